@@ -51,6 +51,12 @@
 #if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
   #include <stdint.h>
   extern uint32_t SystemCoreClock;
+  void PreSleepProcessing(uint32_t ulExpectedIdleTime);
+  void PostSleepProcessing(uint32_t ulExpectedIdleTime);
+/* USER CODE BEGIN 0 */
+  extern void configureTimerForRunTimeStats(void);
+  extern uint64_t getRunTimeCounterValue(void);
+/* USER CODE END 0 */
 #endif
 #ifndef CMSIS_device_header
 #define CMSIS_device_header "stm32f1xx.h"
@@ -60,13 +66,14 @@
 #define configSUPPORT_STATIC_ALLOCATION          1
 #define configSUPPORT_DYNAMIC_ALLOCATION         1
 #define configUSE_IDLE_HOOK                      0
-#define configUSE_TICK_HOOK                      0
+#define configUSE_TICK_HOOK                      1
 #define configCPU_CLOCK_HZ                       ( SystemCoreClock )
 #define configTICK_RATE_HZ                       ((TickType_t)1000)
 #define configMAX_PRIORITIES                     ( 56 )
 #define configMINIMAL_STACK_SIZE                 ((uint16_t)128)
 #define configTOTAL_HEAP_SIZE                    ((size_t)8192)
 #define configMAX_TASK_NAME_LEN                  ( 16 )
+#define configGENERATE_RUN_TIME_STATS            1
 #define configUSE_TRACE_FACILITY                 1
 #define configUSE_16_BIT_TICKS                   0
 #define configUSE_MUTEXES                        1
@@ -74,6 +81,7 @@
 #define configUSE_RECURSIVE_MUTEXES              1
 #define configUSE_COUNTING_SEMAPHORES            1
 #define configUSE_PORT_OPTIMISED_TASK_SELECTION  0
+#define configUSE_TICKLESS_IDLE                  1
 
 /* Co-routine definitions. */
 #define configUSE_CO_ROUTINES                    0
@@ -138,6 +146,17 @@ header file. */
 #define configASSERT( x ) if ((x) == 0) {taskDISABLE_INTERRUPTS(); for( ;; );}
 /* USER CODE END 1 */
 
+/* USER CODE BEGIN 2 */
+/* Definitions needed when configGENERATE_RUN_TIME_STATS is on */
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS configureTimerForRunTimeStats
+#define portGET_RUN_TIME_COUNTER_VALUE getRunTimeCounterValue
+/* USER CODE END 2 */
+
+#if configUSE_TICKLESS_IDLE == 1
+#define configPRE_SLEEP_PROCESSING                PreSleepProcessing
+#define configPOST_SLEEP_PROCESSING               PostSleepProcessing
+#endif /* configUSE_TICKLESS_IDLE == 1 */
+
 /* Definitions that map the FreeRTOS port interrupt handlers to their CMSIS
 standard names. */
 #define vPortSVCHandler    SVC_Handler
@@ -149,6 +168,69 @@ standard names. */
 
 /* USER CODE BEGIN Defines */
 /* Section where parameter definitions can be added (for instance, to override default ones in FreeRTOS.h) */
+/* One thread local storage pointer per task, used by uart_log.c to find the
+task's log staging buffer without taking a lock.  The delete callback gives the
+buffer back when the task is deleted. */
+#define configNUM_THREAD_LOCAL_STORAGE_POINTERS  1
+#define configTHREAD_LOCAL_STORAGE_DELETE_CALLBACKS 1
+/* Run time stats are counted in CPU cycles.  At 72MHz a 32-bit total wraps
+after a minute, so accumulate in 64 bits; getRunTimeCounterValue() in
+freertos.c extends the DWT cycle counter to match. */
+#define configRUN_TIME_COUNTER_TYPE              uint64_t
+/* Find the highest ready priority with a two level bitmap instead of scanning
+the 56 ready lists downward; CMSIS-RTOS2 priorities are sparse (Normal is 24),
+so the scan usually walks many empty lists. */
+#define configUSE_BITMAP_TASK_SELECTION          1
+/* Generate the tick from TIM4 instead of the SysTick (see tim.c).  TIM4 counts
+at 2kHz, two counts per tick, so with its 16-bit counter the idle task can sleep
+for up to 32 seconds; the SysTick's 24 bits only reach 233ms at 72MHz. */
+#define configUSE_TICKLESS_TIMER                 1
+#define configTICKLESS_TIMER_HZ                  2000
+/* Queue reserve/commit and acquire/release, so large items can be written and
+read in place in the queue storage instead of being copied in and out. */
+#define configUSE_QUEUE_ZERO_COPY                1
+/* Queue send/receive of several items under one critical section. */
+#define configUSE_QUEUE_BATCH                    1
+/* xQueueCreatePriority(), so osMessageQueuePut() honours msg_prio for queues
+created with osMessageQueuePrio. */
+#define configUSE_QUEUE_PRIORITY                 1
+/* Per-queue send/receive/block counters, read with uxQueueGetRegistryStats()
+to find the busiest queues and mutexes.  Left off: it misses the 1% overhead
+target.  A send and receive that do not block pay two counter increments and a
+peak compare (2-7ns, 7-17% of the pair on the host, see qstats_bench_stats),
+and a task that blocks reads the clock as it blocks and as it wakes, which
+takes burst_bench task,single from about 126k to 107k frames/s. */
+#define configUSE_QUEUE_STATISTICS               0
+/* Take and give uncontended mutexes with a single LDREX/STREX compare and swap
+instead of a critical section. */
+#define configUSE_MUTEX_FAST_PATH                1
+/* Immediate priority ceiling mutexes (vSemaphoreSetMutexCeiling(), osMutexCeiling)
+that raise the holder to the ceiling as soon as they are taken.  The check
+asserts that no task above a mutex's ceiling ever takes it. */
+#define configUSE_MUTEX_CEILING                  1
+#define configCHECK_MUTEX_CEILING                1
+/* Wait and hold time histograms for the first four mutexes created, per task,
+read with uxQueueGetMutexProfiles() to find locks held across slow calls.  Left
+off: every take and give of a profiled mutex also reads the clock and records
+the sample in a critical section, so an uncontended take and give costs
+130-190ns on the host against 26-40ns without it (mutex_bench_prof). */
+#define configUSE_MUTEX_PROFILING                0
+#define configMUTEX_PROFILE_COUNT                4
+/* Tasks waiting on one of event bits 0-7 are kept on a list per bit, so
+xEventGroupSetBits() only visits the tasks waiting for the bits it sets. */
+#define configUSE_EVENT_GROUP_INDEX              1
+/* xEventGroupSetBitsFromISR() sets the bits and wakes up to four waiting tasks
+in the interrupt, instead of going through the timer task (priority 2). */
+#define configUSE_EVENT_GROUP_ISR_SET            1
+/* 64-bit event groups (event_groups64.h, osEventFlagsWide): 56 event bits in
+one group, for 8 more bytes in every TCB. */
+#define configUSE_64_BIT_EVENT_GROUPS            1
+/* Stream and message buffer reserve/commit and acquire/release, so data can be
+written and read in place in the buffer storage instead of being copied. */
+#define configUSE_STREAM_BUFFER_ZERO_COPY        1
+/* Multi-producer stream buffers: tasks and interrupts claim space with a
+compare and swap and copy in without a critical section (the UART log). */
+#define configUSE_STREAM_BUFFER_MULTI_PRODUCER   1
 /* USER CODE END Defines */
 
 #endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,54 @@
+/**
+  ******************************************************************************
+  * @file    kbench.h
+  * @brief   内核性能测试: 测量队列/信号量/互斥量/任务通知/事件组/流缓冲区/SPSC 通道
+  *          接口的调用耗时, 任务切换时间以及中断到任务的唤醒延迟.
+  *
+  *          结果以 CSV 格式通过 printf 输出, 便于和基准结果直接比较:
+  *            # kbench v1 unit=cycles clock_hz=72000000 samples=200 overhead=12
+  *            name,n,min,avg,p99,max
+  *            queue_send,200,...
+  *
+  *          目标板上定义 KBENCH_ENABLE=1 编译即为测试固件(只运行测试任务),
+  *          主机上由 Host/Bench/kernel_bench.c 运行同一套测试.
+  ******************************************************************************
+  */
+#ifndef __KBENCH_H__
+#define __KBENCH_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/* 置1编译测试固件 */
+#ifndef KBENCH_ENABLE
+#define KBENCH_ENABLE     0
+#endif
+
+/* 每项测试的采样次数 */
+#ifndef KBENCH_SAMPLES
+#define KBENCH_SAMPLES    200U
+#endif
+
+/* 测试任务, 以 osThreadNew/xTaskCreate 创建. 测试任务优先级应高于其它应用任务,
+   内部会再创建同优先级, 更高优先级和最低优先级(空闲任务之上)的辅助任务. */
+void KBENCH_Task(void *argument);
+
+/* 在测试中断(目标板上为 EXTI0)中调用 */
+void KBENCH_IrqHandler(void);
+
+/* 由平台实现 */
+uint32_t KBENCH_PortNow(void);              /* 自由运行的计数器 */
+uint32_t KBENCH_PortClockHz(void);          /* 计数器频率 */
+const char *KBENCH_PortUnit(void);          /* 计数单位, 如 "cycles" */
+void KBENCH_PortInit(void);                 /* 启动计数器 */
+void KBENCH_PortTriggerIrq(void);           /* 用软件触发测试中断 */
+void KBENCH_PortDone(void);                 /* 所有测试完成后调用 */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __KBENCH_H__ */
@@ -0,0 +1,56 @@
+/**
+  ******************************************************************************
+  * @file    spsc.h
+  * @brief   单生产者/单消费者环形缓冲区, 用于中断到任务的数据通道.
+  *
+  *          生产者(通常是一个中断, 或者同一优先级、不会互相嵌套的几个中断)
+  *          只修改写入位置, 消费者(一个任务)只修改读取位置, 双方都不需要
+  *          临界区. 写入只是拷贝一个元素、一次内存屏障和一次写入位置的更新;
+  *          只有消费者正在等待时才会调用一次任务通知把它唤醒.
+  *
+  *          消费者阻塞时使用自己的任务通知(ulTaskNotifyTake), 所以消费者
+  *          任务的通知值不能再用于别的用途.
+  ******************************************************************************
+  */
+#ifndef __SPSC_H__
+#define __SPSC_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+typedef struct
+{
+  uint8_t *Buf;                       /* Capacity * ItemSize 字节 */
+  uint32_t ItemSize;
+  uint32_t Mask;                      /* 容量-1, 容量必须是2的幂 */
+  volatile uint32_t Head;             /* 写入位置(自由计数), 只由生产者修改 */
+  volatile uint32_t Tail;             /* 读取位置(自由计数), 只由消费者修改 */
+  volatile TaskHandle_t Consumer;     /* 正在等待的消费者任务 */
+  volatile uint32_t Waiting;          /* 非0表示消费者已经或即将阻塞 */
+} SPSC_t;
+
+/* buf 至少 capacity * itemSize 字节, capacity 必须是2的幂 */
+void SPSC_Init(SPSC_t *q, void *buf, uint32_t itemSize, uint32_t capacity);
+
+/* 生产者调用: 写入一个元素, 满时返回-1(不等待).
+   FromISR 版本在唤醒了消费者时把 *woken 置为 pdTRUE */
+int SPSC_Put(SPSC_t *q, const void *item);
+int SPSC_PutFromISR(SPSC_t *q, const void *item, BaseType_t *woken);
+
+/* 消费者任务调用: 取出一个元素, 为空时最多等待 timeout 个节拍, 超时返回-1 */
+int SPSC_Get(SPSC_t *q, void *item, uint32_t timeout);
+
+/* 当前元素个数, 生产者和消费者都可以调用 */
+uint32_t SPSC_Count(const SPSC_t *q);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SPSC_H__ */
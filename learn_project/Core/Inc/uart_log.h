@@ -0,0 +1,62 @@
+/**
+  ******************************************************************************
+  * @file    uart_log.h
+  * @brief   非阻塞日志模块: 每个任务先写入自己的暂存区, 整行提交到一个
+  *          环形缓冲区, 再由 USART1 的 DMA 发送通道(DMA1_Channel4)在后台发出.
+  ******************************************************************************
+  */
+#ifndef __UART_LOG_H__
+#define __UART_LOG_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/* 环形缓冲区大小 */
+#ifndef LOG_RING_SIZE
+#define LOG_RING_SIZE       1024U
+#endif
+
+/* 每个任务暂存区的大小, 也是一次提交到环形缓冲区的最大字节数 */
+#ifndef LOG_LINE_MAX
+#define LOG_LINE_MAX        80U
+#endif
+
+/* 暂存区个数, 每个打印过日志的任务占用一个 */
+#ifndef LOG_STAGING_SLOTS
+#define LOG_STAGING_SLOTS   6U
+#endif
+
+/* 暂存区指针保存在任务的第几个线程本地存储指针里 */
+#define LOG_TLS_INDEX       0
+
+typedef struct
+{
+  uint32_t WrittenBytes;    /* 已提交到环形缓冲区的字节数 */
+  uint32_t DroppedBytes;    /* 缓冲区满而丢弃的字节数 */
+  uint32_t HighWaterMark;   /* 环形缓冲区占用的最大字节数 */
+  uint32_t PendingBytes;    /* 当前尚未发送完的字节数 */
+  uint32_t StagingInUse;    /* 已分配给任务的暂存区个数 */
+} LOG_Stats_t;
+
+void LOG_Init(void);
+void LOG_PutChar(int ch);
+void LOG_Write(const char *data, uint32_t len);
+void LOG_Printf(const char *fmt, ...);
+void LOG_Flush(void);
+void LOG_GetStats(LOG_Stats_t *stats);
+
+/* 发送完成后由传输层调用(中断上下文), 继续发送剩余数据 */
+void LOG_TxCpltCallback(void);
+
+/* 由传输层实现: 启动一次 DMA 发送, 成功返回0.
+   目标板上在 usart.c 中实现, 主机上由 UART/DMA 模拟实现. */
+int LOG_PortStartTransmit(const uint8_t *data, uint16_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __UART_LOG_H__ */
@@ -0,0 +1,74 @@
+/**
+  ******************************************************************************
+  * @file    uart_rx.h
+  * @brief   串口接收模块: USART1_RX 的 DMA 通道(DMA1_Channel5)以循环模式写入
+  *          接收缓冲区, 在半满/全满/空闲线中断里把新收到的区间作为描述符交给
+  *          接收任务. 数据留在 DMA 缓冲区中, 中断里不拷贝任何字节.
+  ******************************************************************************
+  */
+#ifndef __UART_RX_H__
+#define __UART_RX_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/* DMA 接收缓冲区大小, 必须是2的幂. 前后两半轮流由 DMA 写入和任务处理 */
+#ifndef UART_RX_BUF_SIZE
+#define UART_RX_BUF_SIZE      512U
+#endif
+
+/* 描述符队列长度, 必须是2的幂 */
+#ifndef UART_RX_QUEUE_LEN
+#define UART_RX_QUEUE_LEN     16U
+#endif
+
+/* 描述符标志 */
+#define UART_RX_FLAG_FRAME_END  0x01U   /* 该区间之后线路空闲, 一帧结束 */
+#define UART_RX_FLAG_ERROR      0x02U   /* 本帧接收出错, 有字节丢失 */
+
+typedef struct
+{
+  const uint8_t *Data;    /* 指向 DMA 缓冲区内部, 调用 UART_RX_Release 前有效 */
+  uint16_t Len;           /* 可能为0: 只表示帧结束 */
+  uint16_t Flags;
+  uint32_t Seq;           /* 第一个字节的接收序号(自由计数) */
+} UART_RX_Segment_t;
+
+typedef struct
+{
+  uint32_t ReceivedBytes;   /* DMA 已写入的字节数 */
+  uint32_t Frames;          /* 检测到的空闲线(帧结束)次数 */
+  uint32_t Events;          /* 半满/全满/空闲线中断次数 */
+  uint32_t DroppedSegments; /* 描述符队列满而丢弃的区间数 */
+  uint32_t Overruns;        /* DMA 覆盖了尚未释放或尚未交给任务的数据的次数 */
+  uint32_t Errors;          /* 串口错误(溢出/噪声/帧错误)次数 */
+} UART_RX_Stats_t;
+
+void UART_RX_Init(void);
+int UART_RX_Start(void);
+
+/* 接收任务调用: 等待下一个区间, 超时返回-1. 只能有一个接收任务, 它的任务通知
+   用于等待描述符, 不能再作他用 */
+int UART_RX_Receive(UART_RX_Segment_t *seg, uint32_t timeout);
+/* 处理完一个区间后释放, 期间数据被 DMA 覆盖则返回-1 */
+int UART_RX_Release(const UART_RX_Segment_t *seg);
+void UART_RX_GetStats(UART_RX_Stats_t *stats);
+
+/* 由传输层在中断中调用. pos 为 DMA 在缓冲区中的写入位置(0..UART_RX_BUF_SIZE),
+   idle 非0表示由空闲线中断触发, halves 为上次调用以来 DMA 越过缓冲区一半或
+   末尾的次数(半满/全满中断为1, 空闲线为0) */
+void UART_RX_EventCallback(uint16_t pos, uint32_t idle, uint32_t halves);
+void UART_RX_ErrorCallback(void);
+
+/* 由传输层实现: 以循环模式启动 DMA 接收并打开空闲线中断, 成功返回0.
+   目标板上在 usart.c 中实现, 主机上由 UART/DMA 模拟实现. */
+int UART_RX_PortStartReceive(uint8_t *buf, uint16_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __UART_RX_H__ */
@@ -27,6 +27,9 @@
 /* USER CODE BEGIN Includes */
 #include <stdio.h>
 #include "usart.h"
+#include "uart_log.h"
+#include "uart_rx.h"
+#include "kbench.h"
 #include "string.h"
 #include "event_groups.h"
 /* USER CODE END Includes */
@@ -51,6 +54,8 @@
 osThreadId_t LED1TaskHandle;
 osThreadId_t LED2TaskHandle;
 osThreadId_t KEY_TaskHandle;
+osThreadId_t UartRxTaskHandle;
+osThreadId_t KBenchTaskHandle;
 
 const osThreadAttr_t LED1Task_attributes = {
     .name = "LED1Task",
@@ -69,6 +74,16 @@ const osThreadAttr_t KEY_Task_attributes = {
     .stack_size = 128,
     .priority = (osPriority_t)osPriorityNormal,
 };
+const osThreadAttr_t UartRxTask_attributes = {
+    .name = "UartRxTask",
+    .stack_size = 128 * 4,
+    .priority = (osPriority_t)osPriorityAboveNormal,
+};
+const osThreadAttr_t KBenchTask_attributes = {
+    .name = "KBenchTask",
+    .stack_size = 256 * 4,
+    .priority = (osPriority_t)osPriorityHigh,
+};
 
 /* USER CODE END Variables */
 /* Definitions for defaultTask */
@@ -84,12 +99,107 @@ const osThreadAttr_t defaultTask_attributes = {
 extern void LED1_Task(void *argument);
 extern void LED2_Task(void *argument);
 extern void KEY_Task(void *argument);
+void UartRx_Task(void *argument);
 /* USER CODE END FunctionPrototypes */
 
 void StartDefaultTask(void *argument);
 
 void MX_FREERTOS_Init(void); /* (MISRA C 2004 rule 8.1) */
 
+/* Hook prototypes */
+void configureTimerForRunTimeStats(void);
+uint64_t getRunTimeCounterValue(void);
+void vApplicationTickHook(void);
+
+/* Pre/Post sleep processing prototypes */
+void PreSleepProcessing(uint32_t ulExpectedIdleTime);
+void PostSleepProcessing(uint32_t ulExpectedIdleTime);
+
+/* USER CODE BEGIN 1 */
+/* Functions needed when configGENERATE_RUN_TIME_STATS is on */
+// 运行时间统计使用 DWT 周期计数器, 每个时钟周期计一次. 计数器只有32位,
+// 72MHz 下约60秒回绕一次, 这里记录回绕次数扩展到64位
+static uint32_t RunTimeLow;
+static uint32_t RunTimeHigh;
+// 睡眠时内核时钟停止, DWT 也不计数, 睡眠的周期数由 PostSleepProcessing 补上
+static uint64_t RunTimeSlept;
+
+void configureTimerForRunTimeStats(void)
+{
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+  RunTimeLow = 0;
+  RunTimeHigh = 0;
+  RunTimeSlept = 0;
+}
+
+// 任务切换(PendSV), 节拍钩子和任务中都会调用, 用临界区保护扩展的高位
+uint64_t getRunTimeCounterValue(void)
+{
+  UBaseType_t mask = taskENTER_CRITICAL_FROM_ISR();
+  uint32_t now = DWT->CYCCNT;
+  uint64_t value;
+
+  if (now < RunTimeLow)
+  {
+    RunTimeHigh++;
+  }
+  RunTimeLow = now;
+  value = (((uint64_t)RunTimeHigh << 32) | now) + RunTimeSlept;
+
+  taskEXIT_CRITICAL_FROM_ISR(mask);
+  return value;
+}
+/* USER CODE END 1 */
+
+/* USER CODE BEGIN 3 */
+void vApplicationTickHook( void )
+{
+   /* This function will be called by each tick interrupt if
+   configUSE_TICK_HOOK is set to 1 in FreeRTOSConfig.h. User code can be
+   added here, but the tick hook is called from an interrupt context, so
+   code must not attempt to block, and only the interrupt safe FreeRTOS API
+   functions can be used (those that end in FromISR()). */
+  // 每个节拍读一次计数器, 即使长时间没有任务切换也不会漏掉 DWT 的回绕
+  (void)getRunTimeCounterValue();
+}
+/* USER CODE END 3 */
+
+/* USER CODE BEGIN PREPOSTSLEEP */
+// 空闲任务进入睡眠前后调用 (configUSE_TICKLESS_IDLE), 此时中断已关闭.
+// HAL 时基 TIM2 每 1ms 中断一次, 睡眠期间停掉, 否则每毫秒都会被唤醒
+static uint32_t SleepTimerStart;
+static uint32_t SleepCycleStart;
+
+__weak void PreSleepProcessing(uint32_t ulExpectedIdleTime)
+{
+  (void)ulExpectedIdleTime;
+  HAL_SuspendTick();
+  SleepTimerStart = ulApplicationTicklessTimerCount();
+  SleepCycleStart = DWT->CYCCNT;
+}
+
+__weak void PostSleepProcessing(uint32_t ulExpectedIdleTime)
+{
+  uint32_t slept;
+  uint32_t counted;
+  uint64_t cycles;
+
+  (void)ulExpectedIdleTime;
+  // 按 TIM4 计数换算睡眠的时钟周期数, 减去 DWT 在这段时间里实际计到的
+  // (调试器设置 DBG_SLEEP 时睡眠中时钟不停)
+  slept = (ulApplicationTicklessTimerCount() - SleepTimerStart) & 0xFFFFU;
+  counted = DWT->CYCCNT - SleepCycleStart;
+  cycles = (uint64_t)slept * (SystemCoreClock / configTICKLESS_TIMER_HZ);
+  if (cycles > counted)
+  {
+    RunTimeSlept += cycles - counted;
+  }
+  HAL_ResumeTick();
+}
+/* USER CODE END PREPOSTSLEEP */
+
 /**
  * @brief  FreeRTOS initialization
  * @param  None
@@ -98,7 +208,7 @@ void MX_FREERTOS_Init(void); /* (MISRA C 2004 rule 8.1) */
 void MX_FREERTOS_Init(void)
 {
   /* USER CODE BEGIN Init */
-  // 初始化串口互斥量
+  // 初始化串口日志缓冲区
   UART_Init();
   /* USER CODE END Init */
 
@@ -119,9 +229,15 @@ void MX_FREERTOS_Init(void)
   defaultTaskHandle = osThreadNew(StartDefaultTask, NULL, &defaultTask_attributes);
 
   /* USER CODE BEGIN RTOS_THREADS */
+#if KBENCH_ENABLE
+  // 测试固件只运行内核性能测试任务
+  KBenchTaskHandle = osThreadNew(KBENCH_Task, NULL, &KBenchTask_attributes);
+#else
   LED1TaskHandle = osThreadNew(LED1_Task, NULL, &LED1Task_attributes);
   LED2TaskHandle = osThreadNew(LED2_Task, NULL, &LED2Task_attributes);
   KEY_TaskHandle = osThreadNew(KEY_Task, NULL, &KEY_Task_attributes);
+  UartRxTaskHandle = osThreadNew(UartRx_Task, NULL, &UartRxTask_attributes);
+#endif
   /* USER CODE END RTOS_THREADS */
 
   /* USER CODE BEGIN RTOS_EVENTS */
@@ -166,4 +282,67 @@ void KEY_Task(void *argument)
   {
   }
 }
+
+// 串口接收任务: 直接在DMA缓冲区中处理收到的数据, 每收到一帧打印一次长度
+void UartRx_Task(void *argument)
+{
+  UART_RX_Segment_t seg;
+  uint32_t frameLen = 0;
+
+  for (;;)
+  {
+    if (UART_RX_Receive(&seg, osWaitForever) != 0)
+    {
+      continue;
+    }
+
+    frameLen += seg.Len;
+    if (UART_RX_Release(&seg) != 0)
+    {
+      LOG_Printf("RX overrun\r\n");
+    }
+
+    if ((seg.Flags & UART_RX_FLAG_FRAME_END) != 0U)
+    {
+      LOG_Printf("RX frame: %lu bytes%s\r\n", (unsigned long)frameLen,
+                 ((seg.Flags & UART_RX_FLAG_ERROR) != 0U) ? " (error)" : "");
+      frameLen = 0;
+    }
+  }
+}
+
+#if KBENCH_ENABLE
+// 内核性能测试的平台接口: DWT 周期计数器计时, 软件触发 EXTI0 作为测试中断
+uint32_t KBENCH_PortNow(void)
+{
+  return DWT->CYCCNT;
+}
+
+uint32_t KBENCH_PortClockHz(void)
+{
+  return SystemCoreClock;
+}
+
+const char *KBENCH_PortUnit(void)
+{
+  return "cycles";
+}
+
+void KBENCH_PortInit(void)
+{
+  // 计数器已由 configureTimerForRunTimeStats 启动, 这里不清零, 以免干扰运行时间统计
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+void KBENCH_PortTriggerIrq(void)
+{
+  EXTI->SWIER = EXTI_SWIER_SWIER0;
+}
+
+void KBENCH_PortDone(void)
+{
+  LOG_Flush();
+}
+#endif
 /* USER CODE END Application */
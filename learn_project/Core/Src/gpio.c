@@ -22,7 +22,7 @@
 #include "gpio.h"
 
 /* USER CODE BEGIN 0 */
-
+#include "kbench.h"
 /* USER CODE END 0 */
 
 /*----------------------------------------------------------------------------*/
@@ -83,5 +83,15 @@ void MX_GPIO_Init(void)
 }
 
 /* USER CODE BEGIN 2 */
-
+// 外部中断回调
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
+{
+  if (GPIO_Pin == KEY1_Pin)
+  {
+#if KBENCH_ENABLE
+    // 测试固件中 EXTI0 由软件触发, 用于测量中断到任务的唤醒延迟
+    KBENCH_IrqHandler();
+#endif
+  }
+}
 /* USER CODE END 2 */
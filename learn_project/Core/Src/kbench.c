@@ -0,0 +1,622 @@
+/**
+  ******************************************************************************
+  * @file    kbench.c
+  * @brief   内核性能测试, 见 kbench.h.
+  *
+  *          每次测量用 KBENCH_PortNow 读取被测代码前后的计数值, 减去两次
+  *          连续读取本身的开销. 接口调用耗时的测试都在没有任务等待的情况下
+  *          进行, 只测接口本身; 切换和唤醒延迟由被唤醒的任务在恢复运行后
+  *          立即记录. isr_* 各项在测试中断里测量 FromISR 接口的耗时, 用来
+  *          比较中断到任务的几种数据通道.
+  ******************************************************************************
+  */
+#include "kbench.h"
+
+#include <stdio.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "event_groups.h"
+#include "stream_buffer.h"
+#include "spsc.h"
+
+#define KBENCH_STACK_SIZE   (configMINIMAL_STACK_SIZE * 2U)
+#define KBENCH_STREAM_SIZE  64U
+#define KBENCH_STREAM_WRITE 16U
+#define KBENCH_CHANNEL_LEN  4U
+
+typedef struct
+{
+  uint32_t Count;
+  uint32_t Samples[KBENCH_SAMPLES];
+} KBENCH_Series_t;
+
+typedef enum
+{
+  KBENCH_WAKE_NOTIFY = 0,
+  KBENCH_WAKE_IRQ
+} KBENCH_WakeMode_t;
+
+// 测试中断的动作
+typedef enum
+{
+  KBENCH_IRQ_NOTIFY = 0,        // 通知 WakeTask
+  KBENCH_IRQ_QUEUE,             // 计时 xQueueSendFromISR
+  KBENCH_IRQ_STREAM,            // 计时 xStreamBufferSendFromISR
+  KBENCH_IRQ_SPSC,              // 计时 SPSC_PutFromISR
+  KBENCH_IRQ_SPSC_WAKE,         // SPSC_PutFromISR, 唤醒阻塞的消费者
+  KBENCH_IRQ_EVENT_GROUP        // xEventGroupSetBitsFromISR, 唤醒等待 bit0 的任务
+} KBENCH_IrqMode_t;
+
+// 大多数测试一次测两个成对的接口(如发送和接收), 各用一组采样
+static KBENCH_Series_t SeriesA;
+static KBENCH_Series_t SeriesB;
+static uint32_t Overhead;
+
+static volatile uint32_t Stamp;
+static volatile TaskHandle_t StampOwner;
+
+static TaskHandle_t BenchTask;
+static TaskHandle_t WakeTask;
+
+static volatile KBENCH_IrqMode_t IrqMode;
+static QueueHandle_t IrqQueue;
+static StreamBufferHandle_t IrqStream;
+static SPSC_t Spsc;
+static uint32_t SpscBuf[KBENCH_CHANNEL_LEN];
+static EventGroupHandle_t IrqGroup;
+
+static void KBENCH_Record(KBENCH_Series_t *series, uint32_t start, uint32_t end)
+{
+  uint32_t delta = end - start;
+
+  delta = (delta > Overhead) ? (delta - Overhead) : 0U;
+  if (series->Count < KBENCH_SAMPLES)
+  {
+    series->Samples[series->Count++] = delta;
+  }
+}
+
+static void KBENCH_Report(const char *name, KBENCH_Series_t *series)
+{
+  uint32_t *s = series->Samples;
+  uint32_t n = series->Count;
+  uint64_t sum = 0;
+  uint32_t value;
+  uint32_t i;
+  uint32_t j;
+
+  if (n == 0U)
+  {
+    printf("%s,0,0,0,0,0\r\n", name);
+    return;
+  }
+
+  // 插入排序, 采样点不多
+  for (i = 1U; i < n; i++)
+  {
+    value = s[i];
+    for (j = i; (j > 0U) && (s[j - 1U] > value); j--)
+    {
+      s[j] = s[j - 1U];
+    }
+    s[j] = value;
+  }
+  for (i = 0U; i < n; i++)
+  {
+    sum += s[i];
+  }
+
+  printf("%s,%lu,%lu,%lu,%lu,%lu\r\n", name, (unsigned long)n, (unsigned long)s[0],
+         (unsigned long)(sum / n), (unsigned long)s[(((n * 99U) + 99U) / 100U) - 1U],
+         (unsigned long)s[n - 1U]);
+
+  series->Count = 0U;
+}
+
+static void KBENCH_Calibrate(void)
+{
+  uint32_t start;
+  uint32_t end;
+  uint32_t i;
+
+  Overhead = 0xFFFFFFFFU;
+  for (i = 0U; i < 100U; i++)
+  {
+    start = KBENCH_PortNow();
+    end = KBENCH_PortNow();
+    if ((end - start) < Overhead)
+    {
+      Overhead = end - start;
+    }
+  }
+}
+
+static void KBENCH_Queue(void)
+{
+  QueueHandle_t queue = xQueueCreate(4U, sizeof(uint32_t));
+  uint32_t item = 0;
+  uint32_t start;
+  uint32_t i;
+
+  configASSERT(queue != NULL);
+
+  for (i = 0U; i < KBENCH_SAMPLES; i++)
+  {
+    start = KBENCH_PortNow();
+    (void)xQueueSend(queue, &item, 0);
+    KBENCH_Record(&SeriesA, start, KBENCH_PortNow());
+
+    start = KBENCH_PortNow();
+    (void)xQueueReceive(queue, &item, 0);
+    KBENCH_Record(&SeriesB, start, KBENCH_PortNow());
+  }
+  KBENCH_Report("queue_send", &SeriesA);
+  KBENCH_Report("queue_receive", &SeriesB);
+
+  vQueueDelete(queue);
+}
+
+static void KBENCH_Semaphore(void)
+{
+  SemaphoreHandle_t sem = xSemaphoreCreateBinary();
+  uint32_t start;
+  uint32_t i;
+
+  configASSERT(sem != NULL);
+
+  for (i = 0U; i < KBENCH_SAMPLES; i++)
+  {
+    start = KBENCH_PortNow();
+    (void)xSemaphoreGive(sem);
+    KBENCH_Record(&SeriesA, start, KBENCH_PortNow());
+
+    start = KBENCH_PortNow();
+    (void)xSemaphoreTake(sem, 0);
+    KBENCH_Record(&SeriesB, start, KBENCH_PortNow());
+  }
+  KBENCH_Report("sem_give", &SeriesA);
+  KBENCH_Report("sem_take", &SeriesB);
+
+  vSemaphoreDelete(sem);
+}
+
+// 没有竞争的互斥量获取和释放
+static void KBENCH_Mutex(void)
+{
+  SemaphoreHandle_t mutex = xSemaphoreCreateMutex();
+  uint32_t start;
+  uint32_t i;
+
+  configASSERT(mutex != NULL);
+
+  for (i = 0U; i < KBENCH_SAMPLES; i++)
+  {
+    start = KBENCH_PortNow();
+    (void)xSemaphoreTake(mutex, 0);
+    KBENCH_Record(&SeriesA, start, KBENCH_PortNow());
+
+    start = KBENCH_PortNow();
+    (void)xSemaphoreGive(mutex);
+    KBENCH_Record(&SeriesB, start, KBENCH_PortNow());
+  }
+  KBENCH_Report("mutex_take", &SeriesA);
+  KBENCH_Report("mutex_give", &SeriesB);
+
+  vSemaphoreDelete(mutex);
+}
+
+static void KBENCH_EventGroup(void)
+{
+  EventGroupHandle_t group = xEventGroupCreate();
+  uint32_t start;
+  uint32_t i;
+
+  configASSERT(group != NULL);
+
+  for (i = 0U; i < KBENCH_SAMPLES; i++)
+  {
+    start = KBENCH_PortNow();
+    (void)xEventGroupSetBits(group, 0x01U);
+    KBENCH_Record(&SeriesA, start, KBENCH_PortNow());
+
+    start = KBENCH_PortNow();
+    (void)xEventGroupClearBits(group, 0x01U);
+    KBENCH_Record(&SeriesB, start, KBENCH_PortNow());
+  }
+  KBENCH_Report("event_set", &SeriesA);
+  KBENCH_Report("event_clear", &SeriesB);
+
+  vEventGroupDelete(group);
+}
+
+static void KBENCH_StreamBuffer(void)
+{
+  StreamBufferHandle_t stream = xStreamBufferCreate(KBENCH_STREAM_SIZE, 1U);
+  uint8_t data[KBENCH_STREAM_WRITE] = {0};
+  uint32_t start;
+  uint32_t i;
+
+  configASSERT(stream != NULL);
+
+  for (i = 0U; i < KBENCH_SAMPLES; i++)
+  {
+    start = KBENCH_PortNow();
+    (void)xStreamBufferSend(stream, data, sizeof(data), 0);
+    KBENCH_Record(&SeriesA, start, KBENCH_PortNow());
+
+    start = KBENCH_PortNow();
+    (void)xStreamBufferReceive(stream, data, sizeof(data), 0);
+    KBENCH_Record(&SeriesB, start, KBENCH_PortNow());
+  }
+  KBENCH_Report("stream_send", &SeriesA);
+  KBENCH_Report("stream_receive", &SeriesB);
+
+  vStreamBufferDelete(stream);
+}
+
+static void KBENCH_Spsc(void)
+{
+  uint32_t item = 0;
+  uint32_t start;
+  uint32_t i;
+
+  SPSC_Init(&Spsc, SpscBuf, sizeof(uint32_t), KBENCH_CHANNEL_LEN);
+
+  for (i = 0U; i < KBENCH_SAMPLES; i++)
+  {
+    start = KBENCH_PortNow();
+    (void)SPSC_Put(&Spsc, &item);
+    KBENCH_Record(&SeriesA, start, KBENCH_PortNow());
+
+    start = KBENCH_PortNow();
+    (void)SPSC_Get(&Spsc, &item, 0U);
+    KBENCH_Record(&SeriesB, start, KBENCH_PortNow());
+  }
+  KBENCH_Report("spsc_put", &SeriesA);
+  KBENCH_Report("spsc_get", &SeriesB);
+}
+
+static void KBENCH_Notify(void)
+{
+  uint32_t start;
+  uint32_t i;
+
+  // 通知自己, 没有任务在等待
+  for (i = 0U; i < KBENCH_SAMPLES; i++)
+  {
+    start = KBENCH_PortNow();
+    (void)xTaskNotify(BenchTask, 0x01U, eSetBits);
+    KBENCH_Record(&SeriesA, start, KBENCH_PortNow());
+
+    (void)xTaskNotifyWait(0U, 0xFFFFFFFFU, NULL, 0);
+  }
+  KBENCH_Report("task_notify", &SeriesA);
+}
+
+// 两个同优先级的任务轮流 taskYIELD, 每次恢复运行时记录对方让出后经过的时间
+static void KBENCH_YieldLoop(void)
+{
+  TaskHandle_t self = xTaskGetCurrentTaskHandle();
+  uint32_t now;
+  uint32_t i;
+
+  for (i = 0U; i < KBENCH_SAMPLES; i++)
+  {
+    now = KBENCH_PortNow();
+    if ((StampOwner != NULL) && (StampOwner != self))
+    {
+      KBENCH_Record(&SeriesA, Stamp, now);
+    }
+    StampOwner = self;
+    Stamp = KBENCH_PortNow();
+    taskYIELD();
+  }
+  StampOwner = NULL;
+}
+
+static void KBENCH_YieldTask(void *argument)
+{
+  (void)argument;
+
+  KBENCH_YieldLoop();
+  xTaskNotifyGive(BenchTask);
+  vTaskDelete(NULL);
+}
+
+static void KBENCH_Yield(void)
+{
+  TaskHandle_t partner;
+
+  StampOwner = NULL;
+  if (xTaskCreate(KBENCH_YieldTask, "KBenchYield", KBENCH_STACK_SIZE, NULL,
+                  uxTaskPriorityGet(NULL), &partner) != pdPASS)
+  {
+    printf("yield_switch,0,0,0,0,0\r\n");
+    return;
+  }
+
+  KBENCH_YieldLoop();
+  (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+  KBENCH_Report("yield_switch", &SeriesA);
+}
+
+// 最低优先级之上的任务: 测试任务阻塞后调度器要从测试任务的优先级一直找到
+// 这里, 测量的是优先级相距很远时的任务切换时间
+static void KBENCH_LowTask(void *argument)
+{
+  (void)argument;
+
+  for (;;)
+  {
+    KBENCH_Record(&SeriesA, Stamp, KBENCH_PortNow());
+    xTaskNotifyGive(BenchTask);
+  }
+}
+
+static void KBENCH_BlockSwitch(void)
+{
+  TaskHandle_t low;
+  uint32_t i;
+
+  if (xTaskCreate(KBENCH_LowTask, "KBenchLow", KBENCH_STACK_SIZE, NULL,
+                  tskIDLE_PRIORITY + 1U, &low) != pdPASS)
+  {
+    printf("block_switch,0,0,0,0,0\r\n");
+    return;
+  }
+
+  for (i = 0U; i < KBENCH_SAMPLES; i++)
+  {
+    Stamp = KBENCH_PortNow();
+    (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+  }
+  vTaskDelete(low);
+  KBENCH_Report("block_switch", &SeriesA);
+}
+
+// 高优先级的等待任务: 被唤醒后立即记录延迟, 再通知测试任务继续
+static void KBENCH_WakeTask(void *argument)
+{
+  (void)argument;
+
+  for (;;)
+  {
+    (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    KBENCH_Record(&SeriesA, Stamp, KBENCH_PortNow());
+    xTaskNotifyGive(BenchTask);
+  }
+}
+
+static void KBENCH_Wake(KBENCH_WakeMode_t mode)
+{
+  uint32_t i;
+
+  for (i = 0U; i < KBENCH_SAMPLES; i++)
+  {
+    Stamp = KBENCH_PortNow();
+    if (mode == KBENCH_WAKE_IRQ)
+    {
+      KBENCH_PortTriggerIrq();
+    }
+    else
+    {
+      xTaskNotifyGive(WakeTask);
+    }
+    (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+  }
+  KBENCH_Report((mode == KBENCH_WAKE_IRQ) ? "irq_to_task" : "notify_wake", &SeriesA);
+}
+
+// 在测试中断里写入一个32位数据, 每次中断后由测试任务立即取走, 所以通道里
+// 最多只有一个元素, 也没有任务在等待, 测的是写入本身
+static void KBENCH_IsrSend(void)
+{
+  static const char *const names[] = { "isr_queue_send", "isr_stream_send", "isr_spsc_put" };
+  uint32_t item;
+  uint32_t mode;
+  uint32_t i;
+
+  IrqQueue = xQueueCreate(KBENCH_CHANNEL_LEN, sizeof(uint32_t));
+  IrqStream = xStreamBufferCreate(KBENCH_CHANNEL_LEN * sizeof(uint32_t), 1U);
+  configASSERT((IrqQueue != NULL) && (IrqStream != NULL));
+  SPSC_Init(&Spsc, SpscBuf, sizeof(uint32_t), KBENCH_CHANNEL_LEN);
+
+  for (mode = KBENCH_IRQ_QUEUE; mode <= KBENCH_IRQ_SPSC; mode++)
+  {
+    IrqMode = (KBENCH_IrqMode_t)mode;
+    for (i = 0U; i < KBENCH_SAMPLES; i++)
+    {
+      KBENCH_PortTriggerIrq();
+      if (mode == KBENCH_IRQ_QUEUE)
+      {
+        (void)xQueueReceive(IrqQueue, &item, 0);
+      }
+      else if (mode == KBENCH_IRQ_STREAM)
+      {
+        (void)xStreamBufferReceive(IrqStream, &item, sizeof(item), 0);
+      }
+      else
+      {
+        (void)SPSC_Get(&Spsc, &item, 0U);
+      }
+    }
+    KBENCH_Report(names[mode - KBENCH_IRQ_QUEUE], &SeriesA);
+  }
+  IrqMode = KBENCH_IRQ_NOTIFY;
+
+  vQueueDelete(IrqQueue);
+  vStreamBufferDelete(IrqStream);
+}
+
+// 阻塞在 SPSC_Get 上的高优先级消费者, 取到数据后立即记录延迟
+static void KBENCH_SpscTask(void *argument)
+{
+  uint32_t item;
+
+  (void)argument;
+
+  for (;;)
+  {
+    if (SPSC_Get(&Spsc, &item, portMAX_DELAY) == 0)
+    {
+      KBENCH_Record(&SeriesA, Stamp, KBENCH_PortNow());
+      xTaskNotifyGive(BenchTask);
+    }
+  }
+}
+
+// 与 irq_to_task 相同, 但中断通过 SPSC 通道唤醒消费者
+static void KBENCH_SpscWake(void)
+{
+  TaskHandle_t consumer;
+  uint32_t i;
+
+  SPSC_Init(&Spsc, SpscBuf, sizeof(uint32_t), KBENCH_CHANNEL_LEN);
+  if (xTaskCreate(KBENCH_SpscTask, "KBenchSpsc", KBENCH_STACK_SIZE, NULL,
+                  uxTaskPriorityGet(NULL) + 1U, &consumer) != pdPASS)
+  {
+    printf("spsc_irq_to_task,0,0,0,0,0\r\n");
+    return;
+  }
+
+  IrqMode = KBENCH_IRQ_SPSC_WAKE;
+  for (i = 0U; i < KBENCH_SAMPLES; i++)
+  {
+    Stamp = KBENCH_PortNow();
+    KBENCH_PortTriggerIrq();
+    (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+  }
+  IrqMode = KBENCH_IRQ_NOTIFY;
+  vTaskDelete(consumer);
+  KBENCH_Report("spsc_irq_to_task", &SeriesA);
+}
+
+// 等待 bit0 的高优先级任务, 被唤醒后立即记录延迟
+static void KBENCH_EventGroupTask(void *argument)
+{
+  (void)argument;
+
+  for (;;)
+  {
+    if ((xEventGroupWaitBits(IrqGroup, 0x01U, pdTRUE, pdFALSE, portMAX_DELAY) & 0x01U) != 0U)
+    {
+      KBENCH_Record(&SeriesA, Stamp, KBENCH_PortNow());
+      xTaskNotifyGive(BenchTask);
+    }
+  }
+}
+
+// 与 irq_to_task 相同, 但中断通过事件组唤醒等待任务. configUSE_EVENT_GROUP_ISR_SET
+// 为0时置位操作经定时器服务任务转发, 多一次任务切换
+static void KBENCH_EventGroupWake(void)
+{
+  TaskHandle_t waiter;
+  uint32_t i;
+
+  IrqGroup = xEventGroupCreate();
+  if ((IrqGroup == NULL) ||
+      (xTaskCreate(KBENCH_EventGroupTask, "KBenchEvt", KBENCH_STACK_SIZE, NULL,
+                   uxTaskPriorityGet(NULL) + 1U, &waiter) != pdPASS))
+  {
+    printf("evgroup_irq_to_task,0,0,0,0,0\r\n");
+    return;
+  }
+
+  IrqMode = KBENCH_IRQ_EVENT_GROUP;
+  for (i = 0U; i < KBENCH_SAMPLES; i++)
+  {
+    Stamp = KBENCH_PortNow();
+    KBENCH_PortTriggerIrq();
+    (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+  }
+  IrqMode = KBENCH_IRQ_NOTIFY;
+  vTaskDelete(waiter);
+  vEventGroupDelete(IrqGroup);
+  KBENCH_Report("evgroup_irq_to_task", &SeriesA);
+}
+
+void KBENCH_IrqHandler(void)
+{
+  BaseType_t woken = pdFALSE;
+  uint32_t item = 0;
+  uint32_t start;
+
+  start = KBENCH_PortNow();
+  switch (IrqMode)
+  {
+    case KBENCH_IRQ_QUEUE:
+      (void)xQueueSendFromISR(IrqQueue, &item, &woken);
+      KBENCH_Record(&SeriesA, start, KBENCH_PortNow());
+      break;
+
+    case KBENCH_IRQ_STREAM:
+      (void)xStreamBufferSendFromISR(IrqStream, &item, sizeof(item), &woken);
+      KBENCH_Record(&SeriesA, start, KBENCH_PortNow());
+      break;
+
+    case KBENCH_IRQ_SPSC:
+      (void)SPSC_PutFromISR(&Spsc, &item, &woken);
+      KBENCH_Record(&SeriesA, start, KBENCH_PortNow());
+      break;
+
+    case KBENCH_IRQ_SPSC_WAKE:
+      (void)SPSC_PutFromISR(&Spsc, &item, &woken);
+      break;
+
+    case KBENCH_IRQ_EVENT_GROUP:
+      (void)xEventGroupSetBitsFromISR(IrqGroup, 0x01U, &woken);
+      break;
+
+    default:
+      if (WakeTask != NULL)
+      {
+        vTaskNotifyGiveFromISR(WakeTask, &woken);
+      }
+      break;
+  }
+  portYIELD_FROM_ISR(woken);
+}
+
+void KBENCH_Task(void *argument)
+{
+  (void)argument;
+
+  BenchTask = xTaskGetCurrentTaskHandle();
+  KBENCH_PortInit();
+  KBENCH_Calibrate();
+
+  if (xTaskCreate(KBENCH_WakeTask, "KBenchWake", KBENCH_STACK_SIZE, NULL,
+                  uxTaskPriorityGet(NULL) + 1U, &WakeTask) != pdPASS)
+  {
+    WakeTask = NULL;
+  }
+
+  printf("# kbench v1 unit=%s clock_hz=%lu samples=%lu overhead=%lu\r\n", KBENCH_PortUnit(),
+         (unsigned long)KBENCH_PortClockHz(), (unsigned long)KBENCH_SAMPLES, (unsigned long)Overhead);
+  printf("name,n,min,avg,p99,max\r\n");
+
+  KBENCH_Queue();
+  KBENCH_Semaphore();
+  KBENCH_Mutex();
+  KBENCH_Notify();
+  KBENCH_EventGroup();
+  KBENCH_StreamBuffer();
+  KBENCH_Spsc();
+  KBENCH_Yield();
+  KBENCH_BlockSwitch();
+  if (WakeTask != NULL)
+  {
+    KBENCH_Wake(KBENCH_WAKE_NOTIFY);
+    KBENCH_Wake(KBENCH_WAKE_IRQ);
+  }
+  KBENCH_IsrSend();
+  KBENCH_SpscWake();
+  KBENCH_EventGroupWake();
+  printf("# kbench end\r\n");
+
+  KBENCH_PortDone();
+  vTaskDelete(NULL);
+}
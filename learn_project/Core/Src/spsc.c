@@ -0,0 +1,120 @@
+/**
+  ******************************************************************************
+  * @file    spsc.c
+  * @brief   单生产者/单消费者环形缓冲区, 见 spsc.h.
+  *
+  *          Head 和 Tail 都是自由计数的32位位置, 二者之差就是元素个数, 下标
+  *          取低位. 各自只有一方写入, 另一方只读, 32位读写是原子的, 所以
+  *          不需要临界区. 生产者先写元素再更新 Head, 消费者先读元素再更新
+  *          Tail, 中间各有一次内存屏障, 保证对方看到新位置时元素已经就绪.
+  *
+  *          消费者阻塞前先置 Waiting 再检查一次 Head; 生产者更新 Head 之后
+  *          再检查 Waiting. 两边的检查至少有一边能看到对方的写入, 不会丢失
+  *          唤醒. 多出来的通知只会让消费者多检查一次.
+  ******************************************************************************
+  */
+#include "spsc.h"
+
+#include <string.h>
+
+#include "cmsis_compiler.h"
+
+void SPSC_Init(SPSC_t *q, void *buf, uint32_t itemSize, uint32_t capacity)
+{
+  configASSERT((capacity != 0U) && ((capacity & (capacity - 1U)) == 0U));
+
+  q->Buf = buf;
+  q->ItemSize = itemSize;
+  q->Mask = capacity - 1U;
+  q->Head = 0U;
+  q->Tail = 0U;
+  q->Consumer = NULL;
+  q->Waiting = 0U;
+}
+
+// 写入元素并发布新的 Head, 满时返回0
+static uint32_t SPSC_Push(SPSC_t *q, const void *item)
+{
+  uint32_t head = q->Head;
+
+  if ((head - q->Tail) > q->Mask)
+  {
+    return 0U;
+  }
+
+  memcpy(&q->Buf[(head & q->Mask) * q->ItemSize], item, q->ItemSize);
+  __DMB();
+  q->Head = head + 1U;
+  __DMB();
+  return 1U;
+}
+
+int SPSC_Put(SPSC_t *q, const void *item)
+{
+  if (SPSC_Push(q, item) == 0U)
+  {
+    return -1;
+  }
+  if (q->Waiting != 0U)
+  {
+    q->Waiting = 0U;
+    xTaskNotifyGive(q->Consumer);
+  }
+  return 0;
+}
+
+int SPSC_PutFromISR(SPSC_t *q, const void *item, BaseType_t *woken)
+{
+  if (SPSC_Push(q, item) == 0U)
+  {
+    return -1;
+  }
+  if (q->Waiting != 0U)
+  {
+    q->Waiting = 0U;
+    vTaskNotifyGiveFromISR(q->Consumer, woken);
+  }
+  return 0;
+}
+
+int SPSC_Get(SPSC_t *q, void *item, uint32_t timeout)
+{
+  TickType_t ticks = (TickType_t)timeout;
+  TimeOut_t timeOut;
+  uint32_t tail;
+
+  vTaskSetTimeOutState(&timeOut);
+
+  for (;;)
+  {
+    tail = q->Tail;
+    if (q->Head != tail)
+    {
+      __DMB();
+      memcpy(item, &q->Buf[(tail & q->Mask) * q->ItemSize], q->ItemSize);
+      __DMB();
+      q->Tail = tail + 1U;
+      return 0;
+    }
+
+    // timeout 为0时第一次就返回; 被提前唤醒(如多余的通知)时只等剩下的时间
+    if (xTaskCheckForTimeOut(&timeOut, &ticks) != pdFALSE)
+    {
+      return -1;
+    }
+
+    q->Consumer = xTaskGetCurrentTaskHandle();
+    q->Waiting = 1U;
+    __DMB();
+    if (q->Head == tail)
+    {
+      (void)ulTaskNotifyTake(pdTRUE, ticks);
+    }
+    q->Waiting = 0U;
+  }
+}
+
+uint32_t SPSC_Count(const SPSC_t *q)
+{
+  return q->Head - q->Tail;
+}
@@ -0,0 +1,324 @@
+/**
+  ******************************************************************************
+  * @file    uart_log.c
+  * @brief   非阻塞日志模块.
+  *
+  *          printf 逐字符调用 __io_putchar, 每个字符都不进入内核: 字符先写入
+  *          当前任务独占的暂存区(通过线程本地存储指针找到, 无需加锁), 遇到
+  *          换行或暂存区写满时才把整行一次性拷贝进环形缓冲区.
+  *          环形缓冲区是一个多生产者流缓冲区: 任务和中断用一次比较交换
+  *          占下空间, 在临界区外拷贝, 再发布给读者, 拷贝期间不关中断,
+  *          也不挡住其他任务和中断的日志. 不会阻塞调用者.
+  *          环形缓冲区由 DMA 在后台直接从缓冲区内发送, 每次发送完成后在
+  *          中断里启动下一段.
+  *          缓冲区放不下一整行时丢弃该行并计数, 不会等待.
+  ******************************************************************************
+  */
+#include "uart_log.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stream_buffer.h"
+
+#if (configUSE_STREAM_BUFFER_MULTI_PRODUCER != 1)
+#error "uart_log requires configUSE_STREAM_BUFFER_MULTI_PRODUCER"
+#endif
+
+#if (configNUM_THREAD_LOCAL_STORAGE_POINTERS <= LOG_TLS_INDEX)
+#error "configNUM_THREAD_LOCAL_STORAGE_POINTERS must be larger than LOG_TLS_INDEX"
+#endif
+
+#if (configTHREAD_LOCAL_STORAGE_DELETE_CALLBACKS != 1)
+#error "uart_log requires configTHREAD_LOCAL_STORAGE_DELETE_CALLBACKS"
+#endif
+
+#define LOG_DMA_MAX     0xFFFFU
+
+typedef struct
+{
+  TaskHandle_t Owner;
+  uint32_t Len;
+  char Buf[LOG_LINE_MAX];
+} LOG_Staging_t;
+
+// 流缓冲区总要空出一个字节, 多分配一个字节使可用容量正好是 LOG_RING_SIZE
+static uint8_t LogRing[LOG_RING_SIZE + 1U];
+static StaticStreamBuffer_t LogStreamBuffer;
+static StreamBufferHandle_t LogStream;
+static volatile uint32_t LogInFlight;   // 正在由DMA发送的字节数, 0表示DMA空闲
+
+static volatile uint32_t LogWrittenBytes;
+static volatile uint32_t LogDroppedBytes;
+static volatile uint32_t LogHighWaterMark;
+
+static LOG_Staging_t LogStaging[LOG_STAGING_SLOTS];
+
+// DMA空闲时启动下一段连续数据的发送, 必须在临界区内调用
+static void LOG_StartNext(void)
+{
+  StreamBufferRegion_t region;
+  uint32_t chunk;
+
+  if (LogInFlight != 0U)
+  {
+    return;
+  }
+
+  if (xStreamBufferAcquireFromISR(LogStream, &region) == 0U)
+  {
+    return;
+  }
+
+  // DMA不能跨过缓冲区末尾回绕, 回绕部分留给下一次发送
+  chunk = (uint32_t)region.xFirstLength;
+  if (chunk > LOG_DMA_MAX)
+  {
+    chunk = LOG_DMA_MAX;
+  }
+
+  LogInFlight = chunk;
+  if (LOG_PortStartTransmit(region.pucFirst, (uint16_t)chunk) != 0)
+  {
+    // 发送通道忙, 数据留在缓冲区里, 下一次提交时再试
+    LogInFlight = 0U;
+    (void)xStreamBufferReleaseFromISR(LogStream, 0U, NULL);
+  }
+}
+
+// 把一段数据整体提交到环形缓冲区, 任务和中断中都可以调用
+static void LOG_Commit(const char *data, uint32_t len)
+{
+  StreamBufferRegion_t region;
+  UBaseType_t mask;
+  uint32_t used;
+
+  if (len == 0U)
+  {
+    return;
+  }
+
+  // 放不下整段就整段丢弃, 避免输出半行
+  if (xStreamBufferClaim(LogStream, &region, len) == 0U)
+  {
+    mask = taskENTER_CRITICAL_FROM_ISR();
+    LogDroppedBytes += len;
+    taskEXIT_CRITICAL_FROM_ISR(mask);
+    return;
+  }
+
+  // 拷贝不在临界区内, 其他任务和中断可以同时占用后面的空间
+  memcpy(region.pucFirst, data, region.xFirstLength);
+  if (region.xSecondLength > 0U)
+  {
+    memcpy(region.pucSecond, data + region.xFirstLength, region.xSecondLength);
+  }
+
+  if (xPortIsInsideInterrupt() != pdFALSE)
+  {
+    (void)xStreamBufferPublishFromISR(LogStream, NULL);
+  }
+  else
+  {
+    (void)xStreamBufferPublish(LogStream);
+  }
+
+  mask = taskENTER_CRITICAL_FROM_ISR();
+
+  LogWrittenBytes += len;
+
+  // 已占用但还没发布的空间也计入
+  used = LOG_RING_SIZE - (uint32_t)xStreamBufferSpacesAvailable(LogStream);
+  if (used > LogHighWaterMark)
+  {
+    LogHighWaterMark = used;
+  }
+
+  // 前面还有未发布的占用时数据暂时读不到, 由最后一个发布者启动发送
+  LOG_StartNext();
+
+  taskEXIT_CRITICAL_FROM_ISR(mask);
+}
+
+// 任务删除时由内核调用, 归还它的暂存区. 不归还的话 LOG_STAGING_SLOTS 个
+// 任务先后删除后, 之后的任务都只能逐字符提交. 没换行的半行随任务丢弃
+static void LOG_StagingDeleted(int index, void *pointer)
+{
+  LOG_Staging_t *staging = (LOG_Staging_t *)pointer;
+
+  (void)index;
+  taskENTER_CRITICAL();
+  LogDroppedBytes += staging->Len;
+  staging->Len = 0U;
+  staging->Owner = NULL;
+  taskEXIT_CRITICAL();
+}
+
+// 取得当前任务的暂存区, 中断中或调度器启动前返回NULL
+static LOG_Staging_t *LOG_GetStaging(void)
+{
+  LOG_Staging_t *staging;
+  TaskHandle_t self;
+  uint32_t i;
+
+  if ((xPortIsInsideInterrupt() != pdFALSE) ||
+      (xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED))
+  {
+    return NULL;
+  }
+
+  staging = (LOG_Staging_t *)pvTaskGetThreadLocalStoragePointer(NULL, LOG_TLS_INDEX);
+  if (staging == NULL)
+  {
+    // 每个任务第一次打印时分配一个暂存区, 之后直接通过本地存储指针取得
+    self = xTaskGetCurrentTaskHandle();
+    taskENTER_CRITICAL();
+    for (i = 0U; i < LOG_STAGING_SLOTS; i++)
+    {
+      if (LogStaging[i].Owner == NULL)
+      {
+        LogStaging[i].Owner = self;
+        LogStaging[i].Len = 0U;
+        staging = &LogStaging[i];
+        break;
+      }
+    }
+    taskEXIT_CRITICAL();
+
+    if (staging != NULL)
+    {
+      vTaskSetThreadLocalStoragePointerAndDelCallback(NULL, LOG_TLS_INDEX, staging, LOG_StagingDeleted);
+    }
+  }
+
+  return staging;
+}
+
+void LOG_Init(void)
+{
+  LogStream = xStreamBufferCreateMultiProducerStatic(sizeof(LogRing), 1U, LogRing, &LogStreamBuffer);
+  LogInFlight = 0U;
+  LogWrittenBytes = 0U;
+  LogDroppedBytes = 0U;
+  LogHighWaterMark = 0U;
+  memset(LogStaging, 0, sizeof(LogStaging));
+}
+
+void LOG_PutChar(int ch)
+{
+  LOG_Staging_t *staging = LOG_GetStaging();
+  char c = (char)ch;
+
+  if (staging == NULL)
+  {
+    // 没有暂存区(中断中/暂存区用完)时逐字符提交
+    LOG_Commit(&c, 1U);
+    return;
+  }
+
+  staging->Buf[staging->Len++] = c;
+  if ((c == '\n') || (staging->Len >= LOG_LINE_MAX))
+  {
+    LOG_Commit(staging->Buf, staging->Len);
+    staging->Len = 0U;
+  }
+}
+
+void LOG_Write(const char *data, uint32_t len)
+{
+  LOG_Staging_t *staging = LOG_GetStaging();
+  uint32_t i;
+  uint32_t chunk;
+
+  if (staging == NULL)
+  {
+    while (len > 0U)
+    {
+      chunk = (len > LOG_LINE_MAX) ? LOG_LINE_MAX : len;
+      LOG_Commit(data, chunk);
+      data += chunk;
+      len -= chunk;
+    }
+    return;
+  }
+
+  for (i = 0U; i < len; i++)
+  {
+    staging->Buf[staging->Len++] = data[i];
+    if ((data[i] == '\n') || (staging->Len >= LOG_LINE_MAX))
+    {
+      LOG_Commit(staging->Buf, staging->Len);
+      staging->Len = 0U;
+    }
+  }
+}
+
+void LOG_Printf(const char *fmt, ...)
+{
+  char line[LOG_LINE_MAX];
+  UBaseType_t mask;
+  va_list args;
+  int len;
+
+  va_start(args, fmt);
+  len = vsnprintf(line, sizeof(line), fmt, args);
+  va_end(args);
+
+  if (len < 0)
+  {
+    return;
+  }
+  if ((uint32_t)len >= sizeof(line))
+  {
+    // 超出一行的部分被截断
+    mask = taskENTER_CRITICAL_FROM_ISR();
+    LogDroppedBytes += (uint32_t)len - (sizeof(line) - 1U);
+    taskEXIT_CRITICAL_FROM_ISR(mask);
+    len = (int)(sizeof(line) - 1U);
+  }
+
+  LOG_Write(line, (uint32_t)len);
+}
+
+void LOG_Flush(void)
+{
+  LOG_Staging_t *staging = LOG_GetStaging();
+
+  if ((staging != NULL) && (staging->Len > 0U))
+  {
+    LOG_Commit(staging->Buf, staging->Len);
+    staging->Len = 0U;
+  }
+}
+
+void LOG_GetStats(LOG_Stats_t *stats)
+{
+  UBaseType_t mask = taskENTER_CRITICAL_FROM_ISR();
+  uint32_t i;
+
+  stats->WrittenBytes = LogWrittenBytes;
+  stats->DroppedBytes = LogDroppedBytes;
+  stats->HighWaterMark = LogHighWaterMark;
+  stats->PendingBytes = (uint32_t)xStreamBufferBytesAvailable(LogStream);
+  stats->StagingInUse = 0U;
+  for (i = 0U; i < LOG_STAGING_SLOTS; i++)
+  {
+    stats->StagingInUse += (LogStaging[i].Owner != NULL) ? 1U : 0U;
+  }
+
+  taskEXIT_CRITICAL_FROM_ISR(mask);
+}
+
+void LOG_TxCpltCallback(void)
+{
+  UBaseType_t mask = taskENTER_CRITICAL_FROM_ISR();
+
+  (void)xStreamBufferReleaseFromISR(LogStream, LogInFlight, NULL);
+  LogInFlight = 0U;
+  LOG_StartNext();
+
+  taskEXIT_CRITICAL_FROM_ISR(mask);
+}
@@ -0,0 +1,217 @@
+/**
+  ******************************************************************************
+  * @file    uart_rx.c
+  * @brief   串口接收模块.
+  *
+  *          DMA 以循环模式不停地写入 RxBuf, 不需要在每帧之后重新启动. 半满
+  *          和全满中断保证每次最多处理半个缓冲区, 空闲线中断标出帧的结尾.
+  *          每次中断只计算 DMA 写入位置前进了多少, 把新数据所在的区间(起始
+  *          序号, 长度, 标志)放进描述符队列, 数据本身不拷贝. 接收任务直接在
+  *          DMA 缓冲区里解析, 处理完调用 UART_RX_Release.
+  *
+  *          描述符队列是 SPSC 环形缓冲区: 写入描述符的 DMA1_Channel5 和
+  *          USART1 中断优先级相同, 不会互相嵌套, 相当于一个生产者; 读取的
+  *          只有接收任务一个. 中断里写入描述符不需要进入临界区.
+  *
+  *          任务来不及处理时 DMA 不会停下, 而是覆盖最早的数据; 这种情况
+  *          在中断里计为 Overruns, 并由 UART_RX_Release 告诉调用者.
+  *          中断本身来得太晚, DMA 在两次回调之间写满了整圈时, 只看写入
+  *          位置看不出来; 传输层同时报告越过缓冲区一半和末尾的次数, 比
+  *          位置变化多出整圈时同样计为 Overruns, 丢掉这之间的数据, 并发
+  *          一个出错的帧结束标记.
+  ******************************************************************************
+  */
+#include "uart_rx.h"
+
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "spsc.h"
+
+#if ((UART_RX_BUF_SIZE & (UART_RX_BUF_SIZE - 1U)) != 0U)
+#error "UART_RX_BUF_SIZE must be a power of two"
+#endif
+
+#if ((UART_RX_QUEUE_LEN & (UART_RX_QUEUE_LEN - 1U)) != 0U)
+#error "UART_RX_QUEUE_LEN must be a power of two"
+#endif
+
+#define UART_RX_BUF_MASK  (UART_RX_BUF_SIZE - 1U)
+#define UART_RX_BUF_HALF  (UART_RX_BUF_SIZE / 2U)
+
+static uint8_t RxBuf[UART_RX_BUF_SIZE];
+static UART_RX_Segment_t RxSegments[UART_RX_QUEUE_LEN];
+static SPSC_t RxQueue;
+
+static uint16_t RxLastPos;              // 上一次中断时 DMA 的写入位置
+static uint32_t RxInFrame;              // 上一次帧结束之后是否收到过数据
+static volatile uint32_t RxReceived;    // DMA已写入的字节数(自由计数)
+static volatile uint32_t RxReleased;    // 接收任务已处理完的位置
+
+static volatile uint32_t RxFrames;
+static volatile uint32_t RxEvents;
+static volatile uint32_t RxDroppedSegments;
+static volatile uint32_t RxOverruns;
+static volatile uint32_t RxErrors;
+
+// 把一个区间放进描述符队列, 只在中断中调用
+static void UART_RX_Post(uint32_t seq, uint32_t len, uint32_t flags, BaseType_t *woken)
+{
+  UART_RX_Segment_t seg;
+
+  seg.Data = &RxBuf[seq & UART_RX_BUF_MASK];
+  seg.Len = (uint16_t)len;
+  seg.Flags = (uint16_t)flags;
+  seg.Seq = seq;
+
+  if (SPSC_PutFromISR(&RxQueue, &seg, woken) != 0)
+  {
+    RxDroppedSegments++;
+  }
+}
+
+void UART_RX_Init(void)
+{
+  SPSC_Init(&RxQueue, RxSegments, sizeof(UART_RX_Segment_t), UART_RX_QUEUE_LEN);
+  RxLastPos = 0U;
+  RxInFrame = 0U;
+  RxReceived = 0U;
+  RxReleased = 0U;
+  RxFrames = 0U;
+  RxEvents = 0U;
+  RxDroppedSegments = 0U;
+  RxOverruns = 0U;
+  RxErrors = 0U;
+}
+
+int UART_RX_Start(void)
+{
+  RxLastPos = 0U;
+  return UART_RX_PortStartReceive(RxBuf, (uint16_t)UART_RX_BUF_SIZE);
+}
+
+void UART_RX_EventCallback(uint16_t pos, uint32_t idle, uint32_t halves)
+{
+  BaseType_t woken = pdFALSE;
+  uint32_t seq = RxReceived;
+  uint32_t len;
+  uint32_t crossed;
+  uint32_t laps;
+  uint32_t first;
+  uint32_t flags;
+
+  RxEvents++;
+
+  // 全满中断时 pos 等于缓冲区大小, 即回到起点
+  pos &= UART_RX_BUF_MASK;
+  len = ((uint32_t)pos - RxLastPos) & UART_RX_BUF_MASK;
+  // 不到一圈的前进越过的一半/末尾次数, 传输层报告的每多两次就是多跑了一圈
+  crossed = ((RxLastPos + len) / UART_RX_BUF_HALF) - (RxLastPos / UART_RX_BUF_HALF);
+  laps = (halves > crossed) ? ((halves - crossed) / 2U) : 0U;
+  RxLastPos = pos;
+
+  flags = (idle != 0U) ? UART_RX_FLAG_FRAME_END : 0U;
+
+  if (laps > 0U)
+  {
+    // 这之间的数据(包括缓冲区里现有的)已被覆盖过, 全部丢掉, 与出错时一样
+    // 从新的位置继续接收, 当前帧标记为出错
+    RxOverruns++;
+    RxReceived = seq + (laps * UART_RX_BUF_SIZE) + len;
+    RxReleased = RxReceived;
+    UART_RX_Post(RxReceived, 0U, UART_RX_FLAG_FRAME_END | UART_RX_FLAG_ERROR, &woken);
+    RxInFrame = 0U;
+  }
+  else if (len > 0U)
+  {
+    RxReceived = seq + len;
+    RxInFrame = 1U;
+
+    if ((RxReceived - RxReleased) > UART_RX_BUF_SIZE)
+    {
+      RxOverruns++;
+    }
+
+    // 跨过缓冲区末尾的数据分成两个区间, 保证每个区间在内存中连续
+    first = UART_RX_BUF_SIZE - (seq & UART_RX_BUF_MASK);
+    if (len > first)
+    {
+      UART_RX_Post(seq, first, 0U, &woken);
+      UART_RX_Post(seq + first, len - first, flags, &woken);
+    }
+    else
+    {
+      UART_RX_Post(seq, len, flags, &woken);
+    }
+  }
+  else if ((idle != 0U) && (RxInFrame != 0U))
+  {
+    // 帧的最后一个字节刚好由半满/全满中断送出, 单独发一个帧结束标记
+    UART_RX_Post(seq, 0U, flags, &woken);
+  }
+
+  if (idle != 0U)
+  {
+    if (RxInFrame != 0U)
+    {
+      RxFrames++;
+    }
+    RxInFrame = 0U;
+  }
+
+  portYIELD_FROM_ISR(woken);
+}
+
+void UART_RX_ErrorCallback(void)
+{
+  BaseType_t woken = pdFALSE;
+
+  // 出错后 HAL 已停止 DMA, 未处理的字节丢失, 当前帧标记为出错后重新开始接收
+  RxErrors++;
+  if (RxInFrame != 0U)
+  {
+    UART_RX_Post(RxReceived, 0U, UART_RX_FLAG_FRAME_END | UART_RX_FLAG_ERROR, &woken);
+    RxInFrame = 0U;
+  }
+
+  // DMA从缓冲区起点重新写入, 接收序号随之对齐到下一个缓冲区起点
+  RxReceived = (RxReceived + UART_RX_BUF_MASK) & ~UART_RX_BUF_MASK;
+  RxReleased = RxReceived;
+  (void)UART_RX_Start();
+
+  portYIELD_FROM_ISR(woken);
+}
+
+int UART_RX_Receive(UART_RX_Segment_t *seg, uint32_t timeout)
+{
+  return SPSC_Get(&RxQueue, seg, timeout);
+}
+
+int UART_RX_Release(const UART_RX_Segment_t *seg)
+{
+  uint32_t end = seg->Seq + seg->Len;
+
+  // 只在接收任务中调用, 32位写入是原子的
+  if ((int32_t)(end - RxReleased) > 0)
+  {
+    RxReleased = end;
+  }
+
+  // 处理期间 DMA 已经写过了这个区间的位置, 数据不再可信
+  return ((RxReceived - seg->Seq) > UART_RX_BUF_SIZE) ? -1 : 0;
+}
+
+void UART_RX_GetStats(UART_RX_Stats_t *stats)
+{
+  UBaseType_t mask = taskENTER_CRITICAL_FROM_ISR();
+
+  stats->ReceivedBytes = RxReceived;
+  stats->Frames = RxFrames;
+  stats->Events = RxEvents;
+  stats->DroppedSegments = RxDroppedSegments;
+  stats->Overruns = RxOverruns;
+  stats->Errors = RxErrors;
+
+  taskEXIT_CRITICAL_FROM_ISR(mask);
+}
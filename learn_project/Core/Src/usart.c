@@ -22,76 +22,86 @@
 
 /* USER CODE BEGIN 0 */
 #include <stdio.h>
-#include "cmsis_os.h"
 #include <string.h>
+#include "uart_log.h"
+#include "uart_rx.h"
 
 // DMA发送完成回调
 void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
 {
     if(huart->Instance == USART1)
     {
-        // DMA发送完成
+        // DMA发送完成, 继续发送日志缓冲区中剩余的数据
+        LOG_TxCpltCallback();
     }
 }
 
-// 创建互斥量句柄
-static osMutexId_t UartMutexHandle;
-const osMutexAttr_t UartMutex_attributes = {
-    .name = "UartMutex"
-};
-
-// 串口初始化时创建互斥量
-void UART_Init(void)
+// 日志模块的发送接口, 由 DMA1_Channel4 在后台发送
+int LOG_PortStartTransmit(const uint8_t *data, uint16_t len)
 {
-    UartMutexHandle = osMutexNew(&UartMutex_attributes);
+    return (HAL_UART_Transmit_DMA(&huart1, (uint8_t *)data, len) == HAL_OK) ? 0 : -1;
 }
 
-#ifdef __GNUC__
-int __io_putchar(int ch)
+// 接收事件回调: DMA半满/全满或空闲线, Size 为本次接收在缓冲区中的写入位置
+void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size)
 {
-    if (UartMutexHandle != NULL && (osKernelGetState() == osKernelRunning))
+    if(huart->Instance == USART1)
     {
-        // 在RTOS运行时使用互斥量保护
-        osMutexAcquire(UartMutexHandle, osWaitForever);
-        HAL_UART_Transmit(&huart1, (uint8_t *)&ch, 1, 1000);
-        osMutexRelease(UartMutexHandle);
+        // 注意: 空闲线恰好出现在缓冲区末尾时 HAL 不会回调, 该帧会与下一帧合并.
+        // 每次半满/全满回调算越过一次; DMA 的标志记不下第二次, 所以目标板上
+        // 中断晚到整圈以上时仍然发现不了
+        uint32_t idle = (HAL_UARTEx_GetRxEventType(huart) == HAL_UART_RXEVENT_IDLE) ? 1U : 0U;
+
+        UART_RX_EventCallback(Size, idle, (idle != 0U) ? 0U : 1U);
     }
-    else
+}
+
+// 串口错误回调: DMA模式下HAL已中止接收, 由接收模块重新启动
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
+{
+    if(huart->Instance == USART1)
     {
-        // RTOS未运行时直接发送
-        HAL_UART_Transmit(&huart1, (uint8_t *)&ch, 1, 1000);
+        UART_RX_ErrorCallback();
     }
+}
+
+// 接收模块的接收接口, DMA1_Channel5 以循环模式写入, 同时打开空闲线中断
+int UART_RX_PortStartReceive(uint8_t *buf, uint16_t size)
+{
+    return (HAL_UARTEx_ReceiveToIdle_DMA(&huart1, buf, size) == HAL_OK) ? 0 : -1;
+}
+
+// 串口初始化时初始化日志缓冲区, 并启动DMA接收
+void UART_Init(void)
+{
+    LOG_Init();
+    UART_RX_Init();
+    UART_RX_Start();
+}
+
+// printf 只把字符写入本任务的暂存区, 不再逐字节轮询发送, 也不再需要互斥量
+#ifdef __GNUC__
+int __io_putchar(int ch)
+{
+    LOG_PutChar(ch);
     return ch;
 }
 #else
 int fputc(int ch, FILE *f)
 {
-    if (UartMutexHandle != NULL && (osKernelGetState() == osKernelRunning))
-    {
-        // 在RTOS运行时使用互斥量保护
-        osMutexAcquire(UartMutexHandle, osWaitForever);
-        HAL_UART_Transmit(&huart1, (uint8_t *)&ch, 1, 1000);
-        osMutexRelease(UartMutexHandle);
-    }
-    else
-    {
-        // RTOS未运行时直接发送
-        HAL_UART_Transmit(&huart1, (uint8_t *)&ch, 1, 1000);
-    }
+    LOG_PutChar(ch);
     return ch;
 }
 #endif
 
 void DEBUG_Print(const char *str)
 {
-    HAL_UART_Transmit(&huart1, (uint8_t *)str, strlen(str), 1000);
+    LOG_Write(str, strlen(str));
 }
 
 void DEBUG_PrintNum(const char *str, int num)
 {
-    char buf[64];
-    int len = sprintf(buf, "%s%d\r\n", str, num);
-    HAL_UART_Transmit(&huart1, (uint8_t *)buf, len, 2000);
+    LOG_Printf("%s%d\r\n", str, num);
 }
 
 /* USER CODE END 0 */
@@ -165,7 +175,7 @@ void HAL_UART_MspInit(UART_HandleTypeDef* uartHandle)
     hdma_usart1_rx.Init.MemInc = DMA_MINC_ENABLE;
     hdma_usart1_rx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
     hdma_usart1_rx.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
-    hdma_usart1_rx.Init.Mode = DMA_NORMAL;
+    hdma_usart1_rx.Init.Mode = DMA_CIRCULAR;
     hdma_usart1_rx.Init.Priority = DMA_PRIORITY_MEDIUM;
     if (HAL_DMA_Init(&hdma_usart1_rx) != HAL_OK)
     {
@@ -0,0 +1,52 @@
+/**
+ ******************************************************************************
+ * @file    bench_util.h
+ * @brief   主机测试程序共用的部分: 计时, 检查计数, 结果行
+ *
+ * 每个测试程序是一个单独的可执行文件, 只有一个源文件包含本头文件,
+ * 所以这里直接定义 static 的计数变量和函数.
+ *
+ * 测试程序的约定: 输出 CSV 或 key=value 行, 做了正确性检查的程序在
+ * Bench_Task 最后调用 BENCH_Finish(), 输出 "# pass" 或 "# FAIL" 并结束
+ * 调度器; 不启动调度器的程序只调用 BENCH_PrintResult().
+ ******************************************************************************
+ */
+#ifndef BENCH_UTIL_H
+#define BENCH_UTIL_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+// 失败的检查个数. 任务, 模拟中断和外设线程都可能累加, 所以是 volatile
+static volatile uint32_t Errors __attribute__((unused));
+
+// 条件成立时记一次失败
+#define BENCH_FAIL_IF(failed)   (Errors += (failed) ? 1U : 0U)
+
+static inline uint64_t NowNs(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+// 按失败的检查个数输出 "# pass" 或 "# FAIL"
+static inline void BENCH_PrintResult(void)
+{
+  printf("# %s\n", (Errors == 0U) ? "pass" : "FAIL");
+}
+
+// 输出结果行并结束调度器, vTaskStartScheduler() 随后在 main() 中返回
+static inline void BENCH_Finish(void)
+{
+  BENCH_PrintResult();
+  fflush(stdout);
+  vTaskEndScheduler();
+}
+
+#endif /* BENCH_UTIL_H */
@@ -0,0 +1,208 @@
+/**
+ ******************************************************************************
+ * @file    burst_bench.c
+ * @brief   突发写入时逐条收发与批量收发 (configUSE_QUEUE_BATCH) 的吞吐量
+ *
+ * 生产者每次连续写入一批 (BENCH_BURST 条) 16 字节的帧, 模拟 UART 接收
+ * 一次突发; 消费者的优先级高于生产者, 与处理串口帧的任务一样.
+ *   single  osMessageQueuePut / osMessageQueueGet 逐条收发, 每写一条都会
+ *           唤醒消费者并切换过去
+ *   batch   osMessageQueuePutBatch / osMessageQueueGetBatch, 一批只唤醒
+ *           消费者一次
+ * 生产者分别在任务中和在 (由生产者任务触发的) 模拟中断中写入各测一次.
+ * 输出每秒传递的帧数, 消费者的读取调用次数和因队列为空而阻塞 (之后被唤醒)
+ * 的次数. 帧中带序号, 消费者检查顺序.
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "cmsis_os2.h"
+#include "bench_util.h"
+
+#define BENCH_SIM_IRQ       9U        // 与其他测试和 uart_sim 的中断号错开
+#define BENCH_FRAME_SIZE    16U
+#define BENCH_BURST         32U
+#define BENCH_DEPTH         32U
+#define BENCH_FRAMES        200000U
+#define BENCH_IRQ_FRAMES    20000U
+#define BENCH_PRIORITY      (configMAX_PRIORITIES - 8U)
+
+typedef struct
+{
+  uint32_t Seq;
+  uint8_t Data[BENCH_FRAME_SIZE - sizeof(uint32_t)];
+} Frame_t;
+
+static const char *const ModeNames[] = { "single", "batch" };
+
+static osMessageQueueId_t Queue;
+static TaskHandle_t BenchTask;
+static TaskHandle_t ProducerTask;
+static TaskHandle_t ConsumerTask;
+static volatile uint32_t Batch;
+static volatile uint32_t Frames;
+static volatile uint32_t IrqProducer;
+static volatile uint32_t Calls;
+static volatile uint32_t Blocks;
+static uint32_t IrqSeq;
+static Frame_t Burst[BENCH_BURST];
+
+static void FillBurst(uint32_t seq)
+{
+  uint32_t i;
+
+  for (i = 0; i < BENCH_BURST; i++)
+  {
+    Burst[i].Seq = seq + i;
+  }
+}
+
+// 写入一整批, 队列满时等待. 中断中 timeout 为 0: 消费者优先级更高,
+// 每次中断之后都会把队列取空, 一批总能放下
+static void PutBurst(uint32_t timeout)
+{
+  uint32_t sent;
+
+  if (Batch != 0U)
+  {
+    for (sent = 0; sent < BENCH_BURST;)
+    {
+      sent += osMessageQueuePutBatch(Queue, &Burst[sent], BENCH_BURST - sent, timeout);
+    }
+  }
+  else
+  {
+    for (sent = 0; sent < BENCH_BURST; sent++)
+    {
+      (void)osMessageQueuePut(Queue, &Burst[sent], 0U, timeout);
+    }
+  }
+}
+
+static void Producer_Task(void *argument)
+{
+  uint32_t seq;
+
+  (void)argument;
+
+  for (;;)
+  {
+    (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    for (seq = 0; seq < Frames; seq += BENCH_BURST)
+    {
+      if (IrqProducer != 0U)
+      {
+        vPortGenerateSimulatedInterrupt(BENCH_SIM_IRQ);
+      }
+      else
+      {
+        FillBurst(seq);
+        PutBurst(osWaitForever);
+      }
+    }
+  }
+}
+
+static void Consumer_Task(void *argument)
+{
+  Frame_t frames[BENCH_BURST];
+  uint32_t expect;
+  uint32_t got;
+  uint32_t i;
+
+  (void)argument;
+
+  for (;;)
+  {
+    (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    for (expect = 0; expect < Frames;)
+    {
+      if (osMessageQueueGetCount(Queue) == 0U)
+      {
+        Blocks++;
+      }
+      if (Batch != 0U)
+      {
+        got = osMessageQueueGetBatch(Queue, frames, BENCH_BURST, osWaitForever);
+      }
+      else
+      {
+        got = (osMessageQueueGet(Queue, frames, NULL, osWaitForever) == osOK) ? 1U : 0U;
+      }
+      Calls++;
+      for (i = 0; i < got; i++)
+      {
+        BENCH_FAIL_IF(frames[i].Seq != expect);
+        expect++;
+      }
+    }
+    xTaskNotifyGive(BenchTask);
+  }
+}
+
+// 模拟中断: 一次中断写入一批
+static uint32_t Bench_SimIrq(void)
+{
+  FillBurst(IrqSeq);
+  IrqSeq += BENCH_BURST;
+  PutBurst(0U);
+  return pdTRUE;
+}
+
+static void Run(uint32_t irq, uint32_t frames)
+{
+  uint64_t ns;
+  uint64_t start;
+
+  Frames = frames;
+  IrqProducer = irq;
+  IrqSeq = 0;
+  Calls = 0;
+  Blocks = 0;
+  start = NowNs();
+  xTaskNotifyGive(ConsumerTask);
+  xTaskNotifyGive(ProducerTask);
+  (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+  ns = NowNs() - start;
+
+  printf("%s,%s,%lu,%llu,%lu,%lu\n", (irq != 0U) ? "isr" : "task", ModeNames[Batch], (unsigned long)frames,
+         (unsigned long long)(((uint64_t)frames * 1000000000ULL) / ns), (unsigned long)Calls, (unsigned long)Blocks);
+}
+
+static void Bench_Task(void *argument)
+{
+  (void)argument;
+
+  printf("# burst_bench frame=%u burst=%u depth=%u\n", BENCH_FRAME_SIZE, BENCH_BURST, BENCH_DEPTH);
+  printf("producer,mode,frames,frames_per_s,calls,blocks\n");
+
+  Queue = osMessageQueueNew(BENCH_DEPTH, sizeof(Frame_t), NULL);
+  memset(Burst, 0x5A, sizeof(Burst));
+  xTaskCreate(Producer_Task, "Producer", configMINIMAL_STACK_SIZE * 2U, NULL, BENCH_PRIORITY - 2U, &ProducerTask);
+  xTaskCreate(Consumer_Task, "Consumer", configMINIMAL_STACK_SIZE * 4U, NULL, BENCH_PRIORITY - 1U, &ConsumerTask);
+  vPortSetInterruptHandler(BENCH_SIM_IRQ, Bench_SimIrq);
+
+  for (Batch = 0; Batch < 2U; Batch++)
+  {
+    Run(0U, BENCH_FRAMES);
+  }
+  for (Batch = 0; Batch < 2U; Batch++)
+  {
+    Run(1U, BENCH_IRQ_FRAMES);
+  }
+
+  printf("burst_check errors=%lu waiting=%lu\n", (unsigned long)Errors, (unsigned long)osMessageQueueGetCount(Queue));
+  BENCH_FAIL_IF(osMessageQueueGetCount(Queue) != 0U);
+  BENCH_Finish();
+}
+
+int main(void)
+{
+  xTaskCreate(Bench_Task, "Bench", configMINIMAL_STACK_SIZE * 4U, NULL, BENCH_PRIORITY, &BenchTask);
+  vTaskStartScheduler();
+  return 0;
+}
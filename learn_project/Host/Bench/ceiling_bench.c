@@ -0,0 +1,335 @@
+/**
+ ******************************************************************************
+ * @file    ceiling_bench.c
+ * @brief   优先级天花板互斥量 (configUSE_MUTEX_CEILING) 与优先级继承的对比
+ *
+ * chain    L 持有 A; M 持有 B 后等待 A; H 等待 B; 同时一个介于 L 和 H 之间的
+ *          Hog 任务空转. 优先级继承不传递, Hog 抢占继承到 M 优先级的 L,
+ *          H 要等 Hog 跑完; 天花板协议下 L 一拿到 A 就升到 A 的天花板,
+ *          Hog 抢不到. 输出 H 等待 B 的平均/最大时间.
+ * cost     单个任务没有竞争地获取+释放一次的平均耗时 (普通/天花板).
+ * check    获取后优先级等于天花板, 释放后恢复; 嵌套按相反顺序释放逐级恢复;
+ *          递归互斥量最后一次释放才恢复; 天花板不高于当前优先级时不变;
+ *          低优先级任务等待超时后持有者仍在天花板; 非法天花板创建失败.
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "cmsis_os2.h"
+#include "bench_util.h"
+
+#define BENCH_ROUNDS        10U
+#define BENCH_ROUND_TICKS   20U
+#define BENCH_LOW_WORK_US   4000U
+#define BENCH_MID_WORK_US   200U
+#define BENCH_HIGH_WORK_US  200U
+#define BENCH_HOG_WORK_US   6000U
+#define BENCH_COST_ITEMS    1000000U
+#define BENCH_COST_ROUNDS   5U
+#define BENCH_PRIORITY      (configMAX_PRIORITIES - 8U)
+#define BENCH_LOW_PRIORITY  (BENCH_PRIORITY - 6U)
+#define BENCH_MID_PRIORITY  (BENCH_LOW_PRIORITY + 2U)
+#define BENCH_HOG_PRIORITY  (BENCH_LOW_PRIORITY + 3U)
+#define BENCH_HIGH_PRIORITY (BENCH_LOW_PRIORITY + 4U)
+
+static osMutexId_t MutexA;
+static osMutexId_t MutexB;
+static TickType_t Start;
+static volatile uint32_t Done;
+static volatile uint32_t Inside;
+static volatile uint64_t BlockNs;
+static volatile uint64_t BlockMaxNs;
+static volatile uint8_t Taken;
+static volatile UBaseType_t WaiterPrio;
+static uint64_t LoopsPerMs;
+
+// 按循环次数计的工作量: 被抢占的时间不算在内, 与目标板上的计算相同
+static void Work(uint32_t us)
+{
+  volatile uint64_t i;
+  const uint64_t loops = (LoopsPerMs * us) / 1000U;
+
+  for (i = 0; i < loops; i++)
+  {
+  }
+}
+
+static void Calibrate(void)
+{
+  volatile uint64_t i;
+  uint64_t start = NowNs();
+
+  for (i = 0; i < 10000000U; i++)
+  {
+  }
+  LoopsPerMs = (10000000ULL * 1000000ULL) / (NowNs() - start);
+}
+
+static osMutexId_t NewMutex(uint32_t attrBits)
+{
+  osMutexAttr_t attr;
+
+  memset(&attr, 0, sizeof(attr));
+  attr.attr_bits = attrBits;
+  return osMutexNew(&attr);
+}
+
+// L: 每轮开始时获取 A
+static void Low_Task(void *argument)
+{
+  TickType_t wake = Start - BENCH_ROUND_TICKS;
+  uint32_t r;
+
+  (void)argument;
+
+  for (r = 0; r < BENCH_ROUNDS; r++)
+  {
+    vTaskDelayUntil(&wake, BENCH_ROUND_TICKS);
+    (void)osMutexAcquire(MutexA, osWaitForever);
+    Inside++;
+    Work(BENCH_LOW_WORK_US);
+    Inside--;
+    (void)osMutexRelease(MutexA);
+  }
+  Done++;
+  vTaskSuspend(NULL);
+}
+
+// M: 第 1 个节拍获取 B, 再等待 L 持有的 A
+static void Mid_Task(void *argument)
+{
+  TickType_t wake = Start - BENCH_ROUND_TICKS + 1U;
+  uint32_t r;
+
+  (void)argument;
+
+  for (r = 0; r < BENCH_ROUNDS; r++)
+  {
+    vTaskDelayUntil(&wake, BENCH_ROUND_TICKS);
+    (void)osMutexAcquire(MutexB, osWaitForever);
+    (void)osMutexAcquire(MutexA, osWaitForever);
+    BENCH_FAIL_IF(Inside != 0U);
+    Work(BENCH_MID_WORK_US);
+    (void)osMutexRelease(MutexA);
+    (void)osMutexRelease(MutexB);
+  }
+  Done++;
+  vTaskSuspend(NULL);
+}
+
+// H: 第 2 个节拍等待 M 持有的 B, 记录被阻塞的时间
+static void High_Task(void *argument)
+{
+  TickType_t wake = Start - BENCH_ROUND_TICKS + 2U;
+  uint64_t t0;
+  uint64_t ns;
+  uint32_t r;
+
+  (void)argument;
+
+  for (r = 0; r < BENCH_ROUNDS; r++)
+  {
+    vTaskDelayUntil(&wake, BENCH_ROUND_TICKS);
+    t0 = NowNs();
+    (void)osMutexAcquire(MutexB, osWaitForever);
+    ns = NowNs() - t0;
+    Work(BENCH_HIGH_WORK_US);
+    (void)osMutexRelease(MutexB);
+    BlockNs += ns;
+    BlockMaxNs = (ns > BlockMaxNs) ? ns : BlockMaxNs;
+  }
+  Done++;
+  vTaskSuspend(NULL);
+}
+
+// Hog: 与 H 同时醒来, 不用任何互斥量
+static void Hog_Task(void *argument)
+{
+  TickType_t wake = Start - BENCH_ROUND_TICKS + 2U;
+  uint32_t r;
+
+  (void)argument;
+
+  for (r = 0; r < BENCH_ROUNDS; r++)
+  {
+    vTaskDelayUntil(&wake, BENCH_ROUND_TICKS);
+    Work(BENCH_HOG_WORK_US);
+  }
+  Done++;
+  vTaskSuspend(NULL);
+}
+
+static void RunChain(uint8_t ceiling)
+{
+  TaskHandle_t tasks[4];
+  uint32_t i;
+
+  if (ceiling != 0U)
+  {
+    MutexA = NewMutex(osMutexPrioInherit | osMutexCeiling(BENCH_MID_PRIORITY));
+    MutexB = NewMutex(osMutexPrioInherit | osMutexCeiling(BENCH_HIGH_PRIORITY));
+  }
+  else
+  {
+    MutexA = NewMutex(osMutexPrioInherit);
+    MutexB = NewMutex(osMutexPrioInherit);
+  }
+  Done = 0U;
+  BlockNs = 0U;
+  BlockMaxNs = 0U;
+
+  Start = xTaskGetTickCount() + 2U;
+  xTaskCreate(Low_Task, "Low", configMINIMAL_STACK_SIZE * 2U, NULL, BENCH_LOW_PRIORITY, &tasks[0]);
+  xTaskCreate(Mid_Task, "Mid", configMINIMAL_STACK_SIZE * 2U, NULL, BENCH_MID_PRIORITY, &tasks[1]);
+  xTaskCreate(High_Task, "High", configMINIMAL_STACK_SIZE * 2U, NULL, BENCH_HIGH_PRIORITY, &tasks[2]);
+  xTaskCreate(Hog_Task, "Hog", configMINIMAL_STACK_SIZE * 2U, NULL, BENCH_HOG_PRIORITY, &tasks[3]);
+  while (Done < 4U)
+  {
+    vTaskDelay(BENCH_ROUND_TICKS);
+  }
+  for (i = 0; i < 4U; i++)
+  {
+    vTaskDelete(tasks[i]);
+  }
+
+  printf("%s,%lu,%llu,%llu\n", (ceiling != 0U) ? "ceiling" : "inherit", (unsigned long)BENCH_ROUNDS,
+         (unsigned long long)(BlockNs / BENCH_ROUNDS / 1000U), (unsigned long long)(BlockMaxNs / 1000U));
+  (void)osMutexDelete(MutexA);
+  (void)osMutexDelete(MutexB);
+}
+
+static void MeasureCost(const char *name, uint32_t attrBits)
+{
+  osMutexId_t mutex = NewMutex(attrBits);
+  uint64_t best = UINT64_MAX;
+  uint64_t start;
+  uint64_t ns;
+  uint32_t r;
+  uint32_t i;
+
+  for (r = 0; r < BENCH_COST_ROUNDS; r++)
+  {
+    start = NowNs();
+    for (i = 0; i < BENCH_COST_ITEMS; i++)
+    {
+      (void)osMutexAcquire(mutex, osWaitForever);
+      (void)osMutexRelease(mutex);
+    }
+    ns = NowNs() - start;
+    best = (ns < best) ? ns : best;
+  }
+  BENCH_FAIL_IF(uxTaskPriorityGet(NULL) != BENCH_PRIORITY);
+  (void)osMutexDelete(mutex);
+  printf("cost %s ns_per_acquire_release=%llu.%02llu\n", name, (unsigned long long)(best / BENCH_COST_ITEMS),
+         (unsigned long long)(((best % BENCH_COST_ITEMS) * 100U) / BENCH_COST_ITEMS));
+}
+
+// 低优先级任务等待 Bench 任务持有的天花板互斥量, 超时后记录持有者的优先级
+static void Waiter_Task(void *argument)
+{
+  Taken = (osMutexAcquire((osMutexId_t)argument, 5U) == osOK) ? 1U : 0U;
+  WaiterPrio = uxTaskPriorityGet(NULL);
+  vTaskSuspend(NULL);
+}
+
+static void CheckCeiling(void)
+{
+  osMutexId_t outer;
+  osMutexId_t inner;
+  TaskHandle_t waiter;
+  UBaseType_t raised;
+  UBaseType_t nested;
+  UBaseType_t unwound;
+  uint32_t i;
+
+  // 获取后升到天花板, 释放后恢复
+  outer = NewMutex(osMutexCeiling(BENCH_PRIORITY + 2U));
+  inner = NewMutex(osMutexCeiling(BENCH_PRIORITY + 4U));
+  BENCH_FAIL_IF((outer == NULL) || (inner == NULL));
+  BENCH_FAIL_IF(osMutexAcquire(outer, 0U) != osOK);
+  raised = uxTaskPriorityGet(NULL);
+  BENCH_FAIL_IF(osMutexAcquire(inner, 0U) != osOK);
+  nested = uxTaskPriorityGet(NULL);
+  (void)osMutexRelease(inner);
+  unwound = uxTaskPriorityGet(NULL);
+  (void)osMutexRelease(outer);
+  BENCH_FAIL_IF(raised != (BENCH_PRIORITY + 2U));
+  BENCH_FAIL_IF(nested != (BENCH_PRIORITY + 4U));
+  BENCH_FAIL_IF(unwound != (BENCH_PRIORITY + 2U));
+  BENCH_FAIL_IF(uxTaskPriorityGet(NULL) != BENCH_PRIORITY);
+  printf("nest base=%lu outer=%lu inner=%lu after_inner=%lu after_outer=%lu\n", (unsigned long)BENCH_PRIORITY,
+         (unsigned long)raised, (unsigned long)nested, (unsigned long)unwound, (unsigned long)uxTaskPriorityGet(NULL));
+
+  // 持有期间阻塞, 低优先级任务等待超时: 持有者不被降到天花板以下
+  Taken = 1U;
+  WaiterPrio = 0U;
+  BENCH_FAIL_IF(osMutexAcquire(outer, 0U) != osOK);
+  xTaskCreate(Waiter_Task, "Waiter", configMINIMAL_STACK_SIZE * 2U, (void *)outer, BENCH_PRIORITY - 1U, &waiter);
+  vTaskDelay(10);
+  BENCH_FAIL_IF((Taken != 0U) || (WaiterPrio != (BENCH_PRIORITY - 1U)));
+  BENCH_FAIL_IF(uxTaskPriorityGet(NULL) != (BENCH_PRIORITY + 2U));
+  (void)osMutexRelease(outer);
+  BENCH_FAIL_IF(uxTaskPriorityGet(NULL) != BENCH_PRIORITY);
+  vTaskDelete(waiter);
+  (void)osMutexDelete(outer);
+  (void)osMutexDelete(inner);
+
+  // 递归互斥量: 最后一次释放才恢复
+  outer = NewMutex(osMutexRecursive | osMutexCeiling(BENCH_PRIORITY + 3U));
+  for (i = 0; i < 3U; i++)
+  {
+    BENCH_FAIL_IF(osMutexAcquire(outer, 0U) != osOK);
+    BENCH_FAIL_IF(uxTaskPriorityGet(NULL) != (BENCH_PRIORITY + 3U));
+  }
+  for (i = 0; i < 3U; i++)
+  {
+    BENCH_FAIL_IF(uxTaskPriorityGet(NULL) != (BENCH_PRIORITY + 3U));
+    BENCH_FAIL_IF(osMutexRelease(outer) != osOK);
+  }
+  BENCH_FAIL_IF(uxTaskPriorityGet(NULL) != BENCH_PRIORITY);
+  BENCH_FAIL_IF(osMutexGetOwner(outer) != NULL);
+  (void)osMutexDelete(outer);
+
+  // 天花板等于当前优先级: 不变
+  outer = NewMutex(osMutexCeiling(BENCH_PRIORITY));
+  BENCH_FAIL_IF(osMutexAcquire(outer, 0U) != osOK);
+  BENCH_FAIL_IF(uxTaskPriorityGet(NULL) != BENCH_PRIORITY);
+  (void)osMutexRelease(outer);
+  BENCH_FAIL_IF(uxTaskPriorityGet(NULL) != BENCH_PRIORITY);
+  (void)osMutexDelete(outer);
+
+  // 非法天花板
+  BENCH_FAIL_IF(NewMutex(osMutexCeiling(0U)) != NULL);
+  BENCH_FAIL_IF(NewMutex(osMutexCeiling(configMAX_PRIORITIES)) != NULL);
+}
+
+static void Bench_Task(void *argument)
+{
+  (void)argument;
+
+  Calibrate();
+  printf("# ceiling_bench unit=us rounds=%u low_work=%u hog_work=%u\n", BENCH_ROUNDS, BENCH_LOW_WORK_US,
+         BENCH_HOG_WORK_US);
+  printf("protocol,rounds,high_block_avg,high_block_max\n");
+  RunChain(0U);
+  RunChain(1U);
+
+  MeasureCost("inherit", osMutexPrioInherit);
+  MeasureCost("ceiling", osMutexCeiling(BENCH_PRIORITY + 2U));
+
+  CheckCeiling();
+  printf("ceiling_check errors=%lu\n", (unsigned long)Errors);
+  BENCH_Finish();
+}
+
+int main(void)
+{
+  xTaskCreate(Bench_Task, "Bench", configMINIMAL_STACK_SIZE * 4U, NULL, BENCH_PRIORITY, NULL);
+  vTaskStartScheduler();
+  return 0;
+}
@@ -0,0 +1,208 @@
+/**
+ ******************************************************************************
+ * @file    delay_bench.c
+ * @brief   延时任务数量对阻塞和节拍处理耗时的影响
+ *
+ * 逐步增加以 vTaskDelay 周期运行的休眠任务 (10 到 1000 个), 每一档测量:
+ *   block  测试任务带超时阻塞 (加入延时列表) 到辅助任务开始运行的时间
+ *   tick   用 xTaskCatchUpTicks 补处理节拍时平均每个节拍的耗时
+ * 延时列表为有序链表时 block 随任务数线性增长, 时间轮 (delay_bench_wheel,
+ * 见 configUSE_DELAYED_TIMING_WHEEL) 下与任务数无关. 有序链表的 tick 只与
+ * 每个节拍唤醒的任务数有关; 时间轮的槽不排序, 到达一个槽的节拍要看完槽内
+ * 所有任务 (约为任务数 / configTIMING_WHEEL_SLOTS), 所以 tick 比有序链表慢,
+ * 任务越多差得越多.
+ * 结束前检查休眠任务的唤醒: 早于延时到期醒来, 或到期后仍在阻塞 (漏唤醒)
+ * 都输出 "# FAIL".
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "bench_util.h"
+
+#define BENCH_MAX_SLEEPERS  1000U
+#define BENCH_SLEEPER_STACK 64U
+#define BENCH_MIN_PERIOD    50U       // 休眠任务的周期范围, 单位为节拍
+#define BENCH_MAX_PERIOD    500U
+#define BENCH_SAMPLES       200U
+#define BENCH_TICKS_PER_RUN 8U        // 每次 xTaskCatchUpTicks 处理的节拍数
+#define BENCH_PRIORITY      (configMAX_PRIORITIES - 8U)
+#define BENCH_WAKE_SLACK    2U        // 结束检查时允许尚未运行的节拍数
+
+static const uint32_t Levels[] = { 10U, 30U, 100U, 300U, 1000U };
+
+static StaticTask_t SleeperTcb[BENCH_MAX_SLEEPERS];
+static StackType_t SleeperStack[BENCH_MAX_SLEEPERS][BENCH_SLEEPER_STACK];
+static TickType_t SleeperPeriod[BENCH_MAX_SLEEPERS];
+static volatile TickType_t SleeperWakeAt[BENCH_MAX_SLEEPERS];   // 本次延时应当唤醒的节拍
+static uint32_t Sleepers;
+static volatile uint32_t Wakes;
+static volatile uint32_t EarlyWakes;
+
+static TaskHandle_t BenchTask;
+static TaskHandle_t PartnerTask;
+static volatile uint64_t Stamp;
+static uint64_t Samples[BENCH_SAMPLES];
+static volatile uint32_t SampleCount;
+
+static TickType_t RandomPeriod(void)
+{
+  return (TickType_t)(BENCH_MIN_PERIOD + ((uint32_t)rand() % (BENCH_MAX_PERIOD - BENCH_MIN_PERIOD)));
+}
+
+static void Sleeper_Task(void *argument)
+{
+  uint32_t index = (uint32_t)(uintptr_t)argument;
+  TickType_t delay = RandomPeriod();    // 第一次延时错开各任务的起始相位
+
+  for (;;)
+  {
+    // 在这之后才阻塞的话只会晚醒, 不会误判为早醒
+    SleeperWakeAt[index] = xTaskGetTickCount() + delay;
+    vTaskDelay(delay);
+    if (xTaskGetTickCount() < SleeperWakeAt[index])
+    {
+      EarlyWakes++;
+    }
+    Wakes++;
+    delay = SleeperPeriod[index];
+  }
+}
+
+// 测试任务阻塞后运行, 记录从阻塞开始到这里的时间后唤醒测试任务
+static void Partner_Task(void *argument)
+{
+  (void)argument;
+
+  for (;;)
+  {
+    (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    Samples[SampleCount++] = NowNs() - Stamp;
+    xTaskNotifyGive(BenchTask);
+  }
+}
+
+static int CompareU64(const void *a, const void *b)
+{
+  uint64_t x = *(const uint64_t *)a;
+  uint64_t y = *(const uint64_t *)b;
+
+  return (x > y) - (x < y);
+}
+
+static void Report(uint32_t tasks, const char *name)
+{
+  uint64_t sum = 0;
+  uint32_t i;
+
+  qsort(Samples, BENCH_SAMPLES, sizeof(Samples[0]), CompareU64);
+  for (i = 0; i < BENCH_SAMPLES; i++)
+  {
+    sum += Samples[i];
+  }
+  printf("%lu,%s,%u,%llu,%llu,%llu,%llu\n", (unsigned long)tasks, name, BENCH_SAMPLES,
+         (unsigned long long)Samples[0], (unsigned long long)(sum / BENCH_SAMPLES),
+         (unsigned long long)Samples[(BENCH_SAMPLES * 99U) / 100U],
+         (unsigned long long)Samples[BENCH_SAMPLES - 1U]);
+}
+
+static void AddSleepers(uint32_t count)
+{
+  while (Sleepers < count)
+  {
+    SleeperPeriod[Sleepers] = RandomPeriod();
+    xTaskCreateStatic(Sleeper_Task, "Sleeper", BENCH_SLEEPER_STACK, (void *)(uintptr_t)Sleepers,
+                      tskIDLE_PRIORITY + 1U, SleeperStack[Sleepers], &SleeperTcb[Sleepers]);
+    Sleepers++;
+  }
+  // 让所有休眠任务进入周期运行
+  vTaskDelay(BENCH_MAX_PERIOD * 2U);
+}
+
+static void MeasureBlock(void)
+{
+  uint32_t i;
+
+  SampleCount = 0;
+  for (i = 0; i < BENCH_SAMPLES; i++)
+  {
+    xTaskNotifyGive(PartnerTask);
+    Stamp = NowNs();
+    (void)ulTaskNotifyTake(pdTRUE, RandomPeriod());
+  }
+}
+
+static void MeasureTick(void)
+{
+  uint64_t start;
+  uint32_t i;
+
+  for (i = 0; i < BENCH_SAMPLES; i++)
+  {
+    // 让这段时间内到期的休眠任务运行并重新阻塞
+    vTaskDelay(1);
+    start = NowNs();
+    (void)xTaskCatchUpTicks(BENCH_TICKS_PER_RUN);
+    Samples[i] = (NowNs() - start) / BENCH_TICKS_PER_RUN;
+  }
+}
+
+// 让补处理节拍时唤醒的休眠任务都运行后, 检查有没有应当唤醒却仍在阻塞的任务
+static void CheckWakes(void)
+{
+  TickType_t now;
+  uint32_t missed = 0;
+  uint32_t i;
+
+  vTaskDelay(BENCH_WAKE_SLACK * 5U);
+  vTaskSuspendAll();
+  now = xTaskGetTickCount();
+  for (i = 0; i < Sleepers; i++)
+  {
+    if ((SleeperWakeAt[i] + BENCH_WAKE_SLACK) <= now)
+    {
+      missed++;
+    }
+  }
+  (void)xTaskResumeAll();
+
+  printf("delay_check wakes=%lu early=%lu missed=%lu\n", (unsigned long)Wakes,
+         (unsigned long)EarlyWakes, (unsigned long)missed);
+  BENCH_FAIL_IF(Wakes == 0U);
+  BENCH_FAIL_IF(EarlyWakes != 0U);
+  BENCH_FAIL_IF(missed != 0U);
+}
+
+static void Bench_Task(void *argument)
+{
+  uint32_t i;
+
+  (void)argument;
+
+  printf("# delay_bench unit=ns wheel=%d slots=%d\n", configUSE_DELAYED_TIMING_WHEEL, configTIMING_WHEEL_SLOTS);
+  printf("tasks,op,n,min,avg,p99,max\n");
+  xTaskCreate(Partner_Task, "Partner", configMINIMAL_STACK_SIZE, NULL, BENCH_PRIORITY - 1U, &PartnerTask);
+
+  for (i = 0; i < sizeof(Levels) / sizeof(Levels[0]); i++)
+  {
+    AddSleepers(Levels[i]);
+    MeasureBlock();
+    Report(Levels[i], "block");
+    MeasureTick();
+    Report(Levels[i], "tick");
+  }
+  CheckWakes();
+
+  BENCH_Finish();
+}
+
+int main(void)
+{
+  srand(1);
+  xTaskCreate(Bench_Task, "Bench", configMINIMAL_STACK_SIZE * 4U, NULL, BENCH_PRIORITY, &BenchTask);
+  vTaskStartScheduler();
+  return 0;
+}
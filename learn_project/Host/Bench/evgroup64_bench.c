@@ -0,0 +1,418 @@
+/**
+ ******************************************************************************
+ * @file    evgroup64_bench.c
+ * @brief   64 位事件组 (configUSE_64_BIT_EVENT_GROUPS) 的耗时和正确性
+ *
+ * cost     一个任务等 40 个事件全部发生 (AND), 另一个任务逐个置位.
+ *          split  24 位事件组放不下, 拆成两个事件组 (24 + 16 位), 等待方
+ *                 先等第一组再等第二组, 每轮被唤醒两次
+ *          wide   一个 64 位事件组, 一次等待, 每轮被唤醒一次
+ *          另测没有等待者时置位+清除一位的耗时 (24 位 / 64 位), 64 位事件组
+ *          读写位都要关中断.
+ *          每项测 BENCH_COST_ROUNDS 轮取最小值.
+ * check    AND/OR/退出时清除, bit55, 超时后再置位, xEventGroup64Sync,
+ *          删除事件组时唤醒所有等待者, 静态创建.
+ * isr      模拟中断里 osEventFlagsSet64 两次只转发一次, 中断里清除会取消
+ *          还没转发的置位, osEventFlagsClear64 直接清除.
+ * cmsis    osEventFlagsWide 属性, 32 位接口访问宽事件组的 bit0~30,
+ *          错误码按 osFlagsError64 符号扩展.
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "event_groups.h"
+#include "event_groups64.h"
+#include "cmsis_os2.h"
+#include "bench_util.h"
+
+#define BENCH_ROUNDS        20000U
+#define BENCH_SET_ITEMS     100000U
+#define BENCH_COST_ROUNDS   5U
+#define BENCH_EVENTS        40U
+#define BENCH_LOW_BITS      24U
+#define BENCH_LOW_MASK      0x00FFFFFFU
+#define BENCH_HIGH_MASK     ((1UL << (BENCH_EVENTS - BENCH_LOW_BITS)) - 1U)
+#define BENCH_WIDE_MASK     ((1ULL << BENCH_EVENTS) - 1U)
+#define BENCH_BIT(n)        (1ULL << (n))
+#define BENCH_PRIORITY      (configMAX_PRIORITIES - 8U)
+#define BENCH_SIM_IRQ       12U       // 与其他测试和 uart_sim 的中断号错开
+
+typedef struct
+{
+  EventBits64_t bits;
+  BaseType_t clear;
+  BaseType_t all;
+  volatile EventBits64_t result;
+  volatile uint8_t done;
+} Waiter_t;
+
+static EventGroupHandle_t Low;
+static EventGroupHandle_t High;
+static EventGroup64Handle_t Wide;
+static osEventFlagsId_t WideFlags;
+static volatile uint32_t Completed;
+static volatile uint8_t Stop;
+static volatile uint32_t SyncDone;
+static volatile uint32_t IsrMode;
+static volatile uint64_t IsrResult;
+
+// 40 个事件分在两个事件组里, 先等齐第一组再等齐第二组
+static void Split_Task(void *argument)
+{
+  (void)argument;
+
+  while (Stop == 0U)
+  {
+    if ((xEventGroupWaitBits(Low, BENCH_LOW_MASK, pdTRUE, pdTRUE, portMAX_DELAY) & BENCH_LOW_MASK) != BENCH_LOW_MASK)
+    {
+      continue;
+    }
+    if ((xEventGroupWaitBits(High, BENCH_HIGH_MASK, pdTRUE, pdTRUE, portMAX_DELAY) & BENCH_HIGH_MASK) == BENCH_HIGH_MASK)
+    {
+      Completed++;
+    }
+  }
+  vTaskSuspend(NULL);
+}
+
+// 40 个事件在一个 64 位事件组里, 一次等齐
+static void Wide_Task(void *argument)
+{
+  (void)argument;
+
+  while (Stop == 0U)
+  {
+    if ((xEventGroup64WaitBits(Wide, BENCH_WIDE_MASK, pdTRUE, pdTRUE, portMAX_DELAY) & BENCH_WIDE_MASK) == BENCH_WIDE_MASK)
+    {
+      Completed++;
+    }
+  }
+  vTaskSuspend(NULL);
+}
+
+static void MeasureCost(void)
+{
+  TaskHandle_t task;
+  uint64_t bestSplit = UINT64_MAX;
+  uint64_t bestWide = UINT64_MAX;
+  uint64_t bestSet = UINT64_MAX;
+  uint64_t bestSet64 = UINT64_MAX;
+  uint64_t start;
+  uint64_t ns;
+  uint32_t r;
+  uint32_t i;
+  uint32_t e;
+
+  // 两个 24 位事件组
+  Low = xEventGroupCreate();
+  High = xEventGroupCreate();
+  Stop = 0U;
+  Completed = 0;
+  xTaskCreate(Split_Task, "Split", configMINIMAL_STACK_SIZE * 2U, NULL, BENCH_PRIORITY + 1U, &task);
+  for (r = 0; r < BENCH_COST_ROUNDS; r++)
+  {
+    start = NowNs();
+    for (i = 0; i < BENCH_ROUNDS; i++)
+    {
+      for (e = 0; e < BENCH_EVENTS; e++)
+      {
+        if (e < BENCH_LOW_BITS)
+        {
+          (void)xEventGroupSetBits(Low, (EventBits_t)1U << e);
+        }
+        else
+        {
+          (void)xEventGroupSetBits(High, (EventBits_t)1U << (e - BENCH_LOW_BITS));
+        }
+      }
+    }
+    ns = NowNs() - start;
+    bestSplit = (ns < bestSplit) ? ns : bestSplit;
+  }
+  BENCH_FAIL_IF(Completed != (BENCH_COST_ROUNDS * BENCH_ROUNDS));
+
+  for (r = 0; r < BENCH_COST_ROUNDS; r++)
+  {
+    start = NowNs();
+    for (i = 0; i < BENCH_SET_ITEMS; i++)
+    {
+      (void)xEventGroupSetBits(High, 0x800000U);
+      (void)xEventGroupClearBits(High, 0x800000U);
+    }
+    ns = NowNs() - start;
+    bestSet = (ns < bestSet) ? ns : bestSet;
+  }
+
+  Stop = 1U;
+  vEventGroupDelete(Low);
+  vEventGroupDelete(High);
+  vTaskDelete(task);
+
+  // 一个 64 位事件组
+  Wide = xEventGroup64Create();
+  Stop = 0U;
+  Completed = 0;
+  xTaskCreate(Wide_Task, "Wide", configMINIMAL_STACK_SIZE * 2U, NULL, BENCH_PRIORITY + 1U, &task);
+  for (r = 0; r < BENCH_COST_ROUNDS; r++)
+  {
+    start = NowNs();
+    for (i = 0; i < BENCH_ROUNDS; i++)
+    {
+      for (e = 0; e < BENCH_EVENTS; e++)
+      {
+        (void)xEventGroup64SetBits(Wide, BENCH_BIT(e));
+      }
+    }
+    ns = NowNs() - start;
+    bestWide = (ns < bestWide) ? ns : bestWide;
+  }
+  BENCH_FAIL_IF(Completed != (BENCH_COST_ROUNDS * BENCH_ROUNDS));
+
+  for (r = 0; r < BENCH_COST_ROUNDS; r++)
+  {
+    start = NowNs();
+    for (i = 0; i < BENCH_SET_ITEMS; i++)
+    {
+      (void)xEventGroup64SetBits(Wide, BENCH_BIT(55));
+      (void)xEventGroup64ClearBits(Wide, BENCH_BIT(55));
+    }
+    ns = NowNs() - start;
+    bestSet64 = (ns < bestSet64) ? ns : bestSet64;
+  }
+
+  Stop = 1U;
+  vEventGroup64Delete(Wide);
+  vTaskDelete(task);
+
+  printf("split,%llu,%llu.%02llu\n", (unsigned long long)(bestSplit / BENCH_ROUNDS),
+         (unsigned long long)(bestSet / BENCH_SET_ITEMS),
+         (unsigned long long)(((bestSet % BENCH_SET_ITEMS) * 100U) / BENCH_SET_ITEMS));
+  printf("wide,%llu,%llu.%02llu\n", (unsigned long long)(bestWide / BENCH_ROUNDS),
+         (unsigned long long)(bestSet64 / BENCH_SET_ITEMS),
+         (unsigned long long)(((bestSet64 % BENCH_SET_ITEMS) * 100U) / BENCH_SET_ITEMS));
+}
+
+static void Waiter_Task(void *argument)
+{
+  Waiter_t *waiter = argument;
+
+  waiter->result = xEventGroup64WaitBits(Wide, waiter->bits, waiter->clear, waiter->all, portMAX_DELAY);
+  waiter->done = 1U;
+  vTaskSuspend(NULL);
+}
+
+static TaskHandle_t StartWaiter(Waiter_t *waiter, EventBits64_t bits, BaseType_t clear, BaseType_t all)
+{
+  TaskHandle_t task;
+
+  waiter->bits = bits;
+  waiter->clear = clear;
+  waiter->all = all;
+  waiter->result = 0;
+  waiter->done = 0U;
+  // 优先级高于测试任务, 创建后立即运行并阻塞, 被唤醒时也立即运行
+  xTaskCreate(Waiter_Task, "Waiter", configMINIMAL_STACK_SIZE * 2U, waiter, BENCH_PRIORITY + 1U, &task);
+  return task;
+}
+
+// 每个任务置自己的一位, 等三位都置位
+static void Sync_Task(void *argument)
+{
+  EventBits64_t bit = BENCH_BIT((uint32_t)(uintptr_t)argument);
+  EventBits64_t all = BENCH_BIT(40) | BENCH_BIT(48) | BENCH_BIT(55);
+
+  if ((xEventGroup64Sync(Wide, bit, all, portMAX_DELAY) & all) == all)
+  {
+    SyncDone++;
+  }
+  vTaskSuspend(NULL);
+}
+
+static void CheckSemantics(void)
+{
+  static StaticEventGroup64_t buffer;
+  EventBits64_t all = BENCH_BIT(40) | BENCH_BIT(48) | BENCH_BIT(55);
+  Waiter_t a;
+  Waiter_t b;
+  TaskHandle_t ta;
+  TaskHandle_t tb;
+
+  Wide = xEventGroup64CreateStatic(&buffer);
+  BENCH_FAIL_IF(xEventGroup64GetBits(Wide) != 0U);
+
+  // OR: 置 bit55 即唤醒, 不清除
+  ta = StartWaiter(&a, BENCH_BIT(55) | BENCH_BIT(0), pdFALSE, pdFALSE);
+  (void)xEventGroup64SetBits(Wide, BENCH_BIT(55));
+  BENCH_FAIL_IF((a.done == 0U) || (a.result != BENCH_BIT(55)));
+  BENCH_FAIL_IF(xEventGroup64GetBits(Wide) != BENCH_BIT(55));
+  vTaskDelete(ta);
+  (void)xEventGroup64ClearBits(Wide, BENCH_BIT(55));
+
+  // AND 40 位, 退出时清除: 只差一位时不唤醒
+  ta = StartWaiter(&a, BENCH_WIDE_MASK, pdTRUE, pdTRUE);
+  (void)xEventGroup64SetBits(Wide, BENCH_WIDE_MASK & ~BENCH_BIT(33));
+  BENCH_FAIL_IF(a.done != 0U);
+  (void)xEventGroup64SetBits(Wide, BENCH_BIT(33) | BENCH_BIT(50));
+  BENCH_FAIL_IF((a.done == 0U) || (a.result != (BENCH_WIDE_MASK | BENCH_BIT(50))));
+  BENCH_FAIL_IF(xEventGroup64GetBits(Wide) != BENCH_BIT(50));
+  vTaskDelete(ta);
+
+  // 两个等待者都被唤醒, 其中一个要求清除
+  (void)xEventGroup64ClearBits(Wide, BENCH_BIT(50));
+  ta = StartWaiter(&a, BENCH_BIT(50), pdTRUE, pdFALSE);
+  tb = StartWaiter(&b, BENCH_BIT(50) | BENCH_BIT(31), pdFALSE, pdTRUE);
+  (void)xEventGroup64SetBits(Wide, BENCH_BIT(31) | BENCH_BIT(50));
+  BENCH_FAIL_IF((a.done == 0U) || (b.done == 0U));
+  BENCH_FAIL_IF((a.result != (BENCH_BIT(31) | BENCH_BIT(50))) || (b.result != (BENCH_BIT(31) | BENCH_BIT(50))));
+  BENCH_FAIL_IF(xEventGroup64GetBits(Wide) != BENCH_BIT(31));
+  vTaskDelete(ta);
+  vTaskDelete(tb);
+  (void)xEventGroup64ClearBits(Wide, BENCH_BIT(31));
+
+  // 等待超时后再置位: 没有任务被唤醒, 位保持置位
+  BENCH_FAIL_IF(xEventGroup64WaitBits(Wide, BENCH_BIT(45), pdTRUE, pdFALSE, 2U) != 0U);
+  BENCH_FAIL_IF(xEventGroup64SetBits(Wide, BENCH_BIT(45)) != BENCH_BIT(45));
+  (void)xEventGroup64ClearBits(Wide, BENCH_BIT(45));
+
+  // 三方汇合: 两个任务先到达并阻塞, 测试任务最后到达
+  SyncDone = 0;
+  xTaskCreate(Sync_Task, "Sync", configMINIMAL_STACK_SIZE * 2U, (void *)(uintptr_t)40U, BENCH_PRIORITY + 1U, &ta);
+  xTaskCreate(Sync_Task, "Sync", configMINIMAL_STACK_SIZE * 2U, (void *)(uintptr_t)48U, BENCH_PRIORITY + 1U, &tb);
+  BENCH_FAIL_IF(SyncDone != 0U);
+  BENCH_FAIL_IF((xEventGroup64Sync(Wide, BENCH_BIT(55), all, 10U) & all) != all);
+  BENCH_FAIL_IF((SyncDone != 2U) || (xEventGroup64GetBits(Wide) != 0U));
+  vTaskDelete(ta);
+  vTaskDelete(tb);
+
+  // 删除事件组: 等待者都返回 0
+  ta = StartWaiter(&a, BENCH_BIT(1), pdFALSE, pdFALSE);
+  tb = StartWaiter(&b, BENCH_BIT(1) | BENCH_BIT(52), pdFALSE, pdTRUE);
+  vEventGroup64Delete(Wide);
+  BENCH_FAIL_IF((a.done == 0U) || (b.done == 0U) || (a.result != 0U) || (b.result != 0U));
+  vTaskDelete(ta);
+  vTaskDelete(tb);
+
+  printf("evgroup64_check errors=%lu\n", (unsigned long)Errors);
+}
+
+static uint32_t Bench_SimIrq(void)
+{
+  BaseType_t woken = pdFALSE;
+
+  switch (IsrMode)
+  {
+    case 0U:
+      // 两次置位, 只占定时器命令队列的一个位置
+      (void)xEventGroup64SetBitsFromISR(Wide, BENCH_BIT(33), &woken);
+      (void)xEventGroup64SetBitsFromISR(Wide, BENCH_BIT(54), &woken);
+      break;
+    case 1U:
+      // 置位后马上清除, 转发的置位不再生效
+      (void)xEventGroup64SetBitsFromISR(Wide, BENCH_BIT(20) | BENCH_BIT(44), &woken);
+      (void)xEventGroup64ClearBitsFromISR(Wide, BENCH_BIT(44));
+      break;
+    default:
+      // 经 CMSIS: 清除直接生效
+      IsrResult = osEventFlagsClear64(WideFlags, BENCH_BIT(53));
+      break;
+  }
+  return (uint32_t)woken;
+}
+
+static void CheckIsr(void)
+{
+  Waiter_t a;
+  TaskHandle_t ta;
+  uint32_t direct;
+
+  Wide = xEventGroup64Create();
+  vPortSetInterruptHandler(BENCH_SIM_IRQ, Bench_SimIrq);
+
+  IsrMode = 0U;
+  ta = StartWaiter(&a, BENCH_BIT(33) | BENCH_BIT(54), pdTRUE, pdTRUE);
+  vPortGenerateSimulatedInterrupt(BENCH_SIM_IRQ);
+  direct = a.done;
+  vTaskDelay(2);
+  BENCH_FAIL_IF((direct != 0U) || (a.done == 0U) || (a.result != (BENCH_BIT(33) | BENCH_BIT(54))));
+  BENCH_FAIL_IF(xEventGroup64GetBits(Wide) != 0U);
+  vTaskDelete(ta);
+
+  IsrMode = 1U;
+  vPortGenerateSimulatedInterrupt(BENCH_SIM_IRQ);
+  vTaskDelay(2);
+  BENCH_FAIL_IF(xEventGroup64GetBits(Wide) != BENCH_BIT(20));
+  vEventGroup64Delete(Wide);
+
+  printf("evgroup64_isr direct=%lu errors=%lu\n", (unsigned long)direct, (unsigned long)Errors);
+}
+
+static void CheckCmsis(void)
+{
+  static StaticEventGroup64_t buffer;
+  osEventFlagsAttr_t attr = {0};
+  osEventFlagsId_t narrow;
+
+  attr.attr_bits = osEventFlagsWide;
+  WideFlags = osEventFlagsNew(&attr);
+  narrow = osEventFlagsNew(NULL);
+  BENCH_FAIL_IF((WideFlags == NULL) || (narrow == NULL));
+
+  BENCH_FAIL_IF(osEventFlagsSet64(WideFlags, BENCH_BIT(55) | BENCH_BIT(53)) != (BENCH_BIT(55) | BENCH_BIT(53)));
+  BENCH_FAIL_IF(osEventFlagsWait64(WideFlags, BENCH_BIT(55), osFlagsWaitAny, 0U) != (BENCH_BIT(55) | BENCH_BIT(53)));
+  BENCH_FAIL_IF(osEventFlagsWait64(WideFlags, BENCH_BIT(55), osFlagsWaitAny, 0U) != osFlagsError64(osFlagsErrorResource));
+  BENCH_FAIL_IF(osEventFlagsWait64(WideFlags, BENCH_BIT(54), osFlagsWaitAll, 2U) != osFlagsError64(osFlagsErrorTimeout));
+  BENCH_FAIL_IF(osEventFlagsSet64(WideFlags, BENCH_BIT(56)) != osFlagsError64(osFlagsErrorParameter));
+  BENCH_FAIL_IF(osEventFlagsSet64(narrow, 1U) != osFlagsError64(osFlagsErrorParameter));
+
+  // 中断里清除
+  IsrMode = 2U;
+  vPortGenerateSimulatedInterrupt(BENCH_SIM_IRQ);
+  BENCH_FAIL_IF((IsrResult != BENCH_BIT(53)) || (osEventFlagsGet64(WideFlags) != 0U));
+
+  // 32 位接口: bit0~30 可用, bit31 是参数错误, 结果不含高位
+  (void)osEventFlagsSet64(WideFlags, BENCH_BIT(50));
+  BENCH_FAIL_IF(osEventFlagsSet(WideFlags, 0x40000001U) != 0x40000001U);
+  BENCH_FAIL_IF(osEventFlagsSet(WideFlags, 0x80000000U) != osFlagsErrorParameter);
+  BENCH_FAIL_IF(osEventFlagsWait(WideFlags, 0x40000000U, osFlagsWaitAll, 0U) != 0x40000001U);
+  BENCH_FAIL_IF(osEventFlagsClear(WideFlags, 0x01U) != 0x01U);
+  BENCH_FAIL_IF(osEventFlagsGet(WideFlags) != 0U);
+  BENCH_FAIL_IF(osEventFlagsGet64(WideFlags) != BENCH_BIT(50));
+  BENCH_FAIL_IF(osEventFlagsWait(WideFlags, 0x02U, osFlagsWaitAny, 0U) != osFlagsErrorResource);
+  BENCH_FAIL_IF(osEventFlagsDelete(WideFlags) != osOK);
+  BENCH_FAIL_IF(osEventFlagsDelete(narrow) != osOK);
+
+  // 静态创建, 控制块太小时失败
+  attr.cb_mem = &buffer;
+  attr.cb_size = sizeof(buffer) - 1U;
+  BENCH_FAIL_IF(osEventFlagsNew(&attr) != NULL);
+  attr.cb_size = sizeof(buffer);
+  WideFlags = osEventFlagsNew(&attr);
+  BENCH_FAIL_IF((WideFlags == NULL) || (osEventFlagsSet64(WideFlags, BENCH_BIT(52)) != BENCH_BIT(52)));
+  BENCH_FAIL_IF(osEventFlagsDelete(WideFlags) != osOK);
+
+  printf("evgroup64_cmsis errors=%lu\n", (unsigned long)Errors);
+}
+
+static void Bench_Task(void *argument)
+{
+  (void)argument;
+
+  printf("# evgroup64_bench unit=ns events=%u rounds=%u\n", (unsigned)BENCH_EVENTS, (unsigned)BENCH_ROUNDS);
+  printf("groups,round_ns,set_clear_ns\n");
+  MeasureCost();
+
+  CheckSemantics();
+  CheckIsr();
+  CheckCmsis();
+  BENCH_Finish();
+}
+
+int main(void)
+{
+  xTaskCreate(Bench_Task, "Bench", configMINIMAL_STACK_SIZE * 4U, NULL, BENCH_PRIORITY, NULL);
+  vTaskStartScheduler();
+  return 0;
+}
@@ -0,0 +1,446 @@
+/**
+ ******************************************************************************
+ * @file    evgroup_bench.c
+ * @brief   事件组按位索引等待者 (configUSE_EVENT_GROUP_INDEX) 的耗时和正确性
+ *
+ * cost     1~64 个任务阻塞在事件组上, 每个只等一位, 轮流分布在 bit1~bit22
+ *          上 (多于 22 个时有任务等同一位). 默认只索引 bit0~bit7, 所以等
+ *          bit8 及以上的任务在普通链表上. 测量:
+ *          set        置位+清除没有任务等待的 bit0 的平均耗时. 原实现要遍历
+ *                     全部等待者; 索引后普通链表由等待位掩码跳过, 与索引
+ *                     本身无关
+ *          set_in     置位有一个同优先级任务等待的 bit0 (索引内) 的耗时,
+ *                     只计 xEventGroupSetBits 本身, 被唤醒的任务在测试任务
+ *                     让出 CPU 后再次等待
+ *          set_above  同上, 但等的是 bit23 (索引外), 要遍历普通链表
+ *          每项测 BENCH_COST_ROUNDS 轮取最小值, 与 evgroup_bench_noindex
+ *          (关闭索引的内核) 的结果比较. set_in 和 set_above 含两次 NowNs()
+ *          的开销.
+ * check    AND/OR/退出时清除, xEventGroupSync, 超时后再置位, 索引范围外的
+ *          位, 删除事件组时唤醒所有等待者.
+ * isr      模拟中断里 xEventGroupSetBitsFromISR: 等待者不超过
+ *          configEVENT_GROUP_ISR_WAKE_LIMIT 个时应在中断返回时已被唤醒
+ *          (configUSE_EVENT_GROUP_ISR_SET), 超过上限或有等待多个位的任务时
+ *          经定时器服务任务转发, 最终也都被唤醒.
+ *          同一中断里先后清除和置位, 包括前面的置位被转发时, 结果应与
+ *          按调用顺序执行一致.
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "event_groups.h"
+#include "bench_util.h"
+
+#define BENCH_SET_ITEMS     100000U
+#define BENCH_WAKE_ITEMS    2000U
+#define BENCH_COST_ROUNDS   5U
+#define BENCH_MAX_WAITERS   64U
+#define BENCH_WAIT_BITS     22U       // 等待者分布在 bit1~bit22
+#define BENCH_IN_BIT        0x01U     // 索引内, 没有其他任务等
+#define BENCH_ABOVE_BIT     0x800000U // bit23, 索引外, 没有其他任务等
+#define BENCH_ISR_WAITERS   (configEVENT_GROUP_ISR_WAKE_LIMIT + 1U)
+#define BENCH_PRIORITY      (configMAX_PRIORITIES - 8U)
+#define BENCH_SIM_IRQ       11U       // 与其他测试和 uart_sim 的中断号错开
+
+// 模拟中断里依次执行的一次置位或清除
+typedef struct
+{
+  uint8_t clear;
+  EventBits_t bits;
+} IsrOp_t;
+
+typedef struct
+{
+  EventBits_t bits;
+  BaseType_t clear;
+  BaseType_t all;
+  volatile EventBits_t result;
+  volatile uint8_t done;
+} Waiter_t;
+
+static EventGroupHandle_t Group;
+static volatile uint32_t ParkedDone;
+static volatile uint32_t Woken;
+static volatile EventBits_t WakerBit;
+static volatile uint32_t SyncDone;
+static IsrOp_t IsrOps[3];
+static volatile uint32_t IsrOpCount;
+
+// 阻塞等待一位, 直到事件组被删除
+static void Parked_Task(void *argument)
+{
+  EventBits_t bits = (EventBits_t)(uintptr_t)argument;
+
+  if (xEventGroupWaitBits(Group, bits, pdFALSE, pdFALSE, portMAX_DELAY) == 0U)
+  {
+    ParkedDone++;
+  }
+  vTaskSuspend(NULL);
+}
+
+// 等 WakerBit (退出时清除), 每被唤醒一次计数一次, 阻塞时被测试任务删除
+static void Waker_Task(void *argument)
+{
+  (void)argument;
+
+  for (;;)
+  {
+    if ((xEventGroupWaitBits(Group, WakerBit, pdTRUE, pdFALSE, portMAX_DELAY) & WakerBit) != 0U)
+    {
+      Woken++;
+    }
+  }
+}
+
+// 置位唤醒与测试任务同优先级的 Waker_Task, 只计置位调用本身的耗时.
+// 同优先级不会在置位时切换, taskYIELD() 后唤醒的任务再次等待
+static uint64_t MeasureWake(EventBits_t bit)
+{
+  TaskHandle_t waker;
+  uint64_t best = UINT64_MAX;
+  uint64_t start;
+  uint64_t ns;
+  uint32_t r;
+  uint32_t i;
+
+  Woken = 0;
+  WakerBit = bit;
+  xTaskCreate(Waker_Task, "Waker", configMINIMAL_STACK_SIZE * 2U, NULL, BENCH_PRIORITY, &waker);
+  taskYIELD();
+  for (r = 0; r < BENCH_COST_ROUNDS; r++)
+  {
+    ns = 0;
+    for (i = 0; i < BENCH_WAKE_ITEMS; i++)
+    {
+      start = NowNs();
+      (void)xEventGroupSetBits(Group, bit);
+      ns += NowNs() - start;
+      taskYIELD();
+    }
+    best = (ns < best) ? ns : best;
+  }
+  BENCH_FAIL_IF(Woken != (BENCH_COST_ROUNDS * BENCH_WAKE_ITEMS));
+  BENCH_FAIL_IF((xEventGroupGetBits(Group) & bit) != 0U);
+  vTaskDelete(waker);
+  return best;
+}
+
+static void MeasureWaiters(uint32_t waiters)
+{
+  TaskHandle_t parked[BENCH_MAX_WAITERS];
+  uint64_t bestSet = UINT64_MAX;
+  uint64_t bestIn;
+  uint64_t bestAbove;
+  uint64_t start;
+  uint64_t ns;
+  uint32_t r;
+  uint32_t i;
+
+  Group = xEventGroupCreate();
+  ParkedDone = 0;
+  for (i = 0; i < waiters; i++)
+  {
+    xTaskCreate(Parked_Task, "Parked", configMINIMAL_STACK_SIZE, (void *)(uintptr_t)(1UL << (1U + (i % BENCH_WAIT_BITS))),
+                BENCH_PRIORITY + 1U, &parked[i]);
+  }
+
+  for (r = 0; r < BENCH_COST_ROUNDS; r++)
+  {
+    start = NowNs();
+    for (i = 0; i < BENCH_SET_ITEMS; i++)
+    {
+      (void)xEventGroupSetBits(Group, 0x01U);
+      (void)xEventGroupClearBits(Group, 0x01U);
+    }
+    ns = NowNs() - start;
+    bestSet = (ns < bestSet) ? ns : bestSet;
+  }
+
+  bestIn = MeasureWake(BENCH_IN_BIT);
+  bestAbove = MeasureWake(BENCH_ABOVE_BIT);
+
+  // 删除事件组唤醒所有等待者
+  vEventGroupDelete(Group);
+  vTaskDelay(2);
+  BENCH_FAIL_IF(ParkedDone != waiters);
+  for (i = 0; i < waiters; i++)
+  {
+    vTaskDelete(parked[i]);
+  }
+
+  printf("%lu,%llu.%02llu,%llu.%02llu,%llu.%02llu\n", (unsigned long)waiters,
+         (unsigned long long)(bestSet / BENCH_SET_ITEMS),
+         (unsigned long long)(((bestSet % BENCH_SET_ITEMS) * 100U) / BENCH_SET_ITEMS),
+         (unsigned long long)(bestIn / BENCH_WAKE_ITEMS),
+         (unsigned long long)(((bestIn % BENCH_WAKE_ITEMS) * 100U) / BENCH_WAKE_ITEMS),
+         (unsigned long long)(bestAbove / BENCH_WAKE_ITEMS),
+         (unsigned long long)(((bestAbove % BENCH_WAKE_ITEMS) * 100U) / BENCH_WAKE_ITEMS));
+}
+
+static void Waiter_Task(void *argument)
+{
+  Waiter_t *waiter = argument;
+
+  waiter->result = xEventGroupWaitBits(Group, waiter->bits, waiter->clear, waiter->all, portMAX_DELAY);
+  waiter->done = 1U;
+  vTaskSuspend(NULL);
+}
+
+static TaskHandle_t StartWaiter(Waiter_t *waiter, EventBits_t bits, BaseType_t clear, BaseType_t all)
+{
+  TaskHandle_t task;
+
+  waiter->bits = bits;
+  waiter->clear = clear;
+  waiter->all = all;
+  waiter->result = 0;
+  waiter->done = 0U;
+  // 优先级高于测试任务, 创建后立即运行并阻塞, 被唤醒时也立即运行
+  xTaskCreate(Waiter_Task, "Waiter", configMINIMAL_STACK_SIZE * 2U, waiter, BENCH_PRIORITY + 1U, &task);
+  return task;
+}
+
+// 每个任务置自己的一位, 等三位都置位
+static void Sync_Task(void *argument)
+{
+  EventBits_t bit = (EventBits_t)(uintptr_t)argument;
+
+  if ((xEventGroupSync(Group, bit, 0xE0U, portMAX_DELAY) & 0xE0U) == 0xE0U)
+  {
+    SyncDone++;
+  }
+  vTaskSuspend(NULL);
+}
+
+static void CheckSemantics(void)
+{
+  Waiter_t a;
+  Waiter_t b;
+  TaskHandle_t ta;
+  TaskHandle_t tb;
+
+  Group = xEventGroupCreate();
+
+  // OR, 多位: 置其中一位即唤醒, 不清除
+  ta = StartWaiter(&a, 0x0201U, pdFALSE, pdFALSE);
+  (void)xEventGroupSetBits(Group, 0x0200U);
+  BENCH_FAIL_IF((a.done == 0U) || ((a.result & 0x0201U) != 0x0200U));
+  BENCH_FAIL_IF(xEventGroupGetBits(Group) != 0x0200U);
+  vTaskDelete(ta);
+  (void)xEventGroupClearBits(Group, 0x00FFFFFFU);
+
+  // AND, 多位, 退出时清除: 只置一位不唤醒
+  ta = StartWaiter(&a, 0x06U, pdTRUE, pdTRUE);
+  (void)xEventGroupSetBits(Group, 0x02U);
+  BENCH_FAIL_IF(a.done != 0U);
+  (void)xEventGroupSetBits(Group, 0x04U);
+  BENCH_FAIL_IF((a.done == 0U) || ((a.result & 0x06U) != 0x06U));
+  BENCH_FAIL_IF(xEventGroupGetBits(Group) != 0U);
+  vTaskDelete(ta);
+
+  // 同一索引位上的两个等待者都被唤醒, 其中一个要求清除
+  ta = StartWaiter(&a, 0x08U, pdTRUE, pdFALSE);
+  tb = StartWaiter(&b, 0x08U, pdFALSE, pdTRUE);
+  (void)xEventGroupSetBits(Group, 0x18U);
+  BENCH_FAIL_IF((a.done == 0U) || (b.done == 0U));
+  BENCH_FAIL_IF(((a.result & 0x18U) != 0x18U) || ((b.result & 0x18U) != 0x18U));
+  BENCH_FAIL_IF(xEventGroupGetBits(Group) != 0x10U);
+  vTaskDelete(ta);
+  vTaskDelete(tb);
+  (void)xEventGroupClearBits(Group, 0x00FFFFFFU);
+
+  // 等待超时后再置位: 没有任务被唤醒, 位保持置位
+  BENCH_FAIL_IF(xEventGroupWaitBits(Group, 0x08U, pdTRUE, pdFALSE, 2U) != 0U);
+  BENCH_FAIL_IF(xEventGroupSetBits(Group, 0x08U) != 0x08U);
+  (void)xEventGroupClearBits(Group, 0x00FFFFFFU);
+
+  // 索引范围外的单个位
+  ta = StartWaiter(&a, 0x100000U, pdTRUE, pdFALSE);
+  (void)xEventGroupSetBits(Group, 0x01U);
+  BENCH_FAIL_IF(a.done != 0U);
+  (void)xEventGroupSetBits(Group, 0x100000U);
+  BENCH_FAIL_IF((a.done == 0U) || ((a.result & 0x100001U) != 0x100001U));
+  BENCH_FAIL_IF(xEventGroupGetBits(Group) != 0x01U);
+  vTaskDelete(ta);
+  (void)xEventGroupClearBits(Group, 0x00FFFFFFU);
+
+  // 三方汇合: 两个任务先到达并阻塞, 测试任务最后到达
+  SyncDone = 0;
+  xTaskCreate(Sync_Task, "Sync", configMINIMAL_STACK_SIZE * 2U, (void *)(uintptr_t)0x20U, BENCH_PRIORITY + 1U, &ta);
+  xTaskCreate(Sync_Task, "Sync", configMINIMAL_STACK_SIZE * 2U, (void *)(uintptr_t)0x40U, BENCH_PRIORITY + 1U, &tb);
+  BENCH_FAIL_IF(SyncDone != 0U);
+  BENCH_FAIL_IF((xEventGroupSync(Group, 0x80U, 0xE0U, 10U) & 0xE0U) != 0xE0U);
+  BENCH_FAIL_IF((SyncDone != 2U) || (xEventGroupGetBits(Group) != 0U));
+  vTaskDelete(ta);
+  vTaskDelete(tb);
+
+  // 删除事件组: 索引位和普通链表上的等待者都返回 0
+  ta = StartWaiter(&a, 0x02U, pdFALSE, pdFALSE);
+  tb = StartWaiter(&b, 0x0300U, pdFALSE, pdTRUE);
+  vEventGroupDelete(Group);
+  BENCH_FAIL_IF((a.done == 0U) || (b.done == 0U) || (a.result != 0U) || (b.result != 0U));
+  vTaskDelete(ta);
+  vTaskDelete(tb);
+
+  printf("evgroup_check errors=%lu\n", (unsigned long)Errors);
+}
+
+static uint32_t Bench_SimIrq(void)
+{
+  BaseType_t woken = pdFALSE;
+  uint32_t i;
+
+  for (i = 0; i < IsrOpCount; i++)
+  {
+    if (IsrOps[i].clear != 0U)
+    {
+      BENCH_FAIL_IF(xEventGroupClearBitsFromISR(Group, IsrOps[i].bits) != pdPASS);
+    }
+    else
+    {
+      BENCH_FAIL_IF(xEventGroupSetBitsFromISR(Group, IsrOps[i].bits, &woken) != pdPASS);
+    }
+  }
+  return (uint32_t)woken;
+}
+
+// 在模拟中断里依次执行 ops, 等转发的调用完成后返回事件组的位
+static EventBits_t RunIsrOps(const IsrOp_t *ops, uint32_t count)
+{
+  uint32_t i;
+
+  for (i = 0; i < count; i++)
+  {
+    IsrOps[i] = ops[i];
+  }
+  IsrOpCount = count;
+  vPortGenerateSimulatedInterrupt(BENCH_SIM_IRQ);
+  vTaskDelay(2);
+  return xEventGroupGetBits(Group);
+}
+
+// 在模拟中断里置位, 返回中断返回时已被唤醒的等待者个数, 再等转发的置位完成
+static uint32_t SetFromIsr(Waiter_t *waiters, uint32_t count, EventBits_t bits)
+{
+  uint32_t direct = 0;
+  uint32_t i;
+
+  IsrOps[0].clear = 0U;
+  IsrOps[0].bits = bits;
+  IsrOpCount = 1U;
+  vPortGenerateSimulatedInterrupt(BENCH_SIM_IRQ);
+  for (i = 0; i < count; i++)
+  {
+    direct += waiters[i].done;
+  }
+  vTaskDelay(2);
+  for (i = 0; i < count; i++)
+  {
+    BENCH_FAIL_IF((waiters[i].done == 0U) || ((waiters[i].result & bits) != bits));
+  }
+  return direct;
+}
+
+static void CheckIsr(void)
+{
+  Waiter_t w[BENCH_ISR_WAITERS];
+  TaskHandle_t t[BENCH_ISR_WAITERS];
+  uint32_t direct[3];
+  EventBits_t order[3];
+  uint32_t i;
+
+  Group = xEventGroupCreate();
+  vPortSetInterruptHandler(BENCH_SIM_IRQ, Bench_SimIrq);
+
+  // 两个等待 bit1 的任务, 其中一个要求清除
+  t[0] = StartWaiter(&w[0], 0x02U, pdTRUE, pdFALSE);
+  t[1] = StartWaiter(&w[1], 0x02U, pdFALSE, pdFALSE);
+  direct[0] = SetFromIsr(w, 2U, 0x02U);
+  BENCH_FAIL_IF(xEventGroupGetBits(Group) != 0U);
+  for (i = 0; i < 2U; i++)
+  {
+    vTaskDelete(t[i]);
+  }
+
+  // 等待者超过上限, 转发给定时器服务任务
+  for (i = 0; i < BENCH_ISR_WAITERS; i++)
+  {
+    t[i] = StartWaiter(&w[i], 0x04U, pdFALSE, pdFALSE);
+  }
+  direct[1] = SetFromIsr(w, BENCH_ISR_WAITERS, 0x04U);
+  BENCH_FAIL_IF(xEventGroupGetBits(Group) != 0x04U);
+  for (i = 0; i < BENCH_ISR_WAITERS; i++)
+  {
+    vTaskDelete(t[i]);
+  }
+  (void)xEventGroupClearBits(Group, 0x00FFFFFFU);
+
+  // 等待多个位的任务在普通链表上, 也转发
+  t[0] = StartWaiter(&w[0], 0x30U, pdTRUE, pdFALSE);
+  direct[2] = SetFromIsr(w, 1U, 0x10U);
+  BENCH_FAIL_IF(xEventGroupGetBits(Group) != 0U);
+  vTaskDelete(t[0]);
+
+  // 没有等待者: 先清除再置位, 先置位再清除
+  {
+    static const IsrOp_t clearSet[] = {{1U, 0x40U}, {0U, 0x40U}};
+    static const IsrOp_t setClear[] = {{0U, 0x40U}, {1U, 0x40U}};
+
+    order[0] = RunIsrOps(clearSet, 2U);
+    order[1] = RunIsrOps(setClear, 2U);
+  }
+  BENCH_FAIL_IF((order[0] != 0x40U) || (order[1] != 0U));
+
+  // 等待 0x300 的任务在普通链表上, 置位 0x100 被转发, 其后的清除和置位也
+  // 要排在它后面: 任务被 0x100 唤醒, 最后 0x40 置位, 0x100 清除
+  {
+    static const IsrOp_t pending[] = {{0U, 0x100U}, {1U, 0x140U}, {0U, 0x40U}};
+
+    (void)xEventGroupSetBits(Group, 0x40U);
+    t[0] = StartWaiter(&w[0], 0x300U, pdFALSE, pdFALSE);
+    order[2] = RunIsrOps(pending, 3U);
+    BENCH_FAIL_IF((w[0].done == 0U) || ((w[0].result & 0x100U) == 0U));
+    vTaskDelete(t[0]);
+  }
+  BENCH_FAIL_IF(order[2] != 0x40U);
+
+  vEventGroupDelete(Group);
+#if (configUSE_EVENT_GROUP_ISR_SET == 1)
+  BENCH_FAIL_IF((direct[0] != 2U) || (direct[1] != 0U) || (direct[2] != 0U));
+#else
+  BENCH_FAIL_IF((direct[0] != 0U) || (direct[1] != 0U) || (direct[2] != 0U));
+#endif
+  printf("evgroup_isr direct=%lu/2 over_limit=%lu/%u multi_bit=%lu/1 errors=%lu\n", (unsigned long)direct[0],
+         (unsigned long)direct[1], (unsigned)BENCH_ISR_WAITERS, (unsigned long)direct[2], (unsigned long)Errors);
+  printf("evgroup_isr_order clear_set=0x%lx set_clear=0x%lx pending=0x%lx\n", (unsigned long)order[0],
+         (unsigned long)order[1], (unsigned long)order[2]);
+}
+
+static void Bench_Task(void *argument)
+{
+  uint32_t waiters;
+
+  (void)argument;
+
+  printf("# evgroup_bench unit=ns index=%d indexed_bits=%d isr_set=%d\n", configUSE_EVENT_GROUP_INDEX,
+         configEVENT_GROUP_INDEXED_BITS, configUSE_EVENT_GROUP_ISR_SET);
+  printf("waiters,set_ns,set_in_ns,set_above_ns\n");
+  for (waiters = 1U; waiters <= BENCH_MAX_WAITERS; waiters *= 2U)
+  {
+    MeasureWaiters(waiters);
+  }
+
+  CheckSemantics();
+  CheckIsr();
+  BENCH_Finish();
+}
+
+int main(void)
+{
+  xTaskCreate(Bench_Task, "Bench", configMINIMAL_STACK_SIZE * 4U, NULL, BENCH_PRIORITY, NULL);
+  vTaskStartScheduler();
+  return 0;
+}
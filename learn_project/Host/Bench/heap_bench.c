@@ -0,0 +1,253 @@
+/**
+ ******************************************************************************
+ * @file    heap_bench.c
+ * @brief   heap_4 随机分配/释放压力测试
+ *
+ * 在调度器启动前 (没有节拍中断干扰) 对 pvPortMalloc / vPortFree 做随机的
+ * 分配和释放: 每一步随机选一个槽位, 空则分配随机大小的内存, 否则释放.
+ * 统计:
+ *   malloc / free  每次调用耗时的 min/avg/p99/p999/max
+ *   frag           1 - 最大空闲块 / 总空闲字节, 定期采样的平均值和最大值
+ *   fail           分配失败次数; 其中 fail_fit 为当时最大空闲块其实放得下
+ *                  的次数 (即分配器漏找)
+ * 每个内存块写入图案, 释放时校验, 结束时全部释放后检查堆是否恢复为一整块.
+ * 与 heap_bench_tlsf (见 configUSE_TLSF_HEAP) 的结果对比.
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "bench_util.h"
+
+#define BENCH_SLOTS         512U
+#define BENCH_OPS           200000U
+#define BENCH_FRAG_PERIOD   1000U     // 每隔多少次操作采样一次碎片率
+
+typedef struct
+{
+  const char *Name;
+  uint32_t SmallMax;        // 小块上限, 约 75% 的分配
+  uint32_t MediumMax;       // 中块上限, 约 20% 的分配
+  uint32_t LargeMax;        // 大块上限, 约 5% 的分配
+} Profile_t;
+
+static const Profile_t Profiles[] =
+{
+  { "small", 64U, 256U, 512U },         // 与目标板上的队列/任务控制块相近
+  { "mixed", 128U, 2048U, 16384U },
+};
+
+typedef struct
+{
+  uint8_t *Ptr;
+  size_t Size;
+} Slot_t;
+
+static Slot_t Slots[BENCH_SLOTS];
+static uint64_t MallocNs[BENCH_OPS];
+static uint64_t FreeNs[BENCH_OPS];
+static uint32_t MallocCount;
+static uint32_t FreeCount;
+static uint32_t Fails;
+static uint32_t FailsFit;
+static uint32_t Corrupted;
+
+static size_t RandomSize(const Profile_t *profile)
+{
+  uint32_t r = (uint32_t)rand() % 100U;
+
+  if (r < 75U)
+  {
+    return 1U + ((uint32_t)rand() % profile->SmallMax);
+  }
+  if (r < 95U)
+  {
+    return 1U + ((uint32_t)rand() % profile->MediumMax);
+  }
+  return 1U + ((uint32_t)rand() % profile->LargeMax);
+}
+
+static uint8_t Pattern(const Slot_t *slot)
+{
+  return (uint8_t)(((uintptr_t)slot->Ptr >> 3) ^ slot->Size);
+}
+
+static void FreeSlot(Slot_t *slot, uint8_t timed)
+{
+  uint8_t pattern = Pattern(slot);
+  uint64_t start;
+  size_t i;
+
+  for (i = 0; i < slot->Size; i++)
+  {
+    if (slot->Ptr[i] != pattern)
+    {
+      Corrupted++;
+      break;
+    }
+  }
+
+  start = NowNs();
+  vPortFree(slot->Ptr);
+  if (timed != 0U)
+  {
+    FreeNs[FreeCount++] = NowNs() - start;
+  }
+  slot->Ptr = NULL;
+}
+
+static void AllocSlot(Slot_t *slot, const Profile_t *profile)
+{
+  HeapStats_t stats;
+  size_t size = RandomSize(profile);
+  uint64_t start;
+
+  start = NowNs();
+  slot->Ptr = pvPortMalloc(size);
+  MallocNs[MallocCount++] = NowNs() - start;
+
+  if (slot->Ptr == NULL)
+  {
+    // 加上块头 (两个指针大小) 并对齐后最大空闲块仍然放得下, 说明分配器没有找到它
+    Fails++;
+    vPortGetHeapStats(&stats);
+    if (stats.xSizeOfLargestFreeBlockInBytes >=
+        ((size + (2U * sizeof(void *)) + portBYTE_ALIGNMENT_MASK) & ~(size_t)portBYTE_ALIGNMENT_MASK))
+    {
+      FailsFit++;
+    }
+    return;
+  }
+  slot->Size = size;
+  memset(slot->Ptr, Pattern(slot), size);
+}
+
+static int CompareU64(const void *a, const void *b)
+{
+  uint64_t x = *(const uint64_t *)a;
+  uint64_t y = *(const uint64_t *)b;
+
+  return (x > y) - (x < y);
+}
+
+static void Report(const char *profile, const char *name, uint64_t *samples, uint32_t count)
+{
+  uint64_t sum = 0;
+  uint32_t i;
+
+  if (count == 0U)
+  {
+    return;
+  }
+  qsort(samples, count, sizeof(samples[0]), CompareU64);
+  for (i = 0; i < count; i++)
+  {
+    sum += samples[i];
+  }
+  printf("heap_op profile=%s op=%s n=%lu min=%llu avg=%llu p99=%llu p999=%llu max=%llu\n", profile, name,
+         (unsigned long)count, (unsigned long long)samples[0], (unsigned long long)(sum / count),
+         (unsigned long long)samples[(count * 99U) / 100U], (unsigned long long)samples[(count * 999U) / 1000U],
+         (unsigned long long)samples[count - 1U]);
+}
+
+static void RunProfile(const Profile_t *profile)
+{
+  HeapStats_t stats;
+  uint64_t fragSum = 0;
+  uint32_t fragMax = 0;
+  uint32_t fragSamples = 0;
+  uint32_t frag;
+  uint32_t op;
+  Slot_t *slot;
+
+  MallocCount = 0;
+  FreeCount = 0;
+  Fails = 0;
+  FailsFit = 0;
+
+  for (op = 0; op < BENCH_OPS; op++)
+  {
+    slot = &Slots[(uint32_t)rand() % BENCH_SLOTS];
+    if (slot->Ptr == NULL)
+    {
+      AllocSlot(slot, profile);
+    }
+    else
+    {
+      FreeSlot(slot, 1U);
+    }
+
+    if ((op % BENCH_FRAG_PERIOD) == (BENCH_FRAG_PERIOD - 1U))
+    {
+      // 碎片率按千分比记录
+      vPortGetHeapStats(&stats);
+      if (stats.xAvailableHeapSpaceInBytes > 0U)
+      {
+        frag = (uint32_t)(1000U - ((uint64_t)stats.xSizeOfLargestFreeBlockInBytes * 1000U) /
+                                  stats.xAvailableHeapSpaceInBytes);
+        fragSum += frag;
+        fragMax = (frag > fragMax) ? frag : fragMax;
+        fragSamples++;
+      }
+    }
+  }
+
+  Report(profile->Name, "malloc", MallocNs, MallocCount);
+  Report(profile->Name, "free", FreeNs, FreeCount);
+  printf("heap_frag profile=%s avg_permille=%llu max_permille=%lu fail=%lu fail_fit=%lu\n", profile->Name,
+         (unsigned long long)(fragSamples ? fragSum / fragSamples : 0U), (unsigned long)fragMax,
+         (unsigned long)Fails, (unsigned long)FailsFit);
+
+  for (op = 0; op < BENCH_SLOTS; op++)
+  {
+    if (Slots[op].Ptr != NULL)
+    {
+      FreeSlot(&Slots[op], 0U);
+    }
+  }
+}
+
+int main(void)
+{
+  HeapStats_t stats;
+  size_t initialFree;
+  uint8_t *warm;
+  uint32_t i;
+
+  srand(1);
+  printf("# heap_bench unit=ns tlsf=%d heap=%lu slots=%u ops=%u\n", configUSE_TLSF_HEAP,
+         (unsigned long)configTOTAL_HEAP_SIZE, BENCH_SLOTS, BENCH_OPS);
+
+  // 第一次分配会初始化堆; 再把整个堆写一遍, 免得缺页计入测量结果
+  vPortFree(pvPortMalloc(1U));
+  initialFree = xPortGetFreeHeapSize();
+  warm = pvPortMalloc(initialFree / 2U);
+  memset(warm, 0, initialFree / 2U);
+  vPortFree(warm);
+  warm = pvPortMalloc(initialFree - 64U);
+  if (warm != NULL)
+  {
+    memset(warm, 0, initialFree - 64U);
+    vPortFree(warm);
+  }
+
+  for (i = 0; i < sizeof(Profiles) / sizeof(Profiles[0]); i++)
+  {
+    RunProfile(&Profiles[i]);
+  }
+
+  // 全部释放后堆应当恢复为一整块
+  vPortGetHeapStats(&stats);
+  printf("heap_check free=%lu initial=%lu blocks=%lu min_ever=%lu corrupted=%lu\n",
+         (unsigned long)stats.xAvailableHeapSpaceInBytes, (unsigned long)initialFree,
+         (unsigned long)stats.xNumberOfFreeBlocks, (unsigned long)stats.xMinimumEverFreeBytesRemaining,
+         (unsigned long)Corrupted);
+  BENCH_FAIL_IF((stats.xAvailableHeapSpaceInBytes != initialFree) || (stats.xNumberOfFreeBlocks != 1U) ||
+                (Corrupted != 0U));
+  BENCH_PrintResult();
+  return 0;
+}
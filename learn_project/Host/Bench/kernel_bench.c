@@ -0,0 +1,68 @@
+/**
+ ******************************************************************************
+ * @file    kernel_bench.c
+ * @brief   在主机上运行 kbench 内核性能测试
+ *
+ * 计数器为 CLOCK_MONOTONIC 纳秒, 测试中断为 Posix 移植层的模拟中断.
+ * 输出格式与目标板相同, 见 kbench.h.
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <time.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "kbench.h"
+
+/* 测试中断使用的模拟中断号, 与 uart_sim 使用的中断号错开 */
+#define KBENCH_SIM_IRQ      6U
+
+#define KBENCH_PRIORITY     (configMAX_PRIORITIES - 8U)
+
+static uint32_t KBENCH_SimIrq(void)
+{
+  KBENCH_IrqHandler();
+  return pdFALSE;
+}
+
+uint32_t KBENCH_PortNow(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t)(((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec);
+}
+
+uint32_t KBENCH_PortClockHz(void)
+{
+  return 1000000000U;
+}
+
+const char *KBENCH_PortUnit(void)
+{
+  return "ns";
+}
+
+void KBENCH_PortInit(void)
+{
+}
+
+void KBENCH_PortTriggerIrq(void)
+{
+  vPortGenerateSimulatedInterrupt(KBENCH_SIM_IRQ);
+}
+
+void KBENCH_PortDone(void)
+{
+  fflush(stdout);
+  vTaskEndScheduler();
+}
+
+int main(void)
+{
+  vPortSetInterruptHandler(KBENCH_SIM_IRQ, KBENCH_SimIrq);
+  xTaskCreate(KBENCH_Task, "KBench", configMINIMAL_STACK_SIZE * 4U, NULL, KBENCH_PRIORITY, NULL);
+  vTaskStartScheduler();
+  return 0;
+}
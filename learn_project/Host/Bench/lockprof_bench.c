@@ -0,0 +1,315 @@
+/**
+ ******************************************************************************
+ * @file    lockprof_bench.c
+ * @brief   互斥量等待/持有时间统计 (configUSE_MUTEX_PROFILING)
+ *
+ * uart     模拟逐字符加锁的串口输出: BENCH_PRINTERS 个同优先级任务每输出一个
+ *          字符就获取一次 UartMutex, 在持有期间阻塞发送 (115200 波特率下一个
+ *          字符约 87us); 每行开始时另取一次持有时间很短的 CfgMutex.
+ *          结束后用 uxQueueGetMutexProfiles 读出每个互斥量的等待/持有时间
+ *          直方图和按任务的统计. 任务数多于 configMUTEX_PROFILE_TASKS,
+ *          多出的任务计入最后一项 (task=other).
+ * slots    前 configMUTEX_PROFILE_COUNT 个互斥量有统计, 之后创建的没有;
+ *          删除一个后新建的互斥量重新得到统计.
+ * cost     单个任务没有竞争地获取+释放一次的平均耗时: 有统计和没有统计的
+ *          互斥量各测 BENCH_COST_ROUNDS 轮取最小值.
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "cmsis_os2.h"
+#include "bench_util.h"
+
+#define BENCH_PRINTERS      (configMUTEX_PROFILE_TASKS + 1U)
+#define BENCH_LINES         20U
+#define BENCH_LINE_CHARS    16U
+#define BENCH_CHAR_NS       86800U
+#define BENCH_CFG_NS        1000U
+#define BENCH_COST_ITEMS    1000000U
+#define BENCH_COST_ROUNDS   5U
+#define BENCH_PRIORITY      (configMAX_PRIORITIES - 8U)
+
+static osMutexId_t UartMutex;
+static osMutexId_t CfgMutex;
+static volatile uint32_t Done;
+static volatile uint32_t Printed[BENCH_PRINTERS];
+static volatile uint32_t ProbeFailures;
+
+static void Spin(uint32_t ns)
+{
+  uint64_t start = NowNs();
+
+  while ((NowNs() - start) < ns)
+  {
+  }
+}
+
+static osMutexId_t NewMutex(const char *name)
+{
+  osMutexAttr_t attr;
+
+  memset(&attr, 0, sizeof(attr));
+  attr.name = name;
+  attr.attr_bits = osMutexPrioInherit;
+  return osMutexNew(&attr);
+}
+
+// 每个字符加锁一次, 持有期间忙等发送完成, 与原来串口互斥量的用法相同
+static void Printer_Task(void *argument)
+{
+  const uint32_t index = (uint32_t)(uintptr_t)argument;
+  uint32_t line;
+  uint32_t c;
+
+  for (line = 0; line < BENCH_LINES; line++)
+  {
+    (void)osMutexAcquire(CfgMutex, osWaitForever);
+    Spin(BENCH_CFG_NS);
+    (void)osMutexRelease(CfgMutex);
+
+    for (c = 0; c < BENCH_LINE_CHARS; c++)
+    {
+      (void)osMutexAcquire(UartMutex, osWaitForever);
+      Spin(BENCH_CHAR_NS);
+      (void)osMutexRelease(UartMutex);
+      Printed[index]++;
+    }
+    vTaskDelay(1);
+  }
+  Done++;
+  vTaskSuspend(NULL);
+}
+
+static void PrintProfile(const MutexProfile_t *profile)
+{
+  const MutexProfileTask_t *entry;
+  uint32_t b;
+  uint32_t t;
+
+  printf("hist,%s,wait", profile->pcMutexName);
+  for (b = 0; b < configMUTEX_PROFILE_BUCKETS; b++)
+  {
+    printf(",%lu", (unsigned long)profile->ulWaitHistogram[b]);
+  }
+  printf("\nhist,%s,hold", profile->pcMutexName);
+  for (b = 0; b < configMUTEX_PROFILE_BUCKETS; b++)
+  {
+    printf(",%lu", (unsigned long)profile->ulHoldHistogram[b]);
+  }
+  printf("\n");
+
+  for (t = 0; t <= configMUTEX_PROFILE_TASKS; t++)
+  {
+    entry = &profile->xTasks[t];
+    if ((entry->ulAcquisitions == 0U) && (entry->ulFailures == 0U))
+    {
+      continue;
+    }
+    printf("task,%s,%s,%lu,%lu,%lu,%llu,%llu,%llu,%llu\n", profile->pcMutexName,
+           (entry->xTask != NULL) ? pcTaskGetName(entry->xTask) : "other", (unsigned long)entry->ulAcquisitions,
+           (unsigned long)entry->ulContended, (unsigned long)entry->ulFailures,
+           (unsigned long long)(entry->ulWaitTime / ((entry->ulAcquisitions != 0U) ? entry->ulAcquisitions : 1U)),
+           (unsigned long long)entry->ulMaxWaitTime,
+           (unsigned long long)(entry->ulHoldTime / ((entry->ulAcquisitions != 0U) ? entry->ulAcquisitions : 1U)),
+           (unsigned long long)entry->ulMaxHoldTime);
+  }
+}
+
+// 直方图的样本数与按任务的获取次数一致
+static void CheckProfile(const MutexProfile_t *profile, uint32_t expected)
+{
+  uint32_t waits = 0;
+  uint32_t holds = 0;
+  uint32_t acquisitions = 0;
+  uint32_t i;
+
+  for (i = 0; i < configMUTEX_PROFILE_BUCKETS; i++)
+  {
+    waits += profile->ulWaitHistogram[i];
+    holds += profile->ulHoldHistogram[i];
+  }
+  for (i = 0; i <= configMUTEX_PROFILE_TASKS; i++)
+  {
+    acquisitions += profile->xTasks[i].ulAcquisitions;
+  }
+  BENCH_FAIL_IF((waits != expected) || (holds != expected) || (acquisitions != expected));
+}
+
+static void RunUart(void)
+{
+  static MutexProfile_t profiles[configMUTEX_PROFILE_COUNT];
+  TaskHandle_t tasks[BENCH_PRINTERS];
+  const MutexProfile_t *uart = NULL;
+  const MutexProfile_t *cfg = NULL;
+  char name[configMAX_TASK_NAME_LEN];
+  UBaseType_t count;
+  uint64_t start;
+  uint32_t i;
+
+  UartMutex = NewMutex("UartMutex");
+  CfgMutex = NewMutex("CfgMutex");
+  Done = 0U;
+  start = NowNs();
+  for (i = 0; i < BENCH_PRINTERS; i++)
+  {
+    (void)snprintf(name, sizeof(name), "Printer%lu", (unsigned long)i);
+    xTaskCreate(Printer_Task, name, configMINIMAL_STACK_SIZE * 2U, (void *)(uintptr_t)i, BENCH_PRIORITY - 1U,
+                &tasks[i]);
+  }
+  while (Done < BENCH_PRINTERS)
+  {
+    vTaskDelay(5);
+  }
+  printf("# uart printers=%u lines=%u chars=%u run_us=%llu\n", BENCH_PRINTERS, BENCH_LINES, BENCH_LINE_CHARS,
+         (unsigned long long)((NowNs() - start) / 1000U));
+
+  // 任务删除前读出, 以便输出任务名
+  count = uxQueueGetMutexProfiles(profiles, configMUTEX_PROFILE_COUNT);
+  printf("kind,mutex,bucket0..bucket%u\n", configMUTEX_PROFILE_BUCKETS - 1U);
+  printf("task,mutex,name,acquisitions,contended,failures,wait_avg,wait_max,hold_avg,hold_max\n");
+  for (i = 0; i < count; i++)
+  {
+    if (profiles[i].xHandle == (QueueHandle_t)UartMutex)
+    {
+      uart = &profiles[i];
+    }
+    else if (profiles[i].xHandle == (QueueHandle_t)CfgMutex)
+    {
+      cfg = &profiles[i];
+    }
+    PrintProfile(&profiles[i]);
+  }
+
+  BENCH_FAIL_IF((uart == NULL) || (cfg == NULL));
+  if ((uart != NULL) && (cfg != NULL))
+  {
+    CheckProfile(uart, BENCH_PRINTERS * BENCH_LINES * BENCH_LINE_CHARS);
+    CheckProfile(cfg, BENCH_PRINTERS * BENCH_LINES);
+    for (i = 0; i < configMUTEX_PROFILE_TASKS; i++)
+    {
+      BENCH_FAIL_IF(uart->xTasks[i].xTask == NULL);
+      BENCH_FAIL_IF(uart->xTasks[i].ulMaxHoldTime < BENCH_CHAR_NS);
+      BENCH_FAIL_IF((uart->xTasks[i].ulHoldTime / BENCH_CHAR_NS) < (BENCH_LINES * BENCH_LINE_CHARS));
+    }
+    // 多出的一个任务计入最后一项
+    BENCH_FAIL_IF(uart->xTasks[configMUTEX_PROFILE_TASKS].xTask != NULL);
+    BENCH_FAIL_IF(uart->xTasks[configMUTEX_PROFILE_TASKS].ulAcquisitions != (BENCH_LINES * BENCH_LINE_CHARS));
+    // 持有时间差别要在统计里看得出来
+    BENCH_FAIL_IF(cfg->xTasks[0].ulMaxHoldTime >= BENCH_CHAR_NS);
+  }
+  for (i = 0; i < BENCH_PRINTERS; i++)
+  {
+    BENCH_FAIL_IF(Printed[i] != (BENCH_LINES * BENCH_LINE_CHARS));
+    vTaskDelete(tasks[i]);
+  }
+}
+
+static void Probe_Task(void *argument)
+{
+  osMutexId_t mutex = (osMutexId_t)argument;
+
+  ProbeFailures += (osMutexAcquire(mutex, 0U) != osOK) ? 1U : 0U;
+  ProbeFailures += (osMutexAcquire(mutex, 2U) != osOK) ? 1U : 0U;
+  vTaskSuspend(NULL);
+}
+
+static void MeasureCost(const char *name, osMutexId_t mutex)
+{
+  uint64_t best = UINT64_MAX;
+  uint64_t start;
+  uint64_t ns;
+  uint32_t r;
+  uint32_t i;
+
+  for (r = 0; r < BENCH_COST_ROUNDS; r++)
+  {
+    start = NowNs();
+    for (i = 0; i < BENCH_COST_ITEMS; i++)
+    {
+      (void)osMutexAcquire(mutex, osWaitForever);
+      (void)osMutexRelease(mutex);
+    }
+    ns = NowNs() - start;
+    best = (ns < best) ? ns : best;
+  }
+  printf("cost %s ns_per_acquire_release=%llu.%02llu\n", name, (unsigned long long)(best / BENCH_COST_ITEMS),
+         (unsigned long long)(((best % BENCH_COST_ITEMS) * 100U) / BENCH_COST_ITEMS));
+}
+
+static void CheckSlots(void)
+{
+  osMutexId_t extra[configMUTEX_PROFILE_COUNT];
+  osMutexId_t spare;
+  MutexProfile_t profile;
+  TaskHandle_t probe;
+  uint32_t used = 2U;
+  uint32_t i;
+
+  // 占满剩下的统计槽, 再建一个没有统计的
+  for (i = 0; used < configMUTEX_PROFILE_COUNT; i++, used++)
+  {
+    extra[i] = NewMutex("Extra");
+    BENCH_FAIL_IF(xQueueGetMutexProfile((QueueHandle_t)extra[i], &profile) != pdPASS);
+  }
+  spare = NewMutex("Spare");
+  BENCH_FAIL_IF(xQueueGetMutexProfile((QueueHandle_t)spare, &profile) != pdFAIL);
+
+  MeasureCost("profiled", extra[0]);
+  MeasureCost("unprofiled", spare);
+  BENCH_FAIL_IF(xQueueGetMutexProfile((QueueHandle_t)extra[0], &profile) != pdPASS);
+  BENCH_FAIL_IF(profile.xTasks[0].ulAcquisitions != (BENCH_COST_ROUNDS * BENCH_COST_ITEMS));
+  BENCH_FAIL_IF(profile.xTasks[0].ulContended != 0U);
+
+  // 获取失败按任务计数
+  ProbeFailures = 0U;
+  (void)osMutexAcquire(extra[0], osWaitForever);
+  xTaskCreate(Probe_Task, "Probe", configMINIMAL_STACK_SIZE * 2U, (void *)extra[0], BENCH_PRIORITY + 1U, &probe);
+  vTaskDelay(5);
+  BENCH_FAIL_IF(ProbeFailures != 2U);
+  (void)osMutexRelease(extra[0]);
+  (void)xQueueGetMutexProfile((QueueHandle_t)extra[0], &profile);
+  BENCH_FAIL_IF((profile.xTasks[1].xTask != probe) || (profile.xTasks[1].ulFailures != 2U));
+  BENCH_FAIL_IF(profile.xTasks[1].ulAcquisitions != 0U);
+  printf("slots profiled=%u probe_failures=%lu\n", configMUTEX_PROFILE_COUNT,
+         (unsigned long)profile.xTasks[1].ulFailures);
+  vTaskDelete(probe);
+
+  // 删除一个后, 新建的互斥量重新得到统计, 从零开始
+  (void)osMutexDelete(extra[0]);
+  extra[0] = NewMutex("Extra");
+  BENCH_FAIL_IF(xQueueGetMutexProfile((QueueHandle_t)extra[0], &profile) != pdPASS);
+  BENCH_FAIL_IF(profile.xTasks[0].xTask != NULL);
+
+  for (i = 0; (i + 2U) < configMUTEX_PROFILE_COUNT; i++)
+  {
+    (void)osMutexDelete(extra[i]);
+  }
+  (void)osMutexDelete(spare);
+}
+
+static void Bench_Task(void *argument)
+{
+  (void)argument;
+
+  printf("# lockprof_bench unit=ns buckets=%u bucket_shift=%u\n", configMUTEX_PROFILE_BUCKETS,
+         configMUTEX_PROFILE_BUCKET_SHIFT);
+  RunUart();
+  CheckSlots();
+  (void)osMutexDelete(UartMutex);
+  (void)osMutexDelete(CfgMutex);
+
+  printf("lockprof_check errors=%lu\n", (unsigned long)Errors);
+  BENCH_Finish();
+}
+
+int main(void)
+{
+  xTaskCreate(Bench_Task, "Bench", configMINIMAL_STACK_SIZE * 4U, NULL, BENCH_PRIORITY, NULL);
+  vTaskStartScheduler();
+  return 0;
+}
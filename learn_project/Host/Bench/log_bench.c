@@ -0,0 +1,233 @@
+/**
+ ******************************************************************************
+ * @file    log_bench.c
+ * @brief   uart_log 日志模块在主机上的测量
+ *
+ * 三个任务通过 LOG_Printf 打印 60 字节的日志行, UART/DMA 由 uart_sim 按
+ * 115200 波特率模拟. 统计每次调用的耗时, 以及丢弃字节数和环形缓冲区的
+ * 最高占用, 并检查收到的每一行都是完整的(不同任务的输出没有交错).
+ * 最后比暂存区个数多的任务先后写半行后退出, 检查每个任务都分到了暂存区,
+ * 退出后暂存区都已归还. 任何一项检查失败时输出 "# FAIL".
+ ******************************************************************************
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "cmsis_os2.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "uart_log.h"
+#include "uart_sim.h"
+#include "bench_util.h"
+
+#define BENCH_BAUD          115200U
+#define BENCH_LOGGERS       3U
+#define BENCH_LINE_LEN      60U
+#define BENCH_STEADY_LINES  50U
+#define BENCH_STEADY_GAP_MS 20U
+#define BENCH_BURST_LINES   40U
+#define BENCH_CAPTURE_SIZE  (64U * 1024U)
+#define BENCH_SHORT_TASKS   (LOG_STAGING_SLOTS + 2U)
+
+typedef struct
+{
+  uint32_t Id;
+  uint32_t Calls;
+  uint64_t MinNs;
+  uint64_t MaxNs;
+  uint64_t TotalNs;
+} Logger_t;
+
+static Logger_t Loggers[BENCH_LOGGERS];
+static volatile uint32_t LoggersDone;
+static volatile uint32_t ShortStaged;
+
+static pthread_mutex_t CaptureMutex = PTHREAD_MUTEX_INITIALIZER;
+static char Capture[BENCH_CAPTURE_SIZE];
+static uint32_t CaptureLen;
+
+// 模拟串口的接收端, 在外设线程中调用
+static void CaptureSink(const uint8_t *data, uint32_t len)
+{
+  pthread_mutex_lock(&CaptureMutex);
+  if ((CaptureLen + len) <= sizeof(Capture))
+  {
+    memcpy(&Capture[CaptureLen], data, len);
+    CaptureLen += len;
+  }
+  pthread_mutex_unlock(&CaptureMutex);
+}
+
+static void TimedLine(Logger_t *logger, uint32_t seq)
+{
+  uint64_t start;
+  uint64_t ns;
+
+  // "[L1] seq=00012 " + 填充 + "\r\n", 总长 BENCH_LINE_LEN
+  start = NowNs();
+  LOG_Printf("[L%lu] seq=%05lu %.*s\r\n", (unsigned long)logger->Id, (unsigned long)seq,
+             (int)(BENCH_LINE_LEN - 17U), "................................................................");
+  ns = NowNs() - start;
+
+  if ((logger->Calls == 0U) || (ns < logger->MinNs))
+  {
+    logger->MinNs = ns;
+  }
+  if (ns > logger->MaxNs)
+  {
+    logger->MaxNs = ns;
+  }
+  logger->TotalNs += ns;
+  logger->Calls++;
+}
+
+static void Logger_Task(void *argument)
+{
+  Logger_t *logger = (Logger_t *)argument;
+  uint32_t seq = 0;
+  uint32_t i;
+
+  // 稳定阶段: 总速率低于串口带宽, 不应丢数据
+  for (i = 0; i < BENCH_STEADY_LINES; i++)
+  {
+    TimedLine(logger, seq++);
+    osDelay(BENCH_STEADY_GAP_MS);
+  }
+
+  // 突发阶段: 一次打印很多行, 缓冲区满后丢弃整行
+  for (i = 0; i < BENCH_BURST_LINES; i++)
+  {
+    TimedLine(logger, seq++);
+  }
+
+  LoggersDone++;
+  osThreadExit();
+}
+
+// 写半行(占用暂存区)后退出
+static void ShortLived_Task(void *argument)
+{
+  (void)argument;
+  LOG_Write("[partial", 8U);
+  if (pvTaskGetThreadLocalStoragePointer(NULL, LOG_TLS_INDEX) != NULL)
+  {
+    ShortStaged++;
+  }
+  osThreadExit();
+}
+
+// 检查每一行都以 "[L" 开头, 长度正确, 以 "\r\n" 结尾
+static uint32_t CheckLines(uint32_t *lines)
+{
+  uint32_t torn = 0;
+  uint32_t pos = 0;
+
+  *lines = 0;
+  while ((pos + BENCH_LINE_LEN) <= CaptureLen)
+  {
+    if ((Capture[pos] != '[') || (Capture[pos + 1U] != 'L') ||
+        (Capture[pos + BENCH_LINE_LEN - 2U] != '\r') || (Capture[pos + BENCH_LINE_LEN - 1U] != '\n'))
+    {
+      torn++;
+      break;
+    }
+    (*lines)++;
+    pos += BENCH_LINE_LEN;
+  }
+  if (pos != CaptureLen)
+  {
+    torn++;
+  }
+  return torn;
+}
+
+static void Monitor_Task(void *argument)
+{
+  LOG_Stats_t stats;
+  uint32_t lines;
+  uint32_t torn;
+  uint32_t i;
+
+  (void)argument;
+  while (LoggersDone < BENCH_LOGGERS)
+  {
+    osDelay(10);
+  }
+  do
+  {
+    osDelay(10);
+    LOG_GetStats(&stats);
+  } while (stats.PendingBytes != 0U);
+
+  pthread_mutex_lock(&CaptureMutex);
+  torn = CheckLines(&lines);
+  pthread_mutex_unlock(&CaptureMutex);
+
+  for (i = 0; i < BENCH_LOGGERS; i++)
+  {
+    printf("log_printf logger=%lu calls=%lu min_ns=%llu avg_ns=%llu max_ns=%llu\n",
+           (unsigned long)Loggers[i].Id, (unsigned long)Loggers[i].Calls,
+           (unsigned long long)Loggers[i].MinNs,
+           (unsigned long long)(Loggers[i].TotalNs / Loggers[i].Calls),
+           (unsigned long long)Loggers[i].MaxNs);
+  }
+  printf("log_ring written=%lu dropped=%lu high_water=%lu size=%lu\n",
+         (unsigned long)stats.WrittenBytes, (unsigned long)stats.DroppedBytes,
+         (unsigned long)stats.HighWaterMark, (unsigned long)LOG_RING_SIZE);
+  printf("log_uart tx_bytes=%lu transfers=%lu lines=%lu torn=%lu\n",
+         (unsigned long)UART_SimTxBytes(), (unsigned long)UART_SimTxTransfers(),
+         (unsigned long)lines, (unsigned long)torn);
+  // 原来的实现逐字节轮询发送, 一行的耗时就是它在线路上的时间
+  printf("log_polled_equivalent line_ns=%llu\n",
+         (unsigned long long)((uint64_t)BENCH_LINE_LEN * 10ULL * 1000000000ULL / BENCH_BAUD));
+
+  // 每一行要么完整发出, 要么整行丢弃
+  BENCH_FAIL_IF(torn != 0U);
+  BENCH_FAIL_IF((stats.WrittenBytes + stats.DroppedBytes) != (BENCH_LOGGERS * (BENCH_STEADY_LINES + BENCH_BURST_LINES) * BENCH_LINE_LEN));
+  BENCH_FAIL_IF((UART_SimTxBytes() != stats.WrittenBytes) || ((lines * BENCH_LINE_LEN) != stats.WrittenBytes));
+
+  // 每个短任务优先级更高, 创建后立刻运行到退出; 延时让空闲任务回收它
+  for (i = 0; i < BENCH_SHORT_TASKS; i++)
+  {
+    xTaskCreate(ShortLived_Task, "Short", configMINIMAL_STACK_SIZE * 2U, NULL, osPriorityHigh, NULL);
+    osDelay(1);
+  }
+  LOG_GetStats(&stats);
+  printf("log_staging tasks=%lu staged=%lu in_use=%lu slots=%lu\n", (unsigned long)BENCH_SHORT_TASKS,
+         (unsigned long)ShortStaged, (unsigned long)stats.StagingInUse, (unsigned long)LOG_STAGING_SLOTS);
+  BENCH_FAIL_IF(ShortStaged != BENCH_SHORT_TASKS);
+  BENCH_FAIL_IF(stats.StagingInUse != 0U);
+
+  BENCH_Finish();
+}
+
+int main(void)
+{
+  static char names[BENCH_LOGGERS][8];
+  osThreadAttr_t attr;
+  uint32_t i;
+
+  osKernelInitialize();
+  LOG_Init();
+  UART_SimInit(BENCH_BAUD, CaptureSink);
+
+  memset(&attr, 0, sizeof(attr));
+  attr.stack_size = 256 * 4;
+  for (i = 0; i < BENCH_LOGGERS; i++)
+  {
+    Loggers[i].Id = i + 1U;
+    snprintf(names[i], sizeof(names[i]), "Log%lu", (unsigned long)(i + 1U));
+    attr.name = names[i];
+    attr.priority = (osPriority_t)(osPriorityNormal + (int)i);
+    osThreadNew(Logger_Task, &Loggers[i], &attr);
+  }
+
+  attr.name = "Monitor";
+  attr.priority = osPriorityLow;
+  osThreadNew(Monitor_Task, NULL, &attr);
+
+  osKernelStart();
+  return 0;
+}
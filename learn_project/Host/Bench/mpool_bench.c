@@ -0,0 +1,301 @@
+/**
+ ******************************************************************************
+ * @file    mpool_bench.c
+ * @brief   osMemoryPoolAlloc / osMemoryPoolFree 的耗时与并发正确性
+ *
+ * cost    不等待的分配+释放一对调用的耗时, 任务中和模拟中断中各测一次;
+ *         sem_crit 为原实现的等价操作 (信号量 + 临界区保护的空闲链表),
+ *         作为对照
+ * stress  几个不同优先级的任务用 osWaitForever 争用一个小内存池, 每次持有
+ *         一到两块, 合起来的需求大于容量, 所以任务时常在内存池为空时阻塞;
+ *         同时模拟中断每个节拍用 timeout=0 分配/释放几次, 内存池大多数时候
+ *         还有空闲块, 中断的分配应大多成功. 每个内存块写入持有者编号, 释放
+ *         前校验, 检查有没有同一块被分给两个持有者, 以及结束后内存池是否
+ *         全部归还. 任务没有遇到过空内存池, 或中断分配成功的不到一半时
+ *         判为失败 (压力测试没有覆盖到要测的情况).
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "cmsis_os2.h"
+#include "bench_util.h"
+
+#define BENCH_SIM_IRQ       7U        // 与 kernel_bench / uart_sim 的中断号错开
+#define BENCH_BLOCK_SIZE    64U
+#define BENCH_COST_BLOCKS   8U
+#define BENCH_COST_SAMPLES  10000U
+#define BENCH_STRESS_BLOCKS 5U
+#define BENCH_WORKERS       4U
+#define BENCH_WORKER_HOLD   2U        // 每个任务最多同时持有的块数
+#define BENCH_IRQS_PER_TICK 4U
+#define BENCH_STRESS_TICKS  2000U
+#define BENCH_PRIORITY      (configMAX_PRIORITIES - 8U)
+
+typedef struct
+{
+  uint32_t Id;
+  uint32_t Allocs;
+  uint32_t Waits;                     // 分配时内存池已空的次数
+  uint32_t Errors;
+  TaskHandle_t Handle;
+} Worker_t;
+
+static osMemoryPoolId_t Pool;
+static Worker_t Workers[BENCH_WORKERS];
+static uint64_t Samples[BENCH_COST_SAMPLES];
+static volatile uint32_t IrqAllocs;
+static volatile uint32_t IrqEmpty;
+static volatile uint32_t IrqErrors;
+static volatile uint8_t IrqTimed;
+static volatile uint64_t IrqNs;
+static volatile uint8_t Stop;
+
+// 原实现的等价操作: 计数信号量 + 临界区保护的单链表
+static SemaphoreHandle_t BaseSem;
+static void *BaseHead;
+static uint8_t BaseArr[BENCH_COST_BLOCKS][BENCH_BLOCK_SIZE];
+
+static void *BaseAlloc(void)
+{
+  void *block = NULL;
+
+  if (xSemaphoreTake(BaseSem, 0) == pdTRUE)
+  {
+    taskENTER_CRITICAL();
+    block = BaseHead;
+    BaseHead = *(void **)block;
+    taskEXIT_CRITICAL();
+  }
+  return block;
+}
+
+static void BaseFree(void *block)
+{
+  if (uxSemaphoreGetCount(BaseSem) != BENCH_COST_BLOCKS)
+  {
+    taskENTER_CRITICAL();
+    *(void **)block = BaseHead;
+    BaseHead = block;
+    taskEXIT_CRITICAL();
+    xSemaphoreGive(BaseSem);
+  }
+}
+
+static int CompareU64(const void *a, const void *b)
+{
+  uint64_t x = *(const uint64_t *)a;
+  uint64_t y = *(const uint64_t *)b;
+
+  return (x > y) - (x < y);
+}
+
+static void Report(const char *name, uint32_t count)
+{
+  uint64_t sum = 0;
+  uint32_t i;
+
+  qsort(Samples, count, sizeof(Samples[0]), CompareU64);
+  for (i = 0; i < count; i++)
+  {
+    sum += Samples[i];
+  }
+  printf("mpool_cost op=%s n=%lu min=%llu avg=%llu p99=%llu max=%llu\n", name, (unsigned long)count,
+         (unsigned long long)Samples[0], (unsigned long long)(sum / count),
+         (unsigned long long)Samples[(count * 99U) / 100U], (unsigned long long)Samples[count - 1U]);
+}
+
+// 模拟中断: 测耗时时只做一次计时的分配+释放, 压力测试时分配后立即校验并释放
+static uint32_t Bench_SimIrq(void)
+{
+  uint64_t start;
+  uint8_t *block;
+
+  start = NowNs();
+  block = osMemoryPoolAlloc(Pool, 0U);
+  if (block == NULL)
+  {
+    IrqEmpty++;
+    return pdFALSE;
+  }
+  if (IrqTimed != 0U)
+  {
+    (void)osMemoryPoolFree(Pool, block);
+    IrqNs = NowNs() - start;
+    return pdFALSE;
+  }
+
+  IrqAllocs++;
+  memset(block, 0xA5, BENCH_BLOCK_SIZE);
+  if ((block[0] != 0xA5U) || (block[BENCH_BLOCK_SIZE - 1U] != 0xA5U))
+  {
+    IrqErrors++;
+  }
+  if (osMemoryPoolFree(Pool, block) != osOK)
+  {
+    IrqErrors++;
+  }
+  return pdFALSE;
+}
+
+static void MeasureCost(void)
+{
+  uint64_t start;
+  void *block;
+  uint32_t i;
+
+  for (i = 0; i < BENCH_COST_SAMPLES; i++)
+  {
+    start = NowNs();
+    block = osMemoryPoolAlloc(Pool, 0U);
+    (void)osMemoryPoolFree(Pool, block);
+    Samples[i] = NowNs() - start;
+  }
+  Report("task", BENCH_COST_SAMPLES);
+
+  IrqTimed = 1U;
+  for (i = 0; i < BENCH_COST_SAMPLES; i++)
+  {
+    vPortGenerateSimulatedInterrupt(BENCH_SIM_IRQ);
+    Samples[i] = IrqNs;
+  }
+  IrqTimed = 0U;
+  Report("isr", BENCH_COST_SAMPLES);
+
+  for (i = 0; i < BENCH_COST_SAMPLES; i++)
+  {
+    start = NowNs();
+    block = BaseAlloc();
+    BaseFree(block);
+    Samples[i] = NowNs() - start;
+  }
+  Report("sem_crit", BENCH_COST_SAMPLES);
+}
+
+static void Worker_Task(void *argument)
+{
+  Worker_t *worker = argument;
+  uint32_t *blocks[BENCH_WORKER_HOLD];
+  uint32_t count;
+  uint32_t b;
+  uint32_t i;
+
+  while (Stop == 0U)
+  {
+    count = 1U + ((uint32_t)rand() % BENCH_WORKER_HOLD);
+    for (b = 0; b < count; b++)
+    {
+      if (osMemoryPoolGetSpace(Pool) == 0U)
+      {
+        worker->Waits++;
+      }
+      blocks[b] = osMemoryPoolAlloc(Pool, osWaitForever);
+      if (blocks[b] == NULL)
+      {
+        worker->Errors++;
+        break;
+      }
+      worker->Allocs++;
+      for (i = 0; i < BENCH_BLOCK_SIZE / sizeof(uint32_t); i++)
+      {
+        blocks[b][i] = worker->Id;
+      }
+    }
+    count = b;
+
+    // 持有一段时间, 让其他任务在内存池为空时阻塞
+    vTaskDelay((TickType_t)(rand() % 3));
+    for (b = 0; b < count; b++)
+    {
+      for (i = 0; i < BENCH_BLOCK_SIZE / sizeof(uint32_t); i++)
+      {
+        if (blocks[b][i] != worker->Id)
+        {
+          worker->Errors++;
+          break;
+        }
+      }
+      if (osMemoryPoolFree(Pool, blocks[b]) != osOK)
+      {
+        worker->Errors++;
+      }
+    }
+
+    // 歇一会再分配, 让内存池在大部分时间里还有空闲块
+    vTaskDelay((TickType_t)(1 + (rand() % 3)));
+  }
+  vTaskSuspend(NULL);
+}
+
+static void Bench_Task(void *argument)
+{
+  TickType_t end;
+  uint32_t waits = 0;
+  uint32_t w;
+
+  (void)argument;
+
+  printf("# mpool_bench unit=ns block=%u\n", BENCH_BLOCK_SIZE);
+
+  Pool = osMemoryPoolNew(BENCH_COST_BLOCKS, BENCH_BLOCK_SIZE, NULL);
+  BaseSem = xSemaphoreCreateCounting(BENCH_COST_BLOCKS, BENCH_COST_BLOCKS);
+  for (w = 0; w < BENCH_COST_BLOCKS; w++)
+  {
+    *(void **)BaseArr[w] = BaseHead;
+    BaseHead = BaseArr[w];
+  }
+  vPortSetInterruptHandler(BENCH_SIM_IRQ, Bench_SimIrq);
+  MeasureCost();
+  (void)osMemoryPoolDelete(Pool);
+
+  Pool = osMemoryPoolNew(BENCH_STRESS_BLOCKS, BENCH_BLOCK_SIZE, NULL);
+  for (w = 0; w < BENCH_WORKERS; w++)
+  {
+    Workers[w].Id = w + 1U;
+    xTaskCreate(Worker_Task, "Worker", configMINIMAL_STACK_SIZE * 2U, &Workers[w], BENCH_PRIORITY - 1U - w,
+                &Workers[w].Handle);
+  }
+
+  end = xTaskGetTickCount() + BENCH_STRESS_TICKS;
+  while (xTaskGetTickCount() < end)
+  {
+    for (w = 0; w < BENCH_IRQS_PER_TICK; w++)
+    {
+      vPortGenerateSimulatedInterrupt(BENCH_SIM_IRQ);
+    }
+    vTaskDelay(1);
+  }
+  Stop = 1U;
+  // 等所有任务归还内存块
+  vTaskDelay(20);
+
+  Errors += IrqErrors;
+  for (w = 0; w < BENCH_WORKERS; w++)
+  {
+    printf("mpool_worker id=%lu allocs=%lu waits=%lu errors=%lu\n", (unsigned long)Workers[w].Id,
+           (unsigned long)Workers[w].Allocs, (unsigned long)Workers[w].Waits, (unsigned long)Workers[w].Errors);
+    Errors += Workers[w].Errors;
+    waits += Workers[w].Waits;
+  }
+  printf("mpool_isr allocs=%lu empty=%lu errors=%lu\n", (unsigned long)IrqAllocs, (unsigned long)IrqEmpty,
+         (unsigned long)IrqErrors);
+  printf("mpool_check space=%lu capacity=%lu\n", (unsigned long)osMemoryPoolGetSpace(Pool),
+         (unsigned long)osMemoryPoolGetCapacity(Pool));
+  BENCH_FAIL_IF(osMemoryPoolGetSpace(Pool) != BENCH_STRESS_BLOCKS);
+  BENCH_FAIL_IF(waits == 0U);
+  BENCH_FAIL_IF(IrqAllocs < IrqEmpty);
+  BENCH_Finish();
+}
+
+int main(void)
+{
+  srand(1);
+  xTaskCreate(Bench_Task, "Bench", configMINIMAL_STACK_SIZE * 4U, NULL, BENCH_PRIORITY, NULL);
+  vTaskStartScheduler();
+  return 0;
+}
@@ -0,0 +1,466 @@
+/**
+ ******************************************************************************
+ * @file    mpstream_bench.c
+ * @brief   多生产者流缓冲区/消息缓冲区 (configUSE_STREAM_BUFFER_MULTI_PRODUCER)
+ *          的开销和正确性
+ *
+ * cost     一个任务向消息缓冲区发送 16 字节消息, 每条的平均耗时 (ns),
+ *          每 32 条读空一次, 读的时间不计入.  每项测 BENCH_REPEAT 次取最快.
+ *          mutex     互斥量保护的普通消息缓冲区 (多个写者的老办法)
+ *          critical  临界区保护的普通消息缓冲区
+ *          mp_send   多生产者缓冲区上的 xMessageBufferSend
+ *          mp_claim  多生产者缓冲区上的 Claim, 原地填写, Publish
+ * stress   BENCH_PRODUCERS 个不同优先级的任务和一个模拟中断同时向一个多
+ *          生产者消息缓冲区写带序号的变长消息, 一个读任务校验每个写者的
+ *          序号连续, 内容完整, 消息没有被拆开或交错.  用 Claim/Publish 的
+ *          任务在发布前触发中断, 让中断在它的占用之后再占用并先发布.
+ * check    乱序发布时读者只在最后一个占用发布后才看到数据, 且按占用顺序;
+ *          触发水位唤醒读任务; 有未发布的占用时 Reset 失败; 流缓冲区放不
+ *          下时 Send 写一部分而 Claim 什么也不占; 已占用的空间不算空闲;
+ *          静态创建.
+ ******************************************************************************
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "stream_buffer.h"
+#include "message_buffer.h"
+#include "bench_util.h"
+
+#define BENCH_PRIORITY      (configMAX_PRIORITIES - 8U)
+#define BENCH_SIM_IRQ       14U       // 与其他测试和 uart_sim 的中断号错开
+#define BENCH_REPEAT        3U
+#define BENCH_COST_CALLS    (32U * 4096U)
+#define BENCH_COST_BATCH    32U
+#define BENCH_COST_LENGTH   16U
+#define BENCH_PRODUCERS     3U
+#define BENCH_MESSAGES      20000U    // 每个写任务
+#define BENCH_BUFFER_SIZE   256U
+#define BENCH_MAX_PAYLOAD   13U
+#define BENCH_HEADER        5U        // 4 字节序号 + 1 字节写者编号
+#define BENCH_WRITERS       (BENCH_PRODUCERS + 1U)   // 最后一个是中断
+
+static MessageBufferHandle_t StressBuffer;
+static uint32_t IsrSeq;
+static volatile uint32_t IsrSent;
+static volatile uint32_t IsrFull;
+static volatile uint32_t FullRetries;
+static volatile uint32_t ProducersDone;
+static volatile uint32_t ConsumerDone;
+static uint32_t Expected[BENCH_WRITERS];
+static uint32_t Received;
+static uint32_t OrderErrors;
+static MessageBufferHandle_t IsrBuffer;
+
+// 消息: 序号(4) 写者编号(1) 内容(序号 % 14 字节), 内容由编号和序号决定
+static size_t BuildMessage(uint8_t *message, uint8_t id, uint32_t seq)
+{
+  size_t length = seq % (BENCH_MAX_PAYLOAD + 1U);
+  size_t i;
+
+  memcpy(message, &seq, sizeof(seq));
+  message[4] = id;
+  for (i = 0; i < length; i++)
+  {
+    message[BENCH_HEADER + i] = (uint8_t)((id * 31U) + seq + i);
+  }
+  return BENCH_HEADER + length;
+}
+
+static void CheckMessage(const uint8_t *message, size_t length)
+{
+  uint8_t expected[BENCH_HEADER + BENCH_MAX_PAYLOAD];
+  uint32_t seq;
+  uint8_t id;
+
+  if (length < BENCH_HEADER)
+  {
+    OrderErrors++;
+    return;
+  }
+
+  memcpy(&seq, message, sizeof(seq));
+  id = message[4];
+  if ((id >= BENCH_WRITERS) || (seq != Expected[id]) ||
+      (BuildMessage(expected, id, seq) != length) || (memcmp(expected, message, length) != 0))
+  {
+    OrderErrors++;
+    return;
+  }
+  Expected[id]++;
+  Received++;
+}
+
+// 把消息写进占用的空间, 回绕时分两段
+static void CopyToRegion(const StreamBufferRegion_t *region, const uint8_t *data, size_t length)
+{
+  memcpy(region->pucFirst, data, region->xFirstLength);
+  if (length > region->xFirstLength)
+  {
+    memcpy(region->pucSecond, data + region->xFirstLength, length - region->xFirstLength);
+  }
+}
+
+// ---------------------------------------------------------------- cost
+
+static uint64_t RunCost(uint32_t method, MessageBufferHandle_t buffer, SemaphoreHandle_t mutex)
+{
+  StreamBufferRegion_t region;
+  uint8_t tx[BENCH_COST_LENGTH];
+  uint8_t rx[BENCH_COST_LENGTH];
+  uint64_t total = 0U;
+  uint64_t start;
+  uint32_t i;
+  uint32_t j;
+
+  memset(tx, 0x5A, sizeof(tx));
+  for (i = 0; i < (BENCH_COST_CALLS / BENCH_COST_BATCH); i++)
+  {
+    start = NowNs();
+    for (j = 0; j < BENCH_COST_BATCH; j++)
+    {
+      switch (method)
+      {
+        case 0U:
+          (void)xSemaphoreTake(mutex, portMAX_DELAY);
+          BENCH_FAIL_IF(xMessageBufferSend(buffer, tx, sizeof(tx), 0U) != sizeof(tx));
+          (void)xSemaphoreGive(mutex);
+          break;
+        case 1U:
+          taskENTER_CRITICAL();
+          BENCH_FAIL_IF(xMessageBufferSend(buffer, tx, sizeof(tx), 0U) != sizeof(tx));
+          taskEXIT_CRITICAL();
+          break;
+        case 2U:
+          BENCH_FAIL_IF(xMessageBufferSend(buffer, tx, sizeof(tx), 0U) != sizeof(tx));
+          break;
+        default:
+          BENCH_FAIL_IF(xMessageBufferClaim(buffer, &region, sizeof(tx)) != sizeof(tx));
+          CopyToRegion(&region, tx, sizeof(tx));
+          (void)xMessageBufferPublish(buffer);
+          break;
+      }
+    }
+    total += NowNs() - start;
+
+    for (j = 0; j < BENCH_COST_BATCH; j++)
+    {
+      BENCH_FAIL_IF(xMessageBufferReceive(buffer, rx, sizeof(rx), 0U) != sizeof(rx));
+    }
+  }
+  return total;
+}
+
+static void MeasureCost(void)
+{
+  static const char *const names[] = { "mutex", "critical", "mp_send", "mp_claim" };
+  MessageBufferHandle_t plain = xMessageBufferCreate(1024U);
+  MessageBufferHandle_t mp = xMessageBufferCreateMultiProducer(1024U);
+  SemaphoreHandle_t mutex = xSemaphoreCreateMutex();
+  uint64_t best;
+  uint64_t ns;
+  uint32_t method;
+  uint32_t r;
+
+  for (method = 0U; method < 4U; method++)
+  {
+    best = UINT64_MAX;
+    for (r = 0U; r < BENCH_REPEAT; r++)
+    {
+      ns = RunCost(method, (method < 2U) ? plain : mp, mutex);
+      if (ns < best)
+      {
+        best = ns;
+      }
+    }
+    printf("%s,%llu\n", names[method], (unsigned long long)(best / BENCH_COST_CALLS));
+  }
+
+  vSemaphoreDelete(mutex);
+  vMessageBufferDelete(mp);
+  vMessageBufferDelete(plain);
+}
+
+// ---------------------------------------------------------------- stress
+
+// 中断写者: 放不下就丢掉, 序号只在写成功后递增, 读者仍可以检查连续
+static uint32_t Stress_SimIrq(void)
+{
+  uint8_t message[BENCH_HEADER + BENCH_MAX_PAYLOAD];
+  BaseType_t woken = pdFALSE;
+  size_t length = BuildMessage(message, (uint8_t)BENCH_PRODUCERS, IsrSeq);
+
+  if (xMessageBufferSendFromISR(StressBuffer, message, length, &woken) == length)
+  {
+    IsrSeq++;
+    IsrSent++;
+  }
+  else
+  {
+    IsrFull++;
+  }
+  return (uint32_t)woken;
+}
+
+static void Producer_Task(void *argument)
+{
+  uint8_t id = (uint8_t)(uintptr_t)argument;
+  uint8_t message[BENCH_HEADER + BENCH_MAX_PAYLOAD];
+  StreamBufferRegion_t region;
+  uint32_t seq;
+  size_t length;
+  size_t sent;
+
+  for (seq = 0U; seq < BENCH_MESSAGES; seq++)
+  {
+    length = BuildMessage(message, id, seq);
+    for (;;)
+    {
+      if ((id & 1U) != 0U)
+      {
+        sent = xMessageBufferSend(StressBuffer, message, length, portMAX_DELAY);
+      }
+      else
+      {
+        sent = xMessageBufferClaim(StressBuffer, &region, length);
+        if (sent != 0U)
+        {
+          CopyToRegion(&region, message, length);
+          if ((seq % 8U) == 0U)
+          {
+            // 中断在这个占用之后占用, 并且先发布
+            vPortGenerateSimulatedInterrupt(BENCH_SIM_IRQ);
+          }
+          (void)xMessageBufferPublish(StressBuffer);
+        }
+      }
+
+      if (sent == length)
+      {
+        break;
+      }
+      // 写者不阻塞, 满了就让读任务运行一会儿
+      FullRetries++;
+      vTaskDelay(1);
+    }
+
+    if ((seq % 64U) == 0U)
+    {
+      vTaskDelay(1);
+    }
+  }
+
+  taskENTER_CRITICAL();
+  ProducersDone++;
+  taskEXIT_CRITICAL();
+  for (;;)
+  {
+    vTaskDelay(portMAX_DELAY);
+  }
+}
+
+static void Consumer_Task(void *argument)
+{
+  uint8_t message[BENCH_HEADER + BENCH_MAX_PAYLOAD];
+  size_t length;
+
+  (void)argument;
+  for (;;)
+  {
+    length = xMessageBufferReceive(StressBuffer, message, sizeof(message), 10U);
+    if (length != 0U)
+    {
+      CheckMessage(message, length);
+    }
+    else if (ProducersDone == BENCH_PRODUCERS)
+    {
+      break;
+    }
+  }
+
+  ConsumerDone = 1U;
+  for (;;)
+  {
+    vTaskDelay(portMAX_DELAY);
+  }
+}
+
+static void RunStress(void)
+{
+  TaskHandle_t tasks[BENCH_PRODUCERS + 1U];
+  uint32_t i;
+
+  StressBuffer = xMessageBufferCreateMultiProducer(BENCH_BUFFER_SIZE);
+  vPortSetInterruptHandler(BENCH_SIM_IRQ, Stress_SimIrq);
+
+  // 两个写者同优先级靠时间片交替, 一个更高优先级的写者随时抢占;
+  // 读任务优先级最低, 只在写者都让出时运行, 缓冲区经常是满的
+  xTaskCreate(Consumer_Task, "Consumer", configMINIMAL_STACK_SIZE * 2U, NULL, BENCH_PRIORITY + 1U, &tasks[BENCH_PRODUCERS]);
+  for (i = 0U; i < BENCH_PRODUCERS; i++)
+  {
+    xTaskCreate(Producer_Task, "Producer", configMINIMAL_STACK_SIZE * 2U, (void *)(uintptr_t)i,
+                BENCH_PRIORITY + 2U + ((i == (BENCH_PRODUCERS - 1U)) ? 1U : 0U), &tasks[i]);
+  }
+
+  while (ConsumerDone == 0U)
+  {
+    vTaskDelay(10);
+  }
+
+  for (i = 0U; i <= BENCH_PRODUCERS; i++)
+  {
+    vTaskDelete(tasks[i]);
+  }
+  vMessageBufferDelete(StressBuffer);
+
+  for (i = 0U; i < BENCH_PRODUCERS; i++)
+  {
+    BENCH_FAIL_IF(Expected[i] != BENCH_MESSAGES);
+  }
+  BENCH_FAIL_IF((Expected[BENCH_PRODUCERS] != IsrSent) || (IsrSent == 0U));
+  BENCH_FAIL_IF(Received != ((BENCH_PRODUCERS * BENCH_MESSAGES) + IsrSent));
+  BENCH_FAIL_IF(OrderErrors != 0U);
+
+  printf("mpstream_stress producers=%u messages=%lu isr_sent=%lu isr_full=%lu full_retries=%lu received=%lu order_errors=%lu\n",
+         (unsigned)BENCH_PRODUCERS, (unsigned long)(BENCH_PRODUCERS * BENCH_MESSAGES), (unsigned long)IsrSent,
+         (unsigned long)IsrFull, (unsigned long)FullRetries, (unsigned long)Received, (unsigned long)OrderErrors);
+}
+
+// ---------------------------------------------------------------- check
+
+typedef struct
+{
+  StreamBufferHandle_t buffer;
+  volatile size_t result;
+  volatile uint8_t done;
+} Peer_t;
+
+static void Reader_Task(void *argument)
+{
+  Peer_t *peer = argument;
+  uint8_t rx[16];
+
+  peer->result = xStreamBufferReceive(peer->buffer, rx, sizeof(rx), portMAX_DELAY);
+  peer->done = 1U;
+  for (;;)
+  {
+    vTaskDelay(portMAX_DELAY);
+  }
+}
+
+static uint32_t Check_SimIrq(void)
+{
+  BaseType_t woken = pdFALSE;
+  const uint8_t message[2] = { 'I', 'I' };
+
+  (void)xMessageBufferSendFromISR(IsrBuffer, message, sizeof(message), &woken);
+  return (uint32_t)woken;
+}
+
+static void ExpectMessage(MessageBufferHandle_t buffer, const char *text)
+{
+  uint8_t rx[16];
+  size_t length = strlen(text);
+
+  BENCH_FAIL_IF((xMessageBufferReceive(buffer, rx, sizeof(rx), 0U) != length) || (memcmp(rx, text, length) != 0));
+}
+
+static void CheckMultiProducer(void)
+{
+  static uint8_t storage[64U + 1U];
+  static StaticMessageBuffer_t staticBuffer;
+  StreamBufferRegion_t a;
+  StreamBufferRegion_t b;
+  MessageBufferHandle_t message;
+  StreamBufferHandle_t stream;
+  uint8_t data[16];
+  Peer_t peer;
+  TaskHandle_t task;
+  uint32_t early;
+
+  // 后占用的先发布: 数据要等先占用的也发布后才出现, 按占用顺序读出
+  message = xMessageBufferCreateMultiProducerStatic(sizeof(storage), storage, &staticBuffer);
+  BENCH_FAIL_IF(message == NULL);
+  BENCH_FAIL_IF(xMessageBufferClaim(message, &a, 3U) != 3U);
+  BENCH_FAIL_IF(xMessageBufferClaim(message, &b, 4U) != 4U);
+  CopyToRegion(&b, (const uint8_t *)"bbbb", 4U);
+  BENCH_FAIL_IF(xMessageBufferPublish(message) != pdFALSE);
+  BENCH_FAIL_IF(xMessageBufferIsEmpty(message) != pdTRUE);
+  CopyToRegion(&a, (const uint8_t *)"aaa", 3U);
+  BENCH_FAIL_IF(xMessageBufferPublish(message) != pdTRUE);
+  ExpectMessage(message, "aaa");
+  ExpectMessage(message, "bbbb");
+
+  // 中断在任务的占用打开时写入, 同样排在任务消息之后
+  IsrBuffer = message;
+  vPortSetInterruptHandler(BENCH_SIM_IRQ, Check_SimIrq);
+  BENCH_FAIL_IF(xMessageBufferClaim(message, &a, 2U) != 2U);
+  vPortGenerateSimulatedInterrupt(BENCH_SIM_IRQ);
+  BENCH_FAIL_IF(xMessageBufferIsEmpty(message) != pdTRUE);
+  CopyToRegion(&a, (const uint8_t *)"TT", 2U);
+  (void)xMessageBufferPublish(message);
+  ExpectMessage(message, "TT");
+  ExpectMessage(message, "II");
+
+  // 有未发布的占用时不能 Reset; 占用的空间不算空闲
+  BENCH_FAIL_IF(xMessageBufferClaim(message, &a, 8U) != 8U);
+  BENCH_FAIL_IF(xMessageBufferSpacesAvailable(message) != (64U - 8U - sizeof(configMESSAGE_BUFFER_LENGTH_TYPE)));
+  BENCH_FAIL_IF(xMessageBufferReset(message) != pdFAIL);
+  CopyToRegion(&a, (const uint8_t *)"cccccccc", 8U);
+  (void)xMessageBufferPublish(message);
+  BENCH_FAIL_IF(xMessageBufferReset(message) != pdPASS);
+  BENCH_FAIL_IF(xMessageBufferSpacesAvailable(message) != 64U);
+  vMessageBufferDelete(message);
+
+  // 流缓冲区放不下时 Send 写一部分, Claim 什么也不占
+  stream = xStreamBufferCreateMultiProducer(16U, 1U);
+  memset(data, 0x33, sizeof(data));
+  BENCH_FAIL_IF(xStreamBufferSend(stream, data, 10U, 0U) != 10U);
+  BENCH_FAIL_IF(xStreamBufferSend(stream, data, 10U, 0U) != 6U);
+  BENCH_FAIL_IF(xStreamBufferReceive(stream, data, 4U, 0U) != 4U);
+  BENCH_FAIL_IF(xStreamBufferClaim(stream, &a, 5U) != 0U);
+  BENCH_FAIL_IF(xStreamBufferSpacesAvailable(stream) != 4U);
+  vStreamBufferDelete(stream);
+
+  // 触发水位 8: 发布 4 字节不唤醒读任务, 再发布 4 字节才唤醒
+  stream = xStreamBufferCreateMultiProducer(64U, 8U);
+  peer.buffer = stream;
+  peer.result = 0U;
+  peer.done = 0U;
+  xTaskCreate(Reader_Task, "Reader", configMINIMAL_STACK_SIZE * 2U, &peer, BENCH_PRIORITY + 1U, &task);
+  (void)xStreamBufferSend(stream, data, 4U, 0U);
+  early = peer.done;
+  BENCH_FAIL_IF(xStreamBufferClaim(stream, &a, 4U) != 4U);
+  CopyToRegion(&a, data, 4U);
+  (void)xStreamBufferPublish(stream);
+  BENCH_FAIL_IF((early != 0U) || (peer.done == 0U) || (peer.result != 8U));
+  vTaskDelete(task);
+  vStreamBufferDelete(stream);
+
+  printf("mpstream_check errors=%lu\n", (unsigned long)Errors);
+}
+
+static void Bench_Task(void *argument)
+{
+  (void)argument;
+
+  printf("# mpstream_bench unit=ns_per_send length=%u\n", (unsigned)BENCH_COST_LENGTH);
+  printf("method,ns\n");
+  MeasureCost();
+  RunStress();
+  CheckMultiProducer();
+
+  BENCH_Finish();
+}
+
+int main(void)
+{
+  xTaskCreate(Bench_Task, "Bench", configMINIMAL_STACK_SIZE * 4U, NULL, BENCH_PRIORITY, NULL);
+  vTaskStartScheduler();
+  return 0;
+}
@@ -0,0 +1,263 @@
+/**
+ ******************************************************************************
+ * @file    mutex_bench.c
+ * @brief   互斥量快速路径 (configUSE_MUTEX_FAST_PATH) 的耗时和正确性
+ *
+ * cost     单个任务没有竞争地获取+释放一次的平均耗时, 测 BENCH_COST_ROUNDS
+ *          轮取最小值: osMutex (普通/递归) 和 xSemaphoreTake/Give.
+ *          与 mutex_bench_slowmutex (关闭快速路径的内核) 的结果比较.
+ * contend  几个同优先级的任务在持有互斥量时让出 CPU, 检查互斥和计数.
+ * inherit  低优先级任务在快速路径上持有互斥量时, 高优先级任务等待它:
+ *          持有者应继承等待者的优先级, 释放或等待超时后恢复.
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "cmsis_os2.h"
+#include "bench_util.h"
+
+#define BENCH_COST_ITEMS    1000000U
+#define BENCH_COST_ROUNDS   5U
+#define BENCH_CONTENDERS    4U
+#define BENCH_CONTEND_LOOPS 2000U
+#define BENCH_PRIORITY      (configMAX_PRIORITIES - 8U)
+#define BENCH_LOW_PRIORITY  (BENCH_PRIORITY - 3U)
+
+static osMutexId_t Lock;
+static volatile uint32_t Shared;
+static volatile uint32_t Inside;
+static volatile uint32_t ContendDone;
+static volatile uint8_t Taken;
+static volatile uint8_t Go;
+static volatile UBaseType_t InheritedPrio;
+static volatile UBaseType_t ReleasedPrio;
+
+static void ReportCost(const char *name, uint64_t best)
+{
+  printf("%s,%llu.%02llu\n", name, (unsigned long long)(best / BENCH_COST_ITEMS),
+         (unsigned long long)(((best % BENCH_COST_ITEMS) * 100U) / BENCH_COST_ITEMS));
+}
+
+static void MeasureOsMutex(const char *name, uint32_t attrBits)
+{
+  osMutexAttr_t attr;
+  osMutexId_t mutex;
+  uint64_t best = UINT64_MAX;
+  uint64_t start;
+  uint64_t ns;
+  uint32_t r;
+  uint32_t i;
+
+  memset(&attr, 0, sizeof(attr));
+  attr.attr_bits = attrBits;
+  mutex = osMutexNew(&attr);
+  for (r = 0; r < BENCH_COST_ROUNDS; r++)
+  {
+    start = NowNs();
+    for (i = 0; i < BENCH_COST_ITEMS; i++)
+    {
+      (void)osMutexAcquire(mutex, osWaitForever);
+      (void)osMutexRelease(mutex);
+    }
+    ns = NowNs() - start;
+    best = (ns < best) ? ns : best;
+  }
+  BENCH_FAIL_IF(osMutexGetOwner(mutex) != NULL);
+  (void)osMutexDelete(mutex);
+  ReportCost(name, best);
+}
+
+static void MeasureSemaphore(void)
+{
+  SemaphoreHandle_t mutex = xSemaphoreCreateMutex();
+  uint64_t best = UINT64_MAX;
+  uint64_t start;
+  uint64_t ns;
+  uint32_t r;
+  uint32_t i;
+
+  for (r = 0; r < BENCH_COST_ROUNDS; r++)
+  {
+    start = NowNs();
+    for (i = 0; i < BENCH_COST_ITEMS; i++)
+    {
+      (void)xSemaphoreTake(mutex, portMAX_DELAY);
+      (void)xSemaphoreGive(mutex);
+    }
+    ns = NowNs() - start;
+    best = (ns < best) ? ns : best;
+  }
+  vSemaphoreDelete(mutex);
+  ReportCost("semaphore", best);
+}
+
+// 持有互斥量时让出 CPU, 其它任务只能阻塞在互斥量上
+static void Contender_Task(void *argument)
+{
+  uint32_t i;
+
+  (void)argument;
+
+  for (i = 0; i < BENCH_CONTEND_LOOPS; i++)
+  {
+    (void)osMutexAcquire(Lock, osWaitForever);
+    BENCH_FAIL_IF(Inside != 0U);
+    BENCH_FAIL_IF(osMutexGetOwner(Lock) != osThreadGetId());
+    Inside = 1U;
+    Shared++;
+    if ((i % 4U) == 0U)
+    {
+      taskYIELD();
+    }
+    Inside = 0U;
+    (void)osMutexRelease(Lock);
+    if ((i % 3U) == 0U)
+    {
+      taskYIELD();
+    }
+  }
+  ContendDone++;
+  vTaskSuspend(NULL);
+}
+
+static void CheckContention(void)
+{
+  TaskHandle_t tasks[BENCH_CONTENDERS];
+  uint64_t start;
+  uint32_t i;
+
+  Lock = osMutexNew(NULL);
+  Shared = 0;
+  ContendDone = 0;
+  start = NowNs();
+  for (i = 0; i < BENCH_CONTENDERS; i++)
+  {
+    xTaskCreate(Contender_Task, "Contend", configMINIMAL_STACK_SIZE * 2U, NULL, BENCH_PRIORITY - 1U, &tasks[i]);
+  }
+  while (ContendDone < BENCH_CONTENDERS)
+  {
+    vTaskDelay(1);
+  }
+  for (i = 0; i < BENCH_CONTENDERS; i++)
+  {
+    vTaskDelete(tasks[i]);
+  }
+  BENCH_FAIL_IF(Shared != (BENCH_CONTENDERS * BENCH_CONTEND_LOOPS));
+  BENCH_FAIL_IF(osMutexGetOwner(Lock) != NULL);
+  printf("contend tasks=%u loops=%u total_us=%llu shared=%lu\n", BENCH_CONTENDERS, BENCH_CONTEND_LOOPS,
+         (unsigned long long)((NowNs() - start) / 1000U), (unsigned long)Shared);
+  (void)osMutexDelete(Lock);
+}
+
+// 低优先级持有者: 等测试任务开始等待后, 记录继承到的优先级, 释放后再记录一次
+static void Holder_Task(void *argument)
+{
+  (void)argument;
+
+  (void)osMutexAcquire(Lock, osWaitForever);
+  Taken = 1U;
+  while (Go == 0U)
+  {
+  }
+  InheritedPrio = uxTaskPriorityGet(NULL);
+  (void)osMutexRelease(Lock);
+  ReleasedPrio = uxTaskPriorityGet(NULL);
+  vTaskSuspend(NULL);
+}
+
+static void CheckInheritance(void)
+{
+  TaskHandle_t holder;
+
+  // 释放时继承的优先级被收回
+  Lock = osMutexNew(NULL);
+  Taken = 0U;
+  Go = 0U;
+  xTaskCreate(Holder_Task, "Holder", configMINIMAL_STACK_SIZE * 2U, NULL, BENCH_LOW_PRIORITY, &holder);
+  while (Taken == 0U)
+  {
+    vTaskDelay(1);
+  }
+  BENCH_FAIL_IF(osMutexGetOwner(Lock) != (osThreadId_t)holder);
+  Go = 1U;
+  BENCH_FAIL_IF(osMutexAcquire(Lock, 100U) != osOK);
+  BENCH_FAIL_IF(osMutexGetOwner(Lock) != osThreadGetId());
+  (void)osMutexRelease(Lock);
+  vTaskDelay(2);
+  BENCH_FAIL_IF((InheritedPrio != BENCH_PRIORITY) || (ReleasedPrio != BENCH_LOW_PRIORITY));
+  printf("inherit holder_prio=%lu inherited=%lu released=%lu\n", (unsigned long)BENCH_LOW_PRIORITY,
+         (unsigned long)InheritedPrio, (unsigned long)ReleasedPrio);
+  vTaskDelete(holder);
+
+  // 等待超时后持有者恢复原优先级, 之后仍能正常释放和再获取
+  Taken = 0U;
+  Go = 0U;
+  xTaskCreate(Holder_Task, "Holder", configMINIMAL_STACK_SIZE * 2U, NULL, BENCH_LOW_PRIORITY, &holder);
+  while (Taken == 0U)
+  {
+    vTaskDelay(1);
+  }
+  BENCH_FAIL_IF(osMutexAcquire(Lock, 5U) != osErrorTimeout);
+  BENCH_FAIL_IF(uxTaskPriorityGet(holder) != BENCH_LOW_PRIORITY);
+  Go = 1U;
+  vTaskDelay(2);
+  BENCH_FAIL_IF(osMutexGetOwner(Lock) != NULL);
+  BENCH_FAIL_IF(osMutexAcquire(Lock, 0U) != osOK);
+  // 非递归互斥量不能被持有者再次获取
+  BENCH_FAIL_IF(osMutexAcquire(Lock, 0U) == osOK);
+  (void)osMutexRelease(Lock);
+  BENCH_FAIL_IF(osMutexRelease(Lock) == osOK);
+  vTaskDelete(holder);
+  (void)osMutexDelete(Lock);
+}
+
+static void CheckRecursive(void)
+{
+  osMutexAttr_t attr;
+  uint32_t i;
+
+  memset(&attr, 0, sizeof(attr));
+  attr.attr_bits = osMutexRecursive;
+  Lock = osMutexNew(&attr);
+  for (i = 0; i < 3U; i++)
+  {
+    BENCH_FAIL_IF(osMutexAcquire(Lock, 0U) != osOK);
+  }
+  for (i = 0; i < 3U; i++)
+  {
+    BENCH_FAIL_IF(osMutexGetOwner(Lock) != osThreadGetId());
+    BENCH_FAIL_IF(osMutexRelease(Lock) != osOK);
+  }
+  BENCH_FAIL_IF(osMutexGetOwner(Lock) != NULL);
+  BENCH_FAIL_IF(osMutexRelease(Lock) == osOK);
+  (void)osMutexDelete(Lock);
+}
+
+static void Bench_Task(void *argument)
+{
+  (void)argument;
+
+  printf("# mutex_bench unit=ns fast_path=%d items=%u\n", configUSE_MUTEX_FAST_PATH, BENCH_COST_ITEMS);
+  printf("name,ns_per_acquire_release\n");
+  MeasureOsMutex("os_mutex", osMutexPrioInherit);
+  MeasureOsMutex("os_mutex_recursive", osMutexRecursive | osMutexPrioInherit);
+  MeasureSemaphore();
+
+  CheckContention();
+  CheckInheritance();
+  CheckRecursive();
+  printf("mutex_check errors=%lu\n", (unsigned long)Errors);
+  BENCH_Finish();
+}
+
+int main(void)
+{
+  xTaskCreate(Bench_Task, "Bench", configMINIMAL_STACK_SIZE * 4U, NULL, BENCH_PRIORITY, NULL);
+  vTaskStartScheduler();
+  return 0;
+}
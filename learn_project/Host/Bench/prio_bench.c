@@ -0,0 +1,230 @@
+/**
+ ******************************************************************************
+ * @file    prio_bench.c
+ * @brief   消息队列在低优先级消息占满时高优先级消息的等待时间
+ *
+ * 低优先级的批量生产者不断以 msg_prio=0 写入, 使队列一直是满的; 消费者
+ * 处理每条消息需要 BENCH_WORK_NS. 测试任务每隔 1~2 个节拍以 msg_prio=200
+ * 写入一条紧急消息, 记录从调用 osMessageQueuePut 到消费者取到它的时间.
+ *   fifo  普通消息队列 (msg_prio 被忽略), 紧急消息排在整个队列之后
+ *   prio  以 osMessageQueuePrio 创建的优先级消息队列
+ * 另外检查优先级队列的出队顺序 (高优先级先出, 同优先级先进先出),
+ * msg_prio 的返回值, 以及从模拟中断写入的高优先级消息.
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "cmsis_os2.h"
+#include "bench_util.h"
+
+#define BENCH_SIM_IRQ       10U       // 与其他测试和 uart_sim 的中断号错开
+#define BENCH_DEPTH         16U
+#define BENCH_WORK_NS       5000U
+#define BENCH_SAMPLES       300U
+#define BENCH_URGENT_PRIO   200U
+#define BENCH_ORDER_DEPTH   64U
+#define BENCH_PRIORITY      (configMAX_PRIORITIES - 8U)
+
+typedef struct
+{
+  uint64_t Stamp;
+  uint32_t Seq;
+  uint8_t Urgent;
+  uint8_t Pad[19];
+} Msg_t;
+
+static osMessageQueueId_t Queue;
+static uint64_t Samples[BENCH_SAMPLES];
+static volatile uint32_t SampleCount;
+
+static int CompareU64(const void *a, const void *b)
+{
+  uint64_t x = *(const uint64_t *)a;
+  uint64_t y = *(const uint64_t *)b;
+
+  return (x > y) - (x < y);
+}
+
+static void Report(const char *mode, uint32_t count)
+{
+  uint64_t sum = 0;
+  uint32_t i;
+
+  if (count == 0U)
+  {
+    printf("%s,0,0,0,0,0\n", mode);
+    Errors++;
+    return;
+  }
+  qsort(Samples, count, sizeof(Samples[0]), CompareU64);
+  for (i = 0; i < count; i++)
+  {
+    sum += Samples[i];
+  }
+  printf("%s,%lu,%llu,%llu,%llu,%llu\n", mode, (unsigned long)count, (unsigned long long)Samples[0],
+         (unsigned long long)(sum / count), (unsigned long long)Samples[(count * 99U) / 100U],
+         (unsigned long long)Samples[count - 1U]);
+}
+
+static void Bulk_Task(void *argument)
+{
+  Msg_t msg;
+
+  (void)argument;
+
+  memset(&msg, 0, sizeof(msg));
+  for (;;)
+  {
+    msg.Seq++;
+    (void)osMessageQueuePut(Queue, &msg, 0U, osWaitForever);
+  }
+}
+
+// 消费者: 取到紧急消息时记录等待时间, 每条消息都模拟 BENCH_WORK_NS 的处理
+static void Consumer_Task(void *argument)
+{
+  uint64_t start;
+  Msg_t msg;
+
+  (void)argument;
+
+  for (;;)
+  {
+    if (osMessageQueueGet(Queue, &msg, NULL, osWaitForever) != osOK)
+    {
+      continue;
+    }
+    if ((msg.Urgent != 0U) && (SampleCount < BENCH_SAMPLES))
+    {
+      Samples[SampleCount++] = NowNs() - msg.Stamp;
+    }
+    start = NowNs();
+    while ((NowNs() - start) < BENCH_WORK_NS)
+    {
+    }
+  }
+}
+
+static void RunLatency(const char *mode, uint32_t attr_bits)
+{
+  osMessageQueueAttr_t attr;
+  TaskHandle_t bulk;
+  TaskHandle_t consumer;
+  Msg_t msg;
+  uint32_t i;
+
+  memset(&attr, 0, sizeof(attr));
+  attr.attr_bits = attr_bits;
+  Queue = osMessageQueueNew(BENCH_DEPTH, sizeof(Msg_t), &attr);
+  SampleCount = 0;
+
+  xTaskCreate(Consumer_Task, "Consumer", configMINIMAL_STACK_SIZE * 2U, NULL, BENCH_PRIORITY - 2U, &consumer);
+  xTaskCreate(Bulk_Task, "Bulk", configMINIMAL_STACK_SIZE * 2U, NULL, BENCH_PRIORITY - 1U, &bulk);
+  vTaskDelay(10);
+
+  memset(&msg, 0, sizeof(msg));
+  msg.Urgent = 1U;
+  for (i = 0; i < BENCH_SAMPLES; i++)
+  {
+    vTaskDelay(1U + ((uint32_t)rand() % 2U));
+    msg.Seq = i;
+    msg.Stamp = NowNs();
+    (void)osMessageQueuePut(Queue, &msg, BENCH_URGENT_PRIO, osWaitForever);
+  }
+  // 等消费者取完最后一条紧急消息
+  vTaskDelay(10);
+
+  vTaskDelete(bulk);
+  vTaskDelete(consumer);
+  (void)osMessageQueueDelete(Queue);
+  Report(mode, SampleCount);
+}
+
+static uint32_t Bench_SimIrq(void)
+{
+  Msg_t msg;
+
+  memset(&msg, 0, sizeof(msg));
+  msg.Urgent = 1U;
+  if (osMessageQueuePut(Queue, &msg, 255U, 0U) != osOK)
+  {
+    Errors++;
+  }
+  return pdFALSE;
+}
+
+// 乱序写入不同优先级的消息, 检查出队顺序和 msg_prio; 再检查中断写入
+static void CheckOrder(void)
+{
+  osMessageQueueAttr_t attr;
+  uint32_t lastSeq = 0;
+  uint8_t lastPrio = 255U;
+  uint8_t prio;
+  Msg_t msg;
+  uint32_t i;
+
+  memset(&attr, 0, sizeof(attr));
+  attr.attr_bits = osMessageQueuePrio;
+  Queue = osMessageQueueNew(BENCH_ORDER_DEPTH, sizeof(Msg_t), &attr);
+  memset(&msg, 0, sizeof(msg));
+
+  for (i = 0; i < BENCH_ORDER_DEPTH; i++)
+  {
+    msg.Seq = i;
+    msg.Pad[0] = (uint8_t)((uint32_t)rand() % 8U);
+    (void)osMessageQueuePut(Queue, &msg, msg.Pad[0], 0U);
+  }
+  BENCH_FAIL_IF(osMessageQueueGetSpace(Queue) != 0U);
+  for (i = 0; i < BENCH_ORDER_DEPTH; i++)
+  {
+    (void)osMessageQueueGet(Queue, &msg, &prio, 0U);
+    if ((prio != msg.Pad[0]) || (prio > lastPrio) || ((prio == lastPrio) && (i != 0U) && (msg.Seq < lastSeq)))
+    {
+      Errors++;
+    }
+    lastPrio = prio;
+    lastSeq = msg.Seq;
+  }
+
+  // 队列中已有低优先级消息时, 中断写入的消息应当最先取出
+  for (i = 0; i < BENCH_ORDER_DEPTH - 1U; i++)
+  {
+    msg.Urgent = 0U;
+    (void)osMessageQueuePut(Queue, &msg, 0U, 0U);
+  }
+  vPortSetInterruptHandler(BENCH_SIM_IRQ, Bench_SimIrq);
+  vPortGenerateSimulatedInterrupt(BENCH_SIM_IRQ);
+  (void)osMessageQueueGet(Queue, &msg, &prio, 0U);
+  BENCH_FAIL_IF((msg.Urgent != 1U) || (prio != 255U));
+  (void)osMessageQueueReset(Queue);
+  BENCH_FAIL_IF(osMessageQueueGetSpace(Queue) != BENCH_ORDER_DEPTH);
+
+  printf("prio_check errors=%lu\n", (unsigned long)Errors);
+  (void)osMessageQueueDelete(Queue);
+}
+
+static void Bench_Task(void *argument)
+{
+  (void)argument;
+
+  printf("# prio_bench unit=ns depth=%u work=%u\n", BENCH_DEPTH, BENCH_WORK_NS);
+  printf("mode,n,min,avg,p99,max\n");
+
+  RunLatency("fifo", 0U);
+  RunLatency("prio", osMessageQueuePrio);
+  CheckOrder();
+  BENCH_Finish();
+}
+
+int main(void)
+{
+  srand(1);
+  xTaskCreate(Bench_Task, "Bench", configMINIMAL_STACK_SIZE * 4U, NULL, BENCH_PRIORITY, NULL);
+  vTaskStartScheduler();
+  return 0;
+}
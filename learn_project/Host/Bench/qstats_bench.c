@@ -0,0 +1,319 @@
+/**
+ ******************************************************************************
+ * @file    qstats_bench.c
+ * @brief   队列统计 (configUSE_QUEUE_STATISTICS) 的开销和注册表快照
+ *
+ * cost     单个任务不等待地 xQueueSend + xQueueReceive 一对调用的平均耗时,
+ *          测 BENCH_COST_ROUNDS 轮取最小值.
+ *          目标上默认关闭统计, qstats_bench_stats 是打开统计的内核,
+ *          两者的结果之差即为计数的开销.
+ *          不阻塞的收发不读时钟, 只有两次计数加一和一次峰值比较,
+ *          在主机上约 2-7ns, 占这一对调用的 7-17%, 达不到 1% 的目标,
+ *          所以默认关闭; 两个内核的代码布局不同, 结果本身有 1ns 左右的波动.
+ * monitor  几个注册了名字的对象上同时有负载:
+ *            hot   生产者比消费者快, 队列经常是满的
+ *            cold  每个节拍只传一条
+ *            lock  两个任务争用的互斥量
+ *          监视任务每 BENCH_PERIOD 个节拍调用一次 uxQueueGetRegistryStats,
+ *          用相邻两次快照的差值输出各对象的收发次数、阻塞次数和阻塞时间,
+ *          并测量快照本身的耗时. 结束后检查计数是否与实际收发一致.
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "cmsis_os2.h"
+#include "bench_util.h"
+
+#define BENCH_COST_ITEMS    1000000U
+#define BENCH_COST_ROUNDS   5U
+#define BENCH_DEPTH         8U
+#define BENCH_PERIOD        200U
+#define BENCH_SAMPLES       5U
+#define BENCH_WORK_NS       20000U
+#define BENCH_PRIORITY      (configMAX_PRIORITIES - 8U)
+
+static osMessageQueueId_t HotQueue;
+static osMessageQueueId_t ColdQueue;
+static osMutexId_t Lock;
+static volatile uint8_t Stop;
+static volatile uint32_t HotSent;
+static volatile uint32_t HotReceived;
+static volatile uint32_t ColdSent;
+static volatile uint32_t ColdReceived;
+static volatile uint32_t LockTaken;
+
+static void Spin(uint32_t ns)
+{
+  uint64_t start = NowNs();
+
+  while ((NowNs() - start) < ns)
+  {
+  }
+}
+
+static void MeasureCost(void)
+{
+  QueueHandle_t queue = xQueueCreate(BENCH_DEPTH, sizeof(uint32_t));
+  uint64_t best = UINT64_MAX;
+  uint64_t start;
+  uint64_t ns;
+  uint32_t item = 0;
+  uint32_t r;
+  uint32_t i;
+
+  for (r = 0; r < BENCH_COST_ROUNDS; r++)
+  {
+    start = NowNs();
+    for (i = 0; i < BENCH_COST_ITEMS; i++)
+    {
+      (void)xQueueSend(queue, &i, 0);
+      (void)xQueueReceive(queue, &item, 0);
+    }
+    ns = NowNs() - start;
+    best = (ns < best) ? ns : best;
+  }
+  printf("qstats_cost items=%u ns_per_pair=%llu.%02llu stats=%d\n", BENCH_COST_ITEMS,
+         (unsigned long long)(best / BENCH_COST_ITEMS), (unsigned long long)(((best % BENCH_COST_ITEMS) * 100U) / BENCH_COST_ITEMS),
+         configUSE_QUEUE_STATISTICS);
+  vQueueDelete(queue);
+}
+
+static void HotProducer_Task(void *argument)
+{
+  uint32_t seq = 0;
+
+  (void)argument;
+
+  while (Stop == 0U)
+  {
+    if (osMessageQueuePut(HotQueue, &seq, 0U, 10U) == osOK)
+    {
+      seq++;
+      HotSent++;
+    }
+  }
+  vTaskSuspend(NULL);
+}
+
+// 消费者处理每条消息要 BENCH_WORK_NS, 比生产者慢
+static void HotConsumer_Task(void *argument)
+{
+  uint32_t seq;
+
+  (void)argument;
+
+  for (;;)
+  {
+    if (osMessageQueueGet(HotQueue, &seq, NULL, 10U) == osOK)
+    {
+      HotReceived++;
+      Spin(BENCH_WORK_NS);
+    }
+    else if (Stop != 0U)
+    {
+      vTaskSuspend(NULL);
+    }
+  }
+}
+
+static void ColdProducer_Task(void *argument)
+{
+  uint32_t seq = 0;
+
+  (void)argument;
+
+  while (Stop == 0U)
+  {
+    if (osMessageQueuePut(ColdQueue, &seq, 0U, 0U) == osOK)
+    {
+      ColdSent++;
+    }
+    vTaskDelay(1);
+  }
+  vTaskSuspend(NULL);
+}
+
+static void ColdConsumer_Task(void *argument)
+{
+  uint32_t seq;
+
+  (void)argument;
+
+  for (;;)
+  {
+    if (osMessageQueueGet(ColdQueue, &seq, NULL, 10U) == osOK)
+    {
+      ColdReceived++;
+    }
+    else if (Stop != 0U)
+    {
+      vTaskSuspend(NULL);
+    }
+  }
+}
+
+// 两个任务轮流持有互斥量, 持有期间占用 CPU 一段时间
+static void Locker_Task(void *argument)
+{
+  (void)argument;
+
+  while (Stop == 0U)
+  {
+    if (osMutexAcquire(Lock, osWaitForever) == osOK)
+    {
+      LockTaken++;
+      Spin(BENCH_WORK_NS);
+      (void)osMutexRelease(Lock);
+    }
+    vTaskDelay(1);
+  }
+  vTaskSuspend(NULL);
+}
+
+#if (configUSE_QUEUE_STATISTICS == 1)
+static QueueStats_t Prev[configQUEUE_REGISTRY_SIZE];
+static QueueStats_t Curr[configQUEUE_REGISTRY_SIZE];
+
+static const QueueStats_t *Find(const QueueStats_t *stats, UBaseType_t count, QueueHandle_t handle)
+{
+  UBaseType_t i;
+
+  for (i = 0; i < count; i++)
+  {
+    if (stats[i].xHandle == handle)
+    {
+      return &stats[i];
+    }
+  }
+  return NULL;
+}
+
+static void Monitor(void)
+{
+  const QueueStats_t *p;
+  const QueueStats_t *c;
+  UBaseType_t prevCount;
+  UBaseType_t currCount;
+  uint64_t snapNs = 0;
+  uint64_t start;
+  uint32_t s;
+  UBaseType_t i;
+
+  printf("sample,name,sends,receives,full_blocks,empty_blocks,blocked_ns,max_blocked_ns,peak,length\n");
+  prevCount = uxQueueGetRegistryStats(Prev, configQUEUE_REGISTRY_SIZE);
+  for (s = 1; s <= BENCH_SAMPLES; s++)
+  {
+    vTaskDelay(BENCH_PERIOD);
+    start = NowNs();
+    currCount = uxQueueGetRegistryStats(Curr, configQUEUE_REGISTRY_SIZE);
+    snapNs += NowNs() - start;
+
+    for (i = 0; i < currCount; i++)
+    {
+      c = &Curr[i];
+      p = Find(Prev, prevCount, c->xHandle);
+      if (p == NULL)
+      {
+        continue;
+      }
+      printf("%lu,%s,%lu,%lu,%lu,%lu,%llu,%llu,%lu,%lu\n", (unsigned long)s, c->pcQueueName,
+             (unsigned long)(c->ulSends - p->ulSends), (unsigned long)(c->ulReceives - p->ulReceives),
+             (unsigned long)(c->ulFullBlocks - p->ulFullBlocks), (unsigned long)(c->ulEmptyBlocks - p->ulEmptyBlocks),
+             (unsigned long long)(c->ulBlockedTime - p->ulBlockedTime), (unsigned long long)c->ulMaxBlockedTime,
+             (unsigned long)c->uxPeakMessagesWaiting, (unsigned long)c->uxLength);
+    }
+    memcpy(Prev, Curr, sizeof(Curr));
+    prevCount = currCount;
+  }
+  printf("qstats_snapshot entries=%lu avg_ns=%llu\n", (unsigned long)prevCount,
+         (unsigned long long)(snapNs / BENCH_SAMPLES));
+}
+
+// 负载停止并取空后, 计数应与任务自己记录的收发次数一致
+static void Check(void)
+{
+  QueueStats_t stats;
+
+  vQueueGetStats((QueueHandle_t)HotQueue, &stats);
+  BENCH_FAIL_IF((stats.ulSends != HotSent) || (stats.ulReceives != HotReceived));
+  BENCH_FAIL_IF((stats.ulFullBlocks == 0U) || (stats.uxPeakMessagesWaiting != BENCH_DEPTH));
+  BENCH_FAIL_IF(strcmp(stats.pcQueueName, "hot") != 0);
+
+  vQueueGetStats((QueueHandle_t)ColdQueue, &stats);
+  BENCH_FAIL_IF((stats.ulSends != ColdSent) || (stats.ulReceives != ColdReceived));
+  BENCH_FAIL_IF((stats.ulEmptyBlocks == 0U) || (stats.ulFullBlocks != 0U));
+
+  // 非递归互斥量的 osMutexId_t 就是句柄; 新建的互斥量先被给出一次
+  vQueueGetStats((QueueHandle_t)Lock, &stats);
+  BENCH_FAIL_IF((stats.ulReceives != LockTaken) || (stats.ulSends != LockTaken + 1U));
+
+  printf("qstats_check hot=%lu/%lu cold=%lu/%lu lock=%lu errors=%lu\n", (unsigned long)HotSent,
+         (unsigned long)HotReceived, (unsigned long)ColdSent, (unsigned long)ColdReceived, (unsigned long)LockTaken,
+         (unsigned long)Errors);
+}
+#endif
+
+static void Bench_Task(void *argument)
+{
+  osMessageQueueAttr_t qattr;
+  osMutexAttr_t mattr;
+  TaskHandle_t tasks[6];
+  uint32_t i;
+
+  (void)argument;
+
+  printf("# qstats_bench unit=ns depth=%u period=%u\n", BENCH_DEPTH, BENCH_PERIOD);
+  MeasureCost();
+
+  memset(&qattr, 0, sizeof(qattr));
+  qattr.name = "hot";
+  HotQueue = osMessageQueueNew(BENCH_DEPTH, sizeof(uint32_t), &qattr);
+  qattr.name = "cold";
+  ColdQueue = osMessageQueueNew(BENCH_DEPTH, sizeof(uint32_t), &qattr);
+  memset(&mattr, 0, sizeof(mattr));
+  mattr.name = "lock";
+  Lock = osMutexNew(&mattr);
+
+  xTaskCreate(HotConsumer_Task, "HotCons", configMINIMAL_STACK_SIZE * 2U, NULL, BENCH_PRIORITY - 3U, &tasks[0]);
+  xTaskCreate(HotProducer_Task, "HotProd", configMINIMAL_STACK_SIZE * 2U, NULL, BENCH_PRIORITY - 3U, &tasks[1]);
+  xTaskCreate(ColdConsumer_Task, "ColdCons", configMINIMAL_STACK_SIZE * 2U, NULL, BENCH_PRIORITY - 2U, &tasks[2]);
+  xTaskCreate(ColdProducer_Task, "ColdProd", configMINIMAL_STACK_SIZE * 2U, NULL, BENCH_PRIORITY - 2U, &tasks[3]);
+  xTaskCreate(Locker_Task, "Locker1", configMINIMAL_STACK_SIZE * 2U, NULL, BENCH_PRIORITY - 1U, &tasks[4]);
+  xTaskCreate(Locker_Task, "Locker2", configMINIMAL_STACK_SIZE * 2U, NULL, BENCH_PRIORITY - 1U, &tasks[5]);
+
+#if (configUSE_QUEUE_STATISTICS == 1)
+  Monitor();
+#else
+  vTaskDelay(BENCH_PERIOD * BENCH_SAMPLES);
+#endif
+
+  Stop = 1U;
+  // 等生产者停下, 消费者取空队列
+  vTaskDelay(50);
+  for (i = 0; i < sizeof(tasks) / sizeof(tasks[0]); i++)
+  {
+    vTaskDelete(tasks[i]);
+  }
+
+#if (configUSE_QUEUE_STATISTICS == 1)
+  Check();
+  BENCH_PrintResult();
+#else
+  printf("# stats disabled\n");
+#endif
+
+  fflush(stdout);
+  vTaskEndScheduler();
+}
+
+int main(void)
+{
+  xTaskCreate(Bench_Task, "Bench", configMINIMAL_STACK_SIZE * 4U, NULL, BENCH_PRIORITY, NULL);
+  vTaskStartScheduler();
+  return 0;
+}
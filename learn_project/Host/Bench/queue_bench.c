@@ -0,0 +1,267 @@
+/**
+ ******************************************************************************
+ * @file    queue_bench.c
+ * @brief   队列拷贝收发与零拷贝收发 (configUSE_QUEUE_ZERO_COPY) 的吞吐量
+ *
+ * 生产者和消费者两个同优先级的任务通过一个深度为 8 的队列传递记录,
+ * 每一档记录大小 (8 到 256 字节) 分两种方式各传 BENCH_ITEMS 条:
+ *   copy  在局部缓冲区中填好记录后 xQueueSend, xQueueReceive 到局部缓冲区后校验
+ *   zc    pvQueueReserve 后直接在队列存储中填写再 xQueueCommit,
+ *         pvQueueAcquire 后直接在队列存储中校验再 xQueueRelease
+ * 输出每条记录的平均耗时. 记录中带序号, 消费者检查顺序和内容.
+ * 最后用模拟中断做生产者 (FromISR 接口) 再检查一遍, 并检查持有
+ * pvQueueAcquire 取得的记录时 xQueueSendToFront 失败且不改动持有的记录.
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "bench_util.h"
+
+#define BENCH_SIM_IRQ       8U        // 与 kernel_bench / mpool_bench / uart_sim 的中断号错开
+#define BENCH_DEPTH         8U
+#define BENCH_MAX_SIZE      256U
+#define BENCH_ITEMS         200000U
+#define BENCH_ISR_ITEMS     2000U
+#define BENCH_PRIORITY      (configMAX_PRIORITIES - 8U)
+
+typedef enum
+{
+  MODE_COPY = 0,
+  MODE_ZC,
+} Mode_t;
+
+static const uint32_t Sizes[] = { 8U, 16U, 32U, 64U, 128U, 256U };
+
+static QueueHandle_t Queue;
+static TaskHandle_t BenchTask;
+static volatile uint32_t ItemSize;
+static volatile Mode_t Mode;
+static volatile uint32_t Items;
+static volatile uint32_t IrqSeq;
+static volatile uint32_t IrqFull;
+
+// 记录的前 4 字节为序号, 其余字节为序号的低 8 位
+static void Fill(uint8_t *item, uint32_t seq, uint32_t size)
+{
+  memcpy(item, &seq, sizeof(seq));
+  memset(item + sizeof(seq), (int)(seq & 0xFFU), size - sizeof(seq));
+}
+
+static uint8_t Check(const uint8_t *item, uint32_t seq, uint32_t size)
+{
+  uint32_t got;
+  uint32_t i;
+
+  memcpy(&got, item, sizeof(got));
+  if (got != seq)
+  {
+    return 0U;
+  }
+  for (i = sizeof(seq); i < size; i++)
+  {
+    if (item[i] != (uint8_t)(seq & 0xFFU))
+    {
+      return 0U;
+    }
+  }
+  return 1U;
+}
+
+static void Producer_Task(void *argument)
+{
+  uint8_t buffer[BENCH_MAX_SIZE];
+  uint8_t *slot;
+  uint32_t seq;
+
+  (void)argument;
+
+  for (;;)
+  {
+    (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    for (seq = 0; seq < Items; seq++)
+    {
+      if (Mode == MODE_COPY)
+      {
+        Fill(buffer, seq, ItemSize);
+        (void)xQueueSend(Queue, buffer, portMAX_DELAY);
+      }
+      else
+      {
+        slot = pvQueueReserve(Queue, portMAX_DELAY);
+        Fill(slot, seq, ItemSize);
+        (void)xQueueCommit(Queue);
+      }
+    }
+  }
+}
+
+static void Consumer_Task(void *argument)
+{
+  uint8_t buffer[BENCH_MAX_SIZE];
+  uint8_t *slot;
+  uint32_t seq;
+
+  (void)argument;
+
+  for (;;)
+  {
+    (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    for (seq = 0; seq < Items; seq++)
+    {
+      if (Mode == MODE_COPY)
+      {
+        (void)xQueueReceive(Queue, buffer, portMAX_DELAY);
+        BENCH_FAIL_IF(Check(buffer, seq, ItemSize) == 0U);
+      }
+      else
+      {
+        slot = pvQueueAcquire(Queue, portMAX_DELAY);
+        BENCH_FAIL_IF(Check(slot, seq, ItemSize) == 0U);
+        (void)xQueueRelease(Queue);
+      }
+    }
+    xTaskNotifyGive(BenchTask);
+  }
+}
+
+// 模拟中断做生产者: 队列满时丢弃 (计入 IrqFull), 不推进序号
+static uint32_t Bench_SimIrq(void)
+{
+  BaseType_t woken = pdFALSE;
+  uint8_t buffer[BENCH_MAX_SIZE];
+  uint8_t *slot;
+
+  if (Mode == MODE_COPY)
+  {
+    Fill(buffer, IrqSeq, ItemSize);
+    if (xQueueSendFromISR(Queue, buffer, &woken) != pdPASS)
+    {
+      IrqFull++;
+      return pdFALSE;
+    }
+  }
+  else
+  {
+    slot = pvQueueReserveFromISR(Queue);
+    if (slot == NULL)
+    {
+      IrqFull++;
+      return pdFALSE;
+    }
+    Fill(slot, IrqSeq, ItemSize);
+    (void)xQueueCommitFromISR(Queue, &woken);
+  }
+  IrqSeq++;
+  return (uint32_t)woken;
+}
+
+// 持有队首记录时往队首发送: 应失败且不改动持有的记录, 归还后正常发送
+static void CheckFrontWhileHeld(void)
+{
+  uint8_t buffer[BENCH_MAX_SIZE];
+  uint8_t *slot;
+  uint32_t seq;
+
+  for (seq = 100U; seq < 102U; seq++)
+  {
+    Fill(buffer, seq, ItemSize);
+    BENCH_FAIL_IF(xQueueSend(Queue, buffer, 0) != pdPASS);
+  }
+  slot = pvQueueAcquire(Queue, 0);
+  BENCH_FAIL_IF((slot == NULL) || (Check(slot, 100U, ItemSize) == 0U));
+
+  Fill(buffer, 200U, ItemSize);
+  BENCH_FAIL_IF(xQueueSendToFront(Queue, buffer, 2) != errQUEUE_FULL);
+  BENCH_FAIL_IF(xQueueSendToFrontFromISR(Queue, buffer, NULL) != errQUEUE_FULL);
+  BENCH_FAIL_IF((slot == NULL) || (Check(slot, 100U, ItemSize) == 0U));
+  printf("queue_front held_intact=%u\n", (slot != NULL) && (Check(slot, 100U, ItemSize) != 0U));
+  (void)xQueueRelease(Queue);
+
+  // 归还后发往队首的记录排在 101 之前
+  BENCH_FAIL_IF(xQueueSendToFront(Queue, buffer, 0) != pdPASS);
+  for (seq = 0; seq < 2U; seq++)
+  {
+    BENCH_FAIL_IF(xQueueReceive(Queue, buffer, 0) != pdPASS);
+    BENCH_FAIL_IF(Check(buffer, (seq == 0U) ? 200U : 101U, ItemSize) == 0U);
+  }
+}
+
+static void Bench_Task(void *argument)
+{
+  TaskHandle_t producer;
+  TaskHandle_t consumer;
+  uint64_t ns[2];
+  uint64_t start;
+  uint32_t i;
+  uint32_t m;
+
+  (void)argument;
+
+  printf("# queue_bench unit=ns depth=%u items=%u\n", BENCH_DEPTH, BENCH_ITEMS);
+  printf("size,copy_ns,zc_ns,saved_pct\n");
+
+  xTaskCreate(Producer_Task, "Producer", configMINIMAL_STACK_SIZE * 2U, NULL, BENCH_PRIORITY - 1U, &producer);
+  xTaskCreate(Consumer_Task, "Consumer", configMINIMAL_STACK_SIZE * 2U, NULL, BENCH_PRIORITY - 1U, &consumer);
+  vPortSetInterruptHandler(BENCH_SIM_IRQ, Bench_SimIrq);
+
+  for (i = 0; i < sizeof(Sizes) / sizeof(Sizes[0]); i++)
+  {
+    ItemSize = Sizes[i];
+    Queue = xQueueCreate(BENCH_DEPTH, ItemSize);
+    Items = BENCH_ITEMS;
+    for (m = MODE_COPY; m <= MODE_ZC; m++)
+    {
+      Mode = (Mode_t)m;
+      start = NowNs();
+      xTaskNotifyGive(consumer);
+      xTaskNotifyGive(producer);
+      (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+      ns[m] = NowNs() - start;
+    }
+    printf("%lu,%llu,%llu,%lld\n", (unsigned long)ItemSize, (unsigned long long)(ns[MODE_COPY] / BENCH_ITEMS),
+           (unsigned long long)(ns[MODE_ZC] / BENCH_ITEMS),
+           (long long)(100 - (int64_t)((ns[MODE_ZC] * 100U) / ns[MODE_COPY])));
+    vQueueDelete(Queue);
+  }
+
+  // 中断生产, 任务消费: 两种方式都按序号校验
+  ItemSize = 64U;
+  Queue = xQueueCreate(BENCH_DEPTH, ItemSize);
+  Items = BENCH_ISR_ITEMS;
+  for (m = MODE_COPY; m <= MODE_ZC; m++)
+  {
+    Mode = (Mode_t)m;
+    IrqSeq = 0;
+    xTaskNotifyGive(consumer);
+    while (IrqSeq < BENCH_ISR_ITEMS)
+    {
+      vPortGenerateSimulatedInterrupt(BENCH_SIM_IRQ);
+      if ((IrqSeq % BENCH_DEPTH) == 0U)
+      {
+        // 让消费者把队列取空
+        vTaskDelay(1);
+      }
+    }
+    (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+  }
+  printf("queue_isr items=%u full=%lu\n", BENCH_ISR_ITEMS, (unsigned long)IrqFull);
+
+  CheckFrontWhileHeld();
+
+  printf("queue_check errors=%lu waiting=%lu spaces=%lu\n", (unsigned long)Errors,
+         (unsigned long)uxQueueMessagesWaiting(Queue), (unsigned long)uxQueueSpacesAvailable(Queue));
+  BENCH_FAIL_IF(uxQueueSpacesAvailable(Queue) != BENCH_DEPTH);
+  BENCH_Finish();
+}
+
+int main(void)
+{
+  xTaskCreate(Bench_Task, "Bench", configMINIMAL_STACK_SIZE * 4U, NULL, BENCH_PRIORITY, &BenchTask);
+  vTaskStartScheduler();
+  return 0;
+}
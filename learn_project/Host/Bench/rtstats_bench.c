@@ -0,0 +1,174 @@
+/**
+ ******************************************************************************
+ * @file    rtstats_bench.c
+ * @brief   任务运行时间统计在主机上的测量
+ *
+ * 几个工作任务按已知的占空比忙等, 监视任务每 100ms 用
+ * uxTaskGetRunTimeSnapshot 采样一次, 由相邻两次快照的差值计算各任务的
+ * CPU 占用率, 与预期值比较, 相差超过 BENCH_TOLERANCE_PERMILLE 时输出
+ * "# FAIL". 同时测量快照接口与 uxTaskGetSystemState / vTaskGetRunTimeStats
+ * 每次调用的耗时.
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "bench_util.h"
+
+#define BENCH_WORKERS       4U
+#define BENCH_PERIOD_MS     20U
+#define BENCH_SAMPLE_MS     100U
+#define BENCH_SAMPLES       10U
+#define BENCH_MAX_TASKS     16U
+#define BENCH_COST_CALLS    200U
+#define BENCH_TOLERANCE_PERMILLE  20U   // 允许的占用率误差, 千分之
+
+typedef struct
+{
+  uint32_t BusyMs;          // 每个周期内忙等的毫秒数
+  TaskHandle_t Handle;
+  uint64_t RunTime;         // 采样期间累计的运行时间
+} Worker_t;
+
+static Worker_t Workers[BENCH_WORKERS] = {
+  { .BusyMs = 1U }, { .BusyMs = 2U }, { .BusyMs = 3U }, { .BusyMs = 5U }
+};
+
+static TaskRunTimeSnapshot_t Prev[BENCH_MAX_TASKS];
+static TaskRunTimeSnapshot_t Curr[BENCH_MAX_TASKS];
+static TaskStatus_t Status[BENCH_MAX_TASKS];
+static char StatsText[BENCH_MAX_TASKS * 64U];
+
+static void Worker_Task(void *argument)
+{
+  Worker_t *worker = (Worker_t *)argument;
+  TickType_t wake = xTaskGetTickCount();
+  uint64_t end;
+
+  for (;;)
+  {
+    end = NowNs() + ((uint64_t)worker->BusyMs * 1000000ULL);
+    while (NowNs() < end)
+    {
+    }
+    vTaskDelayUntil(&wake, pdMS_TO_TICKS(BENCH_PERIOD_MS));
+  }
+}
+
+static uint64_t FindRunTime(const TaskRunTimeSnapshot_t *snap, UBaseType_t count, TaskHandle_t handle)
+{
+  UBaseType_t i;
+
+  for (i = 0; i < count; i++)
+  {
+    if (snap[i].xHandle == handle)
+    {
+      return snap[i].ulRunTimeCounter;
+    }
+  }
+  return 0;
+}
+
+static void Monitor_Task(void *argument)
+{
+  configRUN_TIME_COUNTER_TYPE prevTotal;
+  configRUN_TIME_COUNTER_TYPE currTotal;
+  configRUN_TIME_COUNTER_TYPE statusTotal;
+  UBaseType_t prevCount;
+  UBaseType_t currCount = 0;
+  uint64_t elapsed = 0;
+  uint64_t start;
+  uint64_t snapshotNs = 0;
+  uint64_t systemStateNs;
+  uint64_t formatNs;
+  uint64_t expected;
+  uint64_t measured;
+  uint32_t i;
+  uint32_t w;
+
+  (void)argument;
+
+  prevCount = uxTaskGetRunTimeSnapshot(Prev, BENCH_MAX_TASKS, &prevTotal);
+
+  for (i = 0; i < BENCH_SAMPLES; i++)
+  {
+    vTaskDelay(pdMS_TO_TICKS(BENCH_SAMPLE_MS));
+
+    start = NowNs();
+    currCount = uxTaskGetRunTimeSnapshot(Curr, BENCH_MAX_TASKS, &currTotal);
+    snapshotNs += NowNs() - start;
+
+    for (w = 0; w < BENCH_WORKERS; w++)
+    {
+      Workers[w].RunTime += FindRunTime(Curr, currCount, Workers[w].Handle) -
+                            FindRunTime(Prev, prevCount, Workers[w].Handle);
+    }
+    elapsed += currTotal - prevTotal;
+
+    memcpy(Prev, Curr, sizeof(Prev));
+    prevCount = currCount;
+    prevTotal = currTotal;
+  }
+
+  // 各接口每次调用的平均耗时
+  start = NowNs();
+  for (i = 0; i < BENCH_COST_CALLS; i++)
+  {
+    (void)uxTaskGetRunTimeSnapshot(Curr, BENCH_MAX_TASKS, &currTotal);
+  }
+  snapshotNs = (NowNs() - start) / BENCH_COST_CALLS;
+
+  start = NowNs();
+  for (i = 0; i < BENCH_COST_CALLS; i++)
+  {
+    (void)uxTaskGetSystemState(Status, BENCH_MAX_TASKS, &statusTotal);
+  }
+  systemStateNs = (NowNs() - start) / BENCH_COST_CALLS;
+
+  start = NowNs();
+  for (i = 0; i < BENCH_COST_CALLS; i++)
+  {
+    vTaskGetRunTimeStats(StatsText);
+  }
+  formatNs = (NowNs() - start) / BENCH_COST_CALLS;
+
+  printf("rtstats tasks=%lu interval_ms=%llu\n", (unsigned long)currCount,
+         (unsigned long long)(elapsed / 1000000ULL));
+  BENCH_FAIL_IF(elapsed == 0U);
+  for (w = 0; w < BENCH_WORKERS; w++)
+  {
+    expected = ((uint64_t)Workers[w].BusyMs * 1000ULL) / BENCH_PERIOD_MS;
+    measured = (elapsed != 0U) ? ((Workers[w].RunTime * 1000ULL) / elapsed) : 0U;
+    printf("rtstats_task name=%s expected_permille=%llu measured_permille=%llu\n",
+           pcTaskGetName(Workers[w].Handle), (unsigned long long)expected,
+           (unsigned long long)measured);
+    BENCH_FAIL_IF((measured + BENCH_TOLERANCE_PERMILLE < expected) ||
+                  (measured > expected + BENCH_TOLERANCE_PERMILLE));
+  }
+  printf("rtstats_cost snapshot_ns=%llu system_state_ns=%llu formatted_ns=%llu\n",
+         (unsigned long long)snapshotNs, (unsigned long long)systemStateNs,
+         (unsigned long long)formatNs);
+
+  BENCH_Finish();
+}
+
+int main(void)
+{
+  char name[configMAX_TASK_NAME_LEN];
+  uint32_t w;
+
+  for (w = 0; w < BENCH_WORKERS; w++)
+  {
+    snprintf(name, sizeof(name), "Busy%lu", (unsigned long)Workers[w].BusyMs);
+    xTaskCreate(Worker_Task, name, configMINIMAL_STACK_SIZE * 2U, &Workers[w],
+                tskIDLE_PRIORITY + 2U + w, &Workers[w].Handle);
+  }
+  xTaskCreate(Monitor_Task, "Monitor", configMINIMAL_STACK_SIZE * 4U, NULL,
+              configMAX_PRIORITIES - 1U, NULL);
+
+  vTaskStartScheduler();
+  return 0;
+}
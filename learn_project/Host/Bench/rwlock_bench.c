@@ -0,0 +1,348 @@
+/**
+ ******************************************************************************
+ * @file    rwlock_bench.c
+ * @brief   读写锁 (osRwLock) 与互斥量在读多写少负载下的对比和正确性检查
+ *
+ * load     BENCH_READERS_MAX 以内不同数量的读任务反复读一张共享表, 读的过程中
+ *          让出一次 CPU (相当于读的途中被抢占); 一个高一级的写任务每
+ *          BENCH_WRITE_PERIOD 个节拍写一次. 分别用 osMutex 和 osRwLock 保护,
+ *          输出读次数、读者获取锁的平均/最大等待和写者的最大等待.
+ * prefer   写者等待期间新来的读者要排在写者后面; 写者等待超时后,
+ *          被它挡住的读者要被唤醒.
+ * inherit  低优先级任务持有写锁时, 高优先级任务等待它:
+ *          写者应继承等待者的优先级, 释放或等待超时后恢复.
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "cmsis_os2.h"
+#include "bench_util.h"
+
+#define BENCH_READERS_MAX   8U
+#define BENCH_RUN_TICKS     200U
+#define BENCH_READ_NS       20000U
+#define BENCH_WRITE_NS      20000U
+#define BENCH_WRITE_PERIOD  5U
+#define BENCH_PRIORITY      (configMAX_PRIORITIES - 8U)
+#define BENCH_LOW_PRIORITY  (BENCH_PRIORITY - 3U)
+
+static osMutexId_t Mutex;
+static osRwLockId_t Lock;
+static uint8_t UseRwLock;
+static volatile uint8_t Stop;
+static volatile uint32_t Done;
+static volatile uint32_t ReadersInside;
+static volatile uint8_t Writing;
+static volatile uint32_t Reads;
+static volatile uint32_t Writes;
+static volatile uint64_t ReadWaitNs;
+static volatile uint64_t ReadWaitMaxNs;
+static volatile uint64_t WriteWaitMaxNs;
+static volatile uint8_t Taken;
+static volatile uint8_t Go;
+static volatile osStatus_t WriterStatus;
+static volatile osStatus_t ReaderStatus;
+static volatile UBaseType_t InheritedPrio;
+static volatile UBaseType_t ReleasedPrio;
+
+static void Spin(uint32_t ns)
+{
+  uint64_t start = NowNs();
+
+  while ((NowNs() - start) < ns)
+  {
+  }
+}
+
+static void ReadLock(void)
+{
+  if (UseRwLock != 0U)
+  {
+    (void)osRwLockAcquireRead(Lock, osWaitForever);
+  }
+  else
+  {
+    (void)osMutexAcquire(Mutex, osWaitForever);
+  }
+}
+
+static void ReadUnlock(void)
+{
+  if (UseRwLock != 0U)
+  {
+    (void)osRwLockReleaseRead(Lock);
+  }
+  else
+  {
+    (void)osMutexRelease(Mutex);
+  }
+}
+
+// 读任务: 读的途中让出一次 CPU, 其它读任务此时也来读
+static void Reader_Task(void *argument)
+{
+  uint64_t start;
+  uint64_t wait;
+
+  (void)argument;
+
+  while (Stop == 0U)
+  {
+    start = NowNs();
+    ReadLock();
+    wait = NowNs() - start;
+    ReadersInside++;
+    BENCH_FAIL_IF(Writing != 0U);
+    Spin(BENCH_READ_NS / 2U);
+    taskYIELD();
+    Spin(BENCH_READ_NS / 2U);
+    BENCH_FAIL_IF(Writing != 0U);
+    ReadersInside--;
+    ReadUnlock();
+
+    Reads++;
+    ReadWaitNs += wait;
+    ReadWaitMaxNs = (wait > ReadWaitMaxNs) ? wait : ReadWaitMaxNs;
+  }
+  Done++;
+  vTaskSuspend(NULL);
+}
+
+static void Writer_Task(void *argument)
+{
+  uint64_t start;
+  uint64_t wait;
+
+  (void)argument;
+
+  while (Stop == 0U)
+  {
+    vTaskDelay(BENCH_WRITE_PERIOD);
+    start = NowNs();
+    if (UseRwLock != 0U)
+    {
+      (void)osRwLockAcquireWrite(Lock, osWaitForever);
+    }
+    else
+    {
+      (void)osMutexAcquire(Mutex, osWaitForever);
+    }
+    wait = NowNs() - start;
+    Writing = 1U;
+    BENCH_FAIL_IF(ReadersInside != 0U);
+    Spin(BENCH_WRITE_NS);
+    Writing = 0U;
+    if (UseRwLock != 0U)
+    {
+      (void)osRwLockReleaseWrite(Lock);
+    }
+    else
+    {
+      (void)osMutexRelease(Mutex);
+    }
+
+    Writes++;
+    WriteWaitMaxNs = (wait > WriteWaitMaxNs) ? wait : WriteWaitMaxNs;
+  }
+  Done++;
+  vTaskSuspend(NULL);
+}
+
+static void RunLoad(uint8_t useRwLock, uint32_t readers)
+{
+  TaskHandle_t tasks[BENCH_READERS_MAX + 1U];
+  uint32_t i;
+
+  UseRwLock = useRwLock;
+  Stop = 0U;
+  Done = 0U;
+  Reads = 0U;
+  Writes = 0U;
+  ReadWaitNs = 0U;
+  ReadWaitMaxNs = 0U;
+  WriteWaitMaxNs = 0U;
+
+  for (i = 0; i < readers; i++)
+  {
+    xTaskCreate(Reader_Task, "Reader", configMINIMAL_STACK_SIZE * 2U, NULL, BENCH_PRIORITY - 2U, &tasks[i]);
+  }
+  xTaskCreate(Writer_Task, "Writer", configMINIMAL_STACK_SIZE * 2U, NULL, BENCH_PRIORITY - 1U, &tasks[readers]);
+
+  vTaskDelay(BENCH_RUN_TICKS);
+  Stop = 1U;
+  while (Done < (readers + 1U))
+  {
+    vTaskDelay(1);
+  }
+  for (i = 0; i <= readers; i++)
+  {
+    vTaskDelete(tasks[i]);
+  }
+
+  printf("%s,%lu,%lu,%lu,%llu,%llu,%llu\n", (useRwLock != 0U) ? "rwlock" : "mutex", (unsigned long)readers,
+         (unsigned long)Reads, (unsigned long)Writes, (unsigned long long)(ReadWaitNs / ((Reads != 0U) ? Reads : 1U)),
+         (unsigned long long)ReadWaitMaxNs, (unsigned long long)WriteWaitMaxNs);
+}
+
+static void Waiter_Task(void *argument)
+{
+  if (argument != NULL)
+  {
+    WriterStatus = osRwLockAcquireWrite(Lock, BENCH_WRITE_PERIOD);
+    if (WriterStatus == osOK)
+    {
+      (void)osRwLockReleaseWrite(Lock);
+    }
+  }
+  else
+  {
+    ReaderStatus = osRwLockAcquireRead(Lock, osWaitForever);
+  }
+  vTaskSuspend(NULL);
+}
+
+static void CheckPreference(void)
+{
+  TaskHandle_t writer;
+  TaskHandle_t reader;
+  osStatus_t timedOut;
+  osStatus_t woken;
+
+  Lock = osRwLockNew(NULL);
+  WriterStatus = osError;
+  ReaderStatus = osError;
+
+  // 写者在读者之后等待, 再来的读者排在写者后面
+  BENCH_FAIL_IF(osRwLockAcquireRead(Lock, 0U) != osOK);
+  xTaskCreate(Waiter_Task, "Writer", configMINIMAL_STACK_SIZE * 2U, (void *)1, BENCH_PRIORITY + 1U, &writer);
+  xTaskCreate(Waiter_Task, "Reader", configMINIMAL_STACK_SIZE * 2U, NULL, BENCH_PRIORITY + 1U, &reader);
+  BENCH_FAIL_IF(osRwLockGetReaderCount(Lock) != 1U);
+  BENCH_FAIL_IF(ReaderStatus != osError);
+
+  // 写者等待超时, 被它挡住的读者随即拿到读锁
+  vTaskDelay(BENCH_WRITE_PERIOD * 2U);
+  timedOut = WriterStatus;
+  woken = ReaderStatus;
+  BENCH_FAIL_IF(timedOut != osErrorTimeout);
+  BENCH_FAIL_IF(woken != osOK);
+  BENCH_FAIL_IF(osRwLockGetReaderCount(Lock) != 2U);
+  vTaskDelete(reader);
+  vTaskDelete(writer);
+  (void)osRwLockReleaseRead(Lock);
+  (void)osRwLockReleaseRead(Lock);
+  BENCH_FAIL_IF(osRwLockGetReaderCount(Lock) != 0U);
+  BENCH_FAIL_IF(osRwLockReleaseRead(Lock) == osOK);
+
+  // 读者都离开后写者立即得到锁
+  WriterStatus = osError;
+  BENCH_FAIL_IF(osRwLockAcquireRead(Lock, 0U) != osOK);
+  xTaskCreate(Waiter_Task, "Writer", configMINIMAL_STACK_SIZE * 2U, (void *)1, BENCH_PRIORITY + 1U, &writer);
+  BENCH_FAIL_IF(WriterStatus != osError);
+  (void)osRwLockReleaseRead(Lock);
+  BENCH_FAIL_IF(WriterStatus != osOK);
+  vTaskDelete(writer);
+
+  printf("prefer writer_timeout=%d reader_after=%d writer_after=%d\n", (int)timedOut, (int)woken, (int)WriterStatus);
+  (void)osRwLockDelete(Lock);
+}
+
+// 低优先级写者: 等测试任务开始等待后, 记录继承到的优先级, 释放后再记录一次
+static void Holder_Task(void *argument)
+{
+  (void)argument;
+
+  (void)osRwLockAcquireWrite(Lock, osWaitForever);
+  Taken = 1U;
+  while (Go == 0U)
+  {
+  }
+  InheritedPrio = uxTaskPriorityGet(NULL);
+  (void)osRwLockReleaseWrite(Lock);
+  ReleasedPrio = uxTaskPriorityGet(NULL);
+  vTaskSuspend(NULL);
+}
+
+static void CheckInheritance(void)
+{
+  TaskHandle_t holder;
+
+  // 读者等待写者时写者继承读者的优先级, 释放时收回
+  Lock = osRwLockNew(NULL);
+  Taken = 0U;
+  Go = 0U;
+  xTaskCreate(Holder_Task, "Holder", configMINIMAL_STACK_SIZE * 2U, NULL, BENCH_LOW_PRIORITY, &holder);
+  while (Taken == 0U)
+  {
+    vTaskDelay(1);
+  }
+  BENCH_FAIL_IF(osRwLockGetWriter(Lock) != (osThreadId_t)holder);
+  BENCH_FAIL_IF(osRwLockAcquireWrite(Lock, 0U) != osErrorResource);
+  Go = 1U;
+  BENCH_FAIL_IF(osRwLockAcquireRead(Lock, 100U) != osOK);
+  BENCH_FAIL_IF(osRwLockGetWriter(Lock) != NULL);
+  (void)osRwLockReleaseRead(Lock);
+  vTaskDelay(2);
+  BENCH_FAIL_IF((InheritedPrio != BENCH_PRIORITY) || (ReleasedPrio != BENCH_LOW_PRIORITY));
+  printf("inherit holder_prio=%lu inherited=%lu released=%lu\n", (unsigned long)BENCH_LOW_PRIORITY,
+         (unsigned long)InheritedPrio, (unsigned long)ReleasedPrio);
+  vTaskDelete(holder);
+
+  // 写者等待超时后持有者恢复原优先级
+  Taken = 0U;
+  Go = 0U;
+  xTaskCreate(Holder_Task, "Holder", configMINIMAL_STACK_SIZE * 2U, NULL, BENCH_LOW_PRIORITY, &holder);
+  while (Taken == 0U)
+  {
+    vTaskDelay(1);
+  }
+  BENCH_FAIL_IF(osRwLockAcquireWrite(Lock, 5U) != osErrorTimeout);
+  BENCH_FAIL_IF(uxTaskPriorityGet(holder) != BENCH_LOW_PRIORITY);
+  Go = 1U;
+  vTaskDelay(2);
+  BENCH_FAIL_IF(osRwLockGetWriter(Lock) != NULL);
+  BENCH_FAIL_IF(osRwLockAcquireWrite(Lock, 0U) != osOK);
+  // 写者不能再次获取, 也不能释放读锁
+  BENCH_FAIL_IF(osRwLockAcquireWrite(Lock, 10U) == osOK);
+  BENCH_FAIL_IF(osRwLockAcquireRead(Lock, 10U) == osOK);
+  BENCH_FAIL_IF(osRwLockReleaseRead(Lock) == osOK);
+  (void)osRwLockReleaseWrite(Lock);
+  BENCH_FAIL_IF(osRwLockReleaseWrite(Lock) == osOK);
+  vTaskDelete(holder);
+  (void)osRwLockDelete(Lock);
+}
+
+static void Bench_Task(void *argument)
+{
+  uint32_t readers;
+
+  (void)argument;
+
+  printf("# rwlock_bench unit=ns run_ticks=%u read_ns=%u write_period=%u\n", BENCH_RUN_TICKS, BENCH_READ_NS,
+         BENCH_WRITE_PERIOD);
+  printf("lock,readers,reads,writes,read_wait_avg,read_wait_max,write_wait_max\n");
+  Mutex = osMutexNew(NULL);
+  Lock = osRwLockNew(NULL);
+  for (readers = 1U; readers <= BENCH_READERS_MAX; readers *= 2U)
+  {
+    RunLoad(0U, readers);
+    RunLoad(1U, readers);
+  }
+  (void)osMutexDelete(Mutex);
+  (void)osRwLockDelete(Lock);
+
+  CheckPreference();
+  CheckInheritance();
+  printf("rwlock_check errors=%lu\n", (unsigned long)Errors);
+  BENCH_Finish();
+}
+
+int main(void)
+{
+  xTaskCreate(Bench_Task, "Bench", configMINIMAL_STACK_SIZE * 4U, NULL, BENCH_PRIORITY, NULL);
+  vTaskStartScheduler();
+  return 0;
+}
@@ -0,0 +1,444 @@
+/**
+ ******************************************************************************
+ * @file    stream_bench.c
+ * @brief   流缓冲区/消息缓冲区零拷贝接口 (configUSE_STREAM_BUFFER_ZERO_COPY)
+ *          的吞吐量和正确性
+ *
+ * cost     一个任务按块写入再读出 BENCH_BYTES 字节, 块大小 1~512 字节,
+ *          每项测 BENCH_REPEAT 次取最快, 单位 bytes/s.
+ *          copy  先填到局部数组, xStreamBufferSend 拷进去,
+ *                xStreamBufferReceive 拷出来再校验
+ *          zc    xStreamBufferReserve 直接在缓冲区里填, Commit 后
+ *                xStreamBufferAcquire 直接在缓冲区里校验, 再 Release
+ *          stream / message 两种缓冲区各测一遍.
+ * check    回绕时分成两段, 部分提交/部分释放, 消息跨回绕 (数据和长度各一次),
+ *          空间不够时 Reserve 返回 0, 静态创建.
+ * block    Acquire 阻塞到触发水位才醒, Reserve 阻塞到 Release 后醒,
+ *          模拟中断里 Commit/Release 唤醒任务.
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stream_buffer.h"
+#include "message_buffer.h"
+#include "bench_util.h"
+
+#define BENCH_BYTES         (1024U * 1024U)
+#define BENCH_REPEAT        3U
+#define BENCH_MAX_CHUNK     512U
+#define BENCH_BUFFER_SIZE   1024U
+#define BENCH_PRIORITY      (configMAX_PRIORITIES - 8U)
+#define BENCH_SIM_IRQ       13U       // 与其他测试和 uart_sim 的中断号错开
+
+typedef struct
+{
+  StreamBufferHandle_t buffer;
+  size_t wanted;
+  volatile size_t result;
+  volatile uint8_t done;
+} Peer_t;
+
+static uint8_t TxSeq;
+static uint8_t RxSeq;
+static uint32_t Mismatch;
+static StreamBufferHandle_t IsrBuffer;
+static volatile uint32_t IsrMode;
+static volatile size_t IsrResult;
+
+// 写入递增序列, 读出时按同一序列校验.  序号先拷到局部变量, 否则 uint8_t
+// 指针可能指向 TxSeq/RxSeq, 编译器每写一个字节都要重新读一次序号.
+// 不内联, 两条路径跑同一份代码, 差别只来自缓冲区接口
+__attribute__((noinline)) static void Fill(uint8_t *data, size_t length)
+{
+  uint8_t seq = TxSeq;
+  size_t i;
+
+  for (i = 0; i < length; i++)
+  {
+    data[i] = (uint8_t)(seq + i);
+  }
+  TxSeq = (uint8_t)(seq + length);
+}
+
+__attribute__((noinline)) static void Verify(const uint8_t *data, size_t length)
+{
+  uint8_t seq = RxSeq;
+  uint32_t mismatch = 0U;
+  size_t i;
+
+  for (i = 0; i < length; i++)
+  {
+    mismatch += (data[i] != (uint8_t)(seq + i)) ? 1U : 0U;
+  }
+  RxSeq = (uint8_t)(seq + length);
+  Mismatch += mismatch;
+}
+
+// 区域的前 length 字节, 回绕时分两段
+static void FillRegion(const StreamBufferRegion_t *region, size_t length)
+{
+  size_t first = (length < region->xFirstLength) ? length : region->xFirstLength;
+
+  Fill(region->pucFirst, first);
+  if (length > first)
+  {
+    Fill(region->pucSecond, length - first);
+  }
+}
+
+static void VerifyRegion(const StreamBufferRegion_t *region, size_t length)
+{
+  size_t first = (length < region->xFirstLength) ? length : region->xFirstLength;
+
+  Verify(region->pucFirst, first);
+  if (length > first)
+  {
+    Verify(region->pucSecond, length - first);
+  }
+}
+
+static uint64_t RunCopy(StreamBufferHandle_t buffer, size_t chunk)
+{
+  uint8_t tx[BENCH_MAX_CHUNK];
+  uint8_t rx[BENCH_MAX_CHUNK];
+  uint32_t i;
+  size_t n;
+  uint64_t start;
+
+  start = NowNs();
+  for (i = 0; i < (BENCH_BYTES / chunk); i++)
+  {
+    Fill(tx, chunk);
+    BENCH_FAIL_IF(xStreamBufferSend(buffer, tx, chunk, 0U) != chunk);
+    n = xStreamBufferReceive(buffer, rx, sizeof(rx), 0U);
+    BENCH_FAIL_IF(n != chunk);
+    Verify(rx, n);
+  }
+  return NowNs() - start;
+}
+
+static uint64_t RunZeroCopy(StreamBufferHandle_t buffer, size_t chunk)
+{
+  StreamBufferRegion_t region;
+  uint32_t i;
+  size_t n;
+  uint64_t start;
+
+  start = NowNs();
+  for (i = 0; i < (BENCH_BYTES / chunk); i++)
+  {
+    BENCH_FAIL_IF(xStreamBufferReserve(buffer, &region, chunk, 0U) < chunk);
+    FillRegion(&region, chunk);
+    (void)xStreamBufferCommit(buffer, chunk);
+    n = xStreamBufferAcquire(buffer, &region, 0U);
+    BENCH_FAIL_IF(n != chunk);
+    VerifyRegion(&region, n);
+    (void)xStreamBufferRelease(buffer, n);
+  }
+  return NowNs() - start;
+}
+
+static uint64_t BytesPerSecond(uint64_t ns)
+{
+  return ((uint64_t)BENCH_BYTES * 1000000000ULL) / ((ns > 0U) ? ns : 1U);
+}
+
+static void MeasureCost(void)
+{
+  StreamBufferHandle_t buffers[2];
+  static const char *const names[2] = { "stream", "message" };
+  size_t chunk;
+  uint32_t b, r;
+  uint64_t ns, bestCopy, bestZc;
+
+  buffers[0] = xStreamBufferCreate(BENCH_BUFFER_SIZE, 1U);
+  buffers[1] = xMessageBufferCreate(BENCH_BUFFER_SIZE);
+
+  for (b = 0; b < 2U; b++)
+  {
+    for (chunk = 1U; chunk <= BENCH_MAX_CHUNK; chunk *= 2U)
+    {
+      bestCopy = UINT64_MAX;
+      bestZc = UINT64_MAX;
+      for (r = 0; r < BENCH_REPEAT; r++)
+      {
+        ns = RunCopy(buffers[b], chunk);
+        bestCopy = (ns < bestCopy) ? ns : bestCopy;
+        ns = RunZeroCopy(buffers[b], chunk);
+        bestZc = (ns < bestZc) ? ns : bestZc;
+      }
+      printf("%s,%u,%llu,%llu\n", names[b], (unsigned)chunk,
+             (unsigned long long)BytesPerSecond(bestCopy),
+             (unsigned long long)BytesPerSecond(bestZc));
+    }
+    vStreamBufferDelete(buffers[b]);
+  }
+  BENCH_FAIL_IF(Mismatch != 0U);
+}
+
+static void CheckStream(void)
+{
+  static StaticStreamBuffer_t control;
+  static uint8_t storage[17];
+  StreamBufferRegion_t region;
+  uint8_t scratch[16];
+  StreamBufferHandle_t buffer;
+
+  // 静态创建, 长度就是 17, 最多存 16 字节
+  buffer = xStreamBufferCreateStatic(sizeof(storage), 1U, storage, &control);
+  BENCH_FAIL_IF(buffer == NULL);
+
+  // 头尾都移到 10, 空闲区从 10 回绕到 9
+  Fill(scratch, 10U);
+  (void)xStreamBufferSend(buffer, scratch, 10U, 0U);
+  Verify(scratch, xStreamBufferReceive(buffer, scratch, sizeof(scratch), 0U));
+
+  BENCH_FAIL_IF(xStreamBufferReserve(buffer, &region, 12U, 0U) != 16U);
+  BENCH_FAIL_IF((region.pucFirst != &storage[10]) || (region.xFirstLength != 7U));
+  BENCH_FAIL_IF((region.pucSecond != storage) || (region.xSecondLength != 9U));
+  FillRegion(&region, 12U);
+  BENCH_FAIL_IF(xStreamBufferCommit(buffer, 12U) != 12U);
+  BENCH_FAIL_IF(xStreamBufferBytesAvailable(buffer) != 12U);
+
+  // 读端也分两段, 只释放一部分, 剩下的再取一次
+  BENCH_FAIL_IF(xStreamBufferAcquire(buffer, &region, 0U) != 12U);
+  BENCH_FAIL_IF((region.xFirstLength != 7U) || (region.xSecondLength != 5U));
+  VerifyRegion(&region, 5U);
+  BENCH_FAIL_IF(xStreamBufferRelease(buffer, 5U) != 5U);
+  BENCH_FAIL_IF(xStreamBufferAcquire(buffer, &region, 0U) != 7U);
+  BENCH_FAIL_IF((region.pucFirst != &storage[15]) || (region.xFirstLength != 2U) || (region.xSecondLength != 5U));
+  VerifyRegion(&region, 7U);
+  (void)xStreamBufferRelease(buffer, 7U);
+  BENCH_FAIL_IF(xStreamBufferIsEmpty(buffer) != pdTRUE);
+
+  // 提交 0 字节等于取消, 普通接口随后照常可用
+  (void)xStreamBufferReserve(buffer, &region, 1U, 0U);
+  BENCH_FAIL_IF(xStreamBufferCommit(buffer, 0U) != 0U);
+  BENCH_FAIL_IF(xStreamBufferIsEmpty(buffer) != pdTRUE);
+  Fill(scratch, 16U);
+  BENCH_FAIL_IF(xStreamBufferSend(buffer, scratch, 16U, 0U) != 16U);
+  BENCH_FAIL_IF(xStreamBufferReserve(buffer, &region, 1U, 0U) != 0U);
+  (void)xStreamBufferCommit(buffer, 0U);
+  BENCH_FAIL_IF(xStreamBufferAcquire(buffer, &region, 0U) != 16U);
+  VerifyRegion(&region, 16U);
+  (void)xStreamBufferRelease(buffer, 16U);
+  BENCH_FAIL_IF(xStreamBufferAcquire(buffer, &region, 0U) != 0U);
+  (void)xStreamBufferRelease(buffer, 0U);
+
+  vStreamBufferDelete(buffer);
+  BENCH_FAIL_IF(Mismatch != 0U);
+}
+
+// 普通接口发一条再收掉, 把头尾都向前移 length + 长度字段
+static void Advance(MessageBufferHandle_t buffer, size_t length)
+{
+  uint8_t scratch[32];
+
+  Fill(scratch, length);
+  (void)xMessageBufferSend(buffer, scratch, length, 0U);
+  Verify(scratch, xMessageBufferReceive(buffer, scratch, sizeof(scratch), 0U));
+}
+
+static void CheckMessage(void)
+{
+  const size_t prefix = sizeof(configMESSAGE_BUFFER_LENGTH_TYPE);
+  StreamBufferRegion_t region;
+  uint8_t scratch[32];
+  MessageBufferHandle_t buffer;
+  uint8_t *storage;
+
+  // 动态创建多分配一个字节, 存储区长度是 33
+  buffer = xMessageBufferCreate(32U);
+
+  // 长度字段放在 20 起, 数据从 20 + prefix 开始跨过末尾
+  Advance(buffer, 20U - prefix);
+  BENCH_FAIL_IF(xMessageBufferReserve(buffer, &region, 40U, 0U) != 0U);
+  (void)xMessageBufferCommit(buffer, 0U);
+  BENCH_FAIL_IF(xMessageBufferReserve(buffer, &region, 10U, 0U) != 10U);
+  BENCH_FAIL_IF((region.xFirstLength != (13U - prefix)) || (region.xSecondLength != (prefix - 3U)));
+  storage = region.pucSecond;
+  FillRegion(&region, 10U);
+  (void)xMessageBufferCommit(buffer, 10U);
+  BENCH_FAIL_IF(xStreamBufferNextMessageLengthBytes(buffer) != 10U);
+  BENCH_FAIL_IF(xMessageBufferReceive(buffer, scratch, sizeof(scratch), 0U) != 10U);
+  Verify(scratch, 10U);
+
+  // 头在 prefix - 3, 移到 30, 长度字段跨过末尾; 只提交 4 字节
+  Advance(buffer, 33U - (2U * prefix));
+  BENCH_FAIL_IF(xMessageBufferReserve(buffer, &region, 6U, 0U) != 6U);
+  BENCH_FAIL_IF((region.pucFirst != &storage[prefix - 3U]) || (region.pucSecond != NULL));
+  FillRegion(&region, 4U);
+  (void)xMessageBufferCommit(buffer, 4U);
+  BENCH_FAIL_IF(xMessageBufferAcquire(buffer, &region, 0U) != 4U);
+  BENCH_FAIL_IF((region.pucFirst != &storage[prefix - 3U]) || (region.xFirstLength != 4U));
+  VerifyRegion(&region, 4U);
+  BENCH_FAIL_IF(xMessageBufferRelease(buffer) != 4U);
+  BENCH_FAIL_IF(xMessageBufferIsEmpty(buffer) != pdTRUE);
+
+  // 普通接口发, 零拷贝收
+  Fill(scratch, 7U);
+  (void)xMessageBufferSend(buffer, scratch, 7U, 0U);
+  BENCH_FAIL_IF(xMessageBufferAcquire(buffer, &region, 0U) != 7U);
+  VerifyRegion(&region, 7U);
+  (void)xMessageBufferRelease(buffer);
+  BENCH_FAIL_IF(xMessageBufferAcquire(buffer, &region, 0U) != 0U);
+  (void)xMessageBufferRelease(buffer);
+
+  vMessageBufferDelete(buffer);
+  BENCH_FAIL_IF(Mismatch != 0U);
+  printf("stream_check errors=%lu\n", (unsigned long)Errors);
+}
+
+static void Reader_Task(void *argument)
+{
+  Peer_t *peer = argument;
+  StreamBufferRegion_t region;
+
+  peer->result = xStreamBufferAcquire(peer->buffer, &region, portMAX_DELAY);
+  VerifyRegion(&region, peer->result);
+  (void)xStreamBufferRelease(peer->buffer, peer->result);
+  peer->done = 1U;
+  for (;;)
+  {
+    vTaskDelay(portMAX_DELAY);
+  }
+}
+
+static void Writer_Task(void *argument)
+{
+  Peer_t *peer = argument;
+  StreamBufferRegion_t region;
+
+  peer->result = xStreamBufferReserve(peer->buffer, &region, peer->wanted, portMAX_DELAY);
+  FillRegion(&region, peer->wanted);
+  (void)xStreamBufferCommit(peer->buffer, peer->wanted);
+  peer->done = 1U;
+  for (;;)
+  {
+    vTaskDelay(portMAX_DELAY);
+  }
+}
+
+// 对端任务优先级更高, 被唤醒后立刻运行
+static TaskHandle_t StartPeer(Peer_t *peer, TaskFunction_t function, StreamBufferHandle_t buffer, size_t wanted)
+{
+  TaskHandle_t task;
+
+  peer->buffer = buffer;
+  peer->wanted = wanted;
+  peer->result = 0U;
+  peer->done = 0U;
+  xTaskCreate(function, "Peer", configMINIMAL_STACK_SIZE * 2U, peer, BENCH_PRIORITY + 1U, &task);
+  return task;
+}
+
+static uint32_t Bench_SimIrq(void)
+{
+  StreamBufferRegion_t region;
+  BaseType_t woken = pdFALSE;
+
+  if (IsrMode == 0U)
+  {
+    // 中断里写: 比如 DMA 收完一段后提交
+    (void)xStreamBufferReserveFromISR(IsrBuffer, &region, 4U);
+    FillRegion(&region, 4U);
+    IsrResult = xStreamBufferCommitFromISR(IsrBuffer, 4U, &woken);
+  }
+  else
+  {
+    // 中断里读: 比如 DMA 发完一段后释放
+    IsrResult = xStreamBufferAcquireFromISR(IsrBuffer, &region);
+    VerifyRegion(&region, IsrResult);
+    (void)xStreamBufferReleaseFromISR(IsrBuffer, IsrResult, &woken);
+  }
+  return (uint32_t)woken;
+}
+
+static void CheckBlocking(void)
+{
+  StreamBufferRegion_t region;
+  StreamBufferHandle_t buffer;
+  uint8_t scratch[16];
+  Peer_t peer;
+  TaskHandle_t task;
+  uint32_t early;
+
+  // 触发水位 8: 提交 4 字节不唤醒, 再提交 4 字节才唤醒
+  buffer = xStreamBufferCreate(64U, 8U);
+  task = StartPeer(&peer, Reader_Task, buffer, 0U);
+  (void)xStreamBufferReserve(buffer, &region, 4U, 0U);
+  FillRegion(&region, 4U);
+  (void)xStreamBufferCommit(buffer, 4U);
+  early = peer.done;
+  (void)xStreamBufferReserve(buffer, &region, 4U, 0U);
+  FillRegion(&region, 4U);
+  (void)xStreamBufferCommit(buffer, 4U);
+  BENCH_FAIL_IF((early != 0U) || (peer.done == 0U) || (peer.result != 8U));
+  vTaskDelete(task);
+  vStreamBufferDelete(buffer);
+
+  // 缓冲区满, Reserve 阻塞到 Release 4 字节后醒
+  buffer = xStreamBufferCreate(16U, 1U);
+  Fill(scratch, 16U);
+  (void)xStreamBufferSend(buffer, scratch, 16U, 0U);
+  task = StartPeer(&peer, Writer_Task, buffer, 4U);
+  early = peer.done;
+  (void)xStreamBufferAcquire(buffer, &region, 0U);
+  VerifyRegion(&region, 4U);
+  (void)xStreamBufferRelease(buffer, 4U);
+  BENCH_FAIL_IF((early != 0U) || (peer.done == 0U) || (peer.result != 4U));
+  BENCH_FAIL_IF(xStreamBufferBytesAvailable(buffer) != 16U);
+  vTaskDelete(task);
+
+  // 中断里 Release 唤醒阻塞的写任务
+  vPortSetInterruptHandler(BENCH_SIM_IRQ, Bench_SimIrq);
+  IsrBuffer = buffer;
+  IsrMode = 1U;
+  task = StartPeer(&peer, Writer_Task, buffer, 2U);
+  early = peer.done;
+  vPortGenerateSimulatedInterrupt(BENCH_SIM_IRQ);
+  vTaskDelay(2);
+  BENCH_FAIL_IF((early != 0U) || (peer.done == 0U) || (IsrResult != 16U) || (peer.result != 16U));
+  vTaskDelete(task);
+
+  // 中断里 Commit 唤醒阻塞的读任务
+  BENCH_FAIL_IF(xStreamBufferAcquire(buffer, &region, 0U) != 2U);
+  VerifyRegion(&region, 2U);
+  (void)xStreamBufferRelease(buffer, 2U);
+  IsrMode = 0U;
+  task = StartPeer(&peer, Reader_Task, buffer, 0U);
+  early = peer.done;
+  vPortGenerateSimulatedInterrupt(BENCH_SIM_IRQ);
+  vTaskDelay(2);
+  BENCH_FAIL_IF((early != 0U) || (peer.done == 0U) || (IsrResult != 4U) || (peer.result != 4U));
+  vTaskDelete(task);
+  vStreamBufferDelete(buffer);
+
+  BENCH_FAIL_IF(Mismatch != 0U);
+  printf("stream_block errors=%lu\n", (unsigned long)Errors);
+}
+
+static void Bench_Task(void *argument)
+{
+  (void)argument;
+
+  printf("# stream_bench unit=bytes/s bytes=%u buffer=%u\n", (unsigned)BENCH_BYTES, (unsigned)BENCH_BUFFER_SIZE);
+  printf("buffer,chunk,copy,zc\n");
+  MeasureCost();
+
+  CheckStream();
+  CheckMessage();
+  CheckBlocking();
+  BENCH_Finish();
+}
+
+int main(void)
+{
+  xTaskCreate(Bench_Task, "Bench", configMINIMAL_STACK_SIZE * 4U, NULL, BENCH_PRIORITY, NULL);
+  vTaskStartScheduler();
+  return 0;
+}
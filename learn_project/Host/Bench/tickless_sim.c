@@ -0,0 +1,453 @@
+/**
+ ******************************************************************************
+ * @file    tickless_sim.c
+ * @brief   定时器驱动的 tickless idle 节拍补偿仿真
+ *
+ * 目标板上节拍由 TIM4 (16位, configTICKLESS_TIMER_HZ 计数) 的比较匹配产生,
+ * 空闲时 vPortSuppressTicksAndSleep 把比较值推到下一个要唤醒的节拍后睡眠
+ * (见 RVDS/ARM_CM3/port.c 的 configUSE_TICKLESS_TIMER 部分). Posix 移植没有
+ * 低功耗模式, 所以这里用模拟的定时器和一个简化的内核模型, 按 port.c 中
+ * prvTicklessTimerService 和 vPortSuppressTicksAndSleep 的流程调用与 port.c
+ * 共用的计算 (RVDS/ARM_CM3/porttickless.h), 先检查这些计算在计数器回绕等边界
+ * 上的结果, 再按模拟时间运行若干小时, 检查:
+ *   drift     任意时刻内核节拍数与定时器计数换算出的节拍数之差, 应始终为 0
+ *   late      任务唤醒时刻比应唤醒节拍晚多少 (单位: 节拍), 应小于 1
+ * 仿真中会随机插入其它中断提前结束睡眠, 放弃睡眠 (eAbortSleep),
+ * 以及代码执行期间计数器前进, 覆盖比较值写入前计数器已越过等竞争情况.
+ *
+ *   ./tickless_sim [hours]
+ ******************************************************************************
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "porttickless.h"
+
+#define SIM_TICK_RATE_HZ    1000U
+#define SIM_IDLE_BEFORE_SLEEP 2U      // configEXPECTED_IDLE_TIME_BEFORE_SLEEP
+#define SIM_TASKS           6U
+#define SIM_DEFAULT_HOURS   24U
+
+// 模拟的时间和定时器, 时间单位为微秒
+static uint64_t Now;                  // 定时器启动以来的时间
+static uint32_t UsPerCount;           // 定时器每计一次的时间
+static uint32_t Compare;
+static int MatchPending;              // CC1 中断标志
+static uint64_t ExtNext;              // 下一个其它中断 (如串口) 到来的时刻
+static int ExtPending;
+static uint32_t ExtMeanTicks;         // 其它中断的平均间隔, 0 表示没有
+
+// 与 port.c 中同名变量对应
+static uint32_t ulTimerCountsForOneTick;
+static uint32_t xMaximumPossibleSuppressedTicks;
+static uint32_t ulTicklessTimerLastTick;
+
+// 内核模型: 节拍数和若干周期性延时的任务
+static uint64_t TickCount;
+static uint64_t NextWake[SIM_TASKS];
+static uint32_t Period[SIM_TASKS];
+static uint64_t NextUnblock;
+
+// 统计
+static uint64_t Sleeps;
+static uint64_t SleptTicks;
+static uint32_t MaxSleptTicks;
+static uint64_t EarlyWakes;
+static uint64_t Aborts;
+static uint64_t Wakeups;
+static int64_t MaxDrift;
+static uint64_t MaxLate;              // 单位: 微秒
+
+static uint32_t Random(uint32_t range)
+{
+  return (uint32_t)rand() % range;
+}
+
+static void ScheduleExternal(void)
+{
+  ExtNext = (ExtMeanTicks == 0U) ? UINT64_MAX
+          : Now + Random(ExtMeanTicks * 2U * (1000000U / SIM_TICK_RATE_HZ)) + 1U;
+}
+
+// 从 Now 起计数器还要多久到达比较值
+static uint64_t TimeToMatch(void)
+{
+  uint64_t count = Now / UsPerCount;
+  uint64_t distance = (Compare - (uint32_t)(count & portTICKLESS_TIMER_MASK)) & portTICKLESS_TIMER_MASK;
+
+  if (distance == 0U)
+  {
+    distance = portTICKLESS_TIMER_MASK + 1U;
+  }
+  return (count + distance) * UsPerCount - Now;
+}
+
+// 时间前进 us, 计数器经过比较值时置位中断标志
+static void Advance(uint64_t us)
+{
+  if (TimeToMatch() <= us)
+  {
+    MatchPending = 1;
+  }
+  Now += us;
+  if (Now >= ExtNext)
+  {
+    ExtPending = 1;
+  }
+}
+
+// 执行一段代码 (一次中断处理或睡眠前后的处理), 72MHz 下几到几十微秒
+static void CpuRun(void)
+{
+  Advance(Random(40U));
+}
+
+// 等待中断: 有挂起的中断时立即返回, 否则前进到比较匹配或其它中断
+static void Wfi(void)
+{
+  uint64_t wake;
+
+  if (MatchPending || ExtPending)
+  {
+    return;
+  }
+  wake = TimeToMatch();
+  if (ExtNext - Now < wake)
+  {
+    wake = ExtNext - Now;
+  }
+  Advance(wake);
+}
+
+static uint32_t ulApplicationTicklessTimerCount(void)
+{
+  return (uint32_t)((Now / UsPerCount) & portTICKLESS_TIMER_MASK);
+}
+
+static void vApplicationTicklessTimerSetCompare(uint32_t ulCompare)
+{
+  Compare = ulCompare & portTICKLESS_TIMER_MASK;
+}
+
+static void UpdateNextUnblock(void)
+{
+  uint32_t i;
+
+  NextUnblock = UINT64_MAX;
+  for (i = 0; i < SIM_TASKS; i++)
+  {
+    if (NextWake[i] < NextUnblock)
+    {
+      NextUnblock = NextWake[i];
+    }
+  }
+}
+
+// 第 tick 个节拍应在定时器计数 tick * ulTimerCountsForOneTick 时到来
+static void CheckTick(void)
+{
+  if ((uint32_t)((TickCount * ulTimerCountsForOneTick) & portTICKLESS_TIMER_MASK) != ulTicklessTimerLastTick)
+  {
+    printf("# tick %llu does not match the timer\n", (unsigned long long)TickCount);
+    exit(1);
+  }
+}
+
+static int xTaskIncrementTick(void)
+{
+  uint64_t late;
+  uint32_t i;
+
+  TickCount++;
+  CheckTick();
+  if (TickCount < NextUnblock)
+  {
+    return 0;
+  }
+
+  late = Now - TickCount * ulTimerCountsForOneTick * UsPerCount;
+  if (late > MaxLate)
+  {
+    MaxLate = late;
+  }
+  for (i = 0; i < SIM_TASKS; i++)
+  {
+    if (NextWake[i] == TickCount)
+    {
+      NextWake[i] += Period[i];
+      Wakeups++;
+    }
+  }
+  UpdateNextUnblock();
+  return 1;
+}
+
+static void vTaskStepTick(uint32_t xTicksToJump)
+{
+  // 与 tasks.c 相同的检查; port.c 总是留下最后一个节拍给正常的节拍处理
+  if (TickCount + xTicksToJump >= NextUnblock)
+  {
+    printf("# stepped onto the unblock time at tick %llu\n", (unsigned long long)TickCount);
+    exit(1);
+  }
+  TickCount += xTicksToJump;
+  CheckTick();
+}
+
+static int eTaskConfirmSleepModeStatusAbort(void)
+{
+  return Random(64U) == 0U;
+}
+
+/* ---- 以下两个函数与 port.c 中的实现流程相同, 计算都来自 porttickless.h ---- */
+
+static int prvTicklessTimerService(void)
+{
+  int xSwitchRequired = 0;
+
+  do
+  {
+    while (portTICKLESS_COUNTS_SINCE(ulApplicationTicklessTimerCount(), ulTicklessTimerLastTick) >= ulTimerCountsForOneTick)
+    {
+      ulTicklessTimerLastTick = portTICKLESS_COUNT_AFTER(ulTicklessTimerLastTick, 1U, ulTimerCountsForOneTick);
+
+      if (xTaskIncrementTick() != 0)
+      {
+        xSwitchRequired = 1;
+      }
+      CpuRun();
+    }
+
+    vApplicationTicklessTimerSetCompare(portTICKLESS_COUNT_AFTER(ulTicklessTimerLastTick, 1U, ulTimerCountsForOneTick));
+
+  } while (portTICKLESS_COUNTS_SINCE(ulApplicationTicklessTimerCount(), ulTicklessTimerLastTick) >= ulTimerCountsForOneTick);
+
+  return xSwitchRequired;
+}
+
+static void vPortSuppressTicksAndSleep(uint32_t xExpectedIdleTime)
+{
+  uint32_t ulCountsSinceTick;
+  uint32_t ulCompleteTickPeriods;
+
+  if (xExpectedIdleTime > xMaximumPossibleSuppressedTicks)
+  {
+    xExpectedIdleTime = xMaximumPossibleSuppressedTicks;
+  }
+
+  // __disable_irq()
+  CpuRun();
+  if (eTaskConfirmSleepModeStatusAbort() ||
+      (portTICKLESS_COUNTS_SINCE(ulApplicationTicklessTimerCount(), ulTicklessTimerLastTick) >= ulTimerCountsForOneTick))
+  {
+    Aborts++;
+    return;
+  }
+
+  CpuRun();
+  vApplicationTicklessTimerSetCompare(portTICKLESS_COUNT_AFTER(ulTicklessTimerLastTick, xExpectedIdleTime, ulTimerCountsForOneTick));
+
+  // configPRE_SLEEP_PROCESSING, __wfi(), configPOST_SLEEP_PROCESSING
+  CpuRun();
+  Wfi();
+  CpuRun();
+
+  ulCountsSinceTick = portTICKLESS_COUNTS_SINCE(ulApplicationTicklessTimerCount(), ulTicklessTimerLastTick);
+  ulCompleteTickPeriods = portTICKLESS_STEP_TICKS(ulCountsSinceTick, ulTimerCountsForOneTick, xExpectedIdleTime);
+  if ((ulCountsSinceTick / ulTimerCountsForOneTick) < xExpectedIdleTime)
+  {
+    EarlyWakes++;
+  }
+  ulTicklessTimerLastTick = portTICKLESS_COUNT_AFTER(ulTicklessTimerLastTick, ulCompleteTickPeriods, ulTimerCountsForOneTick);
+  vTaskStepTick(ulCompleteTickPeriods);
+
+  (void)prvTicklessTimerService();
+
+  Sleeps++;
+  SleptTicks += xExpectedIdleTime;
+  if (xExpectedIdleTime > MaxSleptTicks)
+  {
+    MaxSleptTicks = xExpectedIdleTime;
+  }
+  // __enable_irq()
+}
+
+/* ---- porttickless.h 的边界检查 ---- */
+
+static int CheckValue(const char *name, uint32_t value, uint32_t expected)
+{
+  if (value != expected)
+  {
+    printf("# %s = %lu, expected %lu\n", name, (unsigned long)value, (unsigned long)expected);
+    return 0;
+  }
+  return 1;
+}
+
+#define CHECK_VALUE(expr, expected)   CheckValue(#expr, (uint32_t)(expr), (expected))
+
+static int CheckArithmetic(void)
+{
+  int ok = 1;
+
+  // 计数器回绕前后的距离
+  ok &= CHECK_VALUE(portTICKLESS_COUNTS_SINCE(0x0005U, 0xFFF0U), 0x15U);
+  ok &= CHECK_VALUE(portTICKLESS_COUNTS_SINCE(0x1234U, 0x1234U), 0U);
+  ok &= CHECK_VALUE(portTICKLESS_COUNTS_SINCE(0x0000U, 0x0001U), 0xFFFFU);
+
+  // 比较值越过回绕, 以及睡满最长时间时比较值与起点的距离
+  ok &= CHECK_VALUE(portTICKLESS_COUNT_AFTER(0xFFFEU, 1U, 2U), 0U);
+  ok &= CHECK_VALUE(portTICKLESS_COUNT_AFTER(0xFFF0U, 100U, 20U), 0x07C0U);
+  ok &= CHECK_VALUE(portTICKLESS_COUNTS_SINCE(portTICKLESS_COUNT_AFTER(0xFFFAU, portTICKLESS_MAX_SUPPRESSED_TICKS(2U), 2U), 0xFFFAU),
+                    portTICKLESS_MAX_SUPPRESSED_TICKS(2U) * 2U);
+
+  // 最长睡眠时间留出一个节拍周期
+  ok &= CHECK_VALUE(portTICKLESS_MAX_SUPPRESSED_TICKS(1U), 65534U);
+  ok &= CHECK_VALUE(portTICKLESS_MAX_SUPPRESSED_TICKS(2U), 32766U);
+  ok &= CHECK_VALUE(portTICKLESS_MAX_SUPPRESSED_TICKS(10U), 6552U);
+
+  // 睡醒后补的节拍数: 提前醒来时只补已过完的周期, 否则总留下最后一个
+  ok &= CHECK_VALUE(portTICKLESS_STEP_TICKS(19U, 20U, 10U), 0U);
+  ok &= CHECK_VALUE(portTICKLESS_STEP_TICKS(199U, 20U, 10U), 9U);
+  ok &= CHECK_VALUE(portTICKLESS_STEP_TICKS(200U, 20U, 10U), 9U);
+  ok &= CHECK_VALUE(portTICKLESS_STEP_TICKS(0xFFFFU, 2U, 100U), 99U);
+  ok &= CHECK_VALUE(portTICKLESS_STEP_TICKS(0U, 2U, 1U), 0U);
+
+  printf("# arithmetic %s\n", ok ? "ok" : "FAIL");
+  return ok;
+}
+
+/* ---- 仿真主循环 ---- */
+
+static void CheckDrift(void)
+{
+  int64_t drift = (int64_t)TickCount - (int64_t)(Now / (ulTimerCountsForOneTick * UsPerCount));
+
+  if (drift < 0)
+  {
+    drift = -drift;
+  }
+  if (drift > MaxDrift)
+  {
+    MaxDrift = drift;
+  }
+}
+
+static int Simulate(uint32_t timerHz, const uint32_t *maxPeriod, uint32_t extMeanTicks, uint32_t hours)
+{
+  uint64_t end;
+  uint32_t i;
+  int64_t drift;
+
+  Now = 0;
+  UsPerCount = 1000000U / timerHz;
+  MatchPending = 0;
+  ExtPending = 0;
+  ExtMeanTicks = extMeanTicks;
+  TickCount = 0;
+  Sleeps = SleptTicks = EarlyWakes = Aborts = Wakeups = 0;
+  MaxSleptTicks = 0;
+  MaxDrift = 0;
+  MaxLate = 0;
+
+  // vPortSetupTimerInterrupt
+  ulTimerCountsForOneTick = timerHz / SIM_TICK_RATE_HZ;
+  xMaximumPossibleSuppressedTicks = portTICKLESS_MAX_SUPPRESSED_TICKS(ulTimerCountsForOneTick);
+  ulTicklessTimerLastTick = ulApplicationTicklessTimerCount();
+  vApplicationTicklessTimerSetCompare(portTICKLESS_COUNT_AFTER(ulTicklessTimerLastTick, 1U, ulTimerCountsForOneTick));
+
+  for (i = 0; i < SIM_TASKS; i++)
+  {
+    Period[i] = (maxPeriod[i] / 2U) + Random(maxPeriod[i] / 2U) + 2U;
+    NextWake[i] = Period[i];
+  }
+  UpdateNextUnblock();
+  ScheduleExternal();
+
+  end = (uint64_t)hours * 3600U * 1000000U;
+  while (Now < end)
+  {
+    // 中断打开时先处理挂起的中断
+    if (MatchPending)
+    {
+      MatchPending = 0;
+      (void)prvTicklessTimerService();
+      continue;
+    }
+    if (ExtPending)
+    {
+      ExtPending = 0;
+      CpuRun();
+      ScheduleExternal();
+      continue;
+    }
+
+    // 空闲任务
+    CheckDrift();
+    if (NextUnblock - TickCount >= SIM_IDLE_BEFORE_SLEEP)
+    {
+      vPortSuppressTicksAndSleep((uint32_t)(NextUnblock - TickCount));
+    }
+    else
+    {
+      Wfi();
+    }
+  }
+
+  while (MatchPending)
+  {
+    MatchPending = 0;
+    (void)prvTicklessTimerService();
+  }
+  drift = (int64_t)TickCount - (int64_t)(Now / (ulTimerCountsForOneTick * UsPerCount));
+
+  printf("%lu,%lu,%lu,%lu,%llu,%lld,%lld,%llu,%llu,%llu,%lu,%llu,%llu,%.3f\n",
+         (unsigned long)timerHz, (unsigned long)ulTimerCountsForOneTick,
+         (unsigned long)xMaximumPossibleSuppressedTicks, (unsigned long)extMeanTicks,
+         (unsigned long long)TickCount, (long long)drift, (long long)MaxDrift,
+         (unsigned long long)Wakeups, (unsigned long long)Sleeps,
+         (unsigned long long)(Sleeps ? SleptTicks / Sleeps : 0U), (unsigned long)MaxSleptTicks,
+         (unsigned long long)EarlyWakes, (unsigned long long)Aborts,
+         (double)MaxLate * SIM_TICK_RATE_HZ / 1000000.0);
+
+  return (drift == 0) && (MaxDrift == 0);
+}
+
+int main(int argc, char **argv)
+{
+  static const uint32_t TimerHz[] = { 1000U, 2000U, 10000U };
+  static const uint32_t ExtMean[] = { 0U, 50U, 2000U };
+  // 各任务周期的上限. busy: 有毫秒级的周期任务; sparse: 所有任务都在等待
+  // 一分钟以上, 睡眠时间受定时器的16位范围限制
+  static const uint32_t MaxPeriod[2][SIM_TASKS] = {
+    { 20U, 1000U, 5000U, 30000U, 60000U, 120000U },
+    { 60000U, 120000U, 180000U, 240000U, 300000U, 600000U },
+  };
+  uint32_t hours = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : SIM_DEFAULT_HOURS;
+  uint32_t i;
+  uint32_t j;
+  uint32_t k;
+  int ok = 1;
+
+  srand(1);
+  printf("# tickless_sim hours=%lu tick_hz=%u\n", (unsigned long)hours, SIM_TICK_RATE_HZ);
+  ok &= CheckArithmetic();
+  printf("tasks,timer_hz,counts_per_tick,sleep_limit,ext_irq_mean_ticks,ticks,drift,max_drift,"
+         "wakeups,sleeps,avg_sleep_ticks,max_sleep_ticks,early_wakes,aborts,max_late_ticks\n");
+  for (i = 0; i < sizeof(TimerHz) / sizeof(TimerHz[0]); i++)
+  {
+    for (j = 0; j < 2U; j++)
+    {
+      for (k = 0; k < sizeof(ExtMean) / sizeof(ExtMean[0]); k++)
+      {
+        printf("%s,", (j == 0U) ? "busy" : "sparse");
+        ok &= Simulate(TimerHz[i], MaxPeriod[j], ExtMean[k], hours);
+      }
+    }
+  }
+
+  printf("# %s\n", ok ? "pass" : "FAIL");
+  return ok ? 0 : 1;
+}
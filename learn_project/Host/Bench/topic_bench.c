@@ -0,0 +1,378 @@
+/**
+ ******************************************************************************
+ * @file    topic_bench.c
+ * @brief   发布/订阅主题 (topic.c) 与每个订阅者一个队列的扇出对比
+ *
+ * 一个发布者把 BENCH_MESSAGES 条消息发给 1~16 个订阅者, 每个订阅者都要
+ * 按顺序收到全部消息:
+ *   queues  每个订阅者一个深度 BENCH_DEPTH 的队列, 发布一次就要
+ *           xQueueSend 订阅者个数次, 消息也拷贝同样多次
+ *   topic   一个 eTopicBlock 主题, 发布一次只拷贝一次, 一次唤醒所有
+ *           正在等待的订阅者
+ * cost  单个任务先发布 BENCH_DEPTH 条, 再替每个订阅者把它们取完, 没有任务
+ *       切换, 分别得到每条消息的发布耗时和每次投递的接收耗时
+ *       (BENCH_COST_ROUNDS 轮取最小值).
+ * e2e   每个订阅者一个任务, 优先级高于发布者, 输出从发布第一条到最后一个
+ *       订阅者收完的时间, 折算成每条消息的耗时. 主机上它主要是任务切换的
+ *       耗时: 队列每发送一次就切到一个订阅者再切回来, 主题发布一次唤醒
+ *       全部订阅者, 它们依次运行完才切回发布者.
+ * 另外检查 eTopicDrop / eTopicOverwrite / eTopicBlock 在订阅者跟不上时的
+ * 行为, 以及订阅、退订和超时.
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "topic.h"
+#include "bench_util.h"
+
+#define BENCH_MESSAGES      20000U
+#define BENCH_COST_ROUNDS   5U
+#define BENCH_MAX_SUBS      16U
+#define BENCH_DEPTH         16U
+#define BENCH_PRIORITY      (configMAX_PRIORITIES - 8U)
+
+typedef struct
+{
+  uint32_t Seq;
+  uint8_t Pad[28];
+} Msg_t;
+
+static QueueHandle_t Queues[BENCH_MAX_SUBS];
+static TopicHandle_t Topic;
+static TopicSubscriberHandle_t Subs[BENCH_MAX_SUBS];
+static volatile uint32_t Done;
+static volatile uint64_t EndNs;
+
+// 订阅者: 按顺序收完 BENCH_MESSAGES 条后记下完成时间并挂起
+static void Finish(uint32_t expected)
+{
+  if (expected != BENCH_MESSAGES)
+  {
+    Errors++;
+  }
+  EndNs = NowNs();
+  Done++;
+  vTaskSuspend(NULL);
+}
+
+static void QueueSub_Task(void *argument)
+{
+  QueueHandle_t queue = Queues[(uint32_t)(uintptr_t)argument];
+  uint32_t expected = 0;
+  Msg_t msg;
+
+  while (expected < BENCH_MESSAGES)
+  {
+    (void)xQueueReceive(queue, &msg, portMAX_DELAY);
+    BENCH_FAIL_IF(msg.Seq != expected);
+    expected++;
+  }
+  Finish(expected);
+}
+
+static void TopicSub_Task(void *argument)
+{
+  TopicSubscriberHandle_t sub = Subs[(uint32_t)(uintptr_t)argument];
+  uint32_t expected = 0;
+  Msg_t msg;
+
+  while (expected < BENCH_MESSAGES)
+  {
+    (void)xTopicReceive(sub, &msg, portMAX_DELAY);
+    BENCH_FAIL_IF(msg.Seq != expected);
+    expected++;
+  }
+  Finish(expected);
+}
+
+static uint64_t RunFanout(uint32_t subs, uint8_t useTopic)
+{
+  TaskHandle_t tasks[BENCH_MAX_SUBS];
+  uint64_t start;
+  Msg_t msg;
+  uint32_t i;
+  uint32_t s;
+
+  Done = 0;
+  if (useTopic != 0U)
+  {
+    Topic = xTopicCreate(BENCH_DEPTH, sizeof(Msg_t), eTopicBlock);
+  }
+  for (s = 0; s < subs; s++)
+  {
+    if (useTopic != 0U)
+    {
+      Subs[s] = xTopicSubscribe(Topic);
+      xTaskCreate(TopicSub_Task, "Sub", configMINIMAL_STACK_SIZE * 2U, (void *)(uintptr_t)s, BENCH_PRIORITY - 1U,
+                  &tasks[s]);
+    }
+    else
+    {
+      Queues[s] = xQueueCreate(BENCH_DEPTH, sizeof(Msg_t));
+      xTaskCreate(QueueSub_Task, "Sub", configMINIMAL_STACK_SIZE * 2U, (void *)(uintptr_t)s, BENCH_PRIORITY - 1U,
+                  &tasks[s]);
+    }
+  }
+
+  // 测试任务降到订阅者之下作为发布者
+  vTaskPrioritySet(NULL, BENCH_PRIORITY - 2U);
+  memset(&msg, 0, sizeof(msg));
+  start = NowNs();
+  for (i = 0; i < BENCH_MESSAGES; i++)
+  {
+    msg.Seq = i;
+    if (useTopic != 0U)
+    {
+      (void)xTopicPublish(Topic, &msg, portMAX_DELAY);
+    }
+    else
+    {
+      for (s = 0; s < subs; s++)
+      {
+        (void)xQueueSend(Queues[s], &msg, portMAX_DELAY);
+      }
+    }
+  }
+  while (Done < subs)
+  {
+    vTaskDelay(1);
+  }
+  vTaskPrioritySet(NULL, BENCH_PRIORITY);
+
+  for (s = 0; s < subs; s++)
+  {
+    vTaskDelete(tasks[s]);
+    if (useTopic != 0U)
+    {
+      vTopicUnsubscribe(Subs[s]);
+    }
+    else
+    {
+      vQueueDelete(Queues[s]);
+    }
+  }
+  if (useTopic != 0U)
+  {
+    BENCH_FAIL_IF(ulTopicGetDroppedCount(Topic) != 0U);
+    vTopicDelete(Topic);
+  }
+  return EndNs - start;
+}
+
+// 单个任务内发布 BENCH_DEPTH 条再逐个订阅者取完, 返回发布和接收各自的总耗时
+static void CostRound(uint32_t subs, uint8_t useTopic, uint64_t *pubNs, uint64_t *recvNs)
+{
+  uint64_t start;
+  Msg_t msg;
+  uint32_t i;
+  uint32_t s;
+
+  memset(&msg, 0, sizeof(msg));
+  start = NowNs();
+  for (i = 0; i < BENCH_DEPTH; i++)
+  {
+    if (useTopic != 0U)
+    {
+      (void)xTopicPublish(Topic, &msg, 0U);
+    }
+    else
+    {
+      for (s = 0; s < subs; s++)
+      {
+        (void)xQueueSend(Queues[s], &msg, 0U);
+      }
+    }
+  }
+  *pubNs += NowNs() - start;
+
+  start = NowNs();
+  for (s = 0; s < subs; s++)
+  {
+    for (i = 0; i < BENCH_DEPTH; i++)
+    {
+      if (useTopic != 0U)
+      {
+        (void)xTopicReceive(Subs[s], &msg, 0U);
+      }
+      else
+      {
+        (void)xQueueReceive(Queues[s], &msg, 0U);
+      }
+    }
+  }
+  *recvNs += NowNs() - start;
+}
+
+static void RunCost(uint32_t subs, uint8_t useTopic)
+{
+  const uint32_t bursts = BENCH_MESSAGES / BENCH_DEPTH;
+  uint64_t bestPub = UINT64_MAX;
+  uint64_t bestRecv = UINT64_MAX;
+  uint64_t pubNs;
+  uint64_t recvNs;
+  uint32_t r;
+  uint32_t b;
+  uint32_t s;
+
+  if (useTopic != 0U)
+  {
+    Topic = xTopicCreate(BENCH_DEPTH, sizeof(Msg_t), eTopicBlock);
+  }
+  for (s = 0; s < subs; s++)
+  {
+    if (useTopic != 0U)
+    {
+      Subs[s] = xTopicSubscribe(Topic);
+    }
+    else
+    {
+      Queues[s] = xQueueCreate(BENCH_DEPTH, sizeof(Msg_t));
+    }
+  }
+
+  for (r = 0; r < BENCH_COST_ROUNDS; r++)
+  {
+    pubNs = 0;
+    recvNs = 0;
+    for (b = 0; b < bursts; b++)
+    {
+      CostRound(subs, useTopic, &pubNs, &recvNs);
+    }
+    bestPub = (pubNs < bestPub) ? pubNs : bestPub;
+    bestRecv = (recvNs < bestRecv) ? recvNs : bestRecv;
+  }
+
+  for (s = 0; s < subs; s++)
+  {
+    if (useTopic != 0U)
+    {
+      BENCH_FAIL_IF(uxTopicMessagesWaiting(Subs[s]) != 0U);
+      vTopicUnsubscribe(Subs[s]);
+    }
+    else
+    {
+      vQueueDelete(Queues[s]);
+    }
+  }
+  if (useTopic != 0U)
+  {
+    BENCH_FAIL_IF(ulTopicGetDroppedCount(Topic) != 0U);
+    vTopicDelete(Topic);
+  }
+
+  printf("cost,%s,%lu,%llu,%llu\n", (useTopic != 0U) ? "topic" : "queues", (unsigned long)subs,
+         (unsigned long long)(bestPub / (bursts * BENCH_DEPTH)),
+         (unsigned long long)(bestRecv / ((uint64_t)bursts * BENCH_DEPTH * subs)));
+}
+
+// 订阅者一直不读时各策略的行为
+static void CheckPolicies(void)
+{
+  TopicSubscriberHandle_t slow;
+  TopicSubscriberHandle_t late;
+  TickType_t ticks;
+  Msg_t msg;
+  uint32_t i;
+
+  memset(&msg, 0, sizeof(msg));
+
+  // drop: 满了以后的消息直接失败, 已有的消息不受影响
+  Topic = xTopicCreate(4U, sizeof(Msg_t), eTopicDrop);
+  slow = xTopicSubscribe(Topic);
+  for (i = 0; i < 6U; i++)
+  {
+    msg.Seq = i;
+    BENCH_FAIL_IF((xTopicPublish(Topic, &msg, 10U) == pdPASS) != (i < 4U));
+  }
+  BENCH_FAIL_IF((ulTopicGetDroppedCount(Topic) != 2U) || (uxTopicMessagesWaiting(slow) != 4U));
+  (void)xTopicReceive(slow, &msg, 0U);
+  BENCH_FAIL_IF(msg.Seq != 0U);
+  // 新的订阅者只收到订阅之后发布的消息
+  late = xTopicSubscribe(Topic);
+  msg.Seq = 100U;
+  BENCH_FAIL_IF(xTopicPublish(Topic, &msg, 0U) != pdPASS);
+  BENCH_FAIL_IF((xTopicReceive(late, &msg, 0U) != pdPASS) || (msg.Seq != 100U));
+  BENCH_FAIL_IF(xTopicReceive(late, &msg, 0U) != pdFAIL);
+  vTopicUnsubscribe(late);
+  vTopicUnsubscribe(slow);
+  vTopicDelete(Topic);
+
+  // overwrite: 发布总是成功, 慢的订阅者丢掉最旧的消息
+  Topic = xTopicCreate(4U, sizeof(Msg_t), eTopicOverwrite);
+  slow = xTopicSubscribe(Topic);
+  for (i = 0; i < 10U; i++)
+  {
+    msg.Seq = i;
+    BENCH_FAIL_IF(xTopicPublish(Topic, &msg, 0U) != pdPASS);
+  }
+  BENCH_FAIL_IF((ulTopicGetLostCount(slow) != 6U) || (uxTopicMessagesWaiting(slow) != 4U));
+  for (i = 6U; i < 10U; i++)
+  {
+    BENCH_FAIL_IF((xTopicReceive(slow, &msg, 0U) != pdPASS) || (msg.Seq != i));
+  }
+  vTopicUnsubscribe(slow);
+  vTopicDelete(Topic);
+
+  // block: 满了以后等待超时; 接收也一样
+  Topic = xTopicCreate(4U, sizeof(Msg_t), eTopicBlock);
+  slow = xTopicSubscribe(Topic);
+  for (i = 0; i < 4U; i++)
+  {
+    (void)xTopicPublish(Topic, &msg, 0U);
+  }
+  ticks = xTaskGetTickCount();
+  BENCH_FAIL_IF(xTopicPublish(Topic, &msg, 5U) != pdFAIL);
+  BENCH_FAIL_IF((xTaskGetTickCount() - ticks) < 5U);
+  // 退订后不再阻挡发布者
+  vTopicUnsubscribe(slow);
+  BENCH_FAIL_IF(xTopicPublish(Topic, &msg, 0U) != pdPASS);
+  slow = xTopicSubscribe(Topic);
+  ticks = xTaskGetTickCount();
+  BENCH_FAIL_IF(xTopicReceive(slow, &msg, 5U) != pdFAIL);
+  BENCH_FAIL_IF((xTaskGetTickCount() - ticks) < 5U);
+  vTopicUnsubscribe(slow);
+  vTopicDelete(Topic);
+
+  printf("topic_check errors=%lu\n", (unsigned long)Errors);
+}
+
+static void Bench_Task(void *argument)
+{
+  uint64_t ns;
+  uint32_t subs;
+
+  (void)argument;
+
+  printf("# topic_bench unit=ns messages=%u depth=%u size=%u\n", BENCH_MESSAGES, BENCH_DEPTH,
+         (unsigned)sizeof(Msg_t));
+  printf("phase,mode,subs,publish_per_msg,receive_per_delivery\n");
+  for (subs = 1U; subs <= BENCH_MAX_SUBS; subs *= 2U)
+  {
+    RunCost(subs, 0U);
+    RunCost(subs, 1U);
+  }
+  printf("phase,mode,subs,total_us,per_msg\n");
+  for (subs = 1U; subs <= BENCH_MAX_SUBS; subs *= 2U)
+  {
+    ns = RunFanout(subs, 0U);
+    printf("e2e,queues,%lu,%llu,%llu\n", (unsigned long)subs, (unsigned long long)(ns / 1000U),
+           (unsigned long long)(ns / BENCH_MESSAGES));
+    ns = RunFanout(subs, 1U);
+    printf("e2e,topic,%lu,%llu,%llu\n", (unsigned long)subs, (unsigned long long)(ns / 1000U),
+           (unsigned long long)(ns / BENCH_MESSAGES));
+  }
+  CheckPolicies();
+  BENCH_Finish();
+}
+
+int main(void)
+{
+  xTaskCreate(Bench_Task, "Bench", configMINIMAL_STACK_SIZE * 4U, NULL, BENCH_PRIORITY, NULL);
+  vTaskStartScheduler();
+  return 0;
+}
@@ -0,0 +1,280 @@
+/**
+ ******************************************************************************
+ * @file    uart_rx_bench.c
+ * @brief   uart_rx 接收模块在主机上的测量
+ *
+ * 一个主机线程按 921600 波特率向模拟串口注入随机长度的帧, 帧间隔随机:
+ * 大多数间隔超过一个字符时间(产生空闲线中断), 少数不足一个字符(两帧
+ * 在线路上连在一起). 接收任务直接在 DMA 缓冲区里逐字节校验数据, 并检查
+ * 每个帧结束标志都出现在注入时记录的空闲位置上.
+ * 中断来得太晚、DMA 写满整圈时, 接收模块丢掉这段数据并发一个出错的帧
+ * 结束标记, 接收任务从它的序号处重新校验. 检查失败, 或者有字节既没有
+ * 收到也没有作为丢失报告时输出 "# FAIL".
+ ******************************************************************************
+ */
+
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "cmsis_os2.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "uart_log.h"
+#include "uart_rx.h"
+#include "uart_sim.h"
+#include "bench_util.h"
+
+#define BENCH_BAUD          921600U
+#define BENCH_FRAMES        1000U
+#define BENCH_MAX_FRAME     1024U
+
+static uint8_t FrameData[BENCH_MAX_FRAME];
+
+// 注入线程记录的每个空闲线位置(从开始起的字节序号)
+static uint32_t IdleAt[BENCH_FRAMES];
+static volatile uint32_t IdleCount;
+static volatile uint32_t InjectDone;
+static uint32_t InjectedBytes;
+static uint64_t InjectNs;
+
+static volatile uint32_t RxBytes;
+static volatile uint32_t RxFrames;
+static volatile uint32_t RxMismatches;
+static volatile uint32_t RxBoundaryErrors;
+static volatile uint32_t RxReleaseErrors;
+static volatile uint32_t RxLostSegments;
+static volatile uint32_t RxLostBytes;
+static volatile uint64_t RxTaskNs;
+
+// 数据内容只由字节在整个数据流中的序号决定, 接收端可以独立校验
+static uint8_t StreamByte(uint32_t index)
+{
+  return (uint8_t)((index * 2654435761U) >> 24);
+}
+
+static uint32_t Random(void)
+{
+  static uint32_t state = 0x12345678U;
+
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  return state;
+}
+
+static uint32_t RandomFrameLen(void)
+{
+  uint32_t r = Random() % 100U;
+
+  if (r < 70U)
+  {
+    return 1U + (Random() % 64U);
+  }
+  if (r < 95U)
+  {
+    return 65U + (Random() % 236U);
+  }
+  return 301U + (Random() % (BENCH_MAX_FRAME - 300U));
+}
+
+static uint32_t RandomIdleBits(void)
+{
+  uint32_t r = Random() % 100U;
+
+  if (r < 5U)
+  {
+    return Random() % 10U;      // 不足一个字符, 不产生空闲线中断
+  }
+  if (r < 90U)
+  {
+    return 10U + (Random() % 100U);
+  }
+  return 1000U + (Random() % 10000U);
+}
+
+// 模拟串口对端, 运行在普通线程中
+static void *InjectThread(void *argument)
+{
+  const struct timespec delay = {0, 1000000};
+  sigset_t signals;
+  uint64_t start;
+  uint32_t stream = 0;
+  uint32_t len;
+  uint32_t idle;
+  uint32_t i;
+  uint32_t k;
+
+  (void)argument;
+
+  sigfillset(&signals);
+  pthread_sigmask(SIG_BLOCK, &signals, NULL);
+
+  // 等待调度器启动
+  while (xTaskGetSchedulerState() != taskSCHEDULER_RUNNING)
+  {
+    nanosleep(&delay, NULL);
+  }
+
+  start = NowNs();
+  for (k = 0; k < BENCH_FRAMES; k++)
+  {
+    len = RandomFrameLen();
+    idle = (k == (BENCH_FRAMES - 1U)) ? 100U : RandomIdleBits();
+    for (i = 0; i < len; i++)
+    {
+      FrameData[i] = StreamByte(stream + i);
+    }
+    stream += len;
+    if (idle >= 10U)
+    {
+      IdleAt[IdleCount] = stream;
+      IdleCount++;
+    }
+    UART_SimRxInject(FrameData, len, idle);
+  }
+  InjectNs = NowNs() - start;
+  InjectedBytes = stream;
+  InjectDone = 1U;
+
+  return NULL;
+}
+
+static void Rx_Task(void *argument)
+{
+  UART_RX_Segment_t seg;
+  uint32_t stream = 0;
+  uint64_t start;
+  uint32_t i;
+
+  (void)argument;
+
+  for (;;)
+  {
+    if (UART_RX_Receive(&seg, osWaitForever) != 0)
+    {
+      continue;
+    }
+
+    start = NowNs();
+    if ((seg.Flags & UART_RX_FLAG_ERROR) != 0U)
+    {
+      // 之前的数据被覆盖, 从这里重新开始; 丢失的数据里的空闲位置不再检查
+      RxLostSegments++;
+      RxLostBytes += seg.Seq - stream;
+      stream = seg.Seq + seg.Len;
+      while ((RxFrames < IdleCount) && (IdleAt[RxFrames] <= stream))
+      {
+        RxFrames++;
+      }
+      (void)UART_RX_Release(&seg);
+      RxTaskNs += NowNs() - start;
+      continue;
+    }
+    if (seg.Seq != stream)
+    {
+      RxMismatches++;
+      stream = seg.Seq;
+    }
+    for (i = 0; i < seg.Len; i++)
+    {
+      if (seg.Data[i] != StreamByte(stream + i))
+      {
+        RxMismatches++;
+        break;
+      }
+    }
+    stream += seg.Len;
+    RxBytes += seg.Len;
+
+    if (UART_RX_Release(&seg) != 0)
+    {
+      RxReleaseErrors++;
+    }
+
+    if ((seg.Flags & UART_RX_FLAG_FRAME_END) != 0U)
+    {
+      if ((RxFrames >= IdleCount) || (IdleAt[RxFrames] != stream))
+      {
+        RxBoundaryErrors++;
+      }
+      RxFrames++;
+    }
+    RxTaskNs += NowNs() - start;
+  }
+}
+
+static void Monitor_Task(void *argument)
+{
+  UART_RX_Stats_t stats;
+  uint32_t waited = 0;
+
+  (void)argument;
+
+  while (InjectDone == 0U)
+  {
+    osDelay(10);
+  }
+  while ((RxFrames < IdleCount) && (waited < 1000U))
+  {
+    osDelay(10);
+    waited += 10U;
+  }
+  UART_RX_GetStats(&stats);
+
+  printf("uart_rx baud=%lu frames=%lu bytes=%lu line_ms=%llu\n",
+         (unsigned long)BENCH_BAUD, (unsigned long)IdleCount, (unsigned long)InjectedBytes,
+         (unsigned long long)(InjectNs / 1000000ULL));
+  printf("uart_rx received=%lu frames=%lu events=%lu dropped_segments=%lu overruns=%lu errors=%lu\n",
+         (unsigned long)stats.ReceivedBytes, (unsigned long)stats.Frames, (unsigned long)stats.Events,
+         (unsigned long)stats.DroppedSegments, (unsigned long)stats.Overruns, (unsigned long)stats.Errors);
+  printf("uart_rx_task bytes=%lu frames=%lu mismatches=%lu boundary_errors=%lu release_errors=%lu"
+         " lost_segments=%lu lost_bytes=%lu\n",
+         (unsigned long)RxBytes, (unsigned long)RxFrames, (unsigned long)RxMismatches,
+         (unsigned long)RxBoundaryErrors, (unsigned long)RxReleaseErrors,
+         (unsigned long)RxLostSegments, (unsigned long)RxLostBytes);
+  // 与逐字节接收中断(每字节一次)相比的中断次数, 以及中断和接收任务占用的时间
+  printf("uart_rx_load irqs=%lu irq_per_kbyte=%lu irq_ns=%llu task_ns=%llu busy_ppm=%llu\n",
+         (unsigned long)UART_SimRxInterrupts(),
+         (unsigned long)((UART_SimRxInterrupts() * 1024ULL) / InjectedBytes),
+         (unsigned long long)UART_SimRxInterruptNs(), (unsigned long long)RxTaskNs,
+         (unsigned long long)(((UART_SimRxInterruptNs() + RxTaskNs) * 1000000ULL) / InjectNs));
+
+  BENCH_FAIL_IF(RxMismatches != 0U);
+  BENCH_FAIL_IF(RxBoundaryErrors != 0U);
+  BENCH_FAIL_IF(RxReleaseErrors != 0U);
+  BENCH_FAIL_IF(stats.ReceivedBytes != InjectedBytes);
+  // 每个字节要么交给了接收任务, 要么在出错标记里报告为丢失
+  BENCH_FAIL_IF((RxBytes + RxLostBytes) != InjectedBytes);
+  BENCH_FAIL_IF(RxLostSegments > stats.Overruns);
+  BENCH_Finish();
+}
+
+int main(void)
+{
+  osThreadAttr_t attr;
+  pthread_t injector;
+
+  osKernelInitialize();
+  LOG_Init();
+  UART_SimInit(BENCH_BAUD, NULL);
+  UART_RX_Init();
+  UART_RX_Start();
+
+  memset(&attr, 0, sizeof(attr));
+  attr.stack_size = 256 * 4;
+  attr.name = "UartRx";
+  attr.priority = osPriorityAboveNormal;
+  osThreadNew(Rx_Task, NULL, &attr);
+
+  attr.name = "Monitor";
+  attr.priority = osPriorityLow;
+  osThreadNew(Monitor_Task, NULL, &attr);
+
+  pthread_create(&injector, NULL, InjectThread, NULL);
+
+  osKernelStart();
+  return 0;
+}
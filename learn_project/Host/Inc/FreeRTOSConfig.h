@@ -0,0 +1,95 @@
+/*
+ * FreeRTOS configuration for the Linux host build (GCC/Posix port).
+ *
+ * The kernel is configured exactly as it is for the STM32F103: this file
+ * includes Core/Inc/FreeRTOSConfig.h and only overrides the definitions that
+ * describe the hardware, so the host build runs the same kernel code paths as
+ * the firmware.
+ */
+
+#ifndef HOST_FREERTOS_CONFIG_H
+#define HOST_FREERTOS_CONFIG_H
+
+/* Simulated core peripherals used by cmsis_os2.c in place of stm32f1xx.h. */
+#define CMSIS_device_header "posix_device.h"
+
+#include "../../Core/Inc/FreeRTOSConfig.h"
+
+/* Pointers and stack words are twice as wide on a 64-bit host, so the target's
+8 KB heap does not hold the same set of kernel objects. */
+#undef configTOTAL_HEAP_SIZE
+#define configTOTAL_HEAP_SIZE                    ((size_t)(256 * 1024))
+
+/* Report the failing assertion and abort, rather than spinning with
+interrupts disabled as the target does. */
+#undef configASSERT
+extern void vAssertCalled( const char *pcFile, unsigned long ulLine );
+#define configASSERT( x ) if ((x) == 0) vAssertCalled( __FILE__, __LINE__ )
+
+/* The tick is generated by the port layer, not by a SysTick handler in
+cmsis_os2.c. */
+#undef USE_CUSTOM_SYSTICK_HANDLER_IMPLEMENTATION
+#define USE_CUSTOM_SYSTICK_HANDLER_IMPLEMENTATION 1
+
+#undef vPortSVCHandler
+#undef xPortPendSVHandler
+
+/* The Posix port has no low power mode, and the simulated tick is always
+running, so tickless idle and the TIM4 tick are target only.  The tickless
+timer arithmetic is simulated by Bench/tickless_sim.c instead. */
+#undef configUSE_TICKLESS_IDLE
+#define configUSE_TICKLESS_IDLE                  0
+#undef configUSE_TICKLESS_TIMER
+#define configUSE_TICKLESS_TIMER                 0
+
+/* Variant builds of the kernel (see add_kernel_variant() in CMakeLists.txt)
+switch one feature relative to the target configuration, so the benchmarks can
+compare the two.  HOST_BASELINE_* switches a feature back to the code it
+replaced; HOST_WITH_* turns on a feature the target leaves off. */
+#ifdef HOST_BASELINE_TASK_SELECTION
+	#undef configUSE_BITMAP_TASK_SELECTION
+	#define configUSE_BITMAP_TASK_SELECTION 0
+#endif
+
+#ifdef HOST_WITH_TIMING_WHEEL
+	#undef configUSE_DELAYED_TIMING_WHEEL
+	#define configUSE_DELAYED_TIMING_WHEEL 1
+#endif
+
+#ifdef HOST_WITH_TLSF_HEAP
+	#undef configUSE_TLSF_HEAP
+	#define configUSE_TLSF_HEAP 1
+#endif
+
+#ifdef HOST_WITH_QUEUE_STATISTICS
+	#undef configUSE_QUEUE_STATISTICS
+	#define configUSE_QUEUE_STATISTICS 1
+#endif
+
+#ifdef HOST_BASELINE_MUTEX_FAST_PATH
+	#undef configUSE_MUTEX_FAST_PATH
+	#define configUSE_MUTEX_FAST_PATH 0
+#endif
+
+#ifdef HOST_WITH_MUTEX_PROFILING
+	#undef configUSE_MUTEX_PROFILING
+	#define configUSE_MUTEX_PROFILING 1
+#endif
+
+#ifdef HOST_BASELINE_EVENT_GROUP_INDEX
+	#undef configUSE_EVENT_GROUP_INDEX
+	#define configUSE_EVENT_GROUP_INDEX 0
+	#undef configUSE_EVENT_GROUP_ISR_SET
+	#define configUSE_EVENT_GROUP_ISR_SET 0
+#endif
+
+#ifdef HOST_BASELINE_EVENT_GROUP_ISR_SET
+	#undef configUSE_EVENT_GROUP_ISR_SET
+	#define configUSE_EVENT_GROUP_ISR_SET 0
+#endif
+
+/* The formatted stats functions are only built on the host, so benchmarks can
+compare them with the binary interfaces the firmware uses. */
+#define configUSE_STATS_FORMATTING_FUNCTIONS     1
+
+#endif /* HOST_FREERTOS_CONFIG_H */
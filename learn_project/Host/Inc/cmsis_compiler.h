@@ -0,0 +1,53 @@
+/*
+ * Compiler definitions used by cmsis_os2.c on the Linux host.
+ *
+ * Replaces Drivers/CMSIS/Include/cmsis_compiler.h, which pulls in Cortex-M
+ * intrinsics that cannot be built for the host.  The include guard is the one
+ * used by CMSIS, so only one of the two files is ever seen.
+ */
+
+#ifndef __CMSIS_COMPILER_H
+#define __CMSIS_COMPILER_H
+
+#include <stdint.h>
+
+#ifndef   __ASM
+  #define __ASM                                  __asm
+#endif
+#ifndef   __INLINE
+  #define __INLINE                               inline
+#endif
+#ifndef   __STATIC_INLINE
+  #define __STATIC_INLINE                        static inline
+#endif
+#ifndef   __STATIC_FORCEINLINE
+  #define __STATIC_FORCEINLINE                   __attribute__((always_inline)) static inline
+#endif
+#ifndef   __NO_RETURN
+  #define __NO_RETURN                            __attribute__((__noreturn__))
+#endif
+#ifndef   __USED
+  #define __USED                                 __attribute__((used))
+#endif
+#ifndef   __WEAK
+  #define __WEAK                                 __attribute__((weak))
+#endif
+#ifndef   __PACKED
+  #define __PACKED                               __attribute__((packed, aligned(1)))
+#endif
+#ifndef   __ALIGNED
+  #define __ALIGNED(x)                           __attribute__((aligned(x)))
+#endif
+#ifndef   __RESTRICT
+  #define __RESTRICT                             __restrict
+#endif
+
+/* Used by the lock-free ISR-to-task channels.  Only one task thread runs at
+   a time and simulated interrupts run on that thread, with every hand-over
+   between threads going through the port's pthread synchronisation, so as on
+   the single core target only the compiler has to be kept from reordering. */
+#ifndef   __DMB
+  #define __DMB()                                __asm volatile ("" ::: "memory")
+#endif
+
+#endif /* __CMSIS_COMPILER_H */
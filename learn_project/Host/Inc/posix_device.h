@@ -0,0 +1,56 @@
+/*
+ * Simulated core peripherals for the Linux host build.
+ *
+ * Stands in for stm32f1xx.h (the CMSIS_device_header) so cmsis_os2.c builds
+ * unchanged.  Interrupt state is taken from the GCC/Posix port layer.
+ */
+
+#ifndef POSIX_DEVICE_H
+#define POSIX_DEVICE_H
+
+#include <stdint.h>
+#include "cmsis_compiler.h"
+#include "FreeRTOS.h"
+
+typedef int32_t IRQn_Type;
+
+/* SysTick register block.  The tick is generated by the port layer, so the
+counter never moves; LOAD is set up so osKernelGetSysTimerCount() advances by
+one tick period per tick. */
+typedef struct
+{
+  volatile uint32_t CTRL;
+  volatile uint32_t LOAD;
+  volatile uint32_t VAL;
+  volatile uint32_t CALIB;
+} SysTick_Type;
+
+extern SysTick_Type xHostSysTick;
+#define SysTick (&xHostSysTick)
+
+__STATIC_INLINE uint32_t __get_IPSR (void) {
+  return ((xPortIsInsideInterrupt() != pdFALSE) ? 1U : 0U);
+}
+
+__STATIC_INLINE uint32_t __get_PRIMASK (void) {
+  return ((xPortInterruptsMasked() != pdFALSE) ? 1U : 0U);
+}
+
+__STATIC_INLINE uint32_t __get_BASEPRI (void) {
+  return (__get_PRIMASK());
+}
+
+__STATIC_INLINE void __disable_irq (void) {
+  vPortDisableInterrupts();
+}
+
+__STATIC_INLINE void __enable_irq (void) {
+  vPortEnableInterrupts();
+}
+
+__STATIC_INLINE void NVIC_SetPriority (IRQn_Type IRQn, uint32_t priority) {
+  (void)IRQn;
+  (void)priority;
+}
+
+#endif /* POSIX_DEVICE_H */
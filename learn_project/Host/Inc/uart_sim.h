@@ -0,0 +1,47 @@
+/*
+ * Simulated USART1 and its DMA channels for the host build.
+ *
+ * Stands in for the HAL_UART_Transmit_DMA()/HAL_UART_TxCpltCallback() path
+ * used by uart_log.c on the target.  A pthread plays the part of the
+ * peripheral: it holds each transfer for the time the bytes would take on the
+ * wire, hands them to a sink, then raises the transfer complete interrupt
+ * through the Posix port.
+ *
+ * The receive side stands in for HAL_UARTEx_ReceiveToIdle_DMA() in circular
+ * mode as used by uart_rx.c.  Bytes passed to UART_SimRxInject() are written
+ * into the receive buffer at the rate they would arrive on the wire, raising
+ * the half transfer, transfer complete and idle line interrupts where the
+ * hardware would.
+ */
+
+#ifndef UART_SIM_H
+#define UART_SIM_H
+
+#include <stdint.h>
+
+/* Simulated interrupt number of the DMA1_Channel4 (USART1_TX) transfer
+complete interrupt. */
+#define UART_SIM_TX_IRQ     4U
+
+/* Simulated interrupt number shared by the DMA1_Channel5 (USART1_RX) half and
+full transfer interrupts and the USART1 idle line interrupt. */
+#define UART_SIM_RX_IRQ     5U
+
+typedef void (*UART_SimSink_t)(const uint8_t *data, uint32_t len);
+
+/* baud = 0 completes every transfer immediately. */
+void UART_SimInit(uint32_t baud, UART_SimSink_t sink);
+uint32_t UART_SimTxBytes(void);
+uint32_t UART_SimTxTransfers(void);
+
+/* Play len bytes onto the receive line back to back, then hold the line idle
+for idleBits bit times.  An idle period of at least one character (10 bits)
+raises the idle line interrupt.  Returns once the line time has elapsed.  Must
+be called from a thread that is not a FreeRTOS task and that has all signals
+blocked.  Receive timing is kept against an absolute clock, so consecutive
+calls do not drift. */
+void UART_SimRxInject(const uint8_t *data, uint32_t len, uint32_t idleBits);
+uint32_t UART_SimRxInterrupts(void);
+uint64_t UART_SimRxInterruptNs(void);
+
+#endif /* UART_SIM_H */
@@ -0,0 +1,108 @@
+/**
+ ******************************************************************************
+ * @file    posix_demo.c
+ * @brief   主机(Linux)上运行的 FreeRTOS 示例
+ *
+ * 用 CMSIS-RTOS2 接口创建生产者/消费者任务和一个周期定时器, 运行一秒后
+ * 打印统计并结束调度器, 用来确认内核在 POSIX 移植层上工作正常.
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+
+#include "cmsis_os2.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+#define DEMO_RUN_TIME_MS 1000U
+
+static osMessageQueueId_t DemoQueueHandle;
+static volatile uint32_t ulProduced;
+static volatile uint32_t ulConsumed;
+static volatile uint32_t ulTimerFired;
+
+static const osThreadAttr_t Producer_attributes = {
+    .name = "Producer",
+    .stack_size = 256 * 4,
+    .priority = (osPriority_t)osPriorityNormal,
+};
+
+static const osThreadAttr_t Consumer_attributes = {
+    .name = "Consumer",
+    .stack_size = 256 * 4,
+    .priority = (osPriority_t)osPriorityAboveNormal,
+};
+
+static const osThreadAttr_t Monitor_attributes = {
+    .name = "Monitor",
+    .stack_size = 256 * 4,
+    .priority = (osPriority_t)osPriorityHigh,
+};
+
+static void Producer_Task(void *argument)
+{
+  uint32_t value = 0;
+
+  for (;;)
+  {
+    if (osMessageQueuePut(DemoQueueHandle, &value, 0U, osWaitForever) == osOK)
+    {
+      value++;
+      ulProduced++;
+    }
+    // 每发一批让出一个节拍, 让低优先级的定时器任务也能运行
+    if ((value % 64U) == 0U)
+    {
+      osDelay(1);
+    }
+  }
+}
+
+static void Consumer_Task(void *argument)
+{
+  uint32_t value;
+
+  for (;;)
+  {
+    if (osMessageQueueGet(DemoQueueHandle, &value, NULL, osWaitForever) == osOK)
+    {
+      // 消费者优先级更高, 每条消息都会触发一次任务切换
+      ulConsumed++;
+    }
+  }
+}
+
+static void Demo_TimerCallback(void *argument)
+{
+  ulTimerFired++;
+}
+
+static void Monitor_Task(void *argument)
+{
+  osDelay(DEMO_RUN_TIME_MS);
+
+  printf("tick=%lu produced=%lu consumed=%lu timer=%lu\n",
+         (unsigned long)osKernelGetTickCount(), (unsigned long)ulProduced,
+         (unsigned long)ulConsumed, (unsigned long)ulTimerFired);
+  vTaskEndScheduler();
+}
+
+int main(void)
+{
+  osTimerId_t timer;
+
+  osKernelInitialize();
+
+  DemoQueueHandle = osMessageQueueNew(8, sizeof(uint32_t), NULL);
+  timer = osTimerNew(Demo_TimerCallback, osTimerPeriodic, NULL, NULL);
+  osTimerStart(timer, 10U);
+
+  osThreadNew(Producer_Task, NULL, &Producer_attributes);
+  osThreadNew(Consumer_Task, NULL, &Consumer_attributes);
+  osThreadNew(Monitor_Task, NULL, &Monitor_attributes);
+
+  osKernelStart();
+
+  // 调度器结束后才会回到这里
+  return ((ulConsumed > 0U) && (ulTimerFired > 0U)) ? 0 : 1;
+}
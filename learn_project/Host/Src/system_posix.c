@@ -0,0 +1,48 @@
+/*
+ * System definitions for the Linux host build: the globals that
+ * system_stm32f1xx.c and the CMSIS core provide on the target.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "FreeRTOS.h"
+#include "posix_device.h"
+
+/* Same core clock as SystemClock_Config() sets up on the target (HSE x 9). */
+#define HOST_CORE_CLOCK_HZ  72000000UL
+
+uint32_t SystemCoreClock = HOST_CORE_CLOCK_HZ;
+
+SysTick_Type xHostSysTick = {
+  .CTRL  = 0x7U,
+  .LOAD  = (HOST_CORE_CLOCK_HZ / configTICK_RATE_HZ) - 1UL,
+  .VAL   = 0U,
+  .CALIB = 0U
+};
+
+void vAssertCalled(const char *pcFile, unsigned long ulLine)
+{
+  fprintf(stderr, "configASSERT failed: %s:%lu\n", pcFile, ulLine);
+  abort();
+}
+
+/* Run time stats clock: CLOCK_MONOTONIC in nanoseconds.  It is already 64 bits
+wide, so unlike the DWT counter on the target it needs no wrap tracking and the
+tick hook has nothing to do. */
+void configureTimerForRunTimeStats(void)
+{
+}
+
+uint64_t getRunTimeCounterValue(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+void vApplicationTickHook(void)
+{
+}
@@ -0,0 +1,330 @@
+/*
+ * Simulated USART1 and its DMA channels for the host build.  See uart_sim.h.
+ */
+
+#include <pthread.h>
+#include <signal.h>
+#include <time.h>
+
+#include "FreeRTOS.h"
+#include "uart_log.h"
+#include "uart_rx.h"
+#include "uart_sim.h"
+
+/* Receive status bits, as the DMA ISR and USART SR would report them. */
+#define SIM_RX_HT           0x01U
+#define SIM_RX_TC           0x02U
+
+/* Idle events not yet seen by the interrupt handler. */
+#define SIM_RX_IDLE_QUEUE   16U
+
+/* Receive line time is advanced in chunks of at most this many bytes. */
+#define SIM_RX_CHUNK        16U
+
+static pthread_mutex_t SimMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t SimCond = PTHREAD_COND_INITIALIZER;
+static pthread_t SimThread;
+
+static uint32_t SimBaud;
+static UART_SimSink_t SimSink;
+
+static const uint8_t *TxData;
+static uint16_t TxLen;
+static int TxBusy;
+static volatile uint32_t TxBytes;
+static volatile uint32_t TxTransfers;
+
+static uint8_t *RxBuf;
+static uint16_t RxSize;
+static uint16_t RxPos;
+static uint32_t RxStatus;
+static uint32_t RxHalves;
+static uint32_t RxHalvesReported;
+static uint16_t RxIdlePos[SIM_RX_IDLE_QUEUE];
+static uint32_t RxIdleHalves[SIM_RX_IDLE_QUEUE];
+static uint32_t RxIdleHead;
+static uint32_t RxIdleTail;
+static uint64_t RxClockNs;
+static volatile uint32_t RxInterrupts;
+static volatile uint64_t RxInterruptNs;
+
+static void SimSleepNs(uint64_t ns)
+{
+  struct timespec ts;
+
+  ts.tv_sec = (time_t)(ns / 1000000000ULL);
+  ts.tv_nsec = (long)(ns % 1000000000ULL);
+  while (nanosleep(&ts, &ts) != 0)
+  {
+  }
+}
+
+static uint64_t SimNowNs(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+static void SimSleepUntilNs(uint64_t deadline)
+{
+  struct timespec ts;
+
+  ts.tv_sec = (time_t)(deadline / 1000000000ULL);
+  ts.tv_nsec = (long)(deadline % 1000000000ULL);
+  while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) != 0)
+  {
+  }
+}
+
+static uint64_t SimLineNs(uint32_t bits)
+{
+  return (SimBaud != 0U) ? (((uint64_t)bits * 1000000000ULL) / SimBaud) : 0U;
+}
+
+// DMA1_Channel4 发送完成中断
+static uint32_t SimTxIRQHandler(void)
+{
+  LOG_TxCpltCallback();
+  return pdFALSE;
+}
+
+// DMA1_Channel5 半满/全满中断和 USART1 空闲线中断
+static uint32_t SimRxIRQHandler(void)
+{
+  uint16_t idlePos[SIM_RX_IDLE_QUEUE];
+  uint32_t idleHalves[SIM_RX_IDLE_QUEUE];
+  uint32_t idleCount = 0;
+  uint32_t halves;
+  uint32_t status;
+  uint16_t pos;
+  uint64_t start;
+  uint32_t i;
+
+  start = SimNowNs();
+
+  pthread_mutex_lock(&SimMutex);
+  while (RxIdleTail != RxIdleHead)
+  {
+    idlePos[idleCount] = RxIdlePos[RxIdleTail % SIM_RX_IDLE_QUEUE];
+    idleHalves[idleCount] = RxIdleHalves[RxIdleTail % SIM_RX_IDLE_QUEUE];
+    idleCount++;
+    RxIdleTail++;
+  }
+  status = RxStatus;
+  RxStatus = 0U;
+  pos = RxPos;
+  halves = RxHalves;
+  pthread_mutex_unlock(&SimMutex);
+
+  // 空闲线事件按发生时的写入位置依次报告, 之后到达的字节由最后一次报告送出.
+  // 每次报告带上这之前越过一半/末尾的次数, 中断晚到时可能不止一次
+  for (i = 0; i < idleCount; i++)
+  {
+    UART_RX_EventCallback(idlePos[i], 1U, idleHalves[i] - RxHalvesReported);
+    RxHalvesReported = idleHalves[i];
+  }
+  if ((status != 0U) || ((idleCount > 0U) && (pos != idlePos[idleCount - 1U])))
+  {
+    UART_RX_EventCallback(pos, 0U, halves - RxHalvesReported);
+    RxHalvesReported = halves;
+  }
+
+  RxInterrupts++;
+  RxInterruptNs += SimNowNs() - start;
+
+  return pdFALSE;
+}
+
+// 模拟外设: 按波特率占用时间后把数据交给 sink, 再产生发送完成中断
+static void *SimThreadEntry(void *argument)
+{
+  const uint8_t *data;
+  uint16_t len;
+  sigset_t signals;
+
+  (void)argument;
+
+  // 外设线程不能接收节拍和模拟中断信号, 它们只能由正在运行的任务线程处理
+  sigfillset(&signals);
+  pthread_sigmask(SIG_BLOCK, &signals, NULL);
+
+  for (;;)
+  {
+    pthread_mutex_lock(&SimMutex);
+    while (TxBusy == 0)
+    {
+      pthread_cond_wait(&SimCond, &SimMutex);
+    }
+    data = TxData;
+    len = TxLen;
+    pthread_mutex_unlock(&SimMutex);
+
+    // 8N1: 每字节10位
+    if (SimBaud != 0U)
+    {
+      SimSleepNs(((uint64_t)len * 10ULL * 1000000000ULL) / SimBaud);
+    }
+
+    if (SimSink != NULL)
+    {
+      SimSink(data, len);
+    }
+    TxBytes += len;
+    TxTransfers++;
+
+    pthread_mutex_lock(&SimMutex);
+    TxBusy = 0;
+    pthread_mutex_unlock(&SimMutex);
+
+    vPortGenerateSimulatedInterrupt(UART_SIM_TX_IRQ);
+  }
+
+  return NULL;
+}
+
+void UART_SimInit(uint32_t baud, UART_SimSink_t sink)
+{
+  SimBaud = baud;
+  SimSink = sink;
+  vPortSetInterruptHandler(UART_SIM_TX_IRQ, SimTxIRQHandler);
+  vPortSetInterruptHandler(UART_SIM_RX_IRQ, SimRxIRQHandler);
+  pthread_create(&SimThread, NULL, SimThreadEntry, NULL);
+}
+
+uint32_t UART_SimTxBytes(void)
+{
+  return TxBytes;
+}
+
+uint32_t UART_SimTxTransfers(void)
+{
+  return TxTransfers;
+}
+
+// 与目标板上 usart.c 中的实现对应: 相当于 HAL_UART_Transmit_DMA
+int LOG_PortStartTransmit(const uint8_t *data, uint16_t len)
+{
+  int ret = -1;
+
+  pthread_mutex_lock(&SimMutex);
+  if (TxBusy == 0)
+  {
+    TxData = data;
+    TxLen = len;
+    TxBusy = 1;
+    pthread_cond_signal(&SimCond);
+    ret = 0;
+  }
+  pthread_mutex_unlock(&SimMutex);
+
+  return ret;
+}
+
+// 与目标板上 usart.c 中的实现对应: 相当于循环模式的 HAL_UARTEx_ReceiveToIdle_DMA
+int UART_RX_PortStartReceive(uint8_t *buf, uint16_t size)
+{
+  pthread_mutex_lock(&SimMutex);
+  RxBuf = buf;
+  RxSize = size;
+  RxPos = 0U;
+  RxStatus = 0U;
+  RxHalvesReported = RxHalves;
+  RxIdleTail = RxIdleHead;
+  pthread_mutex_unlock(&SimMutex);
+
+  return 0;
+}
+
+// DMA 写入一段数据, 越过缓冲区一半或末尾时置位相应的中断标志
+static uint32_t SimRxWrite(const uint8_t *data, uint32_t len)
+{
+  uint32_t raised = 0;
+  uint32_t half;
+  uint32_t i;
+
+  pthread_mutex_lock(&SimMutex);
+  if (RxBuf != NULL)
+  {
+    half = RxSize / 2U;
+    for (i = 0; i < len; i++)
+    {
+      RxBuf[RxPos++] = data[i];
+      if (RxPos == half)
+      {
+        RxStatus |= SIM_RX_HT;
+        RxHalves++;
+        raised = 1U;
+      }
+      else if (RxPos == RxSize)
+      {
+        RxPos = 0U;
+        RxStatus |= SIM_RX_TC;
+        RxHalves++;
+        raised = 1U;
+      }
+    }
+  }
+  pthread_mutex_unlock(&SimMutex);
+
+  return raised;
+}
+
+void UART_SimRxInject(const uint8_t *data, uint32_t len, uint32_t idleBits)
+{
+  uint64_t now = SimNowNs();
+  uint32_t chunk;
+
+  // 线路空闲了一段时间后, 从现在开始计时
+  if (RxClockNs < now)
+  {
+    RxClockNs = now;
+  }
+
+  while (len > 0U)
+  {
+    chunk = (len > SIM_RX_CHUNK) ? SIM_RX_CHUNK : len;
+    RxClockNs += SimLineNs(chunk * 10U);
+    SimSleepUntilNs(RxClockNs);
+
+    if (SimRxWrite(data, chunk) != 0U)
+    {
+      vPortGenerateSimulatedInterrupt(UART_SIM_RX_IRQ);
+    }
+    data += chunk;
+    len -= chunk;
+  }
+
+  // 空闲一个字符时间后产生空闲线中断
+  if (idleBits >= 10U)
+  {
+    RxClockNs += SimLineNs(10U);
+    SimSleepUntilNs(RxClockNs);
+
+    pthread_mutex_lock(&SimMutex);
+    // 中断一直没有得到处理时丢弃新的空闲事件, 相当于两帧合并
+    if ((RxBuf != NULL) && ((RxIdleHead - RxIdleTail) < SIM_RX_IDLE_QUEUE))
+    {
+      RxIdlePos[RxIdleHead % SIM_RX_IDLE_QUEUE] = RxPos;
+      RxIdleHalves[RxIdleHead % SIM_RX_IDLE_QUEUE] = RxHalves;
+      RxIdleHead++;
+    }
+    pthread_mutex_unlock(&SimMutex);
+    vPortGenerateSimulatedInterrupt(UART_SIM_RX_IRQ);
+
+    idleBits -= 10U;
+  }
+  RxClockNs += SimLineNs(idleBits);
+  SimSleepUntilNs(RxClockNs);
+}
+
+uint32_t UART_SimRxInterrupts(void)
+{
+  return RxInterrupts;
+}
+
+uint64_t UART_SimRxInterruptNs(void)
+{
+  return RxInterruptNs;
+}
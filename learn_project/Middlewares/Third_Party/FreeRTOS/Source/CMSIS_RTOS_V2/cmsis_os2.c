@@ -29,6 +29,10 @@
 #include "task.h"                       // ARM.FreeRTOS::RTOS:Core
 #include "event_groups.h"               // ARM.FreeRTOS::RTOS:Event Groups
 #include "semphr.h"                     // ARM.FreeRTOS::RTOS:Core
+#include "rwlock.h"                     // Read/write locks
+#if (configUSE_64_BIT_EVENT_GROUPS == 1)
+#include "event_groups64.h"             // 64-bit event groups
+#endif
 
 #include "freertos_mpool.h"             // osMemoryPool definitions
 #include "freertos_os2.h"               // Configuration check and setup
@@ -86,6 +90,18 @@
 #define THREAD_FLAGS_INVALID_BITS (~((1UL << MAX_BITS_TASK_NOTIFY)  - 1U))
 #define EVENT_FLAGS_INVALID_BITS  (~((1UL << MAX_BITS_EVENT_GROUPS) - 1U))
 
+#if (configUSE_64_BIT_EVENT_GROUPS == 1)
+#define MAX_BITS_EVENT_GROUPS64   56U
+#define MAX_BITS_EVENT_FLAGS_WIDE 31U
+
+#define EVENT_FLAGS64_INVALID_BITS    (~((1ULL << MAX_BITS_EVENT_GROUPS64)   - 1U))
+#define EVENT_FLAGS_WIDE_INVALID_BITS (~((1UL  << MAX_BITS_EVENT_FLAGS_WIDE) - 1U))
+
+/* Event flags IDs of 64-bit event groups have the low bit set */
+#define EVENT_FLAGS_IS_WIDE(ef_id)    (((uintptr_t)(ef_id) & 1U) != 0U)
+#define EVENT_FLAGS_WIDE_HANDLE(ef_id) ((EventGroup64Handle_t)((uintptr_t)(ef_id) & ~(uintptr_t)1U))
+#endif
+
 /* Kernel version and identification string definition (major.minor.rev: mmnnnrrrr dec) */
 #define KERNEL_VERSION            (((uint32_t)tskKERNEL_VERSION_MAJOR * 10000000UL) | \
                                    ((uint32_t)tskKERNEL_VERSION_MINOR *    10000UL) | \
@@ -396,6 +412,25 @@ uint32_t osKernelGetTickFreq (void) {
   return (configTICK_RATE_HZ);
 }
 
+#if (configUSE_TICKLESS_TIMER == 1)
+/* The tick is generated by the tickless timer (see port.c), not the SysTick.
+   The count since the last tick already includes a tick that is pending. */
+
+/* Get OS Tick count value */
+static uint32_t OS_Tick_GetCount (void) {
+  return (ulPortTicklessTimerCountsSinceTick());
+}
+
+/* Get OS Tick overflow status */
+static uint32_t OS_Tick_GetOverflow (void) {
+  return (0U);
+}
+
+/* Get OS Tick interval */
+static uint32_t OS_Tick_GetInterval (void) {
+  return (configTICKLESS_TIMER_HZ / configTICK_RATE_HZ);
+}
+#else
 /* Get OS Tick count value */
 static uint32_t OS_Tick_GetCount (void) {
   uint32_t load = SysTick->LOAD;
@@ -411,6 +446,7 @@ static uint32_t OS_Tick_GetOverflow (void) {
 static uint32_t OS_Tick_GetInterval (void) {
   return (SysTick->LOAD + 1U);
 }
+#endif /* configUSE_TICKLESS_TIMER */
 
 uint32_t osKernelGetSysTimerCount (void) {
   uint32_t irqmask = IS_IRQ_MASKED();
@@ -436,7 +472,11 @@ uint32_t osKernelGetSysTimerCount (void) {
 }
 
 uint32_t osKernelGetSysTimerFreq (void) {
+#if (configUSE_TICKLESS_TIMER == 1)
+  return (configTICKLESS_TIMER_HZ);
+#else
   return (configCPU_CLOCK_HZ);
+#endif
 }
 
 /*---------------------------------------------------------------------------*/
@@ -1109,15 +1149,29 @@ osStatus_t osTimerDelete (osTimerId_t timer_id) {
 
 osEventFlagsId_t osEventFlagsNew (const osEventFlagsAttr_t *attr) {
   EventGroupHandle_t hEventGroup;
+  uint32_t wide;
+  uint32_t cb_min;
   int32_t mem;
+  #if (configUSE_64_BIT_EVENT_GROUPS == 1)
+  EventGroup64Handle_t hEventGroup64;
+  #endif
 
   hEventGroup = NULL;
 
   if (!IS_IRQ()) {
     mem = -1;
+    wide = 0U;
+    cb_min = sizeof(StaticEventGroup_t);
 
     if (attr != NULL) {
-      if ((attr->cb_mem != NULL) && (attr->cb_size >= sizeof(StaticEventGroup_t))) {
+      if ((attr->attr_bits & osEventFlagsWide) != 0U) {
+        wide = 1U;
+        #if (configUSE_64_BIT_EVENT_GROUPS == 1)
+        cb_min = sizeof(StaticEventGroup64_t);
+        #endif
+      }
+
+      if ((attr->cb_mem != NULL) && (attr->cb_size >= cb_min)) {
         mem = 1;
       }
       else {
@@ -1130,7 +1184,30 @@ osEventFlagsId_t osEventFlagsNew (const osEventFlagsAttr_t *attr) {
       mem = 0;
     }
 
-    if (mem == 1) {
+    if (wide != 0U) {
+      /* Without configUSE_64_BIT_EVENT_GROUPS no wide event flags can be created */
+      #if (configUSE_64_BIT_EVENT_GROUPS == 1)
+      hEventGroup64 = NULL;
+
+      if (mem == 1) {
+        #if (configSUPPORT_STATIC_ALLOCATION == 1)
+        hEventGroup64 = xEventGroup64CreateStatic (attr->cb_mem);
+        #endif
+      }
+      else {
+        if (mem == 0) {
+          #if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
+            hEventGroup64 = xEventGroup64Create();
+          #endif
+        }
+      }
+
+      if (hEventGroup64 != NULL) {
+        hEventGroup = (EventGroupHandle_t)((uintptr_t)hEventGroup64 | 1U);
+      }
+      #endif
+    }
+    else if (mem == 1) {
       #if (configSUPPORT_STATIC_ALLOCATION == 1)
       hEventGroup = xEventGroupCreateStatic (attr->cb_mem);
       #endif
@@ -1147,11 +1224,49 @@ osEventFlagsId_t osEventFlagsNew (const osEventFlagsAttr_t *attr) {
   return ((osEventFlagsId_t)hEventGroup);
 }
 
+#if (configUSE_64_BIT_EVENT_GROUPS == 1)
+/*
+  The uint32_t event flags functions reach flags 0..30 of wide event flags, bit 31
+  of their result being kept for error codes. Flags they cannot reach are passed
+  on as invalid bits, so the 64-bit function returns osFlagsErrorParameter.
+*/
+static uint64_t EventFlagsWiden (uint32_t flags) {
+  uint64_t wflags;
+
+  if ((flags & EVENT_FLAGS_WIDE_INVALID_BITS) != 0U) {
+    wflags = EVENT_FLAGS64_INVALID_BITS;
+  } else {
+    wflags = flags;
+  }
+
+  return (wflags);
+}
+
+static uint32_t EventFlagsNarrow (uint64_t flags) {
+  uint32_t rflags;
+
+  if ((flags & EVENT_FLAGS64_INVALID_BITS) != 0U) {
+    /* Error code sign extended to 64 bits */
+    rflags = (uint32_t)flags;
+  } else {
+    rflags = (uint32_t)flags & ~EVENT_FLAGS_WIDE_INVALID_BITS;
+  }
+
+  return (rflags);
+}
+#endif /* (configUSE_64_BIT_EVENT_GROUPS == 1) */
+
 uint32_t osEventFlagsSet (osEventFlagsId_t ef_id, uint32_t flags) {
   EventGroupHandle_t hEventGroup = (EventGroupHandle_t)ef_id;
   uint32_t rflags;
   BaseType_t yield;
 
+#if (configUSE_64_BIT_EVENT_GROUPS == 1)
+  if (EVENT_FLAGS_IS_WIDE(ef_id)) {
+    return (EventFlagsNarrow (osEventFlagsSet64 (ef_id, EventFlagsWiden (flags))));
+  }
+#endif
+
   if ((hEventGroup == NULL) || ((flags & EVENT_FLAGS_INVALID_BITS) != 0U)) {
     rflags = (uint32_t)osErrorParameter;
   }
@@ -1182,6 +1297,12 @@ uint32_t osEventFlagsClear (osEventFlagsId_t ef_id, uint32_t flags) {
   EventGroupHandle_t hEventGroup = (EventGroupHandle_t)ef_id;
   uint32_t rflags;
 
+#if (configUSE_64_BIT_EVENT_GROUPS == 1)
+  if (EVENT_FLAGS_IS_WIDE(ef_id)) {
+    return (EventFlagsNarrow (osEventFlagsClear64 (ef_id, EventFlagsWiden (flags))));
+  }
+#endif
+
   if ((hEventGroup == NULL) || ((flags & EVENT_FLAGS_INVALID_BITS) != 0U)) {
     rflags = (uint32_t)osErrorParameter;
   }
@@ -1208,6 +1329,12 @@ uint32_t osEventFlagsGet (osEventFlagsId_t ef_id) {
   EventGroupHandle_t hEventGroup = (EventGroupHandle_t)ef_id;
   uint32_t rflags;
 
+#if (configUSE_64_BIT_EVENT_GROUPS == 1)
+  if (EVENT_FLAGS_IS_WIDE(ef_id)) {
+    return (EventFlagsNarrow (osEventFlagsGet64 (ef_id)));
+  }
+#endif
+
   if (ef_id == NULL) {
     rflags = 0U;
   }
@@ -1227,6 +1354,12 @@ uint32_t osEventFlagsWait (osEventFlagsId_t ef_id, uint32_t flags, uint32_t opti
   BaseType_t exit_clr;
   uint32_t rflags;
 
+#if (configUSE_64_BIT_EVENT_GROUPS == 1)
+  if (EVENT_FLAGS_IS_WIDE(ef_id)) {
+    return (EventFlagsNarrow (osEventFlagsWait64 (ef_id, EventFlagsWiden (flags), options, timeout)));
+  }
+#endif
+
   if ((hEventGroup == NULL) || ((flags & EVENT_FLAGS_INVALID_BITS) != 0U)) {
     rflags = (uint32_t)osErrorParameter;
   }
@@ -1282,6 +1415,12 @@ osStatus_t osEventFlagsDelete (osEventFlagsId_t ef_id) {
   else if (hEventGroup == NULL) {
     stat = osErrorParameter;
   }
+#if (configUSE_64_BIT_EVENT_GROUPS == 1)
+  else if (EVENT_FLAGS_IS_WIDE(ef_id)) {
+    stat = osOK;
+    vEventGroup64Delete (EVENT_FLAGS_WIDE_HANDLE(ef_id));
+  }
+#endif
   else {
     stat = osOK;
     vEventGroupDelete (hEventGroup);
@@ -1293,6 +1432,117 @@ osStatus_t osEventFlagsDelete (osEventFlagsId_t ef_id) {
   return (stat);
 }
 
+#if (configUSE_64_BIT_EVENT_GROUPS == 1)
+uint64_t osEventFlagsSet64 (osEventFlagsId_t ef_id, uint64_t flags) {
+  EventGroup64Handle_t hEventGroup = EVENT_FLAGS_WIDE_HANDLE(ef_id);
+  uint64_t rflags;
+  BaseType_t yield;
+
+  if (!EVENT_FLAGS_IS_WIDE(ef_id) || ((flags & EVENT_FLAGS64_INVALID_BITS) != 0U)) {
+    rflags = osFlagsError64(osFlagsErrorParameter);
+  }
+  else if (IS_IRQ()) {
+    yield = pdFALSE;
+
+    if (xEventGroup64SetBitsFromISR (hEventGroup, flags, &yield) == pdFAIL) {
+      rflags = osFlagsError64(osFlagsErrorResource);
+    } else {
+      rflags = flags;
+      portYIELD_FROM_ISR (yield);
+    }
+  }
+  else {
+    rflags = xEventGroup64SetBits (hEventGroup, flags);
+  }
+
+  return (rflags);
+}
+
+uint64_t osEventFlagsClear64 (osEventFlagsId_t ef_id, uint64_t flags) {
+  EventGroup64Handle_t hEventGroup = EVENT_FLAGS_WIDE_HANDLE(ef_id);
+  uint64_t rflags;
+
+  if (!EVENT_FLAGS_IS_WIDE(ef_id) || ((flags & EVENT_FLAGS64_INVALID_BITS) != 0U)) {
+    rflags = osFlagsError64(osFlagsErrorParameter);
+  }
+  else if (IS_IRQ()) {
+    rflags = xEventGroup64ClearBitsFromISR (hEventGroup, flags);
+  }
+  else {
+    rflags = xEventGroup64ClearBits (hEventGroup, flags);
+  }
+
+  return (rflags);
+}
+
+uint64_t osEventFlagsGet64 (osEventFlagsId_t ef_id) {
+  EventGroup64Handle_t hEventGroup = EVENT_FLAGS_WIDE_HANDLE(ef_id);
+  uint64_t rflags;
+
+  if (!EVENT_FLAGS_IS_WIDE(ef_id)) {
+    rflags = 0U;
+  }
+  else if (IS_IRQ()) {
+    rflags = xEventGroup64GetBitsFromISR (hEventGroup);
+  }
+  else {
+    rflags = xEventGroup64GetBits (hEventGroup);
+  }
+
+  return (rflags);
+}
+
+uint64_t osEventFlagsWait64 (osEventFlagsId_t ef_id, uint64_t flags, uint32_t options, uint32_t timeout) {
+  EventGroup64Handle_t hEventGroup = EVENT_FLAGS_WIDE_HANDLE(ef_id);
+  BaseType_t wait_all;
+  BaseType_t exit_clr;
+  uint64_t rflags;
+
+  if (!EVENT_FLAGS_IS_WIDE(ef_id) || (flags == 0U) || ((flags & EVENT_FLAGS64_INVALID_BITS) != 0U)) {
+    rflags = osFlagsError64(osFlagsErrorParameter);
+  }
+  else if (IS_IRQ()) {
+    rflags = osFlagsError64(osFlagsErrorISR);
+  }
+  else {
+    if (options & osFlagsWaitAll) {
+      wait_all = pdTRUE;
+    } else {
+      wait_all = pdFAIL;
+    }
+
+    if (options & osFlagsNoClear) {
+      exit_clr = pdFAIL;
+    } else {
+      exit_clr = pdTRUE;
+    }
+
+    rflags = xEventGroup64WaitBits (hEventGroup, flags, exit_clr, wait_all, (TickType_t)timeout);
+
+    if (options & osFlagsWaitAll) {
+      if ((flags & rflags) != flags) {
+        if (timeout > 0U) {
+          rflags = osFlagsError64(osFlagsErrorTimeout);
+        } else {
+          rflags = osFlagsError64(osFlagsErrorResource);
+        }
+      }
+    }
+    else {
+      if ((flags & rflags) == 0U) {
+        if (timeout > 0U) {
+          rflags = osFlagsError64(osFlagsErrorTimeout);
+        } else {
+          rflags = osFlagsError64(osFlagsErrorResource);
+        }
+      }
+    }
+  }
+
+  return (rflags);
+}
+#endif /* (configUSE_64_BIT_EVENT_GROUPS == 1) */
+
 /*---------------------------------------------------------------------------*/
 #if (configUSE_OS2_MUTEX == 1)
 
@@ -1300,6 +1550,7 @@ osMutexId_t osMutexNew (const osMutexAttr_t *attr) {
   SemaphoreHandle_t hMutex;
   uint32_t type;
   uint32_t rmtx;
+  uint32_t ceil;
   int32_t  mem;
   #if (configQUEUE_REGISTRY_SIZE > 0)
   const char *name;
@@ -1320,7 +1571,20 @@ osMutexId_t osMutexNew (const osMutexAttr_t *attr) {
       rmtx = 0U;
     }
 
-    if ((type & osMutexRobust) != osMutexRobust) {
+    ceil = 0U;
+    if ((type & osMutexPrioCeiling) == osMutexPrioCeiling) {
+      #if (configUSE_MUTEX_CEILING == 1)
+        ceil = (type >> 8) & 0xFFU;
+        if (ceil == 0U) {
+          /* A ceiling of osPriorityNone is not valid */
+          ceil = (uint32_t)configMAX_PRIORITIES;
+        }
+      #else
+        ceil = (uint32_t)configMAX_PRIORITIES;
+      #endif
+    }
+
+    if (((type & osMutexRobust) != osMutexRobust) && (ceil < (uint32_t)configMAX_PRIORITIES)) {
       mem = -1;
 
       if (attr != NULL) {
@@ -1363,6 +1627,12 @@ osMutexId_t osMutexNew (const osMutexAttr_t *attr) {
         }
       }
 
+      #if (configUSE_MUTEX_CEILING == 1)
+      if ((hMutex != NULL) && (ceil != 0U)) {
+        vSemaphoreSetMutexCeiling (hMutex, (UBaseType_t)ceil);
+      }
+      #endif
+
       #if (configQUEUE_REGISTRY_SIZE > 0)
       if (hMutex != NULL) {
         if (attr != NULL) {
@@ -1504,6 +1774,167 @@ osStatus_t osMutexDelete (osMutexId_t mutex_id) {
 }
 #endif /* (configUSE_OS2_MUTEX == 1) */
 
+/*---------------------------------------------------------------------------*/
+#if (configUSE_OS2_MUTEX == 1)
+
+osRwLockId_t osRwLockNew (const osRwLockAttr_t *attr) {
+  RwLockHandle_t hRwLock;
+
+  hRwLock = NULL;
+
+  if (!IS_IRQ()) {
+    /* Read/write locks are only allocated from the FreeRTOS heap */
+    if ((attr == NULL) || ((attr->cb_mem == NULL) && (attr->cb_size == 0U))) {
+      #if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
+        hRwLock = xRwLockCreate ();
+      #endif
+    }
+  }
+
+  return ((osRwLockId_t)hRwLock);
+}
+
+osStatus_t osRwLockAcquireRead (osRwLockId_t rwlock_id, uint32_t timeout) {
+  RwLockHandle_t hRwLock = (RwLockHandle_t)rwlock_id;
+  osStatus_t stat;
+
+  stat = osOK;
+
+  if (IS_IRQ()) {
+    stat = osErrorISR;
+  }
+  else if (hRwLock == NULL) {
+    stat = osErrorParameter;
+  }
+  else {
+    if (xRwLockTakeRead (hRwLock, (TickType_t)timeout) != pdPASS) {
+      if (timeout != 0U) {
+        stat = osErrorTimeout;
+      } else {
+        stat = osErrorResource;
+      }
+    }
+  }
+
+  return (stat);
+}
+
+osStatus_t osRwLockReleaseRead (osRwLockId_t rwlock_id) {
+  RwLockHandle_t hRwLock = (RwLockHandle_t)rwlock_id;
+  osStatus_t stat;
+
+  stat = osOK;
+
+  if (IS_IRQ()) {
+    stat = osErrorISR;
+  }
+  else if (hRwLock == NULL) {
+    stat = osErrorParameter;
+  }
+  else {
+    if (xRwLockGiveRead (hRwLock) != pdPASS) {
+      stat = osErrorResource;
+    }
+  }
+
+  return (stat);
+}
+
+osStatus_t osRwLockAcquireWrite (osRwLockId_t rwlock_id, uint32_t timeout) {
+  RwLockHandle_t hRwLock = (RwLockHandle_t)rwlock_id;
+  osStatus_t stat;
+
+  stat = osOK;
+
+  if (IS_IRQ()) {
+    stat = osErrorISR;
+  }
+  else if (hRwLock == NULL) {
+    stat = osErrorParameter;
+  }
+  else {
+    if (xRwLockTakeWrite (hRwLock, (TickType_t)timeout) != pdPASS) {
+      if (timeout != 0U) {
+        stat = osErrorTimeout;
+      } else {
+        stat = osErrorResource;
+      }
+    }
+  }
+
+  return (stat);
+}
+
+osStatus_t osRwLockReleaseWrite (osRwLockId_t rwlock_id) {
+  RwLockHandle_t hRwLock = (RwLockHandle_t)rwlock_id;
+  osStatus_t stat;
+
+  stat = osOK;
+
+  if (IS_IRQ()) {
+    stat = osErrorISR;
+  }
+  else if (hRwLock == NULL) {
+    stat = osErrorParameter;
+  }
+  else {
+    if (xRwLockGiveWrite (hRwLock) != pdPASS) {
+      stat = osErrorResource;
+    }
+  }
+
+  return (stat);
+}
+
+osThreadId_t osRwLockGetWriter (osRwLockId_t rwlock_id) {
+  RwLockHandle_t hRwLock = (RwLockHandle_t)rwlock_id;
+  osThreadId_t owner;
+
+  if (IS_IRQ() || (hRwLock == NULL)) {
+    owner = NULL;
+  } else {
+    owner = (osThreadId_t)xRwLockGetWriter (hRwLock);
+  }
+
+  return (owner);
+}
+
+uint32_t osRwLockGetReaderCount (osRwLockId_t rwlock_id) {
+  RwLockHandle_t hRwLock = (RwLockHandle_t)rwlock_id;
+  uint32_t count;
+
+  if (IS_IRQ() || (hRwLock == NULL)) {
+    count = 0U;
+  } else {
+    count = (uint32_t)uxRwLockGetReaderCount (hRwLock);
+  }
+
+  return (count);
+}
+
+osStatus_t osRwLockDelete (osRwLockId_t rwlock_id) {
+  osStatus_t stat;
+#ifndef USE_FreeRTOS_HEAP_1
+  RwLockHandle_t hRwLock = (RwLockHandle_t)rwlock_id;
+
+  if (IS_IRQ()) {
+    stat = osErrorISR;
+  }
+  else if (hRwLock == NULL) {
+    stat = osErrorParameter;
+  }
+  else {
+    stat = osOK;
+    vRwLockDelete (hRwLock);
+  }
+#else
+  stat = osError;
+#endif
+
+  return (stat);
+}
+#endif /* (configUSE_OS2_MUTEX == 1) */
+
 /*---------------------------------------------------------------------------*/
 
 osSemaphoreId_t osSemaphoreNew (uint32_t max_count, uint32_t initial_count, const osSemaphoreAttr_t *attr) {
@@ -1718,6 +2149,17 @@ osMessageQueueId_t osMessageQueueNew (uint32_t msg_count, uint32_t msg_size, con
       mem = 0;
     }
 
+    #if (configUSE_QUEUE_PRIORITY == 1)
+    if ((attr != NULL) && ((attr->attr_bits & osMessageQueuePrio) != 0U)) {
+      /* Priority queues keep their heap with the storage, only dynamic memory is supported */
+      if (mem == 0) {
+        #if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
+          hQueue = xQueueCreatePriority (msg_count, msg_size);
+        #endif
+      }
+    }
+    else
+    #endif
     if (mem == 1) {
       #if (configSUPPORT_STATIC_ALLOCATION == 1)
         hQueue = xQueueCreateStatic (msg_count, msg_size, attr->mq_mem, attr->cb_mem);
@@ -1752,7 +2194,9 @@ osStatus_t osMessageQueuePut (osMessageQueueId_t mq_id, const void *msg_ptr, uin
   osStatus_t stat;
   BaseType_t yield;
 
+  #if (configUSE_QUEUE_PRIORITY == 0)
   (void)msg_prio; /* Message priority is ignored */
+  #endif
 
   stat = osOK;
 
@@ -1763,7 +2207,12 @@ osStatus_t osMessageQueuePut (osMessageQueueId_t mq_id, const void *msg_ptr, uin
     else {
       yield = pdFALSE;
 
+      #if (configUSE_QUEUE_PRIORITY == 1)
+      /* Queues not created with osMessageQueuePrio ignore the priority */
+      if (xQueueSendWithPriorityFromISR (hQueue, msg_ptr, msg_prio, &yield) != pdTRUE) {
+      #else
       if (xQueueSendToBackFromISR (hQueue, msg_ptr, &yield) != pdTRUE) {
+      #endif
         stat = osErrorResource;
       } else {
         portYIELD_FROM_ISR (yield);
@@ -1775,7 +2224,11 @@ osStatus_t osMessageQueuePut (osMessageQueueId_t mq_id, const void *msg_ptr, uin
       stat = osErrorParameter;
     }
     else {
+      #if (configUSE_QUEUE_PRIORITY == 1)
+      if (xQueueSendWithPriority (hQueue, msg_ptr, msg_prio, (TickType_t)timeout) != pdPASS) {
+      #else
       if (xQueueSendToBack (hQueue, msg_ptr, (TickType_t)timeout) != pdPASS) {
+      #endif
         if (timeout != 0U) {
           stat = osErrorTimeout;
         } else {
@@ -1793,7 +2246,9 @@ osStatus_t osMessageQueueGet (osMessageQueueId_t mq_id, void *msg_ptr, uint8_t *
   osStatus_t stat;
   BaseType_t yield;
 
+  #if (configUSE_QUEUE_PRIORITY == 0)
   (void)msg_prio; /* Message priority is ignored */
+  #endif
 
   stat = osOK;
 
@@ -1807,6 +2262,11 @@ osStatus_t osMessageQueueGet (osMessageQueueId_t mq_id, void *msg_ptr, uint8_t *
       if (xQueueReceiveFromISR (hQueue, msg_ptr, &yield) != pdPASS) {
         stat = osErrorResource;
       } else {
+        #if (configUSE_QUEUE_PRIORITY == 1)
+        if (msg_prio != NULL) {
+          *msg_prio = (uint8_t)uxQueueGetLastReceivedPriority (hQueue);
+        }
+        #endif
         portYIELD_FROM_ISR (yield);
       }
     }
@@ -1823,12 +2283,72 @@ osStatus_t osMessageQueueGet (osMessageQueueId_t mq_id, void *msg_ptr, uint8_t *
           stat = osErrorResource;
         }
       }
+      #if (configUSE_QUEUE_PRIORITY == 1)
+      else {
+        if (msg_prio != NULL) {
+          /* Priority of the message got, unless another thread got one since */
+          *msg_prio = (uint8_t)uxQueueGetLastReceivedPriority (hQueue);
+        }
+      }
+      #endif
     }
   }
 
   return (stat);
 }
 
+#if (configUSE_QUEUE_BATCH == 1)
+uint32_t osMessageQueuePutBatch (osMessageQueueId_t mq_id, const void *msg_ptr, uint32_t count, uint32_t timeout) {
+  QueueHandle_t hQueue = (QueueHandle_t)mq_id;
+  uint32_t cnt;
+  BaseType_t yield;
+
+  cnt = 0U;
+
+  if ((hQueue == NULL) || (msg_ptr == NULL) || (count == 0U)) {
+    /* Invalid parameters, nothing is put */
+  }
+  else if (IS_IRQ()) {
+    if (timeout == 0U) {
+      yield = pdFALSE;
+
+      cnt = (uint32_t)xQueueSendBatchFromISR (hQueue, msg_ptr, (UBaseType_t)count, &yield);
+      portYIELD_FROM_ISR (yield);
+    }
+  }
+  else {
+    cnt = (uint32_t)xQueueSendBatch (hQueue, msg_ptr, (UBaseType_t)count, (TickType_t)timeout);
+  }
+
+  return (cnt);
+}
+
+uint32_t osMessageQueueGetBatch (osMessageQueueId_t mq_id, void *msg_ptr, uint32_t count, uint32_t timeout) {
+  QueueHandle_t hQueue = (QueueHandle_t)mq_id;
+  uint32_t cnt;
+  BaseType_t yield;
+
+  cnt = 0U;
+
+  if ((hQueue == NULL) || (msg_ptr == NULL) || (count == 0U)) {
+    /* Invalid parameters, nothing is got */
+  }
+  else if (IS_IRQ()) {
+    if (timeout == 0U) {
+      yield = pdFALSE;
+
+      cnt = (uint32_t)xQueueReceiveBatchFromISR (hQueue, msg_ptr, (UBaseType_t)count, &yield);
+      portYIELD_FROM_ISR (yield);
+    }
+  }
+  else {
+    cnt = (uint32_t)xQueueReceiveBatch (hQueue, msg_ptr, (UBaseType_t)count, (TickType_t)timeout);
+  }
+
+  return (cnt);
+}
+#endif /* (configUSE_QUEUE_BATCH == 1) */
+
 uint32_t osMessageQueueGetCapacity (osMessageQueueId_t mq_id) {
   StaticQueue_t *mq = (StaticQueue_t *)mq_id;
   uint32_t capacity;
@@ -1945,15 +2465,16 @@ osStatus_t osMessageQueueDelete (osMessageQueueId_t mq_id) {
 #ifdef FREERTOS_MPOOL_H_
 
 /* Static memory pool functions */
-static void  FreeBlock   (MemPool_t *mp, void *block);
-static void *AllocBlock  (MemPool_t *mp);
-static void *CreateBlock (MemPool_t *mp);
+static void      FreeBlock   (MemPool_t *mp, void *block);
+static void     *AllocBlock  (MemPool_t *mp);
+static uint32_t  TakeCount   (MemPoolCount_t *cnt);
+static void      AddCount    (MemPoolCount_t *cnt, int32_t inc);
 
 osMemoryPoolId_t osMemoryPoolNew (uint32_t block_count, uint32_t block_size, const osMemoryPoolAttr_t *attr) {
   MemPool_t *mp;
   const char *name;
   int32_t mem_cb, mem_mp;
-  uint32_t sz;
+  uint32_t sz, n, link;
 
   if (IS_IRQ()) {
     mp = NULL;
@@ -2013,11 +2534,12 @@ osMemoryPoolId_t osMemoryPoolNew (uint32_t block_count, uint32_t block_size, con
     }
 
     if (mp != NULL) {
-      /* Create a semaphore (max count == initial count == block_count) */
+      /* Create a semaphore (max count == block_count, initial count == 0),
+         it is only given when a block is freed while threads are waiting */
       #if (configSUPPORT_STATIC_ALLOCATION == 1)
-        mp->sem = xSemaphoreCreateCountingStatic (block_count, block_count, &mp->mem_sem);
+        mp->sem = xSemaphoreCreateCountingStatic (block_count, 0U, &mp->mem_sem);
       #elif (configSUPPORT_DYNAMIC_ALLOCATION == 1)
-        mp->sem = xSemaphoreCreateCounting (block_count, block_count);
+        mp->sem = xSemaphoreCreateCounting (block_count, 0U);
       #else
         mp->sem == NULL;
       #endif
@@ -2034,12 +2556,20 @@ osMemoryPoolId_t osMemoryPoolNew (uint32_t block_count, uint32_t block_size, con
 
     if ((mp != NULL) && (mp->mem_arr != NULL)) {
       /* Memory pool can be created */
-      mp->head    = NULL;
       mp->mem_sz  = sz;
       mp->name    = name;
       mp->bl_sz   = block_size;
       mp->bl_cnt  = block_count;
-      mp->n       = 0U;
+      mp->bl_step = sz / block_count;
+      mp->waiters = 0U;
+
+      /* Link all blocks into the free-list, in address order */
+      for (n = 0U; n < block_count; n++) {
+        link = n * mp->bl_step;
+        ((MemPoolBlock_t *)(void *)&mp->mem_arr[link])->next = ((n + 1U) < block_count) ? (link + mp->bl_step) : MPOOL_LINK_NONE;
+      }
+      mp->head     = 0U;
+      mp->free_cnt = block_count;
 
       /* Set heap allocated memory flags */
       mp->status = MPOOL_STATUS;
@@ -2086,7 +2616,8 @@ const char *osMemoryPoolGetName (osMemoryPoolId_t mp_id) {
 void *osMemoryPoolAlloc (osMemoryPoolId_t mp_id, uint32_t timeout) {
   MemPool_t *mp;
   void *block;
-  uint32_t isrm;
+  TimeOut_t tmo;
+  TickType_t ticks;
 
   if (mp_id == NULL) {
     /* Invalid input parameters */
@@ -2098,40 +2629,44 @@ void *osMemoryPoolAlloc (osMemoryPoolId_t mp_id, uint32_t timeout) {
     mp = (MemPool_t *)mp_id;
 
     if ((mp->status & MPOOL_STATUS) == MPOOL_STATUS) {
-      if (IS_IRQ()) {
-        if (timeout == 0U) {
-          if (xSemaphoreTakeFromISR (mp->sem, NULL) == pdTRUE) {
-            if ((mp->status & MPOOL_STATUS) == MPOOL_STATUS) {
-              isrm  = taskENTER_CRITICAL_FROM_ISR();
-
-              /* Get a block from the free-list */
-              block = AllocBlock(mp);
-
-              if (block == NULL) {
-                /* List of free blocks is empty, 'create' new block */
-                block = CreateBlock(mp);
-              }
-
-              taskEXIT_CRITICAL_FROM_ISR(isrm);
-            }
-          }
-        }
+      if (IS_IRQ() && (timeout != 0U)) {
+        /* Cannot wait in ISR */
       }
-      else {
-        if (xSemaphoreTake (mp->sem, (TickType_t)timeout) == pdTRUE) {
-          if ((mp->status & MPOOL_STATUS) == MPOOL_STATUS) {
-            taskENTER_CRITICAL();
-
-            /* Get a block from the free-list */
-            block = AllocBlock(mp);
+      else if (TakeCount (&mp->free_cnt) != 0U) {
+        /* A free block is reserved, take it from the free-list */
+        block = AllocBlock(mp);
+      }
+      else if (timeout != 0U) {
+        /* Pool is empty, wait on the pool semaphore. The waiter is counted
+           before the free count is checked again, so a block freed in between
+           either is seen here or gives the semaphore. */
+        vTaskSetTimeOutState (&tmo);
+        ticks = (TickType_t)timeout;
 
-            if (block == NULL) {
-              /* List of free blocks is empty, 'create' new block */
-              block = CreateBlock(mp);
-            }
+        AddCount (&mp->waiters, 1);
 
-            taskEXIT_CRITICAL();
+        for (;;) {
+          if (TakeCount (&mp->free_cnt) != 0U) {
+            block = AllocBlock(mp);
+            break;
+          }
+          if (xSemaphoreTake (mp->sem, ticks) != pdTRUE) {
+            /* Timeout */
+            break;
+          }
+          if ((mp->status & MPOOL_STATUS) != MPOOL_STATUS) {
+            /* Memory pool was deleted */
+            break;
           }
+          if (xTaskCheckForTimeOut (&tmo, &ticks) != pdFALSE) {
+            /* Another thread took the freed block and the timeout expired,
+               check the pool once more without waiting */
+            ticks = 0U;
+          }
+        }
+
+        if ((mp->status & MPOOL_STATUS) == MPOOL_STATUS) {
+          AddCount (&mp->waiters, -1);
         }
       }
     }
@@ -2143,7 +2678,6 @@ void *osMemoryPoolAlloc (osMemoryPoolId_t mp_id, uint32_t timeout) {
 osStatus_t osMemoryPoolFree (osMemoryPoolId_t mp_id, void *block) {
   MemPool_t *mp;
   osStatus_t stat;
-  uint32_t isrm;
   BaseType_t yield;
 
   if ((mp_id == NULL) || (block == NULL)) {
@@ -2161,38 +2695,25 @@ osStatus_t osMemoryPoolFree (osMemoryPoolId_t mp_id, void *block) {
       /* Block pointer outside of memory array area */
       stat = osErrorParameter;
     }
+    else if (mp->free_cnt == mp->bl_cnt) {
+      /* All blocks are already free */
+      stat = osErrorResource;
+    }
     else {
       stat = osOK;
 
-      if (IS_IRQ()) {
-        if (uxSemaphoreGetCountFromISR (mp->sem) == mp->bl_cnt) {
-          stat = osErrorResource;
-        }
-        else {
-          isrm = taskENTER_CRITICAL_FROM_ISR();
-
-          /* Add block to the list of free blocks */
-          FreeBlock(mp, block);
-
-          taskEXIT_CRITICAL_FROM_ISR(isrm);
+      /* Add block to the list of free blocks, then make it available */
+      FreeBlock(mp, block);
+      AddCount (&mp->free_cnt, 1);
 
+      if (mp->waiters != 0U) {
+        /* Wake-up a thread waiting for a free block */
+        if (IS_IRQ()) {
           yield = pdFALSE;
           xSemaphoreGiveFromISR (mp->sem, &yield);
           portYIELD_FROM_ISR (yield);
         }
-      }
-      else {
-        if (uxSemaphoreGetCount (mp->sem) == mp->bl_cnt) {
-          stat = osErrorResource;
-        }
         else {
-          taskENTER_CRITICAL();
-
-          /* Add block to the list of free blocks */
-          FreeBlock(mp, block);
-
-          taskEXIT_CRITICAL();
-
           xSemaphoreGive (mp->sem);
         }
       }
@@ -2266,13 +2787,7 @@ uint32_t osMemoryPoolGetCount (osMemoryPoolId_t mp_id) {
       n = 0U;
     }
     else {
-      if (IS_IRQ()) {
-        n = uxSemaphoreGetCountFromISR (mp->sem);
-      } else {
-        n = uxSemaphoreGetCount        (mp->sem);
-      }
-
-      n = mp->bl_cnt - n;
+      n = mp->bl_cnt - mp->free_cnt;
     }
   }
 
@@ -2296,11 +2811,7 @@ uint32_t osMemoryPoolGetSpace (osMemoryPoolId_t mp_id) {
       n = 0U;
     }
     else {
-      if (IS_IRQ()) {
-        n = uxSemaphoreGetCountFromISR (mp->sem);
-      } else {
-        n = uxSemaphoreGetCount        (mp->sem);
-      }
+      n = mp->free_cnt;
     }
   }
 
@@ -2330,9 +2841,10 @@ osStatus_t osMemoryPoolDelete (osMemoryPoolId_t mp_id) {
     /* Wake-up tasks waiting for pool semaphore */
     while (xSemaphoreGive (mp->sem) == pdTRUE);
 
-    mp->head    = NULL;
-    mp->bl_sz   = 0U;
-    mp->bl_cnt  = 0U;
+    mp->head     = MPOOL_LINK_NONE;
+    mp->free_cnt = 0U;
+    mp->bl_sz    = 0U;
+    mp->bl_cnt   = 0U;
 
     if ((mp->status & 2U) != 0U) {
       /* Memory pool array allocated on heap */
@@ -2351,52 +2863,138 @@ osStatus_t osMemoryPoolDelete (osMemoryPoolId_t mp_id) {
   return (stat);
 }
 
+#if (MPOOL_EXCLUSIVE_ACCESS == 1)
+
 /*
-  Create new block given according to the current block index.
+  Allocate a block by taking the head of the list of free blocks.
 */
-static void *CreateBlock (MemPool_t *mp) {
-  MemPoolBlock_t *p = NULL;
+static void *AllocBlock (MemPool_t *mp) {
+  MemPoolBlock_t *p;
+  uint32_t link;
 
-  if (mp->n < mp->bl_cnt) {
-    /* Unallocated blocks exist, set pointer to new block */
-    p = (void *)(mp->mem_arr + (mp->bl_sz * mp->n));
+  do {
+    link = __LDREXW(&mp->head);
 
-    /* Increment block index */
-    mp->n += 1U;
-  }
+    if (link == MPOOL_LINK_NONE) {
+      /* List of free blocks is empty */
+      __CLREX();
+      return (NULL);
+    }
+
+    p = (void *)&mp->mem_arr[link];
+  } while (__STREXW(p->next, &mp->head) != 0U);
 
   return (p);
 }
 
 /*
-  Allocate a block by reading the list of free blocks.
+  Free block by putting it to the head of the list of free blocks.
+*/
+static void FreeBlock (MemPool_t *mp, void *block) {
+  MemPoolBlock_t *p = block;
+  uint32_t link = (uint32_t)((uint8_t *)block - mp->mem_arr);
+
+  do {
+    /* Store current head into block memory space */
+    p->next = __LDREXW(&mp->head);
+  } while (__STREXW(link, &mp->head) != 0U);
+}
+
+/*
+  Decrement a counter unless it is zero, return 1 if it was decremented.
+*/
+static uint32_t TakeCount (MemPoolCount_t *cnt) {
+  uint32_t n;
+
+  do {
+    n = __LDREXW(cnt);
+
+    if (n == 0U) {
+      __CLREX();
+      return (0U);
+    }
+  } while (__STREXW(n - 1U, cnt) != 0U);
+
+  return (1U);
+}
+
+/*
+  Add a signed value to a counter.
+*/
+static void AddCount (MemPoolCount_t *cnt, int32_t inc) {
+  uint32_t n;
+
+  do {
+    n = __LDREXW(cnt);
+  } while (__STREXW(n + (uint32_t)inc, cnt) != 0U);
+}
+
+#else /* MPOOL_EXCLUSIVE_ACCESS */
+
+/*
+  Allocate a block by taking the head of the list of free blocks. The tag in
+  the upper half of the head is incremented on every pop.
 */
 static void *AllocBlock (MemPool_t *mp) {
-  MemPoolBlock_t *p = NULL;
+  MemPoolBlock_t *p;
+  uint64_t head, next;
 
-  if (mp->head != NULL) {
-    /* List of free block exists, get head block */
-    p = mp->head;
+  head = atomic_load (&mp->head);
 
-    /* Head block is now next on the list */
-    mp->head = p->next;
-  }
+  do {
+    if ((uint32_t)head == MPOOL_LINK_NONE) {
+      /* List of free blocks is empty */
+      return (NULL);
+    }
+
+    p    = (void *)&mp->mem_arr[(uint32_t)head];
+    next = ((head + (1ULL << 32)) & ~0xFFFFFFFFULL) | p->next;
+  } while (!atomic_compare_exchange_weak (&mp->head, &head, next));
 
   return (p);
 }
 
 /*
-  Free block by putting it to the list of free blocks.
+  Free block by putting it to the head of the list of free blocks.
 */
 static void FreeBlock (MemPool_t *mp, void *block) {
   MemPoolBlock_t *p = block;
+  uint32_t link = (uint32_t)((uint8_t *)block - mp->mem_arr);
+  uint64_t head;
 
-  /* Store current head into block memory space */
-  p->next = mp->head;
+  head = atomic_load (&mp->head);
 
-  /* Store current block as new head */
-  mp->head = p;
+  do {
+    /* Store current head into block memory space */
+    p->next = (uint32_t)head;
+  } while (!atomic_compare_exchange_weak (&mp->head, &head, (head & ~0xFFFFFFFFULL) | link));
 }
+
+/*
+  Decrement a counter unless it is zero, return 1 if it was decremented.
+*/
+static uint32_t TakeCount (MemPoolCount_t *cnt) {
+  uint32_t n;
+
+  n = atomic_load (cnt);
+
+  do {
+    if (n == 0U) {
+      return (0U);
+    }
+  } while (!atomic_compare_exchange_weak (cnt, &n, n - 1U));
+
+  return (1U);
+}
+
+/*
+  Add a signed value to a counter.
+*/
+static void AddCount (MemPoolCount_t *cnt, int32_t inc) {
+  (void)atomic_fetch_add (cnt, (uint32_t)inc);
+}
+
+#endif /* MPOOL_EXCLUSIVE_ACCESS */
 #endif /* FREERTOS_MPOOL_H_ */
 /*---------------------------------------------------------------------------*/
 
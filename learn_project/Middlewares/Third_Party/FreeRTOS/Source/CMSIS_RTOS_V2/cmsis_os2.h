@@ -163,6 +163,9 @@ typedef enum {
 #define osFlagsErrorParameter 0xFFFFFFFCU ///< osErrorParameter (-4).
 #define osFlagsErrorISR       0xFFFFFFFAU ///< osErrorISR (-6).
 
+/// Error code \a err (osFlagsErrorXxx) as returned by the 64-bit event flags functions.
+#define osFlagsError64(err)   ((uint64_t)(int64_t)(int32_t)(err))
+
 // Thread attributes (attr_bits in \ref osThreadAttr_t).
 #define osThreadDetached      0x00000000U ///< Thread created in detached mode (default)
 #define osThreadJoinable      0x00000001U ///< Thread created in joinable mode
@@ -170,8 +173,18 @@ typedef enum {
 // Mutex attributes (attr_bits in \ref osMutexAttr_t).
 #define osMutexRecursive      0x00000001U ///< Recursive mutex.
 #define osMutexPrioInherit    0x00000002U ///< Priority inherit protocol.
+#define osMutexPrioCeiling    0x00000004U ///< Immediate priority ceiling protocol, ceiling in bits 8..15.
 #define osMutexRobust         0x00000008U ///< Robust mutex.
 
+/// Attribute bits for a priority ceiling mutex: the holder runs at \a prio.
+#define osMutexCeiling(prio)  (osMutexPrioCeiling | (((uint32_t)(prio) & 0xFFU) << 8))
+
+// Event flags attributes (attr_bits in \ref osEventFlagsAttr_t).
+#define osEventFlagsWide      0x00000001U ///< 56 event flags instead of 24, see osEventFlagsSet64 (configUSE_64_BIT_EVENT_GROUPS); osEventFlagsXxx reach flags 0..30.
+
+// Message queue attributes (attr_bits in \ref osMessageQueueAttr_t).
+#define osMessageQueuePrio    0x00000001U ///< Messages are got in msg_prio order (dynamic memory only).
+
 /// Status code values returned by CMSIS-RTOS functions.
 typedef enum {
   osOK                      =  0,         ///< Operation completed successfully.
@@ -197,6 +210,9 @@ typedef void *osEventFlagsId_t;
 /// \details Mutex ID identifies the mutex.
 typedef void *osMutexId_t;
 
+/// \details Read/Write Lock ID identifies the read/write lock.
+typedef void *osRwLockId_t;
+
 /// \details Semaphore ID identifies the semaphore.
 typedef void *osSemaphoreId_t;
 
@@ -251,6 +267,14 @@ typedef struct {
   uint32_t                   cb_size;   ///< size of provided memory for control block
 } osMutexAttr_t;
 
+/// Attributes structure for read/write lock.
+typedef struct {
+  const char                   *name;   ///< name of the read/write lock (not used)
+  uint32_t                 attr_bits;   ///< attribute bits (must be 0)
+  void                      *cb_mem;    ///< memory for control block (must be NULL)
+  uint32_t                   cb_size;   ///< size of provided memory for control block (must be 0)
+} osRwLockAttr_t;
+
 /// Attributes structure for semaphore.
 typedef struct {
   const char                   *name;   ///< name of the semaphore
@@ -543,6 +567,31 @@ uint32_t osEventFlagsWait (osEventFlagsId_t ef_id, uint32_t flags, uint32_t opti
 /// \return status code that indicates the execution status of the function.
 osStatus_t osEventFlagsDelete (osEventFlagsId_t ef_id);
 
+/// Set the specified flags of wide Event Flags (\ref osEventFlagsWide).
+/// \param[in]     ef_id         event flags ID obtained by \ref osEventFlagsNew.
+/// \param[in]     flags         specifies the flags that shall be set (bits 0..55).
+/// \return event flags after setting or error code (\ref osFlagsError64) if highest bit set.
+uint64_t osEventFlagsSet64 (osEventFlagsId_t ef_id, uint64_t flags);
+
+/// Clear the specified flags of wide Event Flags (\ref osEventFlagsWide).
+/// \param[in]     ef_id         event flags ID obtained by \ref osEventFlagsNew.
+/// \param[in]     flags         specifies the flags that shall be cleared (bits 0..55).
+/// \return event flags before clearing or error code (\ref osFlagsError64) if highest bit set.
+uint64_t osEventFlagsClear64 (osEventFlagsId_t ef_id, uint64_t flags);
+
+/// Get the current flags of wide Event Flags (\ref osEventFlagsWide).
+/// \param[in]     ef_id         event flags ID obtained by \ref osEventFlagsNew.
+/// \return current event flags.
+uint64_t osEventFlagsGet64 (osEventFlagsId_t ef_id);
+
+/// Wait for one or more flags of wide Event Flags (\ref osEventFlagsWide) to become signaled.
+/// \param[in]     ef_id         event flags ID obtained by \ref osEventFlagsNew.
+/// \param[in]     flags         specifies the flags to wait for (bits 0..55).
+/// \param[in]     options       specifies flags options (osFlagsXxxx).
+/// \param[in]     timeout       \ref CMSIS_RTOS_TimeOutValue or 0 in case of no time-out.
+/// \return event flags before clearing or error code (\ref osFlagsError64) if highest bit set.
+uint64_t osEventFlagsWait64 (osEventFlagsId_t ef_id, uint64_t flags, uint32_t options, uint32_t timeout);
+
 
 //  ==== Mutex Management Functions ====
 
@@ -578,6 +627,51 @@ osThreadId_t osMutexGetOwner (osMutexId_t mutex_id);
 osStatus_t osMutexDelete (osMutexId_t mutex_id);
 
 
+//  ==== Read/Write Lock Management Functions ====
+
+/// Create and Initialize a Read/Write Lock object.
+/// \param[in]     attr          read/write lock attributes; NULL: default values.
+/// \return read/write lock ID for reference by other functions or NULL in case of error.
+osRwLockId_t osRwLockNew (const osRwLockAttr_t *attr);
+
+/// Acquire a Read/Write Lock for reading or timeout if it is locked for writing or a writer is waiting.
+/// \param[in]     rwlock_id     read/write lock ID obtained by \ref osRwLockNew.
+/// \param[in]     timeout       \ref CMSIS_RTOS_TimeOutValue or 0 in case of no time-out.
+/// \return status code that indicates the execution status of the function.
+osStatus_t osRwLockAcquireRead (osRwLockId_t rwlock_id, uint32_t timeout);
+
+/// Release a Read/Write Lock that was acquired by \ref osRwLockAcquireRead.
+/// \param[in]     rwlock_id     read/write lock ID obtained by \ref osRwLockNew.
+/// \return status code that indicates the execution status of the function.
+osStatus_t osRwLockReleaseRead (osRwLockId_t rwlock_id);
+
+/// Acquire a Read/Write Lock for writing or timeout if it is locked.
+/// \param[in]     rwlock_id     read/write lock ID obtained by \ref osRwLockNew.
+/// \param[in]     timeout       \ref CMSIS_RTOS_TimeOutValue or 0 in case of no time-out.
+/// \return status code that indicates the execution status of the function.
+osStatus_t osRwLockAcquireWrite (osRwLockId_t rwlock_id, uint32_t timeout);
+
+/// Release a Read/Write Lock that was acquired by \ref osRwLockAcquireWrite.
+/// \param[in]     rwlock_id     read/write lock ID obtained by \ref osRwLockNew.
+/// \return status code that indicates the execution status of the function.
+osStatus_t osRwLockReleaseWrite (osRwLockId_t rwlock_id);
+
+/// Get Thread which owns a Read/Write Lock for writing.
+/// \param[in]     rwlock_id     read/write lock ID obtained by \ref osRwLockNew.
+/// \return thread ID of owner thread or NULL when not locked for writing.
+osThreadId_t osRwLockGetWriter (osRwLockId_t rwlock_id);
+
+/// Get number of Threads which own a Read/Write Lock for reading.
+/// \param[in]     rwlock_id     read/write lock ID obtained by \ref osRwLockNew.
+/// \return number of reader threads.
+uint32_t osRwLockGetReaderCount (osRwLockId_t rwlock_id);
+
+/// Delete a Read/Write Lock object.
+/// \param[in]     rwlock_id     read/write lock ID obtained by \ref osRwLockNew.
+/// \return status code that indicates the execution status of the function.
+osStatus_t osRwLockDelete (osRwLockId_t rwlock_id);
+
+
 //  ==== Semaphore Management Functions ====
 
 /// Create and Initialize a Semaphore object.
@@ -696,6 +790,22 @@ osStatus_t osMessageQueuePut (osMessageQueueId_t mq_id, const void *msg_ptr, uin
 /// \return status code that indicates the execution status of the function.
 osStatus_t osMessageQueueGet (osMessageQueueId_t mq_id, void *msg_ptr, uint8_t *msg_prio, uint32_t timeout);
 
+/// Put up to count Messages into a Queue under one lock, or timeout if Queue stays full.
+/// \param[in]     mq_id         message queue ID obtained by \ref osMessageQueueNew.
+/// \param[in]     msg_ptr       pointer to count messages stored one after another.
+/// \param[in]     count         number of messages at msg_ptr.
+/// \param[in]     timeout       \ref CMSIS_RTOS_TimeOutValue or 0 in case of no time-out.
+/// \return number of messages put into the queue, 0 in case of error or time-out.
+uint32_t osMessageQueuePutBatch (osMessageQueueId_t mq_id, const void *msg_ptr, uint32_t count, uint32_t timeout);
+
+/// Get up to count Messages from a Queue under one lock, or timeout if Queue stays empty.
+/// \param[in]     mq_id         message queue ID obtained by \ref osMessageQueueNew.
+/// \param[out]    msg_ptr       pointer to buffer for up to count messages.
+/// \param[in]     count         maximum number of messages to get.
+/// \param[in]     timeout       \ref CMSIS_RTOS_TimeOutValue or 0 in case of no time-out.
+/// \return number of messages got from the queue, 0 in case of error or time-out.
+uint32_t osMessageQueueGetBatch (osMessageQueueId_t mq_id, void *msg_ptr, uint32_t count, uint32_t timeout);
+
 /// Get maximum number of messages in a Message Queue.
 /// \param[in]     mq_id         message queue ID obtained by \ref osMessageQueueNew.
 /// \return maximum number of messages.
@@ -24,27 +24,56 @@
 #define FREERTOS_MPOOL_H_
 
 #include <stdint.h>
+#include "cmsis_compiler.h"
 #include "FreeRTOS.h"
 #include "semphr.h"
 
 /* Memory Pool implementation definitions */
 #define MPOOL_STATUS              0x5EED0000U
 
+/* Free-list link value marking the end of the list */
+#define MPOOL_LINK_NONE           0xFFFFFFFFU
+
+/* The free-list and the free block count are updated without a critical
+   section. Armv7-M and Armv8-M Mainline use LDREX/STREX: any exception between
+   the two clears the exclusive monitor, so an interrupted update is retried
+   and a pop cannot be fooled by a block that was taken and returned meanwhile
+   (ABA). Other targets, such as the Linux host build, use C11 atomics and keep
+   a modification tag next to the list head for the same purpose. */
+#if ((defined(__ARM_ARCH_7M__)      && (__ARM_ARCH_7M__      == 1)) || \
+     (defined(__ARM_ARCH_7EM__)     && (__ARM_ARCH_7EM__     == 1)) || \
+     (defined(__ARM_ARCH_8M_MAIN__) && (__ARM_ARCH_8M_MAIN__ == 1)))
+  #define MPOOL_EXCLUSIVE_ACCESS  1
+#else
+  #define MPOOL_EXCLUSIVE_ACCESS  0
+#endif
+
+#if (MPOOL_EXCLUSIVE_ACCESS == 1)
+typedef volatile uint32_t MemPoolHead_t;    /* Offset of the head block     */
+typedef volatile uint32_t MemPoolCount_t;
+#else
+#include <stdatomic.h>
+typedef _Atomic uint64_t  MemPoolHead_t;    /* Tag (high) : offset (low)    */
+typedef _Atomic uint32_t  MemPoolCount_t;
+#endif
+
 /* Memory Block header */
 typedef struct {
-  void *next;                   /* Pointer to next block  */
+  uint32_t next;                /* Offset of next block, or MPOOL_LINK_NONE */
 } MemPoolBlock_t;
 
 /* Memory Pool control block */
 typedef struct MemPoolDef_t {
-  MemPoolBlock_t    *head;      /* Pointer to head block   */
+  MemPoolHead_t      head;      /* Free-list head          */
+  MemPoolCount_t     free_cnt;  /* Number of free blocks   */
+  MemPoolCount_t     waiters;   /* Threads waiting on sem  */
   SemaphoreHandle_t  sem;       /* Pool semaphore handle   */
   uint8_t           *mem_arr;   /* Pool memory array       */
   uint32_t           mem_sz;    /* Pool memory array size  */
   const char        *name;      /* Pointer to name string  */
   uint32_t           bl_sz;     /* Size of a single block  */
   uint32_t           bl_cnt;    /* Number of blocks        */
-  uint32_t           n;         /* Block allocation index  */
+  uint32_t           bl_step;   /* Block size rounded to 4 */
   volatile uint32_t  status;    /* Object status flags     */
 #if (configSUPPORT_STATIC_ALLOCATION == 1)
   StaticSemaphore_t  mem_sem;   /* Semaphore object memory */
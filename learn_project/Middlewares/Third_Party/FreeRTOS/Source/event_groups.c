@@ -60,11 +60,48 @@ taskEVENT_LIST_ITEM_VALUE_IN_USE definition. */
 	#define eventEVENT_BITS_CONTROL_BYTES	0xff000000UL
 #endif
 
+#if( configUSE_EVENT_GROUP_INDEX == 1 )
+
+	/* Tasks that wait for exactly one of these bits are held on a list of
+	their own for that bit, rather than on xTasksWaitingForBits. */
+	#define eventINDEXED_BITS	( ( EventBits_t ) ( ( ( EventBits_t ) 1U << configEVENT_GROUP_INDEXED_BITS ) - ( EventBits_t ) 1U ) )
+
+#endif
+
+#if( configUSE_EVENT_GROUP_ISR_SET == 1 )
+
+	/* xEventGroupSetBitsFromISR() sets bits and unblocks the tasks waiting on
+	indexed bits from the interrupt itself, so suspending the scheduler is not
+	enough to keep it out.  Task level code masks interrupts around any read-
+	modify-write of the bits, and around testing the bits and then placing the
+	task on a waiting list, so a set from an interrupt cannot be missed. */
+	#define eventLOCK_BITS()		taskENTER_CRITICAL()
+	#define eventUNLOCK_BITS()		taskEXIT_CRITICAL()
+
+#else
+
+	/* Interrupts only set bits through the timer daemon task, so suspending
+	the scheduler is enough. */
+	#define eventLOCK_BITS()
+	#define eventUNLOCK_BITS()
+
+#endif
+
 typedef struct EventGroupDef_t
 {
 	EventBits_t uxEventBits;
 	List_t xTasksWaitingForBits;		/*< List of tasks waiting for a bit to be set. */
 
+	#if( configUSE_EVENT_GROUP_INDEX == 1 )
+		EventBits_t uxWaitedBits;		/*< The bits waited for by the tasks on xTasksWaitingForBits, as of the last time the list was scanned or added to. */
+		EventBits_t uxIndexedBits;		/*< A bit is set if its xTasksWaitingForBit[] list may not be empty. */
+		List_t xTasksWaitingForBit[ configEVENT_GROUP_INDEXED_BITS ];	/*< Lists of tasks waiting for a single indexed bit, one list per bit. */
+	#endif
+
+	#if( configUSE_EVENT_GROUP_ISR_SET == 1 )
+		UBaseType_t uxDeferredFromISR;	/*< Sets and clears made from interrupts that are queued for the timer daemon task and not yet applied.  Only accessed with interrupts masked. */
+	#endif
+
 	#if( configUSE_TRACE_FACILITY == 1 )
 		UBaseType_t uxEventGroupNumber;
 	#endif
@@ -86,6 +123,47 @@ typedef struct EventGroupDef_t
  */
 static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits, const EventBits_t uxBitsToWaitFor, const BaseType_t xWaitForAllBits ) PRIVILEGED_FUNCTION;
 
+/*
+ * Place the calling task on the list it should wait on for uxBitsToWaitFor,
+ * storing the bits and the control bits in the task's event list item.  With
+ * configUSE_EVENT_GROUP_INDEX set a task that waits for a single indexed bit
+ * goes on that bit's own list, otherwise it goes on xTasksWaitingForBits.
+ * Must be called with the scheduler suspended.
+ */
+static void prvPlaceOnWaitingList( EventGroup_t *pxEventBits, const EventBits_t uxBitsToWaitFor, const EventBits_t uxControlBits, const TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+#if( configUSE_EVENT_GROUP_INDEX == 1 )
+
+	/*
+	 * Initialise the per bit waiting lists of a newly created event group.
+	 */
+	static void prvInitialiseBitIndex( EventGroup_t *pxEventBits ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Returns the index of the least significant set bit of a non-zero value.
+	 */
+	static UBaseType_t prvLowestSetBit( EventBits_t uxValue ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if( configUSE_EVENT_GROUP_ISR_SET == 1 )
+
+	/*
+	 * Executed by the timer daemon task to apply a set or clear that an
+	 * interrupt could not make directly, then to note that it is no longer
+	 * outstanding.
+	 */
+	static void prvDeferredSetBitsCallback( void *pvEventGroup, const uint32_t ulBitsToSet ) PRIVILEGED_FUNCTION;
+	static void prvDeferredClearBitsCallback( void *pvEventGroup, const uint32_t ulBitsToClear ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Queue pxCallback for the timer daemon task, or undo the count of
+	 * outstanding calls that the caller made for it if the timer queue is full.
+	 */
+	static BaseType_t prvDeferFromISR( EventGroup_t *pxEventBits, PendedFunction_t pxCallback, const EventBits_t uxBits, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*-----------------------------------------------------------*/
 
 #if( configSUPPORT_STATIC_ALLOCATION == 1 )
@@ -115,6 +193,12 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits, co
 			pxEventBits->uxEventBits = 0;
 			vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
 
+			#if( configUSE_EVENT_GROUP_INDEX == 1 )
+			{
+				prvInitialiseBitIndex( pxEventBits );
+			}
+			#endif
+
 			#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
 			{
 				/* Both static and dynamic allocation can be used, so note that
@@ -166,6 +250,12 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits, co
 			pxEventBits->uxEventBits = 0;
 			vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
 
+			#if( configUSE_EVENT_GROUP_INDEX == 1 )
+			{
+				prvInitialiseBitIndex( pxEventBits );
+			}
+			#endif
+
 			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
 			{
 				/* Both static and dynamic allocation can be used, so note this
@@ -209,6 +299,16 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 
 		( void ) xEventGroupSetBits( xEventGroup, uxBitsToSet );
 
+		eventLOCK_BITS();
+
+		#if( configUSE_EVENT_GROUP_ISR_SET == 1 )
+		{
+			/* Bits set by an interrupt since the bits were read count towards
+			the rendezvous too. */
+			uxOriginalBitValue |= pxEventBits->uxEventBits;
+		}
+		#endif
+
 		if( ( ( uxOriginalBitValue | uxBitsToSet ) & uxBitsToWaitFor ) == uxBitsToWaitFor )
 		{
 			/* All the rendezvous bits are now set - no need to block. */
@@ -229,7 +329,7 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 				/* Store the bits that the calling task is waiting for in the
 				task's event list item so the kernel knows when a match is
 				found.  Then enter the blocked state. */
-				vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
+				prvPlaceOnWaitingList( pxEventBits, uxBitsToWaitFor, ( eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
 
 				/* This assignment is obsolete as uxReturn will get set after
 				the task unblocks, but some compilers mistakenly generate a
@@ -245,6 +345,8 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 				xTimeoutOccurred = pdTRUE;
 			}
 		}
+
+		eventUNLOCK_BITS();
 	}
 	xAlreadyYielded = xTaskResumeAll();
 
@@ -327,6 +429,7 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 	#endif
 
 	vTaskSuspendAll();
+	eventLOCK_BITS();
 	{
 		const EventBits_t uxCurrentEventBits = pxEventBits->uxEventBits;
 
@@ -384,7 +487,7 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 			/* Store the bits that the calling task is waiting for in the
 			task's event list item so the kernel knows when a match is
 			found.  Then enter the blocked state. */
-			vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
+			prvPlaceOnWaitingList( pxEventBits, uxBitsToWaitFor, uxControlBits, xTicksToWait );
 
 			/* This is obsolete as it will get set after the task unblocks, but
 			some compilers mistakenly generate a warning about the variable
@@ -394,6 +497,7 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 			traceEVENT_GROUP_WAIT_BITS_BLOCK( xEventGroup, uxBitsToWaitFor );
 		}
 	}
+	eventUNLOCK_BITS();
 	xAlreadyYielded = xTaskResumeAll();
 
 	if( xTicksToWait != ( TickType_t ) 0 )
@@ -485,7 +589,51 @@ EventBits_t uxReturn;
 }
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
+#if ( configUSE_EVENT_GROUP_ISR_SET == 1 )
+
+	BaseType_t xEventGroupClearBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToClear )
+	{
+	EventGroup_t *pxEventBits = xEventGroup;
+	UBaseType_t uxSavedInterruptStatus;
+	BaseType_t xClearDirectly = pdFALSE, xReturn = pdPASS;
+
+		configASSERT( xEventGroup );
+		configASSERT( ( uxBitsToClear & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
+
+		traceEVENT_GROUP_CLEAR_BITS_FROM_ISR( xEventGroup, uxBitsToClear );
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			/* Clearing bits never unblocks a task, so it is done here - task
+			level code only changes the bits with interrupts masked.  But if a
+			set or clear from an interrupt is still queued for the timer daemon
+			task the clear is queued behind it, or a set made before the clear
+			would be applied after it. */
+			if( pxEventBits->uxDeferredFromISR == ( UBaseType_t ) 0 )
+			{
+				pxEventBits->uxEventBits &= ~uxBitsToClear;
+				xClearDirectly = pdTRUE;
+			}
+			else
+			{
+				( pxEventBits->uxDeferredFromISR )++;
+			}
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		if( xClearDirectly == pdFALSE )
+		{
+			xReturn = prvDeferFromISR( pxEventBits, prvDeferredClearBitsCallback, uxBitsToClear, NULL );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+
+#elif ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
 
 	BaseType_t xEventGroupClearBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToClear )
 	{
@@ -524,6 +672,10 @@ List_t const * pxList;
 EventBits_t uxBitsToClear = 0, uxBitsWaitedFor, uxControlBits;
 EventGroup_t *pxEventBits = xEventGroup;
 BaseType_t xMatchFound = pdFALSE;
+#if( configUSE_EVENT_GROUP_INDEX == 1 )
+	EventBits_t uxBitsToCheck, uxBit, uxStillWaitedFor = 0;
+	List_t * pxBitList;
+#endif
 
 	/* Check the user is not attempting to set the bits used by the kernel
 	itself. */
@@ -539,7 +691,63 @@ BaseType_t xMatchFound = pdFALSE;
 		pxListItem = listGET_HEAD_ENTRY( pxList );
 
 		/* Set the bits. */
+		eventLOCK_BITS();
 		pxEventBits->uxEventBits |= uxBitsToSet;
+		eventUNLOCK_BITS();
+
+		#if( configUSE_EVENT_GROUP_INDEX == 1 )
+		{
+			/* A task waiting for a single indexed bit is blocked only while
+			that bit is clear, so only the lists of the bits being set need
+			looking at, and every task on them is unblocked.  uxIndexedBits
+			can have bits set for lists that have since emptied because their
+			tasks timed out, so it is corrected as the lists are visited. */
+			uxBitsToCheck = uxBitsToSet & pxEventBits->uxIndexedBits;
+
+			while( uxBitsToCheck != ( EventBits_t ) 0 )
+			{
+				uxBit = uxBitsToCheck & ( ~uxBitsToCheck + ( EventBits_t ) 1U );
+				uxBitsToCheck &= ~uxBit;
+				pxBitList = &( pxEventBits->xTasksWaitingForBit[ prvLowestSetBit( uxBit ) ] );
+
+				eventLOCK_BITS();
+
+				while( listLIST_IS_EMPTY( pxBitList ) == pdFALSE )
+				{
+					pxNext = listGET_HEAD_ENTRY( pxBitList );
+
+					if( ( listGET_LIST_ITEM_VALUE( pxNext ) & eventCLEAR_EVENTS_ON_EXIT_BIT ) != ( EventBits_t ) 0 )
+					{
+						uxBitsToClear |= uxBit;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					vTaskRemoveFromUnorderedEventList( pxNext, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET );
+				}
+
+				pxEventBits->uxIndexedBits &= ~uxBit;
+
+				eventUNLOCK_BITS();
+			}
+
+			/* The tasks on xTasksWaitingForBits wait for several bits, or for
+			bits that are not indexed.  The condition they are waiting for can
+			only have become true if one of their bits is being set, so the list
+			is not walked at all if none are. */
+			if( ( uxBitsToSet & pxEventBits->uxWaitedBits ) == ( EventBits_t ) 0 )
+			{
+				pxListItem = ( ListItem_t * ) pxListEnd; /*lint !e9005 The end marker is only compared against, never written through. */
+				uxStillWaitedFor = pxEventBits->uxWaitedBits;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_EVENT_GROUP_INDEX */
 
 		/* See if the new bit value should unblock any tasks. */
 		while( pxListItem != pxListEnd )
@@ -593,6 +801,21 @@ BaseType_t xMatchFound = pdFALSE;
 				than because it timed out. */
 				vTaskRemoveFromUnorderedEventList( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET );
 			}
+			else
+			{
+				#if( configUSE_EVENT_GROUP_INDEX == 1 )
+				{
+					/* Rebuild the record of the bits still waited for as the
+					list is walked, so it does not keep the bits of tasks that
+					have left the list. */
+					uxStillWaitedFor |= uxBitsWaitedFor;
+				}
+				#else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+				#endif
+			}
 
 			/* Move onto the next list item.  Note pxListItem->pxNext is not
 			used here as the list item may have been removed from the event list
@@ -600,9 +823,17 @@ BaseType_t xMatchFound = pdFALSE;
 			pxListItem = pxNext;
 		}
 
+		#if( configUSE_EVENT_GROUP_INDEX == 1 )
+		{
+			pxEventBits->uxWaitedBits = uxStillWaitedFor;
+		}
+		#endif
+
 		/* Clear any bits that matched when the eventCLEAR_EVENTS_ON_EXIT_BIT
 		bit was set in the control word. */
+		eventLOCK_BITS();
 		pxEventBits->uxEventBits &= ~uxBitsToClear;
+		eventUNLOCK_BITS();
 	}
 	( void ) xTaskResumeAll();
 
@@ -614,6 +845,9 @@ void vEventGroupDelete( EventGroupHandle_t xEventGroup )
 {
 EventGroup_t *pxEventBits = xEventGroup;
 const List_t *pxTasksWaitingForBits = &( pxEventBits->xTasksWaitingForBits );
+#if( configUSE_EVENT_GROUP_INDEX == 1 )
+	UBaseType_t uxBit;
+#endif
 
 	vTaskSuspendAll();
 	{
@@ -627,6 +861,21 @@ const List_t *pxTasksWaitingForBits = &( pxEventBits->xTasksWaitingForBits );
 			vTaskRemoveFromUnorderedEventList( pxTasksWaitingForBits->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
 		}
 
+		#if( configUSE_EVENT_GROUP_INDEX == 1 )
+		{
+			/* The same for the tasks waiting for a single indexed bit. */
+			for( uxBit = 0; uxBit < ( UBaseType_t ) configEVENT_GROUP_INDEXED_BITS; uxBit++ )
+			{
+				pxTasksWaitingForBits = &( pxEventBits->xTasksWaitingForBit[ uxBit ] );
+
+				while( listCURRENT_LIST_LENGTH( pxTasksWaitingForBits ) > ( UBaseType_t ) 0 )
+				{
+					vTaskRemoveFromUnorderedEventList( pxTasksWaitingForBits->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
+				}
+			}
+		}
+		#endif /* configUSE_EVENT_GROUP_INDEX */
+
 		#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
 		{
 			/* The event group can only have been allocated dynamically - free
@@ -703,7 +952,249 @@ BaseType_t xWaitConditionMet = pdFALSE;
 }
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
+static void prvPlaceOnWaitingList( EventGroup_t *pxEventBits, const EventBits_t uxBitsToWaitFor, const EventBits_t uxControlBits, const TickType_t xTicksToWait )
+{
+	#if( configUSE_EVENT_GROUP_INDEX == 1 )
+	{
+		if( ( ( uxBitsToWaitFor & ( uxBitsToWaitFor - ( EventBits_t ) 1U ) ) == ( EventBits_t ) 0 ) && ( ( uxBitsToWaitFor & eventINDEXED_BITS ) != ( EventBits_t ) 0 ) )
+		{
+			/* Waiting for one indexed bit.  Waiting for all or any of a single
+			bit is the same thing, so the task is unblocked as soon as the bit
+			is set. */
+			pxEventBits->uxIndexedBits |= uxBitsToWaitFor;
+			vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBit[ prvLowestSetBit( uxBitsToWaitFor ) ] ), ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
+		}
+		else
+		{
+			pxEventBits->uxWaitedBits |= uxBitsToWaitFor;
+			vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
+		}
+	}
+	#else
+	{
+		vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
+	}
+	#endif /* configUSE_EVENT_GROUP_INDEX */
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_EVENT_GROUP_INDEX == 1 )
+
+	static void prvInitialiseBitIndex( EventGroup_t *pxEventBits )
+	{
+	UBaseType_t uxBit;
+
+		pxEventBits->uxWaitedBits = 0;
+		pxEventBits->uxIndexedBits = 0;
+
+		#if( configUSE_EVENT_GROUP_ISR_SET == 1 )
+		{
+			pxEventBits->uxDeferredFromISR = 0;
+		}
+		#endif
+
+		for( uxBit = 0; uxBit < ( UBaseType_t ) configEVENT_GROUP_INDEXED_BITS; uxBit++ )
+		{
+			vListInitialise( &( pxEventBits->xTasksWaitingForBit[ uxBit ] ) );
+		}
+	}
+
+#endif /* configUSE_EVENT_GROUP_INDEX */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_EVENT_GROUP_INDEX == 1 )
+
+	static UBaseType_t prvLowestSetBit( EventBits_t uxValue )
+	{
+	static const uint8_t ucBitPosition[ 32 ] =
+	{
+		0, 1, 28, 2, 29, 14, 24, 3, 30, 22, 20, 15, 25, 17, 4, 8,
+		31, 27, 13, 23, 21, 19, 16, 7, 26, 12, 18, 6, 11, 5, 10, 9
+	};
+	uint32_t ulValue = ( uint32_t ) uxValue;
+
+		configASSERT( ulValue != 0UL );
+
+		/* Isolate the least significant set bit, so the value is 2 ^ n.
+		Multiplying by a De Bruijn constant then shifts a unique pattern for
+		each n into the top five bits. */
+		ulValue &= ( ~ulValue + 1UL );
+
+		return ( UBaseType_t ) ucBitPosition[ ( uint32_t ) ( ulValue * 0x077CB531UL ) >> 27 ];
+	}
+
+#endif /* configUSE_EVENT_GROUP_INDEX */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EVENT_GROUP_ISR_SET == 1 )
+
+	BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet, BaseType_t *pxHigherPriorityTaskWoken )
+	{
+	EventGroup_t *pxEventBits = xEventGroup;
+	List_t *pxBitList;
+	ListItem_t *pxListItem;
+	EventBits_t uxBitsToCheck, uxBit, uxBitsToClear = 0;
+	UBaseType_t uxSavedInterruptStatus, uxTasksToWake = 0;
+	BaseType_t xSetDirectly = pdFALSE, xTaskWoken = pdFALSE, xReturn = pdPASS;
+
+		configASSERT( xEventGroup );
+		configASSERT( ( uxBitsToSet & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
+
+		traceEVENT_GROUP_SET_BITS_FROM_ISR( xEventGroup, uxBitsToSet );
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			/* The bits are set here only if that can be done in bounded time:
+			no task on xTasksWaitingForBits waits for any of them, as that list
+			can be any length and is only walked by task level code, and no
+			more than configEVENT_GROUP_ISR_WAKE_LIMIT tasks wait on the indexed
+			bits being set.  Otherwise the whole set is deferred to the timer
+			daemon task, as it is when configUSE_EVENT_GROUP_ISR_SET is 0.  It
+			is also deferred while an earlier set or clear from an interrupt is
+			still queued, so they are applied in the order they were made. */
+			if( ( ( uxBitsToSet & pxEventBits->uxWaitedBits ) == ( EventBits_t ) 0 ) && ( pxEventBits->uxDeferredFromISR == ( UBaseType_t ) 0 ) )
+			{
+				uxBitsToCheck = uxBitsToSet & pxEventBits->uxIndexedBits;
+
+				while( uxBitsToCheck != ( EventBits_t ) 0 )
+				{
+					uxBit = uxBitsToCheck & ( ~uxBitsToCheck + ( EventBits_t ) 1U );
+					uxBitsToCheck &= ~uxBit;
+					uxTasksToWake += listCURRENT_LIST_LENGTH( &( pxEventBits->xTasksWaitingForBit[ prvLowestSetBit( uxBit ) ] ) );
+				}
+
+				if( uxTasksToWake <= ( UBaseType_t ) configEVENT_GROUP_ISR_WAKE_LIMIT )
+				{
+					xSetDirectly = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( xSetDirectly != pdFALSE )
+			{
+				pxEventBits->uxEventBits |= uxBitsToSet;
+
+				/* As the indexed part of xEventGroupSetBits(). */
+				uxBitsToCheck = uxBitsToSet & pxEventBits->uxIndexedBits;
+
+				while( uxBitsToCheck != ( EventBits_t ) 0 )
+				{
+					uxBit = uxBitsToCheck & ( ~uxBitsToCheck + ( EventBits_t ) 1U );
+					uxBitsToCheck &= ~uxBit;
+					pxBitList = &( pxEventBits->xTasksWaitingForBit[ prvLowestSetBit( uxBit ) ] );
+
+					while( listLIST_IS_EMPTY( pxBitList ) == pdFALSE )
+					{
+						pxListItem = listGET_HEAD_ENTRY( pxBitList );
+
+						if( ( listGET_LIST_ITEM_VALUE( pxListItem ) & eventCLEAR_EVENTS_ON_EXIT_BIT ) != ( EventBits_t ) 0 )
+						{
+							uxBitsToClear |= uxBit;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+
+						if( xTaskRemoveFromUnorderedEventListFromISR( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET ) != pdFALSE )
+						{
+							xTaskWoken = pdTRUE;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+
+					pxEventBits->uxIndexedBits &= ~uxBit;
+				}
+
+				pxEventBits->uxEventBits &= ~uxBitsToClear;
+			}
+			else
+			{
+				( pxEventBits->uxDeferredFromISR )++;
+			}
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		if( xSetDirectly == pdFALSE )
+		{
+			xReturn = prvDeferFromISR( pxEventBits, prvDeferredSetBitsCallback, uxBitsToSet, pxHigherPriorityTaskWoken );
+		}
+		else if( ( xTaskWoken != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+		{
+			*pxHigherPriorityTaskWoken = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	static BaseType_t prvDeferFromISR( EventGroup_t *pxEventBits, PendedFunction_t pxCallback, const EventBits_t uxBits, BaseType_t *pxHigherPriorityTaskWoken )
+	{
+	UBaseType_t uxSavedInterruptStatus;
+	BaseType_t xReturn;
+
+		xReturn = xTimerPendFunctionCallFromISR( pxCallback, ( void * ) pxEventBits, ( uint32_t ) uxBits, pxHigherPriorityTaskWoken ); /*lint !e9087 Can't avoid cast to void* as a generic callback function not specific to this use case. Callback casts back to original type so safe. */
+
+		if( xReturn == pdFAIL )
+		{
+			uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+			{
+				( pxEventBits->uxDeferredFromISR )--;
+			}
+			portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvDeferredSetBitsCallback( void *pvEventGroup, const uint32_t ulBitsToSet )
+	{
+	EventGroup_t *pxEventBits = pvEventGroup; /*lint !e9079 Can't avoid cast to void* as a generic timer callback prototype. Callback casts back to original type so safe. */
+
+		( void ) xEventGroupSetBits( pxEventBits, ( EventBits_t ) ulBitsToSet );
+
+		/* Only now can interrupts set or clear bits directly again. */
+		taskENTER_CRITICAL();
+		{
+			( pxEventBits->uxDeferredFromISR )--;
+		}
+		taskEXIT_CRITICAL();
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvDeferredClearBitsCallback( void *pvEventGroup, const uint32_t ulBitsToClear )
+	{
+	EventGroup_t *pxEventBits = pvEventGroup; /*lint !e9079 Can't avoid cast to void* as a generic timer callback prototype. Callback casts back to original type so safe. */
+
+		( void ) xEventGroupClearBits( pxEventBits, ( EventBits_t ) ulBitsToClear );
+
+		taskENTER_CRITICAL();
+		{
+			( pxEventBits->uxDeferredFromISR )--;
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#elif ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
 
 	BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet, BaseType_t *pxHigherPriorityTaskWoken )
 	{
@@ -0,0 +1,754 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+/* This entire source file will be skipped if the application is not configured
+to include 64-bit event groups.  This #if is closed at the very bottom of this
+file. */
+#if( configUSE_64_BIT_EVENT_GROUPS == 1 )
+
+#include "event_groups64.h"
+
+/* Lint e961, e750 and e9021 are suppressed as a MISRA exception justified
+because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+for the header files above, but not in this file, in order to generate the
+correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021 See comment above. */
+
+/* The following bit fields convey control information in the 64-bit event
+item value of a waiting task, in the same way as the event list item value is
+used by event_groups.c. */
+#define event64CLEAR_EVENTS_ON_EXIT_BIT		0x0100000000000000ULL
+#define event64UNBLOCKED_DUE_TO_BIT_SET		0x0200000000000000ULL
+#define event64WAIT_FOR_ALL_BITS			0x0400000000000000ULL
+#define event64EVENT_BITS_CONTROL_BYTES		0xff00000000000000ULL
+
+/* Interrupts clear bits directly, and on a 32-bit MCU a 64-bit value takes two
+accesses to read or write, so uxEventBits and uxBitsSetFromISR are only
+accessed with interrupts masked. */
+typedef struct EventGroup64Def_t
+{
+	EventBits64_t uxEventBits;
+	List_t xTasksWaitingForBits;		/*< List of tasks waiting for a bit to be set. */
+	EventBits64_t uxBitsSetFromISR;		/*< Bits set from interrupts that the timer daemon task has not yet applied. */
+	BaseType_t xSetFromISRPending;		/*< pdTRUE while a call to apply uxBitsSetFromISR is queued for the timer daemon task. */
+
+	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+		uint8_t ucStaticallyAllocated; /*< Set to pdTRUE if the event group is statically allocated to ensure no attempt is made to free the memory. */
+	#endif
+} EventGroup64_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Initialise a newly allocated event group.
+ */
+static void prvInitialiseNewEventGroup64( EventGroup64_t *pxEventBits ) PRIVILEGED_FUNCTION;
+
+/*
+ * As prvTestWaitCondition() in event_groups.c.
+ */
+static BaseType_t prvTestWaitCondition64( const EventBits64_t uxCurrentEventBits, const EventBits64_t uxBitsToWaitFor, const BaseType_t xWaitForAllBits ) PRIVILEGED_FUNCTION;
+
+/*
+ * Executed by the timer daemon task to apply the bits set from interrupts.
+ */
+static void prvSetBitsFromISRCallback( void *pvEventGroup, uint32_t ulUnused ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	EventGroup64Handle_t xEventGroup64CreateStatic( StaticEventGroup64_t *pxEventGroupBuffer )
+	{
+	EventGroup64_t *pxEventBits;
+
+		/* A StaticEventGroup64_t object must be provided. */
+		configASSERT( pxEventGroupBuffer );
+
+		#if( configASSERT_DEFINED == 1 )
+		{
+			/* Sanity check that the size of the structure used to declare a
+			variable of type StaticEventGroup64_t equals the size of the real
+			event group structure. */
+			volatile size_t xSize = sizeof( StaticEventGroup64_t );
+			configASSERT( xSize == sizeof( EventGroup64_t ) );
+		} /*lint !e529 xSize is referenced if configASSERT() is defined. */
+		#endif /* configASSERT_DEFINED */
+
+		pxEventBits = ( EventGroup64_t * ) pxEventGroupBuffer; /*lint !e740 !e9087 EventGroup64_t and StaticEventGroup64_t are deliberately aliased for data hiding purposes and guaranteed to have the same size and alignment requirement - checked by configASSERT(). */
+
+		if( pxEventBits != NULL )
+		{
+			prvInitialiseNewEventGroup64( pxEventBits );
+
+			#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+			{
+				/* Both static and dynamic allocation can be used, so note that
+				this event group was created statically in case the event group
+				is later deleted. */
+				pxEventBits->ucStaticallyAllocated = pdTRUE;
+			}
+			#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pxEventBits;
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	EventGroup64Handle_t xEventGroup64Create( void )
+	{
+	EventGroup64_t *pxEventBits;
+
+		/* pvPortMalloc() returns memory aligned to portBYTE_ALIGNMENT, which
+		is at least the alignment of the 64-bit members on the supported
+		ports. */
+		pxEventBits = ( EventGroup64_t * ) pvPortMalloc( sizeof( EventGroup64_t ) ); /*lint !e9087 !e9079 see comment above. */
+
+		if( pxEventBits != NULL )
+		{
+			prvInitialiseNewEventGroup64( pxEventBits );
+
+			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+			{
+				/* Both static and dynamic allocation can be used, so note this
+				event group was allocated dynamically in case the event group
+				is later deleted. */
+				pxEventBits->ucStaticallyAllocated = pdFALSE;
+			}
+			#endif /* configSUPPORT_STATIC_ALLOCATION */
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pxEventBits;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+EventBits64_t xEventGroup64Sync( EventGroup64Handle_t xEventGroup, const EventBits64_t uxBitsToSet, const EventBits64_t uxBitsToWaitFor, TickType_t xTicksToWait )
+{
+EventBits64_t uxOriginalBitValue, uxReturn;
+EventGroup64_t *pxEventBits = xEventGroup;
+BaseType_t xAlreadyYielded;
+
+	configASSERT( xEventGroup );
+	configASSERT( ( uxBitsToSet & event64EVENT_BITS_CONTROL_BYTES ) == 0 );
+	configASSERT( ( uxBitsToWaitFor & event64EVENT_BITS_CONTROL_BYTES ) == 0 );
+	configASSERT( uxBitsToWaitFor != 0 );
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
+
+	vTaskSuspendAll();
+	{
+		taskENTER_CRITICAL();
+		{
+			uxOriginalBitValue = pxEventBits->uxEventBits;
+		}
+		taskEXIT_CRITICAL();
+
+		( void ) xEventGroup64SetBits( xEventGroup, uxBitsToSet );
+
+		taskENTER_CRITICAL();
+		{
+			if( ( ( uxOriginalBitValue | uxBitsToSet ) & uxBitsToWaitFor ) == uxBitsToWaitFor )
+			{
+				/* All the rendezvous bits are now set - no need to block. */
+				uxReturn = ( uxOriginalBitValue | uxBitsToSet );
+
+				/* Rendezvous always clear the bits.  They will have been
+				cleared already unless this is the only task in the
+				rendezvous. */
+				pxEventBits->uxEventBits &= ~uxBitsToWaitFor;
+
+				xTicksToWait = 0;
+			}
+			else if( xTicksToWait != ( TickType_t ) 0 )
+			{
+				/* Store the bits that the calling task is waiting for so the
+				kernel knows when a match is found.  Then enter the blocked
+				state. */
+				vTaskPlaceOnUnorderedEventList64( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | event64CLEAR_EVENTS_ON_EXIT_BIT | event64WAIT_FOR_ALL_BITS ), xTicksToWait );
+
+				/* Set after the task unblocks. */
+				uxReturn = 0;
+			}
+			else
+			{
+				/* The rendezvous bits were not set, but no block time was
+				specified - just return the current event bit value. */
+				uxReturn = pxEventBits->uxEventBits;
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+	xAlreadyYielded = xTaskResumeAll();
+
+	if( xTicksToWait != ( TickType_t ) 0 )
+	{
+		if( xAlreadyYielded == pdFALSE )
+		{
+			portYIELD_WITHIN_API();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* Either the required bits were set, in which case the task's 64-bit
+		event item value holds the bits, or the block time expired. */
+		uxReturn = ullTaskResetEventItemValue64();
+
+		if( ( uxReturn & event64UNBLOCKED_DUE_TO_BIT_SET ) == ( EventBits64_t ) 0 )
+		{
+			/* The task timed out, just return the current event bit value. */
+			taskENTER_CRITICAL();
+			{
+				uxReturn = pxEventBits->uxEventBits;
+
+				/* The bits may have been set since the task unblocked, in
+				which case they are cleared before exiting. */
+				if( ( uxReturn & uxBitsToWaitFor ) == uxBitsToWaitFor )
+				{
+					pxEventBits->uxEventBits &= ~uxBitsToWaitFor;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			taskEXIT_CRITICAL();
+		}
+		else
+		{
+			/* The task unblocked because the bits were set. */
+		}
+
+		/* Control bits might be set as the task had blocked should not be
+		returned. */
+		uxReturn &= ~event64EVENT_BITS_CONTROL_BYTES;
+	}
+
+	return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+EventBits64_t xEventGroup64WaitBits( EventGroup64Handle_t xEventGroup, const EventBits64_t uxBitsToWaitFor, const BaseType_t xClearOnExit, const BaseType_t xWaitForAllBits, TickType_t xTicksToWait )
+{
+EventGroup64_t *pxEventBits = xEventGroup;
+EventBits64_t uxReturn, uxCurrentEventBits, uxControlBits = 0;
+BaseType_t xAlreadyYielded;
+
+	/* Check the user is not attempting to wait on the bits used by the kernel
+	itself, and that at least one bit is being requested. */
+	configASSERT( xEventGroup );
+	configASSERT( ( uxBitsToWaitFor & event64EVENT_BITS_CONTROL_BYTES ) == 0 );
+	configASSERT( uxBitsToWaitFor != 0 );
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
+
+	if( xClearOnExit != pdFALSE )
+	{
+		uxControlBits |= event64CLEAR_EVENTS_ON_EXIT_BIT;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( xWaitForAllBits != pdFALSE )
+	{
+		uxControlBits |= event64WAIT_FOR_ALL_BITS;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	vTaskSuspendAll();
+	taskENTER_CRITICAL();
+	{
+		uxCurrentEventBits = pxEventBits->uxEventBits;
+
+		if( prvTestWaitCondition64( uxCurrentEventBits, uxBitsToWaitFor, xWaitForAllBits ) != pdFALSE )
+		{
+			/* The wait condition has already been met so there is no need to
+			block. */
+			uxReturn = uxCurrentEventBits;
+			xTicksToWait = ( TickType_t ) 0;
+
+			/* Clear the wait bits if requested to do so. */
+			if( xClearOnExit != pdFALSE )
+			{
+				pxEventBits->uxEventBits &= ~uxBitsToWaitFor;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else if( xTicksToWait == ( TickType_t ) 0 )
+		{
+			/* The wait condition has not been met, but no block time was
+			specified, so just return the current value. */
+			uxReturn = uxCurrentEventBits;
+		}
+		else
+		{
+			/* Store the bits that the calling task is waiting for so the
+			kernel knows when a match is found.  Then enter the blocked
+			state. */
+			vTaskPlaceOnUnorderedEventList64( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
+
+			/* Set after the task unblocks. */
+			uxReturn = 0;
+		}
+	}
+	taskEXIT_CRITICAL();
+	xAlreadyYielded = xTaskResumeAll();
+
+	if( xTicksToWait != ( TickType_t ) 0 )
+	{
+		if( xAlreadyYielded == pdFALSE )
+		{
+			portYIELD_WITHIN_API();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* Either the required bits were set, in which case the task's 64-bit
+		event item value holds the bits, or the block time expired. */
+		uxReturn = ullTaskResetEventItemValue64();
+
+		if( ( uxReturn & event64UNBLOCKED_DUE_TO_BIT_SET ) == ( EventBits64_t ) 0 )
+		{
+			taskENTER_CRITICAL();
+			{
+				/* The task timed out, just return the current event bit value. */
+				uxReturn = pxEventBits->uxEventBits;
+
+				/* It is possible that the event bits were updated between this
+				task leaving the Blocked state and running again. */
+				if( ( prvTestWaitCondition64( uxReturn, uxBitsToWaitFor, xWaitForAllBits ) != pdFALSE ) && ( xClearOnExit != pdFALSE ) )
+				{
+					pxEventBits->uxEventBits &= ~uxBitsToWaitFor;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			taskEXIT_CRITICAL();
+		}
+		else
+		{
+			/* The task unblocked because the bits were set. */
+		}
+
+		/* The task blocked so control bits may have been set. */
+		uxReturn &= ~event64EVENT_BITS_CONTROL_BYTES;
+	}
+
+	return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+EventBits64_t xEventGroup64ClearBits( EventGroup64Handle_t xEventGroup, const EventBits64_t uxBitsToClear )
+{
+EventGroup64_t *pxEventBits = xEventGroup;
+EventBits64_t uxReturn;
+
+	/* Check the user is not attempting to clear the bits used by the kernel
+	itself. */
+	configASSERT( xEventGroup );
+	configASSERT( ( uxBitsToClear & event64EVENT_BITS_CONTROL_BYTES ) == 0 );
+
+	taskENTER_CRITICAL();
+	{
+		/* The value returned is the event group value prior to the bits being
+		cleared. */
+		uxReturn = pxEventBits->uxEventBits;
+		pxEventBits->uxEventBits &= ~uxBitsToClear;
+	}
+	taskEXIT_CRITICAL();
+
+	return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+EventBits64_t xEventGroup64ClearBitsFromISR( EventGroup64Handle_t xEventGroup, const EventBits64_t uxBitsToClear )
+{
+EventGroup64_t *pxEventBits = xEventGroup;
+UBaseType_t uxSavedInterruptStatus;
+EventBits64_t uxReturn;
+
+	configASSERT( xEventGroup );
+	configASSERT( ( uxBitsToClear & event64EVENT_BITS_CONTROL_BYTES ) == 0 );
+
+	/* Clearing bits never unblocks a task, so unlike setting them it can be
+	done here rather than in the timer daemon task.  Bits set from an interrupt
+	but not yet applied are cleared too, so a clear is never undone by a set
+	made before it. */
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		uxReturn = pxEventBits->uxEventBits;
+		pxEventBits->uxEventBits &= ~uxBitsToClear;
+		pxEventBits->uxBitsSetFromISR &= ~uxBitsToClear;
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+EventBits64_t xEventGroup64GetBitsFromISR( EventGroup64Handle_t xEventGroup )
+{
+UBaseType_t uxSavedInterruptStatus;
+EventGroup64_t const * const pxEventBits = xEventGroup;
+EventBits64_t uxReturn;
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		uxReturn = pxEventBits->uxEventBits;
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	return uxReturn;
+} /*lint !e818 EventGroup64Handle_t is a typedef used in other functions to so can't be pointer to const. */
+/*-----------------------------------------------------------*/
+
+EventBits64_t xEventGroup64SetBits( EventGroup64Handle_t xEventGroup, const EventBits64_t uxBitsToSet )
+{
+ListItem_t *pxListItem, *pxNext;
+ListItem_t const *pxListEnd;
+List_t const * pxList;
+EventBits64_t uxEventBits, uxBitsToClear = 0, uxBitsWaitedFor, uxControlBits;
+EventGroup64_t *pxEventBits = xEventGroup;
+BaseType_t xMatchFound;
+
+	/* Check the user is not attempting to set the bits used by the kernel
+	itself. */
+	configASSERT( xEventGroup );
+	configASSERT( ( uxBitsToSet & event64EVENT_BITS_CONTROL_BYTES ) == 0 );
+
+	pxList = &( pxEventBits->xTasksWaitingForBits );
+	pxListEnd = listGET_END_MARKER( pxList ); /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+	vTaskSuspendAll();
+	{
+		pxListItem = listGET_HEAD_ENTRY( pxList );
+
+		/* Set the bits.  The waiting tasks are tested against a copy, as with
+		the scheduler suspended only an interrupt clearing bits can change the
+		bits, and a task is then unblocked as if the clear came afterwards. */
+		taskENTER_CRITICAL();
+		{
+			pxEventBits->uxEventBits |= uxBitsToSet;
+			uxEventBits = pxEventBits->uxEventBits;
+		}
+		taskEXIT_CRITICAL();
+
+		/* See if the new bit value should unblock any tasks. */
+		while( pxListItem != pxListEnd )
+		{
+			pxNext = listGET_NEXT( pxListItem );
+			uxBitsWaitedFor = ullTaskGetEventItemValue64( pxListItem );
+			xMatchFound = pdFALSE;
+
+			/* Split the bits waited for from the control bits. */
+			uxControlBits = uxBitsWaitedFor & event64EVENT_BITS_CONTROL_BYTES;
+			uxBitsWaitedFor &= ~event64EVENT_BITS_CONTROL_BYTES;
+
+			if( ( uxControlBits & event64WAIT_FOR_ALL_BITS ) == ( EventBits64_t ) 0 )
+			{
+				/* Just looking for single bit being set. */
+				if( ( uxBitsWaitedFor & uxEventBits ) != ( EventBits64_t ) 0 )
+				{
+					xMatchFound = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else if( ( uxBitsWaitedFor & uxEventBits ) == uxBitsWaitedFor )
+			{
+				/* All bits are set. */
+				xMatchFound = pdTRUE;
+			}
+			else
+			{
+				/* Need all bits to be set, but not all the bits were set. */
+			}
+
+			if( xMatchFound != pdFALSE )
+			{
+				/* The bits match.  Should the bits be cleared on exit? */
+				if( ( uxControlBits & event64CLEAR_EVENTS_ON_EXIT_BIT ) != ( EventBits64_t ) 0 )
+				{
+					uxBitsToClear |= uxBitsWaitedFor;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				/* Store the actual event flag value in the task's 64-bit event
+				item value before removing the task from the event list, with
+				event64UNBLOCKED_DUE_TO_BIT_SET set so the task knows it did not
+				time out. */
+				vTaskRemoveFromUnorderedEventList64( pxListItem, uxEventBits | event64UNBLOCKED_DUE_TO_BIT_SET );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* Move onto the next list item.  Note pxListItem->pxNext is not
+			used here as the list item may have been removed from the event list
+			and inserted into the ready/pending reading list. */
+			pxListItem = pxNext;
+		}
+
+		/* Clear any bits that matched when the event64CLEAR_EVENTS_ON_EXIT_BIT
+		bit was set in the control word. */
+		taskENTER_CRITICAL();
+		{
+			pxEventBits->uxEventBits &= ~uxBitsToClear;
+			uxEventBits = pxEventBits->uxEventBits;
+		}
+		taskEXIT_CRITICAL();
+	}
+	( void ) xTaskResumeAll();
+
+	return uxEventBits;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xEventGroup64SetBitsFromISR( EventGroup64Handle_t xEventGroup, const EventBits64_t uxBitsToSet, BaseType_t *pxHigherPriorityTaskWoken )
+{
+EventGroup64_t *pxEventBits = xEventGroup;
+UBaseType_t uxSavedInterruptStatus;
+BaseType_t xSendCall = pdFALSE, xReturn = pdPASS;
+
+	configASSERT( xEventGroup );
+	configASSERT( ( uxBitsToSet & event64EVENT_BITS_CONTROL_BYTES ) == 0 );
+
+	/* The bits do not fit in the uint32_t parameter of a pended function
+	call, so they are collected here and the call only names the event
+	group.  Only one call is queued at a time. */
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		pxEventBits->uxBitsSetFromISR |= uxBitsToSet;
+
+		if( pxEventBits->xSetFromISRPending == pdFALSE )
+		{
+			pxEventBits->xSetFromISRPending = pdTRUE;
+			xSendCall = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	if( xSendCall != pdFALSE )
+	{
+		xReturn = xTimerPendFunctionCallFromISR( prvSetBitsFromISRCallback, ( void * ) pxEventBits, 0, pxHigherPriorityTaskWoken ); /*lint !e9087 Can't avoid cast to void* as a generic callback function not specific to this use case. Callback casts back to original type so safe. */
+
+		if( xReturn == pdFAIL )
+		{
+			/* The bits stay in uxBitsSetFromISR for the next call that
+			gets into the queue. */
+			uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+			{
+				pxEventBits->xSetFromISRPending = pdFALSE;
+			}
+			portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vEventGroup64Delete( EventGroup64Handle_t xEventGroup )
+{
+EventGroup64_t *pxEventBits = xEventGroup;
+const List_t *pxTasksWaitingForBits = &( pxEventBits->xTasksWaitingForBits );
+
+	vTaskSuspendAll();
+	{
+		while( listCURRENT_LIST_LENGTH( pxTasksWaitingForBits ) > ( UBaseType_t ) 0 )
+		{
+			/* Unblock the task, returning 0 as the event list is being deleted
+			and cannot therefore have any bits set. */
+			configASSERT( pxTasksWaitingForBits->xListEnd.pxNext != ( const ListItem_t * ) &( pxTasksWaitingForBits->xListEnd ) );
+			vTaskRemoveFromUnorderedEventList64( pxTasksWaitingForBits->xListEnd.pxNext, event64UNBLOCKED_DUE_TO_BIT_SET );
+		}
+
+		#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+		{
+			/* The event group can only have been allocated dynamically - free
+			it again. */
+			vPortFree( pxEventBits );
+		}
+		#elif( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+		{
+			/* The event group could have been allocated statically or
+			dynamically, so check before attempting to free the memory. */
+			if( pxEventBits->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+			{
+				vPortFree( pxEventBits );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+	}
+	( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+static void prvSetBitsFromISRCallback( void *pvEventGroup, uint32_t ulUnused )
+{
+EventGroup64_t *pxEventBits = ( EventGroup64_t * ) pvEventGroup; /*lint !e9079 Can't avoid cast to void* as a generic timer callback prototype. Callback casts back to original type so safe. */
+EventBits64_t uxBitsToSet;
+
+	( void ) ulUnused;
+
+	/* Take the bits and allow interrupts to queue another call, which then
+	applies any bits set from here on. */
+	taskENTER_CRITICAL();
+	{
+		uxBitsToSet = pxEventBits->uxBitsSetFromISR;
+		pxEventBits->uxBitsSetFromISR = 0;
+		pxEventBits->xSetFromISRPending = pdFALSE;
+	}
+	taskEXIT_CRITICAL();
+
+	if( uxBitsToSet != ( EventBits64_t ) 0 )
+	{
+		( void ) xEventGroup64SetBits( pxEventBits, uxBitsToSet );
+	}
+	else
+	{
+		/* An interrupt cleared the bits before they were applied. */
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvTestWaitCondition64( const EventBits64_t uxCurrentEventBits, const EventBits64_t uxBitsToWaitFor, const BaseType_t xWaitForAllBits )
+{
+BaseType_t xWaitConditionMet = pdFALSE;
+
+	if( xWaitForAllBits == pdFALSE )
+	{
+		/* Task only has to wait for one bit within uxBitsToWaitFor to be
+		set.  Is one already set? */
+		if( ( uxCurrentEventBits & uxBitsToWaitFor ) != ( EventBits64_t ) 0 )
+		{
+			xWaitConditionMet = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		/* Task has to wait for all the bits in uxBitsToWaitFor to be set.
+		Are they set already? */
+		if( ( uxCurrentEventBits & uxBitsToWaitFor ) == uxBitsToWaitFor )
+		{
+			xWaitConditionMet = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	return xWaitConditionMet;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewEventGroup64( EventGroup64_t *pxEventBits )
+{
+	pxEventBits->uxEventBits = 0;
+	pxEventBits->uxBitsSetFromISR = 0;
+	pxEventBits->xSetFromISRPending = pdFALSE;
+	vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
+}
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+to include 64-bit event groups.  This #if is closed at the very bottom of this
+file. */
+#endif /* configUSE_64_BIT_EVENT_GROUPS == 1 */
@@ -198,6 +198,14 @@ extern "C" {
 	#define configNUM_THREAD_LOCAL_STORAGE_POINTERS 0
 #endif
 
+#ifndef configTHREAD_LOCAL_STORAGE_DELETE_CALLBACKS
+	#define configTHREAD_LOCAL_STORAGE_DELETE_CALLBACKS 0
+#endif
+
+#if( ( configTHREAD_LOCAL_STORAGE_DELETE_CALLBACKS == 1 ) && ( configNUM_THREAD_LOCAL_STORAGE_POINTERS == 0 ) )
+	#error configTHREAD_LOCAL_STORAGE_DELETE_CALLBACKS requires configNUM_THREAD_LOCAL_STORAGE_POINTERS to be greater than 0.
+#endif
+
 #ifndef configUSE_RECURSIVE_MUTEXES
 	#define configUSE_RECURSIVE_MUTEXES 0
 #endif
@@ -734,6 +742,14 @@ hold explicit before calling the code. */
 	#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
 #endif
 
+#ifndef configRUN_TIME_COUNTER_TYPE
+	/* Defaults to uint32_t for backward compatibility, but can be overridden in
+	FreeRTOSConfig.h if uint32_t is too restrictive.  When a 64-bit type is used
+	portGET_RUN_TIME_COUNTER_VALUE() must also return a counter that does not
+	wrap, as the accumulated run times are calculated from its differences. */
+	#define configRUN_TIME_COUNTER_TYPE uint32_t
+#endif
+
 #ifndef configUSE_MALLOC_FAILED_HOOK
 	#define configUSE_MALLOC_FAILED_HOOK 0
 #endif
@@ -762,6 +778,18 @@ hold explicit before calling the code. */
 	#define configUSE_TICKLESS_IDLE 0
 #endif
 
+#ifndef configUSE_TICKLESS_TIMER
+	#define configUSE_TICKLESS_TIMER 0
+#endif
+
+#if ( ( configUSE_TICKLESS_TIMER == 1 ) && ( configUSE_TICKLESS_IDLE == 0 ) )
+	#error configUSE_TICKLESS_TIMER requires configUSE_TICKLESS_IDLE to be set to 1
+#endif
+
+#if ( ( configUSE_TICKLESS_TIMER == 1 ) && !defined( configTICKLESS_TIMER_HZ ) )
+	#error configTICKLESS_TIMER_HZ must be set to the count rate of the tickless timer, a multiple of configTICK_RATE_HZ
+#endif
+
 #ifndef configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING
 	#define configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING( x )
 #endif
@@ -826,10 +854,148 @@ hold explicit before calling the code. */
 	#define configUSE_PORT_OPTIMISED_TASK_SELECTION 0
 #endif
 
+#ifndef configUSE_BITMAP_TASK_SELECTION
+	#define configUSE_BITMAP_TASK_SELECTION 0
+#endif
+
+#if ( ( configUSE_BITMAP_TASK_SELECTION == 1 ) && ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 1 ) )
+	#error configUSE_BITMAP_TASK_SELECTION is a replacement for the generic task selection, so configUSE_PORT_OPTIMISED_TASK_SELECTION must be 0 when it is used.
+#endif
+
+#if ( ( configUSE_BITMAP_TASK_SELECTION == 1 ) && ( configMAX_PRIORITIES > 1024 ) )
+	#error configUSE_BITMAP_TASK_SELECTION supports at most 1024 priorities (32 groups of 32).
+#endif
+
+#ifndef configUSE_DELAYED_TIMING_WHEEL
+	#define configUSE_DELAYED_TIMING_WHEEL 0
+#endif
+
+#ifndef configTIMING_WHEEL_SLOTS
+	#define configTIMING_WHEEL_SLOTS 64
+#endif
+
+#if ( ( configUSE_DELAYED_TIMING_WHEEL == 1 ) && ( ( configTIMING_WHEEL_SLOTS < 2 ) || ( ( configTIMING_WHEEL_SLOTS & ( configTIMING_WHEEL_SLOTS - 1 ) ) != 0 ) ) )
+	#error configTIMING_WHEEL_SLOTS must be a power of two.
+#endif
+
 #ifndef configAPPLICATION_ALLOCATED_HEAP
 	#define configAPPLICATION_ALLOCATED_HEAP 0
 #endif
 
+#ifndef configUSE_TLSF_HEAP
+	#define configUSE_TLSF_HEAP 0
+#endif
+
+#ifndef configUSE_QUEUE_ZERO_COPY
+	#define configUSE_QUEUE_ZERO_COPY 0
+#endif
+
+#ifndef configUSE_QUEUE_BATCH
+	#define configUSE_QUEUE_BATCH 0
+#endif
+
+#ifndef configUSE_QUEUE_PRIORITY
+	#define configUSE_QUEUE_PRIORITY 0
+#endif
+
+#ifndef configUSE_QUEUE_STATISTICS
+	#define configUSE_QUEUE_STATISTICS 0
+#endif
+
+#ifndef configUSE_MUTEX_FAST_PATH
+	#define configUSE_MUTEX_FAST_PATH 0
+#endif
+
+#if( ( configUSE_MUTEX_FAST_PATH == 1 ) && ( configUSE_MUTEXES != 1 ) )
+	#error configUSE_MUTEX_FAST_PATH requires configUSE_MUTEXES to be set to 1.
+#endif
+
+#ifndef configUSE_MUTEX_CEILING
+	#define configUSE_MUTEX_CEILING 0
+#endif
+
+#if( ( configUSE_MUTEX_CEILING == 1 ) && ( configUSE_MUTEXES != 1 ) )
+	#error configUSE_MUTEX_CEILING requires configUSE_MUTEXES to be set to 1.
+#endif
+
+#ifndef configCHECK_MUTEX_CEILING
+	#define configCHECK_MUTEX_CEILING 0
+#endif
+
+#ifndef configUSE_MUTEX_PROFILING
+	#define configUSE_MUTEX_PROFILING 0
+#endif
+
+#if( ( configUSE_MUTEX_PROFILING == 1 ) && ( configUSE_MUTEXES != 1 ) )
+	#error configUSE_MUTEX_PROFILING requires configUSE_MUTEXES to be set to 1.
+#endif
+
+#ifndef configMUTEX_PROFILE_COUNT
+	#define configMUTEX_PROFILE_COUNT 4
+#endif
+
+#ifndef configMUTEX_PROFILE_TASKS
+	#define configMUTEX_PROFILE_TASKS 3
+#endif
+
+#ifndef configMUTEX_PROFILE_BUCKETS
+	#define configMUTEX_PROFILE_BUCKETS 16
+#endif
+
+#ifndef configMUTEX_PROFILE_BUCKET_SHIFT
+	#define configMUTEX_PROFILE_BUCKET_SHIFT 6
+#endif
+
+#ifndef configUSE_EVENT_GROUP_INDEX
+	#define configUSE_EVENT_GROUP_INDEX 0
+#endif
+
+#ifndef configEVENT_GROUP_INDEXED_BITS
+	#define configEVENT_GROUP_INDEXED_BITS 8
+#endif
+
+#if( configUSE_EVENT_GROUP_INDEX == 1 )
+	#if( ( configEVENT_GROUP_INDEXED_BITS < 1 ) || ( ( configUSE_16_BIT_TICKS == 1 ) && ( configEVENT_GROUP_INDEXED_BITS > 8 ) ) || ( configEVENT_GROUP_INDEXED_BITS > 24 ) )
+		#error configEVENT_GROUP_INDEXED_BITS must be between 1 and the number of usable event bits (8 with 16-bit ticks, 24 otherwise).
+	#endif
+#endif
+
+#ifndef configUSE_EVENT_GROUP_ISR_SET
+	#define configUSE_EVENT_GROUP_ISR_SET 0
+#endif
+
+#if( ( configUSE_EVENT_GROUP_ISR_SET == 1 ) && ( configUSE_EVENT_GROUP_INDEX != 1 ) )
+	#error configUSE_EVENT_GROUP_ISR_SET requires configUSE_EVENT_GROUP_INDEX to be set to 1.
+#endif
+
+#if( ( configUSE_EVENT_GROUP_ISR_SET == 1 ) && ( ( configUSE_TIMERS != 1 ) || ( INCLUDE_xTimerPendFunctionCall != 1 ) ) )
+	#error configUSE_EVENT_GROUP_ISR_SET requires configUSE_TIMERS and INCLUDE_xTimerPendFunctionCall to be set to 1, to defer the sets it cannot complete in the interrupt.
+#endif
+
+#ifndef configEVENT_GROUP_ISR_WAKE_LIMIT
+	#define configEVENT_GROUP_ISR_WAKE_LIMIT 4
+#endif
+
+#ifndef configUSE_64_BIT_EVENT_GROUPS
+	#define configUSE_64_BIT_EVENT_GROUPS 0
+#endif
+
+#if( ( configUSE_64_BIT_EVENT_GROUPS == 1 ) && ( ( configUSE_TIMERS != 1 ) || ( INCLUDE_xTimerPendFunctionCall != 1 ) ) )
+	#error configUSE_64_BIT_EVENT_GROUPS requires configUSE_TIMERS and INCLUDE_xTimerPendFunctionCall to be set to 1, to apply bits set from interrupts.
+#endif
+
+#ifndef configUSE_STREAM_BUFFER_ZERO_COPY
+	#define configUSE_STREAM_BUFFER_ZERO_COPY 0
+#endif
+
+#ifndef configUSE_STREAM_BUFFER_MULTI_PRODUCER
+	#define configUSE_STREAM_BUFFER_MULTI_PRODUCER 0
+#endif
+
+#if( ( configUSE_STREAM_BUFFER_MULTI_PRODUCER == 1 ) && ( configUSE_STREAM_BUFFER_ZERO_COPY != 1 ) )
+	#error configUSE_STREAM_BUFFER_MULTI_PRODUCER requires configUSE_STREAM_BUFFER_ZERO_COPY to be set to 1, for StreamBufferRegion_t.
+#endif
+
 #ifndef configUSE_TASK_NOTIFICATIONS
 	#define configUSE_TASK_NOTIFICATIONS 1
 #endif
@@ -1131,14 +1297,20 @@ typedef struct xSTATIC_TCB
 	#if ( configUSE_MUTEXES == 1 )
 		UBaseType_t		uxDummy12[ 2 ];
 	#endif
+	#if ( configUSE_MUTEX_CEILING == 1 )
+		UBaseType_t		uxDummy13;
+	#endif
 	#if ( configUSE_APPLICATION_TASK_TAG == 1 )
 		void			*pxDummy14;
 	#endif
 	#if( configNUM_THREAD_LOCAL_STORAGE_POINTERS > 0 )
 		void			*pvDummy15[ configNUM_THREAD_LOCAL_STORAGE_POINTERS ];
+		#if ( configTHREAD_LOCAL_STORAGE_DELETE_CALLBACKS == 1 )
+			void		*pvDummy15Callbacks[ configNUM_THREAD_LOCAL_STORAGE_POINTERS ];
+		#endif
 	#endif
 	#if ( configGENERATE_RUN_TIME_STATS == 1 )
-		uint32_t		ulDummy16;
+		configRUN_TIME_COUNTER_TYPE		ulDummy16;
 	#endif
 	#if ( configUSE_NEWLIB_REENTRANT == 1 )
 		struct	_reent	xDummy17;
@@ -1157,6 +1329,9 @@ typedef struct xSTATIC_TCB
 	#if ( configUSE_POSIX_ERRNO == 1 )
 		int				iDummy22;
 	#endif
+	#if( configUSE_64_BIT_EVENT_GROUPS == 1 )
+		uint64_t		ullDummy23;
+	#endif
 } StaticTask_t;
 
 /*
@@ -1200,6 +1375,34 @@ typedef struct xSTATIC_QUEUE
 		uint8_t ucDummy9;
 	#endif
 
+	#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+		void *pvDummy10[ 2 ];
+	#endif
+
+	#if ( configUSE_QUEUE_PRIORITY == 1 )
+		void *pvDummy11;
+		uint32_t ulDummy12;
+		uint8_t ucDummy13;
+	#endif
+
+	#if ( configUSE_QUEUE_STATISTICS == 1 )
+		uint32_t ulDummy14[ 4 ];
+		configRUN_TIME_COUNTER_TYPE ulDummy15[ 2 ];
+		UBaseType_t uxDummy16;
+	#endif
+
+	#if ( configUSE_MUTEX_FAST_PATH == 1 )
+		portPOINTER_SIZE_TYPE uxDummy17;
+	#endif
+
+	#if ( configUSE_MUTEX_CEILING == 1 )
+		UBaseType_t uxDummy18[ 3 ];
+	#endif
+
+	#if ( configUSE_MUTEX_PROFILING == 1 )
+		void *pvDummy19;
+	#endif
+
 } StaticQueue_t;
 typedef StaticQueue_t StaticSemaphore_t;
 
@@ -1222,6 +1425,15 @@ typedef struct xSTATIC_EVENT_GROUP
 	TickType_t xDummy1;
 	StaticList_t xDummy2;
 
+	#if( configUSE_EVENT_GROUP_INDEX == 1 )
+		TickType_t xDummy5[ 2 ];
+		StaticList_t xDummy6[ configEVENT_GROUP_INDEXED_BITS ];
+	#endif
+
+	#if( configUSE_EVENT_GROUP_ISR_SET == 1 )
+		UBaseType_t uxDummy7;
+	#endif
+
 	#if( configUSE_TRACE_FACILITY == 1 )
 		UBaseType_t uxDummy3;
 	#endif
@@ -1232,6 +1444,25 @@ typedef struct xSTATIC_EVENT_GROUP
 
 } StaticEventGroup_t;
 
+/*
+ * In line with StaticEventGroup_t, for the 64-bit event groups of
+ * event_groups64.h.
+ */
+#if( configUSE_64_BIT_EVENT_GROUPS == 1 )
+	typedef struct xSTATIC_EVENT_GROUP_64
+	{
+		uint64_t ullDummy1;
+		StaticList_t xDummy2;
+		uint64_t ullDummy3;
+		BaseType_t xDummy4;
+
+		#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+			uint8_t ucDummy5;
+		#endif
+
+	} StaticEventGroup64_t;
+#endif
+
 /*
  * In line with software engineering best practice, especially when supplying a
  * library that is likely to change in future versions, FreeRTOS implements a
@@ -1282,6 +1513,12 @@ typedef struct xSTATIC_STREAM_BUFFER
 	#if ( configUSE_TRACE_FACILITY == 1 )
 		UBaseType_t uxDummy4;
 	#endif
+	#if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+		size_t uxDummy5[ 2 ];
+	#endif
+	#if ( configUSE_STREAM_BUFFER_MULTI_PRODUCER == 1 )
+		size_t uxDummy6;
+	#endif
 } StaticStreamBuffer_t;
 
 /* Message buffers are built on stream buffers. */
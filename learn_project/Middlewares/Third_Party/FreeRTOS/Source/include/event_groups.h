@@ -369,6 +369,12 @@ EventBits_t xEventGroupClearBits( EventGroupHandle_t xEventGroup, const EventBit
  * timer task to have the clear operation performed in the context of the timer
  * task.
  *
+ * If configUSE_EVENT_GROUP_ISR_SET is set to 1 in FreeRTOSConfig.h the bits
+ * are cleared before xEventGroupClearBitsFromISR() returns, as clearing bits
+ * never unblocks a task.  The clear is only sent to the timer task if a set or
+ * clear made from an interrupt is still waiting there, so that the two are
+ * applied in the order in which they were made.
+ *
  * @param xEventGroup The event group in which the bits are to be cleared.
  *
  * @param uxBitsToClear A bitwise value that indicates the bit or bits to clear.
@@ -404,7 +410,7 @@ EventBits_t xEventGroupClearBits( EventGroupHandle_t xEventGroup, const EventBit
  * \defgroup xEventGroupClearBitsFromISR xEventGroupClearBitsFromISR
  * \ingroup EventGroup
  */
-#if( configUSE_TRACE_FACILITY == 1 )
+#if( ( configUSE_TRACE_FACILITY == 1 ) || ( configUSE_EVENT_GROUP_ISR_SET == 1 ) )
 	BaseType_t xEventGroupClearBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToClear ) PRIVILEGED_FUNCTION;
 #else
 	#define xEventGroupClearBitsFromISR( xEventGroup, uxBitsToClear ) xTimerPendFunctionCallFromISR( vEventGroupClearBitsCallback, ( void * ) xEventGroup, ( uint32_t ) uxBitsToClear, NULL )
@@ -500,6 +506,17 @@ EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup, const EventBits_
  * context of the timer task - where a scheduler lock is used in place of a
  * critical section.
  *
+ * If configUSE_EVENT_GROUP_ISR_SET is set to 1 in FreeRTOSConfig.h the bits
+ * are instead set in the interrupt itself, and the tasks waiting for them are
+ * unblocked directly, provided that can be done in bounded time: every task
+ * waiting for any of the bits must be waiting for a single indexed bit (see
+ * configUSE_EVENT_GROUP_INDEX), and there must be no more than
+ * configEVENT_GROUP_ISR_WAKE_LIMIT such tasks.  Otherwise the set is sent to
+ * the timer task as described above.  The unblocked task then runs straight
+ * from the interrupt, without first switching to the timer task.  The set is
+ * also sent to the timer task while a set or clear made from an interrupt is
+ * still waiting there.
+ *
  * @param xEventGroup The event group in which the bits are to be set.
  *
  * @param uxBitsToSet A bitwise value that indicates the bit or bits to set.
@@ -509,8 +526,9 @@ EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup, const EventBits_
  * @param pxHigherPriorityTaskWoken As mentioned above, calling this function
  * will result in a message being sent to the timer daemon task.  If the
  * priority of the timer daemon task is higher than the priority of the
- * currently running task (the task the interrupt interrupted) then
- * *pxHigherPriorityTaskWoken will be set to pdTRUE by
+ * currently running task (the task the interrupt interrupted), or if the bits
+ * were set directly and unblocked a task of higher priority than the running
+ * task, then *pxHigherPriorityTaskWoken will be set to pdTRUE by
  * xEventGroupSetBitsFromISR(), indicating that a context switch should be
  * requested before the interrupt exits.  For that reason
  * *pxHigherPriorityTaskWoken must be initialised to pdFALSE.  See the
@@ -556,7 +574,7 @@ EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup, const EventBits_
  * \defgroup xEventGroupSetBitsFromISR xEventGroupSetBitsFromISR
  * \ingroup EventGroup
  */
-#if( configUSE_TRACE_FACILITY == 1 )
+#if( ( configUSE_TRACE_FACILITY == 1 ) || ( configUSE_EVENT_GROUP_ISR_SET == 1 ) )
 	BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 #else
 	#define xEventGroupSetBitsFromISR( xEventGroup, uxBitsToSet, pxHigherPriorityTaskWoken ) xTimerPendFunctionCallFromISR( vEventGroupSetBitsCallback, ( void * ) xEventGroup, ( uint32_t ) uxBitsToSet, pxHigherPriorityTaskWoken )
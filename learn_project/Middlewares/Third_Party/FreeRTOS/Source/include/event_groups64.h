@@ -0,0 +1,249 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * 64-bit event groups work in the same way as the event groups of
+ * event_groups.h, but hold 56 event bits instead of 24, so a task can wait for
+ * any or all of up to 56 events in one call rather than having to split them
+ * across several event groups.  Bits 56 to 63 are used by the kernel and must
+ * not be set, cleared or waited for.
+ *
+ * A 64-bit value is not read or written in one access on a 32-bit MCU, so the
+ * bits are only ever accessed with interrupts masked.  Bits set from an
+ * interrupt are collected in the event group and applied by the timer daemon
+ * task, as xEventGroupSetBitsFromISR() does when
+ * configUSE_EVENT_GROUP_ISR_SET is 0.  Bits are cleared from an interrupt
+ * directly.
+ *
+ * configUSE_64_BIT_EVENT_GROUPS must be set to 1 in FreeRTOSConfig.h for
+ * 64-bit event groups to be available, which adds 8 bytes to every task's TCB.
+ * The trace macros are not called by 64-bit event groups.
+ */
+
+#ifndef EVENT_GROUPS_64_H
+#define EVENT_GROUPS_64_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include event_groups64.h"
+#endif
+
+#if( configUSE_64_BIT_EVENT_GROUPS != 1 )
+	#error configUSE_64_BIT_EVENT_GROUPS must be set to 1 in FreeRTOSConfig.h to use event_groups64.h
+#endif
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/**
+ * The type that holds the bits of a 64-bit event group.
+ */
+typedef uint64_t EventBits64_t;
+
+/**
+ * Type by which 64-bit event groups are referenced.  xEventGroup64Create()
+ * returns an EventGroup64Handle_t that is then passed to the other functions.
+ */
+struct EventGroup64Def_t;
+typedef struct EventGroup64Def_t * EventGroup64Handle_t;
+
+/**
+ * event_groups64.h
+ *
+<pre>
+EventGroup64Handle_t xEventGroup64Create( void );
+</pre>
+ *
+ * Creates a 64-bit event group, allocated from the FreeRTOS heap, with all its
+ * bits clear.
+ *
+ * @return The handle of the event group, or NULL if there was not enough heap.
+ */
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	EventGroup64Handle_t xEventGroup64Create( void ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * event_groups64.h
+ *
+<pre>
+EventGroup64Handle_t xEventGroup64CreateStatic( StaticEventGroup64_t *pxEventGroupBuffer );
+</pre>
+ *
+ * As xEventGroup64Create(), but the event group is held in
+ * *pxEventGroupBuffer.
+ *
+ * @return The handle of the event group.
+ */
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	EventGroup64Handle_t xEventGroup64CreateStatic( StaticEventGroup64_t *pxEventGroupBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * event_groups64.h
+ *
+<pre>
+EventBits64_t xEventGroup64WaitBits( EventGroup64Handle_t xEventGroup,
+                                     const EventBits64_t uxBitsToWaitFor,
+                                     const BaseType_t xClearOnExit,
+                                     const BaseType_t xWaitForAllBits,
+                                     TickType_t xTicksToWait );
+</pre>
+ *
+ * The 64-bit equivalent of xEventGroupWaitBits(), with the same parameters
+ * and behaviour.  uxBitsToWaitFor must not be 0 and must not have any of bits
+ * 56 to 63 set.
+ *
+ * @return The value of the event bits when the bits being waited for were set
+ * or the block time expired, before any were cleared by xClearOnExit.
+ */
+EventBits64_t xEventGroup64WaitBits( EventGroup64Handle_t xEventGroup, const EventBits64_t uxBitsToWaitFor, const BaseType_t xClearOnExit, const BaseType_t xWaitForAllBits, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * event_groups64.h
+ *
+<pre>
+EventBits64_t xEventGroup64ClearBits( EventGroup64Handle_t xEventGroup, const EventBits64_t uxBitsToClear );
+</pre>
+ *
+ * Clears bits in a 64-bit event group.  Must not be called from an interrupt.
+ *
+ * @return The value of the event bits before the bits were cleared.
+ */
+EventBits64_t xEventGroup64ClearBits( EventGroup64Handle_t xEventGroup, const EventBits64_t uxBitsToClear ) PRIVILEGED_FUNCTION;
+
+/**
+ * event_groups64.h
+ *
+<pre>
+EventBits64_t xEventGroup64ClearBitsFromISR( EventGroup64Handle_t xEventGroup, const EventBits64_t uxBitsToClear );
+</pre>
+ *
+ * Clears bits in a 64-bit event group from an interrupt.  The bits are cleared
+ * before the function returns, and bits set by xEventGroup64SetBitsFromISR()
+ * that the timer daemon task has not yet applied are cleared too.
+ *
+ * @return The value of the event bits before the bits were cleared.
+ */
+EventBits64_t xEventGroup64ClearBitsFromISR( EventGroup64Handle_t xEventGroup, const EventBits64_t uxBitsToClear ) PRIVILEGED_FUNCTION;
+
+/**
+ * event_groups64.h
+ *
+<pre>
+EventBits64_t xEventGroup64SetBits( EventGroup64Handle_t xEventGroup, const EventBits64_t uxBitsToSet );
+</pre>
+ *
+ * The 64-bit equivalent of xEventGroupSetBits().  Sets bits in a 64-bit event
+ * group and unblocks the tasks whose wait condition is then met.  Must not be
+ * called from an interrupt.
+ *
+ * @return The value of the event bits when the call returns, after bits have
+ * been cleared for the tasks that were unblocked with xClearOnExit set.
+ */
+EventBits64_t xEventGroup64SetBits( EventGroup64Handle_t xEventGroup, const EventBits64_t uxBitsToSet ) PRIVILEGED_FUNCTION;
+
+/**
+ * event_groups64.h
+ *
+<pre>
+BaseType_t xEventGroup64SetBitsFromISR( EventGroup64Handle_t xEventGroup, const EventBits64_t uxBitsToSet, BaseType_t *pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * Sets bits in a 64-bit event group from an interrupt.  The bits are added to
+ * those already waiting to be set, and a call to set them is sent to the timer
+ * daemon task if one is not already on its way, so any number of calls made
+ * before the daemon task runs use one place in the timer command queue.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if sending the call unblocked
+ * the timer daemon task and it has a priority above the interrupted task, in
+ * which case a context switch should be requested before the interrupt exits.
+ *
+ * @return pdPASS if the bits will be set.  pdFAIL if the timer command queue
+ * was full.  The bits are then held until the next successful call.
+ */
+BaseType_t xEventGroup64SetBitsFromISR( EventGroup64Handle_t xEventGroup, const EventBits64_t uxBitsToSet, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * event_groups64.h
+ *
+<pre>
+EventBits64_t xEventGroup64Sync( EventGroup64Handle_t xEventGroup,
+                                 const EventBits64_t uxBitsToSet,
+                                 const EventBits64_t uxBitsToWaitFor,
+                                 TickType_t xTicksToWait );
+</pre>
+ *
+ * The 64-bit equivalent of xEventGroupSync().  Sets uxBitsToSet and then waits
+ * for all of uxBitsToWaitFor to be set, clearing them when they are.
+ *
+ * @return The value of the event bits when the wait condition was met or the
+ * block time expired, before the bits were cleared.
+ */
+EventBits64_t xEventGroup64Sync( EventGroup64Handle_t xEventGroup, const EventBits64_t uxBitsToSet, const EventBits64_t uxBitsToWaitFor, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * event_groups64.h
+ *
+<pre>
+EventBits64_t xEventGroup64GetBits( EventGroup64Handle_t xEventGroup );
+</pre>
+ *
+ * @return The current value of the event bits.  Must not be called from an
+ * interrupt.
+ */
+#define xEventGroup64GetBits( xEventGroup ) xEventGroup64ClearBits( ( xEventGroup ), 0 )
+
+/**
+ * event_groups64.h
+ *
+<pre>
+EventBits64_t xEventGroup64GetBitsFromISR( EventGroup64Handle_t xEventGroup );
+</pre>
+ *
+ * @return The current value of the event bits.
+ */
+EventBits64_t xEventGroup64GetBitsFromISR( EventGroup64Handle_t xEventGroup ) PRIVILEGED_FUNCTION;
+
+/**
+ * event_groups64.h
+ *
+<pre>
+void vEventGroup64Delete( EventGroup64Handle_t xEventGroup );
+</pre>
+ *
+ * Deletes a 64-bit event group.  Tasks blocked on the event group are
+ * unblocked and return 0.  The event group must not be deleted while an
+ * interrupt may still set bits in it.
+ */
+void vEventGroup64Delete( EventGroup64Handle_t xEventGroup ) PRIVILEGED_FUNCTION;
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* EVENT_GROUPS_64_H */
@@ -796,6 +796,106 @@ BaseType_t xMessageBufferReceiveCompletedFromISR( MessageBufferHandle_t xStreamB
  */
 #define xMessageBufferReceiveCompletedFromISR( xMessageBuffer, pxHigherPriorityTaskWoken ) xStreamBufferReceiveCompletedFromISR( ( StreamBufferHandle_t ) xMessageBuffer, pxHigherPriorityTaskWoken )
 
+#if( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+/**
+ * message_buffer.h
+ *
+<pre>
+size_t xMessageBufferReserve( MessageBufferHandle_t xMessageBuffer,
+                              StreamBufferRegion_t * const pxRegion,
+                              size_t xDataLengthBytes,
+                              TickType_t xTicksToWait );
+size_t xMessageBufferCommit( MessageBufferHandle_t xMessageBuffer, size_t xDataLengthBytes );
+</pre>
+ *
+ * Build the next message in place in the message buffer storage.
+ * xMessageBufferReserve() sets *pxRegion to exactly xDataLengthBytes bytes,
+ * split in two if the message wraps round the end of the storage, and returns
+ * xDataLengthBytes, or 0 if the message did not fit before the block time
+ * expired.  xMessageBufferCommit() sends the first xDataLengthBytes bytes of
+ * it as one message; 0 cancels the message.  See xStreamBufferReserve() and
+ * xStreamBufferCommit().
+ *
+ * \defgroup xMessageBufferReserve xMessageBufferReserve
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferReserve( xMessageBuffer, pxRegion, xDataLengthBytes, xTicksToWait ) xStreamBufferReserve( ( StreamBufferHandle_t ) xMessageBuffer, pxRegion, xDataLengthBytes, xTicksToWait )
+#define xMessageBufferReserveFromISR( xMessageBuffer, pxRegion, xDataLengthBytes ) xStreamBufferReserveFromISR( ( StreamBufferHandle_t ) xMessageBuffer, pxRegion, xDataLengthBytes )
+#define xMessageBufferCommit( xMessageBuffer, xDataLengthBytes ) xStreamBufferCommit( ( StreamBufferHandle_t ) xMessageBuffer, xDataLengthBytes )
+#define xMessageBufferCommitFromISR( xMessageBuffer, xDataLengthBytes, pxHigherPriorityTaskWoken ) xStreamBufferCommitFromISR( ( StreamBufferHandle_t ) xMessageBuffer, xDataLengthBytes, pxHigherPriorityTaskWoken )
+
+/**
+ * message_buffer.h
+ *
+<pre>
+size_t xMessageBufferAcquire( MessageBufferHandle_t xMessageBuffer,
+                              StreamBufferRegion_t * const pxRegion,
+                              TickType_t xTicksToWait );
+size_t xMessageBufferRelease( MessageBufferHandle_t xMessageBuffer );
+</pre>
+ *
+ * Read the next message in place in the message buffer storage.
+ * xMessageBufferAcquire() sets *pxRegion to the message, split in two if it
+ * wraps round the end of the storage, and returns its length, or 0 if no
+ * message arrived before the block time expired.  xMessageBufferRelease()
+ * removes the message.  See xStreamBufferAcquire() and xStreamBufferRelease().
+ *
+ * \defgroup xMessageBufferAcquire xMessageBufferAcquire
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferAcquire( xMessageBuffer, pxRegion, xTicksToWait ) xStreamBufferAcquire( ( StreamBufferHandle_t ) xMessageBuffer, pxRegion, xTicksToWait )
+#define xMessageBufferAcquireFromISR( xMessageBuffer, pxRegion ) xStreamBufferAcquireFromISR( ( StreamBufferHandle_t ) xMessageBuffer, pxRegion )
+#define xMessageBufferRelease( xMessageBuffer ) xStreamBufferRelease( ( StreamBufferHandle_t ) xMessageBuffer, 0 )
+#define xMessageBufferReleaseFromISR( xMessageBuffer, pxHigherPriorityTaskWoken ) xStreamBufferReleaseFromISR( ( StreamBufferHandle_t ) xMessageBuffer, 0, pxHigherPriorityTaskWoken )
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+
+#if( configUSE_STREAM_BUFFER_MULTI_PRODUCER == 1 )
+
+/**
+ * message_buffer.h
+ *
+<pre>
+MessageBufferHandle_t xMessageBufferCreateMultiProducer( size_t xBufferSizeBytes );
+MessageBufferHandle_t xMessageBufferCreateMultiProducerStatic( size_t xBufferSizeBytes,
+                                                               uint8_t *pucMessageBufferStorageArea,
+                                                               StaticMessageBuffer_t *pxStaticMessageBuffer );
+</pre>
+ *
+ * Create a message buffer that any number of tasks and interrupts can send to
+ * at the same time.  Messages from different writers are never interleaved,
+ * and the messages of any one writer arrive in the order it sent them.
+ * Writers never block.  See xStreamBufferCreateMultiProducer().
+ *
+ * \defgroup xMessageBufferCreateMultiProducer xMessageBufferCreateMultiProducer
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferCreateMultiProducer( xBufferSizeBytes ) ( MessageBufferHandle_t ) xStreamBufferGenericCreate( xBufferSizeBytes, ( size_t ) 0, ( pdTRUE | sbTYPE_MULTI_PRODUCER ) )
+#define xMessageBufferCreateMultiProducerStatic( xBufferSizeBytes, pucMessageBufferStorageArea, pxStaticMessageBuffer ) ( MessageBufferHandle_t ) xStreamBufferGenericCreateStatic( xBufferSizeBytes, 0, ( pdTRUE | sbTYPE_MULTI_PRODUCER ), pucMessageBufferStorageArea, pxStaticMessageBuffer )
+
+/**
+ * message_buffer.h
+ *
+<pre>
+size_t xMessageBufferClaim( MessageBufferHandle_t xMessageBuffer,
+                            StreamBufferRegion_t * const pxRegion,
+                            size_t xDataLengthBytes );
+BaseType_t xMessageBufferPublish( MessageBufferHandle_t xMessageBuffer );
+</pre>
+ *
+ * Build a message in place in a multi-producer message buffer.  See
+ * xStreamBufferClaim() and xStreamBufferPublish().
+ *
+ * \defgroup xMessageBufferClaim xMessageBufferClaim
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferClaim( xMessageBuffer, pxRegion, xDataLengthBytes ) xStreamBufferClaim( ( StreamBufferHandle_t ) xMessageBuffer, pxRegion, xDataLengthBytes )
+#define xMessageBufferPublish( xMessageBuffer ) xStreamBufferPublish( ( StreamBufferHandle_t ) xMessageBuffer )
+#define xMessageBufferPublishFromISR( xMessageBuffer, pxHigherPriorityTaskWoken ) xStreamBufferPublishFromISR( ( StreamBufferHandle_t ) xMessageBuffer, pxHigherPriorityTaskWoken )
+
+#endif /* configUSE_STREAM_BUFFER_MULTI_PRODUCER */
+
 #if defined( __cplusplus )
 } /* extern "C" */
 #endif
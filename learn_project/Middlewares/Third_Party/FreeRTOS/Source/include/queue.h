@@ -65,6 +65,7 @@ typedef struct QueueDefinition * QueueSetMemberHandle_t;
 #define	queueSEND_TO_BACK		( ( BaseType_t ) 0 )
 #define	queueSEND_TO_FRONT		( ( BaseType_t ) 1 )
 #define queueOVERWRITE			( ( BaseType_t ) 2 )
+#define queueSEND_BY_PRIORITY	( ( BaseType_t ) 0x100 )	/* OR'ed with the item priority, 0 to 255. */
 
 /* For internal use only.  These definitions *must* match those in queue.c. */
 #define queueQUEUE_TYPE_BASE				( ( uint8_t ) 0U )
@@ -146,6 +147,42 @@ typedef struct QueueDefinition * QueueSetMemberHandle_t;
 	#define xQueueCreate( uxQueueLength, uxItemSize ) xQueueGenericCreate( ( uxQueueLength ), ( uxItemSize ), ( queueQUEUE_TYPE_BASE ) )
 #endif
 
+/**
+ * queue. h
+ * <pre>
+ QueueHandle_t xQueueCreatePriority(
+							  UBaseType_t uxQueueLength,
+							  UBaseType_t uxItemSize
+						  );
+ * </pre>
+ *
+ * Creates a priority queue.  Items sent with xQueueSendWithPriority() are
+ * received highest priority first, and in the order they were sent within a
+ * priority.  Items sent with xQueueSend() or xQueueSendToBack() have priority
+ * 0.  Sending and receiving take O(log uxQueueLength) time.  Blocking and
+ * waking are the same as for a queue created with xQueueCreate().
+ *
+ * In addition to the item storage a priority queue needs 8 bytes of RAM per
+ * item.  It cannot be used with xQueueSendToFront(), xQueueOverwrite() or the
+ * zero copy functions.
+ *
+ * @param uxQueueLength The maximum number of items that the queue can contain,
+ * at most 65535.
+ *
+ * @param uxItemSize The number of bytes each item in the queue will require.
+ * Must not be zero.
+ *
+ * @return If the queue is successfully create then a handle to the newly
+ * created queue is returned.  If the queue cannot be created then 0 is
+ * returned.
+ *
+ * \defgroup xQueueCreatePriority xQueueCreatePriority
+ * \ingroup QueueManagement
+ */
+#if( ( configUSE_QUEUE_PRIORITY == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+	QueueHandle_t xQueueCreatePriority( const UBaseType_t uxQueueLength, const UBaseType_t uxItemSize ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * queue. h
  * <pre>
@@ -561,6 +598,51 @@ typedef struct QueueDefinition * QueueSetMemberHandle_t;
  */
 #define xQueueOverwrite( xQueue, pvItemToQueue ) xQueueGenericSend( ( xQueue ), ( pvItemToQueue ), 0, queueOVERWRITE )
 
+#if( configUSE_QUEUE_PRIORITY == 1 )
+
+/**
+ * queue. h
+ * <pre>
+ BaseType_t xQueueSendWithPriority(
+								   QueueHandle_t xQueue,
+								   const void *pvItemToQueue,
+								   UBaseType_t uxPriority,
+								   TickType_t xTicksToWait
+							   );
+ BaseType_t xQueueSendWithPriorityFromISR(
+										  QueueHandle_t xQueue,
+										  const void *pvItemToQueue,
+										  UBaseType_t uxPriority,
+										  BaseType_t *pxHigherPriorityTaskWoken
+									  );
+ </pre>
+ *
+ * Post an item with a priority from 0 (lowest) to 255 to a queue created with
+ * xQueueCreatePriority().  Otherwise the same as xQueueSendToBack() and
+ * xQueueSendToBackFromISR().  A queue created with xQueueCreate() ignores the
+ * priority and adds the item to the back.
+ *
+ * \defgroup xQueueSendWithPriority xQueueSendWithPriority
+ * \ingroup QueueManagement
+ */
+#define xQueueSendWithPriority( xQueue, pvItemToQueue, uxPriority, xTicksToWait ) xQueueGenericSend( ( xQueue ), ( pvItemToQueue ), ( xTicksToWait ), ( queueSEND_BY_PRIORITY | ( BaseType_t ) ( ( uxPriority ) & 0xFFU ) ) )
+#define xQueueSendWithPriorityFromISR( xQueue, pvItemToQueue, uxPriority, pxHigherPriorityTaskWoken ) xQueueGenericSendFromISR( ( xQueue ), ( pvItemToQueue ), ( pxHigherPriorityTaskWoken ), ( queueSEND_BY_PRIORITY | ( BaseType_t ) ( ( uxPriority ) & 0xFFU ) ) )
+
+/**
+ * queue. h
+ * <pre>UBaseType_t uxQueueGetLastReceivedPriority( const QueueHandle_t xQueue );</pre>
+ *
+ * Return the priority of the item most recently received from a priority
+ * queue.  Only meaningful when a single task receives from the queue, as
+ * another receiver can run between the receive and this call.
+ *
+ * \defgroup uxQueueGetLastReceivedPriority uxQueueGetLastReceivedPriority
+ * \ingroup QueueManagement
+ */
+UBaseType_t uxQueueGetLastReceivedPriority( const QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_QUEUE_PRIORITY */
+
 
 /**
  * queue. h
@@ -899,6 +981,198 @@ UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue ) PRIVILEGED_FUNC
  */
 UBaseType_t uxQueueSpacesAvailable( const QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
 
+#if( configUSE_QUEUE_ZERO_COPY == 1 )
+
+/**
+ * queue. h
+ * <pre>
+ void *pvQueueReserve( QueueHandle_t xQueue, TickType_t xTicksToWait );
+ </pre>
+ *
+ * Reserve the next free slot at the back of a queue so the caller can build
+ * the item in place instead of copying it in with xQueueSend().  The item is
+ * not visible to receivers until xQueueCommit() is called.
+ *
+ * While a slot is reserved the queue appears full to every other writer, so
+ * only one item can be reserved at a time and it keeps its FIFO position.
+ * Keep the time between reserve and commit short.
+ *
+ * Cannot be used with semaphores (queues with an item size of zero) and must
+ * not be mixed with xQueueOverwrite() on the same queue.
+ *
+ * @param xQueue The handle to the queue.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for a free slot, as for xQueueSend().
+ *
+ * @return A pointer to uxItemSize bytes of queue storage, or NULL if no slot
+ * became free before the block time expired.
+ *
+ * Example usage:
+   <pre>
+ struct AMessage *pxMessage;
+
+	pxMessage = ( struct AMessage * ) pvQueueReserve( xQueue, portMAX_DELAY );
+	pxMessage->ucMessageID = 0xab;
+	xQueueCommit( xQueue );
+ </pre>
+ * \defgroup pvQueueReserve pvQueueReserve
+ * \ingroup QueueManagement
+ */
+void *pvQueueReserve( QueueHandle_t xQueue, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>BaseType_t xQueueCommit( QueueHandle_t xQueue );</pre>
+ *
+ * Post the item previously reserved with pvQueueReserve() or
+ * pvQueueReserveFromISR().  Tasks blocked on the queue are woken exactly as
+ * for xQueueSend().
+ *
+ * @param xQueue The handle to the queue.
+ *
+ * @return pdPASS.
+ *
+ * \defgroup xQueueCommit xQueueCommit
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueCommit( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ void *pvQueueAcquire( QueueHandle_t xQueue, TickType_t xTicksToWait );
+ </pre>
+ *
+ * Remove the item at the front of a queue without copying it out, returning a
+ * pointer to it in the queue storage.  The item stays valid until
+ * xQueueRelease() is called, and until then the queue has one space less.
+ *
+ * Only one item can be acquired from a queue at a time.  Other tasks can
+ * keep receiving normally meanwhile.  Cannot be used with semaphores.
+ *
+ * An item sent to the front of the queue would go in the held item's slot, so
+ * while an item is held xQueueSendToFront() and xQueueSendToFrontFromISR()
+ * return errQUEUE_FULL straight away, whatever their block time.
+ *
+ * @param xQueue The handle to the queue.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for an item, as for xQueueReceive().
+ *
+ * @return A pointer to the item, or NULL if the queue stayed empty until the
+ * block time expired.
+ *
+ * \defgroup pvQueueAcquire pvQueueAcquire
+ * \ingroup QueueManagement
+ */
+void *pvQueueAcquire( QueueHandle_t xQueue, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>BaseType_t xQueueRelease( QueueHandle_t xQueue );</pre>
+ *
+ * Return the slot of the item obtained with pvQueueAcquire() or
+ * pvQueueAcquireFromISR() to the queue.  A task blocked waiting to send is
+ * woken, as for xQueueReceive().
+ *
+ * @param xQueue The handle to the queue.
+ *
+ * @return pdPASS.
+ *
+ * \defgroup xQueueRelease xQueueRelease
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueRelease( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+
+#if( configUSE_QUEUE_BATCH == 1 )
+
+/**
+ * queue. h
+ * <pre>
+ BaseType_t xQueueSendBatch(
+							   QueueHandle_t xQueue,
+							   const void * const pvItems,
+							   UBaseType_t uxItemCount,
+							   TickType_t xTicksToWait
+						   );
+ </pre>
+ *
+ * Post up to uxItemCount items, stored one after another at pvItems, to the
+ * back of a queue.  The items are copied under a single critical section and
+ * the calling task yields at most once, however many items are posted.
+ *
+ * The call blocks only while the queue is completely full.  As soon as there
+ * is room for at least one item it posts as many as fit and returns, so the
+ * caller should loop if every item must be sent.
+ *
+ * Cannot be used with semaphores or mutexes.
+ *
+ * @param xQueue The handle to the queue on which the items are to be posted.
+ *
+ * @param pvItems A pointer to the first of the items to post.
+ *
+ * @param uxItemCount The number of items at pvItems.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for space to become available on the queue, as for xQueueSend().
+ *
+ * @return The number of items posted, which is zero if the queue stayed full
+ * until the block time expired.
+ *
+ * Example usage:
+   <pre>
+ uint8_t ucFrames[ 32 ][ 16 ];
+ BaseType_t xSent = 0;
+
+	// Post a burst of frames, waiting for space as needed.
+	while( xSent < 32 )
+	{
+		xSent += xQueueSendBatch( xQueue, ucFrames[ xSent ], 32 - xSent, portMAX_DELAY );
+	}
+ </pre>
+ * \defgroup xQueueSendBatch xQueueSendBatch
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueSendBatch( QueueHandle_t xQueue, const void * const pvItems, const UBaseType_t uxItemCount, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ BaseType_t xQueueReceiveBatch(
+								  QueueHandle_t xQueue,
+								  void * const pvBuffer,
+								  UBaseType_t uxMaxItems,
+								  TickType_t xTicksToWait
+							  );
+ </pre>
+ *
+ * Receive up to uxMaxItems items from a queue into pvBuffer, under a single
+ * critical section and with at most one yield.  Blocks only while the queue
+ * is empty, then takes every item available up to uxMaxItems.
+ *
+ * @param xQueue The handle to the queue from which the items are to be
+ * received.
+ *
+ * @param pvBuffer Pointer to a buffer with room for uxMaxItems items.
+ *
+ * @param uxMaxItems The most items to receive.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for an item, as for xQueueReceive().
+ *
+ * @return The number of items received, which is zero if the queue stayed
+ * empty until the block time expired.
+ *
+ * \defgroup xQueueReceiveBatch xQueueReceiveBatch
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueReceiveBatch( QueueHandle_t xQueue, void * const pvBuffer, const UBaseType_t uxMaxItems, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_QUEUE_BATCH */
+
 /**
  * queue. h
  * <pre>void vQueueDelete( QueueHandle_t xQueue );</pre>
@@ -1390,6 +1664,64 @@ BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue, void * const pvBuffer, Ba
  */
 BaseType_t xQueueIsQueueEmptyFromISR( const QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
 BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+#if( configUSE_QUEUE_ZERO_COPY == 1 )
+
+/**
+ * queue. h
+ * <pre>
+ void *pvQueueReserveFromISR( QueueHandle_t xQueue );
+ void *pvQueueAcquireFromISR( QueueHandle_t xQueue );
+ BaseType_t xQueueCommitFromISR( QueueHandle_t xQueue, BaseType_t *pxHigherPriorityTaskWoken );
+ BaseType_t xQueueReleaseFromISR( QueueHandle_t xQueue, BaseType_t *pxHigherPriorityTaskWoken );
+ </pre>
+ *
+ * Versions of pvQueueReserve(), pvQueueAcquire(), xQueueCommit() and
+ * xQueueRelease() that can be used from an interrupt service routine.  The
+ * reserve and acquire functions never block and return NULL if no slot or
+ * item is available.
+ *
+ * @param xQueue The handle to the queue.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if the commit or release
+ * unblocked a task with a priority higher than the running task, in which case
+ * a context switch should be requested before the interrupt is exited.
+ *
+ * \defgroup pvQueueReserveFromISR pvQueueReserveFromISR
+ * \ingroup QueueManagement
+ */
+void *pvQueueReserveFromISR( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+void *pvQueueAcquireFromISR( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+BaseType_t xQueueCommitFromISR( QueueHandle_t xQueue, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+BaseType_t xQueueReleaseFromISR( QueueHandle_t xQueue, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+
+#if( configUSE_QUEUE_BATCH == 1 )
+
+/**
+ * queue. h
+ * <pre>
+ BaseType_t xQueueSendBatchFromISR( QueueHandle_t xQueue, const void * const pvItems, UBaseType_t uxItemCount, BaseType_t *pxHigherPriorityTaskWoken );
+ BaseType_t xQueueReceiveBatchFromISR( QueueHandle_t xQueue, void * const pvBuffer, UBaseType_t uxMaxItems, BaseType_t *pxHigherPriorityTaskWoken );
+ </pre>
+ *
+ * Versions of xQueueSendBatch() and xQueueReceiveBatch() that can be used
+ * from an interrupt service routine.  They never block.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if the call unblocked a task
+ * with a priority higher than the running task, in which case a context
+ * switch should be requested before the interrupt is exited.
+ *
+ * @return The number of items posted or received.
+ *
+ * \defgroup xQueueSendBatchFromISR xQueueSendBatchFromISR
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueSendBatchFromISR( QueueHandle_t xQueue, const void * const pvItems, const UBaseType_t uxItemCount, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+BaseType_t xQueueReceiveBatchFromISR( QueueHandle_t xQueue, void * const pvBuffer, const UBaseType_t uxMaxItems, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_QUEUE_BATCH */
 UBaseType_t uxQueueMessagesWaitingFromISR( const QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
 
 /*
@@ -1426,6 +1758,12 @@ TaskHandle_t xQueueGetMutexHolderFromISR( QueueHandle_t xSemaphore ) PRIVILEGED_
 BaseType_t xQueueTakeMutexRecursive( QueueHandle_t xMutex, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
 BaseType_t xQueueGiveMutexRecursive( QueueHandle_t xMutex ) PRIVILEGED_FUNCTION;
 
+/*
+ * For internal use only.  Use vSemaphoreSetMutexCeiling() instead of calling
+ * this function directly.
+ */
+void vQueueSetMutexCeiling( QueueHandle_t xMutex, UBaseType_t uxCeilingPriority ) PRIVILEGED_FUNCTION;
+
 /*
  * Reset a queue back to its original empty state.  The return value is now
  * obsolete and is always set to pdPASS.
@@ -1487,6 +1825,167 @@ BaseType_t xQueueGiveMutexRecursive( QueueHandle_t xMutex ) PRIVILEGED_FUNCTION;
 	const char *pcQueueGetName( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
 #endif
 
+#if( configUSE_QUEUE_STATISTICS == 1 )
+
+/* Used with vQueueGetStats() and uxQueueGetRegistryStats() to return the
+activity counters configUSE_QUEUE_STATISTICS keeps for each queue, semaphore
+and mutex.  All counts are since the queue was created. */
+typedef struct xQUEUE_STATS
+{
+	QueueHandle_t xHandle;			/* The queue, semaphore or mutex to which the rest of the information in the structure relates. */
+	const char *pcQueueName;		/* The name the queue was registered with, or NULL if it is not in the registry. */ /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+	UBaseType_t uxLength;			/* The number of items the queue can hold. */
+	UBaseType_t uxMessagesWaiting;	/* The number of items in the queue when the structure was populated.  For a mutex 1 means available. */
+	UBaseType_t uxPeakMessagesWaiting;	/* The highest number of items the queue has held. */
+	uint32_t ulSends;				/* Items sent, or semaphores/mutexes given, including the give that makes a new mutex available. */
+	uint32_t ulReceives;			/* Items received, or semaphores/mutexes taken.  Peeks are not counted. */
+	uint32_t ulFullBlocks;			/* The number of times a task blocked because the queue was full. */
+	uint32_t ulEmptyBlocks;			/* The number of times a task blocked because the queue was empty, or the semaphore/mutex unavailable. */
+	configRUN_TIME_COUNTER_TYPE ulBlockedTime;		/* Total time tasks spent blocked on the queue, in run time stats clock units (ticks if configGENERATE_RUN_TIME_STATS is 0). */
+	configRUN_TIME_COUNTER_TYPE ulMaxBlockedTime;	/* The longest time a task spent blocked on the queue in one go, in the same units. */
+} QueueStats_t;
+
+/**
+ * queue. h
+ * <pre>void vQueueGetStats( QueueHandle_t xQueue, QueueStats_t * const pxStats );</pre>
+ *
+ * configUSE_QUEUE_STATISTICS must be defined as 1 for this function to be
+ * available.
+ *
+ * Copy the activity counters of one queue, semaphore or mutex, which need not
+ * be in the registry, into *pxStats.  The counters are read in one short
+ * critical section, so they are consistent with each other.
+ *
+ * The counters are updated where the queue is already in a critical section,
+ * so counting costs a few instructions per send or receive.  The blocked
+ * time is only measured on the paths that block, which cost a context switch
+ * anyway.
+ *
+ * \defgroup vQueueGetStats vQueueGetStats
+ * \ingroup QueueManagement
+ */
+void vQueueGetStats( QueueHandle_t xQueue, QueueStats_t * const pxStats ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>UBaseType_t uxQueueGetRegistryStats( QueueStats_t * const pxStatsArray, const UBaseType_t uxArraySize );</pre>
+ *
+ * configUSE_QUEUE_STATISTICS must be defined as 1, and configQUEUE_REGISTRY_SIZE
+ * greater than 0, for this function to be available.
+ *
+ * Take a snapshot of the activity counters of every queue, semaphore and mutex
+ * in the queue registry, for a monitoring task that looks for the busiest or
+ * most contended objects.  Differences between two snapshots give the
+ * activity over the interval.
+ *
+ * Each queue is copied in its own critical section, and the scheduler is not
+ * suspended, so taking a snapshot delays interrupts and other tasks by no
+ * more than copying one entry does.  Queues added to or removed from the
+ * registry during the call may or may not be included.
+ *
+ * @param pxStatsArray A pointer to an array of QueueStats_t structures.
+ *
+ * @param uxArraySize The size of the array pointed to by pxStatsArray.  Up
+ * to configQUEUE_REGISTRY_SIZE structures are populated.
+ *
+ * @return The number of QueueStats_t structures that were populated.
+ *
+ * \defgroup uxQueueGetRegistryStats uxQueueGetRegistryStats
+ * \ingroup QueueManagement
+ */
+#if( configQUEUE_REGISTRY_SIZE > 0 )
+	UBaseType_t uxQueueGetRegistryStats( QueueStats_t * const pxStatsArray, const UBaseType_t uxArraySize ) PRIVILEGED_FUNCTION;
+#endif
+
+#endif /* configUSE_QUEUE_STATISTICS */
+
+#if( configUSE_MUTEX_PROFILING == 1 )
+
+/* Used in MutexProfile_t to return what one task has done with a mutex.
+Times are in run time stats clock units - CPU cycles on the target - or ticks
+if configGENERATE_RUN_TIME_STATS is 0. */
+typedef struct xMUTEX_PROFILE_TASK
+{
+	TaskHandle_t xTask;			/* The task the rest of the structure relates to.  NULL in the last entry, which collects the samples of tasks that found no entry free. */
+	uint32_t ulAcquisitions;	/* Holds that have ended, that is takes followed by a give.  Nested takes of a recursive mutex are not counted. */
+	uint32_t ulContended;		/* How many of those holds the task had to block for before it got the mutex. */
+	uint32_t ulFailures;		/* Takes that returned without the mutex, either at once or after their block time expired. */
+	configRUN_TIME_COUNTER_TYPE ulWaitTime;		/* Total time from asking for the mutex to getting it. */
+	configRUN_TIME_COUNTER_TYPE ulMaxWaitTime;	/* The longest single wait. */
+	configRUN_TIME_COUNTER_TYPE ulHoldTime;		/* Total time from getting the mutex to giving it back. */
+	configRUN_TIME_COUNTER_TYPE ulMaxHoldTime;	/* The longest single hold. */
+} MutexProfileTask_t;
+
+/* Used with xQueueGetMutexProfile() and uxQueueGetMutexProfiles() to return
+the wait and hold times configUSE_MUTEX_PROFILING records for a mutex.
+
+Bucket 0 of each histogram counts times shorter than
+2^configMUTEX_PROFILE_BUCKET_SHIFT clock units, and bucket n counts times from
+2^(configMUTEX_PROFILE_BUCKET_SHIFT+n-1) up to twice that.  The last bucket
+also counts every longer time. */
+typedef struct xMUTEX_PROFILE
+{
+	QueueHandle_t xHandle;		/* The mutex to which the rest of the information in the structure relates. */
+	const char *pcMutexName;	/* The name the mutex was registered with, or NULL if it is not in the registry. */ /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+	uint32_t ulWaitHistogram[ configMUTEX_PROFILE_BUCKETS ];	/* Waits of all tasks, by length. */
+	uint32_t ulHoldHistogram[ configMUTEX_PROFILE_BUCKETS ];	/* Holds of all tasks, by length. */
+	MutexProfileTask_t xTasks[ configMUTEX_PROFILE_TASKS + 1 ];	/* The same samples by the task that took the mutex, in the order the tasks first used it. */
+} MutexProfile_t;
+
+/**
+ * queue. h
+ * <pre>BaseType_t xQueueGetMutexProfile( QueueHandle_t xMutex, MutexProfile_t * const pxProfile );</pre>
+ *
+ * configUSE_MUTEX_PROFILING must be defined as 1 for this function to be
+ * available.
+ *
+ * Copy the wait and hold time profile of a mutex or recursive mutex into
+ * *pxProfile.
+ *
+ * The first configMUTEX_PROFILE_COUNT mutexes to be created, counting only
+ * those that still exist, are profiled.  Each take reads the run time stats
+ * clock when it is called and again when it gets the mutex, and the give that
+ * ends the hold reads it once more and adds the sample to the profile in one
+ * short critical section.  A hold still in progress is not yet counted.
+ *
+ * @param xMutex The mutex to read.
+ *
+ * @param pxProfile The structure the profile is copied into.
+ *
+ * @return pdPASS if the profile was copied, or pdFAIL if the mutex is not
+ * profiled because all the profile slots were in use when it was created.
+ *
+ * \defgroup xQueueGetMutexProfile xQueueGetMutexProfile
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueGetMutexProfile( QueueHandle_t xMutex, MutexProfile_t * const pxProfile ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>UBaseType_t uxQueueGetMutexProfiles( MutexProfile_t * const pxProfileArray, const UBaseType_t uxArraySize );</pre>
+ *
+ * configUSE_MUTEX_PROFILING must be defined as 1 for this function to be
+ * available.
+ *
+ * Copy the profiles of every profiled mutex, registered or not, for a
+ * monitoring task that looks for the mutexes that are held longest or waited
+ * for most.  Each profile is copied in its own critical section, and the
+ * scheduler is not suspended.
+ *
+ * @param pxProfileArray A pointer to an array of MutexProfile_t structures.
+ *
+ * @param uxArraySize The size of the array pointed to by pxProfileArray.  Up
+ * to configMUTEX_PROFILE_COUNT structures are populated.
+ *
+ * @return The number of MutexProfile_t structures that were populated.
+ *
+ * \defgroup uxQueueGetMutexProfiles uxQueueGetMutexProfiles
+ * \ingroup QueueManagement
+ */
+UBaseType_t uxQueueGetMutexProfiles( MutexProfile_t * const pxProfileArray, const UBaseType_t uxArraySize ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_MUTEX_PROFILING */
+
 /*
  * Generic version of the function used to creaet a queue using dynamic memory
  * allocation.  This is called by other functions and macros that create other
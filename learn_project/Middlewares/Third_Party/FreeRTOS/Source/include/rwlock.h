@@ -0,0 +1,180 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Read/write locks let any number of tasks hold the lock for reading at the
+ * same time, or one task hold it for writing.  They suit data that is read by
+ * many tasks and written rarely, which an ordinary mutex would serialise.
+ *
+ * Writers are preferred: once a writer is waiting, new readers wait behind it,
+ * so a writer waits at most for the readers already inside to leave.  Readers
+ * can therefore be held off for as long as writers keep arriving.
+ *
+ * The task holding the lock for writing inherits the priority of the highest
+ * priority task waiting for the lock, in the same way as the holder of a
+ * mutex.  Readers do not inherit priority.
+ *
+ * ***NOTE***:  Read/write locks are manipulated with the scheduler suspended,
+ * in the same way as event groups, so the API must not be called from an
+ * interrupt.  The lock is not recursive - a task must not take it again, for
+ * reading or writing, while it already holds it.
+ */
+
+#ifndef RWLOCK_H
+#define RWLOCK_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include rwlock.h"
+#endif
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/**
+ * Type by which read/write locks are referenced.  xRwLockCreate() returns a
+ * RwLockHandle_t that is then passed to the other functions.
+ */
+struct RwLockDef_t;
+typedef struct RwLockDef_t * RwLockHandle_t;
+
+/**
+ * rwlock.h
+ *
+<pre>
+RwLockHandle_t xRwLockCreate( void );
+</pre>
+ *
+ * Creates a read/write lock, allocated from the FreeRTOS heap, that nobody
+ * holds.
+ *
+ * @return The handle of the lock, or NULL if there was not enough heap.
+ */
+RwLockHandle_t xRwLockCreate( void ) PRIVILEGED_FUNCTION;
+
+/**
+ * rwlock.h
+ *
+<pre>
+void vRwLockDelete( RwLockHandle_t xRwLock );
+</pre>
+ *
+ * Deletes a read/write lock.  Nobody may hold or be waiting for the lock.
+ */
+void vRwLockDelete( RwLockHandle_t xRwLock ) PRIVILEGED_FUNCTION;
+
+/**
+ * rwlock.h
+ *
+<pre>
+BaseType_t xRwLockTakeRead( RwLockHandle_t xRwLock, TickType_t xTicksToWait );
+</pre>
+ *
+ * Takes the lock for reading.  Succeeds straight away unless a task holds the
+ * lock for writing or is waiting to.
+ *
+ * @param xTicksToWait The maximum time to wait for the lock.
+ *
+ * @return pdPASS if the lock was taken, pdFAIL if the block time expired.
+ */
+BaseType_t xRwLockTakeRead( RwLockHandle_t xRwLock, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * rwlock.h
+ *
+<pre>
+BaseType_t xRwLockGiveRead( RwLockHandle_t xRwLock );
+</pre>
+ *
+ * Releases a lock taken with xRwLockTakeRead().  The last reader to leave
+ * wakes the highest priority waiting writer.
+ *
+ * @return pdPASS, or pdFAIL if the lock was not held for reading.
+ */
+BaseType_t xRwLockGiveRead( RwLockHandle_t xRwLock ) PRIVILEGED_FUNCTION;
+
+/**
+ * rwlock.h
+ *
+<pre>
+BaseType_t xRwLockTakeWrite( RwLockHandle_t xRwLock, TickType_t xTicksToWait );
+</pre>
+ *
+ * Takes the lock for writing, waiting for the readers inside to leave.  While
+ * the calling task waits no new reader can take the lock.
+ *
+ * @param xTicksToWait The maximum time to wait for the lock.
+ *
+ * @return pdPASS if the lock was taken, pdFAIL if the block time expired or
+ * the calling task already holds the lock for writing.
+ */
+BaseType_t xRwLockTakeWrite( RwLockHandle_t xRwLock, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * rwlock.h
+ *
+<pre>
+BaseType_t xRwLockGiveWrite( RwLockHandle_t xRwLock );
+</pre>
+ *
+ * Releases a lock taken with xRwLockTakeWrite(), returning the calling task
+ * to its base priority if it had inherited one.  Wakes the highest priority
+ * waiting writer if there is one, otherwise every waiting reader.
+ *
+ * @return pdPASS, or pdFAIL if the calling task does not hold the lock for
+ * writing.
+ */
+BaseType_t xRwLockGiveWrite( RwLockHandle_t xRwLock ) PRIVILEGED_FUNCTION;
+
+/**
+ * rwlock.h
+ *
+<pre>
+TaskHandle_t xRwLockGetWriter( RwLockHandle_t xRwLock );
+</pre>
+ *
+ * @return The handle of the task holding the lock for writing, or NULL if the
+ * lock is not held for writing.
+ */
+TaskHandle_t xRwLockGetWriter( RwLockHandle_t xRwLock ) PRIVILEGED_FUNCTION;
+
+/**
+ * rwlock.h
+ *
+<pre>
+UBaseType_t uxRwLockGetReaderCount( RwLockHandle_t xRwLock );
+</pre>
+ *
+ * @return The number of tasks holding the lock for reading.
+ */
+UBaseType_t uxRwLockGetReaderCount( RwLockHandle_t xRwLock ) PRIVILEGED_FUNCTION;
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( RWLOCK_H ) */
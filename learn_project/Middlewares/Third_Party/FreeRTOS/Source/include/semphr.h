@@ -1123,6 +1123,34 @@ typedef QueueHandle_t SemaphoreHandle_t;
  */
 #define xSemaphoreGetMutexHolderFromISR( xSemaphore ) xQueueGetMutexHolderFromISR( ( xSemaphore ) )
 
+/**
+ * semphr.h
+ * <pre>void vSemaphoreSetMutexCeiling( SemaphoreHandle_t xMutex, UBaseType_t uxCeilingPriority );</pre>
+ *
+ * Makes xMutex, a mutex or recursive mutex that is not held, use the
+ * immediate priority ceiling protocol instead of priority inheritance.  A task
+ * that takes the mutex runs at uxCeilingPriority, if it is below that, until it
+ * gives the mutex back, so no other task that uses the mutex can preempt the
+ * holder and find it taken.
+ *
+ * uxCeilingPriority should be the priority of the highest priority task that
+ * takes the mutex.  With configCHECK_MUTEX_CEILING set to 1 a take by a task
+ * whose priority is above the ceiling fails configASSERT().  Tasks at the
+ * ceiling priority itself can still be time sliced with the holder, so either
+ * set the ceiling above the priority of the highest user or set
+ * configUSE_TIME_SLICING to 0 to rule out contention completely.  Ceiling
+ * mutexes held at the same time must be given in the reverse of the order in
+ * which they were taken, or the holder can drop below the ceiling of a mutex
+ * it still holds; with configCHECK_MUTEX_CEILING set to 1 a give out of that
+ * order fails configASSERT().
+ *
+ * configUSE_MUTEX_CEILING must be set to 1 in FreeRTOSConfig.h for this macro
+ * to be available.
+ */
+#if( configUSE_MUTEX_CEILING == 1 )
+	#define vSemaphoreSetMutexCeiling( xMutex, uxCeilingPriority ) vQueueSetMutexCeiling( ( QueueHandle_t ) ( xMutex ), ( uxCeilingPriority ) )
+#endif
+
 /**
  * semphr.h
  * <pre>UBaseType_t uxSemaphoreGetCount( SemaphoreHandle_t xSemaphore );</pre>
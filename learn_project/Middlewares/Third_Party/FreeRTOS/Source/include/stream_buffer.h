@@ -833,7 +833,340 @@ BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuf
  */
 BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuffer, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
+#if( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+/**
+ * Part of the storage of a stream buffer, as handed out by
+ * xStreamBufferReserve() and xStreamBufferAcquire().  The storage is circular,
+ * so a region that runs past its end continues at its start: pucSecond is
+ * NULL and xSecondLength is 0 unless the region wraps.
+ */
+typedef struct xSTREAM_BUFFER_REGION
+{
+	uint8_t *pucFirst;		/* Start of the region. */
+	size_t xFirstLength;	/* Bytes at pucFirst, no further than the end of the storage. */
+	uint8_t *pucSecond;		/* Start of the storage if the region wraps, otherwise NULL. */
+	size_t xSecondLength;	/* Bytes at pucSecond. */
+} StreamBufferRegion_t;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferReserve( StreamBufferHandle_t xStreamBuffer,
+                             StreamBufferRegion_t * const pxRegion,
+                             size_t xBytesWanted,
+                             TickType_t xTicksToWait );
+</pre>
+ *
+ * Hand the writer free space in the buffer storage to fill in place, instead
+ * of copying the data in with xStreamBufferSend().  Nothing is visible to the
+ * reader until xStreamBufferCommit() is called.
+ *
+ * For a stream buffer the region covers all the free space, which may be more
+ * than xBytesWanted, or less if the block time expired first.  For a message
+ * buffer the region is exactly xBytesWanted bytes, or nothing if that message
+ * would not fit before the block time expired.  Either way the region is
+ * split in two when it wraps round the end of the storage.
+ *
+ * Only one region can be reserved at a time, and the writer must not call
+ * xStreamBufferSend() until it has been committed.
+ *
+ * @param xStreamBuffer The handle of the stream buffer to write to.
+ *
+ * @param pxRegion Set to the reserved region.
+ *
+ * @param xBytesWanted The number of bytes the writer needs.  Must not be 0.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block waiting
+ * for xBytesWanted bytes to be free, as for xStreamBufferSend().
+ *
+ * @return The number of bytes in the region.
+ *
+ * Example use:
+<pre>
+StreamBufferRegion_t xRegion;
+size_t xLength;
+
+	xLength = xStreamBufferReserve( xStreamBuffer, &xRegion, 64, portMAX_DELAY );
+	xLength = configMIN( xLength, 64 );
+	vFill( xRegion.pucFirst, configMIN( xLength, xRegion.xFirstLength ) );
+	if( xLength > xRegion.xFirstLength )
+	{
+		vFill( xRegion.pucSecond, xLength - xRegion.xFirstLength );
+	}
+	xStreamBufferCommit( xStreamBuffer, xLength );
+</pre>
+ * \defgroup xStreamBufferReserve xStreamBufferReserve
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferReserve( StreamBufferHandle_t xStreamBuffer,
+							 StreamBufferRegion_t * const pxRegion,
+							 size_t xBytesWanted,
+							 TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferReserveFromISR( StreamBufferHandle_t xStreamBuffer,
+                                    StreamBufferRegion_t * const pxRegion,
+                                    size_t xBytesWanted );
+</pre>
+ *
+ * A version of xStreamBufferReserve() that can be called from an interrupt
+ * service routine (ISR).  It never blocks.
+ *
+ * \defgroup xStreamBufferReserveFromISR xStreamBufferReserveFromISR
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferReserveFromISR( StreamBufferHandle_t xStreamBuffer,
+									StreamBufferRegion_t * const pxRegion,
+									size_t xBytesWanted ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferCommit( StreamBufferHandle_t xStreamBuffer, size_t xBytes );
+</pre>
+ *
+ * Make the first xBytes bytes of the region reserved with
+ * xStreamBufferReserve() visible to the reader.  The rest of the region is
+ * handed back, so 0 cancels the reservation.  A task blocked reading is woken
+ * once the trigger level is reached, as for xStreamBufferSend().
+ *
+ * @param xStreamBuffer The handle of the stream buffer written to.
+ *
+ * @param xBytes The number of bytes written, at most the size of the region.
+ *
+ * @return xBytes.
+ *
+ * \defgroup xStreamBufferCommit xStreamBufferCommit
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferCommit( StreamBufferHandle_t xStreamBuffer, size_t xBytes ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferCommitFromISR( StreamBufferHandle_t xStreamBuffer,
+                                   size_t xBytes,
+                                   BaseType_t * const pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * A version of xStreamBufferCommit() that can be called from an interrupt
+ * service routine (ISR).  The region can have been reserved by a task or by
+ * an earlier interrupt, for example when a DMA transfer was started.
+ * *pxHigherPriorityTaskWoken is used as for xStreamBufferSendFromISR().
+ *
+ * \defgroup xStreamBufferCommitFromISR xStreamBufferCommitFromISR
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferCommitFromISR( StreamBufferHandle_t xStreamBuffer,
+								   size_t xBytes,
+								   BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferAcquire( StreamBufferHandle_t xStreamBuffer,
+                             StreamBufferRegion_t * const pxRegion,
+                             TickType_t xTicksToWait );
+</pre>
+ *
+ * Hand the reader the data in the buffer storage to use in place, instead of
+ * copying it out with xStreamBufferReceive().  The data stays in the buffer
+ * until xStreamBufferRelease() is called.
+ *
+ * For a stream buffer the region covers all the data in the buffer.  For a
+ * message buffer it is the next message, without its length.  Either way the
+ * region is split in two when it wraps round the end of the storage.  Blocking
+ * is the same as for xStreamBufferReceive(), so a blocked task is woken when
+ * the trigger level is reached.
+ *
+ * Only one region can be acquired at a time, and the reader must not call
+ * xStreamBufferReceive() until it has been released.
+ *
+ * @param xStreamBuffer The handle of the stream buffer to read from.
+ *
+ * @param pxRegion Set to the acquired region.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block waiting
+ * for data, as for xStreamBufferReceive().
+ *
+ * @return The number of bytes in the region, 0 if the buffer stayed empty.
+ *
+ * \defgroup xStreamBufferAcquire xStreamBufferAcquire
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferAcquire( StreamBufferHandle_t xStreamBuffer,
+							 StreamBufferRegion_t * const pxRegion,
+							 TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferAcquireFromISR( StreamBufferHandle_t xStreamBuffer,
+                                    StreamBufferRegion_t * const pxRegion );
+</pre>
+ *
+ * A version of xStreamBufferAcquire() that can be called from an interrupt
+ * service routine (ISR).  It never blocks.
+ *
+ * \defgroup xStreamBufferAcquireFromISR xStreamBufferAcquireFromISR
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferAcquireFromISR( StreamBufferHandle_t xStreamBuffer,
+									StreamBufferRegion_t * const pxRegion ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferRelease( StreamBufferHandle_t xStreamBuffer, size_t xBytes );
+</pre>
+ *
+ * Remove the first xBytes bytes of the region acquired with
+ * xStreamBufferAcquire() from a stream buffer; the rest stay in the buffer to
+ * be acquired again.  A message buffer always removes the whole message, and
+ * xBytes is ignored.  A task blocked writing is woken, as for
+ * xStreamBufferReceive().
+ *
+ * @param xStreamBuffer The handle of the stream buffer read from.
+ *
+ * @param xBytes The number of bytes used, at most the size of the region.
+ *
+ * @return The number of bytes removed, not counting the message length.
+ *
+ * \defgroup xStreamBufferRelease xStreamBufferRelease
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferRelease( StreamBufferHandle_t xStreamBuffer, size_t xBytes ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferReleaseFromISR( StreamBufferHandle_t xStreamBuffer,
+                                    size_t xBytes,
+                                    BaseType_t * const pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * A version of xStreamBufferRelease() that can be called from an interrupt
+ * service routine (ISR), for example when a DMA transfer out of the acquired
+ * region completes.  *pxHigherPriorityTaskWoken is used as for
+ * xStreamBufferReceiveFromISR().
+ *
+ * \defgroup xStreamBufferReleaseFromISR xStreamBufferReleaseFromISR
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferReleaseFromISR( StreamBufferHandle_t xStreamBuffer,
+									size_t xBytes,
+									BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+
+#if( configUSE_STREAM_BUFFER_MULTI_PRODUCER == 1 )
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+StreamBufferHandle_t xStreamBufferCreateMultiProducer( size_t xBufferSizeBytes, size_t xTriggerLevelBytes );
+StreamBufferHandle_t xStreamBufferCreateMultiProducerStatic( size_t xBufferSizeBytes,
+                                                             size_t xTriggerLevelBytes,
+                                                             uint8_t *pucStreamBufferStorageArea,
+                                                             StaticStreamBuffer_t *pxStaticStreamBuffer );
+</pre>
+ *
+ * Create a stream buffer that any number of tasks and interrupts can write to
+ * at the same time, without a critical section around each write.  The
+ * parameters are as for xStreamBufferCreate() and xStreamBufferCreateStatic().
+ *
+ * Writers claim space with a compare and swap, fill it, then publish it, so a
+ * long copy never holds off other writers or interrupts.  Claims can be
+ * published in any order; the reader sees the data in the order the space was
+ * claimed, once every claim made before it has been published.
+ *
+ * xStreamBufferSend() and xStreamBufferSendFromISR() work on these buffers as a
+ * claim, a copy and a publish.  Writers never block: xTicksToWait is ignored
+ * and a write that does not fit returns 0 (a stream buffer writes as many bytes
+ * as fit, as before).  The single reader receives, and blocks, as for any
+ * other stream buffer.  xStreamBufferReserve() cannot be used on these buffers.
+ *
+ * configUSE_STREAM_BUFFER_MULTI_PRODUCER must be set to 1 in FreeRTOSConfig.h
+ * for these functions to be available.
+ *
+ * \defgroup xStreamBufferCreateMultiProducer xStreamBufferCreateMultiProducer
+ * \ingroup StreamBufferManagement
+ */
+#define xStreamBufferCreateMultiProducer( xBufferSizeBytes, xTriggerLevelBytes ) xStreamBufferGenericCreate( xBufferSizeBytes, xTriggerLevelBytes, sbTYPE_MULTI_PRODUCER )
+#define xStreamBufferCreateMultiProducerStatic( xBufferSizeBytes, xTriggerLevelBytes, pucStreamBufferStorageArea, pxStaticStreamBuffer ) xStreamBufferGenericCreateStatic( xBufferSizeBytes, xTriggerLevelBytes, sbTYPE_MULTI_PRODUCER, pucStreamBufferStorageArea, pxStaticStreamBuffer )
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferClaim( StreamBufferHandle_t xStreamBuffer,
+                           StreamBufferRegion_t * const pxRegion,
+                           size_t xDataLengthBytes );
+</pre>
+ *
+ * Claim xDataLengthBytes bytes of a multi-producer stream buffer to write in
+ * place.  On success *pxRegion describes the space, split in two if it wraps
+ * round the end of the storage, and xDataLengthBytes is returned.  If the
+ * bytes do not all fit, nothing is claimed and 0 is returned.  On a message
+ * buffer the claimed space is one message of exactly xDataLengthBytes bytes.
+ *
+ * Can be called from tasks and interrupts.  Every successful claim must be
+ * completely filled and then passed to xStreamBufferPublish() or
+ * xStreamBufferPublishFromISR(), and quickly: no data claimed after it reaches
+ * the reader until it is published.
+ *
+ * \defgroup xStreamBufferClaim xStreamBufferClaim
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferClaim( StreamBufferHandle_t xStreamBuffer,
+						   StreamBufferRegion_t * const pxRegion,
+						   size_t xDataLengthBytes ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+BaseType_t xStreamBufferPublish( StreamBufferHandle_t xStreamBuffer );
+BaseType_t xStreamBufferPublishFromISR( StreamBufferHandle_t xStreamBuffer,
+                                        BaseType_t * const pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * Publish one space claimed by xStreamBufferClaim() once it has been filled.
+ * If no other claim is still open, everything claimed so far becomes readable
+ * and a task blocked on the buffer is unblocked once the trigger level is
+ * reached.  Returns pdTRUE if data became readable, pdFALSE if it will become
+ * readable when the last open claim is published.
+ *
+ * Use xStreamBufferPublishFromISR() from an interrupt service routine;
+ * *pxHigherPriorityTaskWoken is used as for xStreamBufferSendFromISR().
+ *
+ * \defgroup xStreamBufferPublish xStreamBufferPublish
+ * \ingroup StreamBufferManagement
+ */
+BaseType_t xStreamBufferPublish( StreamBufferHandle_t xStreamBuffer ) PRIVILEGED_FUNCTION;
+
+BaseType_t xStreamBufferPublishFromISR( StreamBufferHandle_t xStreamBuffer,
+										BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_STREAM_BUFFER_MULTI_PRODUCER */
+
 /* Functions below here are not part of the public API. */
+
+/* Or'ed into xIsMessageBuffer to create a multi-producer buffer. */
+#define sbTYPE_MULTI_PRODUCER ( ( BaseType_t ) 2 )
+
 StreamBufferHandle_t xStreamBufferGenericCreate( size_t xBufferSizeBytes,
 												 size_t xTriggerLevelBytes,
 												 BaseType_t xIsMessageBuffer ) PRIVILEGED_FUNCTION;
@@ -142,11 +142,20 @@ typedef struct xTASK_STATUS
 	eTaskState eCurrentState;		/* The state in which the task existed when the structure was populated. */
 	UBaseType_t uxCurrentPriority;	/* The priority at which the task was running (may be inherited) when the structure was populated. */
 	UBaseType_t uxBasePriority;		/* The priority to which the task will return if the task's current priority has been inherited to avoid unbounded priority inversion when obtaining a mutex.  Only valid if configUSE_MUTEXES is defined as 1 in FreeRTOSConfig.h. */
-	uint32_t ulRunTimeCounter;		/* The total run time allocated to the task so far, as defined by the run time stats clock.  See http://www.freertos.org/rtos-run-time-stats.html.  Only valid when configGENERATE_RUN_TIME_STATS is defined as 1 in FreeRTOSConfig.h. */
+	configRUN_TIME_COUNTER_TYPE ulRunTimeCounter;	/* The total run time allocated to the task so far, as defined by the run time stats clock.  See http://www.freertos.org/rtos-run-time-stats.html.  Only valid when configGENERATE_RUN_TIME_STATS is defined as 1 in FreeRTOSConfig.h. */
 	StackType_t *pxStackBase;		/* Points to the lowest address of the task's stack area. */
 	configSTACK_DEPTH_TYPE usStackHighWaterMark;	/* The minimum amount of stack space that has remained for the task since the task was created.  The closer this value is to zero the closer the task has come to overflowing its stack. */
 } TaskStatus_t;
 
+/* Used with the uxTaskGetRunTimeSnapshot() function to return the run time of
+each task without the cost of populating a full TaskStatus_t structure. */
+typedef struct xTASK_RUN_TIME_SNAPSHOT
+{
+	TaskHandle_t xHandle;			/* The handle of the task to which the rest of the information in the structure relates. */
+	UBaseType_t xTaskNumber;		/* A number unique to the task.  Only valid if configUSE_TRACE_FACILITY is defined as 1 in FreeRTOSConfig.h. */
+	configRUN_TIME_COUNTER_TYPE ulRunTimeCounter;	/* The total run time allocated to the task so far, including the current time slice if the task is the one calling uxTaskGetRunTimeSnapshot(). */
+} TaskRunTimeSnapshot_t;
+
 /* Possible return values for eTaskConfirmSleepModeStatus(). */
 typedef enum
 {
@@ -1517,6 +1526,20 @@ constant. */
 	void vTaskSetThreadLocalStoragePointer( TaskHandle_t xTaskToSet, BaseType_t xIndex, void *pvValue ) PRIVILEGED_FUNCTION;
 	void *pvTaskGetThreadLocalStoragePointer( TaskHandle_t xTaskToQuery, BaseType_t xIndex ) PRIVILEGED_FUNCTION;
 
+	#if ( configTHREAD_LOCAL_STORAGE_DELETE_CALLBACKS == 1 )
+
+		/* Set a thread local storage pointer along with a function that is
+		called with the index and the pointer when the task is deleted, so
+		whatever the pointer refers to can be released.  The callback runs
+		when the kernel frees the task: inside vTaskDelete() when another task
+		deletes it, or later from the idle task when a task deletes itself.  It
+		must not block. */
+		typedef void ( *TlsDeleteCallbackFunction_t )( int, void * );
+
+		void vTaskSetThreadLocalStoragePointerAndDelCallback( TaskHandle_t xTaskToSet, BaseType_t xIndex, void *pvValue, TlsDeleteCallbackFunction_t pvDelCallback ) PRIVILEGED_FUNCTION;
+
+	#endif
+
 #endif
 
 /**
@@ -1638,7 +1661,44 @@ TaskHandle_t xTaskGetIdleTaskHandle( void ) PRIVILEGED_FUNCTION;
 	}
 	</pre>
  */
-UBaseType_t uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray, const UBaseType_t uxArraySize, uint32_t * const pulTotalRunTime ) PRIVILEGED_FUNCTION;
+UBaseType_t uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray, const UBaseType_t uxArraySize, configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <PRE>UBaseType_t uxTaskGetRunTimeSnapshot( TaskRunTimeSnapshot_t * const pxSnapshotArray, const UBaseType_t uxArraySize, configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime );</PRE>
+ *
+ * configGENERATE_RUN_TIME_STATS must be defined as 1 for this function to be
+ * available.
+ *
+ * A lightweight alternative to uxTaskGetSystemState() for code that only needs
+ * the run time of each task, such as a monitoring task that samples the CPU
+ * load periodically.  No task names, priorities or stack high water marks are
+ * gathered (the latter requires scanning each task's stack), and nothing is
+ * formatted, so the scheduler is only suspended for a few loads per task.
+ *
+ * The calling task is credited with the time it has been running since it was
+ * last switched in, so the returned counters and *pulTotalRunTime are
+ * consistent with each other.  Differences between two snapshots give the
+ * CPU time used by each task over the interval.
+ *
+ * @param pxSnapshotArray A pointer to an array of TaskRunTimeSnapshot_t
+ * structures.  The array must contain at least one structure for each task
+ * under the control of the RTOS.  The number of tasks under the control of the
+ * RTOS can be determined using the uxTaskGetNumberOfTasks() API function.
+ *
+ * @param uxArraySize The size of the array pointed to by the pxSnapshotArray
+ * parameter.
+ *
+ * @param pulTotalRunTime Set to the value of the run time stats clock at the
+ * time the snapshot was taken.  Can be set to NULL to omit it.
+ *
+ * @return The number of TaskRunTimeSnapshot_t structures that were populated.
+ * This will be zero if the array is too small.
+ *
+ * \defgroup uxTaskGetRunTimeSnapshot uxTaskGetRunTimeSnapshot
+ * \ingroup TaskUtils
+ */
+UBaseType_t uxTaskGetRunTimeSnapshot( TaskRunTimeSnapshot_t * const pxSnapshotArray, const UBaseType_t uxArraySize, configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime ) PRIVILEGED_FUNCTION;
 
 /**
  * task. h
@@ -1743,7 +1803,7 @@ void vTaskGetRunTimeStats( char *pcWriteBuffer ) PRIVILEGED_FUNCTION; /*lint !e9
 
 /**
 * task. h
-* <PRE>uint32_t ulTaskGetIdleRunTimeCounter( void );</PRE>
+* <PRE>configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimeCounter( void );</PRE>
 *
 * configGENERATE_RUN_TIME_STATS and configUSE_STATS_FORMATTING_FUNCTIONS
 * must both be defined as 1 for this function to be available.  The application
@@ -1769,7 +1829,7 @@ void vTaskGetRunTimeStats( char *pcWriteBuffer ) PRIVILEGED_FUNCTION; /*lint !e9
 * \defgroup ulTaskGetIdleRunTimeCounter ulTaskGetIdleRunTimeCounter
 * \ingroup TaskUtils
 */
-uint32_t ulTaskGetIdleRunTimeCounter( void ) PRIVILEGED_FUNCTION;
+configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimeCounter( void ) PRIVILEGED_FUNCTION;
 
 /**
  * task. h
@@ -2416,6 +2476,22 @@ void vTaskPlaceOnEventListRestricted( List_t * const pxEventList, TickType_t xTi
 BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList ) PRIVILEGED_FUNCTION;
 void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem, const TickType_t xItemValue ) PRIVILEGED_FUNCTION;
 
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
+ * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
+ *
+ * As vTaskRemoveFromUnorderedEventList(), but called from a critical section
+ * or an interrupt with interrupts masked rather than with the scheduler
+ * suspended.  Used by xEventGroupSetBitsFromISR() when
+ * configUSE_EVENT_GROUP_ISR_SET is 1.
+ *
+ * @return pdTRUE if the task being removed has a higher priority than the task
+ * that was running when the call was made, otherwise pdFALSE.
+ */
+#if( configUSE_EVENT_GROUP_ISR_SET == 1 )
+	BaseType_t xTaskRemoveFromUnorderedEventListFromISR( ListItem_t * pxEventListItem, const TickType_t xItemValue ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS ONLY
  * INTENDED FOR USE WHEN IMPLEMENTING A PORT OF THE SCHEDULER AND IS
@@ -2432,6 +2508,23 @@ portDONT_DISCARD void vTaskSwitchContext( void ) PRIVILEGED_FUNCTION;
  */
 TickType_t uxTaskResetEventItemValue( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * THESE FUNCTIONS MUST NOT BE USED FROM APPLICATION CODE.  THEY ARE AN
+ * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
+ *
+ * Versions of vTaskPlaceOnUnorderedEventList(),
+ * vTaskRemoveFromUnorderedEventList() and uxTaskResetEventItemValue() for
+ * 64-bit event groups.  The 64-bit value is held in the TCB, as it does not fit
+ * in the event list item; ullTaskGetEventItemValue64() reads it for the task
+ * that owns an event list item.
+ */
+#if( configUSE_64_BIT_EVENT_GROUPS == 1 )
+	void vTaskPlaceOnUnorderedEventList64( List_t * pxEventList, const uint64_t ullItemValue, const TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+	void vTaskRemoveFromUnorderedEventList64( ListItem_t * pxEventListItem, const uint64_t ullItemValue ) PRIVILEGED_FUNCTION;
+	uint64_t ullTaskGetEventItemValue64( const ListItem_t * pxEventListItem ) PRIVILEGED_FUNCTION;
+	uint64_t ullTaskResetEventItemValue64( void ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Return the handle of the calling task.
  */
@@ -2527,6 +2620,33 @@ eSleepModeStatus eTaskConfirmSleepModeStatus( void ) PRIVILEGED_FUNCTION;
  */
 TaskHandle_t pvTaskIncrementMutexHeldCount( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * For internal use only.  Decrement the running task's mutex held count when
+ * it gives a mutex on the mutex fast path.  Returns pdFALSE, without changing
+ * the count, if the task must instead call xTaskPriorityDisinherit() to give
+ * up an inherited priority.
+ */
+BaseType_t xTaskDecrementMutexHeldCount( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * For internal use only.  Raise the running task to the ceiling priority of a
+ * priority ceiling mutex it has just taken, if it is below it, and return the
+ * priority it had before.  *puxCeilingDepth is set to the number of ceiling
+ * mutexes the task now holds, to be passed back when the mutex is given.
+ */
+UBaseType_t uxTaskPriorityRaiseToCeiling( UBaseType_t uxCeilingPriority, UBaseType_t * const puxCeilingDepth ) PRIVILEGED_FUNCTION;
+
+/*
+ * For internal use only.  Called in place of xTaskPriorityDisinherit() when
+ * the running task gives a priority ceiling mutex.  Decrements the mutex held
+ * count and lowers the task to the priority it had when it took the mutex, or
+ * to its base priority if it holds no other mutex.  uxCeilingDepth is the
+ * value uxTaskPriorityRaiseToCeiling() returned through puxCeilingDepth, used
+ * to check the mutex is the last ceiling mutex taken.  Returns pdTRUE if the
+ * priority was lowered.
+ */
+BaseType_t xTaskPriorityLowerFromCeiling( UBaseType_t uxCeilingPriority, UBaseType_t uxPriorityOnTake, UBaseType_t uxCeilingDepth ) PRIVILEGED_FUNCTION;
+
 /*
  * For internal use only.  Same as vTaskSetTimeOutState(), but without a critial
  * section.
@@ -0,0 +1,211 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Topics are publish/subscribe channels that deliver every published message
+ * to every subscriber.  A message is copied once into a ring shared by all
+ * subscribers; each subscriber keeps its own read position in that ring, so
+ * publishing costs the same single copy however many subscribers there are,
+ * and all the subscribers waiting for a message are woken in one pass.
+ *
+ * A subscriber that falls a full ring behind the newest message stops the
+ * ring from accepting another.  What happens then is chosen when the topic is
+ * created - see eTopicPolicy.
+ *
+ * ***NOTE***:  Topics are manipulated with the scheduler suspended rather than
+ * inside critical sections, in the same way as event groups, so the API must
+ * not be called from an interrupt.  Each subscriber is intended to be read by
+ * a single task.
+ */
+
+#ifndef TOPIC_H
+#define TOPIC_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include topic.h"
+#endif
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/**
+ * Types by which topics and their subscribers are referenced.  xTopicCreate()
+ * returns a TopicHandle_t, xTopicSubscribe() returns a TopicSubscriberHandle_t.
+ */
+struct TopicDef_t;
+typedef struct TopicDef_t * TopicHandle_t;
+struct TopicSubscriberDef_t;
+typedef struct TopicSubscriberDef_t * TopicSubscriberHandle_t;
+
+/**
+ * What xTopicPublish() does when the slowest subscriber has not yet read the
+ * oldest message in the ring:
+ *
+ * eTopicDrop - the new message is not published and xTopicPublish() returns
+ * pdFAIL straight away.  No subscriber sees it.
+ *
+ * eTopicBlock - the publisher waits, for up to its block time, until the
+ * slowest subscriber has read a message.  Nothing is lost.
+ *
+ * eTopicOverwrite - the oldest message is overwritten.  Subscribers that had
+ * not yet read it skip it, which is counted by ulTopicGetLostCount().  The
+ * publisher never waits.
+ */
+typedef enum
+{
+	eTopicDrop = 0,
+	eTopicBlock,
+	eTopicOverwrite
+} eTopicPolicy;
+
+/**
+ * topic.h
+ *
+<pre>
+TopicHandle_t xTopicCreate( UBaseType_t uxLength, UBaseType_t uxItemSize, eTopicPolicy ePolicy );
+</pre>
+ *
+ * Creates a topic whose ring holds uxLength messages of uxItemSize bytes.
+ * uxLength must be a power of 2.  The topic and its ring are allocated in one
+ * block from the FreeRTOS heap.
+ *
+ * @return The handle of the topic, or NULL if there was not enough heap.
+ */
+TopicHandle_t xTopicCreate( UBaseType_t uxLength, UBaseType_t uxItemSize, eTopicPolicy ePolicy ) PRIVILEGED_FUNCTION;
+
+/**
+ * topic.h
+ *
+<pre>
+void vTopicDelete( TopicHandle_t xTopic );
+</pre>
+ *
+ * Deletes a topic.  All of its subscribers must have been removed with
+ * vTopicUnsubscribe() first.
+ */
+void vTopicDelete( TopicHandle_t xTopic ) PRIVILEGED_FUNCTION;
+
+/**
+ * topic.h
+ *
+<pre>
+TopicSubscriberHandle_t xTopicSubscribe( TopicHandle_t xTopic );
+</pre>
+ *
+ * Adds a subscriber to a topic.  The subscriber receives the messages
+ * published after it was added.
+ *
+ * @return The handle of the subscriber, or NULL if there was not enough heap.
+ */
+TopicSubscriberHandle_t xTopicSubscribe( TopicHandle_t xTopic ) PRIVILEGED_FUNCTION;
+
+/**
+ * topic.h
+ *
+<pre>
+void vTopicUnsubscribe( TopicSubscriberHandle_t xSubscriber );
+</pre>
+ *
+ * Removes a subscriber from its topic and frees it.  Messages it had not read
+ * no longer hold up the publisher.  No task may be blocked on the subscriber.
+ */
+void vTopicUnsubscribe( TopicSubscriberHandle_t xSubscriber ) PRIVILEGED_FUNCTION;
+
+/**
+ * topic.h
+ *
+<pre>
+BaseType_t xTopicPublish( TopicHandle_t xTopic, const void *pvItem, TickType_t xTicksToWait );
+</pre>
+ *
+ * Copies the uxItemSize bytes at pvItem into the topic's ring and wakes every
+ * subscriber that is waiting for a message.  A topic with no subscribers
+ * accepts and discards every message.
+ *
+ * @param xTicksToWait Only used by topics created with eTopicBlock: the
+ * maximum time to wait for the slowest subscriber to make room.
+ *
+ * @return pdPASS if the message was published, otherwise pdFAIL.  Every
+ * message that is not published is counted by ulTopicGetDroppedCount().
+ */
+BaseType_t xTopicPublish( TopicHandle_t xTopic, const void * const pvItem, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * topic.h
+ *
+<pre>
+BaseType_t xTopicReceive( TopicSubscriberHandle_t xSubscriber, void *pvBuffer, TickType_t xTicksToWait );
+</pre>
+ *
+ * Copies the oldest message the subscriber has not yet read into pvBuffer,
+ * waiting up to xTicksToWait for one to be published if there is none.
+ *
+ * @return pdPASS if a message was received, pdFAIL if the block time expired.
+ */
+BaseType_t xTopicReceive( TopicSubscriberHandle_t xSubscriber, void * const pvBuffer, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * topic.h
+ *
+<pre>
+UBaseType_t uxTopicMessagesWaiting( TopicSubscriberHandle_t xSubscriber );
+</pre>
+ *
+ * @return The number of messages the subscriber has not yet read.
+ */
+UBaseType_t uxTopicMessagesWaiting( TopicSubscriberHandle_t xSubscriber ) PRIVILEGED_FUNCTION;
+
+/**
+ * topic.h
+ *
+<pre>
+uint32_t ulTopicGetLostCount( TopicSubscriberHandle_t xSubscriber );
+</pre>
+ *
+ * @return The number of messages overwritten before the subscriber read them.
+ * Always 0 unless the topic was created with eTopicOverwrite.
+ */
+uint32_t ulTopicGetLostCount( TopicSubscriberHandle_t xSubscriber ) PRIVILEGED_FUNCTION;
+
+/**
+ * topic.h
+ *
+<pre>
+uint32_t ulTopicGetDroppedCount( TopicHandle_t xTopic );
+</pre>
+ *
+ * @return The number of calls to xTopicPublish() that failed because the ring
+ * was full.  Always 0 if the topic was created with eTopicOverwrite.
+ */
+uint32_t ulTopicGetDroppedCount( TopicHandle_t xTopic ) PRIVILEGED_FUNCTION;
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( TOPIC_H ) */
@@ -0,0 +1,621 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+/*-----------------------------------------------------------
+ * Implementation of functions defined in portable.h for the Linux (POSIX)
+ * simulator port.
+ *
+ * Each task is backed by a pthread.  Only the thread that belongs to
+ * pxCurrentTCB is allowed to run; every other thread is parked on its own
+ * event.  A context switch wakes the thread of the incoming task and then
+ * parks the thread of the outgoing task.
+ *
+ * The tick is generated by an interval timer (SIGALRM) and simulated
+ * interrupts are delivered with SIGUSR1.  Both signals are blocked in every
+ * thread other than the running one, so an "interrupt" always executes on top
+ * of the running task, as it does on the Cortex-M3.  Masking interrupts does
+ * not need a system call: the signal handler checks a software mask and leaves
+ * the interrupt pending, to be serviced when the mask is cleared - in the same
+ * way BASEPRI holds interrupts off on the target.  A yield requested while
+ * interrupts are masked, or from within an interrupt, is likewise held pending
+ * until the mask is cleared, which mirrors the behaviour of PendSV.
+ *
+ * Task code runs on a stack allocated by the C library rather than on the
+ * FreeRTOS task stack, as the stack depths used on the target are far too
+ * small for host code.  The FreeRTOS stack is only used to hold the
+ * bookkeeping for the thread.
+ *
+ * Threads that are not under the control of the scheduler, such as simulated
+ * peripherals, must block all signals so the tick is never delivered to them.
+ *
+ * The C library is not aware of the scheduler.  Tasks must not preempt each
+ * other while inside stdio or malloc(), so only call them from one task at a
+ * time, or from within a critical section.
+ *----------------------------------------------------------*/
+
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* The size of the C library stack given to the pthread of each task. */
+#ifndef configPOSIX_THREAD_STACK_SIZE
+	#define configPOSIX_THREAD_STACK_SIZE	( 256UL * 1024UL )
+#endif
+
+/* Signals used to simulate the tick interrupt and all other interrupts. */
+#define portTICK_SIGNAL				SIGALRM
+#define portINTERRUPT_SIGNAL		SIGUSR1
+
+/* Used by a thread to wait until it is allowed to run. */
+typedef struct THREAD_EVENT
+{
+	pthread_mutex_t xMutex;
+	pthread_cond_t xCond;
+	BaseType_t xSignalled;
+} ThreadEvent_t;
+
+/* The bookkeeping kept for each task, stored at the top of its stack. */
+typedef struct THREAD
+{
+	pthread_t xPthread;
+	TaskFunction_t pxCode;
+	void *pvParameters;
+	volatile BaseType_t xDying;
+	ThreadEvent_t xEvent;
+} Thread_t;
+
+/*
+ * Setup the timer to generate the tick interrupts.
+ */
+static void prvSetupTimerInterrupt( void );
+
+/*
+ * Install the signal handlers.  Called once, before the first task is
+ * created.
+ */
+static void prvSetupSignals( void );
+
+/*
+ * The handler for both the tick and the simulated interrupt signals.
+ */
+static void prvSignalHandler( int iSignal );
+
+/*
+ * Run the tick and any pending simulated interrupts, then perform a context
+ * switch if one was requested.  Called with interrupts masked.
+ */
+static void prvServiceInterrupts( void );
+
+/*
+ * Select the next task to run and switch to its thread.
+ */
+static void prvYieldNow( void );
+
+/*
+ * Park the calling thread (which belongs to pxOld) and wake the thread of
+ * pxNew.  Returns when the task that owns the calling thread is next selected
+ * to run.
+ */
+static void prvSwitchThread( Thread_t *pxNew, Thread_t *pxOld );
+
+/*
+ * Entry point of the pthread created for each task.
+ */
+static void *prvThreadEntry( void *pvParameters );
+
+/*
+ * Used to catch tasks that attempt to return from their implementing function.
+ */
+static void prvTaskExitError( void );
+
+static Thread_t *prvGetThreadFromTask( TaskHandle_t xTask );
+static void prvEventInit( ThreadEvent_t *pxEvent );
+static void prvEventSignal( ThreadEvent_t *pxEvent );
+static void prvEventWait( ThreadEvent_t *pxEvent );
+static void prvEventDestroy( ThreadEvent_t *pxEvent );
+
+/*-----------------------------------------------------------*/
+
+/* Only one task thread runs at a time, so the interrupt state and critical
+nesting count are global rather than held per thread.  A context switch is only
+ever performed when the critical nesting count is zero. */
+static volatile UBaseType_t uxCriticalNesting = 0;
+static volatile BaseType_t xInterruptsMasked = pdFALSE;
+static volatile BaseType_t xInsideInterrupt = pdFALSE;
+static volatile BaseType_t xSwitchPending = pdFALSE;
+
+/* Interrupts raised but not yet serviced.  Ticks are counted rather than
+flagged so time is not lost if the host deschedules the process. */
+static volatile uint32_t ulPendingInterrupts = 0;
+static volatile uint32_t ulPendingTicks = 0;
+
+static uint32_t ( *pvInterruptHandlers[ portMAX_INTERRUPTS ] )( void );
+
+static volatile BaseType_t xSchedulerStarted = pdFALSE;
+static ThreadEvent_t xSchedulerEndEvent;
+static sigset_t xInterruptSignals;
+static pthread_once_t xSignalsSetup = PTHREAD_ONCE_INIT;
+
+/* Set in the threads that run tasks, so the port can tell those apart from
+the main thread and from simulated peripheral threads. */
+static __thread BaseType_t xIsTaskThread = pdFALSE;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * See header file for description.
+ */
+StackType_t *pxPortInitialiseStack( StackType_t *pxTopOfStack, TaskFunction_t pxCode, void *pvParameters )
+{
+Thread_t *pxThread;
+pthread_attr_t xThreadAttributes;
+sigset_t xOriginalMask;
+int iReturn;
+
+	( void ) pthread_once( &xSignalsSetup, prvSetupSignals );
+
+	/* Place the thread bookkeeping at the top of the task stack.  The task's
+	top of stack then points to the word below it, which is how the thread is
+	found again from the TCB. */
+	pxThread = ( Thread_t * ) ( pxTopOfStack + 1 ) - 1;
+	pxTopOfStack = ( StackType_t * ) pxThread - 1;
+
+	pxThread->pxCode = pxCode;
+	pxThread->pvParameters = pvParameters;
+	pxThread->xDying = pdFALSE;
+	prvEventInit( &pxThread->xEvent );
+
+	( void ) pthread_attr_init( &xThreadAttributes );
+	( void ) pthread_attr_setstacksize( &xThreadAttributes, configPOSIX_THREAD_STACK_SIZE );
+
+	/* The new thread inherits the signal mask of the caller, so block the
+	interrupt signals while it is created.  That also stops a tick switching
+	tasks while the C library holds its internal locks. */
+	( void ) pthread_sigmask( SIG_BLOCK, &xInterruptSignals, &xOriginalMask );
+	iReturn = pthread_create( &pxThread->xPthread, &xThreadAttributes, prvThreadEntry, pxThread );
+	( void ) pthread_sigmask( SIG_SETMASK, &xOriginalMask, NULL );
+	( void ) pthread_attr_destroy( &xThreadAttributes );
+
+	configASSERT( iReturn == 0 );
+	( void ) iReturn;
+
+	return pxTopOfStack;
+}
+/*-----------------------------------------------------------*/
+
+static void *prvThreadEntry( void *pvParameters )
+{
+Thread_t *pxThread = ( Thread_t * ) pvParameters;
+
+	xIsTaskThread = pdTRUE;
+
+	/* Wait until the scheduler selects this task for the first time. */
+	prvEventWait( &pxThread->xEvent );
+
+	if( pxThread->xDying == pdFALSE )
+	{
+		( void ) pthread_sigmask( SIG_UNBLOCK, &xInterruptSignals, NULL );
+		uxCriticalNesting = 0;
+		vPortEnableInterrupts();
+
+		pxThread->pxCode( pxThread->pvParameters );
+		prvTaskExitError();
+	}
+
+	return NULL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvTaskExitError( void )
+{
+	/* A function that implements a task must not exit or attempt to return to
+	its caller as there is nothing to return to.  If a task wants to exit it
+	should instead call vTaskDelete( NULL ).
+
+	Artificially force an assert() to be triggered if configASSERT() is
+	defined, then stop here so application writers can catch the error. */
+	configASSERT( uxCriticalNesting == ~0UL );
+	portDISABLE_INTERRUPTS();
+	for( ;; );
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * See header file for description.
+ */
+BaseType_t xPortStartScheduler( void )
+{
+	( void ) pthread_once( &xSignalsSetup, prvSetupSignals );
+
+	/* The main thread never runs task code, so it must never take one of the
+	interrupt signals. */
+	( void ) pthread_sigmask( SIG_BLOCK, &xInterruptSignals, NULL );
+
+	prvEventInit( &xSchedulerEndEvent );
+	xSchedulerStarted = pdTRUE;
+
+	/* Start the timer that generates the tick ISR.  Interrupts are disabled
+	here already. */
+	prvSetupTimerInterrupt();
+
+	/* Start the first task. */
+	prvEventSignal( &( prvGetThreadFromTask( xTaskGetCurrentTaskHandle() )->xEvent ) );
+
+	/* Wait until a task calls vTaskEndScheduler(). */
+	prvEventWait( &xSchedulerEndEvent );
+	prvEventDestroy( &xSchedulerEndEvent );
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+void vPortEndScheduler( void )
+{
+struct itimerval xTimer;
+
+	memset( &xTimer, 0, sizeof( xTimer ) );
+	( void ) setitimer( ITIMER_REAL, &xTimer, NULL );
+
+	xSchedulerStarted = pdFALSE;
+	( void ) pthread_sigmask( SIG_BLOCK, &xInterruptSignals, NULL );
+
+	/* Return control to the thread that called vTaskStartScheduler().  The
+	calling task's thread never runs again. */
+	prvEventSignal( &xSchedulerEndEvent );
+	pthread_exit( NULL );
+}
+/*-----------------------------------------------------------*/
+
+void vPortYield( void )
+{
+	xSwitchPending = pdTRUE;
+
+	/* As with PendSV, the switch is only taken once the interrupt has
+	returned or the critical section has exited. */
+	if( ( xInsideInterrupt == pdFALSE ) && ( xInterruptsMasked == pdFALSE ) )
+	{
+		vPortEnableInterrupts();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortDisableInterrupts( void )
+{
+	xInterruptsMasked = pdTRUE;
+	portMEMORY_BARRIER();
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnableInterrupts( void )
+{
+	for( ;; )
+	{
+		xInterruptsMasked = pdFALSE;
+		portMEMORY_BARRIER();
+
+		/* Only the running task's thread services interrupts. */
+		if( ( xSchedulerStarted == pdFALSE ) || ( xIsTaskThread == pdFALSE ) )
+		{
+			break;
+		}
+
+		if( ( ulPendingTicks == 0UL ) && ( ulPendingInterrupts == 0UL ) && ( xSwitchPending == pdFALSE ) )
+		{
+			break;
+		}
+
+		/* Something arrived while interrupts were masked.  A signal that
+		arrives from here on only marks itself pending, and is picked up on
+		the next iteration. */
+		xInterruptsMasked = pdTRUE;
+		portMEMORY_BARRIER();
+		prvServiceInterrupts();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnterCritical( void )
+{
+	vPortDisableInterrupts();
+	uxCriticalNesting++;
+}
+/*-----------------------------------------------------------*/
+
+void vPortExitCritical( void )
+{
+	configASSERT( uxCriticalNesting );
+	uxCriticalNesting--;
+	if( uxCriticalNesting == 0 )
+	{
+		vPortEnableInterrupts();
+	}
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxPortSetInterruptMask( void )
+{
+UBaseType_t uxReturn = ( UBaseType_t ) xInterruptsMasked;
+
+	vPortDisableInterrupts();
+	return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortClearInterruptMask( UBaseType_t uxMask )
+{
+	if( uxMask == ( UBaseType_t ) pdFALSE )
+	{
+		vPortEnableInterrupts();
+	}
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortIsInsideInterrupt( void )
+{
+	return xInsideInterrupt;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortInterruptsMasked( void )
+{
+	return xInterruptsMasked;
+}
+/*-----------------------------------------------------------*/
+
+void vPortSetInterruptHandler( uint32_t ulInterruptNumber, uint32_t ( *pvHandler )( void ) )
+{
+	configASSERT( ulInterruptNumber < portMAX_INTERRUPTS );
+
+	if( ulInterruptNumber < portMAX_INTERRUPTS )
+	{
+		pvInterruptHandlers[ ulInterruptNumber ] = pvHandler;
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortGenerateSimulatedInterrupt( uint32_t ulInterruptNumber )
+{
+	configASSERT( ulInterruptNumber < portMAX_INTERRUPTS );
+
+	( void ) __atomic_or_fetch( &ulPendingInterrupts, 1UL << ulInterruptNumber, __ATOMIC_SEQ_CST );
+
+	if( xIsTaskThread != pdFALSE )
+	{
+		/* Raised by the running task, or by an interrupt running on top of
+		it, so it can be serviced without going through a signal. */
+		if( ( xInsideInterrupt == pdFALSE ) && ( xInterruptsMasked == pdFALSE ) )
+		{
+			vPortEnableInterrupts();
+		}
+	}
+	else
+	{
+		/* Raised by a simulated peripheral.  Make sure the signal cannot be
+		delivered back to the calling thread, so it is taken by the thread
+		of the running task. */
+		( void ) pthread_once( &xSignalsSetup, prvSetupSignals );
+		( void ) pthread_sigmask( SIG_BLOCK, &xInterruptSignals, NULL );
+		( void ) kill( getpid(), portINTERRUPT_SIGNAL );
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortCancelThread( void *pxTaskToDelete )
+{
+Thread_t *pxThread = prvGetThreadFromTask( ( TaskHandle_t ) pxTaskToDelete );
+
+	/* The thread is parked, either waiting to run for the first time or in
+	prvSwitchThread().  Wake it so it can exit, and wait for it to do so
+	before the kernel frees the stack that holds its bookkeeping. */
+	pxThread->xDying = pdTRUE;
+	prvEventSignal( &pxThread->xEvent );
+	( void ) pthread_join( pxThread->xPthread, NULL );
+	prvEventDestroy( &pxThread->xEvent );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSetupSignals( void )
+{
+struct sigaction xAction;
+
+	( void ) sigemptyset( &xInterruptSignals );
+	( void ) sigaddset( &xInterruptSignals, portTICK_SIGNAL );
+	( void ) sigaddset( &xInterruptSignals, portINTERRUPT_SIGNAL );
+
+	memset( &xAction, 0, sizeof( xAction ) );
+	xAction.sa_handler = prvSignalHandler;
+	xAction.sa_mask = xInterruptSignals;
+	xAction.sa_flags = SA_RESTART;
+
+	( void ) sigaction( portTICK_SIGNAL, &xAction, NULL );
+	( void ) sigaction( portINTERRUPT_SIGNAL, &xAction, NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSetupTimerInterrupt( void )
+{
+struct itimerval xTimer;
+
+	memset( &xTimer, 0, sizeof( xTimer ) );
+	xTimer.it_interval.tv_usec = 1000000L / configTICK_RATE_HZ;
+	xTimer.it_value = xTimer.it_interval;
+
+	( void ) setitimer( ITIMER_REAL, &xTimer, NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSignalHandler( int iSignal )
+{
+int iSavedErrno = errno;
+
+	if( iSignal == portTICK_SIGNAL )
+	{
+		( void ) __atomic_add_fetch( &ulPendingTicks, 1UL, __ATOMIC_SEQ_CST );
+	}
+
+	/* Interrupts that arrive while masked stay pending until the mask is
+	cleared.  A thread that is not running a task leaves them for the thread
+	that is. */
+	if( ( xIsTaskThread != pdFALSE ) && ( xInterruptsMasked == pdFALSE ) && ( xInsideInterrupt == pdFALSE ) )
+	{
+		vPortEnableInterrupts();
+	}
+
+	errno = iSavedErrno;
+}
+/*-----------------------------------------------------------*/
+
+static void prvServiceInterrupts( void )
+{
+uint32_t ulTicks, ulPending, ulInterrupt;
+
+	xInsideInterrupt = pdTRUE;
+
+	ulTicks = __atomic_exchange_n( &ulPendingTicks, 0UL, __ATOMIC_SEQ_CST );
+	while( ulTicks > 0UL )
+	{
+		/* Increment the RTOS tick. */
+		if( xTaskIncrementTick() != pdFALSE )
+		{
+			/* A context switch is required. */
+			xSwitchPending = pdTRUE;
+		}
+		ulTicks--;
+	}
+
+	ulPending = __atomic_exchange_n( &ulPendingInterrupts, 0UL, __ATOMIC_SEQ_CST );
+	for( ulInterrupt = 0UL; ulPending != 0UL; ulInterrupt++, ulPending >>= 1UL )
+	{
+		if( ( ( ulPending & 1UL ) != 0UL ) && ( pvInterruptHandlers[ ulInterrupt ] != NULL ) )
+		{
+			if( pvInterruptHandlers[ ulInterrupt ]() != pdFALSE )
+			{
+				xSwitchPending = pdTRUE;
+			}
+		}
+	}
+
+	xInsideInterrupt = pdFALSE;
+
+	if( xSwitchPending != pdFALSE )
+	{
+		xSwitchPending = pdFALSE;
+		prvYieldNow();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvYieldNow( void )
+{
+Thread_t *pxOld, *pxNew;
+
+	configASSERT( uxCriticalNesting == 0 );
+
+	pxOld = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+	vTaskSwitchContext();
+	pxNew = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+
+	prvSwitchThread( pxNew, pxOld );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSwitchThread( Thread_t *pxNew, Thread_t *pxOld )
+{
+	if( pxNew != pxOld )
+	{
+		/* Block the interrupt signals in this thread before the next thread
+		starts, so only the running thread ever takes them. */
+		( void ) pthread_sigmask( SIG_BLOCK, &xInterruptSignals, NULL );
+
+		prvEventSignal( &pxNew->xEvent );
+		prvEventWait( &pxOld->xEvent );
+
+		if( pxOld->xDying != pdFALSE )
+		{
+			/* The task was deleted while it was switched out. */
+			pthread_exit( NULL );
+		}
+
+		( void ) pthread_sigmask( SIG_UNBLOCK, &xInterruptSignals, NULL );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static Thread_t *prvGetThreadFromTask( TaskHandle_t xTask )
+{
+StackType_t *pxTopOfStack = *( StackType_t ** ) xTask;
+
+	return ( Thread_t * ) ( pxTopOfStack + 1 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvEventInit( ThreadEvent_t *pxEvent )
+{
+	( void ) pthread_mutex_init( &pxEvent->xMutex, NULL );
+	( void ) pthread_cond_init( &pxEvent->xCond, NULL );
+	pxEvent->xSignalled = pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+static void prvEventSignal( ThreadEvent_t *pxEvent )
+{
+	( void ) pthread_mutex_lock( &pxEvent->xMutex );
+	pxEvent->xSignalled = pdTRUE;
+	( void ) pthread_cond_signal( &pxEvent->xCond );
+	( void ) pthread_mutex_unlock( &pxEvent->xMutex );
+}
+/*-----------------------------------------------------------*/
+
+static void prvEventWait( ThreadEvent_t *pxEvent )
+{
+	( void ) pthread_mutex_lock( &pxEvent->xMutex );
+	while( pxEvent->xSignalled == pdFALSE )
+	{
+		( void ) pthread_cond_wait( &pxEvent->xCond, &pxEvent->xMutex );
+	}
+	pxEvent->xSignalled = pdFALSE;
+	( void ) pthread_mutex_unlock( &pxEvent->xMutex );
+}
+/*-----------------------------------------------------------*/
+
+static void prvEventDestroy( ThreadEvent_t *pxEvent )
+{
+	( void ) pthread_cond_destroy( &pxEvent->xCond );
+	( void ) pthread_mutex_destroy( &pxEvent->xMutex );
+}
+/*-----------------------------------------------------------*/
+
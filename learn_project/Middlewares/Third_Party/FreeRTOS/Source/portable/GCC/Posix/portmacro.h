@@ -0,0 +1,157 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*-----------------------------------------------------------
+ * Port specific definitions.
+ *
+ * The settings in this file configure FreeRTOS correctly for a Linux host,
+ * where each task is backed by a pthread and only one of them is allowed to
+ * run at any one time.  See port.c for a description of how interrupts and
+ * context switches are simulated.
+ *
+ * These settings should not be altered.
+ *-----------------------------------------------------------
+ */
+
+#include <stddef.h>
+
+/* Type definitions. */
+#define portCHAR		char
+#define portFLOAT		float
+#define portDOUBLE		double
+#define portLONG		long
+#define portSHORT		short
+#define portSTACK_TYPE	unsigned long
+#define portBASE_TYPE	long
+#define portPOINTER_SIZE_TYPE	size_t
+
+typedef portSTACK_TYPE StackType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+
+#if( configUSE_16_BIT_TICKS == 1 )
+	typedef uint16_t TickType_t;
+	#define portMAX_DELAY ( TickType_t ) 0xffff
+#else
+	typedef uint32_t TickType_t;
+	#define portMAX_DELAY ( TickType_t ) 0xffffffffUL
+
+	/* 32-bit tick type on a 64-bit host, so reads of the tick count do not
+	need to be guarded with a critical section. */
+	#define portTICK_TYPE_IS_ATOMIC 1
+#endif
+/*-----------------------------------------------------------*/
+
+/* Architecture specifics. */
+#define portSTACK_GROWTH			( -1 )
+#define portTICK_PERIOD_MS			( ( TickType_t ) 1000 / configTICK_RATE_HZ )
+#define portBYTE_ALIGNMENT			8
+/*-----------------------------------------------------------*/
+
+/* Scheduler utilities. */
+extern void vPortYield( void );
+
+#define portYIELD()									vPortYield()
+#define portEND_SWITCHING_ISR( xSwitchRequired )	if( xSwitchRequired != pdFALSE ) portYIELD()
+#define portYIELD_FROM_ISR( x )						portEND_SWITCHING_ISR( x )
+/*-----------------------------------------------------------*/
+
+/* Critical section management. */
+extern void vPortEnterCritical( void );
+extern void vPortExitCritical( void );
+extern void vPortDisableInterrupts( void );
+extern void vPortEnableInterrupts( void );
+extern UBaseType_t uxPortSetInterruptMask( void );
+extern void vPortClearInterruptMask( UBaseType_t uxMask );
+
+#define portDISABLE_INTERRUPTS()				vPortDisableInterrupts()
+#define portENABLE_INTERRUPTS()					vPortEnableInterrupts()
+#define portENTER_CRITICAL()					vPortEnterCritical()
+#define portEXIT_CRITICAL()						vPortExitCritical()
+#define portSET_INTERRUPT_MASK_FROM_ISR()		uxPortSetInterruptMask()
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR(x)	vPortClearInterruptMask(x)
+/*-----------------------------------------------------------*/
+
+/* Task deletion.  The pthread backing a deleted task is woken so it can exit,
+and is then joined, before the kernel frees the task's stack. */
+extern void vPortCancelThread( void *pxTaskToDelete );
+#define portCLEAN_UP_TCB( pxTCB )	vPortCancelThread( pxTCB )
+/*-----------------------------------------------------------*/
+
+/* Simulated interrupts.  An interrupt handler returns pdTRUE if a context
+switch is required on exit from the interrupt, just as an ISR would pass
+xHigherPriorityTaskWoken to portYIELD_FROM_ISR() on the target.  Interrupts can
+be generated from a task, from another interrupt, or from a pthread that is not
+under the control of the scheduler (a simulated peripheral). */
+#define portMAX_INTERRUPTS			( 32UL )
+
+extern void vPortSetInterruptHandler( uint32_t ulInterruptNumber, uint32_t ( *pvHandler )( void ) );
+extern void vPortGenerateSimulatedInterrupt( uint32_t ulInterruptNumber );
+extern BaseType_t xPortIsInsideInterrupt( void );
+extern BaseType_t xPortInterruptsMasked( void );
+/*-----------------------------------------------------------*/
+
+/* Task function macros as described on the FreeRTOS.org WEB site.  These are
+not necessary for to use this port.  They are defined so the common demo files
+(which build with all the ports) will build. */
+#define portTASK_FUNCTION_PROTO( vFunction, pvParameters ) void vFunction( void *pvParameters )
+#define portTASK_FUNCTION( vFunction, pvParameters ) void vFunction( void *pvParameters )
+/*-----------------------------------------------------------*/
+
+#define portNOP()		__asm volatile( "nop" )
+
+#define portINLINE __inline
+
+#ifndef portFORCE_INLINE
+	#define portFORCE_INLINE inline __attribute__(( always_inline ))
+#endif
+
+/* Compare and swap used by the mutex fast path, with the C11 atomic builtins
+so that it is atomic with respect to the thread switches of this port. */
+static portFORCE_INLINE BaseType_t xPortCompareAndSwap( volatile size_t *puxDestination, size_t uxExpected, size_t uxNew )
+{
+	return __atomic_compare_exchange_n( puxDestination, &uxExpected, uxNew, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST ) ? pdTRUE : pdFALSE;
+}
+
+#define portCOMPARE_AND_SWAP_POINTER( pxDestination, xExpected, xNew )	xPortCompareAndSwap( ( pxDestination ), ( xExpected ), ( xNew ) )
+
+#define portMEMORY_BARRIER() __asm volatile( "" ::: "memory" )
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PORTMACRO_H */
+
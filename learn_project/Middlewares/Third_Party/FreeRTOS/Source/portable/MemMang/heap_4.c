@@ -34,6 +34,7 @@
  * memory management pages of http://www.FreeRTOS.org for more information.
  */
 #include <stdlib.h>
+#include <stddef.h>
 
 /* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
 all the API functions to use the MPU wrappers.  That should only be done when
@@ -64,6 +65,8 @@ task.h is included from an application file. */
 	static uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
 #endif /* configAPPLICATION_ALLOCATED_HEAP */
 
+#if( configUSE_TLSF_HEAP == 0 )
+
 /* Define the linked list structure.  This is used to link free blocks in order
 of their memory address. */
 typedef struct A_BLOCK_LINK
@@ -82,6 +85,70 @@ typedef struct A_BLOCK_LINK
  */
 static void prvInsertBlockIntoFreeList( BlockLink_t *pxBlockToInsert );
 
+#else /* configUSE_TLSF_HEAP */
+
+/* Define the block header.  Every block, free or allocated, starts with the
+first two members, which let a block that is being freed find both of its
+neighbours in memory without searching.  The free list links are only valid
+while the block is free, and overlay the application's data otherwise. */
+typedef struct A_BLOCK_LINK
+{
+	struct A_BLOCK_LINK *pxPrevPhysBlock;	/*<< The block immediately below this one in memory, NULL for the first block. */
+	size_t xBlockSize;						/*<< The size of the block, including the header. */
+	struct A_BLOCK_LINK *pxNextFreeBlock;	/*<< The next free block in the same size class. */
+	struct A_BLOCK_LINK *pxPrevFreeBlock;	/*<< The previous free block in the same size class. */
+} BlockLink_t;
+
+/* Free blocks are kept in segregated lists (two level segregated fit).  The
+first level splits block sizes into powers of two, and the second level splits
+each power of two into heapSL_COUNT equal ranges.  Blocks smaller than
+heapSMALL_BLOCK_SIZE all share first level 0, in steps of portBYTE_ALIGNMENT.
+A bitmap per level records which lists are not empty, so a suitable list is
+found with a fixed number of bit operations whatever the state of the heap. */
+#define heapLOG2_2( x )			( ( ( x ) & 0x2UL ) ? 1U : 0U )
+#define heapLOG2_4( x )			( ( ( x ) & 0xCUL ) ? ( 2U + heapLOG2_2( ( x ) >> 2 ) ) : heapLOG2_2( x ) )
+#define heapLOG2_8( x )			( ( ( x ) & 0xF0UL ) ? ( 4U + heapLOG2_4( ( x ) >> 4 ) ) : heapLOG2_4( x ) )
+#define heapLOG2_16( x )		( ( ( x ) & 0xFF00UL ) ? ( 8U + heapLOG2_8( ( x ) >> 8 ) ) : heapLOG2_8( x ) )
+#define heapLOG2( x )			( ( ( x ) & 0xFFFF0000UL ) ? ( 16U + heapLOG2_16( ( x ) >> 16 ) ) : heapLOG2_16( x ) )
+
+#define heapSL_LOG2				( 3U )
+#define heapSL_COUNT			( 1U << heapSL_LOG2 )
+#define heapSMALL_BLOCK_SIZE	( ( size_t ) heapSL_COUNT * portBYTE_ALIGNMENT )
+#define heapFL_SHIFT			( heapSL_LOG2 + heapLOG2( portBYTE_ALIGNMENT ) )
+#define heapFL_COUNT			( heapLOG2( configTOTAL_HEAP_SIZE ) - heapFL_SHIFT + 2U )
+
+/* The block that follows pxBlock in memory.  The void cast is used to prevent
+byte alignment warnings from the compiler. */
+#define heapNEXT_PHYS_BLOCK( pxBlock )	( ( BlockLink_t * ) ( void * ) ( ( ( uint8_t * ) ( pxBlock ) ) + ( ( pxBlock )->xBlockSize & ~xBlockAllocatedBit ) ) )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Adds a free block to, or removes it from, the list for its size class.
+ */
+static void prvInsertFreeBlock( BlockLink_t *pxBlock );
+static void prvRemoveFreeBlock( BlockLink_t *pxBlock );
+
+/*
+ * Returns a free block of at least xWantedSize bytes, or NULL if none can be
+ * found.  The block is left in its free list.
+ */
+static BlockLink_t *prvFindFreeBlock( size_t xWantedSize );
+
+/*
+ * Calculates the first and second level indexes of the list that holds free
+ * blocks of xSize bytes.
+ */
+static void prvMapSize( size_t xSize, UBaseType_t *puxFirstLevel, UBaseType_t *puxSecondLevel );
+
+/*
+ * Returns the index of the most significant set bit in ulValue, which must not
+ * be zero.
+ */
+static UBaseType_t prvHighestSetBit( uint32_t ulValue );
+
+#endif /* configUSE_TLSF_HEAP */
+
 /*
  * Called automatically to setup the required heap structures the first time
  * pvPortMalloc() is called.
@@ -90,6 +157,8 @@ static void prvHeapInit( void );
 
 /*-----------------------------------------------------------*/
 
+#if( configUSE_TLSF_HEAP == 0 )
+
 /* The size of the structure placed at the beginning of each allocated memory
 block must by correctly byte aligned. */
 static const size_t xHeapStructSize	= ( sizeof( BlockLink_t ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
@@ -97,6 +166,25 @@ static const size_t xHeapStructSize	= ( sizeof( BlockLink_t ) + ( ( size_t ) ( p
 /* Create a couple of list links to mark the start and end of the list. */
 static BlockLink_t xStart, *pxEnd = NULL;
 
+#else /* configUSE_TLSF_HEAP */
+
+/* Only the members that are always valid are placed in front of an allocated
+block.  Rounded up to a multiple of portBYTE_ALIGNMENT this is the same size as
+the stock header, so the TLSF lists cost no extra memory per allocation. */
+static const size_t xHeapStructSize	= ( offsetof( BlockLink_t, pxNextFreeBlock ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+/* Marks the end of the heap.  It is a zero length block that is always
+allocated, so it is never merged with the last real block. */
+static BlockLink_t *pxEnd = NULL;
+
+/* The segregated free lists, and the bitmaps of the lists that are not empty.
+Bit n of ulFirstLevelBits is set when ulSecondLevelBits[ n ] is not zero. */
+static BlockLink_t *pxFreeLists[ heapFL_COUNT ][ heapSL_COUNT ];
+static uint32_t ulFirstLevelBits = 0U;
+static uint32_t ulSecondLevelBits[ heapFL_COUNT ];
+
+#endif /* configUSE_TLSF_HEAP */
+
 /* Keeps track of the number of calls to allocate and free memory as well as the
 number of free bytes remaining, but says nothing about fragmentation. */
 static size_t xFreeBytesRemaining = 0U;
@@ -112,6 +200,8 @@ static size_t xBlockAllocatedBit = 0;
 
 /*-----------------------------------------------------------*/
 
+#if( configUSE_TLSF_HEAP == 0 )
+
 void *pvPortMalloc( size_t xWantedSize )
 {
 BlockLink_t *pxBlock, *pxPreviousBlock, *pxNewBlockLink;
@@ -312,6 +402,8 @@ BlockLink_t *pxLink;
 }
 /*-----------------------------------------------------------*/
 
+#endif /* configUSE_TLSF_HEAP */
+
 size_t xPortGetFreeHeapSize( void )
 {
 	return xFreeBytesRemaining;
@@ -330,6 +422,8 @@ void vPortInitialiseBlocks( void )
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_TLSF_HEAP == 0 )
+
 static void prvHeapInit( void )
 {
 BlockLink_t *pxFirstFreeBlock;
@@ -490,3 +584,530 @@ size_t xBlocks = 0, xMaxSize = 0, xMinSize = portMAX_DELAY; /* portMAX_DELAY use
 	taskEXIT_CRITICAL();
 }
 
+#else /* configUSE_TLSF_HEAP */
+
+void *pvPortMalloc( size_t xWantedSize )
+{
+BlockLink_t *pxBlock, *pxNewBlockLink;
+void *pvReturn = NULL;
+
+	vTaskSuspendAll();
+	{
+		/* If this is the first call to malloc then the heap will require
+		initialisation to setup the free lists. */
+		if( pxEnd == NULL )
+		{
+			prvHeapInit();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* Check the requested block size is not so large that the top bit is
+		set.  The top bit of the block size member of the BlockLink_t structure
+		is used to determine who owns the block - the application or the
+		kernel, so it must be free. */
+		if( ( xWantedSize & xBlockAllocatedBit ) == 0 )
+		{
+			/* The wanted size is increased so it can contain the block header
+			in addition to the requested amount of bytes. */
+			if( xWantedSize > 0 )
+			{
+				xWantedSize += xHeapStructSize;
+
+				/* Ensure that blocks are always aligned to the required number
+				of bytes. */
+				if( ( xWantedSize & portBYTE_ALIGNMENT_MASK ) != 0x00 )
+				{
+					/* Byte alignment required. */
+					xWantedSize += ( portBYTE_ALIGNMENT - ( xWantedSize & portBYTE_ALIGNMENT_MASK ) );
+					configASSERT( ( xWantedSize & portBYTE_ALIGNMENT_MASK ) == 0 );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				/* The block must be able to hold the free list links once it
+				is freed again. */
+				if( xWantedSize < heapMINIMUM_BLOCK_SIZE )
+				{
+					xWantedSize = heapMINIMUM_BLOCK_SIZE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( ( xWantedSize > 0 ) && ( xWantedSize <= xFreeBytesRemaining ) )
+			{
+				pxBlock = prvFindFreeBlock( xWantedSize );
+
+				if( pxBlock != NULL )
+				{
+					/* Return the memory space pointed to - jumping over the
+					block header at its start. */
+					pvReturn = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xHeapStructSize );
+
+					/* This block is being returned for use so must be taken out
+					of its free list. */
+					prvRemoveFreeBlock( pxBlock );
+
+					/* If the block is larger than required it can be split into
+					two. */
+					if( ( pxBlock->xBlockSize - xWantedSize ) > heapMINIMUM_BLOCK_SIZE )
+					{
+						/* This block is to be split into two.  Create a new
+						block following the number of bytes requested. The void
+						cast is used to prevent byte alignment warnings from the
+						compiler. */
+						pxNewBlockLink = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xWantedSize );
+						configASSERT( ( ( ( size_t ) pxNewBlockLink ) & portBYTE_ALIGNMENT_MASK ) == 0 );
+
+						/* Calculate the sizes of two blocks split from the
+						single block. */
+						pxNewBlockLink->xBlockSize = pxBlock->xBlockSize - xWantedSize;
+						pxNewBlockLink->pxPrevPhysBlock = pxBlock;
+						pxBlock->xBlockSize = xWantedSize;
+
+						/* Free blocks are always merged with their neighbours,
+						so the block after the new one is allocated and only
+						needs to learn its new neighbour. */
+						heapNEXT_PHYS_BLOCK( pxNewBlockLink )->pxPrevPhysBlock = pxNewBlockLink;
+						prvInsertFreeBlock( pxNewBlockLink );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					xFreeBytesRemaining -= pxBlock->xBlockSize;
+
+					if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+					{
+						xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					/* The block is being returned - it is allocated and owned
+					by the application. */
+					pxBlock->xBlockSize |= xBlockAllocatedBit;
+					xNumberOfSuccessfulAllocations++;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		traceMALLOC( pvReturn, xWantedSize );
+	}
+	( void ) xTaskResumeAll();
+
+	#if( configUSE_MALLOC_FAILED_HOOK == 1 )
+	{
+		if( pvReturn == NULL )
+		{
+			extern void vApplicationMallocFailedHook( void );
+			vApplicationMallocFailedHook();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif
+
+	configASSERT( ( ( ( size_t ) pvReturn ) & ( size_t ) portBYTE_ALIGNMENT_MASK ) == 0 );
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void *pv )
+{
+uint8_t *puc = ( uint8_t * ) pv;
+BlockLink_t *pxLink, *pxNeighbour;
+
+	if( pv != NULL )
+	{
+		/* The memory being freed will have a block header immediately before
+		it. */
+		puc -= xHeapStructSize;
+
+		/* This casting is to keep the compiler from issuing warnings. */
+		pxLink = ( void * ) puc;
+
+		/* Check the block is actually allocated. */
+		configASSERT( ( pxLink->xBlockSize & xBlockAllocatedBit ) != 0 );
+
+		if( ( pxLink->xBlockSize & xBlockAllocatedBit ) != 0 )
+		{
+			vTaskSuspendAll();
+			{
+				/* The block is being returned to the heap - it is no longer
+				allocated.  Unlike the address ordered list the allocated bit
+				is read by the merge in other calls to vPortFree(), so it is
+				only cleared with the scheduler suspended. */
+				pxLink->xBlockSize &= ~xBlockAllocatedBit;
+				xFreeBytesRemaining += pxLink->xBlockSize;
+				traceFREE( pv, pxLink->xBlockSize );
+
+				/* Merge with the block above, if it is free.  pxEnd is marked
+				as allocated so is never merged. */
+				pxNeighbour = heapNEXT_PHYS_BLOCK( pxLink );
+				if( ( pxNeighbour->xBlockSize & xBlockAllocatedBit ) == 0 )
+				{
+					prvRemoveFreeBlock( pxNeighbour );
+					pxLink->xBlockSize += pxNeighbour->xBlockSize;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				/* Merge with the block below, if it is free. */
+				pxNeighbour = pxLink->pxPrevPhysBlock;
+				if( ( pxNeighbour != NULL ) && ( ( pxNeighbour->xBlockSize & xBlockAllocatedBit ) == 0 ) )
+				{
+					prvRemoveFreeBlock( pxNeighbour );
+					pxNeighbour->xBlockSize += pxLink->xBlockSize;
+					pxLink = pxNeighbour;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				heapNEXT_PHYS_BLOCK( pxLink )->pxPrevPhysBlock = pxLink;
+				prvInsertFreeBlock( pxLink );
+				xNumberOfSuccessfulFrees++;
+			}
+			( void ) xTaskResumeAll();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvHeapInit( void )
+{
+BlockLink_t *pxFirstFreeBlock;
+uint8_t *pucAlignedHeap;
+size_t uxAddress;
+size_t xTotalHeapSize = configTOTAL_HEAP_SIZE;
+
+	/* The bitmaps hold one bit per list. */
+	configASSERT( heapFL_COUNT <= 32U );
+
+	/* Ensure the heap starts on a correctly aligned boundary. */
+	uxAddress = ( size_t ) ucHeap;
+
+	if( ( uxAddress & portBYTE_ALIGNMENT_MASK ) != 0 )
+	{
+		uxAddress += ( portBYTE_ALIGNMENT - 1 );
+		uxAddress &= ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+		xTotalHeapSize -= uxAddress - ( size_t ) ucHeap;
+	}
+
+	pucAlignedHeap = ( uint8_t * ) uxAddress;
+
+	/* Work out the position of the top bit in a size_t variable.  This is
+	needed before pxEnd can be marked as allocated. */
+	xBlockAllocatedBit = ( ( size_t ) 1 ) << ( ( sizeof( size_t ) * heapBITS_PER_BYTE ) - 1 );
+
+	/* pxEnd is a zero length, allocated block at the end of the heap space. */
+	uxAddress = ( ( size_t ) pucAlignedHeap ) + xTotalHeapSize;
+	uxAddress -= xHeapStructSize;
+	uxAddress &= ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+	pxEnd = ( void * ) uxAddress;
+	pxEnd->xBlockSize = xBlockAllocatedBit;
+
+	/* To start with there is a single free block that is sized to take up the
+	entire heap space, minus the space taken by pxEnd. */
+	pxFirstFreeBlock = ( void * ) pucAlignedHeap;
+	pxFirstFreeBlock->xBlockSize = uxAddress - ( size_t ) pxFirstFreeBlock;
+	pxFirstFreeBlock->pxPrevPhysBlock = NULL;
+	pxEnd->pxPrevPhysBlock = pxFirstFreeBlock;
+	prvInsertFreeBlock( pxFirstFreeBlock );
+
+	/* Only one block exists - and it covers the entire usable heap space. */
+	xMinimumEverFreeBytesRemaining = pxFirstFreeBlock->xBlockSize;
+	xFreeBytesRemaining = pxFirstFreeBlock->xBlockSize;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvHighestSetBit( uint32_t ulValue )
+{
+static const uint8_t ucDeBruijnBitPosition[ 32 ] =
+{
+	0U, 9U, 1U, 10U, 13U, 21U, 2U, 29U, 11U, 14U, 16U, 18U, 22U, 25U, 3U, 30U,
+	8U, 12U, 20U, 28U, 15U, 17U, 24U, 7U, 19U, 27U, 23U, 6U, 26U, 5U, 4U, 31U
+};
+
+	/* Same method as the portable ready priority selection in tasks.c: smear
+	the top bit downwards, then map the resulting 2^n - 1 value to n with a de
+	Bruijn multiply. */
+	ulValue |= ulValue >> 1;
+	ulValue |= ulValue >> 2;
+	ulValue |= ulValue >> 4;
+	ulValue |= ulValue >> 8;
+	ulValue |= ulValue >> 16;
+
+	return ( UBaseType_t ) ucDeBruijnBitPosition[ ( uint32_t ) ( ulValue * 0x07C4ACDDUL ) >> 27 ];
+}
+/*-----------------------------------------------------------*/
+
+static void prvMapSize( size_t xSize, UBaseType_t *puxFirstLevel, UBaseType_t *puxSecondLevel )
+{
+UBaseType_t uxTopBit;
+
+	if( xSize < heapSMALL_BLOCK_SIZE )
+	{
+		*puxFirstLevel = 0U;
+		*puxSecondLevel = ( UBaseType_t ) ( xSize / portBYTE_ALIGNMENT );
+	}
+	else
+	{
+		/* The second level index is the heapSL_LOG2 bits that follow the most
+		significant set bit. */
+		uxTopBit = prvHighestSetBit( ( uint32_t ) xSize );
+		*puxFirstLevel = uxTopBit - heapFL_SHIFT + 1U;
+		*puxSecondLevel = ( UBaseType_t ) ( xSize >> ( uxTopBit - heapSL_LOG2 ) ) - heapSL_COUNT;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertFreeBlock( BlockLink_t *pxBlock )
+{
+UBaseType_t uxFirstLevel, uxSecondLevel;
+
+	prvMapSize( pxBlock->xBlockSize, &uxFirstLevel, &uxSecondLevel );
+
+	/* Blocks are added to the front of the list. */
+	pxBlock->pxPrevFreeBlock = NULL;
+	pxBlock->pxNextFreeBlock = pxFreeLists[ uxFirstLevel ][ uxSecondLevel ];
+
+	if( pxBlock->pxNextFreeBlock != NULL )
+	{
+		pxBlock->pxNextFreeBlock->pxPrevFreeBlock = pxBlock;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	pxFreeLists[ uxFirstLevel ][ uxSecondLevel ] = pxBlock;
+	ulFirstLevelBits |= ( 1UL << uxFirstLevel );
+	ulSecondLevelBits[ uxFirstLevel ] |= ( 1UL << uxSecondLevel );
+}
+/*-----------------------------------------------------------*/
+
+static void prvRemoveFreeBlock( BlockLink_t *pxBlock )
+{
+UBaseType_t uxFirstLevel, uxSecondLevel;
+
+	prvMapSize( pxBlock->xBlockSize, &uxFirstLevel, &uxSecondLevel );
+
+	if( pxBlock->pxNextFreeBlock != NULL )
+	{
+		pxBlock->pxNextFreeBlock->pxPrevFreeBlock = pxBlock->pxPrevFreeBlock;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( pxBlock->pxPrevFreeBlock != NULL )
+	{
+		pxBlock->pxPrevFreeBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+	}
+	else
+	{
+		/* The block was at the front of its list. */
+		pxFreeLists[ uxFirstLevel ][ uxSecondLevel ] = pxBlock->pxNextFreeBlock;
+
+		if( pxBlock->pxNextFreeBlock == NULL )
+		{
+			ulSecondLevelBits[ uxFirstLevel ] &= ~( 1UL << uxSecondLevel );
+
+			if( ulSecondLevelBits[ uxFirstLevel ] == 0U )
+			{
+				ulFirstLevelBits &= ~( 1UL << uxFirstLevel );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static BlockLink_t *prvFindFreeBlock( size_t xWantedSize )
+{
+BlockLink_t *pxBlock = NULL;
+UBaseType_t uxFirstLevel, uxSecondLevel;
+uint32_t ulBits;
+size_t xSearchSize = xWantedSize;
+
+	/* Round the size up to the start of the next size class, so that every
+	block in the list that is found is big enough and no list has to be
+	searched. */
+	if( xWantedSize >= heapSMALL_BLOCK_SIZE )
+	{
+		xSearchSize += ( ( size_t ) 1 << ( prvHighestSetBit( ( uint32_t ) xWantedSize ) - heapSL_LOG2 ) ) - 1U;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	prvMapSize( xSearchSize, &uxFirstLevel, &uxSecondLevel );
+
+	if( uxFirstLevel < heapFL_COUNT )
+	{
+		/* First look for a list in the same first level, then for the smallest
+		non empty first level above it. */
+		ulBits = ulSecondLevelBits[ uxFirstLevel ] & ( 0xFFFFFFFFUL << uxSecondLevel );
+
+		if( ulBits == 0U )
+		{
+			ulBits = ulFirstLevelBits & ( 0xFFFFFFFFUL << ( uxFirstLevel + 1U ) );
+
+			if( ulBits != 0U )
+			{
+				uxFirstLevel = prvHighestSetBit( ulBits & ( 0U - ulBits ) );
+				ulBits = ulSecondLevelBits[ uxFirstLevel ];
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( ulBits != 0U )
+		{
+			pxBlock = pxFreeLists[ uxFirstLevel ][ prvHighestSetBit( ulBits & ( 0U - ulBits ) ) ];
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	/* Rounding up skips the blocks in the wanted size's own class, which
+	matters when most of the free space is in one block of that class.  Only
+	the block at the front of that list is checked, to keep the time bounded. */
+	if( pxBlock == NULL )
+	{
+		prvMapSize( xWantedSize, &uxFirstLevel, &uxSecondLevel );
+
+		if( uxFirstLevel < heapFL_COUNT )
+		{
+			pxBlock = pxFreeLists[ uxFirstLevel ][ uxSecondLevel ];
+
+			if( ( pxBlock != NULL ) && ( pxBlock->xBlockSize < xWantedSize ) )
+			{
+				pxBlock = NULL;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return pxBlock;
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapStats( HeapStats_t *pxHeapStats )
+{
+BlockLink_t *pxBlock;
+size_t xBlocks = 0, xMaxSize = 0, xMinSize = portMAX_DELAY; /* portMAX_DELAY used as a portable way of getting the maximum value. */
+UBaseType_t uxFirstLevel, uxSecondLevel;
+
+	vTaskSuspendAll();
+	{
+		/* pxEnd is NULL until the heap has been initialised, in which case
+		all the lists are still empty. */
+		for( uxFirstLevel = 0U; uxFirstLevel < heapFL_COUNT; uxFirstLevel++ )
+		{
+			for( uxSecondLevel = 0U; uxSecondLevel < heapSL_COUNT; uxSecondLevel++ )
+			{
+				for( pxBlock = pxFreeLists[ uxFirstLevel ][ uxSecondLevel ]; pxBlock != NULL; pxBlock = pxBlock->pxNextFreeBlock )
+				{
+					/* Increment the number of blocks and record the largest
+					and smallest block sizes. */
+					xBlocks++;
+
+					if( pxBlock->xBlockSize > xMaxSize )
+					{
+						xMaxSize = pxBlock->xBlockSize;
+					}
+
+					if( pxBlock->xBlockSize < xMinSize )
+					{
+						xMinSize = pxBlock->xBlockSize;
+					}
+				}
+			}
+		}
+	}
+	xTaskResumeAll();
+
+	pxHeapStats->xSizeOfLargestFreeBlockInBytes = xMaxSize;
+	pxHeapStats->xSizeOfSmallestFreeBlockInBytes = xMinSize;
+	pxHeapStats->xNumberOfFreeBlocks = xBlocks;
+
+	taskENTER_CRITICAL();
+	{
+		pxHeapStats->xAvailableHeapSpaceInBytes = xFreeBytesRemaining;
+		pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
+		pxHeapStats->xNumberOfSuccessfulFrees = xNumberOfSuccessfulFrees;
+		pxHeapStats->xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytesRemaining;
+	}
+	taskEXIT_CRITICAL();
+}
+#endif /* configUSE_TLSF_HEAP */
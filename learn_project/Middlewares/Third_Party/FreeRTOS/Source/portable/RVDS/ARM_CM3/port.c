@@ -33,6 +33,10 @@
 #include "FreeRTOS.h"
 #include "task.h"
 
+#if( configUSE_TICKLESS_TIMER == 1 )
+	#include "porttickless.h"
+#endif
+
 #ifndef configKERNEL_INTERRUPT_PRIORITY
 	#define configKERNEL_INTERRUPT_PRIORITY 255
 #endif
@@ -152,10 +156,25 @@ static UBaseType_t uxCriticalNesting = 0xaaaaaaaa;
  * Compensate for the CPU cycles that pass while the SysTick is stopped (low
  * power functionality only.
  */
-#if( configUSE_TICKLESS_IDLE == 1 )
+#if( ( configUSE_TICKLESS_IDLE == 1 ) && ( configUSE_TICKLESS_TIMER == 0 ) )
 	static uint32_t ulStoppedTimerCompensation = 0;
 #endif /* configUSE_TICKLESS_IDLE */
 
+/*
+ * When configUSE_TICKLESS_TIMER is 1 the tick is generated by a compare match
+ * on a free running 16-bit timer provided by the application, rather than by
+ * the SysTick, so the idle task can sleep for far longer than the SysTick's 24
+ * bits allow.  ulTicklessTimerLastTick holds the timer count at which the most
+ * recent tick accounted for by the kernel fell due.  Ticks are only ever
+ * accounted for in whole multiples of ulTimerCountsForOneTick from it, and the
+ * timer is never stopped, so sleeping does not make the tick count drift from
+ * the timer.
+ */
+#if( configUSE_TICKLESS_TIMER == 1 )
+	static uint32_t ulTicklessTimerLastTick = 0;
+	static BaseType_t prvTicklessTimerService( void );
+#endif /* configUSE_TICKLESS_TIMER */
+
 /*
  * Used by the portASSERT_IF_INTERRUPT_PRIORITY_INVALID() macro to ensure
  * FreeRTOS API functions are not called from interrupts that have been assigned
@@ -429,7 +448,7 @@ void xPortSysTickHandler( void )
 }
 /*-----------------------------------------------------------*/
 
-#if( configUSE_TICKLESS_IDLE == 1 )
+#if( ( configUSE_TICKLESS_IDLE == 1 ) && ( configUSE_TICKLESS_TIMER == 0 ) )
 
 	__weak void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
 	{
@@ -594,14 +613,169 @@ void xPortSysTickHandler( void )
 	}
 
 #endif /* #if configUSE_TICKLESS_IDLE */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TICKLESS_TIMER == 1 )
+
+	static BaseType_t prvTicklessTimerService( void )
+	{
+	BaseType_t xSwitchRequired = pdFALSE;
+
+		do
+		{
+			/* Account for every tick period that has completed since the last
+			tick, in case the interrupt was held off for longer than one. */
+			while( portTICKLESS_COUNTS_SINCE( ulApplicationTicklessTimerCount(), ulTicklessTimerLastTick ) >= ulTimerCountsForOneTick )
+			{
+				ulTicklessTimerLastTick = portTICKLESS_COUNT_AFTER( ulTicklessTimerLastTick, 1UL, ulTimerCountsForOneTick );
+
+				if( xTaskIncrementTick() != pdFALSE )
+				{
+					xSwitchRequired = pdTRUE;
+				}
+			}
+
+			/* Interrupt at the end of the current tick period.  A compare match
+			only occurs when the counter reaches the compare value, so if the
+			counter passed the end of the period before the register was
+			written the tick is processed here, rather than when the counter
+			next wraps. */
+			vApplicationTicklessTimerSetCompare( portTICKLESS_COUNT_AFTER( ulTicklessTimerLastTick, 1UL, ulTimerCountsForOneTick ) );
+
+		} while( portTICKLESS_COUNTS_SINCE( ulApplicationTicklessTimerCount(), ulTicklessTimerLastTick ) >= ulTimerCountsForOneTick );
+
+		return xSwitchRequired;
+	}
+	/*-----------------------------------------------------------*/
+
+	void xPortTicklessTimerHandler( void )
+	{
+		/* The timer interrupt runs at the lowest interrupt priority, as the
+		SysTick does - see the comments in xPortSysTickHandler(). */
+		vPortRaiseBASEPRI();
+		{
+			if( prvTicklessTimerService() != pdFALSE )
+			{
+				/* A context switch is required.  Context switching is performed
+				in the PendSV interrupt.  Pend the PendSV interrupt. */
+				portNVIC_INT_CTRL_REG = portNVIC_PENDSVSET_BIT;
+			}
+		}
+		vPortClearBASEPRIFromISR();
+	}
+	/*-----------------------------------------------------------*/
+
+	uint32_t ulPortTicklessTimerCountsSinceTick( void )
+	{
+		return portTICKLESS_COUNTS_SINCE( ulApplicationTicklessTimerCount(), ulTicklessTimerLastTick );
+	}
+	/*-----------------------------------------------------------*/
+
+	__weak void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
+	{
+	uint32_t ulCountsSinceTick, ulCompleteTickPeriods;
+	TickType_t xModifiableIdleTime;
+
+		/* Make sure the compare value stays within one period of the
+		counter. */
+		if( xExpectedIdleTime > xMaximumPossibleSuppressedTicks )
+		{
+			xExpectedIdleTime = xMaximumPossibleSuppressedTicks;
+		}
+
+		/* Enter a critical section but don't use the taskENTER_CRITICAL()
+		method as that will mask interrupts that should exit sleep mode. */
+		__disable_irq();
+		__dsb( portSY_FULL_READ_WRITE );
+		__isb( portSY_FULL_READ_WRITE );
+
+		/* If a context switch is pending, a task is waiting for the scheduler
+		to be unsuspended, or the end of the current tick period has already
+		been reached (the tick interrupt is pending, and runs as soon as
+		interrupts are enabled again) then abandon the low power entry. */
+		if( ( eTaskConfirmSleepModeStatus() == eAbortSleep ) ||
+			( ulPortTicklessTimerCountsSinceTick() >= ulTimerCountsForOneTick ) )
+		{
+			__enable_irq();
+		}
+		else
+		{
+			/* Move the compare match from the end of the current tick period
+			to the end of the last period being suppressed.  Unlike the SysTick
+			the timer is not stopped to do this, so no time is lost. */
+			vApplicationTicklessTimerSetCompare( portTICKLESS_COUNT_AFTER( ulTicklessTimerLastTick, xExpectedIdleTime, ulTimerCountsForOneTick ) );
+
+			/* Sleep until something happens.  configPRE_SLEEP_PROCESSING() can
+			set its parameter to 0 to indicate that its implementation contains
+			its own wait for interrupt or wait for event instruction, and so wfi
+			should not be executed again.  However, the original expected idle
+			time variable must remain unmodified, so a copy is taken. */
+			xModifiableIdleTime = xExpectedIdleTime;
+			configPRE_SLEEP_PROCESSING( xModifiableIdleTime );
+			if( xModifiableIdleTime > 0 )
+			{
+				__dsb( portSY_FULL_READ_WRITE );
+				__wfi();
+				__isb( portSY_FULL_READ_WRITE );
+			}
+			configPOST_SLEEP_PROCESSING( xExpectedIdleTime );
+
+			/* Interrupts stay disabled until the tick count has been brought up
+			to date, so the interrupt that ended the sleep sees the correct
+			time.  Step the tick count over the complete tick periods that
+			passed while asleep, but leave the last one expected to
+			prvTicklessTimerService(), so it is processed as a normal tick and
+			the task waiting for it is unblocked.  If another interrupt ended
+			the sleep early no tick is due yet. */
+			ulCountsSinceTick = ulPortTicklessTimerCountsSinceTick();
+			ulCompleteTickPeriods = portTICKLESS_STEP_TICKS( ulCountsSinceTick, ulTimerCountsForOneTick, xExpectedIdleTime );
+			ulTicklessTimerLastTick = portTICKLESS_COUNT_AFTER( ulTicklessTimerLastTick, ulCompleteTickPeriods, ulTimerCountsForOneTick );
+			vTaskStepTick( ulCompleteTickPeriods );
+
+			/* Process the final tick if it is due and move the compare match
+			back to the end of the current tick period. */
+			if( prvTicklessTimerService() != pdFALSE )
+			{
+				portNVIC_INT_CTRL_REG = portNVIC_PENDSVSET_BIT;
+			}
+
+			/* Exit with interrupts enabled. */
+			__enable_irq();
+		}
+	}
+
+#endif /* configUSE_TICKLESS_TIMER */
 
 /*-----------------------------------------------------------*/
 
+/*
+ * Setup the timer provided by the application to generate the tick interrupts
+ * in place of the SysTick.
+ */
+#if( configUSE_TICKLESS_TIMER == 1 )
+
+	void vPortSetupTimerInterrupt( void )
+	{
+		ulTimerCountsForOneTick = ( configTICKLESS_TIMER_HZ / configTICK_RATE_HZ );
+		configASSERT( ( ulTimerCountsForOneTick * configTICK_RATE_HZ ) == configTICKLESS_TIMER_HZ );
+
+		xMaximumPossibleSuppressedTicks = portTICKLESS_MAX_SUPPRESSED_TICKS( ulTimerCountsForOneTick );
+
+		/* The SysTick is not used. */
+		portNVIC_SYSTICK_CTRL_REG = 0UL;
+
+		/* Start the timer counting at configTICKLESS_TIMER_HZ, and generate the
+		first tick one tick period from now. */
+		vApplicationTicklessTimerSetup();
+		ulTicklessTimerLastTick = ulApplicationTicklessTimerCount();
+		vApplicationTicklessTimerSetCompare( portTICKLESS_COUNT_AFTER( ulTicklessTimerLastTick, 1UL, ulTimerCountsForOneTick ) );
+	}
+
 /*
  * Setup the SysTick timer to generate the tick interrupts at the required
  * frequency.
  */
-#if( configOVERRIDE_DEFAULT_TICK_CONFIGURATION == 0 )
+#elif( configOVERRIDE_DEFAULT_TICK_CONFIGURATION == 0 )
 
 	__weak void vPortSetupTimerInterrupt( void )
 	{
@@ -116,6 +116,19 @@ extern void vPortExitCritical( void );
 	extern void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime );
 	#define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime ) vPortSuppressTicksAndSleep( xExpectedIdleTime )
 #endif
+
+/* When configUSE_TICKLESS_TIMER is 1 the tick is generated from a free running
+16-bit timer instead of the SysTick.  The application provides the timer: the
+first function starts it counting up at configTICKLESS_TIMER_HZ with its
+compare interrupt enabled at the kernel interrupt priority, and the timer's
+interrupt handler clears the interrupt then calls xPortTicklessTimerHandler(). */
+#if( configUSE_TICKLESS_TIMER == 1 )
+	extern void vApplicationTicklessTimerSetup( void );
+	extern uint32_t ulApplicationTicklessTimerCount( void );
+	extern void vApplicationTicklessTimerSetCompare( uint32_t ulCompare );
+	extern void xPortTicklessTimerHandler( void );
+	extern uint32_t ulPortTicklessTimerCountsSinceTick( void );
+#endif
 /*-----------------------------------------------------------*/
 
 /* Port specific optimisations. */
@@ -220,6 +233,26 @@ uint32_t ulReturn, ulNewBASEPRI = configMAX_SYSCALL_INTERRUPT_PRIORITY;
 }
 /*-----------------------------------------------------------*/
 
+/* Compare and swap used by the mutex fast path.  Any exception taken between
+the LDREX and the STREX clears the exclusive monitor, so the STREX fails and the
+word is read again. */
+static portFORCE_INLINE BaseType_t xPortCompareAndSwap( volatile uint32_t *pulDestination, uint32_t ulExpected, uint32_t ulNew )
+{
+	do
+	{
+		if( __ldrex( pulDestination ) != ulExpected )
+		{
+			__clrex();
+			return pdFALSE;
+		}
+	} while( __strex( ulNew, pulDestination ) != 0UL );
+
+	return pdTRUE;
+}
+
+#define portCOMPARE_AND_SWAP_POINTER( pxDestination, xExpected, xNew )	xPortCompareAndSwap( ( pxDestination ), ( xExpected ), ( xNew ) )
+/*-----------------------------------------------------------*/
+
 static portFORCE_INLINE BaseType_t xPortIsInsideInterrupt( void )
 {
 uint32_t ulCurrentInterrupt;
@@ -0,0 +1,66 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Arithmetic used by the configUSE_TICKLESS_TIMER tick, see port.c.  The tick
+ * comes from a compare match on a free running 16-bit counter, so every count
+ * is held modulo portTICKLESS_TIMER_MASK + 1 and every distance between two
+ * counts is taken modulo the same.  The macros only use their arguments, so
+ * the host tickless simulation includes this file and runs the same
+ * calculations as the port.  Arguments may be evaluated more than once.
+ */
+
+#ifndef PORTTICKLESS_H
+#define PORTTICKLESS_H
+
+/* The timer used in place of the SysTick when configUSE_TICKLESS_TIMER is 1 is
+a 16-bit counter. */
+#define portTICKLESS_TIMER_MASK				( 0xffffUL )
+
+/* The number of counts from ulLastTick to ulCount, across a counter wrap. */
+#define portTICKLESS_COUNTS_SINCE( ulCount, ulLastTick )	( ( ( ulCount ) - ( ulLastTick ) ) & portTICKLESS_TIMER_MASK )
+
+/* The count at which the ulTicks'th tick period after the one that ended at
+ulLastTick ends.  Used both to move ulLastTick on over ticks that have been
+accounted for and to set the compare match for a tick still to come. */
+#define portTICKLESS_COUNT_AFTER( ulLastTick, ulTicks, ulCountsForOneTick )	( ( ( ulLastTick ) + ( ( ulCountsForOneTick ) * ( ulTicks ) ) ) & portTICKLESS_TIMER_MASK )
+
+/* The most tick periods that can be suppressed.  One period of the counter's
+range is kept spare, so the time spent asleep can still be measured if waking
+is delayed a little. */
+#define portTICKLESS_MAX_SUPPRESSED_TICKS( ulCountsForOneTick )	( ( portTICKLESS_TIMER_MASK / ( ulCountsForOneTick ) ) - 1UL )
+
+/* The number of tick periods to step the tick count by after sleeping for
+xExpectedIdleTime ticks, given the counts that have passed since the last tick.
+The last expected period is always left to be processed as a normal tick, so
+the task waiting for it is unblocked; if another interrupt ended the sleep
+early only the periods that have completed are stepped over. */
+#define portTICKLESS_STEP_TICKS( ulCountsSinceTick, ulCountsForOneTick, xExpectedIdleTime )	\
+	( ( ( ( ulCountsSinceTick ) / ( ulCountsForOneTick ) ) < ( xExpectedIdleTime ) ) ?		\
+		( ( ulCountsSinceTick ) / ( ulCountsForOneTick ) ) : ( ( xExpectedIdleTime ) - 1UL ) )
+
+#endif /* PORTTICKLESS_H */
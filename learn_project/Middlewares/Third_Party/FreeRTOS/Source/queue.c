@@ -51,6 +51,7 @@ correct privileged Vs unprivileged linkage and placement. */
 /* Constants used with the cRxLock and cTxLock structure members. */
 #define queueUNLOCKED					( ( int8_t ) -1 )
 #define queueLOCKED_UNMODIFIED			( ( int8_t ) 0 )
+#define queueLOCK_COUNT_MAX				( ( int8_t ) 127 )
 
 /* When the Queue_t structure is used to represent a base queue its pcHead and
 pcTail members are used as pointers into the queue storage area.  When the
@@ -89,6 +90,19 @@ zero. */
 	#define queueYIELD_IF_USING_PREEMPTION() portYIELD_WITHIN_API()
 #endif
 
+#if ( configUSE_QUEUE_PRIORITY == 1 )
+	/* Entry of the binary heap that orders the items of a priority queue.  The
+	first uxMessagesWaiting entries are the heap, highest priority first and,
+	within a priority, in the order sent.  The remaining entries hold the
+	indexes of the free storage slots. */
+	typedef struct QueuePriorityItem
+	{
+		uint32_t ulSequence;		/*< Order in which the item was sent. */
+		uint16_t usSlot;			/*< Index of the storage slot holding the item. */
+		uint8_t ucPriority;			/*< Priority the item was sent with. */
+	} QueuePriorityItem_t;
+#endif
+
 /*
  * Definition of the queue used by the scheduler.
  * Items are queued by copy, not reference.  See the following link for the
@@ -128,6 +142,41 @@ typedef struct QueueDefinition 		/* The old naming convention is used to prevent
 		uint8_t ucQueueType;
 	#endif
 
+	#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+		int8_t *pcReservedSlot;		/*< The storage slot handed out by pvQueueReserve(), or NULL if no reservation is outstanding. */
+		int8_t *pcAcquiredSlot;		/*< The storage slot handed out by pvQueueAcquire(), or NULL if no item is held. */
+	#endif
+
+	#if ( configUSE_QUEUE_PRIORITY == 1 )
+		QueuePriorityItem_t *pxPriorityItems;	/*< Orders the items of a queue created by xQueueCreatePriority(), NULL for a FIFO queue. */
+		uint32_t ulNextSequence;				/*< Sequence number of the next item sent to a priority queue. */
+		uint8_t ucLastPriority;					/*< Priority of the item most recently received from a priority queue. */
+	#endif
+
+	#if ( configUSE_QUEUE_STATISTICS == 1 )
+		uint32_t ulSends;								/*< Items sent, or semaphores/mutexes given. */
+		uint32_t ulReceives;							/*< Items received, or semaphores/mutexes taken. */
+		uint32_t ulFullBlocks;							/*< Times a task blocked because the queue was full. */
+		uint32_t ulEmptyBlocks;							/*< Times a task blocked because the queue was empty. */
+		configRUN_TIME_COUNTER_TYPE ulBlockedTime;		/*< Total time tasks spent blocked on the queue. */
+		configRUN_TIME_COUNTER_TYPE ulMaxBlockedTime;	/*< Longest single time a task spent blocked on the queue. */
+		UBaseType_t uxPeakMessagesWaiting;				/*< Highest value uxMessagesWaiting has reached. */
+	#endif
+
+	#if ( configUSE_MUTEX_FAST_PATH == 1 )
+		volatile portPOINTER_SIZE_TYPE uxMutexOwner;	/*< Owner word of a mutex, see queueMUTEX_SLOW. */
+	#endif
+
+	#if ( configUSE_MUTEX_CEILING == 1 )
+		UBaseType_t uxCeilingPriority;		/*< Priority a holder of the mutex runs at, or 0 for priority inheritance. */
+		UBaseType_t uxPriorityOnTake;		/*< Priority the holder had before it was raised to the ceiling. */
+		UBaseType_t uxCeilingDepth;			/*< Number of ceiling mutexes the holder held once it had taken this one. */
+	#endif
+
+	#if ( configUSE_MUTEX_PROFILING == 1 )
+		struct MutexProfileSlot *pxProfile;	/*< The profile slot of a mutex, or NULL if all slots were in use when it was created. */
+	#endif
+
 } xQUEUE;
 
 /* The old xQUEUE name is maintained above then typedefed to the new Queue_t
@@ -163,6 +212,25 @@ typedef xQUEUE Queue_t;
 
 #endif /* configQUEUE_REGISTRY_SIZE */
 
+#if ( configUSE_MUTEX_PROFILING == 1 )
+
+	/* The profile of one mutex, and the state of the hold in progress.  Slots
+	are handed out to mutexes as they are created and returned when they are
+	deleted, so mutexes created once all the slots are in use are not
+	profiled. */
+	typedef struct MutexProfileSlot
+	{
+		Queue_t *pxMutex;								/*< The mutex the slot belongs to, or NULL if the slot is free. */
+		MutexProfile_t xProfile;						/*< The samples recorded so far. */
+		configRUN_TIME_COUNTER_TYPE ulTakeTime;			/*< When the holder got the mutex. */
+		configRUN_TIME_COUNTER_TYPE ulHolderWaitTime;	/*< How long the holder waited for it. */
+		BaseType_t xHolderBlocked;						/*< pdTRUE if the holder had to block to get it. */
+	} MutexProfileSlot_t;
+
+	PRIVILEGED_DATA static MutexProfileSlot_t xMutexProfiles[ configMUTEX_PROFILE_COUNT ];
+
+#endif /* configUSE_MUTEX_PROFILING */
+
 /*
  * Unlocks a queue locked by a call to prvLockQueue.  Locking a queue does not
  * prevent an ISR from adding or removing items to the queue, but does prevent
@@ -206,6 +274,188 @@ static void prvCopyDataFromQueue( Queue_t * const pxQueue, void * const pvBuffer
 	static BaseType_t prvNotifyQueueSetContainer( const Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
 #endif
 
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+	/*
+	 * Moves pcWriteTo past the reserved slot and counts the item in it.
+	 */
+	static void prvCommitReservedSlot( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Removes the item at the front of the queue without copying it, and
+	 * returns a pointer to its slot.
+	 */
+	static void *prvAcquireFrontSlot( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( ( configUSE_QUEUE_ZERO_COPY == 1 ) || ( configUSE_QUEUE_BATCH == 1 ) )
+	/*
+	 * Unblock the highest priority task waiting to receive from, or send to,
+	 * the queue.  Return pdTRUE if the unblocked task has a priority above the
+	 * calling task.
+	 */
+	static BaseType_t prvUnblockReader( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+	static BaseType_t prvUnblockWriter( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configUSE_QUEUE_PRIORITY == 1 )
+	/*
+	 * Copies an item into a free slot of a priority queue and adds it to the
+	 * heap.  Items sent to the back without a priority get priority 0.
+	 */
+	static void prvInsertByPriority( Queue_t * const pxQueue, const void *pvItemToQueue, const BaseType_t xPosition ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Removes the item prvCopyDataFromQueue() just read from the heap of a
+	 * priority queue.  Does nothing for a FIFO queue.  Must be called before
+	 * uxMessagesWaiting is decremented.
+	 */
+	static void prvRemovePriorityHead( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Returns the heap of a priority queue to its empty state.
+	 */
+	static void prvResetPriorityItems( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * pdTRUE if the item pxA must be received before the item pxB.
+	 */
+	static BaseType_t prvPriorityBefore( const QueuePriorityItem_t * const pxA, const QueuePriorityItem_t * const pxB ) PRIVILEGED_FUNCTION;
+#else
+	#define prvRemovePriorityHead( pxQueue )
+#endif
+
+#if ( configUSE_QUEUE_BATCH == 1 )
+	/*
+	 * Adds uxCount to the lock count of a locked queue, saturating rather than
+	 * overflowing the int8_t.
+	 */
+	static int8_t prvAddToLockCount( const int8_t cLock, const UBaseType_t uxCount ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( ( configUSE_QUEUE_STATISTICS == 1 ) || ( configUSE_MUTEX_PROFILING == 1 ) )
+	/*
+	 * The clock the blocked, wait and hold times are measured with: the run
+	 * time stats clock if there is one, otherwise the tick count.
+	 */
+	static configRUN_TIME_COUNTER_TYPE prvStatsNow( void ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configUSE_QUEUE_STATISTICS == 1 )
+	/*
+	 * Adds the time since ulBlockStart to the blocked time of the queue.
+	 * Called by a task that has just resumed after blocking on the queue.
+	 */
+	static void prvStatsBlockEnd( Queue_t * const pxQueue, const configRUN_TIME_COUNTER_TYPE ulBlockStart ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Copies the counters of a queue into pxStats.  Must be called from a
+	 * critical section.
+	 */
+	static void prvCopyStats( const Queue_t * const pxQueue, QueueStats_t * const pxStats ) PRIVILEGED_FUNCTION;
+
+	/* The send and receive counters are updated wherever uxMessagesWaiting
+	is, so from the same critical section or interrupt mask, or for a mutex
+	taken or given on the fast path by the task holding it.  The block
+	counters are only updated by tasks, with the scheduler suspended.
+	uxNewMessagesWaiting is the count the caller has just stored, passed in so
+	the peak is not updated from a second read of the volatile count.  Nothing
+	here reads the clock - only a task that blocks does that. */
+	#define queueSTATS_ITEM_ADDED( pxQueue, uxNewMessagesWaiting )							\
+	{																						\
+		( pxQueue )->ulSends++;																\
+		if( ( uxNewMessagesWaiting ) > ( pxQueue )->uxPeakMessagesWaiting )					\
+		{																					\
+			( pxQueue )->uxPeakMessagesWaiting = ( uxNewMessagesWaiting );					\
+		}																					\
+	}
+	#define queueSTATS_ITEM_REMOVED( pxQueue )		( ( pxQueue )->ulReceives++ )
+	#define queueSTATS_BLOCK_START( pxQueue, ulBlocks, ulBlockStart )							\
+	{																						\
+		( pxQueue )->ulBlocks++;															\
+		( ulBlockStart ) = prvStatsNow();													\
+	}
+	#define queueSTATS_BLOCK_END( pxQueue, ulBlockStart )	prvStatsBlockEnd( ( pxQueue ), ( ulBlockStart ) )
+#else
+	#define queueSTATS_ITEM_ADDED( pxQueue, uxNewMessagesWaiting )
+	#define queueSTATS_ITEM_REMOVED( pxQueue )
+	#define queueSTATS_BLOCK_START( pxQueue, ulBlocks, ulBlockStart )
+	#define queueSTATS_BLOCK_END( pxQueue, ulBlockStart )
+#endif
+
+#if ( configUSE_MUTEX_PROFILING == 1 )
+	/*
+	 * Give a profile slot to a newly created mutex, if one is free.
+	 */
+	static void prvProfileClaim( Queue_t * const pxMutex ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Called by the task that has just taken the mutex, having asked for it at
+	 * ulWaitStart.  Only records when the hold started - the sample is added
+	 * when the mutex is given back.
+	 */
+	static void prvProfileTaken( MutexProfileSlot_t * const pxSlot, const configRUN_TIME_COUNTER_TYPE ulWaitStart, const BaseType_t xBlocked ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Called by a task about to give the mutex.  If it is the holder, adds the
+	 * wait and hold times of the hold that is ending to the profile.
+	 */
+	static void prvProfileGive( Queue_t * const pxMutex ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Counts a take that returned without the mutex.
+	 */
+	static void prvProfileFailed( MutexProfileSlot_t * const pxSlot ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * The entry of the profile that samples from xTask are added to, claiming
+	 * a free one if xTask has none.  Must be called from a critical section.
+	 */
+	static MutexProfileTask_t *prvProfileTaskEntry( MutexProfileSlot_t * const pxSlot, const TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * The histogram bucket a wait or hold time is counted in.
+	 */
+	static UBaseType_t prvProfileBucket( configRUN_TIME_COUNTER_TYPE ulTime ) PRIVILEGED_FUNCTION;
+
+	/* pxProfile is only ever set for a mutex, so queues and semaphores pay
+	for one test of it. */
+	#define queuePROFILE_TAKE_START( pxQueue, ulWaitStart )									\
+	{																						\
+		if( ( pxQueue )->pxProfile != NULL )												\
+		{																					\
+			( ulWaitStart ) = prvStatsNow();												\
+		}																					\
+	}
+	#define queuePROFILE_TAKEN( pxQueue, ulWaitStart, xBlocked )								\
+	{																						\
+		if( ( pxQueue )->pxProfile != NULL )												\
+		{																					\
+			prvProfileTaken( ( pxQueue )->pxProfile, ( ulWaitStart ), ( xBlocked ) );		\
+		}																					\
+	}
+	#define queuePROFILE_BLOCKED( xBlocked )		( ( xBlocked ) = pdTRUE )
+	#define queuePROFILE_FAILED( pxQueue )													\
+	{																						\
+		if( ( pxQueue )->pxProfile != NULL )												\
+		{																					\
+			prvProfileFailed( ( pxQueue )->pxProfile );										\
+		}																					\
+	}
+	#define queuePROFILE_GIVE( pxQueue )														\
+	{																						\
+		if( ( pxQueue )->pxProfile != NULL )												\
+		{																					\
+			prvProfileGive( ( pxQueue ) );													\
+		}																					\
+	}
+#else
+	#define queuePROFILE_TAKE_START( pxQueue, ulWaitStart )
+	#define queuePROFILE_TAKEN( pxQueue, ulWaitStart, xBlocked )
+	#define queuePROFILE_BLOCKED( xBlocked )
+	#define queuePROFILE_FAILED( pxQueue )
+	#define queuePROFILE_GIVE( pxQueue )
+#endif
+
 /*
  * Called after a Queue_t structure has been allocated either statically or
  * dynamically to fill in the structure's members.
@@ -221,6 +471,55 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 	static void prvInitialiseMutex( Queue_t *pxNewQueue ) PRIVILEGED_FUNCTION;
 #endif
 
+#if ( configUSE_MUTEX_FAST_PATH == 1 )
+
+	#ifndef portCOMPARE_AND_SWAP_POINTER
+		#error configUSE_MUTEX_FAST_PATH requires the port to define portCOMPARE_AND_SWAP_POINTER().
+	#endif
+
+	/* uxMutexOwner is the word the fast path takes and gives a mutex with.  It
+	holds one of:
+
+	0 - the mutex is free and nobody is waiting for it.  uxMessagesWaiting is 1
+	and xMutexHolder is NULL.
+
+	A task handle - the mutex was taken by that task on the fast path.
+	uxMessagesWaiting and xMutexHolder still say the mutex is free; they are
+	left alone so the fast path never writes more than the one word.
+
+	queueMUTEX_SLOW - uxMessagesWaiting and xMutexHolder describe the mutex and
+	the normal queue code manages it, with priority inheritance.
+
+	The fast take swaps 0 for the task's handle and the fast give swaps it back.
+	Anything else goes through xQueueSemaphoreTake() or xQueueGenericSend(),
+	which first call prvMutexEnterSlowPath() so that a task about to block can
+	see, and inherit the priority of, a holder that took the mutex on the fast
+	path.  The give that leaves the mutex free with no task waiting for it
+	returns the word to 0. */
+	#define queueMUTEX_SLOW		( ( portPOINTER_SIZE_TYPE ) 1 )
+
+	/*
+	 * Attempt to take or give a mutex with a single compare and swap on
+	 * uxMutexOwner.  Return pdFALSE if the normal queue code must be used.
+	 */
+	static BaseType_t prvMutexTakeFast( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+	static BaseType_t prvMutexGiveFast( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Make uxMessagesWaiting and xMutexHolder describe the mutex, then mark it
+	 * queueMUTEX_SLOW.  Must be called from a critical section.
+	 */
+	static void prvMutexEnterSlowPath( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+
+	/* The task holding a mutex, wherever it is currently recorded. */
+	#define prvGetMutexHolder( pxQueue )	( ( ( pxQueue )->uxMutexOwner == queueMUTEX_SLOW ) ? ( pxQueue )->u.xSemaphore.xMutexHolder : ( TaskHandle_t ) ( pxQueue )->uxMutexOwner ) /*lint !e923 !e9078 The owner word holds a task handle. */
+
+#elif ( configUSE_MUTEXES == 1 )
+
+	#define prvGetMutexHolder( pxQueue )	( ( pxQueue )->u.xSemaphore.xMutexHolder )
+
+#endif /* configUSE_MUTEX_FAST_PATH */
+
 #if( configUSE_MUTEXES == 1 )
 	/*
 	 * If a task waiting for a mutex causes the mutex holder to inherit a
@@ -252,6 +551,39 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 	taskEXIT_CRITICAL()
 /*-----------------------------------------------------------*/
 
+/* While a slot is reserved by pvQueueReserve() the queue is full as far as
+other writers are concerned, as the reserved item has to be the next one in the
+queue.  An item held by pvQueueAcquire() is instead accounted for by reducing
+uxLength by one, so the writers cannot wrap around onto it while the readers
+carry on as normal. */
+#if( configUSE_QUEUE_ZERO_COPY == 1 )
+	#define prvQueueHasSpace( pxQueue ) ( ( ( pxQueue )->uxMessagesWaiting < ( pxQueue )->uxLength ) && ( ( pxQueue )->pcReservedSlot == NULL ) )
+#else
+	#define prvQueueHasSpace( pxQueue ) ( ( pxQueue )->uxMessagesWaiting < ( pxQueue )->uxLength )
+#endif
+
+/*
+ * A FIFO queue ignores the priority of an item sent with queueSEND_BY_PRIORITY
+ * and adds it to the back.
+ */
+#if ( configUSE_QUEUE_PRIORITY == 1 )
+	#define prvIsSendToBack( xPosition ) ( ( ( xPosition ) == queueSEND_TO_BACK ) || ( ( ( xPosition ) & queueSEND_BY_PRIORITY ) != 0 ) )
+#else
+	#define prvIsSendToBack( xPosition ) ( ( xPosition ) == queueSEND_TO_BACK )
+#endif
+
+/*
+ * An item sent to the front of a queue goes in the slot the last item was
+ * read from.  While that item is held by pvQueueAcquire() the slot is in use,
+ * so nothing can be sent to the front until it is released.
+ */
+#if( configUSE_QUEUE_ZERO_COPY == 1 )
+	#define prvIsFrontSlotHeld( pxQueue, xPosition ) ( ( ( xPosition ) == queueSEND_TO_FRONT ) && ( ( pxQueue )->pcAcquiredSlot != NULL ) )
+#else
+	#define prvIsFrontSlotHeld( pxQueue, xPosition ) ( pdFALSE )
+#endif
+/*-----------------------------------------------------------*/
+
 BaseType_t xQueueGenericReset( QueueHandle_t xQueue, BaseType_t xNewQueue )
 {
 Queue_t * const pxQueue = xQueue;
@@ -260,6 +592,39 @@ Queue_t * const pxQueue = xQueue;
 
 	taskENTER_CRITICAL();
 	{
+		#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+		{
+			/* Any reservation or held item is dropped.  uxLength was reduced
+			by one while an item was held, restore it before it is used below.
+			The members are not yet initialised if this is a new queue. */
+			if( ( xNewQueue == pdFALSE ) && ( pxQueue->pcAcquiredSlot != NULL ) )
+			{
+				( pxQueue->uxLength )++;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			pxQueue->pcReservedSlot = NULL;
+			pxQueue->pcAcquiredSlot = NULL;
+		}
+		#endif /* configUSE_QUEUE_ZERO_COPY */
+
+		#if ( configUSE_QUEUE_PRIORITY == 1 )
+		{
+			/* The heap is not yet allocated if this is a new queue. */
+			if( ( xNewQueue == pdFALSE ) && ( pxQueue->pxPriorityItems != NULL ) )
+			{
+				prvResetPriorityItems( pxQueue );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_QUEUE_PRIORITY */
+
 		pxQueue->u.xQueue.pcTail = pxQueue->pcHead + ( pxQueue->uxLength * pxQueue->uxItemSize ); /*lint !e9016 Pointer arithmetic allowed on char types, especially when it assists conveying intent. */
 		pxQueue->uxMessagesWaiting = ( UBaseType_t ) 0U;
 		pxQueue->pcWriteTo = pxQueue->pcHead;
@@ -419,6 +784,54 @@ Queue_t * const pxQueue = xQueue;
 #endif /* configSUPPORT_STATIC_ALLOCATION */
 /*-----------------------------------------------------------*/
 
+#if( ( configUSE_QUEUE_PRIORITY == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+	QueueHandle_t xQueueCreatePriority( const UBaseType_t uxQueueLength, const UBaseType_t uxItemSize )
+	{
+	Queue_t *pxNewQueue;
+	size_t xItemsSizeInBytes, xQueueSizeInBytes;
+	uint8_t *pucItems;
+
+		/* Slot indexes are stored in 16 bits. */
+		configASSERT( uxQueueLength > ( UBaseType_t ) 0 );
+		configASSERT( uxQueueLength <= ( UBaseType_t ) 0xFFFFU );
+
+		/* A priority queue orders items, so cannot be used as a semaphore. */
+		configASSERT( uxItemSize > ( UBaseType_t ) 0 );
+
+		/* The heap and the storage area are allocated with the queue, the heap
+		first as its entries need more alignment than the items. */
+		xItemsSizeInBytes = ( size_t ) uxQueueLength * sizeof( QueuePriorityItem_t );
+		xQueueSizeInBytes = ( size_t ) ( uxQueueLength * uxItemSize ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+		pxNewQueue = ( Queue_t * ) pvPortMalloc( sizeof( Queue_t ) + xItemsSizeInBytes + xQueueSizeInBytes ); /*lint !e9087 !e9079 see comment in xQueueGenericCreate(). */
+
+		if( pxNewQueue != NULL )
+		{
+			pucItems = ( uint8_t * ) pxNewQueue;
+			pucItems += sizeof( Queue_t ); /*lint !e9016 Pointer arithmetic allowed on char types, especially when it assists conveying intent. */
+
+			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+			{
+				pxNewQueue->ucStaticallyAllocated = pdFALSE;
+			}
+			#endif /* configSUPPORT_STATIC_ALLOCATION */
+
+			prvInitialiseNewQueue( uxQueueLength, uxItemSize, pucItems + xItemsSizeInBytes, queueQUEUE_TYPE_BASE, pxNewQueue );
+			pxNewQueue->pxPriorityItems = ( QueuePriorityItem_t * ) pucItems; /*lint !e9087 !e826 Alignment is ensured by the layout of the allocation. */
+			prvResetPriorityItems( pxNewQueue );
+		}
+		else
+		{
+			traceQUEUE_CREATE_FAILED( queueQUEUE_TYPE_BASE );
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pxNewQueue;
+	}
+
+#endif /* ( configUSE_QUEUE_PRIORITY == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) */
+/*-----------------------------------------------------------*/
+
 static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseType_t uxItemSize, uint8_t *pucQueueStorage, const uint8_t ucQueueType, Queue_t *pxNewQueue )
 {
 	/* Remove compiler warnings about unused parameters should
@@ -457,6 +870,36 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 	}
 	#endif /* configUSE_QUEUE_SETS */
 
+	#if( configUSE_QUEUE_PRIORITY == 1 )
+	{
+		/* xQueueCreatePriority() sets the heap after the queue is
+		initialised. */
+		pxNewQueue->pxPriorityItems = NULL;
+		pxNewQueue->ucLastPriority = 0;
+	}
+	#endif /* configUSE_QUEUE_PRIORITY */
+
+	#if( configUSE_QUEUE_STATISTICS == 1 )
+	{
+		/* Not cleared by xQueueGenericReset(), so the counters cover the
+		whole life of the queue. */
+		pxNewQueue->ulSends = 0U;
+		pxNewQueue->ulReceives = 0U;
+		pxNewQueue->ulFullBlocks = 0U;
+		pxNewQueue->ulEmptyBlocks = 0U;
+		pxNewQueue->ulBlockedTime = 0U;
+		pxNewQueue->ulMaxBlockedTime = 0U;
+		pxNewQueue->uxPeakMessagesWaiting = pxNewQueue->uxMessagesWaiting;
+	}
+	#endif /* configUSE_QUEUE_STATISTICS */
+
+	#if( configUSE_MUTEX_PROFILING == 1 )
+	{
+		/* Set by prvInitialiseMutex() if this is a mutex. */
+		pxNewQueue->pxProfile = NULL;
+	}
+	#endif
+
 	traceQUEUE_CREATE( pxNewQueue );
 }
 /*-----------------------------------------------------------*/
@@ -477,10 +920,36 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 			/* In case this is a recursive mutex. */
 			pxNewQueue->u.xSemaphore.uxRecursiveCallCount = 0;
 
+			#if ( configUSE_MUTEX_CEILING == 1 )
+			{
+				/* Priority inheritance unless vQueueSetMutexCeiling() is
+				called. */
+				pxNewQueue->uxCeilingPriority = ( UBaseType_t ) 0;
+				pxNewQueue->uxPriorityOnTake = ( UBaseType_t ) 0;
+				pxNewQueue->uxCeilingDepth = ( UBaseType_t ) 0;
+			}
+			#endif
+
+			#if ( configUSE_MUTEX_FAST_PATH == 1 )
+			{
+				/* The mutex starts out taken, so the give below must go
+				through the normal queue code.  That returns the owner word to
+				0. */
+				pxNewQueue->uxMutexOwner = queueMUTEX_SLOW;
+			}
+			#endif
+
 			traceCREATE_MUTEX( pxNewQueue );
 
 			/* Start with the semaphore in the expected state. */
 			( void ) xQueueGenericSend( pxNewQueue, NULL, ( TickType_t ) 0U, queueSEND_TO_BACK );
+
+			#if ( configUSE_MUTEX_PROFILING == 1 )
+			{
+				/* After the give above, which is not a hold ending. */
+				prvProfileClaim( pxNewQueue );
+			}
+			#endif
 		}
 		else
 		{
@@ -491,87 +960,220 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
-#if( ( configUSE_MUTEXES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
-
-	QueueHandle_t xQueueCreateMutex( const uint8_t ucQueueType )
-	{
-	QueueHandle_t xNewQueue;
-	const UBaseType_t uxMutexLength = ( UBaseType_t ) 1, uxMutexSize = ( UBaseType_t ) 0;
-
-		xNewQueue = xQueueGenericCreate( uxMutexLength, uxMutexSize, ucQueueType );
-		prvInitialiseMutex( ( Queue_t * ) xNewQueue );
-
-		return xNewQueue;
-	}
-
-#endif /* configUSE_MUTEXES */
-/*-----------------------------------------------------------*/
-
-#if( ( configUSE_MUTEXES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
-
-	QueueHandle_t xQueueCreateMutexStatic( const uint8_t ucQueueType, StaticQueue_t *pxStaticQueue )
-	{
-	QueueHandle_t xNewQueue;
-	const UBaseType_t uxMutexLength = ( UBaseType_t ) 1, uxMutexSize = ( UBaseType_t ) 0;
-
-		/* Prevent compiler warnings about unused parameters if
-		configUSE_TRACE_FACILITY does not equal 1. */
-		( void ) ucQueueType;
-
-		xNewQueue = xQueueGenericCreateStatic( uxMutexLength, uxMutexSize, NULL, pxStaticQueue, ucQueueType );
-		prvInitialiseMutex( ( Queue_t * ) xNewQueue );
-
-		return xNewQueue;
-	}
-
-#endif /* configUSE_MUTEXES */
-/*-----------------------------------------------------------*/
-
-#if ( ( configUSE_MUTEXES == 1 ) && ( INCLUDE_xSemaphoreGetMutexHolder == 1 ) )
+#if ( configUSE_MUTEX_FAST_PATH == 1 )
 
-	TaskHandle_t xQueueGetMutexHolder( QueueHandle_t xSemaphore )
+	static BaseType_t prvMutexTakeFast( Queue_t * const pxQueue )
 	{
-	TaskHandle_t pxReturn;
-	Queue_t * const pxSemaphore = ( Queue_t * ) xSemaphore;
+	const TaskHandle_t xCurrentTask = xTaskGetCurrentTaskHandle();
+	BaseType_t xReturn = pdFALSE;
 
-		/* This function is called by xSemaphoreGetMutexHolder(), and should not
-		be called directly.  Note:  This is a good way of determining if the
-		calling task is the mutex holder, but not a good way of determining the
-		identity of the mutex holder, as the holder may change between the
-		following critical section exiting and the function returning. */
-		taskENTER_CRITICAL();
+		/* There is no current task if the mutex is used before any task has
+		been created. */
+		if( xCurrentTask != NULL )
 		{
-			if( pxSemaphore->uxQueueType == queueQUEUE_IS_MUTEX )
+			/* Counted before the swap.  Once the swap succeeds a waiter can
+			enter the slow path, inherit through this mutex and time out, all
+			before this task runs again, and the timeout expects the holder to
+			have counted the mutex.  Only the task itself writes its held
+			count, so no critical section is needed around the increment. */
+			( void ) pvTaskIncrementMutexHeldCount();
+
+			if( portCOMPARE_AND_SWAP_POINTER( &( pxQueue->uxMutexOwner ), ( portPOINTER_SIZE_TYPE ) 0, ( portPOINTER_SIZE_TYPE ) xCurrentTask ) != pdFALSE ) /*lint !e923 The owner word holds a task handle. */
 			{
-				pxReturn = pxSemaphore->u.xSemaphore.xMutexHolder;
+				traceQUEUE_RECEIVE( pxQueue );
+				queueSTATS_ITEM_REMOVED( pxQueue );
+				xReturn = pdTRUE;
 			}
 			else
 			{
-				pxReturn = NULL;
+				/* Not taken, so nobody can have inherited a priority through
+				this mutex, and the count always comes straight back down. */
+				( void ) xTaskDecrementMutexHeldCount();
 			}
 		}
-		taskEXIT_CRITICAL();
-
-		return pxReturn;
-	} /*lint !e818 xSemaphore cannot be a pointer to const because it is a typedef. */
-
-#endif
-/*-----------------------------------------------------------*/
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
 
-#if ( ( configUSE_MUTEXES == 1 ) && ( INCLUDE_xSemaphoreGetMutexHolder == 1 ) )
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
 
-	TaskHandle_t xQueueGetMutexHolderFromISR( QueueHandle_t xSemaphore )
+	static BaseType_t prvMutexGiveFast( Queue_t * const pxQueue )
 	{
-	TaskHandle_t pxReturn;
+	const portPOINTER_SIZE_TYPE uxCurrentTask = ( portPOINTER_SIZE_TYPE ) xTaskGetCurrentTaskHandle(); /*lint !e923 The owner word holds a task handle. */
+	BaseType_t xReturn = pdFALSE;
 
-		configASSERT( xSemaphore );
+		/* Only the task that took the mutex on the fast path can give it on
+		the fast path, and only while no other task has started to wait for
+		it - that would have changed the word to queueMUTEX_SLOW. */
+		if( ( uxCurrentTask != ( portPOINTER_SIZE_TYPE ) 0 ) && ( pxQueue->uxMutexOwner == uxCurrentTask ) )
+		{
+			/* Counted while this task still holds the mutex, and uncounted if
+			the slow path is going to count it instead. */
+			queueSTATS_ITEM_ADDED( pxQueue, pxQueue->uxMessagesWaiting );
 
-		/* Mutexes cannot be used in interrupt service routines, so the mutex
+			if( portCOMPARE_AND_SWAP_POINTER( &( pxQueue->uxMutexOwner ), uxCurrentTask, ( portPOINTER_SIZE_TYPE ) 0 ) != pdFALSE )
+			{
+				traceQUEUE_SEND( pxQueue );
+
+				/* Nobody can have inherited through this mutex as nobody waited
+				for it, but the task may still hold a priority inherited
+				through another mutex it has since given. */
+				if( xTaskDecrementMutexHeldCount() == pdFALSE )
+				{
+					taskENTER_CRITICAL();
+					{
+						if( xTaskPriorityDisinherit( ( TaskHandle_t ) uxCurrentTask ) != pdFALSE ) /*lint !e923 The owner word holds a task handle. */
+						{
+							queueYIELD_IF_USING_PREEMPTION();
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					taskEXIT_CRITICAL();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				xReturn = pdTRUE;
+			}
+			else
+			{
+				#if ( configUSE_QUEUE_STATISTICS == 1 )
+				{
+					pxQueue->ulSends--;
+				}
+				#endif
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvMutexEnterSlowPath( Queue_t * const pxQueue )
+	{
+	const portPOINTER_SIZE_TYPE uxOwner = pxQueue->uxMutexOwner;
+
+		/* Called from a critical section, so the owner word cannot change
+		here: a task part way through a compare and swap has been switched out
+		and its swap will fail. */
+		if( uxOwner != queueMUTEX_SLOW )
+		{
+			if( uxOwner != ( portPOINTER_SIZE_TYPE ) 0 )
+			{
+				/* Taken on the fast path.  The holder counted the take in
+				its held count before the swap. */
+				pxQueue->uxMessagesWaiting = ( UBaseType_t ) 0;
+				pxQueue->u.xSemaphore.xMutexHolder = ( TaskHandle_t ) uxOwner; /*lint !e923 The owner word holds a task handle. */
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			pxQueue->uxMutexOwner = queueMUTEX_SLOW;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configUSE_MUTEX_FAST_PATH */
+/*-----------------------------------------------------------*/
+
+#if( ( configUSE_MUTEXES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+	QueueHandle_t xQueueCreateMutex( const uint8_t ucQueueType )
+	{
+	QueueHandle_t xNewQueue;
+	const UBaseType_t uxMutexLength = ( UBaseType_t ) 1, uxMutexSize = ( UBaseType_t ) 0;
+
+		xNewQueue = xQueueGenericCreate( uxMutexLength, uxMutexSize, ucQueueType );
+		prvInitialiseMutex( ( Queue_t * ) xNewQueue );
+
+		return xNewQueue;
+	}
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if( ( configUSE_MUTEXES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+
+	QueueHandle_t xQueueCreateMutexStatic( const uint8_t ucQueueType, StaticQueue_t *pxStaticQueue )
+	{
+	QueueHandle_t xNewQueue;
+	const UBaseType_t uxMutexLength = ( UBaseType_t ) 1, uxMutexSize = ( UBaseType_t ) 0;
+
+		/* Prevent compiler warnings about unused parameters if
+		configUSE_TRACE_FACILITY does not equal 1. */
+		( void ) ucQueueType;
+
+		xNewQueue = xQueueGenericCreateStatic( uxMutexLength, uxMutexSize, NULL, pxStaticQueue, ucQueueType );
+		prvInitialiseMutex( ( Queue_t * ) xNewQueue );
+
+		return xNewQueue;
+	}
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_MUTEXES == 1 ) && ( INCLUDE_xSemaphoreGetMutexHolder == 1 ) )
+
+	TaskHandle_t xQueueGetMutexHolder( QueueHandle_t xSemaphore )
+	{
+	TaskHandle_t pxReturn;
+	Queue_t * const pxSemaphore = ( Queue_t * ) xSemaphore;
+
+		/* This function is called by xSemaphoreGetMutexHolder(), and should not
+		be called directly.  Note:  This is a good way of determining if the
+		calling task is the mutex holder, but not a good way of determining the
+		identity of the mutex holder, as the holder may change between the
+		following critical section exiting and the function returning. */
+		taskENTER_CRITICAL();
+		{
+			if( pxSemaphore->uxQueueType == queueQUEUE_IS_MUTEX )
+			{
+				pxReturn = prvGetMutexHolder( pxSemaphore );
+			}
+			else
+			{
+				pxReturn = NULL;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return pxReturn;
+	} /*lint !e818 xSemaphore cannot be a pointer to const because it is a typedef. */
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_MUTEXES == 1 ) && ( INCLUDE_xSemaphoreGetMutexHolder == 1 ) )
+
+	TaskHandle_t xQueueGetMutexHolderFromISR( QueueHandle_t xSemaphore )
+	{
+	TaskHandle_t pxReturn;
+
+		configASSERT( xSemaphore );
+
+		/* Mutexes cannot be used in interrupt service routines, so the mutex
 		holder should not change in an ISR, and therefore a critical section is
 		not required here. */
 		if( ( ( Queue_t * ) xSemaphore )->uxQueueType == queueQUEUE_IS_MUTEX )
 		{
-			pxReturn = ( ( Queue_t * ) xSemaphore )->u.xSemaphore.xMutexHolder;
+			pxReturn = prvGetMutexHolder( ( Queue_t * ) xSemaphore );
 		}
 		else
 		{
@@ -599,7 +1201,7 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 		this is the only condition we are interested in it does not matter if
 		pxMutexHolder is accessed simultaneously by another task.  Therefore no
 		mutual exclusion is required to test the pxMutexHolder variable. */
-		if( pxMutex->u.xSemaphore.xMutexHolder == xTaskGetCurrentTaskHandle() )
+		if( prvGetMutexHolder( pxMutex ) == xTaskGetCurrentTaskHandle() )
 		{
 			traceGIVE_MUTEX_RECURSIVE( pxMutex );
 
@@ -653,7 +1255,7 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 
 		traceTAKE_MUTEX_RECURSIVE( pxMutex );
 
-		if( pxMutex->u.xSemaphore.xMutexHolder == xTaskGetCurrentTaskHandle() )
+		if( prvGetMutexHolder( pxMutex ) == xTaskGetCurrentTaskHandle() )
 		{
 			( pxMutex->u.xSemaphore.uxRecursiveCallCount )++;
 			xReturn = pdPASS;
@@ -681,6 +1283,37 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 #endif /* configUSE_RECURSIVE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_MUTEX_CEILING == 1 )
+
+	void vQueueSetMutexCeiling( QueueHandle_t xMutex, UBaseType_t uxCeilingPriority )
+	{
+	Queue_t * const pxMutex = ( Queue_t * ) xMutex;
+
+		configASSERT( pxMutex );
+		configASSERT( pxMutex->uxQueueType == queueQUEUE_IS_MUTEX );
+		configASSERT( ( uxCeilingPriority > tskIDLE_PRIORITY ) && ( uxCeilingPriority < ( UBaseType_t ) configMAX_PRIORITIES ) );
+
+		taskENTER_CRITICAL();
+		{
+			/* Changing the ceiling of a held mutex would leave its holder at
+			the wrong priority. */
+			configASSERT( prvGetMutexHolder( pxMutex ) == NULL );
+			pxMutex->uxCeilingPriority = uxCeilingPriority;
+
+			#if ( configUSE_MUTEX_FAST_PATH == 1 )
+			{
+				/* Every take must go through xQueueSemaphoreTake() to raise
+				the taking task to the ceiling. */
+				pxMutex->uxMutexOwner = queueMUTEX_SLOW;
+			}
+			#endif
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_MUTEX_CEILING */
+/*-----------------------------------------------------------*/
+
 #if( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
 
 	QueueHandle_t xQueueCreateCountingSemaphoreStatic( const UBaseType_t uxMaxCount, const UBaseType_t uxInitialCount, StaticQueue_t *pxStaticQueue )
@@ -743,6 +1376,10 @@ BaseType_t xEntryTimeSet = pdFALSE, xYieldRequired;
 TimeOut_t xTimeOut;
 Queue_t * const pxQueue = xQueue;
 
+#if( configUSE_QUEUE_STATISTICS == 1 )
+	configRUN_TIME_COUNTER_TYPE ulBlockStart;
+#endif
+
 	configASSERT( pxQueue );
 	configASSERT( !( ( pvItemToQueue == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
 	configASSERT( !( ( xCopyPosition == queueOVERWRITE ) && ( pxQueue->uxLength != 1 ) ) );
@@ -752,6 +1389,22 @@ Queue_t * const pxQueue = xQueue;
 	}
 	#endif
 
+	/* Before the give, as once the mutex is free another task can take it
+	and start a hold of its own. */
+	queuePROFILE_GIVE( pxQueue );
+
+	#if ( configUSE_MUTEX_FAST_PATH == 1 )
+	{
+		if( ( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX ) && ( prvMutexGiveFast( pxQueue ) != pdFALSE ) )
+		{
+			return pdPASS;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif
 
 	/*lint -save -e904 This function relaxes the coding standard somewhat to
 	allow return statements within the function itself.  This is done in the
@@ -760,11 +1413,42 @@ Queue_t * const pxQueue = xQueue;
 	{
 		taskENTER_CRITICAL();
 		{
+			#if ( configUSE_MUTEX_FAST_PATH == 1 )
+			{
+				if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+				{
+					prvMutexEnterSlowPath( pxQueue );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif
+
+			#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+			{
+				/* Writers waiting for space are woken without regard to where
+				they send, so a task cannot block until the front slot is
+				released.  Fail now instead. */
+				if( prvIsFrontSlotHeld( pxQueue, xCopyPosition ) )
+				{
+					taskEXIT_CRITICAL();
+					traceQUEUE_SEND_FAILED( pxQueue );
+					return errQUEUE_FULL;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif
+
 			/* Is there room on the queue now?  The running task must be the
 			highest priority task wanting to access the queue.  If the head item
 			in the queue is to be overwritten then it does not matter if the
 			queue is full. */
-			if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
+			if( prvQueueHasSpace( pxQueue ) || ( xCopyPosition == queueOVERWRITE ) )
 			{
 				traceQUEUE_SEND( pxQueue );
 
@@ -908,6 +1592,7 @@ Queue_t * const pxQueue = xQueue;
 			if( prvIsQueueFull( pxQueue ) != pdFALSE )
 			{
 				traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+				queueSTATS_BLOCK_START( pxQueue, ulFullBlocks, ulBlockStart );
 				vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
 
 				/* Unlocking the queue means queue events can effect the
@@ -926,6 +1611,8 @@ Queue_t * const pxQueue = xQueue;
 				{
 					portYIELD_WITHIN_API();
 				}
+
+				queueSTATS_BLOCK_END( pxQueue, ulBlockStart );
 			}
 			else
 			{
@@ -980,7 +1667,7 @@ Queue_t * const pxQueue = xQueue;
 	post). */
 	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
 	{
-		if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
+		if( ( prvQueueHasSpace( pxQueue ) && !prvIsFrontSlotHeld( pxQueue, xCopyPosition ) ) || ( xCopyPosition == queueOVERWRITE ) )
 		{
 			const int8_t cTxLock = pxQueue->cTxLock;
 			const UBaseType_t uxPreviousMessagesWaiting = pxQueue->uxMessagesWaiting;
@@ -1168,6 +1855,7 @@ Queue_t * const pxQueue = xQueue;
 			priority disinheritance is needed.  Simply increase the count of
 			messages (semaphores) available. */
 			pxQueue->uxMessagesWaiting = uxMessagesWaiting + ( UBaseType_t ) 1;
+			queueSTATS_ITEM_ADDED( pxQueue, uxMessagesWaiting + ( UBaseType_t ) 1 );
 
 			/* The event list is not altered if the queue is locked.  This will
 			be done when the queue is unlocked later. */
@@ -1280,6 +1968,10 @@ BaseType_t xEntryTimeSet = pdFALSE;
 TimeOut_t xTimeOut;
 Queue_t * const pxQueue = xQueue;
 
+#if( configUSE_QUEUE_STATISTICS == 1 )
+	configRUN_TIME_COUNTER_TYPE ulBlockStart;
+#endif
+
 	/* Check the pointer is not NULL. */
 	configASSERT( ( pxQueue ) );
 
@@ -1310,8 +2002,10 @@ Queue_t * const pxQueue = xQueue;
 			{
 				/* Data available, remove one item. */
 				prvCopyDataFromQueue( pxQueue, pvBuffer );
+				prvRemovePriorityHead( pxQueue );
 				traceQUEUE_RECEIVE( pxQueue );
 				pxQueue->uxMessagesWaiting = uxMessagesWaiting - ( UBaseType_t ) 1;
+				queueSTATS_ITEM_REMOVED( pxQueue );
 
 				/* There is now space in the queue, were any tasks waiting to
 				post to the queue?  If so, unblock the highest priority waiting
@@ -1375,6 +2069,7 @@ Queue_t * const pxQueue = xQueue;
 			if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
 			{
 				traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+				queueSTATS_BLOCK_START( pxQueue, ulEmptyBlocks, ulBlockStart );
 				vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
 				prvUnlockQueue( pxQueue );
 				if( xTaskResumeAll() == pdFALSE )
@@ -1385,6 +2080,8 @@ Queue_t * const pxQueue = xQueue;
 				{
 					mtCOVERAGE_TEST_MARKER();
 				}
+
+				queueSTATS_BLOCK_END( pxQueue, ulBlockStart );
 			}
 			else
 			{
@@ -1425,6 +2122,15 @@ Queue_t * const pxQueue = xQueue;
 	BaseType_t xInheritanceOccurred = pdFALSE;
 #endif
 
+#if( configUSE_QUEUE_STATISTICS == 1 )
+	configRUN_TIME_COUNTER_TYPE ulBlockStart;
+#endif
+
+#if( configUSE_MUTEX_PROFILING == 1 )
+	configRUN_TIME_COUNTER_TYPE ulWaitStart = 0U;
+	BaseType_t xBlocked = pdFALSE;
+#endif
+
 	/* Check the queue pointer is not NULL. */
 	configASSERT( ( pxQueue ) );
 
@@ -1432,6 +2138,8 @@ Queue_t * const pxQueue = xQueue;
 	0. */
 	configASSERT( pxQueue->uxItemSize == 0 );
 
+	queuePROFILE_TAKE_START( pxQueue, ulWaitStart );
+
 	/* Cannot block if the scheduler is suspended. */
 	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
 	{
@@ -1439,6 +2147,19 @@ Queue_t * const pxQueue = xQueue;
 	}
 	#endif
 
+	#if ( configUSE_MUTEX_FAST_PATH == 1 )
+	{
+		if( ( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX ) && ( prvMutexTakeFast( pxQueue ) != pdFALSE ) )
+		{
+			queuePROFILE_TAKEN( pxQueue, ulWaitStart, pdFALSE );
+			return pdPASS;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif
 
 	/*lint -save -e904 This function relaxes the coding standard somewhat to allow return
 	statements within the function itself.  This is done in the interest
@@ -1447,9 +2168,26 @@ Queue_t * const pxQueue = xQueue;
 	{
 		taskENTER_CRITICAL();
 		{
+		UBaseType_t uxSemaphoreCount;
+
+			#if ( configUSE_MUTEX_FAST_PATH == 1 )
+			{
+				/* If the holder took the mutex on the fast path, record it as
+				the holder so this task can inherit its priority below. */
+				if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+				{
+					prvMutexEnterSlowPath( pxQueue );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif
+
 			/* Semaphores are queues with an item size of 0, and where the
 			number of messages in the queue is the semaphore's count value. */
-			const UBaseType_t uxSemaphoreCount = pxQueue->uxMessagesWaiting;
+			uxSemaphoreCount = pxQueue->uxMessagesWaiting;
 
 			/* Is there data in the queue now?  To be running the calling task
 			must be the highest priority task wanting to access the queue. */
@@ -1460,6 +2198,7 @@ Queue_t * const pxQueue = xQueue;
 				/* Semaphores are queues with a data size of zero and where the
 				messages waiting is the semaphore's count.  Reduce the count. */
 				pxQueue->uxMessagesWaiting = uxSemaphoreCount - ( UBaseType_t ) 1;
+				queueSTATS_ITEM_REMOVED( pxQueue );
 
 				#if ( configUSE_MUTEXES == 1 )
 				{
@@ -1468,6 +2207,20 @@ Queue_t * const pxQueue = xQueue;
 						/* Record the information required to implement
 						priority inheritance should it become necessary. */
 						pxQueue->u.xSemaphore.xMutexHolder = pvTaskIncrementMutexHeldCount();
+						queuePROFILE_TAKEN( pxQueue, ulWaitStart, xBlocked );
+
+						#if ( configUSE_MUTEX_CEILING == 1 )
+						{
+							if( ( pxQueue->uxCeilingPriority != ( UBaseType_t ) 0 ) && ( pxQueue->u.xSemaphore.xMutexHolder != NULL ) )
+							{
+								pxQueue->uxPriorityOnTake = uxTaskPriorityRaiseToCeiling( pxQueue->uxCeilingPriority, &( pxQueue->uxCeilingDepth ) );
+							}
+							else
+							{
+								mtCOVERAGE_TEST_MARKER();
+							}
+						}
+						#endif
 					}
 					else
 					{
@@ -1513,6 +2266,7 @@ Queue_t * const pxQueue = xQueue;
 					/* The semaphore count was 0 and no block time is specified
 					(or the block time has expired) so exit now. */
 					taskEXIT_CRITICAL();
+					queuePROFILE_FAILED( pxQueue );
 					traceQUEUE_RECEIVE_FAILED( pxQueue );
 					return errQUEUE_EMPTY;
 				}
@@ -1566,6 +2320,8 @@ Queue_t * const pxQueue = xQueue;
 				}
 				#endif
 
+				queueSTATS_BLOCK_START( pxQueue, ulEmptyBlocks, ulBlockStart );
+				queuePROFILE_BLOCKED( xBlocked );
 				vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
 				prvUnlockQueue( pxQueue );
 				if( xTaskResumeAll() == pdFALSE )
@@ -1576,6 +2332,8 @@ Queue_t * const pxQueue = xQueue;
 				{
 					mtCOVERAGE_TEST_MARKER();
 				}
+
+				queueSTATS_BLOCK_END( pxQueue, ulBlockStart );
 			}
 			else
 			{
@@ -1621,6 +2379,7 @@ Queue_t * const pxQueue = xQueue;
 				}
 				#endif /* configUSE_MUTEXES */
 
+				queuePROFILE_FAILED( pxQueue );
 				traceQUEUE_RECEIVE_FAILED( pxQueue );
 				return errQUEUE_EMPTY;
 			}
@@ -1640,6 +2399,10 @@ TimeOut_t xTimeOut;
 int8_t *pcOriginalReadPosition;
 Queue_t * const pxQueue = xQueue;
 
+#if( configUSE_QUEUE_STATISTICS == 1 )
+	configRUN_TIME_COUNTER_TYPE ulBlockStart;
+#endif
+
 	/* Check the pointer is not NULL. */
 	configASSERT( ( pxQueue ) );
 
@@ -1742,6 +2505,7 @@ Queue_t * const pxQueue = xQueue;
 			if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
 			{
 				traceBLOCKING_ON_QUEUE_PEEK( pxQueue );
+				queueSTATS_BLOCK_START( pxQueue, ulEmptyBlocks, ulBlockStart );
 				vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
 				prvUnlockQueue( pxQueue );
 				if( xTaskResumeAll() == pdFALSE )
@@ -1752,6 +2516,8 @@ Queue_t * const pxQueue = xQueue;
 				{
 					mtCOVERAGE_TEST_MARKER();
 				}
+
+				queueSTATS_BLOCK_END( pxQueue, ulBlockStart );
 			}
 			else
 			{
@@ -1819,7 +2585,9 @@ Queue_t * const pxQueue = xQueue;
 			traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
 
 			prvCopyDataFromQueue( pxQueue, pvBuffer );
+			prvRemovePriorityHead( pxQueue );
 			pxQueue->uxMessagesWaiting = uxMessagesWaiting - ( UBaseType_t ) 1;
+			queueSTATS_ITEM_REMOVED( pxQueue );
 
 			/* If the queue is locked the event list will not be modified.
 			Instead update the lock count so the task that unlocks the queue
@@ -1927,43 +2695,996 @@ Queue_t * const pxQueue = xQueue;
 }
 /*-----------------------------------------------------------*/
 
-UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue )
-{
-UBaseType_t uxReturn;
-
-	configASSERT( xQueue );
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
 
-	taskENTER_CRITICAL();
+	void *pvQueueReserve( QueueHandle_t xQueue, TickType_t xTicksToWait )
 	{
-		uxReturn = ( ( Queue_t * ) xQueue )->uxMessagesWaiting;
-	}
-	taskEXIT_CRITICAL();
-
-	return uxReturn;
-} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
-/*-----------------------------------------------------------*/
-
-UBaseType_t uxQueueSpacesAvailable( const QueueHandle_t xQueue )
-{
-UBaseType_t uxReturn;
-Queue_t * const pxQueue = xQueue;
+	BaseType_t xEntryTimeSet = pdFALSE;
+	TimeOut_t xTimeOut;
+	Queue_t * const pxQueue = xQueue;
+	void *pvSlot;
 
-	configASSERT( pxQueue );
+	#if( configUSE_QUEUE_STATISTICS == 1 )
+		configRUN_TIME_COUNTER_TYPE ulBlockStart;
+	#endif
 
-	taskENTER_CRITICAL();
-	{
-		uxReturn = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
-	}
-	taskEXIT_CRITICAL();
+		configASSERT( pxQueue );
 
-	return uxReturn;
-} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
-/*-----------------------------------------------------------*/
+		/* Semaphores have no storage to hand out. */
+		configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
 
-UBaseType_t uxQueueMessagesWaitingFromISR( const QueueHandle_t xQueue )
-{
-UBaseType_t uxReturn;
-Queue_t * const pxQueue = xQueue;
+		#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+		{
+			configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+		}
+		#endif
+
+		/*lint -save -e904 This function relaxes the coding standard somewhat to
+		allow return statements within the function itself.  This is done in the
+		interest of execution time efficiency. */
+		for( ;; )
+		{
+			taskENTER_CRITICAL();
+			{
+				/* Is there room on the queue now, and no other reservation
+				outstanding? */
+				if( prvQueueHasSpace( pxQueue ) )
+				{
+					/* Hand out the slot the next item would be copied to.
+					pcWriteTo is not moved on until the item is committed. */
+					pvSlot = ( void * ) pxQueue->pcWriteTo;
+					pxQueue->pcReservedSlot = pxQueue->pcWriteTo;
+					taskEXIT_CRITICAL();
+					return pvSlot;
+				}
+				else
+				{
+					if( xTicksToWait == ( TickType_t ) 0 )
+					{
+						/* The queue was full and no block time is specified (or
+						the block time has expired) so leave now. */
+						taskEXIT_CRITICAL();
+						traceQUEUE_SEND_FAILED( pxQueue );
+						return NULL;
+					}
+					else if( xEntryTimeSet == pdFALSE )
+					{
+						/* The queue was full and a block time was specified so
+						configure the timeout structure. */
+						vTaskInternalSetTimeOutState( &xTimeOut );
+						xEntryTimeSet = pdTRUE;
+					}
+					else
+					{
+						/* Entry time was already set. */
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			/* Interrupts and other tasks can send to and receive from the queue
+			now the critical section has been exited. */
+
+			vTaskSuspendAll();
+			prvLockQueue( pxQueue );
+
+			/* Update the timeout state to see if it has expired yet. */
+			if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+			{
+				if( prvIsQueueFull( pxQueue ) != pdFALSE )
+				{
+					traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+					queueSTATS_BLOCK_START( pxQueue, ulFullBlocks, ulBlockStart );
+					vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+					prvUnlockQueue( pxQueue );
+
+					if( xTaskResumeAll() == pdFALSE )
+					{
+						portYIELD_WITHIN_API();
+					}
+
+					queueSTATS_BLOCK_END( pxQueue, ulBlockStart );
+				}
+				else
+				{
+					/* Try again. */
+					prvUnlockQueue( pxQueue );
+					( void ) xTaskResumeAll();
+				}
+			}
+			else
+			{
+				/* The timeout has expired. */
+				prvUnlockQueue( pxQueue );
+				( void ) xTaskResumeAll();
+
+				traceQUEUE_SEND_FAILED( pxQueue );
+				return NULL;
+			}
+		} /*lint -restore */
+	}
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+	void *pvQueueReserveFromISR( QueueHandle_t xQueue )
+	{
+	UBaseType_t uxSavedInterruptStatus;
+	Queue_t * const pxQueue = xQueue;
+	void *pvSlot = NULL;
+
+		configASSERT( pxQueue );
+		configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+		/* See the comment in xQueueGenericSendFromISR(). */
+		portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			if( prvQueueHasSpace( pxQueue ) )
+			{
+				pvSlot = ( void * ) pxQueue->pcWriteTo;
+				pxQueue->pcReservedSlot = pxQueue->pcWriteTo;
+			}
+			else
+			{
+				traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+			}
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		return pvSlot;
+	}
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+	BaseType_t xQueueCommit( QueueHandle_t xQueue )
+	{
+	Queue_t * const pxQueue = xQueue;
+
+		configASSERT( pxQueue );
+		configASSERT( pxQueue->pcReservedSlot != NULL );
+
+		taskENTER_CRITICAL();
+		{
+			traceQUEUE_SEND( pxQueue );
+			prvCommitReservedSlot( pxQueue );
+
+			if( prvUnblockReader( pxQueue ) != pdFALSE )
+			{
+				queueYIELD_IF_USING_PREEMPTION();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* Writers that found the queue full only because of the
+			reservation can try again. */
+			if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) && ( prvUnblockWriter( pxQueue ) != pdFALSE ) )
+			{
+				queueYIELD_IF_USING_PREEMPTION();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return pdPASS;
+	}
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+	BaseType_t xQueueCommitFromISR( QueueHandle_t xQueue, BaseType_t * const pxHigherPriorityTaskWoken )
+	{
+	UBaseType_t uxSavedInterruptStatus;
+	Queue_t * const pxQueue = xQueue;
+	BaseType_t xTaskWoken = pdFALSE;
+
+		configASSERT( pxQueue );
+		configASSERT( pxQueue->pcReservedSlot != NULL );
+		portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			const int8_t cTxLock = pxQueue->cTxLock;
+
+			traceQUEUE_SEND_FROM_ISR( pxQueue );
+			prvCommitReservedSlot( pxQueue );
+
+			/* The event lists are not altered if the queue is locked.  This
+			will be done when the queue is unlocked later. */
+			if( cTxLock == queueUNLOCKED )
+			{
+				xTaskWoken = prvUnblockReader( pxQueue );
+
+				if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) && ( prvUnblockWriter( pxQueue ) != pdFALSE ) )
+				{
+					xTaskWoken = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				/* Increment the lock counts so the task that unlocks the queue
+				knows that data was posted, and that a writer might now find
+				room. */
+				pxQueue->cTxLock = ( int8_t ) ( cTxLock + 1 );
+
+				if( pxQueue->uxMessagesWaiting < pxQueue->uxLength )
+				{
+					pxQueue->cRxLock = ( int8_t ) ( pxQueue->cRxLock + 1 );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		if( ( xTaskWoken != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+		{
+			*pxHigherPriorityTaskWoken = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pdPASS;
+	}
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+	void *pvQueueAcquire( QueueHandle_t xQueue, TickType_t xTicksToWait )
+	{
+	BaseType_t xEntryTimeSet = pdFALSE;
+	TimeOut_t xTimeOut;
+	Queue_t * const pxQueue = xQueue;
+	void *pvSlot;
+
+	#if( configUSE_QUEUE_STATISTICS == 1 )
+		configRUN_TIME_COUNTER_TYPE ulBlockStart;
+	#endif
+
+		configASSERT( pxQueue );
+		configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+		/* Only one item can be held at a time. */
+		configASSERT( pxQueue->pcAcquiredSlot == NULL );
+
+		#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+		{
+			configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+		}
+		#endif
+
+		/*lint -save -e904  This function relaxes the coding standard somewhat to
+		allow return statements within the function itself.  This is done in the
+		interest of execution time efficiency. */
+		for( ;; )
+		{
+			taskENTER_CRITICAL();
+			{
+				/* Is there data in the queue now?  To be running the calling
+				task must be the highest priority task wanting to access the
+				queue. */
+				if( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 )
+				{
+					/* Data available, take the item without copying it.  The
+					space it occupies stays in use until it is released, so no
+					writer is woken. */
+					pvSlot = prvAcquireFrontSlot( pxQueue );
+					traceQUEUE_RECEIVE( pxQueue );
+					taskEXIT_CRITICAL();
+					return pvSlot;
+				}
+				else
+				{
+					if( xTicksToWait == ( TickType_t ) 0 )
+					{
+						/* The queue was empty and no block time is specified (or
+						the block time has expired) so leave now. */
+						taskEXIT_CRITICAL();
+						traceQUEUE_RECEIVE_FAILED( pxQueue );
+						return NULL;
+					}
+					else if( xEntryTimeSet == pdFALSE )
+					{
+						/* The queue was empty and a block time was specified so
+						configure the timeout structure. */
+						vTaskInternalSetTimeOutState( &xTimeOut );
+						xEntryTimeSet = pdTRUE;
+					}
+					else
+					{
+						/* Entry time was already set. */
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			/* Interrupts and other tasks can send to and receive from the queue
+			now the critical section has been exited. */
+
+			vTaskSuspendAll();
+			prvLockQueue( pxQueue );
+
+			/* Update the timeout state to see if it has expired yet. */
+			if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+			{
+				/* The timeout has not expired.  If the queue is still empty
+				place the task on the list of tasks waiting to receive from the
+				queue. */
+				if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+				{
+					traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+					queueSTATS_BLOCK_START( pxQueue, ulEmptyBlocks, ulBlockStart );
+					vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+					prvUnlockQueue( pxQueue );
+					if( xTaskResumeAll() == pdFALSE )
+					{
+						portYIELD_WITHIN_API();
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					queueSTATS_BLOCK_END( pxQueue, ulBlockStart );
+				}
+				else
+				{
+					/* The queue contains data again.  Loop back to try and read
+					the data. */
+					prvUnlockQueue( pxQueue );
+					( void ) xTaskResumeAll();
+				}
+			}
+			else
+			{
+				/* Timed out.  If there is no data in the queue exit, otherwise
+				loop back and attempt to read the data. */
+				prvUnlockQueue( pxQueue );
+				( void ) xTaskResumeAll();
+
+				if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+				{
+					traceQUEUE_RECEIVE_FAILED( pxQueue );
+					return NULL;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		} /*lint -restore */
+	}
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+	void *pvQueueAcquireFromISR( QueueHandle_t xQueue )
+	{
+	UBaseType_t uxSavedInterruptStatus;
+	Queue_t * const pxQueue = xQueue;
+	void *pvSlot = NULL;
+
+		configASSERT( pxQueue );
+		configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+		configASSERT( pxQueue->pcAcquiredSlot == NULL );
+		portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			if( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 )
+			{
+				pvSlot = prvAcquireFrontSlot( pxQueue );
+				traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
+			}
+			else
+			{
+				traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
+			}
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		return pvSlot;
+	}
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+	BaseType_t xQueueRelease( QueueHandle_t xQueue )
+	{
+	Queue_t * const pxQueue = xQueue;
+
+		configASSERT( pxQueue );
+		configASSERT( pxQueue->pcAcquiredSlot != NULL );
+
+		taskENTER_CRITICAL();
+		{
+			/* The slot can be written to again.  There is now space in the
+			queue, were any tasks waiting to post to the queue?  If so, unblock
+			the highest priority waiting task. */
+			pxQueue->pcAcquiredSlot = NULL;
+			( pxQueue->uxLength )++;
+
+			if( prvUnblockWriter( pxQueue ) != pdFALSE )
+			{
+				queueYIELD_IF_USING_PREEMPTION();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return pdPASS;
+	}
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+	BaseType_t xQueueReleaseFromISR( QueueHandle_t xQueue, BaseType_t * const pxHigherPriorityTaskWoken )
+	{
+	UBaseType_t uxSavedInterruptStatus;
+	Queue_t * const pxQueue = xQueue;
+
+		configASSERT( pxQueue );
+		configASSERT( pxQueue->pcAcquiredSlot != NULL );
+		portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			const int8_t cRxLock = pxQueue->cRxLock;
+
+			pxQueue->pcAcquiredSlot = NULL;
+			( pxQueue->uxLength )++;
+
+			/* The event list is not altered if the queue is locked.  This will
+			be done when the queue is unlocked later. */
+			if( cRxLock == queueUNLOCKED )
+			{
+				if( ( prvUnblockWriter( pxQueue ) != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+				{
+					*pxHigherPriorityTaskWoken = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				/* Increment the lock count so the task that unlocks the queue
+				knows that space was freed while it was locked. */
+				pxQueue->cRxLock = ( int8_t ) ( cRxLock + 1 );
+			}
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		return pdPASS;
+	}
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_BATCH == 1 )
+
+	BaseType_t xQueueSendBatch( QueueHandle_t xQueue, const void * const pvItems, const UBaseType_t uxItemCount, TickType_t xTicksToWait )
+	{
+	BaseType_t xEntryTimeSet = pdFALSE, xYieldRequired;
+	TimeOut_t xTimeOut;
+	Queue_t * const pxQueue = xQueue;
+	const int8_t *pcItem = ( const int8_t * ) pvItems;
+	UBaseType_t uxMoved, uxWoken;
+
+	#if( configUSE_QUEUE_STATISTICS == 1 )
+		configRUN_TIME_COUNTER_TYPE ulBlockStart;
+	#endif
+
+		configASSERT( pxQueue );
+		configASSERT( !( ( pvItems == NULL ) && ( uxItemCount != ( UBaseType_t ) 0U ) ) );
+
+		/* Semaphores and mutexes have no items to move. */
+		configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+		#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+		{
+			configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+		}
+		#endif
+
+		/*lint -save -e904 This function relaxes the coding standard somewhat to
+		allow return statements within the function itself.  This is done in the
+		interest of execution time efficiency. */
+		for( ;; )
+		{
+			taskENTER_CRITICAL();
+			{
+				/* Is there room for at least one item? */
+				if( prvQueueHasSpace( pxQueue ) || ( uxItemCount == ( UBaseType_t ) 0U ) )
+				{
+					/* Move as many items as fit under the one critical
+					section. */
+					for( uxMoved = 0; ( uxMoved < uxItemCount ) && prvQueueHasSpace( pxQueue ); uxMoved++ )
+					{
+						traceQUEUE_SEND( pxQueue );
+						( void ) prvCopyDataToQueue( pxQueue, pcItem, queueSEND_TO_BACK );
+						pcItem += pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok. */
+					}
+
+					/* Wake one receiver per item posted, but yield at most
+					once.  A queue set needs one notification per item. */
+					xYieldRequired = pdFALSE;
+					for( uxWoken = 0; uxWoken < uxMoved; uxWoken++ )
+					{
+						if( prvUnblockReader( pxQueue ) != pdFALSE )
+						{
+							xYieldRequired = pdTRUE;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+
+					if( xYieldRequired != pdFALSE )
+					{
+						queueYIELD_IF_USING_PREEMPTION();
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					taskEXIT_CRITICAL();
+					return ( BaseType_t ) uxMoved;
+				}
+				else
+				{
+					if( xTicksToWait == ( TickType_t ) 0 )
+					{
+						/* The queue was full and no block time is specified (or
+						the block time has expired) so leave now. */
+						taskEXIT_CRITICAL();
+						traceQUEUE_SEND_FAILED( pxQueue );
+						return 0;
+					}
+					else if( xEntryTimeSet == pdFALSE )
+					{
+						/* The queue was full and a block time was specified so
+						configure the timeout structure. */
+						vTaskInternalSetTimeOutState( &xTimeOut );
+						xEntryTimeSet = pdTRUE;
+					}
+					else
+					{
+						/* Entry time was already set. */
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			/* Interrupts and other tasks can send to and receive from the queue
+			now the critical section has been exited. */
+
+			vTaskSuspendAll();
+			prvLockQueue( pxQueue );
+
+			/* Update the timeout state to see if it has expired yet. */
+			if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+			{
+				if( prvIsQueueFull( pxQueue ) != pdFALSE )
+				{
+					traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+					queueSTATS_BLOCK_START( pxQueue, ulFullBlocks, ulBlockStart );
+					vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+					prvUnlockQueue( pxQueue );
+
+					if( xTaskResumeAll() == pdFALSE )
+					{
+						portYIELD_WITHIN_API();
+					}
+
+					queueSTATS_BLOCK_END( pxQueue, ulBlockStart );
+				}
+				else
+				{
+					/* Try again. */
+					prvUnlockQueue( pxQueue );
+					( void ) xTaskResumeAll();
+				}
+			}
+			else
+			{
+				/* The timeout has expired. */
+				prvUnlockQueue( pxQueue );
+				( void ) xTaskResumeAll();
+
+				traceQUEUE_SEND_FAILED( pxQueue );
+				return 0;
+			}
+		} /*lint -restore */
+	}
+
+#endif /* configUSE_QUEUE_BATCH */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_BATCH == 1 )
+
+	BaseType_t xQueueSendBatchFromISR( QueueHandle_t xQueue, const void * const pvItems, const UBaseType_t uxItemCount, BaseType_t * const pxHigherPriorityTaskWoken )
+	{
+	UBaseType_t uxSavedInterruptStatus, uxMoved, uxWoken;
+	Queue_t * const pxQueue = xQueue;
+	const int8_t *pcItem = ( const int8_t * ) pvItems;
+
+		configASSERT( pxQueue );
+		configASSERT( !( ( pvItems == NULL ) && ( uxItemCount != ( UBaseType_t ) 0U ) ) );
+		configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+		/* See the comment in xQueueGenericSendFromISR(). */
+		portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			const int8_t cTxLock = pxQueue->cTxLock;
+
+			for( uxMoved = 0; ( uxMoved < uxItemCount ) && prvQueueHasSpace( pxQueue ); uxMoved++ )
+			{
+				traceQUEUE_SEND_FROM_ISR( pxQueue );
+				( void ) prvCopyDataToQueue( pxQueue, pcItem, queueSEND_TO_BACK );
+				pcItem += pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok. */
+			}
+
+			if( uxMoved == ( UBaseType_t ) 0U )
+			{
+				traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+			}
+			else if( cTxLock == queueUNLOCKED )
+			{
+				for( uxWoken = 0; uxWoken < uxMoved; uxWoken++ )
+				{
+					if( ( prvUnblockReader( pxQueue ) != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+					{
+						*pxHigherPriorityTaskWoken = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+			}
+			else
+			{
+				/* Increment the lock count so the task that unlocks the queue
+				knows how many items were posted while it was locked. */
+				pxQueue->cTxLock = prvAddToLockCount( cTxLock, uxMoved );
+			}
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		return ( BaseType_t ) uxMoved;
+	}
+
+#endif /* configUSE_QUEUE_BATCH */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_BATCH == 1 )
+
+	BaseType_t xQueueReceiveBatch( QueueHandle_t xQueue, void * const pvBuffer, const UBaseType_t uxMaxItems, TickType_t xTicksToWait )
+	{
+	BaseType_t xEntryTimeSet = pdFALSE, xYieldRequired;
+	TimeOut_t xTimeOut;
+	Queue_t * const pxQueue = xQueue;
+	int8_t *pcItem = ( int8_t * ) pvBuffer;
+	UBaseType_t uxMoved, uxWoken;
+
+	#if( configUSE_QUEUE_STATISTICS == 1 )
+		configRUN_TIME_COUNTER_TYPE ulBlockStart;
+	#endif
+
+		configASSERT( pxQueue );
+		configASSERT( !( ( pvBuffer == NULL ) && ( uxMaxItems != ( UBaseType_t ) 0U ) ) );
+		configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+		#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+		{
+			configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+		}
+		#endif
+
+		/*lint -save -e904  This function relaxes the coding standard somewhat to
+		allow return statements within the function itself.  This is done in the
+		interest of execution time efficiency. */
+		for( ;; )
+		{
+			taskENTER_CRITICAL();
+			{
+				/* Is there data in the queue now?  To be running the calling
+				task must be the highest priority task wanting to access the
+				queue. */
+				if( ( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 ) || ( uxMaxItems == ( UBaseType_t ) 0U ) )
+				{
+					for( uxMoved = 0; ( uxMoved < uxMaxItems ) && ( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 ); uxMoved++ )
+					{
+						prvCopyDataFromQueue( pxQueue, pcItem );
+						prvRemovePriorityHead( pxQueue );
+						traceQUEUE_RECEIVE( pxQueue );
+						pxQueue->uxMessagesWaiting = pxQueue->uxMessagesWaiting - ( UBaseType_t ) 1;
+						queueSTATS_ITEM_REMOVED( pxQueue );
+						pcItem += pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok. */
+					}
+
+					/* There is now space in the queue for every item removed.
+					Wake one waiting sender per space, but yield at most once. */
+					xYieldRequired = pdFALSE;
+					for( uxWoken = 0; uxWoken < uxMoved; uxWoken++ )
+					{
+						if( prvUnblockWriter( pxQueue ) != pdFALSE )
+						{
+							xYieldRequired = pdTRUE;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+
+					if( xYieldRequired != pdFALSE )
+					{
+						queueYIELD_IF_USING_PREEMPTION();
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					taskEXIT_CRITICAL();
+					return ( BaseType_t ) uxMoved;
+				}
+				else
+				{
+					if( xTicksToWait == ( TickType_t ) 0 )
+					{
+						/* The queue was empty and no block time is specified (or
+						the block time has expired) so leave now. */
+						taskEXIT_CRITICAL();
+						traceQUEUE_RECEIVE_FAILED( pxQueue );
+						return 0;
+					}
+					else if( xEntryTimeSet == pdFALSE )
+					{
+						/* The queue was empty and a block time was specified so
+						configure the timeout structure. */
+						vTaskInternalSetTimeOutState( &xTimeOut );
+						xEntryTimeSet = pdTRUE;
+					}
+					else
+					{
+						/* Entry time was already set. */
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			/* Interrupts and other tasks can send to and receive from the queue
+			now the critical section has been exited. */
+
+			vTaskSuspendAll();
+			prvLockQueue( pxQueue );
+
+			/* Update the timeout state to see if it has expired yet. */
+			if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+			{
+				/* The timeout has not expired.  If the queue is still empty
+				place the task on the list of tasks waiting to receive from the
+				queue. */
+				if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+				{
+					traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+					queueSTATS_BLOCK_START( pxQueue, ulEmptyBlocks, ulBlockStart );
+					vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+					prvUnlockQueue( pxQueue );
+					if( xTaskResumeAll() == pdFALSE )
+					{
+						portYIELD_WITHIN_API();
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					queueSTATS_BLOCK_END( pxQueue, ulBlockStart );
+				}
+				else
+				{
+					/* The queue contains data again.  Loop back to try and read
+					the data. */
+					prvUnlockQueue( pxQueue );
+					( void ) xTaskResumeAll();
+				}
+			}
+			else
+			{
+				/* Timed out.  If there is no data in the queue exit, otherwise
+				loop back and attempt to read the data. */
+				prvUnlockQueue( pxQueue );
+				( void ) xTaskResumeAll();
+
+				if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+				{
+					traceQUEUE_RECEIVE_FAILED( pxQueue );
+					return 0;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		} /*lint -restore */
+	}
+
+#endif /* configUSE_QUEUE_BATCH */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_BATCH == 1 )
+
+	BaseType_t xQueueReceiveBatchFromISR( QueueHandle_t xQueue, void * const pvBuffer, const UBaseType_t uxMaxItems, BaseType_t * const pxHigherPriorityTaskWoken )
+	{
+	UBaseType_t uxSavedInterruptStatus, uxMoved, uxWoken;
+	Queue_t * const pxQueue = xQueue;
+	int8_t *pcItem = ( int8_t * ) pvBuffer;
+
+		configASSERT( pxQueue );
+		configASSERT( !( ( pvBuffer == NULL ) && ( uxMaxItems != ( UBaseType_t ) 0U ) ) );
+		configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+		/* See the comment in xQueueGenericSendFromISR(). */
+		portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			const int8_t cRxLock = pxQueue->cRxLock;
+
+			for( uxMoved = 0; ( uxMoved < uxMaxItems ) && ( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 ); uxMoved++ )
+			{
+				prvCopyDataFromQueue( pxQueue, pcItem );
+				prvRemovePriorityHead( pxQueue );
+				traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
+				pxQueue->uxMessagesWaiting = pxQueue->uxMessagesWaiting - ( UBaseType_t ) 1;
+				queueSTATS_ITEM_REMOVED( pxQueue );
+				pcItem += pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok. */
+			}
+
+			if( uxMoved == ( UBaseType_t ) 0U )
+			{
+				traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
+			}
+			else if( cRxLock == queueUNLOCKED )
+			{
+				for( uxWoken = 0; uxWoken < uxMoved; uxWoken++ )
+				{
+					if( ( prvUnblockWriter( pxQueue ) != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+					{
+						*pxHigherPriorityTaskWoken = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+			}
+			else
+			{
+				/* Increment the lock count so the task that unlocks the queue
+				knows how many items were removed while it was locked. */
+				pxQueue->cRxLock = prvAddToLockCount( cRxLock, uxMoved );
+			}
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		return ( BaseType_t ) uxMoved;
+	}
+
+#endif /* configUSE_QUEUE_BATCH */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_PRIORITY == 1 )
+
+	UBaseType_t uxQueueGetLastReceivedPriority( const QueueHandle_t xQueue )
+	{
+	UBaseType_t uxReturn;
+
+		configASSERT( xQueue );
+		uxReturn = ( UBaseType_t ) ( ( Queue_t * ) xQueue )->ucLastPriority;
+
+		return uxReturn;
+	}
+
+#endif /* configUSE_QUEUE_PRIORITY */
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue )
+{
+UBaseType_t uxReturn;
+
+	configASSERT( xQueue );
+
+	taskENTER_CRITICAL();
+	{
+		uxReturn = ( ( Queue_t * ) xQueue )->uxMessagesWaiting;
+	}
+	taskEXIT_CRITICAL();
+
+	return uxReturn;
+} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueSpacesAvailable( const QueueHandle_t xQueue )
+{
+UBaseType_t uxReturn;
+Queue_t * const pxQueue = xQueue;
+
+	configASSERT( pxQueue );
+
+	taskENTER_CRITICAL();
+	{
+		uxReturn = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
+
+		#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+		{
+			/* A reserved slot is not yet counted in uxMessagesWaiting. */
+			if( pxQueue->pcReservedSlot != NULL )
+			{
+				uxReturn--;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_QUEUE_ZERO_COPY */
+	}
+	taskEXIT_CRITICAL();
+
+	return uxReturn;
+} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueMessagesWaitingFromISR( const QueueHandle_t xQueue )
+{
+UBaseType_t uxReturn;
+Queue_t * const pxQueue = xQueue;
 
 	configASSERT( pxQueue );
 	uxReturn = pxQueue->uxMessagesWaiting;
@@ -1985,6 +3706,24 @@ Queue_t * const pxQueue = xQueue;
 	}
 	#endif
 
+	#if ( configUSE_MUTEX_PROFILING == 1 )
+	{
+		/* Free the profile slot for the next mutex to be created. */
+		if( pxQueue->pxProfile != NULL )
+		{
+			taskENTER_CRITICAL();
+			{
+				pxQueue->pxProfile->pxMutex = NULL;
+			}
+			taskEXIT_CRITICAL();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif
+
 	#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
 	{
 		/* The queue can only have been allocated dynamically - free it
@@ -2065,12 +3804,314 @@ Queue_t * const pxQueue = xQueue;
 			uxHighestPriorityOfWaitingTasks = tskIDLE_PRIORITY;
 		}
 
+		#if ( configUSE_MUTEX_CEILING == 1 )
+		{
+			/* The holder of a ceiling mutex stays at least at the ceiling. */
+			if( pxQueue->uxCeilingPriority > uxHighestPriorityOfWaitingTasks )
+			{
+				uxHighestPriorityOfWaitingTasks = pxQueue->uxCeilingPriority;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif
+
 		return uxHighestPriorityOfWaitingTasks;
 	}
 
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+	static void prvCommitReservedSlot( Queue_t * const pxQueue )
+	{
+	const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting + ( UBaseType_t ) 1;
+
+		#if ( configUSE_QUEUE_PRIORITY == 1 )
+		{
+			/* Items of a priority queue are not stored in order. */
+			configASSERT( pxQueue->pxPriorityItems == NULL );
+		}
+		#endif
+
+		/* The item is already in place, so this is the bookkeeping
+		prvCopyDataToQueue() does for queueSEND_TO_BACK without the copy. */
+		pxQueue->pcWriteTo += pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+		if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+		{
+			pxQueue->pcWriteTo = pxQueue->pcHead;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		pxQueue->pcReservedSlot = NULL;
+		pxQueue->uxMessagesWaiting = uxMessagesWaiting;
+		queueSTATS_ITEM_ADDED( pxQueue, uxMessagesWaiting );
+	}
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+	static void *prvAcquireFrontSlot( Queue_t * const pxQueue )
+	{
+		#if ( configUSE_QUEUE_PRIORITY == 1 )
+		{
+			/* Items of a priority queue are not stored in order. */
+			configASSERT( pxQueue->pxPriorityItems == NULL );
+		}
+		#endif
+
+		/* As prvCopyDataFromQueue(), without the copy. */
+		pxQueue->u.xQueue.pcReadFrom += pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+		if( pxQueue->u.xQueue.pcReadFrom >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as use of the relational operator is the cleanest solutions. */
+		{
+			pxQueue->u.xQueue.pcReadFrom = pxQueue->pcHead;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* The item leaves the queue, but its slot cannot be reused until it is
+		released, so the queue holds one item less meanwhile. */
+		pxQueue->pcAcquiredSlot = pxQueue->u.xQueue.pcReadFrom;
+		pxQueue->uxMessagesWaiting = pxQueue->uxMessagesWaiting - ( UBaseType_t ) 1;
+		queueSTATS_ITEM_REMOVED( pxQueue );
+		( pxQueue->uxLength )--;
+
+		return ( void * ) pxQueue->pcAcquiredSlot;
+	}
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_QUEUE_ZERO_COPY == 1 ) || ( configUSE_QUEUE_BATCH == 1 ) )
+
+	static BaseType_t prvUnblockReader( Queue_t * const pxQueue )
+	{
+	BaseType_t xReturn = pdFALSE;
+
+		#if ( configUSE_QUEUE_SETS == 1 )
+			if( pxQueue->pxQueueSetContainer != NULL )
+			{
+				/* The queue is a member of a queue set, so the task to wake is
+				the one blocked on the set. */
+				xReturn = prvNotifyQueueSetContainer( pxQueue );
+			}
+			else
+		#endif /* configUSE_QUEUE_SETS */
+		if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+		{
+			xReturn = xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_QUEUE_ZERO_COPY || configUSE_QUEUE_BATCH */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_QUEUE_ZERO_COPY == 1 ) || ( configUSE_QUEUE_BATCH == 1 ) )
+
+	static BaseType_t prvUnblockWriter( Queue_t * const pxQueue )
+	{
+	BaseType_t xReturn = pdFALSE;
+
+		if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+		{
+			xReturn = xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_QUEUE_ZERO_COPY || configUSE_QUEUE_BATCH */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_BATCH == 1 )
+
+	static int8_t prvAddToLockCount( const int8_t cLock, const UBaseType_t uxCount )
+	{
+	int8_t cReturn;
+
+		/* prvUnlockQueue() stops early once no task is waiting, so a
+		saturated count loses nothing. */
+		if( uxCount < ( UBaseType_t ) ( queueLOCK_COUNT_MAX - cLock ) )
+		{
+			cReturn = ( int8_t ) ( cLock + ( int8_t ) uxCount );
+		}
+		else
+		{
+			cReturn = queueLOCK_COUNT_MAX;
+		}
+
+		return cReturn;
+	}
+
+#endif /* configUSE_QUEUE_BATCH */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_PRIORITY == 1 )
+
+	static BaseType_t prvPriorityBefore( const QueuePriorityItem_t * const pxA, const QueuePriorityItem_t * const pxB )
+	{
+	BaseType_t xReturn;
+
+		if( pxA->ucPriority != pxB->ucPriority )
+		{
+			xReturn = ( pxA->ucPriority > pxB->ucPriority ) ? pdTRUE : pdFALSE;
+		}
+		else
+		{
+			/* The difference is taken so the order holds when the sequence
+			number wraps. */
+			xReturn = ( ( int32_t ) ( pxA->ulSequence - pxB->ulSequence ) < 0 ) ? pdTRUE : pdFALSE;
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_QUEUE_PRIORITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_PRIORITY == 1 )
+
+	static void prvInsertByPriority( Queue_t * const pxQueue, const void *pvItemToQueue, const BaseType_t xPosition )
+	{
+	QueuePriorityItem_t * const pxItems = pxQueue->pxPriorityItems;
+	QueuePriorityItem_t xNewItem;
+	UBaseType_t uxIndex, uxParent;
+
+		/* This function is called from a critical section.  Items can only be
+		sent to the back or by priority. */
+		configASSERT( prvIsSendToBack( xPosition ) );
+
+		/* The entry just past the heap holds a free slot. */
+		uxIndex = pxQueue->uxMessagesWaiting;
+		xNewItem.usSlot = pxItems[ uxIndex ].usSlot;
+		xNewItem.ucPriority = ( uint8_t ) ( xPosition & ( BaseType_t ) 0xFF );
+		xNewItem.ulSequence = pxQueue->ulNextSequence;
+		( pxQueue->ulNextSequence )++;
+
+		( void ) memcpy( ( void * ) ( pxQueue->pcHead + ( ( UBaseType_t ) xNewItem.usSlot * pxQueue->uxItemSize ) ), pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 !e9016 See the comment on the memcpy() in prvCopyDataToQueue(). */
+
+		/* Move the new entry up past every parent it must be received
+		before. */
+		while( uxIndex > ( UBaseType_t ) 0 )
+		{
+			uxParent = ( uxIndex - ( UBaseType_t ) 1 ) / ( UBaseType_t ) 2;
+
+			if( prvPriorityBefore( &xNewItem, &( pxItems[ uxParent ] ) ) == pdFALSE )
+			{
+				break;
+			}
+
+			pxItems[ uxIndex ] = pxItems[ uxParent ];
+			uxIndex = uxParent;
+		}
+
+		pxItems[ uxIndex ] = xNewItem;
+	}
+
+#endif /* configUSE_QUEUE_PRIORITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_PRIORITY == 1 )
+
+	static void prvRemovePriorityHead( Queue_t * const pxQueue )
+	{
+	QueuePriorityItem_t * const pxItems = pxQueue->pxPriorityItems;
+	QueuePriorityItem_t xHead, xLast;
+	UBaseType_t uxIndex, uxChild, uxLast;
+
+		/* This function is called from a critical section. */
+		if( pxItems != NULL )
+		{
+			configASSERT( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 );
+
+			xHead = pxItems[ 0 ];
+			uxLast = pxQueue->uxMessagesWaiting - ( UBaseType_t ) 1;
+			xLast = pxItems[ uxLast ];
+			pxQueue->ucLastPriority = xHead.ucPriority;
+
+			/* Move the last entry down from the top of the now smaller heap
+			until no child must be received before it. */
+			uxIndex = 0;
+			for( ;; )
+			{
+				uxChild = ( uxIndex * ( UBaseType_t ) 2 ) + ( UBaseType_t ) 1;
+
+				if( uxChild >= uxLast )
+				{
+					break;
+				}
+
+				if( ( ( uxChild + ( UBaseType_t ) 1 ) < uxLast ) && ( prvPriorityBefore( &( pxItems[ uxChild + 1U ] ), &( pxItems[ uxChild ] ) ) != pdFALSE ) )
+				{
+					uxChild++;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				if( prvPriorityBefore( &( pxItems[ uxChild ] ), &xLast ) == pdFALSE )
+				{
+					break;
+				}
+
+				pxItems[ uxIndex ] = pxItems[ uxChild ];
+				uxIndex = uxChild;
+			}
+
+			pxItems[ uxIndex ] = xLast;
+
+			/* The slot of the removed item is now free, keep it just past the
+			heap. */
+			pxItems[ uxLast ] = xHead;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configUSE_QUEUE_PRIORITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_PRIORITY == 1 )
+
+	static void prvResetPriorityItems( Queue_t * const pxQueue )
+	{
+	UBaseType_t uxSlot;
+
+		for( uxSlot = 0; uxSlot < pxQueue->uxLength; uxSlot++ )
+		{
+			pxQueue->pxPriorityItems[ uxSlot ].usSlot = ( uint16_t ) uxSlot;
+		}
+
+		pxQueue->ulNextSequence = 0;
+		pxQueue->ucLastPriority = 0;
+	}
+
+#endif /* configUSE_QUEUE_PRIORITY */
+/*-----------------------------------------------------------*/
+
 static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue, const void *pvItemToQueue, const BaseType_t xPosition )
 {
 BaseType_t xReturn = pdFALSE;
@@ -2087,8 +4128,46 @@ UBaseType_t uxMessagesWaiting;
 			if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
 			{
 				/* The mutex is no longer being held. */
-				xReturn = xTaskPriorityDisinherit( pxQueue->u.xSemaphore.xMutexHolder );
+				#if ( configUSE_MUTEX_CEILING == 1 )
+				{
+					if( ( pxQueue->uxCeilingPriority != ( UBaseType_t ) 0 ) && ( pxQueue->u.xSemaphore.xMutexHolder != NULL ) )
+					{
+						xReturn = xTaskPriorityLowerFromCeiling( pxQueue->uxCeilingPriority, pxQueue->uxPriorityOnTake, pxQueue->uxCeilingDepth );
+					}
+					else
+					{
+						xReturn = xTaskPriorityDisinherit( pxQueue->u.xSemaphore.xMutexHolder );
+					}
+				}
+				#else
+				{
+					xReturn = xTaskPriorityDisinherit( pxQueue->u.xSemaphore.xMutexHolder );
+				}
+				#endif
 				pxQueue->u.xSemaphore.xMutexHolder = NULL;
+
+				#if ( configUSE_MUTEX_FAST_PATH == 1 )
+				{
+					/* uxMessagesWaiting becomes 1 below, so if nobody is
+					waiting the mutex can be taken on the fast path again -
+					unless it is a ceiling mutex, whose every take has to raise
+					the taking task's priority. */
+					#if ( configUSE_MUTEX_CEILING == 1 )
+						const BaseType_t xFastPathAllowed = ( pxQueue->uxCeilingPriority == ( UBaseType_t ) 0 ) ? pdTRUE : pdFALSE;
+					#else
+						const BaseType_t xFastPathAllowed = pdTRUE;
+					#endif
+
+					if( ( xFastPathAllowed != pdFALSE ) && ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE ) )
+					{
+						pxQueue->uxMutexOwner = ( portPOINTER_SIZE_TYPE ) 0;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif
 			}
 			else
 			{
@@ -2097,7 +4176,13 @@ UBaseType_t uxMessagesWaiting;
 		}
 		#endif /* configUSE_MUTEXES */
 	}
-	else if( xPosition == queueSEND_TO_BACK )
+	#if ( configUSE_QUEUE_PRIORITY == 1 )
+		else if( pxQueue->pxPriorityItems != NULL )
+		{
+			prvInsertByPriority( pxQueue, pvItemToQueue, xPosition );
+		}
+	#endif /* configUSE_QUEUE_PRIORITY */
+	else if( prvIsSendToBack( xPosition ) )
 	{
 		( void ) memcpy( ( void * ) pxQueue->pcWriteTo, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports, plus previous logic ensures a null pointer can only be passed to memcpy() if the copy size is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
 		pxQueue->pcWriteTo += pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
@@ -2145,6 +4230,7 @@ UBaseType_t uxMessagesWaiting;
 	}
 
 	pxQueue->uxMessagesWaiting = uxMessagesWaiting + ( UBaseType_t ) 1;
+	queueSTATS_ITEM_ADDED( pxQueue, uxMessagesWaiting + ( UBaseType_t ) 1 );
 
 	return xReturn;
 }
@@ -2152,6 +4238,16 @@ UBaseType_t uxMessagesWaiting;
 
 static void prvCopyDataFromQueue( Queue_t * const pxQueue, void * const pvBuffer )
 {
+	#if ( configUSE_QUEUE_PRIORITY == 1 )
+		if( pxQueue->pxPriorityItems != NULL )
+		{
+			/* The item to read is the one at the top of the heap.  It is only
+			removed by prvRemovePriorityHead(), so peeking needs nothing
+			more. */
+			( void ) memcpy( ( void * ) pvBuffer, ( void * ) ( pxQueue->pcHead + ( ( UBaseType_t ) pxQueue->pxPriorityItems[ 0 ].usSlot * pxQueue->uxItemSize ) ), ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 !e9016 See the comment on the memcpy() below. */
+		}
+		else
+	#endif /* configUSE_QUEUE_PRIORITY */
 	if( pxQueue->uxItemSize != ( UBaseType_t ) 0 )
 	{
 		pxQueue->u.xQueue.pcReadFrom += pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
@@ -2334,7 +4430,7 @@ BaseType_t xReturn;
 
 	taskENTER_CRITICAL();
 	{
-		if( pxQueue->uxMessagesWaiting == pxQueue->uxLength )
+		if( prvQueueHasSpace( pxQueue ) == pdFALSE )
 		{
 			xReturn = pdTRUE;
 		}
@@ -2355,7 +4451,7 @@ BaseType_t xReturn;
 Queue_t * const pxQueue = xQueue;
 
 	configASSERT( pxQueue );
-	if( pxQueue->uxMessagesWaiting == pxQueue->uxLength )
+	if( prvQueueHasSpace( pxQueue ) == pdFALSE )
 	{
 		xReturn = pdTRUE;
 	}
@@ -2732,6 +4828,426 @@ Queue_t * const pxQueue = xQueue;
 #endif /* configQUEUE_REGISTRY_SIZE */
 /*-----------------------------------------------------------*/
 
+#if ( ( configUSE_QUEUE_STATISTICS == 1 ) || ( configUSE_MUTEX_PROFILING == 1 ) )
+
+	static configRUN_TIME_COUNTER_TYPE prvStatsNow( void )
+	{
+	configRUN_TIME_COUNTER_TYPE ulNow;
+
+		#if ( configGENERATE_RUN_TIME_STATS == 1 )
+		{
+			#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+				portALT_GET_RUN_TIME_COUNTER_VALUE( ulNow );
+			#else
+				ulNow = portGET_RUN_TIME_COUNTER_VALUE();
+			#endif
+		}
+		#else
+		{
+			ulNow = ( configRUN_TIME_COUNTER_TYPE ) xTaskGetTickCount();
+		}
+		#endif
+
+		return ulNow;
+	}
+
+#endif /* ( configUSE_QUEUE_STATISTICS == 1 ) || ( configUSE_MUTEX_PROFILING == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_STATISTICS == 1 )
+
+	static void prvStatsBlockEnd( Queue_t * const pxQueue, const configRUN_TIME_COUNTER_TYPE ulBlockStart )
+	{
+	const configRUN_TIME_COUNTER_TYPE ulBlocked = prvStatsNow() - ulBlockStart;
+
+		/* Several tasks can be blocked on the same queue, and the counters may
+		be wider than the architecture can store in one access. */
+		taskENTER_CRITICAL();
+		{
+			pxQueue->ulBlockedTime += ulBlocked;
+
+			if( ulBlocked > pxQueue->ulMaxBlockedTime )
+			{
+				pxQueue->ulMaxBlockedTime = ulBlocked;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_QUEUE_STATISTICS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_STATISTICS == 1 )
+
+	static void prvCopyStats( const Queue_t * const pxQueue, QueueStats_t * const pxStats )
+	{
+		pxStats->uxLength = pxQueue->uxLength;
+		pxStats->uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+		pxStats->uxPeakMessagesWaiting = pxQueue->uxPeakMessagesWaiting;
+		pxStats->ulSends = pxQueue->ulSends;
+		pxStats->ulReceives = pxQueue->ulReceives;
+		pxStats->ulFullBlocks = pxQueue->ulFullBlocks;
+		pxStats->ulEmptyBlocks = pxQueue->ulEmptyBlocks;
+		pxStats->ulBlockedTime = pxQueue->ulBlockedTime;
+		pxStats->ulMaxBlockedTime = pxQueue->ulMaxBlockedTime;
+	}
+
+#endif /* configUSE_QUEUE_STATISTICS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_STATISTICS == 1 )
+
+	void vQueueGetStats( QueueHandle_t xQueue, QueueStats_t * const pxStats )
+	{
+	Queue_t * const pxQueue = xQueue;
+
+		configASSERT( pxQueue );
+		configASSERT( pxStats );
+
+		pxStats->xHandle = xQueue;
+
+		#if ( configQUEUE_REGISTRY_SIZE > 0 )
+		{
+			pxStats->pcQueueName = pcQueueGetName( xQueue );
+		}
+		#else
+		{
+			pxStats->pcQueueName = NULL;
+		}
+		#endif
+
+		taskENTER_CRITICAL();
+		{
+			prvCopyStats( pxQueue, pxStats );
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_QUEUE_STATISTICS */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_QUEUE_STATISTICS == 1 ) && ( configQUEUE_REGISTRY_SIZE > 0 ) )
+
+	UBaseType_t uxQueueGetRegistryStats( QueueStats_t * const pxStatsArray, const UBaseType_t uxArraySize )
+	{
+	UBaseType_t ux, uxCount = 0;
+	const Queue_t *pxQueue;
+
+		configASSERT( !( ( pxStatsArray == NULL ) && ( uxArraySize != ( UBaseType_t ) 0U ) ) );
+
+		/* Each entry is copied in its own short critical section rather than
+		suspending the scheduler for the whole walk.  vQueueDelete() removes a
+		queue from the registry before freeing it, so a handle read from the
+		registry in the critical section still refers to a valid queue until the
+		critical section is exited. */
+		for( ux = ( UBaseType_t ) 0U; ( ux < ( UBaseType_t ) configQUEUE_REGISTRY_SIZE ) && ( uxCount < uxArraySize ); ux++ )
+		{
+			taskENTER_CRITICAL();
+			{
+				pxQueue = xQueueRegistry[ ux ].xHandle;
+
+				/* A NULL name marks a free slot, as in vQueueAddToRegistry(). */
+				if( xQueueRegistry[ ux ].pcQueueName != NULL )
+				{
+					pxStatsArray[ uxCount ].xHandle = xQueueRegistry[ ux ].xHandle;
+					pxStatsArray[ uxCount ].pcQueueName = xQueueRegistry[ ux ].pcQueueName;
+					prvCopyStats( pxQueue, &( pxStatsArray[ uxCount ] ) );
+					uxCount++;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			taskEXIT_CRITICAL();
+		}
+
+		return uxCount;
+	}
+
+#endif /* ( configUSE_QUEUE_STATISTICS == 1 ) && ( configQUEUE_REGISTRY_SIZE > 0 ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEX_PROFILING == 1 )
+
+	static void prvProfileClaim( Queue_t * const pxMutex )
+	{
+	UBaseType_t ux;
+	MutexProfileSlot_t *pxSlot;
+
+		taskENTER_CRITICAL();
+		{
+			for( ux = ( UBaseType_t ) 0U; ux < ( UBaseType_t ) configMUTEX_PROFILE_COUNT; ux++ )
+			{
+				pxSlot = &( xMutexProfiles[ ux ] );
+
+				if( pxSlot->pxMutex == NULL )
+				{
+					( void ) memset( ( void * ) &( pxSlot->xProfile ), 0x00, sizeof( pxSlot->xProfile ) );
+					pxSlot->xProfile.xHandle = ( QueueHandle_t ) pxMutex;
+					pxSlot->pxMutex = pxMutex;
+					pxMutex->pxProfile = pxSlot;
+					break;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_MUTEX_PROFILING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEX_PROFILING == 1 )
+
+	static void prvProfileTaken( MutexProfileSlot_t * const pxSlot, const configRUN_TIME_COUNTER_TYPE ulWaitStart, const BaseType_t xBlocked )
+	{
+	const configRUN_TIME_COUNTER_TYPE ulNow = prvStatsNow();
+
+		/* Only the holder writes these, and only until it gives the mutex, so
+		no critical section is needed. */
+		pxSlot->ulTakeTime = ulNow;
+		pxSlot->ulHolderWaitTime = ulNow - ulWaitStart;
+		pxSlot->xHolderBlocked = xBlocked;
+	}
+
+#endif /* configUSE_MUTEX_PROFILING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEX_PROFILING == 1 )
+
+	static void prvProfileGive( Queue_t * const pxMutex )
+	{
+	const configRUN_TIME_COUNTER_TYPE ulNow = prvStatsNow();
+	const TaskHandle_t xCurrentTask = xTaskGetCurrentTaskHandle();
+	MutexProfileSlot_t * const pxSlot = pxMutex->pxProfile;
+	MutexProfileTask_t *pxEntry;
+	configRUN_TIME_COUNTER_TYPE ulWait, ulHold;
+
+		taskENTER_CRITICAL();
+		{
+			/* Only a give by the holder ends a hold - any other give fails.
+			The holder can only be read reliably inside the critical
+			section, as another task may be moving it off the fast path. */
+			if( ( xCurrentTask != NULL ) && ( prvGetMutexHolder( pxMutex ) == xCurrentTask ) )
+			{
+				ulWait = pxSlot->ulHolderWaitTime;
+				ulHold = ulNow - pxSlot->ulTakeTime;
+				pxEntry = prvProfileTaskEntry( pxSlot, xCurrentTask );
+
+				( pxEntry->ulAcquisitions )++;
+				if( pxSlot->xHolderBlocked != pdFALSE )
+				{
+					( pxEntry->ulContended )++;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				pxEntry->ulWaitTime += ulWait;
+				if( ulWait > pxEntry->ulMaxWaitTime )
+				{
+					pxEntry->ulMaxWaitTime = ulWait;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				pxEntry->ulHoldTime += ulHold;
+				if( ulHold > pxEntry->ulMaxHoldTime )
+				{
+					pxEntry->ulMaxHoldTime = ulHold;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				( pxSlot->xProfile.ulWaitHistogram[ prvProfileBucket( ulWait ) ] )++;
+				( pxSlot->xProfile.ulHoldHistogram[ prvProfileBucket( ulHold ) ] )++;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_MUTEX_PROFILING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEX_PROFILING == 1 )
+
+	static void prvProfileFailed( MutexProfileSlot_t * const pxSlot )
+	{
+	const TaskHandle_t xCurrentTask = xTaskGetCurrentTaskHandle();
+
+		taskENTER_CRITICAL();
+		{
+			( prvProfileTaskEntry( pxSlot, xCurrentTask )->ulFailures )++;
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_MUTEX_PROFILING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEX_PROFILING == 1 )
+
+	static MutexProfileTask_t *prvProfileTaskEntry( MutexProfileSlot_t * const pxSlot, const TaskHandle_t xTask )
+	{
+	UBaseType_t ux;
+	MutexProfileTask_t *pxEntry;
+
+		/* Entries are claimed in order, so the first free entry means xTask
+		has none yet.  Once all are claimed, samples from further tasks go to
+		the extra entry at the end, which has no task. */
+		for( ux = ( UBaseType_t ) 0U; ux < ( UBaseType_t ) configMUTEX_PROFILE_TASKS; ux++ )
+		{
+			pxEntry = &( pxSlot->xProfile.xTasks[ ux ] );
+
+			if( pxEntry->xTask == xTask )
+			{
+				break;
+			}
+			else if( pxEntry->xTask == NULL )
+			{
+				pxEntry->xTask = xTask;
+				break;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		return &( pxSlot->xProfile.xTasks[ ux ] );
+	}
+
+#endif /* configUSE_MUTEX_PROFILING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEX_PROFILING == 1 )
+
+	static UBaseType_t prvProfileBucket( configRUN_TIME_COUNTER_TYPE ulTime )
+	{
+	UBaseType_t uxBucket = ( UBaseType_t ) 0U;
+
+		/* Bucket 0 counts times below 2^configMUTEX_PROFILE_BUCKET_SHIFT, and
+		each bucket after it times up to twice as long as the one before.  The
+		last bucket also counts anything longer. */
+		ulTime >>= configMUTEX_PROFILE_BUCKET_SHIFT;
+
+		while( ( ulTime != 0U ) && ( uxBucket < ( ( UBaseType_t ) configMUTEX_PROFILE_BUCKETS - ( UBaseType_t ) 1U ) ) )
+		{
+			ulTime >>= 1;
+			uxBucket++;
+		}
+
+		return uxBucket;
+	}
+
+#endif /* configUSE_MUTEX_PROFILING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEX_PROFILING == 1 )
+
+	BaseType_t xQueueGetMutexProfile( QueueHandle_t xMutex, MutexProfile_t * const pxProfile )
+	{
+	Queue_t * const pxMutex = xMutex;
+	BaseType_t xReturn = pdFAIL;
+
+		configASSERT( pxMutex );
+		configASSERT( pxProfile );
+
+		taskENTER_CRITICAL();
+		{
+			if( pxMutex->pxProfile != NULL )
+			{
+				*pxProfile = pxMutex->pxProfile->xProfile;
+				xReturn = pdPASS;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		#if ( configQUEUE_REGISTRY_SIZE > 0 )
+		{
+			if( xReturn != pdFAIL )
+			{
+				pxProfile->pcMutexName = pcQueueGetName( xMutex );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif
+
+		return xReturn;
+	}
+
+#endif /* configUSE_MUTEX_PROFILING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEX_PROFILING == 1 )
+
+	UBaseType_t uxQueueGetMutexProfiles( MutexProfile_t * const pxProfileArray, const UBaseType_t uxArraySize )
+	{
+	UBaseType_t ux, uxCount = 0;
+	const MutexProfileSlot_t *pxSlot;
+
+		configASSERT( !( ( pxProfileArray == NULL ) && ( uxArraySize != ( UBaseType_t ) 0U ) ) );
+
+		/* As uxQueueGetRegistryStats(), each profile is copied in its own
+		critical section.  vQueueDelete() frees the slot of a mutex inside a
+		critical section, so a slot in use when it is checked here stays
+		valid until the copy is made. */
+		for( ux = ( UBaseType_t ) 0U; ( ux < ( UBaseType_t ) configMUTEX_PROFILE_COUNT ) && ( uxCount < uxArraySize ); ux++ )
+		{
+			pxSlot = &( xMutexProfiles[ ux ] );
+
+			taskENTER_CRITICAL();
+			{
+				if( pxSlot->pxMutex != NULL )
+				{
+					pxProfileArray[ uxCount ] = pxSlot->xProfile;
+
+					#if ( configQUEUE_REGISTRY_SIZE > 0 )
+					{
+						pxProfileArray[ uxCount ].pcMutexName = pcQueueGetName( pxSlot->xProfile.xHandle );
+					}
+					#endif
+
+					uxCount++;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			taskEXIT_CRITICAL();
+		}
+
+		return uxCount;
+	}
+
+#endif /* configUSE_MUTEX_PROFILING */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_TIMERS == 1 )
 
 	void vQueueWaitForMessageRestricted( QueueHandle_t xQueue, TickType_t xTicksToWait, const BaseType_t xWaitIndefinitely )
@@ -0,0 +1,477 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "rwlock.h"
+
+#if( configUSE_MUTEXES != 1 )
+	#error configUSE_MUTEXES must be set to 1 to build rwlock.c
+#endif
+
+/* Lint e961, e750 and e9021 are suppressed as a MISRA exception justified
+because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+for the header files above, but not in this file, in order to generate the
+correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021 See comment above. */
+
+/* A waiting writer is counted in uxWritersWaiting from the time it first
+blocks until it takes the lock or gives up, including the time between being
+woken and running again when it is no longer in xWritersWaiting.  Readers test
+the count rather than the list so they cannot slip in during that time. */
+typedef struct RwLockDef_t
+{
+	TaskHandle_t xWriter;						/*< The task holding the lock for writing, or NULL. */
+	UBaseType_t uxReaders;						/*< The number of tasks holding the lock for reading. */
+	UBaseType_t uxWritersWaiting;				/*< Writers that have blocked and not yet taken the lock or given up. */
+	List_t xReadersWaiting;						/*< Tasks blocked in xRwLockTakeRead(), in priority order. */
+	List_t xWritersWaiting;						/*< Tasks blocked in xRwLockTakeWrite(), in priority order. */
+} RwLock_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The body of xRwLockTakeRead() and xRwLockTakeWrite().
+ */
+static BaseType_t prvRwLockTake( RwLock_t * const pxRwLock, const BaseType_t xWrite, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by a task whose block time expired before it took the lock.  If the
+ * lock is held for writing the writer's priority is lowered to that of the
+ * highest priority task still waiting, as when a mutex take times out.
+ */
+static void prvRwLockTimedOut( RwLock_t * const pxRwLock, const BaseType_t xWasCounted ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblocks the highest priority task on pxList, or every task on pxList.  The
+ * tasks are removed as from an unordered event list, which is done with the
+ * scheduler suspended rather than in a critical section, so each woken task
+ * resets its event list item value before waiting again.
+ */
+static void prvWakeFirst( List_t * const pxList ) PRIVILEGED_FUNCTION;
+static void prvWakeAll( List_t * const pxList ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	RwLockHandle_t xRwLockCreate( void )
+	{
+	RwLock_t *pxRwLock;
+
+		pxRwLock = ( RwLock_t * ) pvPortMalloc( sizeof( RwLock_t ) );
+
+		if( pxRwLock != NULL )
+		{
+			pxRwLock->xWriter = NULL;
+			pxRwLock->uxReaders = ( UBaseType_t ) 0;
+			pxRwLock->uxWritersWaiting = ( UBaseType_t ) 0;
+			vListInitialise( &( pxRwLock->xReadersWaiting ) );
+			vListInitialise( &( pxRwLock->xWritersWaiting ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pxRwLock;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+void vRwLockDelete( RwLockHandle_t xRwLock )
+{
+RwLock_t * const pxRwLock = xRwLock;
+
+	configASSERT( pxRwLock );
+	configASSERT( pxRwLock->xWriter == NULL );
+	configASSERT( pxRwLock->uxReaders == ( UBaseType_t ) 0 );
+	configASSERT( pxRwLock->uxWritersWaiting == ( UBaseType_t ) 0 );
+	configASSERT( listCURRENT_LIST_LENGTH( &( pxRwLock->xReadersWaiting ) ) == ( UBaseType_t ) 0 );
+
+	vPortFree( pxRwLock );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xRwLockTakeRead( RwLockHandle_t xRwLock, TickType_t xTicksToWait )
+{
+	configASSERT( xRwLock );
+	return prvRwLockTake( xRwLock, pdFALSE, xTicksToWait );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xRwLockTakeWrite( RwLockHandle_t xRwLock, TickType_t xTicksToWait )
+{
+	configASSERT( xRwLock );
+	return prvRwLockTake( xRwLock, pdTRUE, xTicksToWait );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xRwLockGiveRead( RwLockHandle_t xRwLock )
+{
+RwLock_t * const pxRwLock = xRwLock;
+BaseType_t xReturn = pdFAIL;
+
+	configASSERT( pxRwLock );
+
+	vTaskSuspendAll();
+	{
+		if( pxRwLock->uxReaders != ( UBaseType_t ) 0 )
+		{
+			( pxRwLock->uxReaders )--;
+			xReturn = pdPASS;
+
+			/* Readers only wait while a writer holds or is waiting for the
+			lock, so when the last reader leaves only a writer can be waiting
+			for it. */
+			if( pxRwLock->uxReaders == ( UBaseType_t ) 0 )
+			{
+				prvWakeFirst( &( pxRwLock->xWritersWaiting ) );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	( void ) xTaskResumeAll();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xRwLockGiveWrite( RwLockHandle_t xRwLock )
+{
+RwLock_t * const pxRwLock = xRwLock;
+BaseType_t xReturn = pdFAIL, xYieldRequired = pdFALSE;
+
+	configASSERT( pxRwLock );
+
+	vTaskSuspendAll();
+	{
+		if( pxRwLock->xWriter == xTaskGetCurrentTaskHandle() )
+		{
+			pxRwLock->xWriter = NULL;
+			xReturn = pdPASS;
+
+			/* Return to the base priority if one was inherited, as on giving
+			a mutex.  Done in a critical section as in queue.c. */
+			taskENTER_CRITICAL();
+			{
+				xYieldRequired = xTaskPriorityDisinherit( xTaskGetCurrentTaskHandle() );
+			}
+			taskEXIT_CRITICAL();
+
+			if( listLIST_IS_EMPTY( &( pxRwLock->xWritersWaiting ) ) == pdFALSE )
+			{
+				prvWakeFirst( &( pxRwLock->xWritersWaiting ) );
+			}
+			else if( pxRwLock->uxWritersWaiting == ( UBaseType_t ) 0 )
+			{
+				prvWakeAll( &( pxRwLock->xReadersWaiting ) );
+			}
+			else
+			{
+				/* A writer has already been woken but has not yet run.  It
+				wakes the readers when it gives the lock. */
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	if( xTaskResumeAll() == pdFALSE )
+	{
+		if( xYieldRequired != pdFALSE )
+		{
+			portYIELD_WITHIN_API();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+TaskHandle_t xRwLockGetWriter( RwLockHandle_t xRwLock )
+{
+	configASSERT( xRwLock );
+	return xRwLock->xWriter;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxRwLockGetReaderCount( RwLockHandle_t xRwLock )
+{
+	configASSERT( xRwLock );
+	return xRwLock->uxReaders;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvRwLockTake( RwLock_t * const pxRwLock, const BaseType_t xWrite, TickType_t xTicksToWait )
+{
+BaseType_t xReturn = pdFAIL, xBlocked, xEntryTimeSet = pdFALSE, xCounted = pdFALSE, xAlreadyYielded, xAvailable;
+TimeOut_t xTimeOut;
+TaskHandle_t xCurrentTask;
+List_t * const pxWaitList = ( xWrite != pdFALSE ) ? &( pxRwLock->xWritersWaiting ) : &( pxRwLock->xReadersWaiting );
+
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
+
+	xCurrentTask = xTaskGetCurrentTaskHandle();
+
+	for( ;; )
+	{
+		xBlocked = pdFALSE;
+
+		vTaskSuspendAll();
+		{
+			if( pxRwLock->xWriter == xCurrentTask )
+			{
+				/* Waiting for the lock this task holds would never end. */
+				xTicksToWait = ( TickType_t ) 0;
+				xAvailable = pdFALSE;
+			}
+			else if( xWrite != pdFALSE )
+			{
+				xAvailable = ( ( pxRwLock->xWriter == NULL ) && ( pxRwLock->uxReaders == ( UBaseType_t ) 0 ) ) ? pdTRUE : pdFALSE;
+			}
+			else
+			{
+				xAvailable = ( ( pxRwLock->xWriter == NULL ) && ( pxRwLock->uxWritersWaiting == ( UBaseType_t ) 0 ) ) ? pdTRUE : pdFALSE;
+			}
+
+			if( xAvailable != pdFALSE )
+			{
+				if( xWrite != pdFALSE )
+				{
+					/* Count the lock as a mutex held by this task so
+					xTaskPriorityDisinherit() restores its priority only when
+					it has given up all of them. */
+					pxRwLock->xWriter = pvTaskIncrementMutexHeldCount();
+
+					if( xCounted != pdFALSE )
+					{
+						( pxRwLock->uxWritersWaiting )--;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					( pxRwLock->uxReaders )++;
+				}
+
+				xReturn = pdPASS;
+			}
+			else if( xTicksToWait != ( TickType_t ) 0 )
+			{
+				if( xEntryTimeSet == pdFALSE )
+				{
+					vTaskInternalSetTimeOutState( &xTimeOut );
+					xEntryTimeSet = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+				{
+					if( ( xWrite != pdFALSE ) && ( xCounted == pdFALSE ) )
+					{
+						( pxRwLock->uxWritersWaiting )++;
+						xCounted = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					if( pxRwLock->xWriter != NULL )
+					{
+						taskENTER_CRITICAL();
+						{
+							( void ) xTaskPriorityInherit( pxRwLock->xWriter );
+						}
+						taskEXIT_CRITICAL();
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					vTaskPlaceOnEventList( pxWaitList, xTicksToWait );
+					xBlocked = pdTRUE;
+				}
+				else
+				{
+					prvRwLockTimedOut( pxRwLock, xCounted );
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		xAlreadyYielded = xTaskResumeAll();
+
+		if( xBlocked == pdFALSE )
+		{
+			break;
+		}
+
+		if( xAlreadyYielded == pdFALSE )
+		{
+			portYIELD_WITHIN_API();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* Woken by a give, or the block time expired.  Either way restore the
+		event list item value used to order the waiting tasks, then try
+		again. */
+		( void ) uxTaskResetEventItemValue();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRwLockTimedOut( RwLock_t * const pxRwLock, const BaseType_t xWasCounted )
+{
+UBaseType_t uxHighestPriority = tskIDLE_PRIORITY, uxPriority;
+
+	if( xWasCounted != pdFALSE )
+	{
+		( pxRwLock->uxWritersWaiting )--;
+
+		/* Readers may have been waiting only because this writer was. */
+		if( ( pxRwLock->uxWritersWaiting == ( UBaseType_t ) 0 ) && ( pxRwLock->xWriter == NULL ) )
+		{
+			prvWakeAll( &( pxRwLock->xReadersWaiting ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( pxRwLock->xWriter != NULL )
+	{
+		/* The lists are in priority order, so only their heads need
+		looking at. */
+		if( listLIST_IS_EMPTY( &( pxRwLock->xReadersWaiting ) ) == pdFALSE )
+		{
+			uxHighestPriority = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxRwLock->xReadersWaiting ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( listLIST_IS_EMPTY( &( pxRwLock->xWritersWaiting ) ) == pdFALSE )
+		{
+			uxPriority = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxRwLock->xWritersWaiting ) );
+
+			if( uxPriority > uxHighestPriority )
+			{
+				uxHighestPriority = uxPriority;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		taskENTER_CRITICAL();
+		{
+			vTaskPriorityDisinheritAfterTimeout( pxRwLock->xWriter, uxHighestPriority );
+		}
+		taskEXIT_CRITICAL();
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvWakeFirst( List_t * const pxList )
+{
+	if( listLIST_IS_EMPTY( pxList ) == pdFALSE )
+	{
+		vTaskRemoveFromUnorderedEventList( listGET_HEAD_ENTRY( pxList ), ( TickType_t ) 0 );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvWakeAll( List_t * const pxList )
+{
+	while( listLIST_IS_EMPTY( pxList ) == pdFALSE )
+	{
+		vTaskRemoveFromUnorderedEventList( listGET_HEAD_ENTRY( pxList ), ( TickType_t ) 0 );
+	}
+}
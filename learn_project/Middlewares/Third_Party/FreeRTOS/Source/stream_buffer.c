@@ -134,6 +134,26 @@ that uses task notifications. */
 /* Bits stored in the ucFlags field of the stream buffer. */
 #define sbFLAGS_IS_MESSAGE_BUFFER		( ( uint8_t ) 1 ) /* Set if the stream buffer was created as a message buffer, in which case it holds discrete messages rather than a stream. */
 #define sbFLAGS_IS_STATICALLY_ALLOCATED ( ( uint8_t ) 2 ) /* Set if the stream buffer was created using statically allocated memory. */
+#define sbFLAGS_IS_MULTI_PRODUCER		( ( uint8_t ) 4 ) /* Set if the stream buffer was created for several writers, which claim space with xClaimState. */
+
+#if( configUSE_STREAM_BUFFER_MULTI_PRODUCER == 1 )
+
+	#ifndef portCOMPARE_AND_SWAP_POINTER
+		#error configUSE_STREAM_BUFFER_MULTI_PRODUCER requires the port to define portCOMPARE_AND_SWAP_POINTER().
+	#endif
+
+	/* xClaimState holds the index of the next byte a writer can claim in its
+	low bits, and the number of writers that have claimed space but not yet
+	published it in its top 8 bits.  Keeping both in one word lets a writer
+	claim space and count itself in with a single compare and swap. */
+	#define sbCLAIM_COUNT_SHIFT		( ( sizeof( size_t ) * ( size_t ) 8 ) - ( size_t ) 8 )
+	#define sbCLAIM_INDEX_MASK		( ( ( size_t ) 1 << sbCLAIM_COUNT_SHIFT ) - ( size_t ) 1 )
+	#define sbCLAIM_ONE_WRITER		( ( size_t ) 1 << sbCLAIM_COUNT_SHIFT )
+
+	#define sbCLAIMS_OPEN( pxStreamBuffer ) ( ( ( pxStreamBuffer )->xClaimState >= sbCLAIM_ONE_WRITER ) ? pdTRUE : pdFALSE )
+#else
+	#define sbCLAIMS_OPEN( pxStreamBuffer ) pdFALSE
+#endif
 
 /*-----------------------------------------------------------*/
 
@@ -152,6 +172,15 @@ typedef struct StreamBufferDef_t /*lint !e9058 Style convention uses tag. */
 	#if ( configUSE_TRACE_FACILITY == 1 )
 		UBaseType_t uxStreamBufferNumber;		/* Used for tracing purposes. */
 	#endif
+
+	#if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+		size_t xReservedBytes;				/* The number of bytes handed to the writer by xStreamBufferReserve() and not yet committed. */
+		size_t xAcquiredBytes;				/* The number of bytes handed to the reader by xStreamBufferAcquire() and not yet released. */
+	#endif
+
+	#if ( configUSE_STREAM_BUFFER_MULTI_PRODUCER == 1 )
+		volatile size_t xClaimState;		/* The next index to claim and the number of open claims of a multi-producer buffer, see sbCLAIM_COUNT_SHIFT.  xHead only moves when the last open claim is published. */
+	#endif
 } StreamBuffer_t;
 
 /*
@@ -212,6 +241,83 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
 										  size_t xTriggerLevelBytes,
 										  uint8_t ucFlags ) PRIVILEGED_FUNCTION;
 
+#if( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+	/*
+	 * Describe the xCount bytes of the buffer storage starting at index xStart
+	 * in *pxRegion, split in two if they run past the end of the storage.
+	 */
+	static void prvGetRegion( const StreamBuffer_t * const pxStreamBuffer,
+							  size_t xStart,
+							  size_t xCount,
+							  StreamBufferRegion_t * const pxRegion ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * The parts of xStreamBufferReserve() and xStreamBufferReserveFromISR()
+	 * that run once xSpace bytes are known to be free.
+	 */
+	static size_t prvReserveRegion( StreamBuffer_t * const pxStreamBuffer,
+									StreamBufferRegion_t * const pxRegion,
+									size_t xBytesWanted,
+									size_t xSpace ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Make xBytes of the reserved region visible to the reader, writing the
+	 * length of the message first if this is a message buffer.
+	 */
+	static size_t prvCommitRegion( StreamBuffer_t * const pxStreamBuffer, size_t xBytes ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * The parts of xStreamBufferAcquire() and xStreamBufferAcquireFromISR()
+	 * that run once xBytesAvailable bytes are known to be in the buffer.
+	 */
+	static size_t prvAcquireRegion( StreamBuffer_t * const pxStreamBuffer,
+									StreamBufferRegion_t * const pxRegion,
+									size_t xBytesAvailable,
+									size_t xBytesToStoreMessageLength ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Remove xBytes of the acquired region from the buffer, or the whole
+	 * acquired message if this is a message buffer.
+	 */
+	static size_t prvReleaseRegion( StreamBuffer_t * const pxStreamBuffer, size_t xBytes ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+
+#if( configUSE_STREAM_BUFFER_MULTI_PRODUCER == 1 )
+
+	/*
+	 * Claim space for xDataLengthBytes bytes of a multi-producer buffer without
+	 * a critical section, writing the message length first if it is a message
+	 * buffer.  A stream buffer claims what it can if xAllowPartial is pdTRUE.
+	 * Returns the number of bytes claimed, described by *pxRegion.
+	 */
+	static size_t prvClaimSpace( StreamBuffer_t * const pxStreamBuffer,
+								 size_t xDataLengthBytes,
+								 BaseType_t xAllowPartial,
+								 StreamBufferRegion_t * const pxRegion ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Close one claim, and if no other claim is open move the head over
+	 * everything claimed so far and notify the reader.  Returns pdTRUE if the
+	 * head moved.
+	 */
+	static BaseType_t prvPublish( StreamBuffer_t * const pxStreamBuffer,
+								  BaseType_t xFromISR,
+								  BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * xStreamBufferSend() and xStreamBufferSendFromISR() for a multi-producer
+	 * buffer: claim, copy in outside any critical section, publish.
+	 */
+	static size_t prvSendMultiProducer( StreamBuffer_t * const pxStreamBuffer,
+										const void *pvTxData,
+										size_t xDataLengthBytes,
+										BaseType_t xFromISR,
+										BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_STREAM_BUFFER_MULTI_PRODUCER */
+
 /*-----------------------------------------------------------*/
 
 #if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
@@ -221,6 +327,13 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
 	uint8_t *pucAllocatedMemory;
 	uint8_t ucFlags;
 
+		#if( configUSE_STREAM_BUFFER_MULTI_PRODUCER == 1 )
+		BaseType_t xIsMultiProducer = xIsMessageBuffer & sbTYPE_MULTI_PRODUCER;
+
+			/* The rest of the function only expects pdTRUE or pdFALSE. */
+			xIsMessageBuffer &= ~sbTYPE_MULTI_PRODUCER;
+		#endif
+
 		/* In case the stream buffer is going to be used as a message buffer
 		(that is, it will hold discrete messages with a little meta data that
 		says how big the next message is) check the buffer will be large enough
@@ -255,6 +368,22 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
 		space would be reported as one byte smaller than would be logically
 		expected. */
 		xBufferSizeBytes++;
+
+		#if( configUSE_STREAM_BUFFER_MULTI_PRODUCER == 1 )
+		{
+			if( xIsMultiProducer != pdFALSE )
+			{
+				/* Every index must fit below the claim count in xClaimState. */
+				configASSERT( xBufferSizeBytes <= sbCLAIM_INDEX_MASK );
+				ucFlags |= sbFLAGS_IS_MULTI_PRODUCER;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif
+
 		pucAllocatedMemory = ( uint8_t * ) pvPortMalloc( xBufferSizeBytes + sizeof( StreamBuffer_t ) ); /*lint !e9079 malloc() only returns void*. */
 
 		if( pucAllocatedMemory != NULL )
@@ -290,6 +419,13 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
 	StreamBufferHandle_t xReturn;
 	uint8_t ucFlags;
 
+		#if( configUSE_STREAM_BUFFER_MULTI_PRODUCER == 1 )
+		BaseType_t xIsMultiProducer = xIsMessageBuffer & sbTYPE_MULTI_PRODUCER;
+
+			/* The rest of the function only expects pdTRUE or pdFALSE. */
+			xIsMessageBuffer &= ~sbTYPE_MULTI_PRODUCER;
+		#endif
+
 		configASSERT( pucStreamBufferStorageArea );
 		configASSERT( pxStaticStreamBuffer );
 		configASSERT( xTriggerLevelBytes <= xBufferSizeBytes );
@@ -312,6 +448,21 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
 			ucFlags = sbFLAGS_IS_STATICALLY_ALLOCATED;
 		}
 
+		#if( configUSE_STREAM_BUFFER_MULTI_PRODUCER == 1 )
+		{
+			if( xIsMultiProducer != pdFALSE )
+			{
+				/* Every index must fit below the claim count in xClaimState. */
+				configASSERT( xBufferSizeBytes <= sbCLAIM_INDEX_MASK );
+				ucFlags |= sbFLAGS_IS_MULTI_PRODUCER;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif
+
 		/* In case the stream buffer is going to be used as a message buffer
 		(that is, it will hold discrete messages with a little meta data that
 		says how big the next message is) check the buffer will be large enough
@@ -408,12 +559,13 @@ BaseType_t xReturn = pdFAIL;
 	}
 	#endif
 
-	/* Can only reset a message buffer if there are no tasks blocked on it. */
+	/* Can only reset a message buffer if there are no tasks blocked on it, and
+	no writer is part way through filling space it has claimed. */
 	taskENTER_CRITICAL();
 	{
 		if( pxStreamBuffer->xTaskWaitingToReceive == NULL )
 		{
-			if( pxStreamBuffer->xTaskWaitingToSend == NULL )
+			if( ( pxStreamBuffer->xTaskWaitingToSend == NULL ) && ( sbCLAIMS_OPEN( pxStreamBuffer ) == pdFALSE ) )
 			{
 				prvInitialiseNewStreamBuffer( pxStreamBuffer,
 											  pxStreamBuffer->pucBuffer,
@@ -475,7 +627,25 @@ size_t xSpace;
 	configASSERT( pxStreamBuffer );
 
 	xSpace = pxStreamBuffer->xLength + pxStreamBuffer->xTail;
-	xSpace -= pxStreamBuffer->xHead;
+
+	#if( configUSE_STREAM_BUFFER_MULTI_PRODUCER == 1 )
+	{
+		/* Space claimed by a writer is not free, even before it is published. */
+		if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MULTI_PRODUCER ) != ( uint8_t ) 0 )
+		{
+			xSpace -= ( pxStreamBuffer->xClaimState & sbCLAIM_INDEX_MASK );
+		}
+		else
+		{
+			xSpace -= pxStreamBuffer->xHead;
+		}
+	}
+	#else
+	{
+		xSpace -= pxStreamBuffer->xHead;
+	}
+	#endif
+
 	xSpace -= ( size_t ) 1;
 
 	if( xSpace >= pxStreamBuffer->xLength )
@@ -516,6 +686,32 @@ TimeOut_t xTimeOut;
 	configASSERT( pvTxData );
 	configASSERT( pxStreamBuffer );
 
+	#if( configUSE_STREAM_BUFFER_MULTI_PRODUCER == 1 )
+	{
+		/* Writers to a multi-producer buffer never block, as they cannot all
+		wait in xTaskWaitingToSend. */
+		if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MULTI_PRODUCER ) != ( uint8_t ) 0 )
+		{
+			xReturn = prvSendMultiProducer( pxStreamBuffer, pvTxData, xDataLengthBytes, pdFALSE, NULL );
+
+			if( xReturn > ( size_t ) 0 )
+			{
+				traceSTREAM_BUFFER_SEND( xStreamBuffer, xReturn );
+			}
+			else
+			{
+				traceSTREAM_BUFFER_SEND_FAILED( xStreamBuffer );
+			}
+
+			return xReturn;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif
+
 	/* This send function is used to write to both message buffers and stream
 	buffers.  If this is a message buffer then the space needed must be
 	increased by the amount of bytes needed to store the length of the
@@ -619,6 +815,22 @@ size_t xRequiredSpace = xDataLengthBytes;
 	configASSERT( pvTxData );
 	configASSERT( pxStreamBuffer );
 
+	#if( configUSE_STREAM_BUFFER_MULTI_PRODUCER == 1 )
+	{
+		if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MULTI_PRODUCER ) != ( uint8_t ) 0 )
+		{
+			xReturn = prvSendMultiProducer( pxStreamBuffer, pvTxData, xDataLengthBytes, pdTRUE, pxHigherPriorityTaskWoken );
+			traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xReturn );
+
+			return xReturn;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif
+
 	/* This send function is used to write to both message buffers and stream
 	buffers.  If this is a message buffer then the space needed must be
 	increased by the amount of bytes needed to store the length of the
@@ -1085,6 +1297,902 @@ UBaseType_t uxSavedInterruptStatus;
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+	size_t xStreamBufferReserve( StreamBufferHandle_t xStreamBuffer,
+								 StreamBufferRegion_t * const pxRegion,
+								 size_t xBytesWanted,
+								 TickType_t xTicksToWait )
+	{
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+	size_t xReturn, xSpace = 0;
+	size_t xRequiredSpace = xBytesWanted;
+	TimeOut_t xTimeOut;
+
+		configASSERT( pxRegion );
+		configASSERT( pxStreamBuffer );
+		configASSERT( xBytesWanted > ( size_t ) 0 );
+
+		/* Only one region can be reserved at a time.  Writers to a
+		multi-producer buffer use xStreamBufferClaim() instead. */
+		configASSERT( pxStreamBuffer->xReservedBytes == ( size_t ) 0 );
+		configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MULTI_PRODUCER ) == ( uint8_t ) 0 );
+
+		if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+		{
+			xRequiredSpace += sbBYTES_TO_STORE_MESSAGE_LENGTH;
+
+			/* Overflow? */
+			configASSERT( xRequiredSpace > xBytesWanted );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( xTicksToWait != ( TickType_t ) 0 )
+		{
+			vTaskSetTimeOutState( &xTimeOut );
+
+			do
+			{
+				/* Wait until the required number of bytes are free, exactly as
+				xStreamBufferSend() does. */
+				taskENTER_CRITICAL();
+				{
+					xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+
+					if( xSpace < xRequiredSpace )
+					{
+						/* Clear notification state as going to wait for space. */
+						( void ) xTaskNotifyStateClear( NULL );
+
+						/* Should only be one writer. */
+						configASSERT( pxStreamBuffer->xTaskWaitingToSend == NULL );
+						pxStreamBuffer->xTaskWaitingToSend = xTaskGetCurrentTaskHandle();
+					}
+					else
+					{
+						taskEXIT_CRITICAL();
+						break;
+					}
+				}
+				taskEXIT_CRITICAL();
+
+				traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer );
+				( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+				pxStreamBuffer->xTaskWaitingToSend = NULL;
+
+			} while( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( xSpace == ( size_t ) 0 )
+		{
+			xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		xReturn = prvReserveRegion( pxStreamBuffer, pxRegion, xBytesWanted, xSpace );
+
+		if( xReturn == ( size_t ) 0 )
+		{
+			traceSTREAM_BUFFER_SEND_FAILED( xStreamBuffer );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+	size_t xStreamBufferReserveFromISR( StreamBufferHandle_t xStreamBuffer,
+										StreamBufferRegion_t * const pxRegion,
+										size_t xBytesWanted )
+	{
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+		configASSERT( pxRegion );
+		configASSERT( pxStreamBuffer );
+		configASSERT( xBytesWanted > ( size_t ) 0 );
+		configASSERT( pxStreamBuffer->xReservedBytes == ( size_t ) 0 );
+		configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MULTI_PRODUCER ) == ( uint8_t ) 0 );
+
+		return prvReserveRegion( pxStreamBuffer, pxRegion, xBytesWanted, xStreamBufferSpacesAvailable( pxStreamBuffer ) );
+	}
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+	size_t xStreamBufferCommit( StreamBufferHandle_t xStreamBuffer, size_t xBytes )
+	{
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+	size_t xReturn;
+
+		configASSERT( pxStreamBuffer );
+
+		xReturn = prvCommitRegion( pxStreamBuffer, xBytes );
+
+		if( xReturn > ( size_t ) 0 )
+		{
+			traceSTREAM_BUFFER_SEND( xStreamBuffer, xReturn );
+
+			/* Was a task waiting for the data? */
+			if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+			{
+				sbSEND_COMPLETED( pxStreamBuffer );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+	size_t xStreamBufferCommitFromISR( StreamBufferHandle_t xStreamBuffer,
+									   size_t xBytes,
+									   BaseType_t * const pxHigherPriorityTaskWoken )
+	{
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+	size_t xReturn;
+
+		configASSERT( pxStreamBuffer );
+
+		xReturn = prvCommitRegion( pxStreamBuffer, xBytes );
+
+		if( xReturn > ( size_t ) 0 )
+		{
+			/* Was a task waiting for the data? */
+			if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+			{
+				sbSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xReturn );
+
+		return xReturn;
+	}
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+	size_t xStreamBufferAcquire( StreamBufferHandle_t xStreamBuffer,
+								 StreamBufferRegion_t * const pxRegion,
+								 TickType_t xTicksToWait )
+	{
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+	size_t xReturn, xBytesAvailable, xBytesToStoreMessageLength;
+
+		configASSERT( pxRegion );
+		configASSERT( pxStreamBuffer );
+
+		/* Only one region can be acquired at a time. */
+		configASSERT( pxStreamBuffer->xAcquiredBytes == ( size_t ) 0 );
+
+		if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+		{
+			xBytesToStoreMessageLength = sbBYTES_TO_STORE_MESSAGE_LENGTH;
+		}
+		else
+		{
+			xBytesToStoreMessageLength = 0;
+		}
+
+		if( xTicksToWait != ( TickType_t ) 0 )
+		{
+			/* Checking if there is data and clearing the notification state
+			must be performed atomically, as in xStreamBufferReceive(). */
+			taskENTER_CRITICAL();
+			{
+				xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+				if( xBytesAvailable <= xBytesToStoreMessageLength )
+				{
+					/* Clear notification state as going to wait for data. */
+					( void ) xTaskNotifyStateClear( NULL );
+
+					/* Should only be one reader. */
+					configASSERT( pxStreamBuffer->xTaskWaitingToReceive == NULL );
+					pxStreamBuffer->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			if( xBytesAvailable <= xBytesToStoreMessageLength )
+			{
+				/* Wait for the trigger level to be reached. */
+				traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer );
+				( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+				pxStreamBuffer->xTaskWaitingToReceive = NULL;
+
+				/* Recheck the data available after blocking. */
+				xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+		}
+
+		xReturn = prvAcquireRegion( pxStreamBuffer, pxRegion, xBytesAvailable, xBytesToStoreMessageLength );
+
+		if( xReturn == ( size_t ) 0 )
+		{
+			traceSTREAM_BUFFER_RECEIVE_FAILED( xStreamBuffer );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+	size_t xStreamBufferAcquireFromISR( StreamBufferHandle_t xStreamBuffer,
+										StreamBufferRegion_t * const pxRegion )
+	{
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+	size_t xBytesToStoreMessageLength;
+
+		configASSERT( pxRegion );
+		configASSERT( pxStreamBuffer );
+		configASSERT( pxStreamBuffer->xAcquiredBytes == ( size_t ) 0 );
+
+		if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+		{
+			xBytesToStoreMessageLength = sbBYTES_TO_STORE_MESSAGE_LENGTH;
+		}
+		else
+		{
+			xBytesToStoreMessageLength = 0;
+		}
+
+		return prvAcquireRegion( pxStreamBuffer, pxRegion, prvBytesInBuffer( pxStreamBuffer ), xBytesToStoreMessageLength );
+	}
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+	size_t xStreamBufferRelease( StreamBufferHandle_t xStreamBuffer, size_t xBytes )
+	{
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+	size_t xReturn;
+
+		configASSERT( pxStreamBuffer );
+
+		xReturn = prvReleaseRegion( pxStreamBuffer, xBytes );
+
+		/* Was a task waiting for space in the buffer? */
+		if( xReturn != ( size_t ) 0 )
+		{
+			traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReturn );
+			sbRECEIVE_COMPLETED( pxStreamBuffer );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+	size_t xStreamBufferReleaseFromISR( StreamBufferHandle_t xStreamBuffer,
+										size_t xBytes,
+										BaseType_t * const pxHigherPriorityTaskWoken )
+	{
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+	size_t xReturn;
+
+		configASSERT( pxStreamBuffer );
+
+		xReturn = prvReleaseRegion( pxStreamBuffer, xBytes );
+
+		/* Was a task waiting for space in the buffer? */
+		if( xReturn != ( size_t ) 0 )
+		{
+			sbRECEIVE_COMPLETED_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xReturn );
+
+		return xReturn;
+	}
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+	static void prvGetRegion( const StreamBuffer_t * const pxStreamBuffer,
+							  size_t xStart,
+							  size_t xCount,
+							  StreamBufferRegion_t * const pxRegion )
+	{
+		/* The first part runs from xStart to the end of the storage at most. */
+		pxRegion->pucFirst = &( pxStreamBuffer->pucBuffer[ xStart ] );
+		pxRegion->xFirstLength = configMIN( pxStreamBuffer->xLength - xStart, xCount );
+
+		/* Anything left over wraps back to the start of the storage. */
+		if( xCount > pxRegion->xFirstLength )
+		{
+			pxRegion->pucSecond = pxStreamBuffer->pucBuffer;
+			pxRegion->xSecondLength = xCount - pxRegion->xFirstLength;
+		}
+		else
+		{
+			pxRegion->pucSecond = NULL;
+			pxRegion->xSecondLength = 0;
+		}
+	}
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+	static size_t prvReserveRegion( StreamBuffer_t * const pxStreamBuffer,
+									StreamBufferRegion_t * const pxRegion,
+									size_t xBytesWanted,
+									size_t xSpace )
+	{
+	size_t xReturn, xStart;
+
+		xStart = pxStreamBuffer->xHead;
+
+		if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) == ( uint8_t ) 0 )
+		{
+			/* A stream buffer hands out all the free space, which may be more
+			or less than was wanted. */
+			xReturn = xSpace;
+		}
+		else if( xSpace >= ( xBytesWanted + sbBYTES_TO_STORE_MESSAGE_LENGTH ) )
+		{
+			/* A message buffer hands out exactly the message, leaving room in
+			front of it for the length that xStreamBufferCommit() writes. */
+			xReturn = xBytesWanted;
+			xStart += sbBYTES_TO_STORE_MESSAGE_LENGTH;
+
+			if( xStart >= pxStreamBuffer->xLength )
+			{
+				xStart -= pxStreamBuffer->xLength;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			/* There is space available, but not enough for the message. */
+			xReturn = 0;
+		}
+
+		prvGetRegion( pxStreamBuffer, xStart, xReturn, pxRegion );
+		pxStreamBuffer->xReservedBytes = xReturn;
+
+		return xReturn;
+	}
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+	static size_t prvCommitRegion( StreamBuffer_t * const pxStreamBuffer, size_t xBytes )
+	{
+	size_t xNextHead;
+	configMESSAGE_BUFFER_LENGTH_TYPE xTempLength;
+
+		/* Cannot commit more than was reserved. */
+		configASSERT( xBytes <= pxStreamBuffer->xReservedBytes );
+
+		if( xBytes > ( size_t ) 0 )
+		{
+			if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+			{
+				/* The data is already in place after the length, so only the
+				length has to be copied in.  This moves the head past it. */
+				xTempLength = ( configMESSAGE_BUFFER_LENGTH_TYPE ) xBytes;
+				( void ) prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) &xTempLength, sbBYTES_TO_STORE_MESSAGE_LENGTH );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* Moving the head is what makes the data visible to the reader. */
+			xNextHead = pxStreamBuffer->xHead + xBytes;
+
+			if( xNextHead >= pxStreamBuffer->xLength )
+			{
+				xNextHead -= pxStreamBuffer->xLength;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			pxStreamBuffer->xHead = xNextHead;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		pxStreamBuffer->xReservedBytes = 0;
+
+		return xBytes;
+	}
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+	static size_t prvAcquireRegion( StreamBuffer_t * const pxStreamBuffer,
+									StreamBufferRegion_t * const pxRegion,
+									size_t xBytesAvailable,
+									size_t xBytesToStoreMessageLength )
+	{
+	size_t xReturn, xStart, xFirstLength;
+	configMESSAGE_BUFFER_LENGTH_TYPE xTempLength;
+
+		xStart = pxStreamBuffer->xTail;
+
+		if( xBytesAvailable <= xBytesToStoreMessageLength )
+		{
+			/* Nothing to read. */
+			xReturn = 0;
+		}
+		else if( xBytesToStoreMessageLength != ( size_t ) 0 )
+		{
+			/* Copy the length of the next message out without moving the tail,
+			so the writer never sees the length bytes as free. */
+			xFirstLength = configMIN( pxStreamBuffer->xLength - xStart, xBytesToStoreMessageLength );
+			( void ) memcpy( ( void * ) &xTempLength, ( const void * ) &( pxStreamBuffer->pucBuffer[ xStart ] ), xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+
+			if( xBytesToStoreMessageLength > xFirstLength )
+			{
+				( void ) memcpy( ( void * ) &( ( ( uint8_t * ) &xTempLength )[ xFirstLength ] ), ( const void * ) pxStreamBuffer->pucBuffer, xBytesToStoreMessageLength - xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			xReturn = ( size_t ) xTempLength;
+			configASSERT( xReturn <= ( xBytesAvailable - xBytesToStoreMessageLength ) );
+
+			xStart += xBytesToStoreMessageLength;
+
+			if( xStart >= pxStreamBuffer->xLength )
+			{
+				xStart -= pxStreamBuffer->xLength;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			/* A stream buffer hands out everything that is in it. */
+			xReturn = xBytesAvailable;
+		}
+
+		prvGetRegion( pxStreamBuffer, xStart, xReturn, pxRegion );
+		pxStreamBuffer->xAcquiredBytes = xReturn;
+
+		return xReturn;
+	}
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+	static size_t prvReleaseRegion( StreamBuffer_t * const pxStreamBuffer, size_t xBytes )
+	{
+	size_t xNextTail, xCount;
+
+		if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+		{
+			/* A message is always removed whole, along with its length. */
+			xBytes = pxStreamBuffer->xAcquiredBytes;
+
+			if( xBytes > ( size_t ) 0 )
+			{
+				xCount = xBytes + sbBYTES_TO_STORE_MESSAGE_LENGTH;
+			}
+			else
+			{
+				xCount = 0;
+			}
+		}
+		else
+		{
+			/* Cannot release more than was acquired. */
+			configASSERT( xBytes <= pxStreamBuffer->xAcquiredBytes );
+			xCount = xBytes;
+		}
+
+		if( xCount > ( size_t ) 0 )
+		{
+			/* Moving the tail is what hands the space back to the writer. */
+			xNextTail = pxStreamBuffer->xTail + xCount;
+
+			if( xNextTail >= pxStreamBuffer->xLength )
+			{
+				xNextTail -= pxStreamBuffer->xLength;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			pxStreamBuffer->xTail = xNextTail;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		pxStreamBuffer->xAcquiredBytes = 0;
+
+		return xBytes;
+	}
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_STREAM_BUFFER_MULTI_PRODUCER == 1 )
+
+	size_t xStreamBufferClaim( StreamBufferHandle_t xStreamBuffer,
+							   StreamBufferRegion_t * const pxRegion,
+							   size_t xDataLengthBytes )
+	{
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+	size_t xReturn;
+
+		configASSERT( pxRegion );
+		configASSERT( pxStreamBuffer );
+		configASSERT( xDataLengthBytes > ( size_t ) 0 );
+		configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MULTI_PRODUCER ) != ( uint8_t ) 0 );
+
+		xReturn = prvClaimSpace( pxStreamBuffer, xDataLengthBytes, pdFALSE, pxRegion );
+
+		if( xReturn == ( size_t ) 0 )
+		{
+			traceSTREAM_BUFFER_SEND_FAILED( xStreamBuffer );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_STREAM_BUFFER_MULTI_PRODUCER */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_STREAM_BUFFER_MULTI_PRODUCER == 1 )
+
+	BaseType_t xStreamBufferPublish( StreamBufferHandle_t xStreamBuffer )
+	{
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+		configASSERT( pxStreamBuffer );
+
+		return prvPublish( pxStreamBuffer, pdFALSE, NULL );
+	}
+
+#endif /* configUSE_STREAM_BUFFER_MULTI_PRODUCER */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_STREAM_BUFFER_MULTI_PRODUCER == 1 )
+
+	BaseType_t xStreamBufferPublishFromISR( StreamBufferHandle_t xStreamBuffer, BaseType_t * const pxHigherPriorityTaskWoken )
+	{
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+		configASSERT( pxStreamBuffer );
+
+		return prvPublish( pxStreamBuffer, pdTRUE, pxHigherPriorityTaskWoken );
+	}
+
+#endif /* configUSE_STREAM_BUFFER_MULTI_PRODUCER */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_STREAM_BUFFER_MULTI_PRODUCER == 1 )
+
+	static size_t prvClaimSpace( StreamBuffer_t * const pxStreamBuffer,
+								 size_t xDataLengthBytes,
+								 BaseType_t xAllowPartial,
+								 StreamBufferRegion_t * const pxRegion )
+	{
+	size_t xState, xClaim, xSpace, xCount, xNextClaim, xBytesToStoreMessageLength;
+	configMESSAGE_BUFFER_LENGTH_TYPE xTempLength;
+	StreamBufferRegion_t xLengthRegion;
+
+		if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+		{
+			xBytesToStoreMessageLength = sbBYTES_TO_STORE_MESSAGE_LENGTH;
+		}
+		else
+		{
+			xBytesToStoreMessageLength = 0;
+		}
+
+		for( ;; )
+		{
+			xState = pxStreamBuffer->xClaimState;
+			xClaim = xState & sbCLAIM_INDEX_MASK;
+
+			/* The free space runs from the claim index round to the tail.  The
+			tail only ever moves forward, so reading it before another writer
+			or the reader changes it can only under-report the space. */
+			xSpace = pxStreamBuffer->xLength + pxStreamBuffer->xTail;
+			xSpace -= xClaim;
+			xSpace -= ( size_t ) 1;
+
+			if( xSpace >= pxStreamBuffer->xLength )
+			{
+				xSpace -= pxStreamBuffer->xLength;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( xSpace >= ( xDataLengthBytes + xBytesToStoreMessageLength ) )
+			{
+				xCount = xDataLengthBytes;
+			}
+			else if( ( xAllowPartial != pdFALSE ) && ( xBytesToStoreMessageLength == ( size_t ) 0 ) )
+			{
+				/* A stream buffer takes as many bytes as fit, as for
+				xStreamBufferSend(). */
+				xCount = xSpace;
+			}
+			else
+			{
+				xCount = 0;
+			}
+
+			if( xCount == ( size_t ) 0 )
+			{
+				break;
+			}
+
+			xNextClaim = xClaim + xCount + xBytesToStoreMessageLength;
+
+			if( xNextClaim >= pxStreamBuffer->xLength )
+			{
+				xNextClaim -= pxStreamBuffer->xLength;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* The count of open claims is 8 bits wide. */
+			configASSERT( ( xState >> sbCLAIM_COUNT_SHIFT ) < ( size_t ) 0xff );
+
+			/* Move the claim index and count this writer in, unless another
+			writer or an interrupt claimed or published since xState was read,
+			in which case start again from the new state. */
+			if( portCOMPARE_AND_SWAP_POINTER( &( pxStreamBuffer->xClaimState ), xState, ( ( xState & ~sbCLAIM_INDEX_MASK ) + sbCLAIM_ONE_WRITER ) | xNextClaim ) != pdFALSE )
+			{
+				break;
+			}
+		}
+
+		if( xCount > ( size_t ) 0 )
+		{
+			if( xBytesToStoreMessageLength != ( size_t ) 0 )
+			{
+				/* The length goes in front of the message.  The reader cannot
+				see it until the claim is published. */
+				xTempLength = ( configMESSAGE_BUFFER_LENGTH_TYPE ) xCount;
+				prvGetRegion( pxStreamBuffer, xClaim, xBytesToStoreMessageLength, &xLengthRegion );
+				( void ) memcpy( ( void * ) xLengthRegion.pucFirst, ( const void * ) &xTempLength, xLengthRegion.xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+
+				if( xLengthRegion.xSecondLength > ( size_t ) 0 )
+				{
+					( void ) memcpy( ( void * ) xLengthRegion.pucSecond, ( const void * ) &( ( ( const uint8_t * ) &xTempLength )[ xLengthRegion.xFirstLength ] ), xLengthRegion.xSecondLength ); /*lint !e9087 memcpy() requires void *. */
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				xClaim += xBytesToStoreMessageLength;
+
+				if( xClaim >= pxStreamBuffer->xLength )
+				{
+					xClaim -= pxStreamBuffer->xLength;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		prvGetRegion( pxStreamBuffer, xClaim, xCount, pxRegion );
+
+		return xCount;
+	}
+
+#endif /* configUSE_STREAM_BUFFER_MULTI_PRODUCER */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_STREAM_BUFFER_MULTI_PRODUCER == 1 )
+
+	static BaseType_t prvPublish( StreamBuffer_t * const pxStreamBuffer,
+								  BaseType_t xFromISR,
+								  BaseType_t * const pxHigherPriorityTaskWoken )
+	{
+	UBaseType_t uxSavedInterruptStatus;
+	size_t xState;
+	BaseType_t xReturn = pdFALSE;
+
+		/* Closing the last open claim and moving the head up to the claim index
+		must be one step, otherwise a writer that claimed in between would have
+		its space published before it was filled.  Claims complete in any
+		order, so the head only moves when none are open, and then always over
+		whole messages in the order they were claimed. */
+		uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			xState = pxStreamBuffer->xClaimState;
+			configASSERT( xState >= sbCLAIM_ONE_WRITER );
+			xState -= sbCLAIM_ONE_WRITER;
+			pxStreamBuffer->xClaimState = xState;
+
+			if( xState < sbCLAIM_ONE_WRITER )
+			{
+				pxStreamBuffer->xHead = xState;
+				xReturn = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		/* Was a task waiting for the data? */
+		if( ( xReturn != pdFALSE ) && ( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes ) )
+		{
+			if( xFromISR != pdFALSE )
+			{
+				sbSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+			}
+			else
+			{
+				sbSEND_COMPLETED( pxStreamBuffer );
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_STREAM_BUFFER_MULTI_PRODUCER */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_STREAM_BUFFER_MULTI_PRODUCER == 1 )
+
+	static size_t prvSendMultiProducer( StreamBuffer_t * const pxStreamBuffer,
+										const void *pvTxData,
+										size_t xDataLengthBytes,
+										BaseType_t xFromISR,
+										BaseType_t * const pxHigherPriorityTaskWoken )
+	{
+	StreamBufferRegion_t xRegion;
+	size_t xReturn;
+
+		xReturn = prvClaimSpace( pxStreamBuffer, xDataLengthBytes, pdTRUE, &xRegion );
+
+		if( xReturn > ( size_t ) 0 )
+		{
+			/* Other writers can claim, fill and publish while this copy runs. */
+			( void ) memcpy( ( void * ) xRegion.pucFirst, pvTxData, xRegion.xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+
+			if( xRegion.xSecondLength > ( size_t ) 0 )
+			{
+				( void ) memcpy( ( void * ) xRegion.pucSecond, ( const void * ) &( ( ( const uint8_t * ) pvTxData )[ xRegion.xFirstLength ] ), xRegion.xSecondLength ); /*lint !e9087 memcpy() requires void *. */
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			( void ) prvPublish( pxStreamBuffer, xFromISR, pxHigherPriorityTaskWoken );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_STREAM_BUFFER_MULTI_PRODUCER */
+/*-----------------------------------------------------------*/
+
 static size_t prvWriteBytesToBuffer( StreamBuffer_t * const pxStreamBuffer, const uint8_t *pucData, size_t xCount )
 {
 size_t xNextHead, xFirstLength;
@@ -112,7 +112,7 @@ configIDLE_TASK_NAME in FreeRTOSConfig.h. */
 	#define configIDLE_TASK_NAME "IDLE"
 #endif
 
-#if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+#if ( ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 ) && ( configUSE_BITMAP_TASK_SELECTION == 0 ) )
 
 	/* If configUSE_PORT_OPTIMISED_TASK_SELECTION is 0 then task selection is
 	performed in a generic way that is not optimised to any particular
@@ -155,6 +155,76 @@ configIDLE_TASK_NAME in FreeRTOSConfig.h. */
 	#define taskRESET_READY_PRIORITY( uxPriority )
 	#define portRESET_READY_PRIORITY( uxPriority, uxTopReadyPriority )
 
+#elif ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 ) /* configUSE_BITMAP_TASK_SELECTION == 1 */
+
+	/* If configUSE_BITMAP_TASK_SELECTION is 1 then task selection is still
+	portable, but uses a two level bitmap of ready priorities in place of the
+	downward scan of the ready lists.  Each bit of ulReadyPriorityGroups
+	represents a group of 32 priorities, and is set when any bit of the
+	group's word in ulReadyPriorities[] is set.  Finding the highest ready
+	priority is therefore two constant time bit searches, however sparse the
+	priorities in use are.  The bit search uses a multiply and a 32 entry table
+	rather than a count leading zeros instruction, so it works on any
+	architecture. */
+
+	#define taskREADY_PRIORITY_GROUPS	( ( ( UBaseType_t ) configMAX_PRIORITIES + 31U ) / 32U )
+
+	#define taskRECORD_READY_PRIORITY( uxPriority )														\
+	{																									\
+		ulReadyPriorities[ ( uxPriority ) >> 5 ] |= ( 1UL << ( ( uxPriority ) & 31U ) );				\
+		ulReadyPriorityGroups |= ( 1UL << ( ( uxPriority ) >> 5 ) );									\
+																										\
+		/* uxTopReadyPriority is maintained as the generic method does, as the							\
+		tickless idle code uses it to know if tasks above the idle priority								\
+		are ready. */																					\
+		if( ( uxPriority ) > uxTopReadyPriority )														\
+		{																								\
+			uxTopReadyPriority = ( uxPriority );														\
+		}																								\
+	} /* taskRECORD_READY_PRIORITY */
+
+	/*-----------------------------------------------------------*/
+
+	#define taskSELECT_HIGHEST_PRIORITY_TASK()															\
+	{																									\
+	UBaseType_t uxTopGroup, uxTopPriority;																\
+																										\
+		/* The idle task is always ready, so there is always a bit set. */							\
+		configASSERT( ulReadyPriorityGroups != 0UL );													\
+		uxTopGroup = prvHighestSetBit( ulReadyPriorityGroups );										\
+		uxTopPriority = ( uxTopGroup << 5 ) + prvHighestSetBit( ulReadyPriorities[ uxTopGroup ] );		\
+		configASSERT( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxTopPriority ] ) ) > 0 );		\
+																										\
+		/* listGET_OWNER_OF_NEXT_ENTRY indexes through the list, so the tasks of						\
+		the	same priority get an equal share of the processor time. */									\
+		listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) );			\
+		uxTopReadyPriority = uxTopPriority;																\
+	} /* taskSELECT_HIGHEST_PRIORITY_TASK */
+
+	/*-----------------------------------------------------------*/
+
+	/* Clear the priority's bit, and the group's bit if it was the last ready
+	priority in the group.  Only called when the ready list is known to be
+	empty. */
+	#define portRESET_READY_PRIORITY( uxPriority, uxTopReadyPriority )									\
+	{																									\
+		ulReadyPriorities[ ( uxPriority ) >> 5 ] &= ~( 1UL << ( ( uxPriority ) & 31U ) );				\
+		if( ulReadyPriorities[ ( uxPriority ) >> 5 ] == 0UL )											\
+		{																								\
+			ulReadyPriorityGroups &= ~( 1UL << ( ( uxPriority ) >> 5 ) );								\
+		}																								\
+	}
+
+	/* As for the port optimised version, only reset the priority if the TCB
+	was the last one referenced from its ready list. */
+	#define taskRESET_READY_PRIORITY( uxPriority )														\
+	{																									\
+		if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ ( uxPriority ) ] ) ) == ( UBaseType_t ) 0 )	\
+		{																								\
+			portRESET_READY_PRIORITY( ( uxPriority ), ( uxTopReadyPriority ) );							\
+		}																								\
+	}
+
 #else /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
 
 	/* If configUSE_PORT_OPTIMISED_TASK_SELECTION is 1 then task selection is
@@ -193,21 +263,67 @@ configIDLE_TASK_NAME in FreeRTOSConfig.h. */
 
 /*-----------------------------------------------------------*/
 
-/* pxDelayedTaskList and pxOverflowDelayedTaskList are switched when the tick
-count overflows. */
-#define taskSWITCH_DELAYED_LISTS()																	\
-{																									\
-	List_t *pxTemp;																					\
-																									\
-	/* The delayed tasks list should be empty when the lists are switched. */						\
-	configASSERT( ( listLIST_IS_EMPTY( pxDelayedTaskList ) ) );										\
-																									\
-	pxTemp = pxDelayedTaskList;																		\
-	pxDelayedTaskList = pxOverflowDelayedTaskList;													\
-	pxOverflowDelayedTaskList = pxTemp;																\
-	xNumOfOverflows++;																				\
-	prvResetNextTaskUnblockTime();																	\
-}
+#if ( configUSE_DELAYED_TIMING_WHEEL == 0 )
+
+	/* pxDelayedTaskList and pxOverflowDelayedTaskList are switched when the tick
+	count overflows. */
+	#define taskSWITCH_DELAYED_LISTS()																	\
+	{																									\
+		List_t *pxTemp;																					\
+																										\
+		/* The delayed tasks list should be empty when the lists are switched. */						\
+		configASSERT( ( listLIST_IS_EMPTY( pxDelayedTaskList ) ) );										\
+																										\
+		pxTemp = pxDelayedTaskList;																		\
+		pxDelayedTaskList = pxOverflowDelayedTaskList;													\
+		pxOverflowDelayedTaskList = pxTemp;																\
+		xNumOfOverflows++;																				\
+		prvResetNextTaskUnblockTime();																	\
+	}
+
+	#define taskLIST_IS_DELAYED( pxList ) ( ( ( pxList ) == pxDelayedTaskList ) || ( ( pxList ) == pxOverflowDelayedTaskList ) )
+
+#else /* configUSE_DELAYED_TIMING_WHEEL */
+
+	/* Blocked tasks are kept on a timing wheel of configTIMING_WHEEL_SLOTS
+	lists.  A task goes at the end of the slot selected by the low bits of its
+	wake time, so adding a task takes the same time however many tasks are
+	blocked.  The slots are not sorted: the tick that reaches a slot walks all of
+	it, unblocks the tasks whose wake time is that tick and leaves the ones from
+	later revolutions of the wheel where they are.  That tick therefore takes
+	time in proportion to the tasks in the slot, about the number of blocked
+	tasks divided by configTIMING_WHEEL_SLOTS.
+
+	As with the delayed lists, a task whose wake time has overflowed the tick
+	count goes on a second wheel, and the wheels are switched when the tick count
+	wraps.  The current wheel is empty by then.
+
+	Each wheel has a bitmap with a bit set for each slot that may be non-empty.
+	Bits are set when a task is added and cleared when the tick finds the slot
+	empty, so a task leaving a slot early (for example because the event it
+	waited for occurred) leaves a stale bit that only costs a visit to an empty
+	slot. */
+	#define taskWHEEL_SLOT_MASK		( ( TickType_t ) configTIMING_WHEEL_SLOTS - ( TickType_t ) 1 )
+	#define taskWHEEL_BIT_WORDS		( ( configTIMING_WHEEL_SLOTS + 31 ) / 32 )
+	#define taskWHEEL_WORD_BITS		( ( configTIMING_WHEEL_SLOTS < 32 ) ? configTIMING_WHEEL_SLOTS : 32 )
+	#define taskWHEEL_LISTS				( 2 * configTIMING_WHEEL_SLOTS )
+
+	/* Both wheels, indexed from 0 to taskWHEEL_LISTS - 1. */
+	#define taskWHEEL_LIST( uxIndex )	( &( xDelayedTaskWheel[ ( uxIndex ) / ( UBaseType_t ) configTIMING_WHEEL_SLOTS ][ ( uxIndex ) & ( UBaseType_t ) taskWHEEL_SLOT_MASK ] ) )
+
+	#define taskLIST_IS_DELAYED( pxList ) ( ( ( pxList ) >= &( xDelayedTaskWheel[ 0 ][ 0 ] ) ) && ( ( pxList ) <= &( xDelayedTaskWheel[ 1 ][ configTIMING_WHEEL_SLOTS - 1 ] ) ) )
+
+	/* The current and overflow wheels are switched when the tick count
+	overflows.  The tick being entered is 0, so make the tick look at its slot,
+	which also sets xNextTaskUnblockTime for the new wheel. */
+	#define taskSWITCH_DELAYED_WHEELS()																	\
+	{																									\
+		uxCurrentDelayedTaskWheel ^= ( UBaseType_t ) 1;													\
+		xNumOfOverflows++;																				\
+		xNextTaskUnblockTime = ( TickType_t ) 0U;														\
+	}
+
+#endif /* configUSE_DELAYED_TIMING_WHEEL */
 
 /*-----------------------------------------------------------*/
 
@@ -281,16 +397,23 @@ typedef struct tskTaskControlBlock 			/* The old naming convention is used to pr
 		UBaseType_t		uxMutexesHeld;
 	#endif
 
+	#if ( configUSE_MUTEX_CEILING == 1 )
+		UBaseType_t		uxCeilingMutexesHeld;	/*< Number of priority ceiling mutexes held, so they can be checked to be given in reverse order. */
+	#endif
+
 	#if ( configUSE_APPLICATION_TASK_TAG == 1 )
 		TaskHookFunction_t pxTaskTag;
 	#endif
 
 	#if( configNUM_THREAD_LOCAL_STORAGE_POINTERS > 0 )
 		void			*pvThreadLocalStoragePointers[ configNUM_THREAD_LOCAL_STORAGE_POINTERS ];
+		#if ( configTHREAD_LOCAL_STORAGE_DELETE_CALLBACKS == 1 )
+			TlsDeleteCallbackFunction_t pvThreadLocalStoragePointersDelCallback[ configNUM_THREAD_LOCAL_STORAGE_POINTERS ];
+		#endif
 	#endif
 
 	#if( configGENERATE_RUN_TIME_STATS == 1 )
-		uint32_t		ulRunTimeCounter;	/*< Stores the amount of time the task has spent in the Running state. */
+		configRUN_TIME_COUNTER_TYPE		ulRunTimeCounter;	/*< Stores the amount of time the task has spent in the Running state. */
 	#endif
 
 	#if ( configUSE_NEWLIB_REENTRANT == 1 )
@@ -326,6 +449,10 @@ typedef struct tskTaskControlBlock 			/* The old naming convention is used to pr
 		int iTaskErrno;
 	#endif
 
+	#if( configUSE_64_BIT_EVENT_GROUPS == 1 )
+		uint64_t ullEventItemValue;	/*< Used in place of the value of xEventListItem while the task waits on a 64-bit event group, as the bits do not fit in a TickType_t. */
+	#endif
+
 } tskTCB;
 
 /* The old tskTCB name is maintained above then typedefed to the new TCB_t name
@@ -341,10 +468,16 @@ xDelayedTaskList1 and xDelayedTaskList2 could be move to function scople but
 doing so breaks some kernel aware debuggers and debuggers that rely on removing
 the static qualifier. */
 PRIVILEGED_DATA static List_t pxReadyTasksLists[ configMAX_PRIORITIES ];/*< Prioritised ready tasks. */
-PRIVILEGED_DATA static List_t xDelayedTaskList1;						/*< Delayed tasks. */
-PRIVILEGED_DATA static List_t xDelayedTaskList2;						/*< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
-PRIVILEGED_DATA static List_t * volatile pxDelayedTaskList;				/*< Points to the delayed task list currently being used. */
-PRIVILEGED_DATA static List_t * volatile pxOverflowDelayedTaskList;		/*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
+#if ( configUSE_DELAYED_TIMING_WHEEL == 0 )
+	PRIVILEGED_DATA static List_t xDelayedTaskList1;						/*< Delayed tasks. */
+	PRIVILEGED_DATA static List_t xDelayedTaskList2;						/*< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
+	PRIVILEGED_DATA static List_t * volatile pxDelayedTaskList;				/*< Points to the delayed task list currently being used. */
+	PRIVILEGED_DATA static List_t * volatile pxOverflowDelayedTaskList;		/*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
+#else
+	PRIVILEGED_DATA static List_t xDelayedTaskWheel[ 2 ][ configTIMING_WHEEL_SLOTS ];		/*< Delayed tasks, by the low bits of their wake time (two wheels are used - one for wake times that have overflowed the current tick count). */
+	PRIVILEGED_DATA static uint32_t ulDelayedTaskWheelBits[ 2 ][ taskWHEEL_BIT_WORDS ];	/*< Slots of xDelayedTaskWheel that may hold tasks. */
+	PRIVILEGED_DATA static UBaseType_t uxCurrentDelayedTaskWheel;							/*< Index of the wheel currently being used. */
+#endif
 PRIVILEGED_DATA static List_t xPendingReadyList;						/*< Tasks that have been readied while the scheduler was suspended.  They will be moved to the ready list when the scheduler is resumed. */
 
 #if( INCLUDE_vTaskDelete == 1 )
@@ -370,6 +503,14 @@ the errno of the currently running task. */
 PRIVILEGED_DATA static volatile UBaseType_t uxCurrentNumberOfTasks 	= ( UBaseType_t ) 0U;
 PRIVILEGED_DATA static volatile TickType_t xTickCount 				= ( TickType_t ) configINITIAL_TICK_COUNT;
 PRIVILEGED_DATA static volatile UBaseType_t uxTopReadyPriority 		= tskIDLE_PRIORITY;
+
+#if ( ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 ) && ( configUSE_BITMAP_TASK_SELECTION == 1 ) )
+
+	/* Bitmap of ready priorities, see taskSELECT_HIGHEST_PRIORITY_TASK(). */
+	PRIVILEGED_DATA static uint32_t ulReadyPriorityGroups = 0UL;
+	PRIVILEGED_DATA static uint32_t ulReadyPriorities[ taskREADY_PRIORITY_GROUPS ] = { 0UL };
+
+#endif
 PRIVILEGED_DATA static volatile BaseType_t xSchedulerRunning 		= pdFALSE;
 PRIVILEGED_DATA static volatile TickType_t xPendedTicks 			= ( TickType_t ) 0U;
 PRIVILEGED_DATA static volatile BaseType_t xYieldPending 			= pdFALSE;
@@ -392,8 +533,8 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended	= ( UBaseType_t
 
 	/* Do not move these variables to function scope as doing so prevents the
 	code working with debuggers that need to remove the static qualifier. */
-	PRIVILEGED_DATA static uint32_t ulTaskSwitchedInTime = 0UL;	/*< Holds the value of a timer/counter the last time a task was switched in. */
-	PRIVILEGED_DATA static uint32_t ulTotalRunTime = 0UL;		/*< Holds the total amount of execution time as defined by the run time counter clock. */
+	PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulTaskSwitchedInTime = 0UL;	/*< Holds the value of a timer/counter the last time a task was switched in. */
+	PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulTotalRunTime = 0UL;		/*< Holds the total amount of execution time as defined by the run time counter clock. */
 
 #endif
 
@@ -422,6 +563,36 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended	= ( UBaseType_t
 
 /* File private functions. --------------------------------*/
 
+/*
+ * Returns the index of the most significant set bit of a non-zero value, used
+ * by the bitmap task selection.
+ */
+#if ( ( ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 ) && ( configUSE_BITMAP_TASK_SELECTION == 1 ) ) || ( configUSE_DELAYED_TIMING_WHEEL == 1 ) )
+
+	static UBaseType_t prvHighestSetBit( uint32_t ulValue ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Adds the task to the delayed task wheel, see configUSE_DELAYED_TIMING_WHEEL.
+ */
+#if ( configUSE_DELAYED_TIMING_WHEEL == 1 )
+
+	static void prvAddTaskToDelayedWheel( TCB_t * const pxTCB, const TickType_t xTimeToWake, const TickType_t xConstTickCount ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Returns how far after uxFirstSlot (wrapping round the wheel) the first slot
+ * with its bit set in pulBits is, looking at uxCount slots, or uxCount if none
+ * of them are set.
+ */
+#if ( configUSE_DELAYED_TIMING_WHEEL == 1 )
+
+	static UBaseType_t prvFindDelayedWheelSlot( const uint32_t * const pulBits, const UBaseType_t uxFirstSlot, const UBaseType_t uxCount ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /**
  * Utility task that simply returns pdTRUE if the task referenced by xTask is
  * currently in the Suspended state, or pdFALSE if the task referenced by xTask
@@ -478,6 +649,15 @@ static void prvCheckTasksWaitingTermination( void ) PRIVILEGED_FUNCTION;
  */
 static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait, const BaseType_t xCanBlockIndefinitely ) PRIVILEGED_FUNCTION;
 
+/*
+ * Moves the running task to the ready list of uxNewPriority.  Used to raise a
+ * task to, and lower it from, the ceiling of a priority ceiling mutex.  Must
+ * be called from a critical section.
+ */
+#if ( configUSE_MUTEX_CEILING == 1 )
+	static void prvSetRunningTaskPriority( UBaseType_t uxNewPriority ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Fills an TaskStatus_t structure with information on each task that is
  * referenced from the pxList list (which may be a ready list, a delayed list,
@@ -492,6 +672,18 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait, const BaseT
 
 #endif
 
+/*
+ * Fills a TaskRunTimeSnapshot_t structure with the handle, number and run time
+ * of each task that is referenced from the pxList list.  Unlike
+ * prvListTasksWithinSingleList() nothing else is read from the TCB, so the
+ * cost is a handful of loads per task.
+ */
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+
+	static UBaseType_t prvListTaskRunTimesWithinSingleList( TaskRunTimeSnapshot_t *pxSnapshotArray, List_t *pxList ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * Searches pxList for a task with name pcNameToQuery - returning a handle to
  * the task if it is found, or NULL if the task is not found.
@@ -938,6 +1130,12 @@ UBaseType_t x;
 	}
 	#endif /* configUSE_MUTEXES */
 
+	#if ( configUSE_MUTEX_CEILING == 1 )
+	{
+		pxNewTCB->uxCeilingMutexesHeld = 0;
+	}
+	#endif
+
 	vListInitialiseItem( &( pxNewTCB->xStateListItem ) );
 	vListInitialiseItem( &( pxNewTCB->xEventListItem ) );
 
@@ -983,6 +1181,12 @@ UBaseType_t x;
 		for( x = 0; x < ( UBaseType_t ) configNUM_THREAD_LOCAL_STORAGE_POINTERS; x++ )
 		{
 			pxNewTCB->pvThreadLocalStoragePointers[ x ] = NULL;
+
+			#if ( configTHREAD_LOCAL_STORAGE_DELETE_CALLBACKS == 1 )
+			{
+				pxNewTCB->pvThreadLocalStoragePointersDelCallback[ x ] = NULL;
+			}
+			#endif
 		}
 	}
 	#endif
@@ -1386,7 +1590,8 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 	eTaskState eTaskGetState( TaskHandle_t xTask )
 	{
 	eTaskState eReturn;
-	List_t const * pxStateList, *pxDelayedList, *pxOverflowedDelayedList;
+	List_t const * pxStateList;
+	BaseType_t xStateIsDelayed;
 	const TCB_t * const pxTCB = xTask;
 
 		configASSERT( pxTCB );
@@ -1401,12 +1606,11 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 			taskENTER_CRITICAL();
 			{
 				pxStateList = listLIST_ITEM_CONTAINER( &( pxTCB->xStateListItem ) );
-				pxDelayedList = pxDelayedTaskList;
-				pxOverflowedDelayedList = pxOverflowDelayedTaskList;
+				xStateIsDelayed = taskLIST_IS_DELAYED( pxStateList );
 			}
 			taskEXIT_CRITICAL();
 
-			if( ( pxStateList == pxDelayedList ) || ( pxStateList == pxOverflowedDelayedList ) )
+			if( xStateIsDelayed != pdFALSE )
 			{
 				/* The task being queried is referenced from one of the Blocked
 				lists. */
@@ -2462,15 +2666,28 @@ TCB_t *pxTCB;
 			} while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 
 			/* Search the delayed lists. */
-			if( pxTCB == NULL )
+			#if ( configUSE_DELAYED_TIMING_WHEEL == 0 )
 			{
-				pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxDelayedTaskList, pcNameToQuery );
-			}
+				if( pxTCB == NULL )
+				{
+					pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxDelayedTaskList, pcNameToQuery );
+				}
 
-			if( pxTCB == NULL )
+				if( pxTCB == NULL )
+				{
+					pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxOverflowDelayedTaskList, pcNameToQuery );
+				}
+			}
+			#else
 			{
-				pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxOverflowDelayedTaskList, pcNameToQuery );
+			UBaseType_t uxSlot;
+
+				for( uxSlot = 0; ( uxSlot < ( UBaseType_t ) taskWHEEL_LISTS ) && ( pxTCB == NULL ); uxSlot++ )
+				{
+					pxTCB = prvSearchForNameWithinSingleList( taskWHEEL_LIST( uxSlot ), pcNameToQuery );
+				}
 			}
+			#endif /* configUSE_DELAYED_TIMING_WHEEL */
 
 			#if ( INCLUDE_vTaskSuspend == 1 )
 			{
@@ -2502,7 +2719,7 @@ TCB_t *pxTCB;
 
 #if ( configUSE_TRACE_FACILITY == 1 )
 
-	UBaseType_t uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray, const UBaseType_t uxArraySize, uint32_t * const pulTotalRunTime )
+	UBaseType_t uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray, const UBaseType_t uxArraySize, configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime )
 	{
 	UBaseType_t uxTask = 0, uxQueue = configMAX_PRIORITIES;
 
@@ -2522,8 +2739,21 @@ TCB_t *pxTCB;
 
 				/* Fill in an TaskStatus_t structure with information on each
 				task in the Blocked state. */
-				uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList, eBlocked );
-				uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList, eBlocked );
+				#if ( configUSE_DELAYED_TIMING_WHEEL == 0 )
+				{
+					uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList, eBlocked );
+					uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList, eBlocked );
+				}
+				#else
+				{
+				UBaseType_t uxSlot;
+
+					for( uxSlot = 0; uxSlot < ( UBaseType_t ) taskWHEEL_LISTS; uxSlot++ )
+					{
+						uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), taskWHEEL_LIST( uxSlot ), eBlocked );
+					}
+				}
+				#endif /* configUSE_DELAYED_TIMING_WHEEL */
 
 				#if( INCLUDE_vTaskDelete == 1 )
 				{
@@ -2574,6 +2804,95 @@ TCB_t *pxTCB;
 #endif /* configUSE_TRACE_FACILITY */
 /*----------------------------------------------------------*/
 
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+
+	UBaseType_t uxTaskGetRunTimeSnapshot( TaskRunTimeSnapshot_t * const pxSnapshotArray, const UBaseType_t uxArraySize, configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime )
+	{
+	UBaseType_t uxTask = 0, uxQueue = configMAX_PRIORITIES, x;
+	configRUN_TIME_COUNTER_TYPE ulNow;
+
+		vTaskSuspendAll();
+		{
+			/* Is there a space in the array for each task in the system? */
+			if( uxArraySize >= uxCurrentNumberOfTasks )
+			{
+				do
+				{
+					uxQueue--;
+					uxTask += prvListTaskRunTimesWithinSingleList( &( pxSnapshotArray[ uxTask ] ), &( pxReadyTasksLists[ uxQueue ] ) );
+
+				} while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+
+				#if ( configUSE_DELAYED_TIMING_WHEEL == 0 )
+				{
+					uxTask += prvListTaskRunTimesWithinSingleList( &( pxSnapshotArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList );
+					uxTask += prvListTaskRunTimesWithinSingleList( &( pxSnapshotArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList );
+				}
+				#else
+				{
+					for( x = 0; x < ( UBaseType_t ) taskWHEEL_LISTS; x++ )
+					{
+						uxTask += prvListTaskRunTimesWithinSingleList( &( pxSnapshotArray[ uxTask ] ), taskWHEEL_LIST( x ) );
+					}
+				}
+				#endif /* configUSE_DELAYED_TIMING_WHEEL */
+
+				#if( INCLUDE_vTaskDelete == 1 )
+				{
+					uxTask += prvListTaskRunTimesWithinSingleList( &( pxSnapshotArray[ uxTask ] ), &xTasksWaitingTermination );
+				}
+				#endif
+
+				#if ( INCLUDE_vTaskSuspend == 1 )
+				{
+					uxTask += prvListTaskRunTimesWithinSingleList( &( pxSnapshotArray[ uxTask ] ), &xSuspendedTaskList );
+				}
+				#endif
+
+				#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+					portALT_GET_RUN_TIME_COUNTER_VALUE( ulNow );
+				#else
+					ulNow = portGET_RUN_TIME_COUNTER_VALUE();
+				#endif
+
+				/* The calling task's counter is only updated when it is switched
+				out, so credit it with the time it has been running since it was
+				last switched in.  The scheduler is suspended so that time cannot
+				change under us. */
+				if( ulNow > ulTaskSwitchedInTime )
+				{
+					for( x = 0; x < uxTask; x++ )
+					{
+						if( pxSnapshotArray[ x ].xHandle == ( TaskHandle_t ) pxCurrentTCB )
+						{
+							pxSnapshotArray[ x ].ulRunTimeCounter += ( ulNow - ulTaskSwitchedInTime );
+							break;
+						}
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				if( pulTotalRunTime != NULL )
+				{
+					*pulTotalRunTime = ulNow;
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		( void ) xTaskResumeAll();
+
+		return uxTask;
+	}
+
+#endif /* configGENERATE_RUN_TIME_STATS */
+/*----------------------------------------------------------*/
+
 #if ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
 
 	TaskHandle_t xTaskGetIdleTaskHandle( void )
@@ -2598,8 +2917,37 @@ implementations require configUSE_TICKLESS_IDLE to be set to a value other than
 		/* Correct the tick count value after a period during which the tick
 		was suppressed.  Note this does *not* call the tick hook function for
 		each stepped tick. */
-		configASSERT( ( xTickCount + xTicksToJump ) <= xNextTaskUnblockTime );
-		xTickCount += xTicksToJump;
+		#if ( configUSE_DELAYED_TIMING_WHEEL == 0 )
+		{
+			configASSERT( ( xTickCount + xTicksToJump ) <= xNextTaskUnblockTime );
+			xTickCount += xTicksToJump;
+		}
+		#else
+		{
+		const TickType_t xTicksToUnblock = xNextTaskUnblockTime - xTickCount;
+
+			configASSERT( xTicksToJump <= xTicksToUnblock );
+
+			/* The wheel only looks at the slot of the tick being entered, so
+			the tick on which the next task unblocks must not be stepped over.
+			The scheduler is suspended here, so pend that tick instead and
+			xTaskResumeAll() will process it. */
+			if( xTicksToJump == xTicksToUnblock )
+			{
+				configASSERT( uxSchedulerSuspended );
+				taskENTER_CRITICAL();
+				{
+					xPendedTicks++;
+				}
+				taskEXIT_CRITICAL();
+				xTickCount += xTicksToJump - ( TickType_t ) 1;
+			}
+			else
+			{
+				xTickCount += xTicksToJump;
+			}
+		}
+		#endif /* configUSE_DELAYED_TIMING_WHEEL */
 		traceINCREASE_TICK_COUNT( xTicksToJump );
 	}
 
@@ -2707,7 +3055,9 @@ BaseType_t xYieldRequired = pdFALSE;
 BaseType_t xTaskIncrementTick( void )
 {
 TCB_t * pxTCB;
-TickType_t xItemValue;
+#if ( configUSE_DELAYED_TIMING_WHEEL == 0 )
+	TickType_t xItemValue;
+#endif
 BaseType_t xSwitchRequired = pdFALSE;
 
 	/* Called by the portable layer each time a tick interrupt occurs.
@@ -2724,105 +3074,189 @@ BaseType_t xSwitchRequired = pdFALSE;
 		delayed lists if it wraps to 0. */
 		xTickCount = xConstTickCount;
 
-		if( xConstTickCount == ( TickType_t ) 0U ) /*lint !e774 'if' does not always evaluate to false as it is looking for an overflow. */
-		{
-			taskSWITCH_DELAYED_LISTS();
-		}
-		else
+		#if ( configUSE_DELAYED_TIMING_WHEEL == 0 )
 		{
-			mtCOVERAGE_TEST_MARKER();
-		}
+			if( xConstTickCount == ( TickType_t ) 0U ) /*lint !e774 'if' does not always evaluate to false as it is looking for an overflow. */
+			{
+				taskSWITCH_DELAYED_LISTS();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 
-		/* See if this tick has made a timeout expire.  Tasks are stored in
-		the	queue in the order of their wake time - meaning once one task
-		has been found whose block time has not expired there is no need to
-		look any further down the list. */
-		if( xConstTickCount >= xNextTaskUnblockTime )
-		{
-			for( ;; )
+			/* See if this tick has made a timeout expire.  Tasks are stored in
+			the	queue in the order of their wake time - meaning once one task
+			has been found whose block time has not expired there is no need to
+			look any further down the list. */
+			if( xConstTickCount >= xNextTaskUnblockTime )
 			{
-				if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
-				{
-					/* The delayed list is empty.  Set xNextTaskUnblockTime
-					to the maximum possible value so it is extremely
-					unlikely that the
-					if( xTickCount >= xNextTaskUnblockTime ) test will pass
-					next time through. */
-					xNextTaskUnblockTime = portMAX_DELAY; /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-					break;
-				}
-				else
+				for( ;; )
 				{
-					/* The delayed list is not empty, get the value of the
-					item at the head of the delayed list.  This is the time
-					at which the task at the head of the delayed list must
-					be removed from the Blocked state. */
-					pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-					xItemValue = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
-
-					if( xConstTickCount < xItemValue )
-					{
-						/* It is not time to unblock this item yet, but the
-						item value is the time at which the task at the head
-						of the blocked list must be removed from the Blocked
-						state -	so record the item value in
-						xNextTaskUnblockTime. */
-						xNextTaskUnblockTime = xItemValue;
-						break; /*lint !e9011 Code structure here is deedmed easier to understand with multiple breaks. */
-					}
-					else
-					{
-						mtCOVERAGE_TEST_MARKER();
-					}
-
-					/* It is time to remove the item from the Blocked state. */
-					( void ) uxListRemove( &( pxTCB->xStateListItem ) );
-
-					/* Is the task waiting on an event also?  If so remove
-					it from the event list. */
-					if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+					if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
 					{
-						( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+						/* The delayed list is empty.  Set xNextTaskUnblockTime
+						to the maximum possible value so it is extremely
+						unlikely that the
+						if( xTickCount >= xNextTaskUnblockTime ) test will pass
+						next time through. */
+						xNextTaskUnblockTime = portMAX_DELAY; /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+						break;
 					}
 					else
 					{
-						mtCOVERAGE_TEST_MARKER();
-					}
+						/* The delayed list is not empty, get the value of the
+						item at the head of the delayed list.  This is the time
+						at which the task at the head of the delayed list must
+						be removed from the Blocked state. */
+						pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+						xItemValue = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
+
+						if( xConstTickCount < xItemValue )
+						{
+							/* It is not time to unblock this item yet, but the
+							item value is the time at which the task at the head
+							of the blocked list must be removed from the Blocked
+							state -	so record the item value in
+							xNextTaskUnblockTime. */
+							xNextTaskUnblockTime = xItemValue;
+							break; /*lint !e9011 Code structure here is deedmed easier to understand with multiple breaks. */
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
 
-					/* Place the unblocked task into the appropriate ready
-					list. */
-					prvAddTaskToReadyList( pxTCB );
+						/* It is time to remove the item from the Blocked state. */
+						( void ) uxListRemove( &( pxTCB->xStateListItem ) );
 
-					/* A task being unblocked cannot cause an immediate
-					context switch if preemption is turned off. */
-					#if (  configUSE_PREEMPTION == 1 )
-					{
-						/* Preemption is on, but a context switch should
-						only be performed if the unblocked task has a
-						priority that is equal to or higher than the
-						currently executing task. */
-						if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+						/* Is the task waiting on an event also?  If so remove
+						it from the event list. */
+						if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
 						{
-							xSwitchRequired = pdTRUE;
+							( void ) uxListRemove( &( pxTCB->xEventListItem ) );
 						}
 						else
 						{
 							mtCOVERAGE_TEST_MARKER();
 						}
+
+						/* Place the unblocked task into the appropriate ready
+						list. */
+						prvAddTaskToReadyList( pxTCB );
+
+						/* A task being unblocked cannot cause an immediate
+						context switch if preemption is turned off. */
+						#if (  configUSE_PREEMPTION == 1 )
+						{
+							/* Preemption is on, but a context switch should
+							only be performed if the unblocked task has a
+							priority that is equal to or higher than the
+							currently executing task. */
+							if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+							{
+								xSwitchRequired = pdTRUE;
+							}
+							else
+							{
+								mtCOVERAGE_TEST_MARKER();
+							}
+						}
+						#endif /* configUSE_PREEMPTION */
 					}
-					#endif /* configUSE_PREEMPTION */
 				}
 			}
 		}
-
-		/* Tasks of equal priority to the currently running task will share
-		processing time (time slice) if preemption is on, and the application
-		writer has not explicitly turned time slicing off. */
-		#if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
+		#else /* configUSE_DELAYED_TIMING_WHEEL */
 		{
-			if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 )
+			if( xConstTickCount == ( TickType_t ) 0U ) /*lint !e774 'if' does not always evaluate to false as it is looking for an overflow. */
 			{
-				xSwitchRequired = pdTRUE;
+				taskSWITCH_DELAYED_WHEELS();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* xNextTaskUnblockTime is never later than the first tick on which a
+			task unblocks, and every tick is entered here, so the wheel only
+			needs to be looked at when it is reached. */
+			if( xConstTickCount == xNextTaskUnblockTime )
+			{
+			const UBaseType_t uxSlot = ( UBaseType_t ) ( xConstTickCount & taskWHEEL_SLOT_MASK );
+			List_t * const pxSlot = &( xDelayedTaskWheel[ uxCurrentDelayedTaskWheel ][ uxSlot ] );
+			const ListItem_t * const pxSlotEnd = listGET_END_MARKER( pxSlot );
+			ListItem_t *pxItem = listGET_HEAD_ENTRY( pxSlot );
+
+				/* The slot is not sorted, so every task in it is looked at. */
+				while( pxItem != pxSlotEnd )
+				{
+					pxTCB = listGET_LIST_ITEM_OWNER( pxItem ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+					pxItem = listGET_NEXT( pxItem );
+
+					if( listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) ) == xConstTickCount )
+					{
+						( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+
+						/* Is the task waiting on an event also?  If so remove
+						it from the event list. */
+						if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+						{
+							( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+
+						prvAddTaskToReadyList( pxTCB );
+
+						#if (  configUSE_PREEMPTION == 1 )
+						{
+							if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+							{
+								xSwitchRequired = pdTRUE;
+							}
+							else
+							{
+								mtCOVERAGE_TEST_MARKER();
+							}
+						}
+						#endif /* configUSE_PREEMPTION */
+					}
+					else
+					{
+						/* From a later revolution. */
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+
+				if( listLIST_IS_EMPTY( pxSlot ) != pdFALSE )
+				{
+					ulDelayedTaskWheelBits[ uxCurrentDelayedTaskWheel ][ uxSlot >> 5 ] &= ~( 1UL << ( uxSlot & ( UBaseType_t ) 0x1f ) );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				prvResetNextTaskUnblockTime();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_DELAYED_TIMING_WHEEL */
+
+		/* Tasks of equal priority to the currently running task will share
+		processing time (time slice) if preemption is on, and the application
+		writer has not explicitly turned time slicing off. */
+		#if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
+		{
+			if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 )
+			{
+				xSwitchRequired = pdTRUE;
 			}
 			else
 			{
@@ -3251,6 +3685,60 @@ TCB_t *pxUnblockedTCB;
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_EVENT_GROUP_ISR_SET == 1 )
+
+	BaseType_t xTaskRemoveFromUnorderedEventListFromISR( ListItem_t * pxEventListItem, const TickType_t xItemValue )
+	{
+	TCB_t *pxUnblockedTCB;
+	BaseType_t xReturn;
+
+		/* THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION, or from an
+		interrupt with interrupts masked.  Event groups that are set from
+		interrupts are only accessed with interrupts masked, so exclusive
+		access to the event list is guaranteed here. */
+
+		listSET_LIST_ITEM_VALUE( pxEventListItem, xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+
+		pxUnblockedTCB = listGET_LIST_ITEM_OWNER( pxEventListItem ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+		configASSERT( pxUnblockedTCB );
+		( void ) uxListRemove( pxEventListItem );
+
+		/* From here on as xTaskRemoveFromEventList().  The event list item is
+		reused to hold the task on the pending ready list if the scheduler is
+		suspended; the item value stored above is left intact for
+		uxTaskResetEventItemValue(). */
+		if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+		{
+			( void ) uxListRemove( &( pxUnblockedTCB->xStateListItem ) );
+			prvAddTaskToReadyList( pxUnblockedTCB );
+
+			#if( configUSE_TICKLESS_IDLE != 0 )
+			{
+				prvResetNextTaskUnblockTime();
+			}
+			#endif
+		}
+		else
+		{
+			vListInsertEnd( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
+		}
+
+		if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+		{
+			xReturn = pdTRUE;
+			xYieldPending = pdTRUE;
+		}
+		else
+		{
+			xReturn = pdFALSE;
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_EVENT_GROUP_ISR_SET */
+/*-----------------------------------------------------------*/
+
 void vTaskSetTimeOutState( TimeOut_t * const pxTimeOut )
 {
 	configASSERT( pxTimeOut );
@@ -3550,17 +4038,41 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
 
 #if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS != 0 )
 
-	void vTaskSetThreadLocalStoragePointer( TaskHandle_t xTaskToSet, BaseType_t xIndex, void *pvValue )
-	{
-	TCB_t *pxTCB;
+	#if ( configTHREAD_LOCAL_STORAGE_DELETE_CALLBACKS == 1 )
 
-		if( xIndex < configNUM_THREAD_LOCAL_STORAGE_POINTERS )
+		void vTaskSetThreadLocalStoragePointer( TaskHandle_t xTaskToSet, BaseType_t xIndex, void *pvValue )
 		{
-			pxTCB = prvGetTCBFromHandle( xTaskToSet );
-			configASSERT( pxTCB != NULL );
-			pxTCB->pvThreadLocalStoragePointers[ xIndex ] = pvValue;
+			vTaskSetThreadLocalStoragePointerAndDelCallback( xTaskToSet, xIndex, pvValue, NULL );
 		}
-	}
+
+		void vTaskSetThreadLocalStoragePointerAndDelCallback( TaskHandle_t xTaskToSet, BaseType_t xIndex, void *pvValue, TlsDeleteCallbackFunction_t pvDelCallback )
+		{
+		TCB_t *pxTCB;
+
+			if( xIndex < configNUM_THREAD_LOCAL_STORAGE_POINTERS )
+			{
+				pxTCB = prvGetTCBFromHandle( xTaskToSet );
+				configASSERT( pxTCB != NULL );
+				pxTCB->pvThreadLocalStoragePointers[ xIndex ] = pvValue;
+				pxTCB->pvThreadLocalStoragePointersDelCallback[ xIndex ] = pvDelCallback;
+			}
+		}
+
+	#else
+
+		void vTaskSetThreadLocalStoragePointer( TaskHandle_t xTaskToSet, BaseType_t xIndex, void *pvValue )
+		{
+		TCB_t *pxTCB;
+
+			if( xIndex < configNUM_THREAD_LOCAL_STORAGE_POINTERS )
+			{
+				pxTCB = prvGetTCBFromHandle( xTaskToSet );
+				configASSERT( pxTCB != NULL );
+				pxTCB->pvThreadLocalStoragePointers[ xIndex ] = pvValue;
+			}
+		}
+
+	#endif /* configTHREAD_LOCAL_STORAGE_DELETE_CALLBACKS */
 
 #endif /* configNUM_THREAD_LOCAL_STORAGE_POINTERS */
 /*-----------------------------------------------------------*/
@@ -3613,8 +4125,21 @@ UBaseType_t uxPriority;
 		vListInitialise( &( pxReadyTasksLists[ uxPriority ] ) );
 	}
 
-	vListInitialise( &xDelayedTaskList1 );
-	vListInitialise( &xDelayedTaskList2 );
+	#if ( configUSE_DELAYED_TIMING_WHEEL == 0 )
+	{
+		vListInitialise( &xDelayedTaskList1 );
+		vListInitialise( &xDelayedTaskList2 );
+	}
+	#else
+	{
+		for( uxPriority = ( UBaseType_t ) 0U; uxPriority < ( UBaseType_t ) taskWHEEL_LISTS; uxPriority++ )
+		{
+			vListInitialise( taskWHEEL_LIST( uxPriority ) );
+		}
+
+		uxCurrentDelayedTaskWheel = ( UBaseType_t ) 0;
+	}
+	#endif /* configUSE_DELAYED_TIMING_WHEEL */
 	vListInitialise( &xPendingReadyList );
 
 	#if ( INCLUDE_vTaskDelete == 1 )
@@ -3631,8 +4156,12 @@ UBaseType_t uxPriority;
 
 	/* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
 	using list2. */
-	pxDelayedTaskList = &xDelayedTaskList1;
-	pxOverflowDelayedTaskList = &xDelayedTaskList2;
+	#if ( configUSE_DELAYED_TIMING_WHEEL == 0 )
+	{
+		pxDelayedTaskList = &xDelayedTaskList1;
+		pxOverflowDelayedTaskList = &xDelayedTaskList2;
+	}
+	#endif
 }
 /*-----------------------------------------------------------*/
 
@@ -3794,6 +4323,45 @@ static void prvCheckTasksWaitingTermination( void )
 #endif /* configUSE_TRACE_FACILITY */
 /*-----------------------------------------------------------*/
 
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+
+	static UBaseType_t prvListTaskRunTimesWithinSingleList( TaskRunTimeSnapshot_t *pxSnapshotArray, List_t *pxList )
+	{
+	configLIST_VOLATILE TCB_t *pxNextTCB, *pxFirstTCB;
+	UBaseType_t uxTask = 0;
+
+		if( listCURRENT_LIST_LENGTH( pxList ) > ( UBaseType_t ) 0 )
+		{
+			listGET_OWNER_OF_NEXT_ENTRY( pxFirstTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+			do
+			{
+				listGET_OWNER_OF_NEXT_ENTRY( pxNextTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+				pxSnapshotArray[ uxTask ].xHandle = ( TaskHandle_t ) pxNextTCB;
+				#if ( configUSE_TRACE_FACILITY == 1 )
+				{
+					pxSnapshotArray[ uxTask ].xTaskNumber = pxNextTCB->uxTCBNumber;
+				}
+				#else
+				{
+					pxSnapshotArray[ uxTask ].xTaskNumber = 0;
+				}
+				#endif
+				pxSnapshotArray[ uxTask ].ulRunTimeCounter = pxNextTCB->ulRunTimeCounter;
+				uxTask++;
+			} while( pxNextTCB != pxFirstTCB );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return uxTask;
+	}
+
+#endif /* configGENERATE_RUN_TIME_STATS */
+/*-----------------------------------------------------------*/
+
 #if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) )
 
 	static configSTACK_DEPTH_TYPE prvTaskCheckFreeStackSpace( const uint8_t * pucStackByte )
@@ -3891,6 +4459,26 @@ static void prvCheckTasksWaitingTermination( void )
 		want to allocate and clean RAM statically. */
 		portCLEAN_UP_TCB( pxTCB );
 
+		#if ( configTHREAD_LOCAL_STORAGE_DELETE_CALLBACKS == 1 )
+		{
+		UBaseType_t x;
+
+			/* Let the owners of the thread local storage pointers release
+			what they point to before the TCB goes. */
+			for( x = 0; x < ( UBaseType_t ) configNUM_THREAD_LOCAL_STORAGE_POINTERS; x++ )
+			{
+				if( pxTCB->pvThreadLocalStoragePointersDelCallback[ x ] != NULL )
+				{
+					pxTCB->pvThreadLocalStoragePointersDelCallback[ x ]( ( int ) x, pxTCB->pvThreadLocalStoragePointers[ x ] );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+		#endif
+
 		/* Free up the memory allocated by the scheduler for the task.  It is up
 		to the task to free any memory allocated at the application level.
 		See the third party link http://www.nadler.com/embedded/newlibAndFreeRTOS.html
@@ -3940,6 +4528,126 @@ static void prvCheckTasksWaitingTermination( void )
 #endif /* INCLUDE_vTaskDelete */
 /*-----------------------------------------------------------*/
 
+#if ( ( ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 ) && ( configUSE_BITMAP_TASK_SELECTION == 1 ) ) || ( configUSE_DELAYED_TIMING_WHEEL == 1 ) )
+
+	static UBaseType_t prvHighestSetBit( uint32_t ulValue )
+	{
+	static const uint8_t ucBitPosition[ 32 ] =
+	{
+		0, 9, 1, 10, 13, 21, 2, 29, 11, 14, 16, 18, 22, 25, 3, 30,
+		8, 12, 20, 28, 15, 17, 24, 7, 19, 27, 23, 6, 26, 5, 4, 31
+	};
+
+		/* Set every bit below the most significant set bit, so the value
+		becomes ( 2 ^ ( n + 1 ) ) - 1.  Multiplying by a De Bruijn style constant
+		then leaves a unique pattern for each n in the top five bits. */
+		ulValue |= ulValue >> 1;
+		ulValue |= ulValue >> 2;
+		ulValue |= ulValue >> 4;
+		ulValue |= ulValue >> 8;
+		ulValue |= ulValue >> 16;
+
+		return ( UBaseType_t ) ucBitPosition[ ( uint32_t ) ( ulValue * 0x07C4ACDDUL ) >> 27 ];
+	}
+
+#endif /* configUSE_BITMAP_TASK_SELECTION || configUSE_DELAYED_TIMING_WHEEL */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_DELAYED_TIMING_WHEEL == 1 )
+
+	static void prvAddTaskToDelayedWheel( TCB_t * const pxTCB, const TickType_t xTimeToWake, const TickType_t xConstTickCount )
+	{
+	const UBaseType_t uxSlot = ( UBaseType_t ) ( xTimeToWake & taskWHEEL_SLOT_MASK );
+	UBaseType_t uxWheel;
+
+		/* The tick has already looked at the slot of the current tick. */
+		configASSERT( xTimeToWake != xConstTickCount );
+
+		if( xTimeToWake < xConstTickCount )
+		{
+			/* Wake time has overflowed.  Place this item on the overflow
+			wheel. */
+			uxWheel = uxCurrentDelayedTaskWheel ^ ( UBaseType_t ) 1;
+		}
+		else
+		{
+			uxWheel = uxCurrentDelayedTaskWheel;
+
+			/* If the task wakes before the tick was next going to look at the
+			wheel then xNextTaskUnblockTime needs to be updated too. */
+			if( xTimeToWake < xNextTaskUnblockTime )
+			{
+				xNextTaskUnblockTime = xTimeToWake;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		/* The slots are not sorted, so the task goes at the end. */
+		vListInsertEnd( &( xDelayedTaskWheel[ uxWheel ][ uxSlot ] ), &( pxTCB->xStateListItem ) );
+		ulDelayedTaskWheelBits[ uxWheel ][ uxSlot >> 5 ] |= 1UL << ( uxSlot & ( UBaseType_t ) 0x1f );
+	}
+	/*-----------------------------------------------------------*/
+
+	static UBaseType_t prvFindDelayedWheelSlot( const uint32_t * const pulBits, const UBaseType_t uxFirstSlot, const UBaseType_t uxCount )
+	{
+	UBaseType_t uxOffset = 0, uxSlot;
+	uint32_t ulBits;
+
+		while( uxOffset < uxCount )
+		{
+			/* The bits of this word from uxSlot up, shifted down so bit 0 is
+			uxSlot.  ulBits & -ulBits isolates the lowest of them. */
+			uxSlot = ( uxFirstSlot + uxOffset ) & ( UBaseType_t ) taskWHEEL_SLOT_MASK;
+			ulBits = pulBits[ uxSlot >> 5 ] >> ( uxSlot & ( UBaseType_t ) 0x1f );
+
+			if( ulBits != 0UL )
+			{
+				uxOffset += prvHighestSetBit( ulBits & ( 0UL - ulBits ) );
+				break;
+			}
+
+			uxOffset += ( UBaseType_t ) taskWHEEL_WORD_BITS - ( uxSlot & ( UBaseType_t ) 0x1f );
+		}
+
+		return ( uxOffset < uxCount ) ? uxOffset : uxCount;
+	}
+
+#endif /* configUSE_DELAYED_TIMING_WHEEL */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_DELAYED_TIMING_WHEEL == 1 )
+
+static void prvResetNextTaskUnblockTime( void )
+{
+const TickType_t xConstTickCount = xTickCount;
+const UBaseType_t uxSlot = ( UBaseType_t ) ( xConstTickCount & taskWHEEL_SLOT_MASK );
+const TickType_t xLastTick = portMAX_DELAY - xConstTickCount;
+UBaseType_t uxOffset;
+
+	/* The first slot after this tick that may hold tasks.  They might be from
+	a later revolution, so this is the earliest a task can unblock rather than
+	the exact time, which is all the tick and tickless idle code need. */
+	uxOffset = prvFindDelayedWheelSlot( ulDelayedTaskWheelBits[ uxCurrentDelayedTaskWheel ], uxSlot + ( UBaseType_t ) 1, ( UBaseType_t ) configTIMING_WHEEL_SLOTS );
+
+	if( ( uxOffset < ( UBaseType_t ) configTIMING_WHEEL_SLOTS ) && ( ( TickType_t ) uxOffset < xLastTick ) )
+	{
+		xNextTaskUnblockTime = xConstTickCount + ( TickType_t ) 1 + ( TickType_t ) uxOffset;
+	}
+	else
+	{
+		/* The current wheel is empty, or only has stale bits left before the
+		tick count overflows and the wheels are switched.  Set
+		xNextTaskUnblockTime to the maximum possible value, as is done when the
+		delayed list is empty. */
+		xNextTaskUnblockTime = portMAX_DELAY;
+	}
+}
+
+#else /* configUSE_DELAYED_TIMING_WHEEL */
+
 static void prvResetNextTaskUnblockTime( void )
 {
 TCB_t *pxTCB;
@@ -3962,6 +4670,8 @@ TCB_t *pxTCB;
 		xNextTaskUnblockTime = listGET_LIST_ITEM_VALUE( &( ( pxTCB )->xStateListItem ) );
 	}
 }
+
+#endif /* configUSE_DELAYED_TIMING_WHEEL */
 /*-----------------------------------------------------------*/
 
 #if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) )
@@ -4478,7 +5188,7 @@ TCB_t *pxTCB;
 	{
 	TaskStatus_t *pxTaskStatusArray;
 	UBaseType_t uxArraySize, x;
-	uint32_t ulTotalTime, ulStatsAsPercentage;
+	configRUN_TIME_COUNTER_TYPE ulTotalTime, ulStatsAsPercentage;
 
 		#if( configUSE_TRACE_FACILITY != 1 )
 		{
@@ -4551,7 +5261,7 @@ TCB_t *pxTCB;
 					{
 						#ifdef portLU_PRINTF_SPECIFIER_REQUIRED
 						{
-							sprintf( pcWriteBuffer, "\t%lu\t\t%lu%%\r\n", pxTaskStatusArray[ x ].ulRunTimeCounter, ulStatsAsPercentage );
+							sprintf( pcWriteBuffer, "\t%lu\t\t%lu%%\r\n", ( unsigned long ) pxTaskStatusArray[ x ].ulRunTimeCounter, ( unsigned long ) ulStatsAsPercentage );
 						}
 						#else
 						{
@@ -4567,7 +5277,7 @@ TCB_t *pxTCB;
 						consumed less than 1% of the total run time. */
 						#ifdef portLU_PRINTF_SPECIFIER_REQUIRED
 						{
-							sprintf( pcWriteBuffer, "\t%lu\t\t<1%%\r\n", pxTaskStatusArray[ x ].ulRunTimeCounter );
+							sprintf( pcWriteBuffer, "\t%lu\t\t<1%%\r\n", ( unsigned long ) pxTaskStatusArray[ x ].ulRunTimeCounter );
 						}
 						#else
 						{
@@ -4613,6 +5323,60 @@ TickType_t uxReturn;
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_64_BIT_EVENT_GROUPS == 1 )
+
+	void vTaskPlaceOnUnorderedEventList64( List_t * pxEventList, const uint64_t ullItemValue, const TickType_t xTicksToWait )
+	{
+		/* The scheduler is suspended, see vTaskPlaceOnUnorderedEventList(). */
+		pxCurrentTCB->ullEventItemValue = ullItemValue;
+		vTaskPlaceOnUnorderedEventList( pxEventList, 0, xTicksToWait );
+	}
+
+#endif /* configUSE_64_BIT_EVENT_GROUPS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_64_BIT_EVENT_GROUPS == 1 )
+
+	uint64_t ullTaskGetEventItemValue64( const ListItem_t * pxEventListItem )
+	{
+	const TCB_t *pxTCB = listGET_LIST_ITEM_OWNER( pxEventListItem ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+		return pxTCB->ullEventItemValue;
+	}
+
+#endif /* configUSE_64_BIT_EVENT_GROUPS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_64_BIT_EVENT_GROUPS == 1 )
+
+	void vTaskRemoveFromUnorderedEventList64( ListItem_t * pxEventListItem, const uint64_t ullItemValue )
+	{
+	TCB_t *pxTCB = listGET_LIST_ITEM_OWNER( pxEventListItem ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+		/* The scheduler is suspended, see vTaskRemoveFromUnorderedEventList(). */
+		pxTCB->ullEventItemValue = ullItemValue;
+		vTaskRemoveFromUnorderedEventList( pxEventListItem, 0 );
+	}
+
+#endif /* configUSE_64_BIT_EVENT_GROUPS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_64_BIT_EVENT_GROUPS == 1 )
+
+	uint64_t ullTaskResetEventItemValue64( void )
+	{
+	uint64_t ullReturn;
+
+		ullReturn = pxCurrentTCB->ullEventItemValue;
+		pxCurrentTCB->ullEventItemValue = 0;
+		( void ) uxTaskResetEventItemValue();
+
+		return ullReturn;
+	}
+
+#endif /* configUSE_64_BIT_EVENT_GROUPS */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_MUTEXES == 1 )
 
 	TaskHandle_t pvTaskIncrementMutexHeldCount( void )
@@ -4630,6 +5394,133 @@ TickType_t uxReturn;
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_MUTEX_FAST_PATH == 1 )
+
+	BaseType_t xTaskDecrementMutexHeldCount( void )
+	{
+	TCB_t * const pxTCB = pxCurrentTCB;
+	BaseType_t xReturn;
+
+		configASSERT( pxTCB->uxMutexesHeld );
+
+		/* Only the task itself changes its held count outside a critical
+		section.  If giving up this mutex means giving up an inherited priority
+		the ready lists have to be changed, which is left to
+		xTaskPriorityDisinherit(). */
+		if( ( pxTCB->uxPriority == pxTCB->uxBasePriority ) || ( pxTCB->uxMutexesHeld > ( UBaseType_t ) 1 ) )
+		{
+			( pxTCB->uxMutexesHeld )--;
+			xReturn = pdTRUE;
+		}
+		else
+		{
+			xReturn = pdFALSE;
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_MUTEX_FAST_PATH */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEX_CEILING == 1 )
+
+	UBaseType_t uxTaskPriorityRaiseToCeiling( UBaseType_t uxCeilingPriority, UBaseType_t * const puxCeilingDepth )
+	{
+	const UBaseType_t uxPriorityOnEntry = pxCurrentTCB->uxPriority;
+
+		/* A task above the ceiling can preempt the holder and then block on
+		the mutex, which is exactly what the ceiling is meant to rule out. */
+		#if ( configCHECK_MUTEX_CEILING == 1 )
+		{
+			configASSERT( pxCurrentTCB->uxBasePriority <= uxCeilingPriority );
+		}
+		#endif
+
+		if( uxPriorityOnEntry < uxCeilingPriority )
+		{
+			traceTASK_PRIORITY_INHERIT( pxCurrentTCB, uxCeilingPriority );
+			prvSetRunningTaskPriority( uxCeilingPriority );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		( pxCurrentTCB->uxCeilingMutexesHeld )++;
+		*puxCeilingDepth = pxCurrentTCB->uxCeilingMutexesHeld;
+
+		return uxPriorityOnEntry;
+	}
+
+#endif /* configUSE_MUTEX_CEILING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEX_CEILING == 1 )
+
+	BaseType_t xTaskPriorityLowerFromCeiling( UBaseType_t uxCeilingPriority, UBaseType_t uxPriorityOnTake, UBaseType_t uxCeilingDepth )
+	{
+	TCB_t * const pxTCB = pxCurrentTCB;
+	UBaseType_t uxPriorityToUse;
+	BaseType_t xReturn = pdFALSE;
+
+		configASSERT( pxTCB->uxMutexesHeld );
+		( pxTCB->uxMutexesHeld )--;
+
+		/* uxPriorityOnTake is only the right priority to go back to if no
+		ceiling mutex taken after this one is still held.  Given out of order,
+		the task would drop below the ceiling of a mutex it still holds. */
+		#if ( configCHECK_MUTEX_CEILING == 1 )
+		{
+			configASSERT( uxCeilingDepth == pxTCB->uxCeilingMutexesHeld );
+		}
+		#else
+		{
+			( void ) uxCeilingDepth;
+		}
+		#endif
+		( pxTCB->uxCeilingMutexesHeld )--;
+
+		if( pxTCB->uxMutexesHeld == ( UBaseType_t ) 0 )
+		{
+			/* Nothing else can be holding the priority up. */
+			uxPriorityToUse = pxTCB->uxBasePriority;
+		}
+		else if( pxTCB->uxPriority <= uxCeilingPriority )
+		{
+			/* Go back to the priority the mutex was taken at, which is right
+			when ceiling mutexes are given in the reverse order to that in
+			which they were taken. */
+			uxPriorityToUse = ( uxPriorityOnTake > pxTCB->uxBasePriority ) ? uxPriorityOnTake : pxTCB->uxBasePriority;
+		}
+		else
+		{
+			/* The priority was raised above the ceiling by inheritance
+			through another mutex this task still holds.  Leave it for
+			xTaskPriorityDisinherit() when that mutex is given. */
+			uxPriorityToUse = pxTCB->uxPriority;
+		}
+
+		if( uxPriorityToUse != pxTCB->uxPriority )
+		{
+			traceTASK_PRIORITY_DISINHERIT( pxTCB, uxPriorityToUse );
+			prvSetRunningTaskPriority( uxPriorityToUse );
+
+			/* Only ever lowered here, so a task that was kept from running
+			by the ceiling may now be able to. */
+			xReturn = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_MUTEX_CEILING */
+/*-----------------------------------------------------------*/
+
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
 	uint32_t ulTaskNotifyTake( BaseType_t xClearCountOnExit, TickType_t xTicksToWait )
@@ -5166,7 +6057,7 @@ TickType_t uxReturn;
 
 #if( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) )
 
-	uint32_t ulTaskGetIdleRunTimeCounter( void )
+	configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimeCounter( void )
 	{
 		return xIdleTaskHandle->ulRunTimeCounter;
 	}
@@ -5174,6 +6065,41 @@ TickType_t uxReturn;
 #endif
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_MUTEX_CEILING == 1 )
+
+	static void prvSetRunningTaskPriority( UBaseType_t uxNewPriority )
+	{
+	TCB_t * const pxTCB = pxCurrentTCB;
+
+		/* The running task is in the ready list of its current priority. */
+		if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+		{
+			portRESET_READY_PRIORITY( pxTCB->uxPriority, uxTopReadyPriority );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		pxTCB->uxPriority = uxNewPriority;
+
+		/* Only reset the event list item value if the value is not being used
+		for anything else. */
+		if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+		{
+			listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxNewPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		prvAddTaskToReadyList( pxTCB );
+	}
+
+#endif /* configUSE_MUTEX_CEILING */
+/*-----------------------------------------------------------*/
+
 static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait, const BaseType_t xCanBlockIndefinitely )
 {
 TickType_t xTimeToWake;
@@ -5220,30 +6146,38 @@ const TickType_t xConstTickCount = xTickCount;
 			/* The list item will be inserted in wake time order. */
 			listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
 
-			if( xTimeToWake < xConstTickCount )
+			#if ( configUSE_DELAYED_TIMING_WHEEL == 0 )
 			{
-				/* Wake time has overflowed.  Place this item in the overflow
-				list. */
-				vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
-			}
-			else
-			{
-				/* The wake time has not overflowed, so the current block list
-				is used. */
-				vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
-
-				/* If the task entering the blocked state was placed at the
-				head of the list of blocked tasks then xNextTaskUnblockTime
-				needs to be updated too. */
-				if( xTimeToWake < xNextTaskUnblockTime )
+				if( xTimeToWake < xConstTickCount )
 				{
-					xNextTaskUnblockTime = xTimeToWake;
+					/* Wake time has overflowed.  Place this item in the overflow
+					list. */
+					vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
 				}
 				else
 				{
-					mtCOVERAGE_TEST_MARKER();
+					/* The wake time has not overflowed, so the current block list
+					is used. */
+					vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+
+					/* If the task entering the blocked state was placed at the
+					head of the list of blocked tasks then xNextTaskUnblockTime
+					needs to be updated too. */
+					if( xTimeToWake < xNextTaskUnblockTime )
+					{
+						xNextTaskUnblockTime = xTimeToWake;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
 				}
 			}
+			#else
+			{
+				prvAddTaskToDelayedWheel( pxCurrentTCB, xTimeToWake, xConstTickCount );
+			}
+			#endif /* configUSE_DELAYED_TIMING_WHEEL */
 		}
 	}
 	#else /* INCLUDE_vTaskSuspend */
@@ -5256,28 +6190,36 @@ const TickType_t xConstTickCount = xTickCount;
 		/* The list item will be inserted in wake time order. */
 		listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
 
-		if( xTimeToWake < xConstTickCount )
-		{
-			/* Wake time has overflowed.  Place this item in the overflow list. */
-			vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
-		}
-		else
+		#if ( configUSE_DELAYED_TIMING_WHEEL == 0 )
 		{
-			/* The wake time has not overflowed, so the current block list is used. */
-			vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
-
-			/* If the task entering the blocked state was placed at the head of the
-			list of blocked tasks then xNextTaskUnblockTime needs to be updated
-			too. */
-			if( xTimeToWake < xNextTaskUnblockTime )
+			if( xTimeToWake < xConstTickCount )
 			{
-				xNextTaskUnblockTime = xTimeToWake;
+				/* Wake time has overflowed.  Place this item in the overflow list. */
+				vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
 			}
 			else
 			{
-				mtCOVERAGE_TEST_MARKER();
+				/* The wake time has not overflowed, so the current block list is used. */
+				vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+
+				/* If the task entering the blocked state was placed at the head of the
+				list of blocked tasks then xNextTaskUnblockTime needs to be updated
+				too. */
+				if( xTimeToWake < xNextTaskUnblockTime )
+				{
+					xNextTaskUnblockTime = xTimeToWake;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
 			}
 		}
+		#else
+		{
+			prvAddTaskToDelayedWheel( pxCurrentTCB, xTimeToWake, xConstTickCount );
+		}
+		#endif /* configUSE_DELAYED_TIMING_WHEEL */
 
 		/* Avoid compiler warning when INCLUDE_vTaskSuspend is not 1. */
 		( void ) xCanBlockIndefinitely;
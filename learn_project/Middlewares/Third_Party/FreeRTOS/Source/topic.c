@@ -0,0 +1,506 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "topic.h"
+
+/* Lint e961, e750 and e9021 are suppressed as a MISRA exception justified
+because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+for the header files above, but not in this file, in order to generate the
+correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021 See comment above. */
+
+/* Messages are numbered by free running 32-bit sequence numbers.  The ring
+slot of a message is the low bits of its sequence number, and the number of
+messages a subscriber has not read is the difference between the topic's and
+the subscriber's sequence numbers, which stays correct when they wrap. */
+typedef struct TopicSubscriberDef_t
+{
+	struct TopicDef_t *pxTopic;					/*< The topic subscribed to. */
+	struct TopicSubscriberDef_t *pxNext;		/*< The next subscriber of the same topic. */
+	uint32_t ulTail;							/*< Sequence number of the next message to read. */
+	uint32_t ulLost;							/*< Messages overwritten before they were read. */
+} TopicSubscriber_t;
+
+typedef struct TopicDef_t
+{
+	uint8_t *pucStorage;						/*< The ring, uxLength * uxItemSize bytes, allocated after the structure. */
+	UBaseType_t uxLength;						/*< Ring length in messages, a power of 2. */
+	UBaseType_t uxItemSize;						/*< Size of each message in bytes. */
+	uint32_t ulHead;							/*< Sequence number the next published message will be given. */
+	uint32_t ulSlowestTail;						/*< Never greater than the lowest ulTail of the subscribers. */
+	uint32_t ulDropped;							/*< Publishes that failed because the ring was full. */
+	TopicSubscriber_t *pxSubscribers;			/*< Singly linked list of subscribers. */
+	List_t xSubscribersWaiting;					/*< Tasks blocked in xTopicReceive(). */
+	List_t xPublishersWaiting;					/*< Tasks blocked in xTopicPublish() under eTopicBlock. */
+	uint8_t ucPolicy;							/*< The eTopicPolicy the topic was created with. */
+} Topic_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Returns pdTRUE if the slowest subscriber has not yet read the oldest
+ * message in the ring, so publishing another would overwrite it.  The
+ * subscribers are only scanned when the cached lower bound of their read
+ * positions says the ring might be full.
+ */
+static BaseType_t prvTopicIsFull( Topic_t * const pxTopic ) PRIVILEGED_FUNCTION;
+
+/*
+ * Moves every subscriber that has not read the oldest message past it.  Only
+ * used by eTopicOverwrite topics when the ring is full.
+ */
+static void prvDiscardOldest( Topic_t * const pxTopic ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblocks every task on pxList.  The list is an unordered event list so this
+ * is one pass over the waiting tasks, made with the scheduler suspended.
+ */
+static void prvWakeAll( List_t * const pxList ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	TopicHandle_t xTopicCreate( UBaseType_t uxLength, UBaseType_t uxItemSize, eTopicPolicy ePolicy )
+	{
+	Topic_t *pxTopic;
+	size_t xStorageSize;
+
+		/* The slot of a message is taken from the low bits of its sequence
+		number, which only keeps successive messages in successive slots when
+		the sequence wraps if the length is a power of 2. */
+		configASSERT( ( uxLength > ( UBaseType_t ) 0 ) && ( ( uxLength & ( uxLength - ( UBaseType_t ) 1 ) ) == ( UBaseType_t ) 0 ) );
+		configASSERT( uxItemSize > ( UBaseType_t ) 0 );
+		configASSERT( ePolicy <= eTopicOverwrite );
+
+		xStorageSize = ( size_t ) uxLength * ( size_t ) uxItemSize;
+		pxTopic = ( Topic_t * ) pvPortMalloc( sizeof( Topic_t ) + xStorageSize ); /*lint !e9087 !e9079 see comment above. */
+
+		if( pxTopic != NULL )
+		{
+			pxTopic->pucStorage = ( ( uint8_t * ) pxTopic ) + sizeof( Topic_t ); /*lint !e9016 Pointer arithmetic allowed on char types, especially when it assists conveying intent. */
+			pxTopic->uxLength = uxLength;
+			pxTopic->uxItemSize = uxItemSize;
+			pxTopic->ulHead = 0;
+			pxTopic->ulSlowestTail = 0;
+			pxTopic->ulDropped = 0;
+			pxTopic->pxSubscribers = NULL;
+			pxTopic->ucPolicy = ( uint8_t ) ePolicy;
+			vListInitialise( &( pxTopic->xSubscribersWaiting ) );
+			vListInitialise( &( pxTopic->xPublishersWaiting ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pxTopic;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+void vTopicDelete( TopicHandle_t xTopic )
+{
+Topic_t * const pxTopic = xTopic;
+
+	configASSERT( pxTopic );
+	configASSERT( pxTopic->pxSubscribers == NULL );
+	configASSERT( listCURRENT_LIST_LENGTH( &( pxTopic->xPublishersWaiting ) ) == ( UBaseType_t ) 0 );
+
+	vPortFree( pxTopic );
+}
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	TopicSubscriberHandle_t xTopicSubscribe( TopicHandle_t xTopic )
+	{
+	Topic_t * const pxTopic = xTopic;
+	TopicSubscriber_t *pxSubscriber;
+
+		configASSERT( pxTopic );
+
+		pxSubscriber = ( TopicSubscriber_t * ) pvPortMalloc( sizeof( TopicSubscriber_t ) );
+
+		if( pxSubscriber != NULL )
+		{
+			pxSubscriber->pxTopic = pxTopic;
+			pxSubscriber->ulLost = 0;
+
+			vTaskSuspendAll();
+			{
+				/* Starting at the head means the new subscriber is never the
+				slowest, so ulSlowestTail remains a valid lower bound. */
+				pxSubscriber->ulTail = pxTopic->ulHead;
+				pxSubscriber->pxNext = pxTopic->pxSubscribers;
+				pxTopic->pxSubscribers = pxSubscriber;
+			}
+			( void ) xTaskResumeAll();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pxSubscriber;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+void vTopicUnsubscribe( TopicSubscriberHandle_t xSubscriber )
+{
+TopicSubscriber_t * const pxSubscriber = xSubscriber;
+Topic_t *pxTopic;
+TopicSubscriber_t **ppxLink;
+
+	configASSERT( pxSubscriber );
+	pxTopic = pxSubscriber->pxTopic;
+
+	vTaskSuspendAll();
+	{
+		for( ppxLink = &( pxTopic->pxSubscribers ); *ppxLink != NULL; ppxLink = &( ( *ppxLink )->pxNext ) )
+		{
+			if( *ppxLink == pxSubscriber )
+			{
+				*ppxLink = pxSubscriber->pxNext;
+				break;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		/* The subscriber may have been the one holding up the publishers. */
+		prvWakeAll( &( pxTopic->xPublishersWaiting ) );
+	}
+	( void ) xTaskResumeAll();
+
+	vPortFree( pxSubscriber );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTopicPublish( TopicHandle_t xTopic, const void * const pvItem, TickType_t xTicksToWait )
+{
+Topic_t * const pxTopic = xTopic;
+BaseType_t xReturn = pdFAIL, xBlocked, xEntryTimeSet = pdFALSE, xAlreadyYielded;
+TimeOut_t xTimeOut;
+
+	configASSERT( pxTopic );
+	configASSERT( pvItem );
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
+
+	for( ;; )
+	{
+		xBlocked = pdFALSE;
+
+		vTaskSuspendAll();
+		{
+			if( prvTopicIsFull( pxTopic ) == pdFALSE )
+			{
+				xReturn = pdPASS;
+			}
+			else if( pxTopic->ucPolicy == ( uint8_t ) eTopicOverwrite )
+			{
+				prvDiscardOldest( pxTopic );
+				xReturn = pdPASS;
+			}
+			else if( ( pxTopic->ucPolicy == ( uint8_t ) eTopicBlock ) && ( xTicksToWait != ( TickType_t ) 0 ) )
+			{
+				if( xEntryTimeSet == pdFALSE )
+				{
+					vTaskInternalSetTimeOutState( &xTimeOut );
+					xEntryTimeSet = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+				{
+					/* prvTopicIsFull() has just scanned the subscribers, so
+					ulSlowestTail is exact and the subscriber at it will wake
+					this task when it reads. */
+					vTaskPlaceOnUnorderedEventList( &( pxTopic->xPublishersWaiting ), ( TickType_t ) 0, xTicksToWait );
+					xBlocked = pdTRUE;
+				}
+				else
+				{
+					pxTopic->ulDropped++;
+				}
+			}
+			else
+			{
+				pxTopic->ulDropped++;
+			}
+
+			if( xReturn != pdFAIL )
+			{
+				( void ) memcpy( ( void * ) &( pxTopic->pucStorage[ ( ( UBaseType_t ) pxTopic->ulHead & ( pxTopic->uxLength - ( UBaseType_t ) 1 ) ) * pxTopic->uxItemSize ] ), pvItem, ( size_t ) pxTopic->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports, plus previous logic ensures a null pointer can only be passed to memcpy() if the copy size is 0. */
+				pxTopic->ulHead++;
+
+				prvWakeAll( &( pxTopic->xSubscribersWaiting ) );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		xAlreadyYielded = xTaskResumeAll();
+
+		if( xBlocked == pdFALSE )
+		{
+			break;
+		}
+
+		if( xAlreadyYielded == pdFALSE )
+		{
+			portYIELD_WITHIN_API();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* Woken by a subscriber reading, or the block time expired.  Either
+		way restore the event list item value used by the priority ordered
+		event lists, then try again. */
+		( void ) uxTaskResetEventItemValue();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTopicReceive( TopicSubscriberHandle_t xSubscriber, void * const pvBuffer, TickType_t xTicksToWait )
+{
+TopicSubscriber_t * const pxSubscriber = xSubscriber;
+Topic_t *pxTopic;
+BaseType_t xReturn = pdFAIL, xBlocked, xEntryTimeSet = pdFALSE, xAlreadyYielded;
+TimeOut_t xTimeOut;
+uint32_t ulTail;
+
+	configASSERT( pxSubscriber );
+	configASSERT( pvBuffer );
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
+
+	pxTopic = pxSubscriber->pxTopic;
+
+	for( ;; )
+	{
+		xBlocked = pdFALSE;
+
+		vTaskSuspendAll();
+		{
+			ulTail = pxSubscriber->ulTail;
+
+			if( ulTail != pxTopic->ulHead )
+			{
+				( void ) memcpy( pvBuffer, ( void * ) &( pxTopic->pucStorage[ ( ( UBaseType_t ) ulTail & ( pxTopic->uxLength - ( UBaseType_t ) 1 ) ) * pxTopic->uxItemSize ] ), ( size_t ) pxTopic->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports. */
+				pxSubscriber->ulTail = ulTail + 1UL;
+				xReturn = pdPASS;
+
+				/* A blocked publisher only needs waking once the slowest
+				subscriber moves.  Publishers only block straight after
+				ulSlowestTail has been made exact, so it is enough to compare
+				against it. */
+				if( ulTail == pxTopic->ulSlowestTail )
+				{
+					prvWakeAll( &( pxTopic->xPublishersWaiting ) );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else if( xTicksToWait != ( TickType_t ) 0 )
+			{
+				if( xEntryTimeSet == pdFALSE )
+				{
+					vTaskInternalSetTimeOutState( &xTimeOut );
+					xEntryTimeSet = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+				{
+					vTaskPlaceOnUnorderedEventList( &( pxTopic->xSubscribersWaiting ), ( TickType_t ) 0, xTicksToWait );
+					xBlocked = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		xAlreadyYielded = xTaskResumeAll();
+
+		if( xBlocked == pdFALSE )
+		{
+			break;
+		}
+
+		if( xAlreadyYielded == pdFALSE )
+		{
+			portYIELD_WITHIN_API();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		( void ) uxTaskResetEventItemValue();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxTopicMessagesWaiting( TopicSubscriberHandle_t xSubscriber )
+{
+TopicSubscriber_t * const pxSubscriber = xSubscriber;
+UBaseType_t uxReturn;
+
+	configASSERT( pxSubscriber );
+
+	vTaskSuspendAll();
+	{
+		uxReturn = ( UBaseType_t ) ( pxSubscriber->pxTopic->ulHead - pxSubscriber->ulTail );
+	}
+	( void ) xTaskResumeAll();
+
+	return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulTopicGetLostCount( TopicSubscriberHandle_t xSubscriber )
+{
+	configASSERT( xSubscriber );
+	return xSubscriber->ulLost;
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulTopicGetDroppedCount( TopicHandle_t xTopic )
+{
+	configASSERT( xTopic );
+	return xTopic->ulDropped;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvTopicIsFull( Topic_t * const pxTopic )
+{
+const TopicSubscriber_t *pxSubscriber;
+uint32_t ulSlowest;
+
+	if( ( pxTopic->ulHead - pxTopic->ulSlowestTail ) >= ( uint32_t ) pxTopic->uxLength )
+	{
+		/* The cached bound says the ring is full, but the slowest subscriber
+		may have read since it was taken.  A topic with no subscribers is never
+		full. */
+		ulSlowest = pxTopic->ulHead;
+
+		for( pxSubscriber = pxTopic->pxSubscribers; pxSubscriber != NULL; pxSubscriber = pxSubscriber->pxNext )
+		{
+			if( ( pxTopic->ulHead - pxSubscriber->ulTail ) > ( pxTopic->ulHead - ulSlowest ) )
+			{
+				ulSlowest = pxSubscriber->ulTail;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		pxTopic->ulSlowestTail = ulSlowest;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return ( ( pxTopic->ulHead - pxTopic->ulSlowestTail ) >= ( uint32_t ) pxTopic->uxLength ) ? pdTRUE : pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+static void prvDiscardOldest( Topic_t * const pxTopic )
+{
+TopicSubscriber_t *pxSubscriber;
+const uint32_t ulOldest = pxTopic->ulHead - ( uint32_t ) pxTopic->uxLength;
+
+	for( pxSubscriber = pxTopic->pxSubscribers; pxSubscriber != NULL; pxSubscriber = pxSubscriber->pxNext )
+	{
+		if( pxSubscriber->ulTail == ulOldest )
+		{
+			pxSubscriber->ulTail = ulOldest + 1UL;
+			pxSubscriber->ulLost++;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	pxTopic->ulSlowestTail = ulOldest + 1UL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvWakeAll( List_t * const pxList )
+{
+	while( listLIST_IS_EMPTY( pxList ) == pdFALSE )
+	{
+		vTaskRemoveFromUnorderedEventList( listGET_HEAD_ENTRY( pxList ), ( TickType_t ) 0 );
+	}
+}